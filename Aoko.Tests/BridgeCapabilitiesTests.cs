@@ -54,4 +54,18 @@ public class BridgeCapabilitiesTests
         Assert.True(parsed.SupportsStateField("actionbar"));
         Assert.True(parsed.SupportsSetting("mincps"));
     }
+
+    [Fact]
+    public void Streams_OnlyWhenAnnounced()
+    {
+        BridgeCapabilities fallback = BridgeCapabilities.ForVersionFallback("26.1");
+        Assert.False(fallback.SupportsStream("telemetry"));
+
+        var payload = new JsonObject
+        {
+            ["modules"] = new JsonArray("autoclicker"),
+            ["streams"] = new JsonArray("Telemetry")
+        };
+        Assert.True(BridgeCapabilities.FromPayload(payload, fallback).SupportsStream("telemetry"));
+    }
 }
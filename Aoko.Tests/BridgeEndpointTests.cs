@@ -0,0 +1,96 @@
+using System.Linq;
+using System.Text.Json.Nodes;
+using System.Threading;
+using System.Threading.Tasks;
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class BridgeEndpointTests
+{
+    [Theory]
+    [InlineData(4, 25592)]
+    [InlineData(16384, 25591)]      // (16384 / 4) % 4096 == 0
+    [InlineData(12340, 25591 + 3085)]
+    public void CandidatePorts_StartAtTheHomePortOfThePid(int pid, int home)
+    {
+        int[] ports = BridgeEndpoint.CandidatePorts(pid, 0).ToArray();
+        Assert.Equal(BridgeEndpoint.Probes, ports.Length);
+        Assert.Equal(home, ports[0]);
+        Assert.All(ports, p => Assert.InRange(p, BridgeEndpoint.BasePort + 1, BridgeEndpoint.BasePort + BridgeEndpoint.PortRange));
+        Assert.Equal(ports.Length, ports.Distinct().Count());
+    }
+
+    [Fact]
+    public void CandidatePorts_WrapAtTheEndOfTheRange()
+    {
+        int pid = (BridgeEndpoint.PortRange - 1) * 4;
+        int[] ports = BridgeEndpoint.CandidatePorts(pid, 0).ToArray();
+        Assert.Equal(BridgeEndpoint.BasePort + BridgeEndpoint.PortRange, ports[0]);
+        Assert.Equal(BridgeEndpoint.BasePort + 1, ports[1]);
+    }
+
+    [Fact]
+    public void CandidatePorts_TryTheOverrideFirstAndOnlyOnce()
+    {
+        int[] ports = BridgeEndpoint.CandidatePorts(4, 30000).ToArray();
+        Assert.Equal(new[] { 30000, 25592 }, ports.Take(2));
+        Assert.Equal(BridgeEndpoint.Probes + 1, ports.Length);
+
+        ports = BridgeEndpoint.CandidatePorts(4, 25593).ToArray();
+        Assert.Equal(new[] { 25593, 25592, 25594 }, ports.Take(3));
+        Assert.Equal(BridgeEndpoint.Probes, ports.Length);
+    }
+
+    [Theory]
+    [InlineData(null, 0)]
+    [InlineData("", 0)]
+    [InlineData("30000", 30000)]
+    [InlineData(" 30000x", 30000)]
+    [InlineData("+80", 80)]
+    [InlineData("0", 0)]
+    [InlineData("-5", 0)]
+    [InlineData("65536", 0)]
+    [InlineData("99999999999", 0)]
+    [InlineData("port", 0)]
+    public void OverridePort_ParsesLikeTheBridge(string? value, int expected)
+    {
+        Assert.Equal(expected, BridgeEndpoint.OverridePort(value));
+    }
+
+    [Theory]
+    [InlineData("{\"type\":\"capabilities\",\"pid\":1234,\"port\":25900}", 1234, true)]
+    [InlineData("{\"type\":\"capabilities\",\"pid\":1234,\"port\":25900}", 5678, false)]
+    [InlineData("{\"type\":\"capabilities\"}", 5678, true)]
+    [InlineData("{\"type\":\"capabilities\",\"pid\":\"x\"}", 5678, false)]
+    public void ServesProcess_ChecksTheAnnouncedPid(string json, int pid, bool expected)
+    {
+        Assert.Equal(expected, BridgeEndpoint.ServesProcess(JsonNode.Parse(json), pid));
+    }
+
+    [Theory]
+    [InlineData("{\"type\":\"capabilities\",\"pid\":1234,\"port\":25900,\"session\":3}", 3)]
+    [InlineData("{\"type\":\"capabilities\",\"pid\":1234,\"port\":25900}", 0)]
+    [InlineData("{\"type\":\"capabilities\",\"session\":\"x\"}", 0)]
+    public void SessionOf_ReadsTheAnnouncedSession(string json, int expected)
+    {
+        Assert.Equal(expected, BridgeEndpoint.SessionOf(JsonNode.Parse(json)));
+    }
+
+    [Fact]
+    public async Task BridgeIoThread_ResumesEveryLoopOnTheSharedThread()
+    {
+        int[] seen = new int[4];
+        async Task Loop(int index)
+        {
+            await Task.Delay(5);
+            seen[index * 2] = Thread.CurrentThread.ManagedThreadId;
+            await Task.Yield();
+            seen[index * 2 + 1] = Thread.CurrentThread.ManagedThreadId;
+        }
+
+        await Task.WhenAll(BridgeIoThread.Run(() => Loop(0)), BridgeIoThread.Run(() => Loop(1)));
+
+        Assert.All(seen, id => Assert.Equal(BridgeIoThread.ManagedThreadId, id));
+    }
+}
@@ -0,0 +1,39 @@
+using System.Text.Json.Nodes;
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class BridgeModuleStateTests
+{
+    [Theory]
+    [InlineData("resolving", ModuleResolveState.Resolving)]
+    [InlineData("ready", ModuleResolveState.Ready)]
+    [InlineData("failed", ModuleResolveState.Failed)]
+    [InlineData("idle", ModuleResolveState.Unknown)]
+    public void TryParse_ReadsModuleAndState(string wire, ModuleResolveState expected)
+    {
+        string line = "{\"type\":\"moduleState\",\"module\":\"ChestEsp\",\"state\":\"" + wire + "\"}\n";
+
+        Assert.True(BridgeModuleState.TryParse(line, out string module, out ModuleResolveState state));
+        Assert.Equal("chestesp", module);
+        Assert.Equal(expected, state);
+    }
+
+    [Fact]
+    public void TryParse_RejectsOtherAndMalformedLines()
+    {
+        Assert.False(BridgeModuleState.TryParse("{\"type\":\"configAck\",\"version\":3}", out _, out _));
+        Assert.False(BridgeModuleState.TryParse("{\"type\":\"moduleState\",\"state\":\"ready\"}", out _, out _));
+        Assert.False(BridgeModuleState.TryParse("{\"type\":\"moduleState\",\"module\":", out _, out _));
+        Assert.False(BridgeModuleState.TryParse("{\"type\":\"moduleState\",\"module\":7}", out _, out _));
+    }
+
+    [Fact]
+    public void ModernCapabilities_AnnounceTheStream()
+    {
+        string payload = "{\"type\":\"capabilities\",\"modules\":[\"reach\"],\"streams\":[\"telemetry\",\"moduleState\"]}";
+        var caps = BridgeCapabilities.FromPayload(JsonNode.Parse(payload), BridgeCapabilities.ForVersionFallback("26.1"));
+
+        Assert.True(caps.SupportsStream(BridgeModuleState.StreamName));
+    }
+}
@@ -0,0 +1,333 @@
+using System.Buffers.Binary;
+using System.Text;
+using System.Text.Json.Nodes;
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class BridgeProtocolTests
+{
+    [Fact]
+    public void DecodeState_ReadsFlagsScalarsAndEntities()
+    {
+        byte[] payload = BuildStatePayload(
+            (ushort)(BridgeProtocol.StateFlags.Mapped | BridgeProtocol.StateFlags.GuiOpen | BridgeProtocol.StateFlags.BreakingBlock),
+            screenName: "InventoryScreen",
+            actionBar: "The theme is _ _ _",
+            entities: new[] { ("Steve", 1.5f, 2.5f, 4.25, 18f) });
+
+        GameState state = BridgeProtocol.DecodeState(payload);
+
+        Assert.True(state.Mapped);
+        Assert.True(state.GuiOpen);
+        Assert.True(state.BreakingBlock);
+        Assert.False(state.LookingAtEntity);
+        Assert.Equal(20f, state.Health);
+        Assert.Equal(90f, state.Fov);
+        Assert.Equal(0.5f, state.AttackCooldown);
+        Assert.Equal(12345UL, state.StateMs);
+        Assert.Equal("InventoryScreen", state.ScreenName);
+        Assert.Equal("The theme is _ _ _", state.ActionBar);
+        EntityInfo entity = Assert.Single(state.Entities);
+        Assert.Equal("Steve", entity.Name);
+        Assert.Equal(1.5f, entity.Sx);
+        Assert.Equal(4.25, entity.Dist);
+        Assert.Equal(18f, entity.Hp);
+    }
+
+    [Fact]
+    public void DecodeState_ThrowsOnTruncatedPayload()
+    {
+        byte[] payload = BuildStatePayload(0, "x", "", new[] { ("Alex", 0f, 0f, 1.0, 20f) });
+
+        Assert.Throws<FormatException>(() => BridgeProtocol.DecodeState(payload.AsSpan(0, payload.Length - 3)));
+    }
+
+    [Fact]
+    public void TickTrailer_IsOptionalOnKeyframesAndFollowsEntitiesInDeltas()
+    {
+        byte[] legacy = BuildStatePayload(0, "x", "", new[] { ("Alex", 0f, 0f, 1.0, 20f) });
+        Assert.Equal(0u, BridgeProtocol.DecodeState(legacy).Tick);
+
+        var ms = new MemoryStream();
+        ms.Write(legacy);
+        var w = new BinaryWriter(ms);
+        w.Write(41u);
+        w.Write(12300UL);
+        w.Flush();
+        var assembler = new BridgeStateAssembler();
+        GameState key = assembler.AcceptKeyframe(BridgeProtocol.DecodeState(ms.ToArray()));
+        Assert.Equal(41u, key.Tick);
+        Assert.Equal(12300UL, key.TickSampleMs);
+
+        ms = new MemoryStream();
+        w = new BinaryWriter(ms);
+        w.Write(1u);
+        w.Write((ushort)(BridgeProtocol.DeltaFields.Entities | BridgeProtocol.DeltaFields.Tick));
+        w.Write((ushort)0);            // count
+        w.Write((ushort)0);            // changed
+        w.Write(42u);
+        w.Write(12350UL);
+        w.Flush();
+
+        GameState? next = assembler.ApplyDelta(ms.ToArray());
+
+        Assert.NotNull(next);
+        Assert.Empty(next!.Entities);
+        Assert.Equal(42u, next.Tick);
+        Assert.Equal(12350UL, next.TickSampleMs);
+        Assert.Equal(12345UL, next.StateMs);
+    }
+
+    [Fact]
+    public void ActionBarRev_TrailsTheTickFieldsAndTravelsWithActionBarDeltas()
+    {
+        var ms = new MemoryStream();
+        ms.Write(BuildStatePayload(0, "x", "Hint: _ _", Array.Empty<(string, float, float, double, float)>()));
+        var w = new BinaryWriter(ms);
+        w.Write(41u);
+        w.Write(12300UL);
+        w.Write(7u);
+        w.Flush();
+        var assembler = new BridgeStateAssembler();
+        GameState key = assembler.AcceptKeyframe(BridgeProtocol.DecodeState(ms.ToArray()));
+        Assert.Equal(7u, key.ActionBarRev);
+
+        ms = new MemoryStream();
+        w = new BinaryWriter(ms);
+        w.Write(1u);
+        w.Write((ushort)BridgeProtocol.DeltaFields.StateMs);
+        w.Write(12400UL);
+        w.Flush();
+        GameState? same = assembler.ApplyDelta(ms.ToArray());
+        Assert.Equal(7u, same!.ActionBarRev);
+        Assert.Equal("Hint: _ _", same.ActionBar);
+
+        ms = new MemoryStream();
+        w = new BinaryWriter(ms);
+        w.Write(2u);
+        w.Write((ushort)(BridgeProtocol.DeltaFields.ActionBar | BridgeProtocol.DeltaFields.ActionBarRev));
+        WriteStr(w, "Hint: a _");
+        w.Write(8u);
+        w.Flush();
+        GameState? moved = assembler.ApplyDelta(ms.ToArray());
+        Assert.Equal(8u, moved!.ActionBarRev);
+        Assert.Equal("Hint: a _", moved.ActionBar);
+    }
+
+    [Fact]
+    public void Assembler_AppliesDeltaFieldsAndEntityChanges()
+    {
+        var assembler = new BridgeStateAssembler();
+        GameState key = assembler.AcceptKeyframe(BridgeProtocol.DecodeState(BuildStatePayload(
+            (ushort)BridgeProtocol.StateFlags.Mapped, "ChatScreen", "",
+            new[] { ("Steve", 1f, 1f, 3.0, 20f), ("Alex", 2f, 2f, 5.0, 20f) })));
+
+        var ms = new MemoryStream();
+        var w = new BinaryWriter(ms);
+        w.Write(1u);
+        w.Write((ushort)(BridgeProtocol.DeltaFields.ActionBar | BridgeProtocol.DeltaFields.Entities));
+        WriteStr(w, "Hint: _ _ _");
+        w.Write((ushort)1);            // count: Alex (index 1) is gone
+        w.Write((ushort)1);            // changed
+        w.Write((ushort)0);
+        w.Write(4f); w.Write(4f); w.Write(2.0); w.Write(12f); WriteStr(w, "Steve");
+        w.Flush();
+
+        GameState? next = assembler.ApplyDelta(ms.ToArray());
+
+        Assert.NotNull(next);
+        Assert.Equal("Hint: _ _ _", next!.ActionBar);
+        Assert.Equal("ChatScreen", next.ScreenName);
+        Assert.True(next.Mapped);
+        EntityInfo steve = Assert.Single(next.Entities);
+        Assert.Equal(12f, steve.Hp);
+        Assert.Equal(2, key.Entities.Count);
+    }
+
+    [Fact]
+    public void EntityDelta_KeepsOrderAndTellsApartPlayersWithTheSameName()
+    {
+        var assembler = new BridgeStateAssembler();
+        GameState key = assembler.AcceptKeyframe(BridgeProtocol.DecodeState(BuildStatePayload(0, "x", "",
+            new[] { ("Player_1", 0f, 0f, 2.0, 20f), ("Steve", 0f, 0f, 4.0, 20f), ("Player_1", 0f, 0f, 6.0, 20f) })));
+
+        // The far Player_1 takes a hit and a new Steve shows up at the front.
+        var ms = new MemoryStream();
+        var w = new BinaryWriter(ms);
+        w.Write(1u);
+        w.Write((ushort)BridgeProtocol.DeltaFields.Entities);
+        w.Write((ushort)4);            // count
+        w.Write((ushort)4);            // changed
+        w.Write((ushort)0); w.Write(0f); w.Write(0f); w.Write(1.0); w.Write(20f); WriteStr(w, "Steve");
+        w.Write((ushort)1); w.Write(0f); w.Write(0f); w.Write(2.0); w.Write(20f); WriteStr(w, "Player_1");
+        w.Write((ushort)2); w.Write(0f); w.Write(0f); w.Write(4.0); w.Write(20f); WriteStr(w, "Steve");
+        w.Write((ushort)3); w.Write(0f); w.Write(0f); w.Write(6.0); w.Write(9f); WriteStr(w, "Player_1");
+        w.Flush();
+        GameState next = assembler.ApplyDelta(ms.ToArray())!;
+
+        Assert.Equal(new[] { 1.0, 2.0, 4.0, 6.0 }, next.Entities.Select(e => e.Dist).ToArray());
+        Assert.Equal(new[] { 20f, 20f, 20f, 9f }, next.Entities.Select(e => e.Hp).ToArray());
+
+        // Only the second Player_1 leaves; the first keeps its record untouched.
+        ms = new MemoryStream();
+        w = new BinaryWriter(ms);
+        w.Write(2u);
+        w.Write((ushort)BridgeProtocol.DeltaFields.Entities);
+        w.Write((ushort)3);            // count
+        w.Write((ushort)0);            // changed
+        w.Flush();
+        GameState last = assembler.ApplyDelta(ms.ToArray())!;
+
+        Assert.Equal(3, last.Entities.Count);
+        Assert.Same(next.Entities[1], last.Entities[1]);
+        Assert.Equal(3, key.Entities.Count);
+    }
+
+    [Fact]
+    public void EntityDelta_WithUnsetSlotsAsksForAKeyframe()
+    {
+        var assembler = new BridgeStateAssembler();
+        assembler.AcceptKeyframe(BridgeProtocol.DecodeState(BuildStatePayload(0, "x", "", Array.Empty<(string, float, float, double, float)>())));
+
+        var ms = new MemoryStream();
+        var w = new BinaryWriter(ms);
+        w.Write(1u);
+        w.Write((ushort)BridgeProtocol.DeltaFields.Entities);
+        w.Write((ushort)1);            // count, but nothing sent for index 0
+        w.Write((ushort)0);
+        w.Flush();
+
+        Assert.Throws<FormatException>(() => BridgeProtocol.ApplyStateDelta(new GameState(), ms.ToArray(), out _));
+        Assert.Null(assembler.ApplyDelta(ms.ToArray()));
+        Assert.True(assembler.TakeKeyframeRequest());
+    }
+
+    [Fact]
+    public void Assembler_DropsDeltasAfterSequenceGapUntilKeyframe()
+    {
+        var assembler = new BridgeStateAssembler();
+        assembler.AcceptKeyframe(BridgeProtocol.DecodeState(BuildStatePayload(0, "x", "", Array.Empty<(string, float, float, double, float)>())));
+
+        Assert.Null(assembler.ApplyDelta(StateMsDelta(seq: 2, stateMs: 99)));
+        Assert.True(assembler.TakeKeyframeRequest());
+        Assert.False(assembler.TakeKeyframeRequest());
+        Assert.Null(assembler.ApplyDelta(StateMsDelta(seq: 3, stateMs: 100)));
+
+        assembler.AcceptKeyframe(BridgeProtocol.DecodeState(BuildStatePayload(0, "x", "", Array.Empty<(string, float, float, double, float)>())));
+        Assert.Equal(101UL, assembler.ApplyDelta(StateMsDelta(seq: 1, stateMs: 101))?.StateMs);
+    }
+
+    [Fact]
+    public async Task Reader_SwitchesFromLinesToFramesWithoutLosingBufferedBytes()
+    {
+        var bytes = new List<byte>();
+        bytes.AddRange(Encoding.UTF8.GetBytes("{\"type\":\"capabilities\"}\n"));
+        bytes.AddRange(Encoding.UTF8.GetBytes("{\"type\":\"format\",\"state\":\"lcb1\"}\n"));
+        bytes.AddRange(Frame(BridgeProtocol.FrameJson, Encoding.UTF8.GetBytes("{\"type\":\"cmd\",\"action\":\"toggleClicker\"}")));
+        bytes.AddRange(Frame(BridgeProtocol.FrameState, BuildStatePayload(0, "ChatScreen", "", Array.Empty<(string, float, float, double, float)>())));
+
+        var reader = new BridgeMessageReader(new MemoryStream(bytes.ToArray()));
+
+        BridgeMessage? caps = await reader.ReadAsync(CancellationToken.None);
+        Assert.Equal("{\"type\":\"capabilities\"}", caps?.Text);
+
+        BridgeMessage? ack = await reader.ReadAsync(CancellationToken.None);
+        Assert.True(BridgeProtocol.IsBinaryAck(ack!.Value.Text!));
+        reader.FrameMode = true;
+
+        BridgeMessage? cmd = await reader.ReadAsync(CancellationToken.None);
+        Assert.Equal(BridgeProtocol.FrameJson, cmd?.FrameType);
+        Assert.Contains("toggleClicker", cmd?.Text);
+
+        BridgeMessage? stateFrame = await reader.ReadAsync(CancellationToken.None);
+        Assert.Equal(BridgeProtocol.FrameState, stateFrame?.FrameType);
+        Assert.Equal("ChatScreen", BridgeProtocol.DecodeState(stateFrame!.Value.Payload.Span).ScreenName);
+
+        Assert.Null(await reader.ReadAsync(CancellationToken.None));
+    }
+
+    [Fact]
+    public async Task Reader_RejectsLinesPastThePayloadCap()
+    {
+        var bytes = new byte[BridgeProtocol.MaxPayloadBytes + 64];
+        Array.Fill(bytes, (byte)'x');
+        var reader = new BridgeMessageReader(new MemoryStream(bytes));
+
+        await Assert.ThrowsAsync<InvalidDataException>(() => reader.ReadAsync(CancellationToken.None).AsTask());
+    }
+
+    [Fact]
+    public void Capabilities_AdvertiseBinaryFormatOnlyWhenPayloadListsIt()
+    {
+        BridgeCapabilities fallback = BridgeCapabilities.ForVersionFallback("26.1");
+        Assert.True(fallback.SupportsStateFormat("json"));
+        Assert.False(fallback.SupportsStateFormat(BridgeProtocol.BinaryFormat));
+
+        var payload = new JsonObject
+        {
+            ["type"] = "capabilities",
+            ["modules"] = new JsonArray("autoclicker"),
+            ["formats"] = new JsonArray("json", "LCB1")
+        };
+
+        BridgeCapabilities parsed = BridgeCapabilities.FromPayload(payload, fallback);
+        Assert.True(parsed.SupportsStateFormat(BridgeProtocol.BinaryFormat));
+    }
+
+    private static byte[] StateMsDelta(uint seq, ulong stateMs)
+    {
+        var ms = new MemoryStream();
+        var w = new BinaryWriter(ms);
+        w.Write(seq);
+        w.Write((ushort)BridgeProtocol.DeltaFields.StateMs);
+        w.Write(stateMs);
+        w.Flush();
+        return ms.ToArray();
+    }
+
+    private static byte[] Frame(byte type, byte[] payload)
+    {
+        var frame = new byte[BridgeProtocol.HeaderSize + payload.Length];
+        frame[0] = type;
+        frame[1] = BridgeProtocol.Version;
+        BinaryPrimitives.WriteUInt32LittleEndian(frame.AsSpan(4), (uint)payload.Length);
+        payload.CopyTo(frame, BridgeProtocol.HeaderSize);
+        return frame;
+    }
+
+    private static byte[] BuildStatePayload(ushort flags, string screenName, string actionBar,
+        (string Name, float Sx, float Sy, double Dist, float Hp)[] entities)
+    {
+        var ms = new MemoryStream();
+        var w = new BinaryWriter(ms); // little-endian
+        w.Write(flags);
+        w.Write(20f);      // health
+        w.Write(90f);      // fov
+        w.Write(0f);       // pitch
+        w.Write(0.5f);     // attackCooldown
+        w.Write(0.08f);    // attackCooldownPerTick
+        w.Write(0.0); w.Write(0.0); w.Write(0.0);
+        w.Write(12345UL);  // stateMs
+        WriteStr(w, screenName);
+        WriteStr(w, actionBar);
+        w.Write((ushort)entities.Length);
+        foreach (var e in entities)
+        {
+            w.Write(e.Sx);
+            w.Write(e.Sy);
+            w.Write(e.Dist);
+            w.Write(e.Hp);
+            WriteStr(w, e.Name);
+        }
+        w.Flush();
+        return ms.ToArray();
+    }
+
+    private static void WriteStr(BinaryWriter w, string s)
+    {
+        byte[] bytes = Encoding.UTF8.GetBytes(s);
+        w.Write((ushort)bytes.Length);
+        w.Write(bytes);
+    }
+}
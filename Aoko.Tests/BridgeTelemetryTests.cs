@@ -0,0 +1,55 @@
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class BridgeTelemetryTests
+{
+    private const string Line =
+        "{\"type\":\"telemetry\",\"intervalMs\":1002,\"modules\":[" +
+        "{\"name\":\"chestEsp\",\"runUs\":1500,\"jniCalls\":820,\"runs\":10.0}," +
+        "{\"name\":\"playerList\",\"runUs\":2500,\"jniCalls\":4000,\"runs\":20.0}]," +
+        "\"jniCalls\":4820,\"bytesOut\":20480,\"snapshotLag\":1,\"snapshotAgeMs\":12," +
+        "\"globalRefs\":42,\"weakRefs\":3,\"frameMs\":6.94," +
+        "\"governor\":{\"level\":1,\"busyPct\":3.5,\"pressured\":false}}\n";
+
+    [Fact]
+    public void Parse_ReadsRatesModulesAndGovernor()
+    {
+        BridgeTelemetry? t = BridgeTelemetry.Parse(Line);
+
+        Assert.NotNull(t);
+        Assert.Equal(1002, t!.IntervalMs);
+        Assert.Equal(2, t.Modules.Count);
+        Assert.Equal("chestEsp", t.Modules[0].Name);
+        Assert.Equal(4000, t.Modules[1].JniCallsPerSec);
+        Assert.Equal(4000, t.TotalRunUsPerSec);
+        Assert.Equal(4820, t.JniCallsPerSec);
+        Assert.Equal(20480, t.BytesOutPerSec);
+        Assert.Equal(1, t.SnapshotLag);
+        Assert.Equal(12, t.SnapshotAgeMs);
+        Assert.Equal(42, t.GlobalRefs);
+        Assert.Equal(3, t.WeakRefs);
+        Assert.Equal(6.94, t.FrameMs, 3);
+        Assert.Equal(1, t.GovernorLevel);
+        Assert.Equal(3.5, t.ScanBusyPct, 3);
+    }
+
+    [Fact]
+    public void Parse_WithoutGovernor_ReportsNone()
+    {
+        BridgeTelemetry? t = BridgeTelemetry.Parse("{\"type\":\"telemetry\",\"intervalMs\":1000,\"modules\":[],\"jniCalls\":0}");
+
+        Assert.NotNull(t);
+        Assert.Empty(t!.Modules);
+        Assert.Equal(-1, t.GovernorLevel);
+    }
+
+    [Theory]
+    [InlineData("{\"type\":\"cmd\",\"action\":\"toggleArmed\"}")]
+    [InlineData("{\"type\":\"telemetry\",")]
+    [InlineData("not json")]
+    public void Parse_RejectsOtherLines(string line)
+    {
+        Assert.Null(BridgeTelemetry.Parse(line));
+    }
+}
@@ -0,0 +1,83 @@
+using System.Diagnostics;
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class ClickSchedulerTests
+{
+    private static ClickScheduler.INPUT[] Inputs(params uint[] flags)
+    {
+        var inputs = new ClickScheduler.INPUT[flags.Length];
+        for (int i = 0; i < flags.Length; i++) inputs[i].Mi.DwFlags = flags[i];
+        return inputs;
+    }
+
+    [Fact]
+    public void SendAtAsync_BatchesInputsThatFallDueTogether()
+    {
+        var calls = new List<uint[]>();
+        using var scheduler = new ClickScheduler((inputs, count) =>
+        {
+            lock (calls) calls.Add(inputs.Take(count).Select(i => i.Mi.DwFlags).ToArray());
+            return (uint)count;
+        });
+
+        long due = ClickScheduler.Now + ClickScheduler.FromMs(50);
+        var click = scheduler.SendAtAsync(due, Inputs(2, 4), 2, CancellationToken.None);
+        var move = scheduler.SendAtAsync(due, Inputs(1), 1, CancellationToken.None);
+        Task.WaitAll(click, move);
+
+        Assert.Single(calls);
+        Assert.Equal(new uint[] { 2, 4, 1 }, calls[0]);
+        Assert.True(ClickScheduler.Now >= due - ClickScheduler.FromMs(0.25));
+        Assert.Equal(2, scheduler.Lateness.Count);
+    }
+
+    [Fact]
+    public void SendAtAsync_DropsCancelledInputs()
+    {
+        int sent = 0;
+        using var scheduler = new ClickScheduler((inputs, count) => (uint)Interlocked.Add(ref sent, count));
+        using var cts = new CancellationTokenSource();
+
+        long due = ClickScheduler.Now + ClickScheduler.FromMs(50);
+        var cancelled = scheduler.SendAtAsync(due, Inputs(2, 4), 2, cts.Token);
+        var kept = scheduler.SendAtAsync(due, Inputs(1), 1, CancellationToken.None);
+        cts.Cancel();
+        kept.Wait();
+
+        Assert.True(cancelled.IsCanceled);
+        Assert.Equal(1, sent);
+    }
+
+    [Fact]
+    public void Reanchor_KeepsTheGridUnlessTheLoopFellAnIntervalBehind()
+    {
+        long interval = 1000;
+
+        Assert.Equal(5000, ClickScheduler.Reanchor(0, interval, 5000));
+        Assert.Equal(4500, ClickScheduler.Reanchor(4500, interval, 5000));
+        Assert.Equal(6000, ClickScheduler.Reanchor(6000, interval, 5000));
+        Assert.Equal(5000, ClickScheduler.Reanchor(3000, interval, 5000));
+    }
+
+    [Fact]
+    public void LatenessHistogram_BucketsByPowersOfTwo()
+    {
+        var histogram = new LatenessHistogram();
+        long perUs = Stopwatch.Frequency / 1_000_000;
+
+        histogram.Record(-5);
+        histogram.Record(10 * perUs);
+        histogram.Record(100 * perUs);
+        histogram.Record(1_000_000 * perUs);
+
+        long[] counts = histogram.Snapshot();
+        Assert.Equal(2, counts[0]);
+        Assert.Equal(1, counts[1]);
+        Assert.Equal(1, counts[LatenessHistogram.BucketCount - 1]);
+        Assert.Equal(0.064, histogram.PercentileMs(0.5), 3);
+        Assert.Equal(double.PositiveInfinity, histogram.PercentileMs(1.0));
+        Assert.Equal(1000.0, histogram.MaxMs, 0);
+    }
+}
@@ -46,6 +46,7 @@ public class GameStateAndProfileTests
         Assert.True(profile.LeftClickEnabled);
         Assert.False(profile.TriggerbotEnabled);
         Assert.Equal(100, profile.ReachChance);
+        Assert.Equal(0, profile.OverlayUpdateHz);
         Assert.True(profile.ModuleKeys.ContainsKey("autoclicker"));
     }
 
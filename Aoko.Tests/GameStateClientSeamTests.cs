@@ -1,3 +1,5 @@
+using System.Text;
+using System.Text.Json.Nodes;
 using Aoko.Core;
 
 namespace Aoko.Tests;
@@ -32,4 +34,14 @@ public class GameStateClientSeamTests
         int index = GameStateClient.ModuleListStyleToIndex(style);
         Assert.Equal(expected, index);
     }
+
+    [Theory]
+    [InlineData("{\"type\":\"config\",\"armed\":true}", "{\"type\":\"config\",\"armed\":true,\"configVersion\":7}")]
+    [InlineData("{}", "{\"configVersion\":7}")]
+    public void WithConfigVersion_AppendsTheVersionAsTheLastMember(string payload, string expected)
+    {
+        byte[] data = GameStateClient.WithConfigVersion(Encoding.UTF8.GetBytes(payload), 7);
+        Assert.Equal(expected, Encoding.UTF8.GetString(data));
+        Assert.Equal(7, JsonNode.Parse(data)!["configVersion"]!.GetValue<int>());
+    }
 }
@@ -0,0 +1,112 @@
+using System.Text;
+using System.Text.Json;
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class GameStateReaderTests
+{
+    private const string LegacyLine =
+        "{\"mapped\":true,\"guiOpen\":false,\"screenName\":\"HUD\",\"actionBar\":\"The theme is C_T\",\"health\":18.5," +
+        "\"posX\":1.5,\"posY\":64.000000,\"posZ\":-3.25,\"pitch\":12.5,\"holdingBlock\":true,\"attackCooldown\":0.5," +
+        "\"stateMs\":123456789,\"entities\":[{\"sx\":120.5,\"sy\":44.2,\"dist\":3.25,\"name\":\"Steve\",\"hp\":20.0}]}";
+
+    [Fact]
+    public void Read_MatchesJsonSerializerContract()
+    {
+        var reader = new GameStateJsonReader(new Utf8StringInterner());
+        GameState? state = reader.Read(Encoding.UTF8.GetBytes(LegacyLine));
+        GameState expected = JsonSerializer.Deserialize<GameState>(LegacyLine)!;
+
+        Assert.NotNull(state);
+        Assert.Equal(expected.Mapped, state.Mapped);
+        Assert.Equal(expected.ScreenName, state.ScreenName);
+        Assert.Equal(expected.ActionBar, state.ActionBar);
+        Assert.Equal(expected.Health, state.Health);
+        Assert.Equal(expected.Fov, state.Fov);
+        Assert.Equal(expected.PosZ, state.PosZ);
+        Assert.Equal(expected.Pitch, state.Pitch);
+        Assert.Equal(expected.HoldingBlock, state.HoldingBlock);
+        Assert.Equal(expected.AttackCooldown, state.AttackCooldown);
+        Assert.Equal(expected.AttackCooldownPerTick, state.AttackCooldownPerTick);
+        Assert.Equal(expected.StateMs, state.StateMs);
+        Assert.Single(state.Entities);
+        Assert.Equal("Steve", state.Entities[0].Name);
+        Assert.Equal(44.2f, state.Entities[0].Sy);
+    }
+
+    [Fact]
+    public void Read_LeavesPublishedStatesUntouched()
+    {
+        var reader = new GameStateJsonReader(new Utf8StringInterner());
+        GameState first = reader.Read(Encoding.UTF8.GetBytes(LegacyLine))!;
+        EntityInfo steve = first.Entities[0];
+
+        for (int i = 0; i < 64; i++)
+            Assert.NotSame(first, reader.Read(Encoding.UTF8.GetBytes("{\"type\":\"state\",\"fov\":90}")));
+
+        GameState next = reader.Read(Encoding.UTF8.GetBytes("{\"type\":\"state\",\"entities\":[{\"name\":\"Alex\",\"dist\":2}]}"))!;
+        Assert.NotSame(first.Entities, next.Entities);
+        Assert.NotSame(steve, next.Entities[0]);
+        Assert.False(next.Mapped);
+        Assert.Equal("unknown", next.ScreenName);
+        Assert.Equal(70.0f, next.Fov);
+        Assert.Equal(-1f, next.Health);
+        Assert.Equal(0f, next.Entities[0].Hp);
+
+        Assert.True(first.Mapped);
+        Assert.Equal("HUD", first.ScreenName);
+        Assert.Single(first.Entities);
+        Assert.Same(steve, first.Entities[0]);
+        Assert.Equal("Steve", steve.Name);
+        Assert.Equal(20.0f, steve.Hp);
+    }
+
+    [Fact]
+    public void Read_InternsNamesAcrossPacketsAndUnescapes()
+    {
+        var strings = new Utf8StringInterner();
+        var reader = new GameStateJsonReader(strings);
+        string a = reader.Read(Encoding.UTF8.GetBytes("{\"entities\":[{\"name\":\"Notch\"}]}"))!.Entities[0].Name;
+        string b = reader.Read(Encoding.UTF8.GetBytes("{\"entities\":[{\"name\":\"Notch\"}]}"))!.Entities[0].Name;
+        Assert.Same(a, b);
+
+        GameState escaped = reader.Read(Encoding.UTF8.GetBytes("{\"screenName\":\"Chest \\\"A\\\" \\u00e9\"}"))!;
+        Assert.Equal("Chest \"A\" \u00e9", escaped.ScreenName);
+    }
+
+    [Fact]
+    public void Read_RejectsWrongTypesAndThrowsOnMalformedJson()
+    {
+        var reader = new GameStateJsonReader(new Utf8StringInterner());
+        Assert.Null(reader.Read(Encoding.UTF8.GetBytes("{\"health\":\"full\"}")));
+        Assert.Null(reader.Read(Encoding.UTF8.GetBytes("[1,2]")));
+        Assert.ThrowsAny<JsonException>(() => reader.Read(Encoding.UTF8.GetBytes("{\"health\":")));
+    }
+
+    [Fact]
+    public void Read_CarriesActionBarForwardWhileTheRevisionHolds()
+    {
+        var reader = new GameStateJsonReader(new Utf8StringInterner());
+        Assert.Equal("Hint: _ _", reader.Read(Encoding.UTF8.GetBytes("{\"type\":\"state\",\"actionBar\":\"Hint: _ _\",\"actionBarRev\":3}"))!.ActionBar);
+
+        GameState held = reader.Read(Encoding.UTF8.GetBytes("{\"type\":\"state\",\"actionBarRev\":3}"))!;
+        Assert.Equal(3u, held.ActionBarRev);
+        Assert.Equal("Hint: _ _", held.ActionBar);
+
+        Assert.Equal("", reader.Read(Encoding.UTF8.GetBytes("{\"type\":\"state\",\"actionBar\":\"\",\"actionBarRev\":4}"))!.ActionBar);
+        Assert.Equal("", reader.Read(Encoding.UTF8.GetBytes("{\"type\":\"state\",\"actionBarRev\":4}"))!.ActionBar);
+
+        // Lines without a revision (the 1.8.9 bridge) keep the JsonSerializer default.
+        Assert.Equal("", reader.Read(Encoding.UTF8.GetBytes("{\"guiOpen\":false}"))!.ActionBar);
+    }
+
+    [Fact]
+    public void IsStateLine_SeparatesStateFromControlLines()
+    {
+        Assert.True(GameStateJsonReader.IsStateLine(Encoding.UTF8.GetBytes(LegacyLine)));
+        Assert.True(GameStateJsonReader.IsStateLine(Encoding.UTF8.GetBytes("{\"type\":\"state\",\"guiOpen\":true}")));
+        Assert.False(GameStateJsonReader.IsStateLine(Encoding.UTF8.GetBytes("{\"type\":\"configAck\",\"version\":3}")));
+        Assert.False(GameStateJsonReader.IsStateLine(Encoding.UTF8.GetBytes("{\"type\":\"telemetry\"}")));
+    }
+}
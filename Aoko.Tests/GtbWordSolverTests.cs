@@ -50,6 +50,56 @@ public class GtbWordSolverTests
         Assert.Contains("cat", afterLearn.Matches);
     }
 
+    [Fact]
+    public void Solve_MatchesOnlyWordsWithTheSameSpacing()
+    {
+        PrepareFreshWordList("hot dog", "hat dog", "ho tdog", "hotdogs");
+
+        var result = GtbWordSolver.Solve("The theme is H_T D_G");
+
+        Assert.Equal("h_t d_g", result.Mask);
+        Assert.Equal(new[] { "hot dog", "hat dog" }, result.Matches);
+    }
+
+    [Fact]
+    public void Solve_UsesBakedWordListUnlessTheScriptIsNewer()
+    {
+        string dataDir = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, "Data");
+        string tablePath = Path.Combine(dataDir, "gtb_wordlist.bin");
+        string jsPath = Path.Combine(dataDir, "gtb_wordlist.js");
+        GtbWordListFormat.Write(tablePath, new[] { "cab", "cob" });
+
+        File.SetLastWriteTimeUtc(jsPath, DateTime.UtcNow.AddMinutes(-1));
+        File.SetLastWriteTimeUtc(tablePath, DateTime.UtcNow);
+        ResetSolverState();
+        var baked = GtbWordSolver.Solve("The theme is C_B");
+        Assert.Equal(new[] { "cab", "cob" }, baked.Matches);
+
+        File.SetLastWriteTimeUtc(jsPath, DateTime.UtcNow.AddMinutes(1));
+        ResetSolverState();
+        var script = GtbWordSolver.Solve("The theme is C_B");
+        Assert.Empty(script.Matches);
+        File.Delete(tablePath);
+    }
+
+    [Fact]
+    public void WordList_RoundTripsAndRejectsForeignFiles()
+    {
+        string path = Path.Combine(Path.GetTempPath(), "aoko_gtb_" + Guid.NewGuid().ToString("N") + ".bin");
+        try
+        {
+            GtbWordListFormat.Write(path, new[] { "dog", "cat", "ice cream", "cat" });
+            Assert.Equal(new[] { "cat", "dog", "ice cream" }, GtbWordList.TryRead(path)!);
+
+            File.WriteAllText(path, "const wordsData = [];");
+            Assert.Null(GtbWordList.TryRead(path));
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
     private static void PrepareFreshWordList(params string[] words)
     {
         string dataDir = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, "Data");
@@ -63,6 +113,10 @@ public class GtbWordSolverTests
         if (File.Exists(customPath))
             File.Delete(customPath);
 
+        string tablePath = Path.Combine(dataDir, "gtb_wordlist.bin");
+        if (File.Exists(tablePath))
+            File.Delete(tablePath);
+
         ResetSolverState();
     }
 
@@ -70,6 +124,7 @@ public class GtbWordSolverTests
     {
         SetPrivateStaticField("_words", null);
         SetPrivateStaticField("_wordSet", null);
+        SetPrivateStaticField("_index", null);
         SetPrivateStaticField("_customWordPath", null);
         SetPrivateStaticField("_lastMask", "");
         SetPrivateStaticField("_lastMatches", Array.Empty<string>());
@@ -0,0 +1,144 @@
+using System.Buffers.Binary;
+using System.Runtime.InteropServices;
+using System.Text;
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class SharedMemoryBridgeChannelTests : IDisposable
+{
+    private readonly IntPtr _view;
+    private long _published;
+
+    public SharedMemoryBridgeChannelTests()
+    {
+        _view = Marshal.AllocHGlobal(SharedMemoryBridgeChannel.MappingBytes);
+        Marshal.Copy(new byte[SharedMemoryBridgeChannel.RingOffset], 0, _view, SharedMemoryBridgeChannel.RingOffset);
+        Marshal.WriteInt32(_view, 0, unchecked((int)SharedMemoryBridgeChannel.Magic));
+        Marshal.WriteInt32(_view, 4, (int)SharedMemoryBridgeChannel.Version);
+        Marshal.WriteInt32(_view, 8, SharedMemoryBridgeChannel.SlotCount);
+        Marshal.WriteInt32(_view, 12, SharedMemoryBridgeChannel.SlotBytes);
+    }
+
+    public void Dispose() => Marshal.FreeHGlobal(_view);
+
+    [Fact]
+    public void FromView_RejectsUnknownLayout()
+    {
+        Marshal.WriteInt32(_view, 4, 99);
+
+        Assert.Null(SharedMemoryBridgeChannel.FromView(_view));
+    }
+
+    [Fact]
+    public void Drain_DeliversFramesInOrderOnce()
+    {
+        using var channel = SharedMemoryBridgeChannel.FromView(_view)!;
+        Publish("{\"type\":\"cmd\",\"action\":\"a\"}");
+        Publish("{\"type\":\"cmd\",\"action\":\"b\"}");
+
+        var seen = new List<string>();
+        int applied = channel.Drain(DecodeText, seen.Add);
+
+        Assert.Equal(2, applied);
+        Assert.Equal(new[] { "{\"type\":\"cmd\",\"action\":\"a\"}", "{\"type\":\"cmd\",\"action\":\"b\"}" }, seen);
+        Assert.Equal(0, channel.Drain(DecodeText, seen.Add));
+    }
+
+    [Fact]
+    public void Drain_SkipsToOldestSlotWhenReaderFallsBehind()
+    {
+        using var channel = SharedMemoryBridgeChannel.FromView(_view)!;
+        for (int i = 0; i < SharedMemoryBridgeChannel.SlotCount + 10; i++)
+            Publish("{\"n\":" + i + "}");
+
+        var seen = new List<string>();
+        channel.Drain(DecodeText, seen.Add);
+
+        Assert.Equal(SharedMemoryBridgeChannel.SlotCount, seen.Count);
+        Assert.Equal("{\"n\":10}", seen[0]);
+        Assert.Equal(10, channel.Overruns);
+    }
+
+    [Fact]
+    public void Drain_ReassemblesFramesSplitOverSlots()
+    {
+        using var channel = SharedMemoryBridgeChannel.FromView(_view)!;
+        string big = "{\"type\":\"cmd\",\"blob\":\"" + new string('x', 3 * SharedMemoryBridgeChannel.SlotBytes) + "\"}";
+        Publish("{\"n\":1}");
+        Publish(big);
+        Publish("{\"n\":2}");
+
+        var seen = new List<string>();
+        int applied = channel.Drain(DecodeText, seen.Add);
+
+        Assert.Equal(3, applied);
+        Assert.Equal(new[] { "{\"n\":1}", big, "{\"n\":2}" }, seen);
+        Assert.Equal(6, _published);
+        Assert.Equal(0, channel.Overruns);
+    }
+
+    [Fact]
+    public void Drain_SkipsTheRestOfAFrameWhoseFirstSlotWasOverwritten()
+    {
+        using var channel = SharedMemoryBridgeChannel.FromView(_view)!;
+        Publish("{\"blob\":\"" + new string('x', 2 * SharedMemoryBridgeChannel.SlotBytes) + "\"}");
+        for (int i = 0; i < SharedMemoryBridgeChannel.SlotCount - 2; i++)
+            Publish("{\"n\":" + i + "}");
+
+        // The split frame's first slot now holds the newest frame; its other two remain.
+        var seen = new List<string>();
+        channel.Drain(DecodeText, seen.Add);
+
+        Assert.Equal(SharedMemoryBridgeChannel.SlotCount - 2, seen.Count);
+        Assert.Equal("{\"n\":0}", seen[0]);
+        Assert.DoesNotContain(seen, f => f.Contains("blob"));
+    }
+
+    [Fact]
+    public void WriteConfig_LeavesEvenSequenceAndPayload()
+    {
+        using var channel = SharedMemoryBridgeChannel.FromView(_view)!;
+        byte[] json = Encoding.UTF8.GetBytes("{\"type\":\"config\",\"armed\":true}");
+
+        Assert.True(channel.WriteConfig(json));
+        Assert.True(channel.WriteConfig(json));
+
+        Assert.Equal(4, Marshal.ReadInt32(_view, 24));
+        Assert.Equal(json.Length, Marshal.ReadInt32(_view, 28));
+        var copy = new byte[json.Length];
+        Marshal.Copy(_view + SharedMemoryBridgeChannel.ConfigOffset, copy, 0, copy.Length);
+        Assert.Equal(json, copy);
+    }
+
+    private static string DecodeText(byte frameType, byte version, ReadOnlySpan<byte> payload)
+        => Encoding.UTF8.GetString(payload);
+
+    // Mirrors lc::ShmChannel::Publish, including frames split over several slots.
+    private void Publish(string json)
+    {
+        byte[] payload = Encoding.UTF8.GetBytes(json);
+        var frame = new byte[BridgeProtocol.HeaderSize + payload.Length];
+        frame[0] = BridgeProtocol.FrameJson;
+        frame[1] = BridgeProtocol.Version;
+        BinaryPrimitives.WriteUInt32LittleEndian(frame.AsSpan(4), (uint)payload.Length);
+        payload.CopyTo(frame, BridgeProtocol.HeaderSize);
+
+        const int chunk = SharedMemoryBridgeChannel.SlotBytes - 16;
+        int parts = (frame.Length + chunk - 1) / chunk;
+        for (int i = 0; i < parts; i++)
+        {
+            long n = _published + 1 + i;
+            int len = Math.Min(chunk, frame.Length - i * chunk);
+            IntPtr slot = _view + SharedMemoryBridgeChannel.RingOffset
+                + (int)((n - 1) % SharedMemoryBridgeChannel.SlotCount) * SharedMemoryBridgeChannel.SlotBytes;
+            Marshal.WriteInt64(slot, 0, 0);
+            Marshal.WriteInt32(slot, 8, len);
+            Marshal.WriteInt32(slot, 12, i == 0 ? parts : 0);
+            Marshal.Copy(frame, i * chunk, slot + 16, len);
+            Marshal.WriteInt64(slot, 0, n);
+        }
+        _published += parts;
+        Marshal.WriteInt64(_view, 16, _published);
+    }
+}
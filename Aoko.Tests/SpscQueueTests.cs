@@ -0,0 +1,57 @@
+using Aoko.Core;
+
+namespace Aoko.Tests;
+
+public class SpscQueueTests
+{
+    [Fact]
+    public void TryEnqueue_RejectsWhenFullAndCountsDrops()
+    {
+        var queue = new SpscQueue<int>(3);
+        Assert.Equal(4, queue.Capacity);
+
+        for (int i = 0; i < 4; i++) Assert.True(queue.TryEnqueue(i));
+        Assert.False(queue.TryEnqueue(99));
+        Assert.Equal(1, queue.Dropped);
+
+        Assert.True(queue.TryDequeue(out int first));
+        Assert.Equal(0, first);
+        Assert.True(queue.TryEnqueue(4));
+
+        var rest = new List<int>();
+        while (queue.TryDequeue(out int item)) rest.Add(item);
+        Assert.Equal(new[] { 1, 2, 3, 4 }, rest);
+        Assert.Equal(0, queue.Count);
+    }
+
+    [Fact]
+    public void ProducerAndConsumerThreads_SeeEveryItemInOrder()
+    {
+        const int total = 200_000;
+        var queue = new SpscQueue<long>(64);
+
+        var producer = new Thread(() =>
+        {
+            for (long i = 0; i < total; i++)
+            {
+                while (!queue.TryEnqueue(i)) Thread.Yield();
+            }
+        });
+        producer.Start();
+
+        long expected = 0;
+        while (expected < total)
+        {
+            if (!queue.TryDequeue(out long item))
+            {
+                Thread.Yield();
+                continue;
+            }
+            Assert.Equal(expected, item);
+            expected++;
+        }
+        producer.Join();
+
+        Assert.Equal(0, queue.Count);
+    }
+}
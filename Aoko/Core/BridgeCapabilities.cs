@@ -9,16 +9,25 @@ public sealed class BridgeCapabilities
     private readonly HashSet<string> _modules;
     private readonly HashSet<string> _settings;
     private readonly HashSet<string> _stateFields;
+    private readonly HashSet<string> _formats;
+    private readonly HashSet<string> _transports;
+    private readonly HashSet<string> _streams;
 
     public int ModuleCount => _modules.Count;
     public int SettingCount => _settings.Count;
     public int StateFieldCount => _stateFields.Count;
 
-    private BridgeCapabilities(HashSet<string> modules, HashSet<string> settings, HashSet<string> stateFields)
+    private BridgeCapabilities(HashSet<string> modules, HashSet<string> settings, HashSet<string> stateFields,
+        HashSet<string>? formats = null, HashSet<string>? transports = null, HashSet<string>? streams = null)
     {
         _modules = modules;
         _settings = settings;
         _stateFields = stateFields;
+        // Every bridge speaks JSON lines; binary formats are opt-in via the payload.
+        _formats = formats ?? BuildSet("json");
+        _transports = transports ?? BuildSet("tcp");
+        // Optional bridge -> loader streams (telemetry); none unless announced.
+        _streams = streams ?? BuildSet();
     }
 
     public static BridgeCapabilities ForVersionFallback(string? injectedVersion)
@@ -92,6 +101,7 @@ public sealed class BridgeCapabilities
                     "showmodulelist",
                     "moduleliststyle",
                     "showlogo",
+                    "overlayupdatehz",
                     "guitheme",
                     "autototemenabled",
                     "autototemmode",
@@ -164,6 +174,7 @@ public sealed class BridgeCapabilities
                 "showmodulelist",
                 "moduleliststyle",
                 "showlogo",
+                "overlayupdatehz",
                 "guitheme",
                 "keybindautoclicker",
                 "keybindspeedbridge",
@@ -191,6 +202,11 @@ public sealed class BridgeCapabilities
         var modules = ParseStringArray(node?["modules"]);
         var settings = ParseStringArray(node?["settings"]);
         var stateFields = ParseStringArray(node?["state"]);
+        var formats = ParseStringArray(node?["formats"]);
+        formats.Add("json");
+        var transports = ParseStringArray(node?["transports"]);
+        transports.Add("tcp");
+        var streams = ParseStringArray(node?["streams"]);
 
         if (modules.Count == 0 && settings.Count == 0 && stateFields.Count == 0)
             return fallback;
@@ -199,7 +215,7 @@ public sealed class BridgeCapabilities
         if (settings.Count == 0) settings = new HashSet<string>(fallback._settings, StringComparer.OrdinalIgnoreCase);
         if (stateFields.Count == 0) stateFields = new HashSet<string>(fallback._stateFields, StringComparer.OrdinalIgnoreCase);
 
-        return new BridgeCapabilities(modules, settings, stateFields);
+        return new BridgeCapabilities(modules, settings, stateFields, formats, transports, streams);
     }
 
     public bool SupportsModule(string moduleId)
@@ -211,6 +227,15 @@ public sealed class BridgeCapabilities
     public bool SupportsStateField(string fieldName)
         => _stateFields.Contains(Normalize(fieldName));
 
+    public bool SupportsStateFormat(string formatName)
+        => _formats.Contains(Normalize(formatName));
+
+    public bool SupportsTransport(string transportName)
+        => _transports.Contains(Normalize(transportName));
+
+    public bool SupportsStream(string streamName)
+        => _streams.Contains(Normalize(streamName));
+
     private static HashSet<string> BuildSet(params string[] values)
     {
         var set = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
@@ -0,0 +1,96 @@
+using System;
+using System.Collections.Generic;
+using System.Text.Json.Nodes;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// Where a bridge listens: a loopback port derived from the game's PID, so several injected
+/// clients each get their own (bridge_endpoint.h computes the same list). The home port is
+/// <see cref="BasePort"/> + 1 + (pid / 4) % <see cref="PortRange"/>; a bridge whose home port
+/// is taken moves on to the next ones, so the capabilities packet names the PID it serves.
+/// LC_BRIDGE_PORT pins the bridge to one port; the loader tries it first when it is set in its
+/// own environment too (a game launched from the loader inherits it).
+/// </summary>
+internal static class BridgeEndpoint
+{
+    public const int BasePort = 25590;
+    public const int PortRange = 4096;
+    public const int Probes = 8;
+    public const string OverrideVariable = "LC_BRIDGE_PORT";
+
+    /// <summary>
+    /// Ports a bridge in process <paramref name="pid"/> may listen on: the LC_BRIDGE_PORT override
+    /// when set, then the PID-derived ones in the order the bridge tries them.
+    /// </summary>
+    public static IEnumerable<int> CandidatePorts(int pid) =>
+        CandidatePorts(pid, OverridePort(Environment.GetEnvironmentVariable(OverrideVariable)));
+
+    /// <summary>Same as <see cref="CandidatePorts(int)"/> with an explicit override (0 = none).</summary>
+    public static IEnumerable<int> CandidatePorts(int pid, int overridePort)
+    {
+        if (overridePort > 0)
+            yield return overridePort;
+        for (int i = 0; i < Probes; i++)
+        {
+            int port = BasePort + 1 + (int)(((uint)pid / 4 + (uint)i) % PortRange);
+            if (port != overridePort)
+                yield return port;
+        }
+    }
+
+    /// <summary>
+    /// The port an LC_BRIDGE_PORT value pins, or 0 when unset or not a port. Parses like the
+    /// bridge's strtol: leading blanks and digits, anything after them ignored.
+    /// </summary>
+    public static int OverridePort(string? value)
+    {
+        if (string.IsNullOrEmpty(value))
+            return 0;
+        int i = 0;
+        while (i < value.Length && char.IsWhiteSpace(value[i]))
+            i++;
+        if (i < value.Length && value[i] == '+')
+            i++;
+        long port = 0;
+        int start = i;
+        while (i < value.Length && value[i] >= '0' && value[i] <= '9' && port < 65536)
+            port = port * 10 + (value[i++] - '0');
+        return i > start && port > 0 && port < 65536 ? (int)port : 0;
+    }
+
+    /// <summary>
+    /// False when the capabilities packet announces a different process than
+    /// <paramref name="pid"/>: another game's bridge took this port. Packets without a PID are accepted.
+    /// </summary>
+    public static bool ServesProcess(JsonNode? capabilities, int pid)
+    {
+        JsonNode? announced = capabilities?["pid"];
+        if (announced == null || pid <= 0)
+            return true;
+        try
+        {
+            return announced.GetValue<long>() == pid;
+        }
+        catch (Exception ex) when (ex is FormatException or InvalidOperationException)
+        {
+            return false;
+        }
+    }
+
+    /// <summary>
+    /// How many loaders the bridge has served, this one included: 1 right after injection, more
+    /// when a resident bridge is resumed. 0 when the packet does not say (older bridges).
+    /// </summary>
+    public static int SessionOf(JsonNode? capabilities)
+    {
+        try
+        {
+            return capabilities?["session"]?.GetValue<int>() ?? 0;
+        }
+        catch (Exception ex) when (ex is FormatException or InvalidOperationException)
+        {
+            return 0;
+        }
+    }
+}
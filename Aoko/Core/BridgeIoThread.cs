@@ -0,0 +1,87 @@
+using System;
+using System.Collections.Concurrent;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// One background thread that runs the socket loops of every bridge session. Loops started
+/// with <see cref="Run"/> resume there after each await, so N connected games cost one
+/// thread instead of two pool tasks per game; their I/O itself is asynchronous and only
+/// the short parse / apply steps run on this thread. Nothing here may block: the
+/// shared-memory reader waits for its event through a registered pool wait.
+/// </summary>
+internal static class BridgeIoThread
+{
+    private static readonly BlockingCollection<(SendOrPostCallback Callback, object? State)> _queue = new();
+    private static readonly LoopContext _context = new();
+    private static readonly Thread _thread = Start();
+
+    public static int ManagedThreadId => _thread.ManagedThreadId;
+
+    /// <summary>Starts <paramref name="loop"/> on the I/O thread; the task completes when the loop does.</summary>
+    public static Task Run(Func<Task> loop)
+    {
+        var done = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        _context.Post(async _ =>
+        {
+            try
+            {
+                await loop();
+                done.TrySetResult();
+            }
+            catch (OperationCanceledException)
+            {
+                done.TrySetCanceled();
+            }
+            catch (Exception ex)
+            {
+                done.TrySetException(ex);
+            }
+        }, null);
+        return done.Task;
+    }
+
+    private static Thread Start()
+    {
+        var thread = new Thread(Pump) { IsBackground = true, Name = "Bridge I/O" };
+        thread.Start();
+        return thread;
+    }
+
+    private static void Pump()
+    {
+        SynchronizationContext.SetSynchronizationContext(_context);
+        foreach (var (callback, state) in _queue.GetConsumingEnumerable())
+        {
+            try
+            {
+                callback(state);
+            }
+            catch (Exception ex)
+            {
+                System.Diagnostics.Debug.WriteLine($"[BridgeIoThread] {ex.Message}");
+            }
+        }
+    }
+
+    private sealed class LoopContext : SynchronizationContext
+    {
+        public override void Post(SendOrPostCallback d, object? state) => _queue.Add((d, state));
+
+        public override void Send(SendOrPostCallback d, object? state)
+        {
+            if (Thread.CurrentThread == _thread)
+            {
+                d(state);
+                return;
+            }
+            using var done = new ManualResetEventSlim();
+            Post(s => { try { d(s); } finally { done.Set(); } }, state);
+            done.Wait();
+        }
+
+        public override SynchronizationContext CreateCopy() => this;
+    }
+}
@@ -0,0 +1,50 @@
+using System;
+using System.Text.Json.Nodes;
+
+namespace Aoko.Core;
+
+/// <summary>Where a module's game mappings stand on the bridge.</summary>
+public enum ModuleResolveState
+{
+    /// <summary>Never reported (or reset by a remap); the module is assumed usable.</summary>
+    Unknown,
+    Resolving,
+    Ready,
+    Failed
+}
+
+/// <summary>
+/// "moduleState" lines from a bridge that lists the stream in its capabilities "streams"
+/// array. The 26.1 bridge resolves a module's mappings the first time the module is switched
+/// on and reports each step; layout in McInjector/src/main/cpp/bridge_261.cpp (LAZY MODULE MAPPINGS).
+/// </summary>
+public static class BridgeModuleState
+{
+    public const string StreamName = "moduleState";
+
+    /// <summary>Parses a moduleState line; false for anything else or a malformed line.</summary>
+    public static bool TryParse(string json, out string moduleId, out ModuleResolveState state)
+    {
+        moduleId = "";
+        state = ModuleResolveState.Unknown;
+        try
+        {
+            JsonNode? node = JsonNode.Parse(json);
+            if (!string.Equals(node?["type"]?.GetValue<string>(), StreamName, StringComparison.OrdinalIgnoreCase))
+                return false;
+            moduleId = (node?["module"]?.GetValue<string>() ?? "").Trim().ToLowerInvariant();
+            state = (node?["state"]?.GetValue<string>() ?? "").ToLowerInvariant() switch
+            {
+                "resolving" => ModuleResolveState.Resolving,
+                "ready" => ModuleResolveState.Ready,
+                "failed" => ModuleResolveState.Failed,
+                _ => ModuleResolveState.Unknown
+            };
+            return moduleId.Length > 0;
+        }
+        catch (Exception ex) when (ex is System.Text.Json.JsonException or FormatException or InvalidOperationException)
+        {
+            return false;
+        }
+    }
+}
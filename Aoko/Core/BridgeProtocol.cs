@@ -0,0 +1,422 @@
+using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// "lcb1" binary framing used by bridges that advertise it in their capabilities
+/// "formats" array. Layout is documented in McInjector/src/main/cpp/bridge_protocol.h.
+/// </summary>
+internal static class BridgeProtocol
+{
+    public const string BinaryFormat = "lcb1";
+    public const string DeltaFormat = "lcb1-delta";
+    public const int HeaderSize = 8;
+    public const byte Version = 2;
+    public const int MaxPayloadBytes = 1 << 20;
+
+    public const byte FrameState = 1;
+    public const byte FrameJson = 2;
+    public const byte FrameStateDelta = 3;
+
+    [Flags]
+    public enum StateFlags : ushort
+    {
+        None = 0,
+        GuiOpen = 1 << 0,
+        HoldingBlock = 1 << 1,
+        LookingAtBlock = 1 << 2,
+        LookingAtEntity = 1 << 3,
+        LookingAtEntityLatched = 1 << 4,
+        BreakingBlock = 1 << 5,
+        Mapped = 1 << 6
+    }
+
+    [Flags]
+    public enum DeltaFields : ushort
+    {
+        None = 0,
+        Flags = 1 << 0,
+        Health = 1 << 1,
+        Fov = 1 << 2,
+        Pitch = 1 << 3,
+        AttackCooldown = 1 << 4,
+        AttackCooldownPerTick = 1 << 5,
+        Pos = 1 << 6,
+        StateMs = 1 << 7,
+        ScreenName = 1 << 8,
+        ActionBar = 1 << 9,
+        Entities = 1 << 10,
+        Tick = 1 << 11,
+        ActionBarRev = 1 << 12
+    }
+
+    public const string KeyframeRequestLine = "{\"type\":\"keyframe\"}\n";
+
+    public static string FormatRequestLine(string format, bool delta = false)
+        => "{\"type\":\"format\",\"state\":\"" + format + "\"" + (delta ? ",\"delta\":true" : "") + "}\n";
+
+    public static bool IsBinaryAck(string line)
+        => line.Contains("\"state\":\"" + BinaryFormat + "\"", StringComparison.OrdinalIgnoreCase);
+
+    public static bool IsDeltaAck(string line)
+        => IsBinaryAck(line) && line.Contains("\"delta\":true", StringComparison.OrdinalIgnoreCase);
+
+    /// <summary>
+    /// Decodes a STATE payload. Throws <see cref="FormatException"/> if it is truncated;
+    /// trailing bytes beyond the known fields are ignored, and the tick trailer is optional so
+    /// frames from bridges that predate it still decode.
+    /// </summary>
+    public static GameState DecodeState(ReadOnlySpan<byte> payload)
+    {
+        var r = new SpanReader(payload);
+        var state = new GameState();
+        ApplyFlags(state, (StateFlags)r.U16());
+        state.Health = r.F32();
+        state.Fov = r.F32();
+        state.Pitch = r.F32();
+        state.AttackCooldown = r.F32();
+        state.AttackCooldownPerTick = r.F32();
+        state.PosX = r.F64();
+        state.PosY = r.F64();
+        state.PosZ = r.F64();
+        state.StateMs = r.U64();
+        state.ScreenName = r.Str();
+        state.ActionBar = r.Str();
+
+        int count = r.U16();
+        state.Entities = new(count);
+        for (int i = 0; i < count; i++)
+            state.Entities.Add(ReadEntity(ref r));
+        if (r.Remaining >= 12)
+        {
+            state.Tick = r.U32();
+            state.TickSampleMs = r.U64();
+            if (r.Remaining >= 4)
+                state.ActionBarRev = r.U32();
+        }
+        return state;
+    }
+
+    /// <summary>
+    /// Applies a version-2 STATE_DELTA payload to <paramref name="baseState"/> and returns the
+    /// result as a new object; the base is not modified and keeps sharing its entity list only
+    /// when the delta leaves entities alone.
+    /// </summary>
+    public static GameState ApplyStateDelta(GameState baseState, ReadOnlySpan<byte> payload, out uint seq)
+    {
+        var r = new SpanReader(payload);
+        seq = r.U32();
+        var mask = (DeltaFields)r.U16();
+
+        var state = new GameState
+        {
+            Mapped = baseState.Mapped,
+            GuiOpen = baseState.GuiOpen,
+            HoldingBlock = baseState.HoldingBlock,
+            LookingAtBlock = baseState.LookingAtBlock,
+            LookingAtEntity = baseState.LookingAtEntity,
+            LookingAtEntityLatched = baseState.LookingAtEntityLatched,
+            BreakingBlock = baseState.BreakingBlock,
+            Health = baseState.Health,
+            Fov = baseState.Fov,
+            Pitch = baseState.Pitch,
+            AttackCooldown = baseState.AttackCooldown,
+            AttackCooldownPerTick = baseState.AttackCooldownPerTick,
+            PosX = baseState.PosX,
+            PosY = baseState.PosY,
+            PosZ = baseState.PosZ,
+            StateMs = baseState.StateMs,
+            Tick = baseState.Tick,
+            TickSampleMs = baseState.TickSampleMs,
+            ScreenName = baseState.ScreenName,
+            ActionBar = baseState.ActionBar,
+            ActionBarRev = baseState.ActionBarRev,
+            Entities = baseState.Entities
+        };
+
+        if (mask.HasFlag(DeltaFields.Flags)) ApplyFlags(state, (StateFlags)r.U16());
+        if (mask.HasFlag(DeltaFields.Health)) state.Health = r.F32();
+        if (mask.HasFlag(DeltaFields.Fov)) state.Fov = r.F32();
+        if (mask.HasFlag(DeltaFields.Pitch)) state.Pitch = r.F32();
+        if (mask.HasFlag(DeltaFields.AttackCooldown)) state.AttackCooldown = r.F32();
+        if (mask.HasFlag(DeltaFields.AttackCooldownPerTick)) state.AttackCooldownPerTick = r.F32();
+        if (mask.HasFlag(DeltaFields.Pos))
+        {
+            state.PosX = r.F64();
+            state.PosY = r.F64();
+            state.PosZ = r.F64();
+        }
+        if (mask.HasFlag(DeltaFields.StateMs)) state.StateMs = r.U64();
+        if (mask.HasFlag(DeltaFields.ScreenName)) state.ScreenName = r.Str();
+        if (mask.HasFlag(DeltaFields.ActionBar)) state.ActionBar = r.Str();
+        if (mask.HasFlag(DeltaFields.Entities))
+        {
+            // Index-based, so the list keeps the bridge's (distance) order and repeated
+            // names cannot hit the wrong record.
+            int count = r.U16();
+            var entities = new EntityInfo?[count];
+            for (int i = 0; i < count && i < baseState.Entities.Count; i++)
+                entities[i] = baseState.Entities[i];
+            int changed = r.U16();
+            for (int i = 0; i < changed; i++)
+            {
+                int at = r.U16();
+                EntityInfo e = ReadEntity(ref r);
+                if (at >= count) throw new FormatException("Entity index past the delta's entity count.");
+                entities[at] = e;
+            }
+            foreach (EntityInfo? e in entities)
+            {
+                if (e == null) throw new FormatException("Delta leaves an entity slot unset.");
+            }
+            state.Entities = new List<EntityInfo>(entities!);
+        }
+        if (mask.HasFlag(DeltaFields.Tick))
+        {
+            state.Tick = r.U32();
+            state.TickSampleMs = r.U64();
+        }
+        if (mask.HasFlag(DeltaFields.ActionBarRev)) state.ActionBarRev = r.U32();
+        return state;
+    }
+
+    private static void ApplyFlags(GameState state, StateFlags flags)
+    {
+        state.Mapped = flags.HasFlag(StateFlags.Mapped);
+        state.GuiOpen = flags.HasFlag(StateFlags.GuiOpen);
+        state.HoldingBlock = flags.HasFlag(StateFlags.HoldingBlock);
+        state.LookingAtBlock = flags.HasFlag(StateFlags.LookingAtBlock);
+        state.LookingAtEntity = flags.HasFlag(StateFlags.LookingAtEntity);
+        state.LookingAtEntityLatched = flags.HasFlag(StateFlags.LookingAtEntityLatched);
+        state.BreakingBlock = flags.HasFlag(StateFlags.BreakingBlock);
+    }
+
+    private static EntityInfo ReadEntity(ref SpanReader r)
+        => new()
+        {
+            Sx = r.F32(),
+            Sy = r.F32(),
+            Dist = r.F64(),
+            Hp = r.F32(),
+            Name = r.Str()
+        };
+
+    private ref struct SpanReader
+    {
+        private readonly ReadOnlySpan<byte> _data;
+        private int _pos;
+
+        public SpanReader(ReadOnlySpan<byte> data)
+        {
+            _data = data;
+            _pos = 0;
+        }
+
+        public int Remaining => _data.Length - _pos;
+
+        private ReadOnlySpan<byte> Take(int n)
+        {
+            if (_pos + n > _data.Length)
+                throw new FormatException("Truncated bridge state frame.");
+            var s = _data.Slice(_pos, n);
+            _pos += n;
+            return s;
+        }
+
+        public uint U32() => BinaryPrimitives.ReadUInt32LittleEndian(Take(4));
+        public ushort U16() => BinaryPrimitives.ReadUInt16LittleEndian(Take(2));
+        public ulong U64() => BinaryPrimitives.ReadUInt64LittleEndian(Take(8));
+        public float F32() => BinaryPrimitives.ReadSingleLittleEndian(Take(4));
+        public double F64() => BinaryPrimitives.ReadDoubleLittleEndian(Take(8));
+        public string Str() => Utf8StringInterner.ForCurrentThread.Intern(Take(U16()));
+    }
+}
+
+/// <summary>
+/// Rebuilds full states from lcb1 keyframes and deltas. A delta that does not follow the
+/// previous frame (dropped shm slot, reconnect) or does not decode is discarded, and the caller
+/// is asked once to request a keyframe; deltas are ignored until it arrives.
+/// </summary>
+internal sealed class BridgeStateAssembler
+{
+    private GameState? _last;
+    private uint _seq;
+    private bool _keyframeRequested;
+
+    public GameState AcceptKeyframe(GameState state)
+    {
+        _last = state;
+        _seq = 0;
+        _keyframeRequested = false;
+        return state;
+    }
+
+    public GameState? ApplyDelta(ReadOnlySpan<byte> payload)
+    {
+        if (_last == null) return null;
+        GameState next;
+        uint seq;
+        try
+        {
+            next = BridgeProtocol.ApplyStateDelta(_last, payload, out seq);
+        }
+        catch (FormatException)
+        {
+            _last = null;
+            return null;
+        }
+        if (seq != _seq + 1)
+        {
+            _last = null;
+            return null;
+        }
+        _last = next;
+        _seq = seq;
+        return next;
+    }
+
+    /// <summary>True once per gap, when the caller should send a keyframe request.</summary>
+    public bool TakeKeyframeRequest()
+    {
+        if (_last != null || _keyframeRequested) return false;
+        _keyframeRequested = true;
+        return true;
+    }
+}
+
+/// <summary>
+/// One message from the bridge: a JSON text (line, or FRAME_JSON frame) or a binary payload.
+/// <see cref="Body"/> points into the reader's buffer and is only valid until the next
+/// <see cref="BridgeMessageReader.ReadAsync"/>; <see cref="Text"/> decodes it on each call.
+/// </summary>
+internal readonly struct BridgeMessage
+{
+    public BridgeMessage(byte frameType, byte version, ReadOnlyMemory<byte> body)
+    {
+        FrameType = frameType;
+        Version = version;
+        Body = body;
+    }
+
+    public byte FrameType { get; }
+    public byte Version { get; }
+    public ReadOnlyMemory<byte> Body { get; }
+
+    public bool IsText => FrameType == BridgeProtocol.FrameJson;
+
+    /// <summary>UTF-8 JSON of a text message; empty for binary ones.</summary>
+    public ReadOnlySpan<byte> Utf8 => IsText ? Body.Span : default;
+
+    public string? Text => IsText ? Encoding.UTF8.GetString(Body.Span) : null;
+
+    /// <summary>Payload of a binary frame; empty for text messages.</summary>
+    public ReadOnlyMemory<byte> Payload => IsText ? default : Body;
+}
+
+/// <summary>
+/// Buffered reader over the bridge stream. Starts in line mode; once the caller sets
+/// <see cref="FrameMode"/> (after the format ack) it reads lcb1 frames. Bytes already
+/// buffered past the ack line are kept, so the switch loses nothing. Messages are handed
+/// out as slices of the buffer, so reading copies nothing per line or frame. Lines and frame
+/// payloads share the <see cref="BridgeProtocol.MaxPayloadBytes"/> cap; a peer that exceeds it
+/// gets an <see cref="InvalidDataException"/> instead of an ever-growing buffer.
+/// </summary>
+internal sealed class BridgeMessageReader
+{
+    private readonly Stream _stream;
+    private byte[] _buf = new byte[16 * 1024];
+    private int _start;
+    private int _end;
+
+    public BridgeMessageReader(Stream stream)
+    {
+        _stream = stream;
+    }
+
+    public bool FrameMode { get; set; }
+
+    /// <summary>Returns null at end of stream.</summary>
+    public async ValueTask<BridgeMessage?> ReadAsync(CancellationToken token)
+    {
+        while (true)
+        {
+            BridgeMessage? msg = FrameMode ? TryTakeFrame() : TryTakeLine();
+            if (msg != null) return msg;
+            if (!await FillAsync(token)) return null;
+        }
+    }
+
+    private BridgeMessage? TryTakeLine()
+    {
+        int available = _end - _start;
+        int nl = Array.IndexOf(_buf, (byte)'\n', _start, Math.Min(available, BridgeProtocol.MaxPayloadBytes + 1));
+        if (nl < 0)
+        {
+            if (available > BridgeProtocol.MaxPayloadBytes)
+                throw new InvalidDataException($"Bridge line longer than {BridgeProtocol.MaxPayloadBytes} bytes.");
+            return null;
+        }
+        int len = nl - _start;
+        if (len > 0 && _buf[nl - 1] == (byte)'\r') len--;
+        var line = new ReadOnlyMemory<byte>(_buf, _start, len);
+        _start = nl + 1;
+        return new BridgeMessage(BridgeProtocol.FrameJson, BridgeProtocol.Version, line);
+    }
+
+    private BridgeMessage? TryTakeFrame()
+    {
+        int available = _end - _start;
+        if (available < BridgeProtocol.HeaderSize) return null;
+
+        var header = new ReadOnlySpan<byte>(_buf, _start, BridgeProtocol.HeaderSize);
+        byte type = header[0];
+        byte version = header[1];
+        uint length = BinaryPrimitives.ReadUInt32LittleEndian(header.Slice(4));
+        if (length > BridgeProtocol.MaxPayloadBytes)
+            throw new InvalidDataException($"Bridge frame too large ({length} bytes).");
+
+        int total = BridgeProtocol.HeaderSize + (int)length;
+        if (available < total)
+        {
+            EnsureCapacity(total);
+            return null;
+        }
+
+        var payload = new ReadOnlyMemory<byte>(_buf, _start + BridgeProtocol.HeaderSize, (int)length);
+        _start += total;
+        return new BridgeMessage(type, version, payload);
+    }
+
+    private void EnsureCapacity(int needed)
+    {
+        if (needed <= _buf.Length) return;
+        var bigger = new byte[Math.Max(needed, _buf.Length * 2)];
+        Buffer.BlockCopy(_buf, _start, bigger, 0, _end - _start);
+        _end -= _start;
+        _start = 0;
+        _buf = bigger;
+    }
+
+    private async ValueTask<bool> FillAsync(CancellationToken token)
+    {
+        if (_start > 0)
+        {
+            Buffer.BlockCopy(_buf, _start, _buf, 0, _end - _start);
+            _end -= _start;
+            _start = 0;
+        }
+        if (_end == _buf.Length)
+            EnsureCapacity(_buf.Length * 2);
+
+        int read = await _stream.ReadAsync(_buf.AsMemory(_end, _buf.Length - _end), token);
+        if (read <= 0) return false;
+        _end += read;
+        return true;
+    }
+}
@@ -0,0 +1,113 @@
+using System;
+using System.Collections.Generic;
+using System.Text.Json.Nodes;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// One 1 Hz "telemetry" line from a bridge that lists the stream in its capabilities
+/// "streams" array. Rates are per second over <see cref="IntervalMs"/>; layout in
+/// McInjector/src/main/cpp/telemetry.h.
+/// </summary>
+public sealed class BridgeTelemetry
+{
+    public const string StreamName = "telemetry";
+
+    /// <summary>Sent once the capabilities list the stream; bridges send nothing until asked.</summary>
+    public const string EnableRequestLine = "{\"type\":\"telemetry\",\"state\":\"on\"}\n";
+
+    public sealed record Module(string Name, double RunUsPerSec, double JniCallsPerSec, double RunsPerSec);
+
+    public DateTime ReceivedAt { get; init; } = DateTime.Now;
+    public int IntervalMs { get; init; }
+    public IReadOnlyList<Module> Modules { get; init; } = Array.Empty<Module>();
+    public double JniCallsPerSec { get; init; }
+    public double BytesOutPerSec { get; init; }
+    public long SnapshotLag { get; init; }
+    public long SnapshotAgeMs { get; init; }
+    public long GlobalRefs { get; init; }
+    public long WeakRefs { get; init; }
+    public double FrameMs { get; init; }
+
+    /// <summary>Scan governor back-off level; -1 when the bridge runs none.</summary>
+    public int GovernorLevel { get; init; } = -1;
+    public double ScanBusyPct { get; init; }
+
+    /// <summary>Module run time summed over all modules, microseconds per second.</summary>
+    public double TotalRunUsPerSec
+    {
+        get
+        {
+            double total = 0;
+            foreach (Module m in Modules) total += m.RunUsPerSec;
+            return total;
+        }
+    }
+
+    /// <summary>Parses a telemetry line; null for anything else or a malformed line.</summary>
+    public static BridgeTelemetry? Parse(string json)
+    {
+        JsonNode? node;
+        try
+        {
+            node = JsonNode.Parse(json);
+        }
+        catch (System.Text.Json.JsonException)
+        {
+            return null;
+        }
+        if (!string.Equals(ReadString(node?["type"]), StreamName, StringComparison.OrdinalIgnoreCase))
+            return null;
+
+        var modules = new List<Module>();
+        if (node?["modules"] is JsonArray arr)
+        {
+            foreach (JsonNode? m in arr)
+            {
+                string name = ReadString(m?["name"]);
+                if (name.Length == 0) continue;
+                modules.Add(new Module(name, ReadDouble(m?["runUs"]), ReadDouble(m?["jniCalls"]), ReadDouble(m?["runs"])));
+            }
+        }
+
+        JsonNode? governor = node?["governor"];
+        return new BridgeTelemetry
+        {
+            IntervalMs = (int)ReadDouble(node?["intervalMs"]),
+            Modules = modules,
+            JniCallsPerSec = ReadDouble(node?["jniCalls"]),
+            BytesOutPerSec = ReadDouble(node?["bytesOut"]),
+            SnapshotLag = (long)ReadDouble(node?["snapshotLag"]),
+            SnapshotAgeMs = (long)ReadDouble(node?["snapshotAgeMs"]),
+            GlobalRefs = (long)ReadDouble(node?["globalRefs"]),
+            WeakRefs = (long)ReadDouble(node?["weakRefs"]),
+            FrameMs = ReadDouble(node?["frameMs"]),
+            GovernorLevel = governor != null ? (int)ReadDouble(governor["level"]) : -1,
+            ScanBusyPct = governor != null ? ReadDouble(governor["busyPct"]) : 0
+        };
+    }
+
+    private static string ReadString(JsonNode? node)
+    {
+        try
+        {
+            return node?.GetValue<string>() ?? "";
+        }
+        catch (Exception ex) when (ex is FormatException or InvalidOperationException)
+        {
+            return "";
+        }
+    }
+
+    private static double ReadDouble(JsonNode? node)
+    {
+        try
+        {
+            return node?.GetValue<double>() ?? 0;
+        }
+        catch (Exception ex) when (ex is FormatException or InvalidOperationException)
+        {
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,388 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+using Microsoft.Win32.SafeHandles;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// Timing thread for the click, aim-assist and triggerbot loops. It sleeps on a
+/// high-resolution waitable timer (CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, Windows 10
+/// 1803+), so deadlines are met to well under a millisecond without timeBeginPeriod
+/// raising the tick rate for the whole machine; older systems get a plain waitable
+/// timer. Deadlines are absolute Stopwatch timestamps, and inputs that fall due
+/// together go out in one SendInput call. This thread is the only caller of SendInput.
+/// </summary>
+internal sealed class ClickScheduler : IDisposable
+{
+    [DllImport("user32.dll", SetLastError = true)]
+    private static extern uint SendInput(uint nInputs, INPUT[] pInputs, int cbSize);
+
+    [DllImport("kernel32.dll", SetLastError = true, CharSet = CharSet.Unicode)]
+    private static extern SafeWaitHandle CreateWaitableTimerExW(IntPtr lpTimerAttributes, string? lpTimerName,
+        uint dwFlags, uint dwDesiredAccess);
+
+    [DllImport("kernel32.dll", SetLastError = true)]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool SetWaitableTimer(SafeWaitHandle hTimer, ref long pDueTime, int lPeriod,
+        IntPtr pfnCompletionRoutine, IntPtr lpArgToCompletionRoutine, [MarshalAs(UnmanagedType.Bool)] bool fResume);
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct INPUT
+    {
+        public uint Type;
+        public MOUSEINPUT Mi;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct MOUSEINPUT
+    {
+        public int Dx;
+        public int Dy;
+        public uint MouseData;
+        public uint DwFlags;
+        public uint Time;
+        public IntPtr DwExtraInfo;
+    }
+
+    private const uint CREATE_WAITABLE_TIMER_HIGH_RESOLUTION = 0x00000002;
+    private const uint TIMER_ALL_ACCESS = 0x001F0003;
+    private const double BatchWindowMs = 0.25;       // items due this close together share a wake-up
+    private const long ReportIntervalMs = 60_000;
+
+    private sealed class Item
+    {
+        public long Deadline;
+        public INPUT[]? Inputs;
+        public int Count;
+        public readonly TaskCompletionSource Done = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public CancellationTokenRegistration Registration;
+    }
+
+    private readonly object _sync = new();
+    private readonly PriorityQueue<Item, long> _queue = new();
+    private readonly AutoResetEvent _wake = new(false);
+    private readonly SafeWaitHandle? _timer;
+    private readonly WaitHandle[] _waitSet;
+    private readonly Func<INPUT[], int, uint> _send;
+    private readonly long _batchWindow;
+    private readonly Thread _thread;
+    private readonly List<Item> _due = new();
+    private INPUT[] _batch = new INPUT[8];
+    private long _lastReport;
+    private volatile bool _disposed;
+
+    public bool HighResolution { get; }
+    public LatenessHistogram Lateness { get; } = new();
+    public long SendCalls => Interlocked.Read(ref _sendCalls);
+    public long InputsSent => Interlocked.Read(ref _inputsSent);
+    private long _sendCalls;
+    private long _inputsSent;
+
+    public static long Now => Stopwatch.GetTimestamp();
+    public static long FromMs(double milliseconds) => (long)(milliseconds * Stopwatch.Frequency / 1000.0);
+
+    /// <summary>
+    /// <paramref name="deadline"/> while the loop is still on its grid, else <paramref name="now"/>:
+    /// a loop that fell more than <paramref name="maxLate"/> behind (paused, or stalled) starts
+    /// a new grid instead of firing a burst to catch up.
+    /// </summary>
+    public static long Reanchor(long deadline, long maxLate, long now)
+    {
+        return deadline == 0 || now - deadline > maxLate ? now : deadline;
+    }
+
+    internal ClickScheduler(Func<INPUT[], int, uint>? send = null)
+    {
+        _send = send ?? ((inputs, count) => SendInput((uint)count, inputs, Marshal.SizeOf<INPUT>()));
+        _batchWindow = FromMs(BatchWindowMs);
+        _timer = CreateTimer(out bool highResolution);
+        HighResolution = highResolution;
+        _waitSet = _timer != null
+            ? new WaitHandle[] { new TimerWaitHandle(_timer), _wake }
+            : new WaitHandle[] { _wake };
+        _lastReport = Now;
+
+        _thread = new Thread(Run)
+        {
+            IsBackground = true,
+            Name = "Aoko click scheduler",
+            Priority = ThreadPriority.AboveNormal
+        };
+        _thread.Start();
+    }
+
+    /// <summary>Completes at <paramref name="deadline"/> (a Stopwatch timestamp).</summary>
+    public Task WaitUntilAsync(long deadline, CancellationToken token)
+    {
+        return Enqueue(deadline, null, 0, token);
+    }
+
+    public Task DelayAsync(int milliseconds, CancellationToken token)
+    {
+        return Enqueue(Now + FromMs(milliseconds), null, 0, token);
+    }
+
+    /// <summary>
+    /// Sends the first <paramref name="count"/> entries of <paramref name="inputs"/> at
+    /// <paramref name="deadline"/>, in the same SendInput call as anything else due then. The
+    /// entries are copied when they are sent, so the caller may reuse the array once the task
+    /// completes. A deadline in the past sends on the next wake-up.
+    /// </summary>
+    public Task SendAtAsync(long deadline, INPUT[] inputs, int count, CancellationToken token)
+    {
+        return Enqueue(deadline, inputs, Math.Min(count, inputs.Length), token);
+    }
+
+    private Task Enqueue(long deadline, INPUT[]? inputs, int count, CancellationToken token)
+    {
+        if (token.IsCancellationRequested) return Task.FromCanceled(token);
+        if (_disposed) throw new ObjectDisposedException(nameof(ClickScheduler));
+
+        var item = new Item { Deadline = deadline, Inputs = inputs, Count = count };
+        if (token.CanBeCanceled)
+            item.Registration = token.Register(static s => ((Item)s!).Done.TrySetCanceled(), item);
+
+        bool first;
+        lock (_sync)
+        {
+            _queue.Enqueue(item, deadline);
+            first = ReferenceEquals(_queue.Peek(), item);
+        }
+        // Only an item that moves the next wake-up earlier needs to re-arm the timer.
+        if (first) _wake.Set();
+        return item.Done.Task;
+    }
+
+    private void Run()
+    {
+        Debug.WriteLine($"[ClickScheduler] thread placement: {ThreadPlacement.OptOutOfEcoQos()}, priority {_thread.Priority}");
+        while (!_disposed)
+        {
+            long now = Now;
+            long next = long.MaxValue;
+            lock (_sync)
+            {
+                while (_queue.TryPeek(out var item, out long deadline))
+                {
+                    if (deadline - now > _batchWindow)
+                    {
+                        next = deadline;
+                        break;
+                    }
+                    _queue.Dequeue();
+                    _due.Add(item);
+                }
+            }
+
+            if (_due.Count > 0)
+            {
+                Dispatch(now);
+                continue;
+            }
+            Wait(next == long.MaxValue ? -1 : next - now);
+        }
+
+        lock (_sync)
+        {
+            while (_queue.TryDequeue(out var item, out _))
+            {
+                item.Registration.Dispose();
+                item.Done.TrySetCanceled();
+            }
+        }
+    }
+
+    private void Dispatch(long now)
+    {
+        int count = 0;
+        foreach (var item in _due)
+        {
+            Lateness.Record(now - item.Deadline);
+            if (item.Inputs == null || item.Count == 0 || item.Done.Task.IsCompleted) continue;
+            if (count + item.Count > _batch.Length)
+                Array.Resize(ref _batch, Math.Max(_batch.Length * 2, count + item.Count));
+            Array.Copy(item.Inputs, 0, _batch, count, item.Count);
+            count += item.Count;
+        }
+
+        if (count > 0)
+        {
+            _send(_batch, count);
+            Interlocked.Increment(ref _sendCalls);
+            Interlocked.Add(ref _inputsSent, count);
+        }
+
+        foreach (var item in _due)
+        {
+            item.Registration.Dispose();
+            item.Done.TrySetResult();
+        }
+        _due.Clear();
+
+        if (now - _lastReport >= FromMs(ReportIntervalMs))
+        {
+            _lastReport = now;
+            Debug.WriteLine($"[ClickScheduler] {(HighResolution ? "hi-res" : "coarse")} timer, " +
+                            $"{SendCalls} SendInput calls for {InputsSent} inputs, lateness {Lateness}");
+        }
+    }
+
+    private void Wait(long ticks)
+    {
+        if (ticks < 0)
+        {
+            _wake.WaitOne();
+            return;
+        }
+
+        if (_timer != null)
+        {
+            // Relative due time in 100 ns units; negative means relative to now.
+            double hundredNs = ticks * (10_000_000.0 / Stopwatch.Frequency);
+            long dueTime = -(long)Math.Clamp(hundredNs, 1.0, 36_000_000_000.0);
+            if (SetWaitableTimer(_timer, ref dueTime, 0, IntPtr.Zero, IntPtr.Zero, false))
+            {
+                WaitHandle.WaitAny(_waitSet);
+                return;
+            }
+        }
+
+        int ms = (int)Math.Min(int.MaxValue, (ticks * 1000 + Stopwatch.Frequency - 1) / Stopwatch.Frequency);
+        _wake.WaitOne(ms);
+    }
+
+    private static SafeWaitHandle? CreateTimer(out bool highResolution)
+    {
+        highResolution = false;
+        try
+        {
+            var timer = CreateWaitableTimerExW(IntPtr.Zero, null, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+            if (!timer.IsInvalid)
+            {
+                highResolution = true;
+                return timer;
+            }
+            timer.Dispose();
+
+            timer = CreateWaitableTimerExW(IntPtr.Zero, null, 0, TIMER_ALL_ACCESS);
+            if (!timer.IsInvalid) return timer;
+            timer.Dispose();
+        }
+        catch (DllNotFoundException)
+        {
+        }
+        catch (EntryPointNotFoundException)
+        {
+        }
+        return null;
+    }
+
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+        _wake.Set();
+        _thread.Join();
+        _wake.Dispose();
+        _timer?.Dispose();
+    }
+
+    private sealed class TimerWaitHandle : WaitHandle
+    {
+        public TimerWaitHandle(SafeWaitHandle handle)
+        {
+            SafeWaitHandle = handle;
+        }
+
+        // The scheduler owns the handle.
+        protected override void Dispose(bool explicitDisposing)
+        {
+        }
+    }
+}
+
+/// <summary>
+/// How late the scheduler dispatched each item against its deadline, in power-of-two
+/// buckets: under 64 µs, under 128 µs, ... under 32.8 ms, and everything later.
+/// </summary>
+internal sealed class LatenessHistogram
+{
+    public const int BucketCount = 11;
+    private const double FirstBoundUs = 64.0;
+
+    private readonly long[] _counts = new long[BucketCount];
+    private long _maxTicks;
+
+    public long Count
+    {
+        get
+        {
+            long total = 0;
+            for (int i = 0; i < BucketCount; i++) total += Interlocked.Read(ref _counts[i]);
+            return total;
+        }
+    }
+
+    public double MaxMs => Interlocked.Read(ref _maxTicks) * 1000.0 / Stopwatch.Frequency;
+
+    /// <summary>Upper bound of a bucket in milliseconds (infinity for the last).</summary>
+    public static double UpperBoundMs(int bucket)
+    {
+        return bucket >= BucketCount - 1 ? double.PositiveInfinity : FirstBoundUs * (1L << bucket) / 1000.0;
+    }
+
+    public static int BucketOf(long ticks)
+    {
+        double us = ticks * 1_000_000.0 / Stopwatch.Frequency;
+        int bucket = 0;
+        double bound = FirstBoundUs;
+        while (bucket < BucketCount - 1 && us >= bound)
+        {
+            bucket++;
+            bound *= 2.0;
+        }
+        return bucket;
+    }
+
+    public void Record(long ticks)
+    {
+        if (ticks < 0) ticks = 0;
+        Interlocked.Increment(ref _counts[BucketOf(ticks)]);
+        if (ticks > Interlocked.Read(ref _maxTicks))
+            Interlocked.Exchange(ref _maxTicks, ticks);
+    }
+
+    public long[] Snapshot()
+    {
+        var copy = new long[BucketCount];
+        for (int i = 0; i < BucketCount; i++) copy[i] = Interlocked.Read(ref _counts[i]);
+        return copy;
+    }
+
+    /// <summary>Upper bound in milliseconds of the bucket holding the given fraction of items.</summary>
+    public double PercentileMs(double fraction)
+    {
+        long[] counts = Snapshot();
+        long total = 0;
+        foreach (long c in counts) total += c;
+        if (total == 0) return 0.0;
+
+        long rank = (long)Math.Ceiling(Math.Clamp(fraction, 0.0, 1.0) * total);
+        long seen = 0;
+        for (int i = 0; i < BucketCount; i++)
+        {
+            seen += counts[i];
+            if (seen >= rank && counts[i] > 0) return UpperBoundMs(i);
+        }
+        return UpperBoundMs(BucketCount - 1);
+    }
+
+    public override string ToString()
+    {
+        return $"n={Count} p50<{PercentileMs(0.50):0.###}ms p99<{PercentileMs(0.99):0.###}ms max={MaxMs:0.###}ms";
+    }
+}
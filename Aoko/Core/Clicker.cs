@@ -12,33 +12,14 @@ public class Clicker : INotifyPropertyChanged
 {
     private const int AimAssistStateFreshMs = 220;
     private const int TriggerbotStateFreshMs = 35;
+    private const int AimAssistPeriodMs = 8;
     private static Clicker? _instance;
     public static Clicker Instance => _instance ??= new Clicker();
 
     // P/Invoke declarations
-    [DllImport("user32.dll", SetLastError = true)]
-    private static extern uint SendInput(uint nInputs, INPUT[] pInputs, int cbSize);
     [DllImport("user32.dll")]
     private static extern short GetAsyncKeyState(int vKey);
 
-    [StructLayout(LayoutKind.Sequential)]
-    private struct INPUT
-    {
-        public uint Type;
-        public MOUSEINPUT Mi;
-    }
-
-    [StructLayout(LayoutKind.Sequential)]
-    private struct MOUSEINPUT
-    {
-        public int Dx;
-        public int Dy;
-        public uint MouseData;
-        public uint DwFlags;
-        public uint Time;
-        public IntPtr DwExtraInfo;
-    }
-
     private const uint INPUT_MOUSE = 0;
     private const uint MOUSEEVENTF_MOVE = 0x0001;
     private const uint MOUSEEVENTF_LEFTDOWN = 0x0002;
@@ -77,29 +58,29 @@ public class Clicker : INotifyPropertyChanged
     private bool _isMiningIntent = false;
     
     private readonly Random _random = new();
-    private readonly object _sendInputLock = new();
-    private readonly INPUT[] _leftClickInputs;
-    private readonly INPUT[] _rightClickInputs;
-    private readonly INPUT[] _aimAssistMoveInput;
+    private readonly ClickScheduler _scheduler = new();
+    private readonly ClickScheduler.INPUT[] _leftClickInputs;
+    private readonly ClickScheduler.INPUT[] _rightClickInputs;
+    private readonly ClickScheduler.INPUT[] _aimAssistMoveInput;
     
     public event PropertyChangedEventHandler? PropertyChanged;
     public event Action? StateChanged;
     
     private Clicker()
     {
-        _leftClickInputs = new INPUT[2];
+        _leftClickInputs = new ClickScheduler.INPUT[2];
         _leftClickInputs[0].Type = INPUT_MOUSE;
         _leftClickInputs[0].Mi.DwFlags = MOUSEEVENTF_LEFTDOWN;
         _leftClickInputs[1].Type = INPUT_MOUSE;
         _leftClickInputs[1].Mi.DwFlags = MOUSEEVENTF_LEFTUP;
 
-        _rightClickInputs = new INPUT[2];
+        _rightClickInputs = new ClickScheduler.INPUT[2];
         _rightClickInputs[0].Type = INPUT_MOUSE;
         _rightClickInputs[0].Mi.DwFlags = MOUSEEVENTF_RIGHTDOWN;
         _rightClickInputs[1].Type = INPUT_MOUSE;
         _rightClickInputs[1].Mi.DwFlags = MOUSEEVENTF_RIGHTUP;
 
-        _aimAssistMoveInput = new INPUT[1];
+        _aimAssistMoveInput = new ClickScheduler.INPUT[1];
         _aimAssistMoveInput[0].Type = INPUT_MOUSE;
         _aimAssistMoveInput[0].Mi.DwFlags = MOUSEEVENTF_MOVE;
     }
@@ -114,6 +95,22 @@ public class Clicker : INotifyPropertyChanged
     private bool _showLogo = true;
     public bool ShowLogo { get => _showLogo; set { _showLogo = value; OnPropertyChanged(nameof(ShowLogo)); } }
 
+    // In-game overlay rebuild rate in Hz; 0 rebuilds on every game frame.
+    private int _overlayUpdateHz = 0;
+    public int OverlayUpdateHz
+    {
+        get => _overlayUpdateHz;
+        set
+        {
+            int clamped = Math.Clamp(value, 0, 240);
+            if (_overlayUpdateHz != clamped)
+            {
+                _overlayUpdateHz = clamped;
+                OnPropertyChanged(nameof(OverlayUpdateHz));
+            }
+        }
+    }
+
     private bool _discordRpcEnabled = true;
     public bool DiscordRpcEnabled
     {
@@ -414,10 +411,10 @@ public class Clicker : INotifyPropertyChanged
             if (System.Windows.Application.Current?.MainWindow is Aoko.MainWindow mainWindow)
                 mainWindow.EnterPanicStealthMode();
 
-            if (GameStateClient.Instance.IsConnected)
+            if (GameStateClient.Sessions.Any(s => s.IsConnected))
                 await Task.Delay(250).ConfigureAwait(false);
 
-            GameStateClient.Instance.Disconnect();
+            GameStateClient.DisconnectAll();
 
             var app = System.Windows.Application.Current;
             if (app != null)
@@ -1143,27 +1140,30 @@ public class Clicker : INotifyPropertyChanged
     
     private async Task AimAssistLoop(CancellationToken token)
     {
+        long period = ClickScheduler.FromMs(AimAssistPeriodMs);
+        long tickAt = 0;
+
         try
         {
             while (!token.IsCancellationRequested)
             {
-                bool supportedVersion = GameStateClient.Instance.SupportsModule("aimassist");
+                bool supportedVersion = GameStateClient.Active.SupportsModule("aimassist");
                 bool shouldRun =
                     AimAssistEnabled &&
                     supportedVersion &&
-                    GameStateClient.Instance.IsConnected &&
+                    GameStateClient.Active.IsConnected &&
                     WindowDetection.IsMinecraftActive();
 
                 if (!shouldRun)
                 {
-                    await Task.Delay(8, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(8, token).ConfigureAwait(false);
                     continue;
                 }
 
-                var state = GameStateClient.Instance.CurrentState;
+                var state = GameStateClient.Active.CurrentState;
                 if (state.GuiOpen && WindowDetection.IsCursorVisible())
                 {
-                    await Task.Delay(16, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(16, token).ConfigureAwait(false);
                     continue;
                 }
 
@@ -1181,16 +1181,18 @@ public class Clicker : INotifyPropertyChanged
                 if (stateAgeMs < 0) stateAgeMs = 0;
                 if (stateAgeMs > AimAssistStateFreshMs)
                 {
-                    await Task.Delay(8, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(8, token).ConfigureAwait(false);
                     continue;
                 }
 
                 bool leftHeld = (GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0;
                 bool autoLeftClicking = IsClicking && _useLeftButton;
-                if (leftHeld || autoLeftClicking)
-                    TryApplyAimAssist();
+                if ((leftHeld || autoLeftClicking) && TryApplyAimAssist())
+                    await _scheduler.SendAtAsync(ClickScheduler.Now, _aimAssistMoveInput, 1, token).ConfigureAwait(false);
 
-                await Task.Delay(8, token).ConfigureAwait(false);
+                // Active steps stay on a fixed grid so the pull rate does not drift with the work done per step.
+                tickAt = ClickScheduler.Reanchor(tickAt + period, period, ClickScheduler.Now);
+                await _scheduler.WaitUntilAsync(tickAt, token).ConfigureAwait(false);
             }
         }
         catch (TaskCanceledException) { }
@@ -1206,22 +1208,22 @@ public class Clicker : INotifyPropertyChanged
         {
             while (!token.IsCancellationRequested)
             {
-                bool supportedVersion = GameStateClient.Instance.SupportsModule("triggerbot");
+                bool supportedVersion = GameStateClient.Active.SupportsModule("triggerbot");
                 bool shouldRun =
                     TriggerbotEnabled &&
                     supportedVersion &&
-                    GameStateClient.Instance.IsConnected &&
+                    GameStateClient.Active.IsConnected &&
                     WindowDetection.IsMinecraftActive() &&
                     !WindowDetection.IsCursorVisible();
 
                 if (!shouldRun)
                 {
                     hadTarget = false;
-                    await Task.Delay(25, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(25, token).ConfigureAwait(false);
                     continue;
                 }
 
-                var state = GameStateClient.Instance.CurrentState;
+                var state = GameStateClient.Active.CurrentState;
                 long nowMs = Environment.TickCount64;
                 long stateAgeMs;
                 if (state.StateMs > 0)
@@ -1238,21 +1240,21 @@ public class Clicker : INotifyPropertyChanged
                 if (staleState)
                 {
                     hadTarget = false;
-                    await Task.Delay(8, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(8, token).ConfigureAwait(false);
                     continue;
                 }
 
                 if (state.GuiOpen && WindowDetection.IsCursorVisible())
                 {
                     hadTarget = false;
-                    await Task.Delay(20, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(20, token).ConfigureAwait(false);
                     continue;
                 }
 
                 if (BreakBlocksEnabled && (state.BreakingBlock || IsMiningIntent))
                 {
                     hadTarget = false;
-                    await Task.Delay(12, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(12, token).ConfigureAwait(false);
                     continue;
                 }
 
@@ -1260,7 +1262,7 @@ public class Clicker : INotifyPropertyChanged
                 if (TriggerbotRequireClick && !leftHeld)
                 {
                     hadTarget = false;
-                    await Task.Delay(8, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(8, token).ConfigureAwait(false);
                     continue;
                 }
 
@@ -1273,7 +1275,7 @@ public class Clicker : INotifyPropertyChanged
                 if (!hasTarget)
                 {
                     hadTarget = false;
-                    await Task.Delay(8, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(8, token).ConfigureAwait(false);
                     continue;
                 }
 
@@ -1314,7 +1316,7 @@ public class Clicker : INotifyPropertyChanged
                     bool didClick = false;
                     if (Random.Shared.Next(1, 101) <= TriggerbotHitChance)
                     {
-                        PerformClick(true);
+                        await _scheduler.SendAtAsync(ClickScheduler.Now, _leftClickInputs, 2, token).ConfigureAwait(false);
                         didClick = true;
                     }
 
@@ -1332,7 +1334,7 @@ public class Clicker : INotifyPropertyChanged
                     }
                 }
 
-                await Task.Delay(4, token).ConfigureAwait(false);
+                await _scheduler.DelayAsync(4, token).ConfigureAwait(false);
             }
         }
         catch (TaskCanceledException) { }
@@ -1456,20 +1458,35 @@ public class Clicker : INotifyPropertyChanged
 
     private async Task ClickLoop(CancellationToken token)
     {
-        var stopwatch = new Stopwatch();
+        // Clicks sit on absolute deadlines: each one is due an interval after the previous
+        // deadline, not after the previous wake-up, so scheduling latency does not add up.
+        long clickAt = 0;
+        long interval = 0;
         
         while (!token.IsCancellationRequested)
         {
+            if (clickAt > ClickScheduler.Now)
+            {
+                try
+                {
+                    await _scheduler.WaitUntilAsync(clickAt, token).ConfigureAwait(false);
+                }
+                catch (TaskCanceledException)
+                {
+                    break;
+                }
+            }
+
             if (!WindowDetection.IsMinecraftActive())
             {
-                await Task.Delay(100, token).ConfigureAwait(false);
+                await _scheduler.DelayAsync(100, token).ConfigureAwait(false);
                 continue;
             }
 
             // Menu & Inventory Safety Checks
-            if (GameStateClient.Instance.IsConnected)
+            if (GameStateClient.Active.IsConnected)
             {
-                var state = GameStateClient.Instance.CurrentState;
+                var state = GameStateClient.Active.CurrentState;
                 if (state.GuiOpen)
                 {
                     string screen = state.ScreenName;
@@ -1502,7 +1519,7 @@ public class Clicker : INotifyPropertyChanged
 
                     if (shouldBlock)
                     {
-                        await Task.Delay(100, token).ConfigureAwait(false);
+                        await _scheduler.DelayAsync(100, token).ConfigureAwait(false);
                         continue;
                     }
                 }
@@ -1512,7 +1529,7 @@ public class Clicker : INotifyPropertyChanged
                 // Fallback if not connected: Cursor check
                 if (WindowDetection.IsCursorVisible())
                 {
-                     await Task.Delay(100, token).ConfigureAwait(false);
+                     await _scheduler.DelayAsync(100, token).ConfigureAwait(false);
                      continue;
                 }
             }
@@ -1521,9 +1538,9 @@ public class Clicker : INotifyPropertyChanged
             if (!_useLeftButton && RightClickOnlyBlock)
             {
                 // Fail-open when state is unavailable; only pause when connected and confirmed not holding a block.
-                if (GameStateClient.Instance.IsConnected && !GameStateClient.Instance.CurrentState.HoldingBlock)
+                if (GameStateClient.Active.IsConnected && !GameStateClient.Active.CurrentState.HoldingBlock)
                 {
-                    await Task.Delay(100, token).ConfigureAwait(false);
+                    await _scheduler.DelayAsync(100, token).ConfigureAwait(false);
                     continue;
                 }
             }
@@ -1531,9 +1548,9 @@ public class Clicker : INotifyPropertyChanged
             // Break Blocks Logic: 
             if (_useLeftButton && BreakBlocksEnabled)
             {
-                if (GameStateClient.Instance.IsConnected)
+                if (GameStateClient.Active.IsConnected)
                 {
-                    var state = GameStateClient.Instance.CurrentState;
+                    var state = GameStateClient.Active.CurrentState;
                     bool allowChestClicks =
                         state.GuiOpen &&
                         WindowDetection.IsCursorVisible() &&
@@ -1545,7 +1562,7 @@ public class Clicker : INotifyPropertyChanged
                         // Chest GUI clicks should never be treated as block-mining intent.
                         IsMiningIntent = false;
                     }
-                    else if (GameStateClient.Instance.SupportsStateField("breakingBlock"))
+                    else if (GameStateClient.Active.SupportsStateField("breakingBlock"))
                     {
                         // Modern state payload: pause when we are actually breaking a block.
                         if (!state.LookingAtBlock)
@@ -1553,7 +1570,7 @@ public class Clicker : INotifyPropertyChanged
 
                         if (state.BreakingBlock || IsMiningIntent)
                         {
-                            await Task.Delay(25, token).ConfigureAwait(false);
+                            await _scheduler.DelayAsync(25, token).ConfigureAwait(false);
                             continue;
                         }
                     }
@@ -1565,15 +1582,13 @@ public class Clicker : INotifyPropertyChanged
 
                         if (IsMiningIntent)
                         {
-                            await Task.Delay(50, token).ConfigureAwait(false);
+                            await _scheduler.DelayAsync(50, token).ConfigureAwait(false);
                             continue;
                         }
                     }
                 }
             }
             
-            stopwatch.Restart();
-            
             float minCps = _useLeftButton ? MinCPS : RightMinCPS;
             float maxCps = _useLeftButton ? MaxCPS : RightMaxCPS;
             if (minCps > maxCps) minCps = maxCps;
@@ -1593,57 +1608,42 @@ public class Clicker : INotifyPropertyChanged
                 cps = minCps + (float)_random.NextDouble() * (maxCps - minCps);
             }
             
-            double targetInterval = 1000.0 / cps; // in milliseconds
-
-            // Perform click
-            PerformClick(_useLeftButton);
-            
-            // Drift Compensation
-            // Stop stopwatch to see how long click + logic took
-            stopwatch.Stop();
-            double elapsed = stopwatch.Elapsed.TotalMilliseconds;
-            
-            // Calculate remaining wait time, compensating for elapsed time
-            int waitTime = (int)(targetInterval - elapsed);
-            if (waitTime < 1) waitTime = 1; // Always yield at least a bit
+            // A deadline missed by more than an interval (a pause above) starts a new grid.
+            long due = ClickScheduler.Reanchor(clickAt, interval, ClickScheduler.Now);
+            var inputs = _useLeftButton ? _leftClickInputs : _rightClickInputs;
             
             try
             {
-                await Task.Delay(waitTime, token).ConfigureAwait(false);
+                await _scheduler.SendAtAsync(due, inputs, 2, token).ConfigureAwait(false);
             }
             catch (TaskCanceledException)
             {
                 break;
             }
-        }
-    }
-    
-    private void PerformClick(bool leftButton)
-    {
-        INPUT[] inputs = leftButton ? _leftClickInputs : _rightClickInputs;
-        lock (_sendInputLock)
-        {
-            SendInput(2, inputs, Marshal.SizeOf<INPUT>());
+
+            interval = ClickScheduler.FromMs(1000.0 / cps);
+            clickAt = due + interval;
         }
     }
 
-    private void TryApplyAimAssist()
+    // Prepares _aimAssistMoveInput; true when there is a move to send.
+    private bool TryApplyAimAssist()
     {
-        var state = GameStateClient.Instance.CurrentState;
+        var state = GameStateClient.Active.CurrentState;
         if (state.Entities.Count == 0)
         {
             _aimAssistFilteredDx = 0.0;
             _aimAssistFilteredDy = 0.0;
-            return;
+            return false;
         }
-        bool isLegacyBridge = GameStateClient.Instance.InjectedVersion.StartsWith("1.8", StringComparison.OrdinalIgnoreCase);
+        bool isLegacyBridge = GameStateClient.Active.InjectedVersion.StartsWith("1.8", StringComparison.OrdinalIgnoreCase);
 
         var rect = WindowDetection.GetMinecraftWindowRect();
-        if (!rect.HasValue) return;
+        if (!rect.HasValue) return false;
 
         int width = rect.Value.Right - rect.Value.Left;
         int height = rect.Value.Bottom - rect.Value.Top;
-        if (width <= 0 || height <= 0) return;
+        if (width <= 0 || height <= 0) return false;
 
         double centerX = width * 0.5;
         double centerY = height * 0.5;
@@ -1684,7 +1684,7 @@ public class Clicker : INotifyPropertyChanged
             }
         }
 
-        if (bestScore == double.MaxValue) return;
+        if (bestScore == double.MaxValue) return false;
 
         // Light temporal filter keeps closest-point targeting, but suppresses endpoint orbiting.
         const double filterAlpha = 0.40;
@@ -1708,14 +1708,11 @@ public class Clicker : INotifyPropertyChanged
         moveX = Math.Clamp(moveX, -maxStep, maxStep);
         moveY = Math.Clamp(moveY, -maxStep, maxStep);
 
-        if (moveX == 0 && moveY == 0) return;
+        if (moveX == 0 && moveY == 0) return false;
 
         _aimAssistMoveInput[0].Mi.Dx = moveX;
         _aimAssistMoveInput[0].Mi.Dy = moveY;
-        lock (_sendInputLock)
-        {
-            SendInput(1, _aimAssistMoveInput, Marshal.SizeOf<INPUT>());
-        }
+        return true;
     }
      
     private float GaussianRandom(float mean, float stddev)
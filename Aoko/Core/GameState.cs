@@ -22,6 +22,10 @@ public class GameState
     [JsonPropertyName("actionBar")]
     public string ActionBar { get; set; } = "";
 
+    /// <summary>Moves whenever the bridge's action bar text changes; 0 when the bridge does not track it.</summary>
+    [JsonPropertyName("actionBarRev")]
+    public uint ActionBarRev { get; set; }
+
     [JsonPropertyName("health")]
     public float Health { get; set; } = -1;
 
@@ -52,6 +56,14 @@ public class GameState
     [JsonPropertyName("stateMs")]
     public ulong StateMs { get; set; }
 
+    /// <summary>Player tick the tick-rate fields (cooldown, breaking/holding block, action bar) were read on; 0 when the bridge has no tick clock.</summary>
+    [JsonPropertyName("tick")]
+    public uint Tick { get; set; }
+
+    /// <summary>When the tick-rate fields were last read; <see cref="StateMs"/> is the newer per-frame sample.</summary>
+    [JsonPropertyName("tickSampleMs")]
+    public ulong TickSampleMs { get; set; }
+
     [JsonPropertyName("posX")]
     public double PosX { get; set; }
 
@@ -1,4 +1,6 @@
 using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.ComponentModel;
 using System.Diagnostics;
 using System.IO;
@@ -16,17 +18,54 @@ namespace Aoko.Core;
 /// <summary>
 /// TCP client that connects to the injected Java agent running inside Minecraft.
 /// Receives game state updates at ~20Hz and exposes them to the rest of the app.
+/// One instance per attached game process: <see cref="Instance"/> is the first (the one the
+/// UI shows), further games get sessions of their own, each with its own config versions and
+/// state stream. All sessions share one I/O thread (<see cref="BridgeIoThread"/>).
 /// </summary>
 public class GameStateClient : INotifyPropertyChanged
 {
     private static GameStateClient? _instance;
     public static GameStateClient Instance => _instance ??= new GameStateClient();
 
+    // Sessions beyond the primary, keyed by game PID.
+    private static readonly ConcurrentDictionary<int, GameStateClient> _secondary = new();
+
+    /// <summary>Every session, the primary first.</summary>
+    public static IReadOnlyList<GameStateClient> Sessions
+        => _secondary.IsEmpty ? [Instance] : [Instance, .. _secondary.Values.OrderBy(s => s.TargetPid)];
+
+    /// <summary>
+    /// The session of the focused game window, else <see cref="Instance"/>. State that belongs to
+    /// one game (aim, held block, break progress) is read from here.
+    /// </summary>
+    public static GameStateClient Active
+    {
+        get
+        {
+            if (_secondary.IsEmpty) return Instance;
+            int pid = WindowDetection.GameProcessId;
+            return pid != 0 && _secondary.TryGetValue(pid, out var session) ? session : Instance;
+        }
+    }
+
+    public static void DisconnectAll()
+    {
+        foreach (var session in _secondary.Values)
+            session.Disconnect();
+        _secondary.Clear();
+        Instance.Disconnect();
+    }
+
     private TcpClient? _client;
     private CancellationTokenSource? _cts;
     private Task? _configSenderTask;
     private Task? _readTask;
-    private readonly int _port = 25590;
+    private int _targetPid;
+    private int _port;
+    private int _bridgeSession;   // "session" of the bridge's capabilities; > 1 when a resident bridge was resumed
+    private const int CapabilitiesTimeoutMs = 1000;
+    private const int ConfigCoalesceMs = 16;      // one frame of property changes per push
+    private const int ConfigAckTimeoutMs = 1000;
 
     private GameState _currentState = new();
     private bool _isConnected;
@@ -36,14 +75,49 @@ public class GameStateClient : INotifyPropertyChanged
     private BridgeCapabilities _capabilities = BridgeCapabilities.ForVersionFallback("1.8.9");
     private int _injectionProgress;
     private bool _isInjectionInProgress;
-    private long _lastUiActionBarDispatchTicks;
+    // Action bar last handed to the GTB solver: it reruns only when the revision (or, from
+    // bridges without one, the text) or the helper switch changes.
+    private readonly object _gtbLock = new();
+    private uint _gtbActionBarRev;
+    private string? _gtbActionBar;
+    private bool _gtbEnabled;
     private int _reloadMappingsNonce;
+    private readonly SemaphoreSlim _writeLock = new(1, 1);
+    private readonly SemaphoreSlim _configSignal = new(0, 1);
+    private int _configDirty;
+    private int _configVersion;
+    private int _appliedConfigVersion;
+    // Clicker and InputHooks outlive every session: the handlers come off again when a
+    // session disconnects, or a dropped secondary would stay reachable through them.
+    private readonly object _configSubscriptionLock = new();
+    private bool _configSubscribed;
+    private PropertyChangedEventHandler? _clickerChangedHandler;
+    private SharedMemoryBridgeChannel? _shm;
+    private BridgeTelemetry? _latestTelemetry;
+    private readonly ConcurrentDictionary<string, ModuleResolveState> _moduleStates = new(StringComparer.OrdinalIgnoreCase);
 
     public event PropertyChangedEventHandler? PropertyChanged;
     public event Action? StateUpdated;
 
+    /// <summary>Raised on the I/O thread for every telemetry line (about once a second).</summary>
+    public event Action<BridgeTelemetry>? TelemetryReceived;
+
     private GameStateClient() { }
 
+    private GameStateClient(int targetPid)
+    {
+        _targetPid = targetPid;
+    }
+
+    /// <summary>PID of the game this session drives; 0 before one is picked.</summary>
+    public int TargetPid => Volatile.Read(ref _targetPid);
+
+    /// <summary>Port the bridge answered on; 0 while not connected.</summary>
+    public int Port => _port;
+
+    /// <summary>Newest bridge telemetry; null until the bridge sends one or after a disconnect.</summary>
+    public BridgeTelemetry? LatestTelemetry => Volatile.Read(ref _latestTelemetry);
+
     // === Properties ===
 
     public GameState CurrentState
@@ -157,6 +231,7 @@ public class GameStateClient : INotifyPropertyChanged
     public void RequestBridgeMappingReload()
     {
         Interlocked.Increment(ref _reloadMappingsNonce);
+        MarkConfigDirty();
         Log("Queued bridge mapping reload request.");
     }
 
@@ -174,36 +249,84 @@ public class GameStateClient : INotifyPropertyChanged
     {
         if (IsInjected || IsConnected)
         {
+            // The primary is attached: a game no session drives yet gets one of its own.
+            if (this == _instance && await AttachNextGameAsync(version))
+                return true;
             StatusMessage = "Already connected/injected";
             IsInjectionInProgress = false;
             InjectionProgress = 100;
             return true;
         }
 
-        var mcProcess = FindMinecraftProcess();
+        // A secondary session is bound to its game; the primary picks again once its game is gone.
+        var mcProcess = TargetPid != 0 ? TryGetProcess(TargetPid) : null;
+        if (mcProcess == null && this == _instance)
+            mcProcess = FindMinecraftProcess(ClaimedProcessIds());
+        Volatile.Write(ref _targetPid, mcProcess?.Id ?? 0);
         string resolvedVersion = ResolveInjectionVersion(version, mcProcess);
         Log($"Resolved injection version: requested={version}, resolved={resolvedVersion}, title='{mcProcess?.MainWindowTitle ?? "<none>"}'");
         Capabilities = BridgeCapabilities.ForVersionFallback(resolvedVersion);
 
+        string dllName = resolvedVersion switch
+        {
+            "26.1" => "bridge_261.dll",
+            "1.21" => "bridge_261.dll", // Modern bridge is shared by 26.1 and 1.21
+            _ => "bridge.dll"
+        };
+
         SetInjectionStage(5, "Checking existing bridge");
 
-        // 1. Try to connect directly (assuming already injected)
-        await ConnectAsync(
-            maxAttempts: 8,
-            onAttempt: (attempt, total) =>
+        // 1. A bridge stays loaded (with its mappings) after its loader goes away. The game's
+        //    module list says whether one is there, so a resident bridge is reconnected to
+        //    without injecting again, and a fresh game skips the connection probe.
+        string? residentPath = null;
+        bool? resident = mcProcess != null
+            ? NativeInjector.FindResidentModule(mcProcess.Id, BridgeModuleNames, out residentPath)
+            : null;
+        if (resident == true)
+        {
+            string residentName = Path.GetFileName(residentPath) ?? dllName;
+            if (!string.Equals(residentName, dllName, StringComparison.OrdinalIgnoreCase))
             {
-                int mapped = 5 + (attempt * 15 / total);
-                SetInjectionStage(mapped, $"Checking existing bridge ({attempt}/{total})");
-            },
-            reportFailure: false);
+                StatusMessage = $"ERROR: {residentName} is already loaded; restart the game to use {dllName}.";
+                Log($"Resident {residentPath} does not match {dllName} for version {resolvedVersion}.");
+                IsInjectionInProgress = false;
+                return false;
+            }
 
-        if (IsConnected)
-        {
-            IsInjected = true;
-            InjectedVersion = resolvedVersion;
+            Log($"{residentName} is resident in PID {mcProcess!.Id}; reconnecting without injection.");
+            await ConnectAsync(
+                maxAttempts: 30,
+                onAttempt: (attempt, total) =>
+                {
+                    int mapped = 5 + (attempt * 94 / total);
+                    SetInjectionStage(mapped, $"Reconnecting to resident bridge ({attempt}/{total})");
+                },
+                reportFailure: false);
+            if (IsConnected)
+                return CompleteInjection(resolvedVersion);
+
+            // Injecting again would only hit the already loaded module.
+            StatusMessage = $"ERROR: Resident {residentName} is not answering.";
+            Log($"Resident {residentName} did not answer on any candidate port.");
             IsInjectionInProgress = false;
-            InjectionProgress = 100;
-            return true;
+            return false;
+        }
+
+        if (resident == null)
+        {
+            // Module list unavailable: probe for a bridge the old way.
+            await ConnectAsync(
+                maxAttempts: 8,
+                onAttempt: (attempt, total) =>
+                {
+                    int mapped = 5 + (attempt * 15 / total);
+                    SetInjectionStage(mapped, $"Checking existing bridge ({attempt}/{total})");
+                },
+                reportFailure: false);
+
+            if (IsConnected)
+                return CompleteInjection(resolvedVersion);
         }
 
         // 2. Inject Native Bridge
@@ -216,12 +339,6 @@ public class GameStateClient : INotifyPropertyChanged
         }
         
         string baseDir = AppDomain.CurrentDomain.BaseDirectory;
-        string dllName = resolvedVersion switch
-        {
-            "26.1" => "bridge_261.dll",
-            "1.21" => "bridge_261.dll", // Modern bridge is shared by 26.1 and 1.21
-            _ => "bridge.dll"
-        };
         string dllPath = Path.Combine(baseDir, dllName);
         SetInjectionStage(20, $"Injecting {dllName}");
         
@@ -264,12 +381,8 @@ public class GameStateClient : INotifyPropertyChanged
         
         if (IsConnected)
         {
-            IsInjected = true;
-            InjectedVersion = resolvedVersion;
             Log("Connected successfully!");
-            IsInjectionInProgress = false;
-            InjectionProgress = 100;
-            return true;
+            return CompleteInjection(resolvedVersion);
         }
         else
         {
@@ -280,10 +393,60 @@ public class GameStateClient : INotifyPropertyChanged
         }
     }
 
+    private static readonly string[] BridgeModuleNames = { "bridge.dll", "bridge_261.dll" };
+
+    private bool CompleteInjection(string resolvedVersion)
+    {
+        IsInjected = true;
+        InjectedVersion = resolvedVersion;
+        IsInjectionInProgress = false;
+        InjectionProgress = 100;
+        return true;
+    }
+
+    private static async Task<bool> AttachNextGameAsync(string version)
+    {
+        Process? next = FindMinecraftProcess(ClaimedProcessIds());
+        if (next == null)
+            return false;
+
+        var session = _secondary.GetOrAdd(next.Id, pid => new GameStateClient(pid));
+        bool attached = await session.InjectAsync(version);
+        if (!attached)
+            _secondary.TryRemove(new KeyValuePair<int, GameStateClient>(next.Id, session));
+        return attached;
+    }
+
+    // Games some session already drives (or is attaching to); skipped when looking for a new one.
+    private static HashSet<int> ClaimedProcessIds()
+    {
+        var claimed = new HashSet<int>();
+        foreach (var session in Sessions)
+        {
+            if (session.TargetPid != 0 && (session.IsConnected || session.IsInjected || session.IsInjectionInProgress))
+                claimed.Add(session.TargetPid);
+        }
+        return claimed;
+    }
+
+    private static Process? TryGetProcess(int pid)
+    {
+        try
+        {
+            var process = Process.GetProcessById(pid);
+            return process.HasExited ? null : process;
+        }
+        catch (Exception ex) when (ex is ArgumentException or InvalidOperationException or Win32Exception)
+        {
+            return null;
+        }
+    }
+
     private void Log(string message)
     {
         // Avoid file I/O on UI thread or frequent calls
-        Debug.WriteLine($"[{DateTime.Now:HH:mm:ss}] [GameStateClient] {message}");
+        string tag = TargetPid != 0 ? $"GameStateClient:{TargetPid}" : "GameStateClient";
+        Debug.WriteLine($"[{DateTime.Now:HH:mm:ss}] [{tag}] {message}");
     }
 
     // === TCP Connection ===
@@ -303,40 +466,82 @@ public class GameStateClient : INotifyPropertyChanged
 
         _cts = new CancellationTokenSource();
         var token = _cts.Token;
+        int pid = TargetPid;
+        if (pid == 0)
+        {
+            if (reportFailure)
+                StatusMessage = "ERROR: No game process to connect to.";
+            return;
+        }
 
         // Retry connection with configurable attempt count (500ms delay between attempts)
+        (BridgeMessageReader Reader, BridgeMessage Capabilities)? opened = null;
         for (int attempt = 0; attempt < maxAttempts; attempt++)
         {
             if (token.IsCancellationRequested) return;
             onAttempt?.Invoke(attempt + 1, maxAttempts);
 
-            try
+            opened = await TryOpenBridgeAsync(pid, token);
+            if (opened != null)
             {
-                _client = new TcpClient();
-                await _client.ConnectAsync("127.0.0.1", _port, token);
                 IsConnected = true;
-                StatusMessage = "Connected!";
+                StatusMessage = _bridgeSession > 1 ? "Connected (resumed resident bridge)" : "Connected!";
                 break;
             }
-            catch
-            {
-                _client?.Dispose();
-                _client = null;
-                if (attempt + 1 < maxAttempts)
-                    await Task.Delay(500, token);
-            }
+            if (attempt + 1 < maxAttempts)
+                await Task.Delay(500, token);
         }
 
-        if (!IsConnected)
+        if (opened == null)
         {
             if (reportFailure)
-                StatusMessage = "ERROR: Could not connect to agent on port " + _port;
+                StatusMessage = $"ERROR: Could not connect to agent for PID {pid}";
             return;
         }
 
-        // Start config sender task
-        _configSenderTask = Task.Run(() => ConfigSenderLoop(token), token);
-        _readTask = Task.Run(() => ReadLoop(token), token);
+        // Both loops run on the shared bridge I/O thread.
+        var (reader, capabilities) = opened.Value;
+        _configSenderTask = BridgeIoThread.Run(() => ConfigSenderLoop(token));
+        _readTask = BridgeIoThread.Run(() => ReadLoop(reader, capabilities, token));
+    }
+
+    // Tries the ports a bridge in `pid` may listen on and keeps the first connection whose
+    // capabilities packet (always the bridge's first line) names that process. A bridge of
+    // another game that moved onto one of our ports is closed again.
+    private async Task<(BridgeMessageReader, BridgeMessage)?> TryOpenBridgeAsync(int pid, CancellationToken token)
+    {
+        foreach (int port in BridgeEndpoint.CandidatePorts(pid))
+        {
+            var client = new TcpClient();
+            try
+            {
+                await client.ConnectAsync("127.0.0.1", port, token);
+                using var timeout = CancellationTokenSource.CreateLinkedTokenSource(token);
+                timeout.CancelAfter(CapabilitiesTimeoutMs);
+                var reader = new BridgeMessageReader(client.GetStream());
+                BridgeMessage? first = await reader.ReadAsync(timeout.Token);
+                string? line = first?.Text;
+                JsonNode? announced = line != null && line.Contains("\"type\":\"capabilities\"") ? JsonNode.Parse(line) : null;
+                if (announced != null && BridgeEndpoint.ServesProcess(announced, pid))
+                {
+                    _client = client;
+                    _port = port;
+                    _bridgeSession = BridgeEndpoint.SessionOf(announced);
+                    Log($"Bridge for PID {pid} answered on port {port} (session {_bridgeSession}).");
+                    return (reader, first!.Value);
+                }
+                Log($"Port {port} is served by another process's bridge; skipping.");
+            }
+            catch (OperationCanceledException) when (!token.IsCancellationRequested)
+            {
+                // Connected, but no capabilities in time: not a bridge we can use.
+            }
+            catch (Exception ex) when (ex is SocketException or IOException or JsonException or InvalidDataException)
+            {
+            }
+            client.Dispose();
+        }
+        return null;
     }
 
     public BridgeCapabilities Capabilities
@@ -358,21 +563,68 @@ public class GameStateClient : INotifyPropertyChanged
     public bool SupportsStateField(string fieldName)
         => Capabilities.SupportsStateField(fieldName);
 
-    private async Task ReadLoop(CancellationToken token)
+    /// <summary>Modules the bridge has reported a mapping state for; cleared on disconnect.</summary>
+    public IReadOnlyDictionary<string, ModuleResolveState> ModuleStates => _moduleStates;
+
+    /// <summary>Mapping state the bridge last reported for a module; Unknown when it never said.</summary>
+    public ModuleResolveState GetModuleState(string moduleId)
+        => _moduleStates.TryGetValue(moduleId, out ModuleResolveState state) ? state : ModuleResolveState.Unknown;
+
+    private async Task ReadLoop(BridgeMessageReader reader, BridgeMessage capabilities, CancellationToken token)
     {
         try
         {
             if (_client == null) return;
             using var stream = _client.GetStream();
-            using var reader = new StreamReader(stream, Encoding.UTF8);
+            var assembler = new BridgeStateAssembler();
+            var stateReader = new GameStateJsonReader();
+            BridgeMessage? pending = capabilities;
 
             while (!token.IsCancellationRequested && _client.Connected)
             {
-                string? line = await reader.ReadLineAsync(token);
-                if (line == null) break;
+                BridgeMessage? message = pending ?? await reader.ReadAsync(token);
+                pending = null;
+                if (message == null) break;
 
                 try
                 {
+                    if (!message.Value.IsText)
+                    {
+                        if (message.Value.Version == BridgeProtocol.Version)
+                            await ApplyStateFrameAsync(stream, assembler, message.Value.FrameType, message.Value.Payload, token);
+                        continue;
+                    }
+
+                    // State lines are parsed from the read buffer with interned names; only the
+                    // rare control lines below are decoded to strings.
+                    if (GameStateJsonReader.IsStateLine(message.Value.Utf8))
+                    {
+                        GameState? state = stateReader.Read(message.Value.Utf8);
+                        if (state != null)
+                            ApplyState(state);
+                        continue;
+                    }
+
+                    string line = message.Value.Text ?? "";
+
+                    if (line.Contains("\"type\":\"telemetry\""))
+                    {
+                        HandleTelemetry(line);
+                        continue;
+                    }
+
+                    if (line.Contains("\"type\":\"configAck\""))
+                    {
+                        HandleConfigAck(line);
+                        continue;
+                    }
+
+                    if (line.Contains("\"type\":\"moduleState\""))
+                    {
+                        HandleModuleState(line);
+                        continue;
+                    }
+
                     // Check if it's a command from ClickGUI
                     if (line.Contains("\"type\":\"cmd\""))
                     {
@@ -383,34 +635,43 @@ public class GameStateClient : INotifyPropertyChanged
                     if (line.Contains("\"type\":\"capabilities\""))
                     {
                         HandleBridgeCapabilities(line);
+                        if (!reader.FrameMode && Capabilities.SupportsStateFormat(BridgeProtocol.BinaryFormat))
+                        {
+                            string request = BridgeProtocol.FormatRequestLine(BridgeProtocol.BinaryFormat,
+                                delta: Capabilities.SupportsStateFormat(BridgeProtocol.DeltaFormat));
+                            await WriteToBridgeAsync(stream, Encoding.UTF8.GetBytes(request), token);
+                        }
+                        if (_shm == null && Capabilities.SupportsTransport("shm"))
+                            await WriteToBridgeAsync(stream, Encoding.UTF8.GetBytes("{\"type\":\"transport\",\"state\":\"shm\"}\n"), token);
+                        if (Capabilities.SupportsStream(BridgeTelemetry.StreamName))
+                            await WriteToBridgeAsync(stream, Encoding.UTF8.GetBytes(BridgeTelemetry.EnableRequestLine), token);
                         continue;
                     }
 
-                    var state = JsonSerializer.Deserialize<GameState>(line);
-                    if (state != null)
+                    if (line.Contains("\"type\":\"transport\""))
                     {
-                        state.IsConnected = true;
-                        state.LastUpdate = DateTime.Now;
-                        CurrentState = state;
-                        if (Capabilities.SupportsStateField("actionBar"))
-                        {
-                            string actionBar = state.ActionBar;
-                            long nowTicks = Environment.TickCount64;
-                            long last = Interlocked.Read(ref _lastUiActionBarDispatchTicks);
-                            if ((nowTicks - last) >= 25 && Interlocked.CompareExchange(ref _lastUiActionBarDispatchTicks, nowTicks, last) == last)
-                            {
-                                System.Windows.Application.Current?.Dispatcher.BeginInvoke(new Action(() =>
-                                {
-                                    Clicker.Instance.UpdateGtbFromActionBar(actionBar);
-                                }));
-                            }
-                        }
+                        await HandleTransportAckAsync(stream, assembler, line, token);
+                        continue;
+                    }
+
+                    // Format ack: the bridge frames everything after this line.
+                    if (line.Contains("\"type\":\"format\""))
+                    {
+                        reader.FrameMode = BridgeProtocol.IsBinaryAck(line);
+                        string format = !reader.FrameMode ? "json"
+                            : BridgeProtocol.IsDeltaAck(line) ? BridgeProtocol.DeltaFormat : BridgeProtocol.BinaryFormat;
+                        Log($"Bridge state format: {format}");
+                        continue;
                     }
                 }
                 catch (JsonException)
                 {
                     // Skip malformed lines
                 }
+                catch (FormatException)
+                {
+                    // Skip truncated frames
+                }
             }
         }
         catch (OperationCanceledException) { }
@@ -420,19 +681,162 @@ public class GameStateClient : INotifyPropertyChanged
         }
         finally
         {
+            Interlocked.Exchange(ref _shm, null)?.Dispose();
+            Volatile.Write(ref _latestTelemetry, null);
+            _moduleStates.Clear();
+            lock (_gtbLock) _gtbActionBar = null;
             IsConnected = false;
             _client?.Dispose();
             _client = null;
+            _port = 0;
             StatusMessage = "Disconnected from agent.";
             Capabilities = BridgeCapabilities.ForVersionFallback(InjectedVersion);
+            if (this != _instance)
+            {
+                ReleaseConfigSubscriptions();
+                _secondary.TryRemove(new KeyValuePair<int, GameStateClient>(TargetPid, this));
+            }
+        }
+    }
+
+    private void ApplyState(GameState state)
+    {
+        state.IsConnected = true;
+        state.LastUpdate = DateTime.Now;
+        CurrentState = state;
+        // GTB hints follow the game in front.
+        if (!Capabilities.SupportsStateField("actionBar"))
+            return;
+        string actionBar = state.ActionBar;
+        lock (_gtbLock)
+        {
+            if (Active != this)
+            {
+                _gtbActionBar = null;
+                return;
+            }
+            bool enabled = Clicker.Instance.GtbHelperEnabled;
+            bool changed = state.ActionBarRev != 0
+                ? state.ActionBarRev != _gtbActionBarRev
+                : !string.Equals(actionBar, _gtbActionBar, StringComparison.Ordinal);
+            if (!changed && _gtbActionBar != null && enabled == _gtbEnabled)
+                return;
+            _gtbActionBarRev = state.ActionBarRev;
+            _gtbActionBar = actionBar;
+            _gtbEnabled = enabled;
         }
+        System.Windows.Application.Current?.Dispatcher.BeginInvoke(new Action(() =>
+        {
+            Clicker.Instance.UpdateGtbFromActionBar(actionBar);
+        }));
     }
 
+    // Bridge answered a transport request. On "shm" open its mapping and read frames from
+    // there; if that fails, tell the bridge to keep using the socket.
+    private async Task HandleTransportAckAsync(NetworkStream stream, BridgeStateAssembler assembler, string line, CancellationToken token)
+    {
+        JsonNode? node = JsonNode.Parse(line);
+        string? name = node?["name"]?.GetValue<string>();
+        if (!string.Equals(node?["state"]?.GetValue<string>(), "shm", StringComparison.OrdinalIgnoreCase) || string.IsNullOrEmpty(name))
+            return;
 
-    // P/Invoke for Detach
-    [System.Runtime.InteropServices.DllImport("bridge.dll", EntryPoint = "Detach", CallingConvention = System.Runtime.InteropServices.CallingConvention.Cdecl)]
-    private static extern void DetachBridge();
+        SharedMemoryBridgeChannel? channel = SharedMemoryBridgeChannel.TryOpen(name);
+        if (channel == null)
+        {
+            Log($"Shared-memory channel {name} unavailable, staying on TCP.");
+            await WriteToBridgeAsync(stream, Encoding.UTF8.GetBytes("{\"type\":\"transport\",\"state\":\"tcp\"}\n"), token);
+            return;
+        }
+
+        Interlocked.Exchange(ref _shm, channel)?.Dispose();
+        Log($"Bridge transport: shared memory ({name}).");
+        // Same thread as ReadLoop: the assembler is shared and only ever touched from there.
+        _ = BridgeIoThread.Run(() => SharedMemoryReadLoop(channel, stream, assembler, token));
+    }
 
+    // Keyframe or delta from either transport. Asks for a keyframe when a delta cannot be applied.
+    private async Task ApplyStateFrameAsync(NetworkStream stream, BridgeStateAssembler assembler, byte frameType, ReadOnlyMemory<byte> payload, CancellationToken token)
+    {
+        GameState? next = frameType switch
+        {
+            BridgeProtocol.FrameState => assembler.AcceptKeyframe(BridgeProtocol.DecodeState(payload.Span)),
+            BridgeProtocol.FrameStateDelta => assembler.ApplyDelta(payload.Span),
+            _ => null
+        };
+        if (next != null)
+            ApplyState(next);
+        else if (frameType == BridgeProtocol.FrameStateDelta && assembler.TakeKeyframeRequest())
+            await WriteToBridgeAsync(stream, Encoding.UTF8.GetBytes(BridgeProtocol.KeyframeRequestLine), token);
+    }
+
+    // Runs on BridgeIoThread. Drain holds the channel lock, so frames are collected first and
+    // applied afterwards in order, each delta awaited before the next one.
+    private async Task SharedMemoryReadLoop(SharedMemoryBridgeChannel channel, NetworkStream stream, BridgeStateAssembler assembler, CancellationToken token)
+    {
+        var frames = new List<object?>();
+        try
+        {
+            while (!token.IsCancellationRequested && Volatile.Read(ref _shm) == channel)
+            {
+                await channel.WaitForFramesAsync(50);
+                frames.Clear();
+                channel.Drain<object?>(DecodeSharedMemoryFrame, frames.Add);
+                foreach (object? message in frames)
+                {
+                    if (message is GameState keyframe) ApplyState(assembler.AcceptKeyframe(keyframe));
+                    else if (message is byte[] delta) await ApplyStateFrameAsync(stream, assembler, BridgeProtocol.FrameStateDelta, delta, token);
+                    else if (message is string json)
+                    {
+                        if (json.Contains("\"type\":\"telemetry\"")) HandleTelemetry(json);
+                        else if (json.Contains("\"type\":\"configAck\"")) HandleConfigAck(json);
+                        else if (json.Contains("\"type\":\"moduleState\"")) HandleModuleState(json);
+                        else HandleBridgeCommand(json);
+                    }
+                }
+            }
+        }
+        catch (OperationCanceledException) { }
+        catch (ObjectDisposedException) { }
+        catch (Exception ex)
+        {
+            Debug.WriteLine($"[GameStateClient] Shared-memory read error: {ex.Message}");
+        }
+    }
+
+    private static object? DecodeSharedMemoryFrame(byte frameType, byte version, ReadOnlySpan<byte> payload)
+    {
+        if (version != BridgeProtocol.Version)
+            return null;
+        if (frameType == BridgeProtocol.FrameState)
+            return BridgeProtocol.DecodeState(payload);
+        // Deltas depend on the previous frame, so they are applied only after the slot checks out.
+        if (frameType == BridgeProtocol.FrameStateDelta)
+            return payload.ToArray();
+        if (frameType == BridgeProtocol.FrameJson)
+            return Encoding.UTF8.GetString(payload);
+        return null;
+    }
+
+    // ReadLoop (format request) and ConfigSenderLoop both write to the stream.
+    private async Task WriteToBridgeAsync(NetworkStream stream, byte[] data, CancellationToken token)
+    {
+        await _writeLock.WaitAsync(token);
+        try
+        {
+            await stream.WriteAsync(data, 0, data.Length, token);
+        }
+        finally
+        {
+            _writeLock.Release();
+        }
+    }
+
+
+    /// <summary>
+    /// Drops the connection and leaves the bridge loaded in the game, mappings and hooks
+    /// included; the next <see cref="InjectAsync"/> finds it resident and reconnects without
+    /// injecting or rediscovering anything.
+    /// </summary>
     public async Task DetachAsync()
     {
         if (!_isInjected) return;
@@ -459,10 +863,6 @@ public class GameStateClient : INotifyPropertyChanged
                      _client = null;
                  }
                  IsConnected = false;
-                 
-                 // Call native detach
-                 try { DetachBridge(); } catch { } 
-                 
                  IsInjected = false;
                  StatusMessage = "Detached";
              }
@@ -487,6 +887,7 @@ public class GameStateClient : INotifyPropertyChanged
         }
         _client?.Dispose();
         _client = null;
+        ReleaseConfigSubscriptions();
         IsConnected = false;
         IsInjected = false;
         IsInjectionInProgress = false;
@@ -501,7 +902,7 @@ public class GameStateClient : INotifyPropertyChanged
     /// Finds the Minecraft/Lunar Client Java process via OS process list.
     /// This is more reliable than VirtualMachine.list() which requires same-JDK compatibility.
     /// </summary>
-    private Process? FindMinecraftProcess()
+    private static Process? FindMinecraftProcess(HashSet<int> skip)
     {
         string[] keywords = { ".lunarclient", "lunar", "minecraft" };
 
@@ -509,7 +910,9 @@ public class GameStateClient : INotifyPropertyChanged
         {
             var javaProcesses = Process.GetProcesses()
                 .Where(p => p.ProcessName.Equals("javaw", StringComparison.OrdinalIgnoreCase)
-                         || p.ProcessName.Equals("java", StringComparison.OrdinalIgnoreCase));
+                         || p.ProcessName.Equals("java", StringComparison.OrdinalIgnoreCase))
+                .Where(p => !skip.Contains(p.Id))
+                .ToList();
 
             foreach (var proc in javaProcesses)
             {
@@ -719,6 +1122,20 @@ public class GameStateClient : INotifyPropertyChanged
 
     // === Config Sending (C# -> Bridge for HUD display) ===
 
+    // `payload` is one serialized JSON object; returns it with "configVersion" added as its last
+    // member, so a changed config is serialized once rather than again with the version.
+    internal static byte[] WithConfigVersion(byte[] payload, int version)
+    {
+        int end = Array.LastIndexOf(payload, (byte)'}');
+        if (end < 0)
+            return payload;
+        byte[] member = Encoding.ASCII.GetBytes($"{(end > 1 ? "," : "")}\"configVersion\":{version}}}");
+        byte[] data = new byte[end + member.Length];
+        payload.AsSpan(0, end).CopyTo(data);
+        member.CopyTo(data, end);
+        return data;
+    }
+
     private void HandleBridgeCapabilities(string json)
     {
         try
@@ -738,103 +1155,213 @@ public class GameStateClient : INotifyPropertyChanged
         }
     }
 
+    // A full config goes out when the loop starts (every (re)connect); after that only when
+    // something changed, coalesced over one frame and tagged with a new configVersion. Bridges
+    // that advertise "configversion" ack what they applied; an unacked version is resent.
     private async Task ConfigSenderLoop(CancellationToken token)
     {
+        EnsureConfigSubscriptions();
+        byte[]? lastSent = null;
+        int sentVersion = 0;
+        long sentAt = 0;
+        bool first = true;
+
         while (!token.IsCancellationRequested && _client?.Connected == true)
         {
             try
             {
-                var clicker = Clicker.Instance;
-                var config = new
+                bool awaitingAck = sentVersion != 0 &&
+                    SupportsSetting("configversion") &&
+                    Volatile.Read(ref _appliedConfigVersion) < sentVersion;
+                bool resend = false;
+                if (!first)
                 {
-                    type = "config",
-                    armed = clicker.IsArmed,
-                    clicking = clicker.IsClicking,
-                    minCPS = clicker.MinCPS,
-                    maxCPS = clicker.MaxCPS,
-                    left = clicker.LeftClickEnabled,
-                    right = clicker.RightClickEnabled,
-                    rightMinCPS = clicker.RightMinCPS,
-                    rightMaxCPS = clicker.RightMaxCPS,
-                    rightBlock = clicker.RightClickOnlyBlock,
-                    breakBlocks = clicker.BreakBlocksEnabled,
-                    jitter = clicker.JitterEnabled,
-                    clickInChests = clicker.ClickInChests,
-                    aimAssist = clicker.AimAssistEnabled,
-                    aimAssistFov = clicker.AimAssistFov,
-                    aimAssistRange = clicker.AimAssistRange,
-                    aimAssistStrength = clicker.AimAssistStrength,
-                    triggerbot = clicker.TriggerbotEnabled,
-                    speedBridge = clicker.SpeedBridgeEnabled,
-                    speedBridgeBlockOnly = clicker.SpeedBridgeBlockOnly,
-                    speedBridgeDelayMs = clicker.SpeedBridgeDelayMs,
-                    speedBridgeHoldingShiftOnly = clicker.SpeedBridgeHoldingShiftOnly,
-                    speedBridgeLookingDownOnly = clicker.SpeedBridgeLookingDownOnly,
-                    gtbHelper = clicker.GtbHelperEnabled,
-                    gtbHint = clicker.GtbCurrentHint,
-                    gtbCount = clicker.GtbMatchCount,
-                    gtbPreview = clicker.GtbMatchesPreview,
-                    nametags = clicker.NametagsEnabled,
-                    showModuleList = clicker.ShowModuleList,
-                    moduleListStyle = ModuleListStyleToIndex(clicker.ModuleListStyle),
-                    showLogo = clicker.ShowLogo,
-                    guiTheme = clicker.GuiTheme,
-                    closestPlayerInfo = clicker.ClosestPlayerInfoEnabled,
-                    nametagShowHealth = clicker.NametagShowHealth,
-                    nametagShowArmor = clicker.NametagShowArmor,
-                    nametagShowHeldItem = clicker.NametagShowHeldItem,
-                    nametagHideVanilla = clicker.NametagHideVanilla,
-                    reloadMappingsNonce = Volatile.Read(ref _reloadMappingsNonce),
-                    nametagMaxCount = clicker.NametagMaxCount,
-                    chestEsp = clicker.ChestEspEnabled,
-                    chestEspMaxCount = clicker.ChestEspMaxCount,
-                    reachEnabled = clicker.ReachEnabled,
-                    reachMin = clicker.ReachMin,
-                    reachMax = clicker.ReachMax,
-                    reachChance = clicker.ReachChance,
-                    velocityEnabled = clicker.VelocityEnabled,
-                    velocityHorizontal = clicker.VelocityHorizontal,
-                    velocityVertical = clicker.VelocityVertical,
-                    velocityChance = clicker.VelocityChance,
-                    autoTotemEnabled = clicker.AutoTotemEnabled,
-                    autoTotemMode = clicker.AutoTotemMode,
-                    autoTotemHealth = clicker.AutoTotemHealth,
-                    autoTotemElytra = clicker.AutoTotemElytra,
-                    autoTotemDelay = clicker.AutoTotemDelay,
-                    autoTotemBehaviorMode = clicker.AutoTotemBehaviorMode,
-                    // Per-module keybinds
-                    keybindAutoclicker   = InputHooks.GetModuleKey("autoclicker"),
-                    keybindRightClick    = InputHooks.GetModuleKey("rightclick"),
-                    keybindJitter        = InputHooks.GetModuleKey("jitter"),
-                    keybindClickInChests = InputHooks.GetModuleKey("clickinchests"),
-                    keybindBreakBlocks   = InputHooks.GetModuleKey("breakblocks"),
-                    keybindAimAssist     = InputHooks.GetModuleKey("aimassist"),
-                    keybindTriggerbot    = InputHooks.GetModuleKey("triggerbot"),
-                    keybindSpeedBridge   = InputHooks.GetModuleKey("speedbridge"),
-                    keybindGtbHelper     = InputHooks.GetModuleKey("gtbhelper"),
-                    keybindNametags      = InputHooks.GetModuleKey("nametags"),
-                    keybindClosestPlayer = InputHooks.GetModuleKey("closestplayer"),
-                    keybindChestEsp      = InputHooks.GetModuleKey("chestesp")
-                };
-
-                string json = JsonSerializer.Serialize(config) + "\n";
-                byte[] data = Encoding.UTF8.GetBytes(json);
+                    int waitMs = awaitingAck
+                        ? (int)Math.Max(1, ConfigAckTimeoutMs - (Environment.TickCount64 - sentAt))
+                        : Timeout.Infinite;
+                    bool signalled = await _configSignal.WaitAsync(waitMs, token);
+                    resend = !signalled;
+                    if (signalled)
+                        await Task.Delay(ConfigCoalesceMs, token);
+                }
+                first = false;
+
+                Interlocked.Exchange(ref _configDirty, 0);
+                byte[] payload = JsonSerializer.SerializeToUtf8Bytes(BuildConfig());
+                if (!resend && lastSent != null && payload.AsSpan().SequenceEqual(lastSent))
+                    continue;
+
+                int version = Interlocked.Increment(ref _configVersion);
+                byte[] data = WithConfigVersion(payload, version);
+                lastSent = payload;
+                sentVersion = version;
+                sentAt = Environment.TickCount64;
+
+                SharedMemoryBridgeChannel? shm = Volatile.Read(ref _shm);
+                if (shm != null && shm.WriteConfig(data))
+                    continue;
 
                 if (_client?.Connected == true)
                 {
                     var stream = _client.GetStream();
-                    await stream.WriteAsync(data, 0, data.Length, token);
+                    await WriteToBridgeAsync(stream, [.. data, (byte)'\n'], token);
                 }
             }
             catch (Exception)
             {
                 break;
             }
+        }
+    }
+
+    public int AppliedConfigVersion => Volatile.Read(ref _appliedConfigVersion);
+
+    private void HandleTelemetry(string json)
+    {
+        BridgeTelemetry? telemetry = BridgeTelemetry.Parse(json);
+        if (telemetry == null) return;
+        Volatile.Write(ref _latestTelemetry, telemetry);
+        TelemetryReceived?.Invoke(telemetry);
+    }
 
-            await Task.Delay(200, token);
+    private void HandleModuleState(string json)
+    {
+        if (!BridgeModuleState.TryParse(json, out string moduleId, out ModuleResolveState state)) return;
+        if (state == ModuleResolveState.Unknown) _moduleStates.TryRemove(moduleId, out _);
+        else _moduleStates[moduleId] = state;
+        OnPropertyChanged(nameof(ModuleStates));
+    }
+
+    private void HandleConfigAck(string json)
+    {
+        try
+        {
+            int version = JsonNode.Parse(json)?["version"]?.GetValue<int>() ?? 0;
+            int seen = Volatile.Read(ref _appliedConfigVersion);
+            while (version > seen)
+            {
+                int prior = Interlocked.CompareExchange(ref _appliedConfigVersion, version, seen);
+                if (prior == seen) break;
+                seen = prior;
+            }
+        }
+        catch (Exception ex)
+        {
+            Log($"Error parsing config ack: {ex.Message}");
+        }
+    }
+
+    private void MarkConfigDirty()
+    {
+        // At most one pending wake-up; the sender clears the flag before it reads the config.
+        if (Interlocked.Exchange(ref _configDirty, 1) == 0)
+            _configSignal.Release();
+    }
+
+    private void EnsureConfigSubscriptions()
+    {
+        lock (_configSubscriptionLock)
+        {
+            if (_configSubscribed)
+                return;
+            _clickerChangedHandler ??= (_, _) => MarkConfigDirty();
+            Clicker.Instance.PropertyChanged += _clickerChangedHandler;
+            InputHooks.OnStateChanged += MarkConfigDirty;
+            _configSubscribed = true;
+        }
+    }
+
+    private void ReleaseConfigSubscriptions()
+    {
+        lock (_configSubscriptionLock)
+        {
+            if (!_configSubscribed)
+                return;
+            Clicker.Instance.PropertyChanged -= _clickerChangedHandler;
+            InputHooks.OnStateChanged -= MarkConfigDirty;
+            _configSubscribed = false;
         }
     }
 
+    // The config object without its configVersion, which WithConfigVersion appends once the
+    // payload is known to differ from the last one sent.
+    private object BuildConfig()
+    {
+        var clicker = Clicker.Instance;
+        return new
+        {
+            type = "config",
+            armed = clicker.IsArmed,
+            clicking = clicker.IsClicking,
+            minCPS = clicker.MinCPS,
+            maxCPS = clicker.MaxCPS,
+            left = clicker.LeftClickEnabled,
+            right = clicker.RightClickEnabled,
+            rightMinCPS = clicker.RightMinCPS,
+            rightMaxCPS = clicker.RightMaxCPS,
+            rightBlock = clicker.RightClickOnlyBlock,
+            breakBlocks = clicker.BreakBlocksEnabled,
+            jitter = clicker.JitterEnabled,
+            clickInChests = clicker.ClickInChests,
+            aimAssist = clicker.AimAssistEnabled,
+            aimAssistFov = clicker.AimAssistFov,
+            aimAssistRange = clicker.AimAssistRange,
+            aimAssistStrength = clicker.AimAssistStrength,
+            triggerbot = clicker.TriggerbotEnabled,
+            speedBridge = clicker.SpeedBridgeEnabled,
+            speedBridgeBlockOnly = clicker.SpeedBridgeBlockOnly,
+            speedBridgeDelayMs = clicker.SpeedBridgeDelayMs,
+            speedBridgeHoldingShiftOnly = clicker.SpeedBridgeHoldingShiftOnly,
+            speedBridgeLookingDownOnly = clicker.SpeedBridgeLookingDownOnly,
+            gtbHelper = clicker.GtbHelperEnabled,
+            gtbHint = clicker.GtbCurrentHint,
+            gtbCount = clicker.GtbMatchCount,
+            gtbPreview = clicker.GtbMatchesPreview,
+            nametags = clicker.NametagsEnabled,
+            showModuleList = clicker.ShowModuleList,
+            moduleListStyle = ModuleListStyleToIndex(clicker.ModuleListStyle),
+            showLogo = clicker.ShowLogo,
+            overlayUpdateHz = clicker.OverlayUpdateHz,
+            guiTheme = clicker.GuiTheme,
+            closestPlayerInfo = clicker.ClosestPlayerInfoEnabled,
+            nametagShowHealth = clicker.NametagShowHealth,
+            nametagShowArmor = clicker.NametagShowArmor,
+            nametagShowHeldItem = clicker.NametagShowHeldItem,
+            nametagHideVanilla = clicker.NametagHideVanilla,
+            reloadMappingsNonce = Volatile.Read(ref _reloadMappingsNonce),
+            nametagMaxCount = clicker.NametagMaxCount,
+            chestEsp = clicker.ChestEspEnabled,
+            chestEspMaxCount = clicker.ChestEspMaxCount,
+            reachEnabled = clicker.ReachEnabled,
+            reachMin = clicker.ReachMin,
+            reachMax = clicker.ReachMax,
+            reachChance = clicker.ReachChance,
+            velocityEnabled = clicker.VelocityEnabled,
+            velocityHorizontal = clicker.VelocityHorizontal,
+            velocityVertical = clicker.VelocityVertical,
+            velocityChance = clicker.VelocityChance,
+            autoTotemEnabled = clicker.AutoTotemEnabled,
+            autoTotemMode = clicker.AutoTotemMode,
+            autoTotemHealth = clicker.AutoTotemHealth,
+            autoTotemElytra = clicker.AutoTotemElytra,
+            autoTotemDelay = clicker.AutoTotemDelay,
+            autoTotemBehaviorMode = clicker.AutoTotemBehaviorMode,
+            // Per-module keybinds
+            keybindAutoclicker   = InputHooks.GetModuleKey("autoclicker"),
+            keybindRightClick    = InputHooks.GetModuleKey("rightclick"),
+            keybindJitter        = InputHooks.GetModuleKey("jitter"),
+            keybindClickInChests = InputHooks.GetModuleKey("clickinchests"),
+            keybindBreakBlocks   = InputHooks.GetModuleKey("breakblocks"),
+            keybindAimAssist     = InputHooks.GetModuleKey("aimassist"),
+            keybindTriggerbot    = InputHooks.GetModuleKey("triggerbot"),
+            keybindSpeedBridge   = InputHooks.GetModuleKey("speedbridge"),
+            keybindGtbHelper     = InputHooks.GetModuleKey("gtbhelper"),
+            keybindNametags      = InputHooks.GetModuleKey("nametags"),
+            keybindClosestPlayer = InputHooks.GetModuleKey("closestplayer"),
+            keybindChestEsp      = InputHooks.GetModuleKey("chestesp")
+        };
+    }
+
     // === ClickGUI Command Handler ===
 
     private void HandleBridgeCommand(string json)
@@ -852,26 +1379,26 @@ public class GameStateClient : INotifyPropertyChanged
                     var mw = System.Windows.Application.Current?.MainWindow as MainWindow;
                     if (mw != null)
                         mw.Dispatcher.Invoke(mw.ShowControlCenterFromBridge);
-                    break;
+                    break;
                 case "toggleArmed":
                     clicker.ToggleArmed();
-                    break;
+                    break;
                 case "toggleLeft":
                     clicker.LeftClickEnabled = !clicker.LeftClickEnabled;
-                    break;
+                    break;
                 case "toggleRight":
                     clicker.RightClickEnabled = !clicker.RightClickEnabled;
-                    break;
+                    break;
                 case "toggleJitter":
                     clicker.JitterEnabled = !clicker.JitterEnabled;
-                    break;
+                    break;
 
                 case "toggleClickInChests":
                     clicker.ClickInChests = !clicker.ClickInChests;
-                    break;
+                    break;
                 case "toggleAimAssist":
                     clicker.AimAssistEnabled = !clicker.AimAssistEnabled;
-                    break;
+                    break;
                 case "toggleTriggerbot":
                     clicker.TriggerbotEnabled = !clicker.TriggerbotEnabled;
                     break;
@@ -892,59 +1419,59 @@ public class GameStateClient : INotifyPropertyChanged
                     break;
                 case "toggleNametags":
                     clicker.NametagsEnabled = !clicker.NametagsEnabled;
-                    break;
+                    break;
                 case "toggleClosestPlayerInfo":
                     clicker.ClosestPlayerInfoEnabled = !clicker.ClosestPlayerInfoEnabled;
-                    break;
+                    break;
                 case "toggleNametagHealth":
                     clicker.NametagShowHealth = !clicker.NametagShowHealth;
-                    break;
+                    break;
                 case "toggleNametagArmor":
                     clicker.NametagShowArmor = !clicker.NametagShowArmor;
-                    break;
+                    break;
                 case "toggleNametagHeldItem":
                     clicker.NametagShowHeldItem = !clicker.NametagShowHeldItem;
-                    break;
+                    break;
                 case "toggleNametagHideVanilla":
                     clicker.NametagHideVanilla = !clicker.NametagHideVanilla;
-                    break;
+                    break;
                 case "toggleChestEsp":
                     clicker.ChestEspEnabled = !clicker.ChestEspEnabled;
-                    break;
+                    break;
                 case "setKeybind":
                     string? moduleId = node?["module"]?.GetValue<string>();
                     int vkCode = node?["key"]?.GetValue<int>() ?? 0;
                     if (moduleId != null)
                         InputHooks.SetModuleKey(moduleId, vkCode);
-                    break;
+                    break;
                 case "setMinCPS":
                     float minVal = node?["value"]?.GetValue<float>() ?? 8;
                     clicker.MinCPS = minVal;
-                    break;
+                    break;
                 case "setMaxCPS":
                     float maxVal = node?["value"]?.GetValue<float>() ?? 12;
                     clicker.MaxCPS = maxVal;
-                    break;
+                    break;
                 case "setRightMinCPS":
                     float rMinVal = node?["value"]?.GetValue<float>() ?? 10;
                     clicker.RightMinCPS = rMinVal;
-                    break;
+                    break;
                 case "setRightMaxCPS":
                     float rMaxVal = node?["value"]?.GetValue<float>() ?? 14;
                     clicker.RightMaxCPS = rMaxVal;
-                    break;
+                    break;
                 case "toggleRightBlockOnly":
                     clicker.RightClickOnlyBlock = !clicker.RightClickOnlyBlock;
-                    break;
+                    break;
                 case "toggleBreakBlocks":
                     clicker.BreakBlocksEnabled = !clicker.BreakBlocksEnabled;
-                    break;
+                    break;
                 case "setAimAssistFov":
                     clicker.AimAssistFov = node?["value"]?.GetValue<float>() ?? 30;
-                    break;
+                    break;
                 case "setAimAssistRange":
                     clicker.AimAssistRange = node?["value"]?.GetValue<float>() ?? 4.5f;
-                    break;
+                    break;
                 case "setAimAssistStrength":
                     clicker.AimAssistStrength = node?["value"]?.GetValue<int>() ?? 40;
                     break;
@@ -953,46 +1480,46 @@ public class GameStateClient : INotifyPropertyChanged
                     break;
                 case "toggleReach":
                     clicker.ReachEnabled = !clicker.ReachEnabled;
-                    break;
+                    break;
                 case "setReachMin":
                     clicker.ReachMin = node?["value"]?.GetValue<float>() ?? 3.0f;
-                    break;
+                    break;
                 case "setReachMax":
                     clicker.ReachMax = node?["value"]?.GetValue<float>() ?? 6.0f;
-                    break;
+                    break;
                 case "setReachChance":
                     clicker.ReachChance = (int)(node?["value"]?.GetValue<float>() ?? 100f);
-                    break;
+                    break;
                 case "toggleVelocity":
                     clicker.VelocityEnabled = !clicker.VelocityEnabled;
-                    break;
+                    break;
                 case "toggleAutoTotem":
                     clicker.AutoTotemEnabled = !clicker.AutoTotemEnabled;
-                    break;
+                    break;
                 case "setAutoTotemMode":
                     clicker.AutoTotemMode = (int)(node?["value"]?.GetValue<float>() ?? 0f);
-                    break;
+                    break;
                 case "setAutoTotemHealth":
                     clicker.AutoTotemHealth = (int)(node?["value"]?.GetValue<float>() ?? 10f);
-                    break;
+                    break;
                 case "toggleAutoTotemElytra":
                     clicker.AutoTotemElytra = !clicker.AutoTotemElytra;
-                    break;
+                    break;
                 case "setAutoTotemDelay":
                     clicker.AutoTotemDelay = (int)(node?["value"]?.GetValue<float>() ?? 0f);
-                    break;
+                    break;
                 case "setAutoTotemBehaviorMode":
                     clicker.AutoTotemBehaviorMode = (int)(node?["value"]?.GetValue<float>() ?? 0f);
-                    break;
+                    break;
                 case "setVelocityHorizontal":
                     clicker.VelocityHorizontal = (int)(node?["value"]?.GetValue<float>() ?? 100f);
-                    break;
+                    break;
                 case "setVelocityVertical":
                     clicker.VelocityVertical = (int)(node?["value"]?.GetValue<float>() ?? 100f);
-                    break;
+                    break;
                 case "setVelocityChance":
                     clicker.VelocityChance = (int)(node?["value"]?.GetValue<float>() ?? 100f);
-                    break;
+                    break;
             }
 
             Log($"Bridge command: {action}");
@@ -0,0 +1,217 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+using System.Text.Json;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// Parses JSON state lines straight from the reader's buffer, with names and screen texts
+/// interned, so a 200 Hz state stream decodes no strings once the name table is warm. Replaces
+/// <c>JsonSerializer.Deserialize&lt;GameState&gt;</c> on the socket path and accepts the same
+/// contract (property names are case-sensitive, unknown properties are skipped, missing ones
+/// keep the <see cref="GameState"/> defaults).
+/// <para>
+/// Every line gets its own <see cref="GameState"/>, entity list and entities, and nothing is
+/// written to them after <see cref="Read"/> returns: the state is published as
+/// <see cref="GameStateClient.CurrentState"/> and read from the click scheduler and UI threads
+/// for as long as they hold it. One reader per connection; not thread-safe.
+/// </para>
+/// </summary>
+internal sealed class GameStateJsonReader
+{
+    private static readonly GameState Defaults = new();
+
+    private readonly Utf8StringInterner _strings;
+    private byte[] _unescaped = new byte[256];
+    private int _entityHint = 8;
+    private bool _sawActionBar;
+    private string _actionBar = "";
+
+    public GameStateJsonReader(Utf8StringInterner? strings = null)
+    {
+        _strings = strings ?? Utf8StringInterner.ForCurrentThread;
+    }
+
+    /// <summary>
+    /// True for a state line: the 1.8.9 bridge's untyped object or 26.1's <c>"type":"state"</c>.
+    /// Everything else (capabilities, acks, commands, telemetry) carries another type.
+    /// </summary>
+    public static bool IsStateLine(ReadOnlySpan<byte> line)
+    {
+        int at = line.IndexOf("\"type\":\""u8);
+        return at < 0 || line.Slice(at).StartsWith("\"type\":\"state\""u8);
+    }
+
+    /// <summary>
+    /// Parses one state line into a new state. Returns null if it is not a JSON object or a
+    /// field has the wrong type; throws <see cref="JsonException"/> on malformed JSON.
+    /// </summary>
+    public GameState? Read(ReadOnlySpan<byte> line)
+    {
+        // Sized from the previous line so the list does not regrow while it is filled.
+        var state = new GameState { Entities = new List<EntityInfo>(_entityHint) };
+
+        _sawActionBar = false;
+        var reader = new Utf8JsonReader(line, new JsonReaderOptions { CommentHandling = JsonCommentHandling.Skip });
+        if (!reader.Read() || reader.TokenType != JsonTokenType.StartObject)
+            return null;
+        try
+        {
+            while (reader.Read() && reader.TokenType == JsonTokenType.PropertyName)
+            {
+                if (!ReadProperty(ref reader, state))
+                    reader.Skip();
+            }
+        }
+        catch (Exception ex) when (ex is InvalidOperationException or FormatException)
+        {
+            // Wrong token type for a known property; JsonSerializer would have rejected it too.
+            return null;
+        }
+
+        // A bridge that tracks actionBarRev sends the text only on the line where it changed.
+        if (_sawActionBar) _actionBar = state.ActionBar;
+        else if (state.ActionBarRev != 0) state.ActionBar = _actionBar;
+
+        _entityHint = Math.Max(state.Entities.Count, 8);
+        return state;
+    }
+
+    // Consumes the value of a known property and returns true; false leaves it for Skip().
+    private bool ReadProperty(ref Utf8JsonReader reader, GameState state)
+    {
+        if (reader.ValueTextEquals("entities"u8))
+        {
+            reader.Read();
+            ReadEntities(ref reader, state.Entities);
+            return true;
+        }
+        if (reader.ValueTextEquals("mapped"u8)) { reader.Read(); state.Mapped = reader.GetBoolean(); return true; }
+        if (reader.ValueTextEquals("guiOpen"u8)) { reader.Read(); state.GuiOpen = reader.GetBoolean(); return true; }
+        if (reader.ValueTextEquals("screenName"u8)) { reader.Read(); state.ScreenName = ReadString(ref reader, Defaults.ScreenName); return true; }
+        if (reader.ValueTextEquals("actionBar"u8)) { reader.Read(); state.ActionBar = ReadString(ref reader, Defaults.ActionBar); _sawActionBar = true; return true; }
+        if (reader.ValueTextEquals("actionBarRev"u8)) { reader.Read(); state.ActionBarRev = reader.GetUInt32(); return true; }
+        if (reader.ValueTextEquals("health"u8)) { reader.Read(); state.Health = reader.GetSingle(); return true; }
+        if (reader.ValueTextEquals("fov"u8)) { reader.Read(); state.Fov = reader.GetSingle(); return true; }
+        if (reader.ValueTextEquals("holdingBlock"u8)) { reader.Read(); state.HoldingBlock = reader.GetBoolean(); return true; }
+        if (reader.ValueTextEquals("lookingAtBlock"u8)) { reader.Read(); state.LookingAtBlock = reader.GetBoolean(); return true; }
+        if (reader.ValueTextEquals("lookingAtEntity"u8)) { reader.Read(); state.LookingAtEntity = reader.GetBoolean(); return true; }
+        if (reader.ValueTextEquals("lookingAtEntityLatched"u8)) { reader.Read(); state.LookingAtEntityLatched = reader.GetBoolean(); return true; }
+        if (reader.ValueTextEquals("breakingBlock"u8)) { reader.Read(); state.BreakingBlock = reader.GetBoolean(); return true; }
+        if (reader.ValueTextEquals("attackCooldown"u8)) { reader.Read(); state.AttackCooldown = reader.GetSingle(); return true; }
+        if (reader.ValueTextEquals("attackCooldownPerTick"u8)) { reader.Read(); state.AttackCooldownPerTick = reader.GetSingle(); return true; }
+        if (reader.ValueTextEquals("stateMs"u8)) { reader.Read(); state.StateMs = reader.GetUInt64(); return true; }
+        if (reader.ValueTextEquals("tick"u8)) { reader.Read(); state.Tick = reader.GetUInt32(); return true; }
+        if (reader.ValueTextEquals("tickSampleMs"u8)) { reader.Read(); state.TickSampleMs = reader.GetUInt64(); return true; }
+        if (reader.ValueTextEquals("posX"u8)) { reader.Read(); state.PosX = reader.GetDouble(); return true; }
+        if (reader.ValueTextEquals("posY"u8)) { reader.Read(); state.PosY = reader.GetDouble(); return true; }
+        if (reader.ValueTextEquals("posZ"u8)) { reader.Read(); state.PosZ = reader.GetDouble(); return true; }
+        if (reader.ValueTextEquals("pitch"u8)) { reader.Read(); state.Pitch = reader.GetSingle(); return true; }
+        return false;
+    }
+
+    private void ReadEntities(ref Utf8JsonReader reader, List<EntityInfo> entities)
+    {
+        if (reader.TokenType == JsonTokenType.Null) return;
+        if (reader.TokenType != JsonTokenType.StartArray)
+            throw new InvalidOperationException("entities is not an array");
+
+        while (reader.Read() && reader.TokenType == JsonTokenType.StartObject)
+        {
+            var entity = new EntityInfo();
+
+            while (reader.Read() && reader.TokenType == JsonTokenType.PropertyName)
+            {
+                if (reader.ValueTextEquals("sx"u8)) { reader.Read(); entity.Sx = reader.GetSingle(); }
+                else if (reader.ValueTextEquals("sy"u8)) { reader.Read(); entity.Sy = reader.GetSingle(); }
+                else if (reader.ValueTextEquals("dist"u8)) { reader.Read(); entity.Dist = reader.GetDouble(); }
+                else if (reader.ValueTextEquals("name"u8)) { reader.Read(); entity.Name = ReadString(ref reader, ""); }
+                else if (reader.ValueTextEquals("hp"u8)) { reader.Read(); entity.Hp = reader.GetSingle(); }
+                else if (reader.ValueTextEquals("x"u8)) { reader.Read(); entity.X = reader.GetDouble(); }
+                else if (reader.ValueTextEquals("y"u8)) { reader.Read(); entity.Y = reader.GetDouble(); }
+                else if (reader.ValueTextEquals("z"u8)) { reader.Read(); entity.Z = reader.GetDouble(); }
+                else reader.Skip();
+            }
+            entities.Add(entity);
+        }
+    }
+
+    private string ReadString(ref Utf8JsonReader reader, string fallback)
+    {
+        if (reader.TokenType == JsonTokenType.Null) return fallback;
+        if (reader.TokenType != JsonTokenType.String)
+            throw new InvalidOperationException("expected a string");
+        if (!reader.ValueIsEscaped)
+            return _strings.Intern(reader.ValueSpan);
+
+        if (_unescaped.Length < reader.ValueSpan.Length)
+            _unescaped = new byte[Math.Max(reader.ValueSpan.Length, _unescaped.Length * 2)];
+        int written = reader.CopyString(_unescaped);
+        return _strings.Intern(_unescaped.AsSpan(0, written));
+    }
+}
+
+/// <summary>
+/// Maps UTF-8 bytes to one shared string per distinct value, so player names, screen names
+/// and action bar texts that repeat across packets are decoded once. Open addressing over a
+/// fixed table; when it fills up (a server cycling many one-off texts) it starts over rather
+/// than growing. Not thread-safe: each bridge I/O thread uses <see cref="ForCurrentThread"/>.
+/// </summary>
+internal sealed class Utf8StringInterner
+{
+    public const int Capacity = 1024;
+    public const int MaxLength = 256;
+
+    [ThreadStatic]
+    private static Utf8StringInterner? t_current;
+
+    private readonly byte[]?[] _keys = new byte[Capacity * 2][];
+    private readonly string?[] _values = new string[Capacity * 2];
+    private readonly int[] _hashes = new int[Capacity * 2];
+    private int _count;
+
+    public static Utf8StringInterner ForCurrentThread => t_current ??= new Utf8StringInterner();
+
+    public int Count => _count;
+
+    public string Intern(ReadOnlySpan<byte> utf8)
+    {
+        if (utf8.IsEmpty) return "";
+        if (utf8.Length > MaxLength) return Encoding.UTF8.GetString(utf8);
+
+        int hash = Hash(utf8);
+        int mask = _keys.Length - 1;
+        int i = hash & mask;
+        while (_keys[i] != null)
+        {
+            if (_hashes[i] == hash && utf8.SequenceEqual(_keys[i]))
+                return _values[i]!;
+            i = (i + 1) & mask;
+        }
+
+        if (_count >= Capacity)
+        {
+            Array.Clear(_keys);
+            Array.Clear(_values);
+            _count = 0;
+            i = hash & mask;
+        }
+
+        string value = Encoding.UTF8.GetString(utf8);
+        _keys[i] = utf8.ToArray();
+        _values[i] = value;
+        _hashes[i] = hash;
+        _count++;
+        return value;
+    }
+
+    // FNV-1a; names are short, so this beats anything fancier.
+    private static int Hash(ReadOnlySpan<byte> utf8)
+    {
+        uint h = 2166136261;
+        foreach (byte b in utf8)
+            h = (h ^ b) * 16777619;
+        return (int)h;
+    }
+}
@@ -0,0 +1,77 @@
+using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Text;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// Pre-baked GTB word table (Data\gtb_wordlist.bin), written at build time from
+/// gtb_wordlist.js by the BakeGtbWordList target in Aoko.csproj and mapped read-only
+/// the first time the solver needs words. Layout and writer: <see cref="GtbWordListFormat"/>.
+/// </summary>
+internal static unsafe class GtbWordList
+{
+    private const uint Magic = GtbWordListFormat.Magic;
+    private const uint Version = GtbWordListFormat.Version;
+    private const int HeaderBytes = GtbWordListFormat.HeaderBytes;
+
+    /// <summary>
+    /// Words from the table at <paramref name="path"/>, or null when it is missing,
+    /// unreadable or not a word table.
+    /// </summary>
+    public static List<string>? TryRead(string path)
+    {
+        try
+        {
+            if (new FileInfo(path).Length < HeaderBytes) return null;
+            using var mapping = MemoryMappedFile.CreateFromFile(path, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+            using var accessor = mapping.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+            byte* view = null;
+            accessor.SafeMemoryMappedViewHandle.AcquirePointer(ref view);
+            try
+            {
+                return Parse(new ReadOnlySpan<byte>(view + accessor.PointerOffset, (int)accessor.Capacity));
+            }
+            finally
+            {
+                accessor.SafeMemoryMappedViewHandle.ReleasePointer();
+            }
+        }
+        catch (IOException)
+        {
+            return null;
+        }
+        catch (UnauthorizedAccessException)
+        {
+            return null;
+        }
+    }
+
+    internal static List<string>? Parse(ReadOnlySpan<byte> data)
+    {
+        if (data.Length < HeaderBytes
+            || BinaryPrimitives.ReadUInt32LittleEndian(data) != Magic
+            || BinaryPrimitives.ReadUInt32LittleEndian(data[4..]) != Version)
+            return null;
+
+        uint count = BinaryPrimitives.ReadUInt32LittleEndian(data[8..]);
+        long bytesStart = HeaderBytes + 4L * (count + 1);
+        if (bytesStart > data.Length) return null;
+
+        var offsets = data.Slice(HeaderBytes, (int)(4 * (count + 1)));
+        ReadOnlySpan<byte> bytes = data[(int)bytesStart..];
+        var words = new List<string>((int)count);
+        uint prev = BinaryPrimitives.ReadUInt32LittleEndian(offsets);
+        for (int i = 1; i <= count; i++)
+        {
+            uint next = BinaryPrimitives.ReadUInt32LittleEndian(offsets[(4 * i)..]);
+            if (next < prev || next > bytes.Length) return null;
+            words.Add(Encoding.ASCII.GetString(bytes[(int)prev..(int)next]));
+            prev = next;
+        }
+        return words;
+    }
+}
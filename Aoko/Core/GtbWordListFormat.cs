@@ -0,0 +1,95 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+#if !AOKO_APP
+using System.Text.RegularExpressions;
+using Microsoft.Build.Framework;
+using Microsoft.Build.Utilities;
+#endif
+
+// Compiled twice: into Aoko (AOKO_APP defined) for GtbWordList and the tests, and by the
+// BakeGtbWordList task in Aoko.csproj, which also gets the task class at the bottom. Keep
+// it to C# and APIs the task compiler has (netstandard2.0, no file-scoped namespace).
+namespace Aoko.Core
+{
+    /// <summary>
+    /// Layout of the GTB word table (Data\gtb_wordlist.bin), little-endian:
+    /// "GTBW", u32 version, u32 count, u32 reserved, u32 offsets[count + 1] into the
+    /// ASCII bytes that follow. Words are de-duplicated and sorted ordinally.
+    /// </summary>
+    internal static class GtbWordListFormat
+    {
+        public const uint Magic = 0x57425447; // "GTBW"
+        public const uint Version = 1;
+        public const int HeaderBytes = 16;
+
+        /// <summary>Writes <paramref name="words"/> (already normalised) as a word table.</summary>
+        public static int Write(string path, IEnumerable<string> words)
+        {
+            var sorted = words.Distinct(StringComparer.Ordinal).OrderBy(w => w, StringComparer.Ordinal).ToList();
+            using (var writer = new BinaryWriter(File.Create(path)))
+            {
+                writer.Write(Magic);
+                writer.Write(Version);
+                writer.Write((uint)sorted.Count);
+                writer.Write(0u);
+                uint offset = 0;
+                writer.Write(offset);
+                foreach (string word in sorted)
+                {
+                    offset += (uint)word.Length;
+                    writer.Write(offset);
+                }
+                foreach (string word in sorted)
+                    writer.Write(Encoding.ASCII.GetBytes(word));
+            }
+            return sorted.Count;
+        }
+    }
+
+#if !AOKO_APP
+    /// <summary>Build task: bakes the word array of gtb_wordlist.js into a word table.</summary>
+    public class BakeGtbWordList : Task
+    {
+        [Required] public string Source { get; set; }
+        [Required] public string Output { get; set; }
+
+        public override bool Execute()
+        {
+            string text = File.ReadAllText(Source);
+            int start = -1, end = -1;
+            foreach (string name in new[] { "wordsData", "arrayData" })
+            {
+                int at = text.IndexOf(name, StringComparison.OrdinalIgnoreCase);
+                if (at < 0) continue;
+                start = text.IndexOf('[', at);
+                end = start >= 0 ? text.IndexOf("];", start, StringComparison.Ordinal) : -1;
+                if (start >= 0 && end > start) break;
+            }
+            if (start < 0 || end <= start)
+            {
+                start = text.IndexOf('[');
+                end = text.LastIndexOf(']');
+            }
+
+            var words = new List<string>();
+            if (start >= 0 && end > start)
+            {
+                foreach (Match m in Regex.Matches(text.Substring(start, end - start), "\"((?:\\\\.|[^\"])*)\""))
+                {
+                    string w = Regex.Replace(m.Groups[1].Value, "[^A-Za-z ]", "");
+                    w = Regex.Replace(w, "\\s+", " ").Trim().ToLowerInvariant();
+                    if (w.Length >= 3) words.Add(w);
+                }
+            }
+
+            Directory.CreateDirectory(Path.GetDirectoryName(Path.GetFullPath(Output)));
+            int count = GtbWordListFormat.Write(Output, words);
+            Log.LogMessage(MessageImportance.Normal, "Baked " + count + " GTB words into " + Output);
+            return true;
+        }
+    }
+#endif
+}
@@ -11,6 +11,7 @@ public static class GtbWordSolver
     private static readonly object Sync = new();
     private static List<string>? _words;
     private static HashSet<string>? _wordSet;
+    private static WordIndex? _index;
     private static string? _customWordPath;
     private static string _lastMask = "";
     private static IReadOnlyList<string> _lastMatches = Array.Empty<string>();
@@ -22,17 +23,14 @@ public static class GtbWordSolver
             return ("", Array.Empty<string>());
 
         EnsureLoaded();
-        var words = _words ?? new List<string>();
 
         lock (Sync)
         {
             if (mask == _lastMask)
                 return (mask, _lastMatches);
 
-            var matches = words
-                .Where(w => IsMatch(w, mask))
-                .Take(Math.Max(1, maxResults))
-                .ToList();
+            _index ??= new WordIndex(_words ?? new List<string>());
+            IReadOnlyList<string> matches = _index.Find(mask, Math.Max(1, maxResults));
 
             _lastMask = mask;
             _lastMatches = matches;
@@ -51,6 +49,7 @@ public static class GtbWordSolver
             _customWordPath = Path.Combine(baseDir, "Data", "gtb_wordlist_custom.txt");
             _words = LoadWords(_customWordPath);
             _wordSet = new HashSet<string>(_words, StringComparer.Ordinal);
+            _index = new WordIndex(_words);
         }
     }
 
@@ -74,6 +73,7 @@ public static class GtbWordSolver
             words.Add(solvedWord);
             _words = words;
             _wordSet = wordSet;
+            _index?.Add(solvedWord);
             _lastMask = "";
             _lastMatches = Array.Empty<string>();
             AppendCustomWord(solvedWord);
@@ -91,6 +91,24 @@ public static class GtbWordSolver
         };
 
         string? path = candidates.FirstOrDefault(File.Exists);
+
+        // The baked table wins unless the .js next to it was edited after it.
+        string[] tables =
+        {
+            Path.Combine(baseDir, "Data", "gtb_wordlist.bin"),
+            Path.Combine(baseDir, "gtb_wordlist.bin")
+        };
+        string? table = tables.FirstOrDefault(File.Exists);
+        if (table != null && (path == null || File.GetLastWriteTimeUtc(table) >= File.GetLastWriteTimeUtc(path)))
+        {
+            List<string>? baked = GtbWordList.TryRead(table);
+            if (baked != null)
+            {
+                baked.AddRange(LoadCustomWords(customWordPath));
+                return baked.Distinct().ToList();
+            }
+        }
+
         if (path == null) return LoadCustomWords(customWordPath);
 
         string text;
@@ -347,6 +365,121 @@ public static class GtbWordSolver
         return new string(chars.ToArray());
     }
 
+    // Words grouped by shape (length and where the spaces are), each group
+    // with one bitset per (position, letter) over the group's words.  A mask
+    // is answered by AND-ing the bitsets of its known letters inside its
+    // shape's group, so only words that match are ever touched.  Groups keep
+    // insertion order, so results come out in word-list order like a scan.
+    private sealed class WordIndex
+    {
+        private readonly Dictionary<string, Group> _groups = new(StringComparer.Ordinal);
+        private ulong[] _scratch = Array.Empty<ulong>();
+
+        public WordIndex(IEnumerable<string> words)
+        {
+            foreach (string word in words)
+                Add(word);
+        }
+
+        public void Add(string word)
+        {
+            if (word.Length == 0) return;
+            string shape = ShapeOf(word);
+            if (!_groups.TryGetValue(shape, out Group? group))
+            {
+                group = new Group(word.Length);
+                _groups[shape] = group;
+            }
+            group.Add(word);
+        }
+
+        public IReadOnlyList<string> Find(string mask, int maxResults)
+        {
+            if (!_groups.TryGetValue(ShapeOf(mask), out Group? group))
+                return Array.Empty<string>();
+
+            int blocks = group.Blocks;
+            if (_scratch.Length < blocks)
+                _scratch = new ulong[Math.Max(blocks, _scratch.Length * 2)];
+            ulong[] acc = _scratch;
+            Array.Fill(acc, ulong.MaxValue, 0, blocks);
+
+            for (int i = 0; i < mask.Length; i++)
+            {
+                char c = mask[i];
+                if (c < 'a' || c > 'z') continue;
+                ulong[]? bits = group.Bits[i * 26 + (c - 'a')];
+                if (bits == null)
+                    return Array.Empty<string>();
+                for (int b = 0; b < blocks; b++)
+                    acc[b] &= bits[b];
+            }
+
+            var matches = new List<string>(Math.Min(maxResults, 16));
+            int count = group.Words.Count;
+            for (int b = 0; b < blocks && matches.Count < maxResults; b++)
+            {
+                ulong word = acc[b];
+                while (word != 0 && matches.Count < maxResults)
+                {
+                    int bit = System.Numerics.BitOperations.TrailingZeroCount(word);
+                    int idx = (b << 6) + bit;
+                    if (idx >= count) break;
+                    matches.Add(group.Words[idx]);
+                    word &= word - 1;
+                }
+            }
+            return matches;
+        }
+
+        // Letters and blanks become '_'; spaces stay, so "__ ___" keys every
+        // two-word phrase of that layout.
+        private static string ShapeOf(string text)
+        {
+            return string.Create(text.Length, text, static (span, src) =>
+            {
+                for (int i = 0; i < span.Length; i++)
+                    span[i] = src[i] == ' ' ? ' ' : '_';
+            });
+        }
+
+        private sealed class Group
+        {
+            public readonly List<string> Words = new();
+            public readonly ulong[]?[] Bits;
+            public int Blocks;
+            private int _capacity;   // blocks allocated in each bitset
+
+            public Group(int length)
+            {
+                Bits = new ulong[]?[length * 26];
+            }
+
+            public void Add(string word)
+            {
+                int idx = Words.Count;
+                Words.Add(word);
+                Blocks = (Words.Count + 63) >> 6;
+                if (Blocks > _capacity)
+                {
+                    _capacity = Math.Max(Blocks, _capacity * 2);
+                    for (int i = 0; i < Bits.Length; i++)
+                        if (Bits[i] != null)
+                            Array.Resize(ref Bits[i], _capacity);
+                }
+
+                for (int i = 0; i < word.Length; i++)
+                {
+                    char c = word[i];
+                    if (c < 'a' || c > 'z') continue;
+                    ref ulong[]? bits = ref Bits[i * 26 + (c - 'a')];
+                    bits ??= new ulong[_capacity];
+                    bits[idx >> 6] |= 1UL << (idx & 63);
+                }
+            }
+        }
+    }
+
     private static bool IsMatch(string word, string mask)
     {
         bool maskHasSpace = mask.Contains(' ');
@@ -2,7 +2,9 @@ using System;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Runtime.InteropServices;
+using System.Threading;
 using System.Windows;
+using System.Windows.Threading;
 
 namespace Aoko.Core;
 
@@ -21,6 +23,27 @@ public static class InputHooks
     
     [DllImport("kernel32.dll", CharSet = CharSet.Unicode)]
     private static extern IntPtr GetModuleHandle(string? lpModuleName);
+
+    [DllImport("kernel32.dll")]
+    private static extern uint GetCurrentThreadId();
+
+    [DllImport("user32.dll")]
+    private static extern int GetMessage(out MSG lpMsg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax);
+
+    [DllImport("user32.dll")]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool PeekMessage(out MSG lpMsg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax, uint wRemoveMsg);
+
+    [DllImport("user32.dll")]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool TranslateMessage(ref MSG lpMsg);
+
+    [DllImport("user32.dll")]
+    private static extern IntPtr DispatchMessage(ref MSG lpMsg);
+
+    [DllImport("user32.dll")]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool PostThreadMessage(uint idThread, uint msg, IntPtr wParam, IntPtr lParam);
     
     private delegate IntPtr LowLevelProc(int nCode, IntPtr wParam, IntPtr lParam);
     
@@ -33,6 +56,10 @@ public static class InputHooks
     private const int WM_RBUTTONUP = 0x0205;
     private const int VK_OEM_3 = 0xC0; // Backtick key
     private const uint LLMHF_INJECTED = 0x00000001;
+    private const uint WM_QUIT = 0x0012;
+    private const uint WM_APP_DRAIN = 0x8000 + 1;   // WM_APP + 1
+    private const uint PM_NOREMOVE = 0x0000;
+    private const int LatencyReportSeconds = 60;
     
     [StructLayout(LayoutKind.Sequential)]
     private struct KBDLLHOOKSTRUCT
@@ -54,9 +81,62 @@ public static class InputHooks
         public uint Time;
         public IntPtr DwExtraInfo;
     }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct MSG
+    {
+        public IntPtr Hwnd;
+        public uint Message;
+        public IntPtr WParam;
+        public IntPtr LParam;
+        public uint Time;
+        public int PtX;
+        public int PtY;
+    }
+
+    private enum HookEventKind : byte
+    {
+        KeyCaptured,
+        ModuleKey,
+        LeftDown,
+        LeftUp,
+        RightDown,
+        RightUp
+    }
+
+    // What a hook callback hands to the UI thread.
+    private struct HookEvent
+    {
+        public HookEventKind Kind;
+        public int Code;
+        public string? ModuleId;
+        public long Timestamp;
+    }
     
     private static IntPtr _keyboardHook = IntPtr.Zero;
     private static IntPtr _mouseHook = IntPtr.Zero;
+
+    // The hooks run on their own message-loop thread and queue events for the UI thread.
+    private static Thread? _hookThread;
+    private static uint _hookThreadId;
+    private static Dispatcher? _dispatcher;
+    private static readonly ManualResetEventSlim _hooksReady = new(false);
+    private static readonly SpscQueue<HookEvent> Events = new(256);
+    private static readonly Action DrainAction = DrainEvents;
+    private static int _drainPosted;
+    private static long _lastLatencyReport = Stopwatch.GetTimestamp();
+
+    // VK -> bound module id, rebuilt on every SetModuleKey so the keyboard hook
+    // never walks the dictionary.
+    private static readonly object KeyMapLock = new();
+    private static volatile string?[] _keyMap = new string?[256];
+    private static volatile bool _isCapturingKey;
+
+    /// <summary>Time spent inside the hook callbacks.</summary>
+    internal static LatenessHistogram CallbackLatency { get; } = new();
+
+    /// <summary>Time from a hook callback to the UI thread handling its event.</summary>
+    internal static LatenessHistogram DeliveryLatency { get; } = new();
     
     // Keep delegates alive to prevent GC
     private static LowLevelProc? _keyboardProc;
@@ -85,6 +165,7 @@ public static class InputHooks
     public static void SetModuleKey(string moduleId, int vk)
     {
         ModuleKeys[moduleId] = vk;
+        RebuildKeyMap();
         OnStateChanged?.Invoke();
     }
 
@@ -92,22 +173,27 @@ public static class InputHooks
         => ModuleKeys.TryGetValue(moduleId, out int vk) ? vk : 0;
 
     // Key capture mode for rebinding (reserved for future use)
-    public static bool IsCapturingKey { get; private set; } = false;
+    public static bool IsCapturingKey => _isCapturingKey;
     public static event Action<int>? OnKeyCaptured;
 
     public static event Action? OnToggleRequested;
     public static event Action? OnStateChanged;
 
-    public static bool IsPhysicalLeftButtonDown { get; private set; } = false;
+    private static volatile bool _isPhysicalLeftButtonDown;
+    public static bool IsPhysicalLeftButtonDown
+    {
+        get => _isPhysicalLeftButtonDown;
+        private set => _isPhysicalLeftButtonDown = value;
+    }
 
     public static void StartKeyCapture()
     {
-        IsCapturingKey = true;
+        _isCapturingKey = true;
     }
 
     public static void StopKeyCapture()
     {
-        IsCapturingKey = false;
+        _isCapturingKey = false;
     }
 
     private static void ToggleModule(string moduleId)
@@ -118,7 +204,7 @@ public static class InputHooks
             return;
         }
 
-        if (!GameStateClient.Instance.SupportsModule(moduleId))
+        if (!GameStateClient.Active.SupportsModule(moduleId))
             return;
 
         var c = Clicker.Instance;
@@ -144,19 +230,68 @@ public static class InputHooks
     
     public static void Install()
     {
-        _keyboardProc = KeyboardProc;
-        _mouseProc = MouseProc;
-        
-        using var curProcess = Process.GetCurrentProcess();
-        using var curModule = curProcess.MainModule;
-        IntPtr moduleHandle = GetModuleHandle(curModule?.ModuleName);
-        
-        _keyboardHook = SetWindowsHookEx(WH_KEYBOARD_LL, _keyboardProc, moduleHandle, 0);
-        _mouseHook = SetWindowsHookEx(WH_MOUSE_LL, _mouseProc, moduleHandle, 0);
+        if (_hookThread != null) return;
+
+        _dispatcher = Application.Current?.Dispatcher;
+        RebuildKeyMap();
+        _hooksReady.Reset();
+        _hookThread = new Thread(HookThreadMain)
+        {
+            IsBackground = true,
+            Name = "Aoko input hooks",
+            // Windows waits on LL hook callbacks before delivering input anywhere on the desktop.
+            Priority = ThreadPriority.Highest
+        };
+        _hookThread.Start();
+        _hooksReady.Wait(2000);
     }
     
     public static void Uninstall()
     {
+        var thread = _hookThread;
+        if (thread == null) return;
+        _hookThread = null;
+
+        PostThreadMessage(_hookThreadId, WM_QUIT, IntPtr.Zero, IntPtr.Zero);
+        thread.Join(1000);
+    }
+
+    private static void HookThreadMain()
+    {
+        _hookThreadId = GetCurrentThreadId();
+        // Create the thread's message queue before anyone can post to it.
+        PeekMessage(out _, IntPtr.Zero, 0, 0, PM_NOREMOVE);
+
+        _keyboardProc = KeyboardProc;
+        _mouseProc = MouseProc;
+
+        using (var curProcess = Process.GetCurrentProcess())
+        using (var curModule = curProcess.MainModule)
+        {
+            IntPtr moduleHandle = GetModuleHandle(curModule?.ModuleName);
+            _keyboardHook = SetWindowsHookEx(WH_KEYBOARD_LL, _keyboardProc, moduleHandle, 0);
+            _mouseHook = SetWindowsHookEx(WH_MOUSE_LL, _mouseProc, moduleHandle, 0);
+        }
+        WindowDetection.StartTracking();
+        _hooksReady.Set();
+
+        // The hooks are called from inside GetMessage on this thread.
+        while (GetMessage(out MSG msg, IntPtr.Zero, 0, 0) > 0)
+        {
+            if (msg.Hwnd == IntPtr.Zero && msg.Message == WM_APP_DRAIN)
+            {
+                if (_dispatcher != null)
+                    _dispatcher.BeginInvoke(DrainAction);
+                else
+                    DrainEvents();
+                continue;
+            }
+            TranslateMessage(ref msg);
+            DispatchMessage(ref msg);
+        }
+
+        WindowDetection.StopTracking();
+
         if (_keyboardHook != IntPtr.Zero)
         {
             UnhookWindowsHookEx(_keyboardHook);
@@ -169,148 +304,197 @@ public static class InputHooks
             _mouseHook = IntPtr.Zero;
         }
     }
-    
-    private static IntPtr KeyboardProc(int nCode, IntPtr wParam, IntPtr lParam)
+
+    private static void RebuildKeyMap()
+    {
+        lock (KeyMapLock)
+        {
+            var map = new string?[256];
+            foreach (var kvp in ModuleKeys)
+            {
+                // First binding wins, as the dictionary scan did before.
+                if (kvp.Value > 0 && kvp.Value < map.Length && map[kvp.Value] == null)
+                    map[kvp.Value] = kvp.Key;
+            }
+            _keyMap = map;
+        }
+    }
+
+    // The callbacks only classify the input and queue it: anything slower here
+    // delays every key press and mouse move on the system.
+    private static unsafe IntPtr KeyboardProc(int nCode, IntPtr wParam, IntPtr lParam)
     {
         if (nCode >= 0 && wParam == (IntPtr)WM_KEYDOWN)
         {
-            var kb = Marshal.PtrToStructure<KBDLLHOOKSTRUCT>(lParam);
+            long start = Stopwatch.GetTimestamp();
+            uint vk = ((KBDLLHOOKSTRUCT*)lParam)->VkCode;
+            bool block = false;
             
             // Key capture mode - capture the pressed key
-            if (IsCapturingKey)
+            if (_isCapturingKey)
             {
-                IsCapturingKey = false;
-                Application.Current?.Dispatcher.BeginInvoke(() =>
-                {
-                    OnKeyCaptured?.Invoke((int)kb.VkCode);
-                });
-                return (IntPtr)1; // Block the key
+                _isCapturingKey = false;
+                Push(new HookEvent { Kind = HookEventKind.KeyCaptured, Code = (int)vk, Timestamp = start });
+                block = true;
             }
-            
-            // Per-module keybinds
-            foreach (var kvp in ModuleKeys)
+            else if (vk < 256 && _keyMap[vk] is { } moduleId)
             {
-                if (kvp.Value > 0 && kb.VkCode == (uint)kvp.Value)
-                {
-                    string id = kvp.Key;
-                    Application.Current?.Dispatcher.BeginInvoke(() =>
-                    {
-                        ToggleModule(id);
-                        OnToggleRequested?.Invoke();
-                        OnStateChanged?.Invoke();
-                    });
-                    return (IntPtr)1; // Block the key
-                }
+                // Per-module keybinds
+                Push(new HookEvent { Kind = HookEventKind.ModuleKey, ModuleId = moduleId, Timestamp = start });
+                block = true;
             }
+
+            CallbackLatency.Record(Stopwatch.GetTimestamp() - start);
+            if (block) return (IntPtr)1; // Block the key
         }
         
         return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
     }
     
-    private static IntPtr MouseProc(int nCode, IntPtr wParam, IntPtr lParam)
+    private static unsafe IntPtr MouseProc(int nCode, IntPtr wParam, IntPtr lParam)
     {
         if (nCode >= 0)
         {
-            var ms = Marshal.PtrToStructure<MSLLHOOKSTRUCT>(lParam);
-            
+            long start = Stopwatch.GetTimestamp();
+
             // Ignore injected events (our own clicks)
-            if ((ms.Flags & LLMHF_INJECTED) != 0)
+            if ((((MSLLHOOKSTRUCT*)lParam)->Flags & LLMHF_INJECTED) == 0)
             {
-                return CallNextHookEx(_mouseHook, nCode, wParam, lParam);
+                int msg = wParam.ToInt32();
+                switch (msg)
+                {
+                    case WM_LBUTTONDOWN:
+                        IsPhysicalLeftButtonDown = true;
+                        Push(new HookEvent { Kind = HookEventKind.LeftDown, Timestamp = start });
+                        break;
+                    case WM_LBUTTONUP:
+                        IsPhysicalLeftButtonDown = false;
+                        Push(new HookEvent { Kind = HookEventKind.LeftUp, Timestamp = start });
+                        break;
+                    case WM_RBUTTONDOWN:
+                        Push(new HookEvent { Kind = HookEventKind.RightDown, Timestamp = start });
+                        break;
+                    case WM_RBUTTONUP:
+                        Push(new HookEvent { Kind = HookEventKind.RightUp, Timestamp = start });
+                        break;
+                }
             }
-            
-            int msg = wParam.ToInt32();
 
-            if (msg == WM_LBUTTONDOWN) IsPhysicalLeftButtonDown = true;
-            else if (msg == WM_LBUTTONUP) IsPhysicalLeftButtonDown = false;
+            CallbackLatency.Record(Stopwatch.GetTimestamp() - start);
+        }
+        
+        return CallNextHookEx(_mouseHook, nCode, wParam, lParam);
+    }
 
-            bool isLeftClickMessage = msg == WM_LBUTTONDOWN || msg == WM_LBUTTONUP;
-            if (isLeftClickMessage && !Clicker.Instance.IsArmed)
-                return CallNextHookEx(_mouseHook, nCode, wParam, lParam);
-            
-            if (msg == WM_LBUTTONDOWN)
-            {
-                Application.Current?.Dispatcher.BeginInvoke(() =>
+    private static void Push(in HookEvent evt)
+    {
+        // One wake-up per batch: the drain clears the flag before it reads the queue.
+        if (Events.TryEnqueue(evt) && Interlocked.Exchange(ref _drainPosted, 1) == 0)
+            PostThreadMessage(_hookThreadId, WM_APP_DRAIN, IntPtr.Zero, IntPtr.Zero);
+    }
+
+    // UI thread (hook thread when there is no dispatcher).
+    private static void DrainEvents()
+    {
+        Interlocked.Exchange(ref _drainPosted, 0);
+        while (Events.TryDequeue(out var evt))
+        {
+            DeliveryLatency.Record(Stopwatch.GetTimestamp() - evt.Timestamp);
+            HandleEvent(evt);
+        }
+
+        long now = Stopwatch.GetTimestamp();
+        if (now - _lastLatencyReport >= Stopwatch.Frequency * LatencyReportSeconds)
+        {
+            _lastLatencyReport = now;
+            Debug.WriteLine($"[InputHooks] callback {CallbackLatency}, delivery {DeliveryLatency}, dropped {Events.Dropped}");
+        }
+    }
+
+    private static void HandleEvent(in HookEvent evt)
+    {
+        switch (evt.Kind)
+        {
+            case HookEventKind.KeyCaptured:
+                OnKeyCaptured?.Invoke(evt.Code);
+                break;
+
+            case HookEventKind.ModuleKey:
+                ToggleModule(evt.ModuleId!);
+                OnToggleRequested?.Invoke();
+                OnStateChanged?.Invoke();
+                break;
+
+            case HookEventKind.LeftDown:
+                if (!Clicker.Instance.IsArmed) break;
+                if (GameStateClient.Active.IsConnected)
                 {
-                    if (GameStateClient.Instance.IsConnected)
-                    {
-                        var state = GameStateClient.Instance.CurrentState;
-                        bool chestGuiOpen =
-                            state.GuiOpen &&
-                            (state.ScreenName.Contains("GuiChest", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("ContainerScreen", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("class_481", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("GuiContainer", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("HopperScreen", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("class_488", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("ShulkerBox", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("class_495", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("HandledScreen", StringComparison.OrdinalIgnoreCase) ||
-                             state.ScreenName.Contains("class_465", StringComparison.OrdinalIgnoreCase));
-
-                        // In chest/container screens, a left click should not mark mining intent.
-                        if (chestGuiOpen && Clicker.Instance.ClickInChests)
-                            Clicker.Instance.IsMiningIntent = false;
-                        else
-                            Clicker.Instance.IsMiningIntent = state.LookingAtBlock;
-                    }
-                    else
-                    {
+                    var state = GameStateClient.Active.CurrentState;
+                    bool chestGuiOpen =
+                        state.GuiOpen &&
+                        (state.ScreenName.Contains("GuiChest", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("ContainerScreen", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("class_481", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("GuiContainer", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("HopperScreen", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("class_488", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("ShulkerBox", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("class_495", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("HandledScreen", StringComparison.OrdinalIgnoreCase) ||
+                         state.ScreenName.Contains("class_465", StringComparison.OrdinalIgnoreCase));
+
+                    // In chest/container screens, a left click should not mark mining intent.
+                    if (chestGuiOpen && Clicker.Instance.ClickInChests)
                         Clicker.Instance.IsMiningIntent = false;
-                    }
-                    Clicker.Instance.StartClicking(true);
-                    OnStateChanged?.Invoke();
-                });
-            }
-            else if (msg == WM_LBUTTONUP)
-            {
+                    else
+                        Clicker.Instance.IsMiningIntent = state.LookingAtBlock;
+                }
+                else
+                {
+                    Clicker.Instance.IsMiningIntent = false;
+                }
+                Clicker.Instance.StartClicking(true);
+                OnStateChanged?.Invoke();
+                break;
+
+            case HookEventKind.LeftUp:
+                if (!Clicker.Instance.IsArmed) break;
                 if (Clicker.Instance.IsClicking && Clicker.Instance.IsUsingLeftButton)
                 {
-                    Application.Current?.Dispatcher.BeginInvoke(() =>
-                    {
-                        Clicker.Instance.StopClicking();
-                        OnStateChanged?.Invoke();
-                    });
+                    Clicker.Instance.StopClicking();
+                    OnStateChanged?.Invoke();
                 }
-            }
-            else if (msg == WM_RBUTTONDOWN)
-            {
-                Application.Current?.Dispatcher.BeginInvoke(() =>
+                break;
+
+            case HookEventKind.RightDown:
+                // Check if right-click-only-block is enabled
+                if (Clicker.Instance.RightClickOnlyBlock)
                 {
-                    // Check if right-click-only-block is enabled
-                    if (Clicker.Instance.RightClickOnlyBlock)
-                    {
-                        // Fail-open when state is unavailable; only block if connected and confirmed not holding a block.
-                        if (GameStateClient.Instance.IsConnected && !GameStateClient.Instance.CurrentState.HoldingBlock)
-                        {
-                            // Don't start clicking - player isn't holding a block
-                            return;
-                        }
-                    }
-                    
-                    if (Clicker.Instance.IsClicking && Clicker.Instance.IsUsingLeftButton)
+                    // Fail-open when state is unavailable; only block if connected and confirmed not holding a block.
+                    if (GameStateClient.Active.IsConnected && !GameStateClient.Active.CurrentState.HoldingBlock)
                     {
-                        // Keep left autoclick stream alive for blockhit sequences.
-                        return;
+                        // Don't start clicking - player isn't holding a block
+                        break;
                     }
+                }
+                
+                if (Clicker.Instance.IsClicking && Clicker.Instance.IsUsingLeftButton)
+                {
+                    // Keep left autoclick stream alive for blockhit sequences.
+                    break;
+                }
 
-                    Clicker.Instance.StartClicking(false);
-                    OnStateChanged?.Invoke();
-                });
-            }
-            else if (msg == WM_RBUTTONUP)
-            {
+                Clicker.Instance.StartClicking(false);
+                OnStateChanged?.Invoke();
+                break;
+
+            case HookEventKind.RightUp:
                 if (Clicker.Instance.IsClicking && !Clicker.Instance.IsUsingLeftButton)
                 {
-                    Application.Current?.Dispatcher.BeginInvoke(() =>
-                    {
-                        Clicker.Instance.StopClicking();
-                        OnStateChanged?.Invoke();
-                    });
+                    Clicker.Instance.StopClicking();
+                    OnStateChanged?.Invoke();
                 }
-            }
+                break;
         }
-        
-        return CallNextHookEx(_mouseHook, nCode, wParam, lParam);
     }
 }
@@ -34,6 +34,32 @@ public static class NativeInjector
     [DllImport("kernel32.dll", SetLastError = true)]
     private static extern uint WaitForSingleObject(IntPtr hHandle, uint dwMilliseconds);
 
+    [DllImport("kernel32.dll", SetLastError = true)]
+    private static extern IntPtr CreateToolhelp32Snapshot(uint dwFlags, int th32ProcessID);
+
+    [DllImport("kernel32.dll", SetLastError = true, CharSet = CharSet.Unicode)]
+    private static extern bool Module32FirstW(IntPtr hSnapshot, ref MODULEENTRY32W lpme);
+
+    [DllImport("kernel32.dll", SetLastError = true, CharSet = CharSet.Unicode)]
+    private static extern bool Module32NextW(IntPtr hSnapshot, ref MODULEENTRY32W lpme);
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Unicode)]
+    private struct MODULEENTRY32W
+    {
+        public uint dwSize;
+        public uint th32ModuleID;
+        public uint th32ProcessID;
+        public uint GlblcntUsage;
+        public uint ProccntUsage;
+        public IntPtr modBaseAddr;
+        public uint modBaseSize;
+        public IntPtr hModule;
+        [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 256)]
+        public string szModule;
+        [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 260)]
+        public string szExePath;
+    }
+
     // Access Rights
     private const uint PROCESS_CREATE_THREAD = 0x0002;
     private const uint PROCESS_QUERY_INFORMATION = 0x0400;
@@ -49,6 +75,12 @@ public static class NativeInjector
     private const uint WAIT_TIMEOUT = 0x00000102;
     private const uint INFINITE = 0xFFFFFFFF;
 
+    // Toolhelp
+    private const uint TH32CS_SNAPMODULE = 0x00000008;
+    private const uint TH32CS_SNAPMODULE32 = 0x00000010;
+    private const int ERROR_BAD_LENGTH = 24;
+    private static readonly IntPtr INVALID_HANDLE_VALUE = new(-1);
+
     private static void Log(string message)
     {
         try
@@ -64,6 +96,51 @@ public static class NativeInjector
         Log(message);
     }
 
+    /// <summary>
+    /// Looks for one of <paramref name="moduleNames"/> among the modules loaded in <paramref name="pid"/>,
+    /// i.e. a bridge that is still resident from an earlier loader. Null when the module list cannot
+    /// be read (access denied, process gone); otherwise whether one was found, with its full path.
+    /// </summary>
+    public static bool? FindResidentModule(int pid, string[] moduleNames, out string? modulePath)
+    {
+        modulePath = null;
+        IntPtr snapshot = INVALID_HANDLE_VALUE;
+        // ERROR_BAD_LENGTH means the process was loading or unloading a module; retry.
+        for (int attempt = 0; attempt < 3 && snapshot == INVALID_HANDLE_VALUE; attempt++)
+        {
+            snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, pid);
+            if (snapshot == INVALID_HANDLE_VALUE && Marshal.GetLastWin32Error() != ERROR_BAD_LENGTH)
+                break;
+        }
+        if (snapshot == INVALID_HANDLE_VALUE)
+        {
+            Log($"Module snapshot of PID {pid} failed. Error: {Marshal.GetLastWin32Error()}");
+            return null;
+        }
+
+        try
+        {
+            var entry = new MODULEENTRY32W { dwSize = (uint)Marshal.SizeOf<MODULEENTRY32W>() };
+            for (bool ok = Module32FirstW(snapshot, ref entry); ok; ok = Module32NextW(snapshot, ref entry))
+            {
+                foreach (string name in moduleNames)
+                {
+                    if (string.Equals(entry.szModule, name, StringComparison.OrdinalIgnoreCase))
+                    {
+                        modulePath = entry.szExePath;
+                        Log($"Resident module in PID {pid}: {modulePath}");
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+        finally
+        {
+            CloseHandle(snapshot);
+        }
+    }
+
     public static bool Inject(int pid, string dllPath, Action<int, string>? progress = null)
     {
         ReportProgress(progress, 2, $"Starting injection into PID {pid}");
@@ -12,6 +12,7 @@ public class Profile
     public string GuiTheme { get; set; } = "Slate";
     public string ModuleListStyle { get; set; } = "Default";
     public bool ShowLogo { get; set; } = true;
+    public int OverlayUpdateHz { get; set; } = 0;
     public bool DiscordRpcEnabled { get; set; } = true;
     public bool IsArmed { get; set; } = false;
     public float MinCPS { get; set; } = 8.0f;
@@ -226,6 +227,7 @@ public static class ProfileManager
             GuiTheme = clicker.GuiTheme,
             ModuleListStyle = clicker.ModuleListStyle,
             ShowLogo = clicker.ShowLogo,
+            OverlayUpdateHz = clicker.OverlayUpdateHz,
             DiscordRpcEnabled = clicker.DiscordRpcEnabled,
             
             RightClickEnabled = clicker.RightClickEnabled,
@@ -304,6 +306,7 @@ public static class ProfileManager
         if (profile.GuiTheme != null) clicker.GuiTheme = profile.GuiTheme;
         if (profile.ModuleListStyle != null) clicker.ModuleListStyle = profile.ModuleListStyle;
         clicker.ShowLogo = profile.ShowLogo;
+        clicker.OverlayUpdateHz = profile.OverlayUpdateHz;
         clicker.DiscordRpcEnabled = profile.DiscordRpcEnabled;
         
         clicker.RightClickEnabled = profile.RightClickEnabled;
@@ -0,0 +1,236 @@
+using System;
+using System.Buffers.Binary;
+using System.IO.MemoryMappedFiles;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// Loader side of the bridge's shared-memory transport (layout in
+/// McInjector/src/main/cpp/shm_channel.h): reads lcb1 frames straight out of the
+/// mapped ring and writes config into the mailbox. The TCP socket stays open as the
+/// session and fallback.
+/// </summary>
+internal sealed unsafe class SharedMemoryBridgeChannel : IDisposable
+{
+    public const uint Magic = 0x4D53434C; // "LCSM"
+    public const uint Version = 2;
+    public const int SlotCount = 64;
+    public const int SlotBytes = 8192;
+    public const int ConfigOffset = 64;
+    public const int ConfigBytes = 16384;
+    public const int RingOffset = ConfigOffset + ConfigBytes;
+    public const int MappingBytes = RingOffset + SlotCount * SlotBytes;
+    public const int MaxFrameSlots = 16;
+    private const int SlotHeaderBytes = 16;
+    private const int SlotPayloadBytes = SlotBytes - SlotHeaderBytes;
+
+    internal delegate T FrameDecoder<T>(byte frameType, byte version, ReadOnlySpan<byte> payload);
+
+    private readonly object _sync = new();
+    private readonly MemoryMappedFile? _mapping;
+    private readonly MemoryMappedViewAccessor? _accessor;
+    private readonly EventWaitHandle? _stateEvent;
+    private readonly EventWaitHandle? _configEvent;
+    private byte* _view;
+    private long _next;
+    private byte[] _spill = Array.Empty<byte>();
+
+    public long Overruns { get; private set; }
+
+    private SharedMemoryBridgeChannel(byte* view, MemoryMappedFile? mapping, MemoryMappedViewAccessor? accessor,
+        EventWaitHandle? stateEvent, EventWaitHandle? configEvent)
+    {
+        _view = view;
+        _mapping = mapping;
+        _accessor = accessor;
+        _stateEvent = stateEvent;
+        _configEvent = configEvent;
+        _next = Interlocked.Read(ref *(long*)(view + 16)); // re-read the newest frame first
+        if (_next < 1) _next = 1;
+    }
+
+    /// <summary>Opens the bridge's objects by base name; null if missing or the layout does not match.</summary>
+    public static SharedMemoryBridgeChannel? TryOpen(string baseName)
+    {
+        MemoryMappedFile? mapping = null;
+        MemoryMappedViewAccessor? accessor = null;
+        EventWaitHandle? stateEvent = null;
+        EventWaitHandle? configEvent = null;
+        bool pointerAcquired = false;
+        try
+        {
+            string local = "Local\\" + baseName;
+            mapping = MemoryMappedFile.OpenExisting(local, MemoryMappedFileRights.ReadWrite);
+            accessor = mapping.CreateViewAccessor(0, MappingBytes, MemoryMappedFileAccess.ReadWrite);
+            stateEvent = EventWaitHandle.OpenExisting(local + "_state");
+            configEvent = EventWaitHandle.OpenExisting(local + "_config");
+
+            byte* view = null;
+            accessor.SafeMemoryMappedViewHandle.AcquirePointer(ref view);
+            pointerAcquired = true;
+            view += accessor.PointerOffset;
+            if (!LayoutMatches(view))
+                throw new InvalidOperationException("Unexpected shared-memory layout.");
+
+            return new SharedMemoryBridgeChannel(view, mapping, accessor, stateEvent, configEvent);
+        }
+        catch (Exception)
+        {
+            if (pointerAcquired) accessor!.SafeMemoryMappedViewHandle.ReleasePointer();
+            accessor?.Dispose();
+            mapping?.Dispose();
+            stateEvent?.Dispose();
+            configEvent?.Dispose();
+            return null;
+        }
+    }
+
+    /// <summary>Wraps an already-initialised mapping image (no events); used by tests.</summary>
+    internal static SharedMemoryBridgeChannel? FromView(IntPtr view)
+        => LayoutMatches((byte*)view) ? new SharedMemoryBridgeChannel((byte*)view, null, null, null, null) : null;
+
+    private static bool LayoutMatches(byte* view)
+        => *(uint*)view == Magic
+            && *(uint*)(view + 4) == Version
+            && *(uint*)(view + 8) == SlotCount
+            && *(uint*)(view + 12) == SlotBytes;
+
+    /// <summary>
+    /// Completes with true when the bridge publishes a frame, false when the timeout passes.
+    /// The wait is registered with the thread pool, so no thread blocks on it.
+    /// </summary>
+    public Task<bool> WaitForFramesAsync(int timeoutMs)
+    {
+        if (_stateEvent == null) return Task.FromResult(false);
+        var signalled = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+        RegisteredWaitHandle registration = ThreadPool.RegisterWaitForSingleObject(_stateEvent,
+            (state, timedOut) => ((TaskCompletionSource<bool>)state!).TrySetResult(!timedOut),
+            signalled, timeoutMs, executeOnlyOnce: true);
+        signalled.Task.ContinueWith(_ => registration.Unregister(null), TaskScheduler.Default);
+        return signalled.Task;
+    }
+
+    /// <summary>
+    /// Decodes every frame published since the last call and hands the results to
+    /// <paramref name="apply"/>. Single-slot frames are decoded in place; a frame split over
+    /// several slots is copied out first. A frame the bridge overwrote while it was being read
+    /// is discarded. Returns the number of frames applied.
+    /// </summary>
+    public int Drain<T>(FrameDecoder<T> decode, Action<T> apply)
+    {
+        int applied = 0;
+        lock (_sync)
+        {
+            if (_view == null) return 0;
+            long published = Interlocked.Read(ref *(long*)(_view + 16));
+            if (published - _next + 1 > SlotCount)
+            {
+                Overruns += published - SlotCount + 1 - _next;
+                _next = published - SlotCount + 1;
+            }
+            for (; _next <= published; _next++)
+            {
+                long first = _next;
+                byte* slot = SlotAt(first);
+                ref long seq = ref *(long*)slot;
+                if (Interlocked.Read(ref seq) != first) { Overruns++; continue; }
+                uint parts = *(uint*)(slot + 12);
+                if (parts == 0) continue; // rest of a frame whose first slot was already overwritten
+
+                ReadOnlySpan<byte> frame;
+                if (parts == 1)
+                {
+                    uint len = *(uint*)(slot + 8);
+                    if (len > SlotPayloadBytes) continue;
+                    frame = new ReadOnlySpan<byte>(slot + SlotHeaderBytes, (int)len);
+                }
+                else
+                {
+                    if (parts > MaxFrameSlots || first + parts - 1 > published) continue;
+                    _next = first + parts - 1;
+                    if (!Gather(first, (int)parts, out frame)) { Overruns++; continue; }
+                }
+
+                if (frame.Length < BridgeProtocol.HeaderSize) continue;
+                uint payloadLen = BinaryPrimitives.ReadUInt32LittleEndian(frame.Slice(4));
+                if (payloadLen != frame.Length - BridgeProtocol.HeaderSize) continue;
+                T result;
+                try
+                {
+                    result = decode(frame[0], frame[1], frame.Slice(BridgeProtocol.HeaderSize));
+                }
+                catch (FormatException)
+                {
+                    continue;
+                }
+                if (Interlocked.Read(ref seq) != first) { Overruns++; continue; }
+                apply(result);
+                applied++;
+            }
+        }
+        return applied;
+    }
+
+    private byte* SlotAt(long n) => _view + RingOffset + (int)((n - 1) % SlotCount) * SlotBytes;
+
+    // Copies the chunks of a frame that starts at slot number `first` into _spill, checking
+    // each slot's seq after the copy. False if the bridge has since reused any of them.
+    private bool Gather(long first, int parts, out ReadOnlySpan<byte> frame)
+    {
+        frame = default;
+        int total = 0;
+        for (int i = 0; i < parts; i++)
+        {
+            byte* slot = SlotAt(first + i);
+            ref long seq = ref *(long*)slot;
+            if (Interlocked.Read(ref seq) != first + i) return false;
+            uint len = *(uint*)(slot + 8);
+            if (len > SlotPayloadBytes) return false;
+            if (_spill.Length < total + (int)len)
+                Array.Resize(ref _spill, Math.Max(total + (int)len, _spill.Length * 2));
+            new ReadOnlySpan<byte>(slot + SlotHeaderBytes, (int)len).CopyTo(_spill.AsSpan(total));
+            total += (int)len;
+            if (Interlocked.Read(ref seq) != first + i) return false;
+        }
+        frame = _spill.AsSpan(0, total);
+        return true;
+    }
+
+    /// <summary>Publishes one JSON config object to the mailbox and wakes the bridge.</summary>
+    public bool WriteConfig(ReadOnlySpan<byte> json)
+    {
+        if (json.Length > ConfigBytes) return false;
+        lock (_sync)
+        {
+            if (_view == null) return false;
+            ref int seq = ref *(int*)(_view + 24);
+            int s = Volatile.Read(ref seq);
+            if ((s & 1) != 0) s++; // a previous writer died mid-update
+            Interlocked.Exchange(ref seq, s + 1);
+            json.CopyTo(new Span<byte>(_view + ConfigOffset, ConfigBytes));
+            *(uint*)(_view + 28) = (uint)json.Length;
+            Interlocked.Exchange(ref seq, s + 2);
+            _configEvent?.Set();
+        }
+        return true;
+    }
+
+    public void Dispose()
+    {
+        lock (_sync)
+        {
+            if (_view == null) return;
+            _view = null;
+            if (_accessor != null)
+            {
+                _accessor.SafeMemoryMappedViewHandle.ReleasePointer();
+                _accessor.Dispose();
+            }
+            _mapping?.Dispose();
+            _stateEvent?.Dispose();
+            _configEvent?.Dispose();
+        }
+    }
+}
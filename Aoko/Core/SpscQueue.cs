@@ -0,0 +1,58 @@
+using System;
+using System.Threading;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// Bounded single-producer / single-consumer ring. One thread may call
+/// <see cref="TryEnqueue"/> and one other thread <see cref="TryDequeue"/>; neither
+/// blocks nor allocates. Capacity is rounded up to a power of two.
+/// </summary>
+internal sealed class SpscQueue<T> where T : struct
+{
+    private readonly T[] _items;
+    private readonly int _mask;
+    private long _head;     // next slot to read; written by the consumer
+    private long _tail;     // next slot to write; written by the producer
+    private long _dropped;
+
+    public SpscQueue(int capacity)
+    {
+        int size = 1;
+        while (size < Math.Max(2, capacity)) size <<= 1;
+        _items = new T[size];
+        _mask = size - 1;
+    }
+
+    public int Capacity => _items.Length;
+    public long Dropped => Interlocked.Read(ref _dropped);
+    public int Count => (int)(Volatile.Read(ref _tail) - Volatile.Read(ref _head));
+
+    /// <summary>Producer side; false (and counted as dropped) when the ring is full.</summary>
+    public bool TryEnqueue(in T item)
+    {
+        long tail = _tail;
+        if (tail - Volatile.Read(ref _head) >= _items.Length)
+        {
+            Interlocked.Increment(ref _dropped);
+            return false;
+        }
+        _items[tail & _mask] = item;
+        Volatile.Write(ref _tail, tail + 1);
+        return true;
+    }
+
+    /// <summary>Consumer side.</summary>
+    public bool TryDequeue(out T item)
+    {
+        long head = _head;
+        if (head == Volatile.Read(ref _tail))
+        {
+            item = default;
+            return false;
+        }
+        item = _items[head & _mask];
+        Volatile.Write(ref _head, head + 1);
+        return true;
+    }
+}
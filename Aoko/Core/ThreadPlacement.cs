@@ -0,0 +1,67 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace Aoko.Core;
+
+/// <summary>
+/// Thread placement for Aoko's own timing thread. Aoko runs in the background while the game has
+/// focus, and Windows may then put its threads under EcoQoS and onto efficiency cores, which shows
+/// up as late clicks. <see cref="OptOutOfEcoQos"/> opts the calling thread out explicitly through
+/// <c>SetThreadInformation(ThreadPowerThrottling)</c>, the call the bridges use to opt their
+/// background threads in, and leaves it free to run on any core. <c>LC_THREAD_POLICY=off</c>
+/// skips it, as it does in the bridges.
+/// </summary>
+internal static class ThreadPlacement
+{
+    [DllImport("kernel32.dll")]
+    private static extern IntPtr GetCurrentThread();
+
+    [DllImport("kernel32.dll", SetLastError = true)]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool SetThreadInformation(IntPtr hThread, int threadInformationClass,
+        ref THREAD_POWER_THROTTLING_STATE threadInformation, int threadInformationSize);
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct THREAD_POWER_THROTTLING_STATE
+    {
+        public uint Version;
+        public uint ControlMask;
+        public uint StateMask;
+    }
+
+    private const int ThreadPowerThrottling = 3;
+    private const uint THREAD_POWER_THROTTLING_CURRENT_VERSION = 1;
+    private const uint THREAD_POWER_THROTTLING_EXECUTION_SPEED = 0x1;
+
+    public static bool Disabled
+    {
+        get
+        {
+            string? policy = Environment.GetEnvironmentVariable("LC_THREAD_POLICY");
+            if (string.IsNullOrEmpty(policy)) return false;
+            return policy.Equals("off", StringComparison.OrdinalIgnoreCase) || "0nNfF".Contains(policy[0]);
+        }
+    }
+
+    /// <summary>Returns what was done, for the caller's log line.</summary>
+    public static string OptOutOfEcoQos()
+    {
+        if (Disabled) return "EcoQoS left to Windows (LC_THREAD_POLICY=off)";
+        var state = new THREAD_POWER_THROTTLING_STATE
+        {
+            Version = THREAD_POWER_THROTTLING_CURRENT_VERSION,
+            ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED,
+            StateMask = 0
+        };
+        try
+        {
+            return SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling, ref state, Marshal.SizeOf<THREAD_POWER_THROTTLING_STATE>())
+                ? "EcoQoS off"
+                : $"EcoQoS opt-out refused (error {Marshal.GetLastWin32Error()})";
+        }
+        catch (EntryPointNotFoundException)
+        {
+            return "EcoQoS opt-out unavailable";
+        }
+    }
+}
@@ -1,6 +1,7 @@
 using System;
 using System.Runtime.InteropServices;
 using System.Text;
+using System.Threading;
 
 namespace Aoko.Core;
 
@@ -21,7 +22,34 @@ public static class WindowDetection
     [DllImport("user32.dll")]
     private static extern bool GetWindowRect(IntPtr hWnd, out RECT lpRect);
     
+    [DllImport("user32.dll")]
+    private static extern bool IsWindow(IntPtr hWnd);
+
+    [DllImport("user32.dll")]
+    private static extern bool IsIconic(IntPtr hWnd);
+
+    [DllImport("user32.dll")]
+    private static extern uint GetWindowThreadProcessId(IntPtr hWnd, out uint processId);
+
+    [DllImport("user32.dll")]
+    private static extern IntPtr SetWinEventHook(uint eventMin, uint eventMax, IntPtr hmodWinEventProc,
+        WinEventProc lpfnWinEventProc, uint idProcess, uint idThread, uint dwFlags);
+
+    [DllImport("user32.dll")]
+    private static extern bool UnhookWinEvent(IntPtr hWinEventHook);
+    
     private delegate bool EnumWindowsProc(IntPtr hWnd, IntPtr lParam);
+
+    private delegate void WinEventProc(IntPtr hWinEventHook, uint eventType, IntPtr hwnd, int idObject,
+        int idChild, uint idEventThread, uint dwmsEventTime);
+
+    private const uint EVENT_SYSTEM_FOREGROUND = 0x0003;
+    private const uint EVENT_SYSTEM_MINIMIZESTART = 0x0016;
+    private const uint EVENT_SYSTEM_MINIMIZEEND = 0x0017;
+    private const uint EVENT_OBJECT_NAMECHANGE = 0x800C;
+    private const uint WINEVENT_OUTOFCONTEXT = 0x0000;
+    private const uint WINEVENT_SKIPOWNPROCESS = 0x0002;
+    private const int OBJID_WINDOW = 0;
     
     [StructLayout(LayoutKind.Sequential)]
     public struct RECT
@@ -35,10 +63,92 @@ public static class WindowDetection
     private static readonly string[] GameTitles = { "Minecraft", "Lunar Client", "Badlion" };
     
     private static IntPtr _foundWindow = IntPtr.Zero;
+
+    // Foreground tracking: WinEvent hooks (on the input hook thread, which pumps
+    // messages) keep these current, so the clicker loops read a flag instead of polling.
+    private static IntPtr _foregroundHook;
+    private static IntPtr _minimizeHook;
+    private static IntPtr _nameChangeHook;
+    private static WinEventProc? _winEventProc;
+    private static volatile bool _tracking;
+    private static volatile bool _isGameFocused;
+    private static IntPtr _gameWindow;
+    private static int _gameProcessId;
+
+    /// <summary>Raised on the hook thread when <see cref="IsGameFocused"/> changes.</summary>
+    public static event Action<bool>? GameFocusChanged;
+
+    /// <summary>Cached: a game window is in the foreground and not minimized.</summary>
+    public static bool IsGameFocused => _tracking ? _isGameFocused : IsMinecraftForegroundTitle(GetForegroundWindow());
     
-    public static bool IsMinecraftActive()
+    public static bool IsMinecraftActive() => IsGameFocused;
+
+    /// <summary>PID of the game window that last had focus; 0 until one did.</summary>
+    public static int GameProcessId => Volatile.Read(ref _gameProcessId);
+
+    // Must run on a thread with a message loop; the callbacks are delivered there.
+    internal static void StartTracking()
+    {
+        if (_tracking) return;
+        _winEventProc = OnWinEvent;
+        uint flags = WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS;
+        _foregroundHook = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, IntPtr.Zero, _winEventProc, 0, 0, flags);
+        _minimizeHook = SetWinEventHook(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND, IntPtr.Zero, _winEventProc, 0, 0, flags);
+        _nameChangeHook = SetWinEventHook(EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, IntPtr.Zero, _winEventProc, 0, 0, flags);
+        if (_foregroundHook == IntPtr.Zero || _minimizeHook == IntPtr.Zero)
+        {
+            StopTracking();
+            return;
+        }
+
+        UpdateFocus(GetForegroundWindow());
+        _tracking = true;
+    }
+
+    internal static void StopTracking()
+    {
+        _tracking = false;
+        if (_foregroundHook != IntPtr.Zero) UnhookWinEvent(_foregroundHook);
+        if (_minimizeHook != IntPtr.Zero) UnhookWinEvent(_minimizeHook);
+        if (_nameChangeHook != IntPtr.Zero) UnhookWinEvent(_nameChangeHook);
+        _foregroundHook = _minimizeHook = _nameChangeHook = IntPtr.Zero;
+    }
+
+    private static void OnWinEvent(IntPtr hook, uint eventType, IntPtr hwnd, int idObject, int idChild,
+        uint idEventThread, uint dwmsEventTime)
+    {
+        if (idObject != OBJID_WINDOW) return;
+        switch (eventType)
+        {
+            case EVENT_SYSTEM_FOREGROUND:
+                UpdateFocus(hwnd);
+                break;
+            case EVENT_SYSTEM_MINIMIZESTART:
+            case EVENT_SYSTEM_MINIMIZEEND:
+                UpdateFocus(GetForegroundWindow());
+                break;
+            case EVENT_OBJECT_NAMECHANGE:
+                // Titles change all over the desktop; only the foreground window's matters.
+                if (hwnd == GetForegroundWindow()) UpdateFocus(hwnd);
+                break;
+        }
+    }
+
+    private static void UpdateFocus(IntPtr foreground)
+    {
+        bool focused = IsMinecraftForegroundTitle(foreground) && !IsIconic(foreground);
+        if (focused && Interlocked.Exchange(ref _gameWindow, foreground) != foreground)
+        {
+            GetWindowThreadProcessId(foreground, out uint pid);
+            Volatile.Write(ref _gameProcessId, (int)pid);
+        }
+        if (focused == _isGameFocused) return;
+        _isGameFocused = focused;
+        GameFocusChanged?.Invoke(focused);
+    }
+
+    private static bool IsMinecraftForegroundTitle(IntPtr hwnd)
     {
-        IntPtr hwnd = GetForegroundWindow();
         if (hwnd == IntPtr.Zero) return false;
         
         StringBuilder title = new StringBuilder(256);
@@ -99,7 +209,10 @@ public static class WindowDetection
     
     public static RECT? GetMinecraftWindowRect()
     {
-        IntPtr hwnd = FindMinecraftWindow();
+        // The last focused game window saves an EnumWindows pass on every aim/triggerbot step.
+        IntPtr hwnd = Interlocked.CompareExchange(ref _gameWindow, IntPtr.Zero, IntPtr.Zero);
+        if (hwnd == IntPtr.Zero || !IsWindow(hwnd) || !IsWindowVisible(hwnd))
+            hwnd = FindMinecraftWindow();
         if (hwnd == IntPtr.Zero) return null;
         
         if (GetWindowRect(hwnd, out RECT rect))
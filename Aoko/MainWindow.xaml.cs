@@ -2,12 +2,14 @@ using System;
 using System.ComponentModel;
 using System.Collections.Generic;
 using System.Runtime.InteropServices;
+using System.Text;
 using System.Threading;
 using System.Windows;
 using System.Windows.Controls;
 using System.Windows.Input;
 using System.Windows.Interop;
 using System.Windows.Media;
+using System.Windows.Shapes;
 using System.Windows.Threading;
 using Aoko.Core;
 
@@ -39,6 +41,11 @@ public partial class MainWindow : Window
     private bool _controlMode;
     private string? _pendingKeybindModuleId;
     private int _uiUpdateQueued;
+    private int _diagnosticsUpdateQueued;
+
+    // Telemetry samples charted on the Diagnostics tab, oldest first.
+    private const int TelemetryHistoryLength = 120;
+    private readonly Queue<BridgeTelemetry> _telemetryHistory = new();
     private static readonly Dictionary<string, string> ModuleTitles = new()
     {
         ["autoclicker"] = "AutoClicker",
@@ -136,6 +143,7 @@ public partial class MainWindow : Window
         // Subscribe to connection state changes
         GameStateClient.Instance.StateUpdated += OnGameStateUpdated;
         GameStateClient.Instance.PropertyChanged += OnGameStateClientPropertyChanged;
+        GameStateClient.Instance.TelemetryReceived += OnTelemetryReceived;
         InputHooks.OnStateChanged += InputHooks_OnStateChanged;
         InputHooks.OnKeyCaptured += InputHooks_OnKeyCaptured;
         
@@ -264,6 +272,28 @@ public partial class MainWindow : Window
         return "Unavailable on current bridge";
     }
 
+    // The 26.1 bridge resolves a module's mappings the first time it is switched on.
+    private static string GetAvailabilityText(string moduleId, bool supported)
+    {
+        if (!supported) return GetUnavailableModuleReason(moduleId);
+        return GameStateClient.Instance.GetModuleState(moduleId) switch
+        {
+            ModuleResolveState.Resolving => "Resolving mappings...",
+            ModuleResolveState.Failed => "Mappings not found for this version",
+            _ => "Available"
+        };
+    }
+
+    private static string FormatResolvingModules(GameStateClient gs)
+    {
+        var resolving = new List<string>();
+        foreach (KeyValuePair<string, ModuleResolveState> entry in gs.ModuleStates)
+        {
+            if (entry.Value == ModuleResolveState.Resolving) resolving.Add(entry.Key);
+        }
+        return resolving.Count == 0 ? "" : $" (resolving {string.Join(", ", resolving)})";
+    }
+
     private void UpdateVersionAvailabilityUi()
     {
         bool aimAssistSupported = IsModuleSupported("aimassist");
@@ -296,9 +326,9 @@ public partial class MainWindow : Window
         AimAssistAvailabilityText.Text = aimAssistSupported ? "Available" : "Unavailable on current bridge";
         TriggerbotAvailabilityText.Text = triggerbotSupported ? "Available" : "Unavailable on 1.8.9 (cooldown-era PvP only)";
         SpeedBridgeAvailabilityText.Text = speedBridgeSupported ? "Available" : "Unavailable on current bridge";
-        ReachAvailabilityText.Text = reachSupported ? "Available" : "Unavailable on current bridge";
-        VelocityAvailabilityText.Text = velocitySupported ? "Available" : "Unavailable on current bridge";
-        AutoTotemAvailabilityText.Text = autoTotemSupported ? "Available" : "Unavailable on current bridge";
+        ReachAvailabilityText.Text = GetAvailabilityText("reach", reachSupported);
+        VelocityAvailabilityText.Text = GetAvailabilityText("velocity", velocitySupported);
+        AutoTotemAvailabilityText.Text = GetAvailabilityText("autototem", autoTotemSupported);
         GtbHelperAvailabilityText.Text = gtbSupported
             ? "Hypixel Guess The Build helper using action-bar hints."
             : "Unavailable on current bridge";
@@ -511,7 +541,7 @@ public partial class MainWindow : Window
 
                     if (gs.IsConnected)
                     {
-                        InjectionStatusText.Text = "Status: Connected & Injected";
+                        InjectionStatusText.Text = "Status: Connected & Injected" + FormatResolvingModules(gs);
                         InjectionStatusText.Foreground = (Brush)(TryFindResource("AccentBrush") ?? new SolidColorBrush(Color.FromRgb(167, 125, 255)));
                         InjectionProgressBar.Visibility = Visibility.Collapsed;
                         InjectionProgressBar.Value = 100;
@@ -566,12 +596,112 @@ public partial class MainWindow : Window
             e.PropertyName == nameof(GameStateClient.InjectionProgress) ||
             e.PropertyName == nameof(GameStateClient.IsInjected) ||
             e.PropertyName == nameof(GameStateClient.InjectedVersion) ||
-            e.PropertyName == nameof(GameStateClient.Capabilities))
+            e.PropertyName == nameof(GameStateClient.Capabilities) ||
+            e.PropertyName == nameof(GameStateClient.ModuleStates))
         {
             UpdateGameStateUI();
         }
     }
 
+    // I/O thread: keep the sample, redraw at most once per dispatcher pass.
+    private void OnTelemetryReceived(BridgeTelemetry telemetry)
+    {
+        lock (_telemetryHistory)
+        {
+            _telemetryHistory.Enqueue(telemetry);
+            while (_telemetryHistory.Count > TelemetryHistoryLength)
+                _telemetryHistory.Dequeue();
+        }
+
+        if (Dispatcher.HasShutdownStarted || Dispatcher.HasShutdownFinished) return;
+        if (Interlocked.Exchange(ref _diagnosticsUpdateQueued, 1) != 0) return;
+        Dispatcher.BeginInvoke(() =>
+        {
+            Interlocked.Exchange(ref _diagnosticsUpdateQueued, 0);
+            UpdateDiagnosticsUi();
+        }, DispatcherPriority.Background);
+    }
+
+    private void DiagnosticsTab_Selected(object sender, RoutedEventArgs e)
+    {
+        UpdateDiagnosticsUi();
+    }
+
+    private void DiagnosticsChart_SizeChanged(object sender, SizeChangedEventArgs e)
+    {
+        UpdateDiagnosticsUi();
+    }
+
+    private void UpdateDiagnosticsUi()
+    {
+        // Charts are only drawn while someone looks at them.
+        if (!DiagnosticsTab.IsSelected) return;
+
+        BridgeTelemetry[] history;
+        lock (_telemetryHistory)
+            history = _telemetryHistory.ToArray();
+
+        BridgeTelemetry? latest = GameStateClient.Instance.LatestTelemetry;
+        if (latest == null)
+        {
+            DiagnosticsStatusText.Text = GameStateClient.Instance.IsConnected
+                ? "This bridge does not send telemetry."
+                : "Waiting for bridge telemetry...";
+            return;
+        }
+
+        string governor = latest.GovernorLevel >= 0
+            ? $" | scan governor level {latest.GovernorLevel}, scan thread {latest.ScanBusyPct:0.0}%"
+            : "";
+        DiagnosticsStatusText.Text = $"{GameStateClient.Instance.InjectedVersion} bridge | frame {latest.FrameMs:0.0} ms{governor} | updated {latest.ReceivedAt:HH:mm:ss}";
+
+        RunTimeValueText.Text = $"{latest.TotalRunUsPerSec / 1000.0:0.0} ms/s";
+        JniCallsValueText.Text = $"{latest.JniCallsPerSec:N0} /s";
+        BytesOutValueText.Text = $"{latest.BytesOutPerSec / 1024.0:0.0} KB/s";
+        SnapshotLagValueText.Text = $"{latest.SnapshotLag} gen, {latest.SnapshotAgeMs} ms old";
+        GlobalRefsValueText.Text = $"{latest.GlobalRefs} ({latest.WeakRefs} weak)";
+
+        DrawTelemetryChart(RunTimeChart, history, t => t.TotalRunUsPerSec / 1000.0);
+        DrawTelemetryChart(JniCallsChart, history, t => t.JniCallsPerSec);
+        DrawTelemetryChart(BytesOutChart, history, t => t.BytesOutPerSec);
+        DrawTelemetryChart(SnapshotLagChart, history, t => t.SnapshotAgeMs);
+        DrawTelemetryChart(GlobalRefsChart, history, t => t.GlobalRefs);
+
+        var modules = new StringBuilder();
+        modules.AppendLine($"{"module",-16}{"ms/s",10}{"JNI/s",12}{"runs/s",10}");
+        foreach (BridgeTelemetry.Module m in latest.Modules)
+            modules.AppendLine($"{m.Name,-16}{m.RunUsPerSec / 1000.0,10:0.00}{m.JniCallsPerSec,12:N0}{m.RunsPerSec,10:0.0}");
+        ModuleTelemetryText.Text = modules.ToString().TrimEnd();
+    }
+
+    // One line over the history, scaled to its own peak; the newest sample sits at the right edge.
+    private void DrawTelemetryChart(Canvas canvas, BridgeTelemetry[] history, Func<BridgeTelemetry, double> value)
+    {
+        canvas.Children.Clear();
+        double width = canvas.ActualWidth;
+        double height = canvas.ActualHeight;
+        if (history.Length < 2 || width <= 0 || height <= 0) return;
+
+        double peak = 0;
+        foreach (BridgeTelemetry t in history)
+            peak = Math.Max(peak, value(t));
+        if (peak <= 0) peak = 1;
+
+        double step = width / (TelemetryHistoryLength - 1);
+        double x = width - step * (history.Length - 1);
+        var line = new Polyline
+        {
+            Stroke = (Brush)(TryFindResource("AccentBrush") ?? Brushes.White),
+            StrokeThickness = 1.5
+        };
+        foreach (BridgeTelemetry t in history)
+        {
+            line.Points.Add(new Point(x, height - 2 - (height - 4) * value(t) / peak));
+            x += step;
+        }
+        canvas.Children.Add(line);
+    }
+
     protected override void OnClosed(EventArgs e)
     {
         DiscordRichPresenceService.Instance.Stop();
@@ -584,6 +714,7 @@ public partial class MainWindow : Window
         InputHooks.OnKeyCaptured -= InputHooks_OnKeyCaptured;
         GameStateClient.Instance.StateUpdated -= OnGameStateUpdated;
         GameStateClient.Instance.PropertyChanged -= OnGameStateClientPropertyChanged;
+        GameStateClient.Instance.TelemetryReceived -= OnTelemetryReceived;
         base.OnClosed(e);
     }
 
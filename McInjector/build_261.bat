@@ -1,7 +1,30 @@
 @echo off
 pushd "%~dp0"
-"C:\mingw64\mingw64\bin\g++.exe" -m64 -std=c++11 -shared -o bridge_261.dll src/main/cpp/bridge_261.cpp src/main/cpp/gl_loader.cpp src/main/cpp/jni_core/resolver.cpp src/main/cpp/jni_core/helper_bridge.cpp src/main/cpp/imgui/imgui.cpp src/main/cpp/imgui/imgui_draw.cpp src/main/cpp/imgui/imgui_tables.cpp src/main/cpp/imgui/imgui_widgets.cpp src/main/cpp/imgui/imgui_impl_win32.cpp src/main/cpp/imgui/imgui_impl_opengl3.cpp src/main/cpp/imgui/minhook_src/buffer.c src/main/cpp/imgui/minhook_src/hook.c src/main/cpp/imgui/minhook_src/trampoline.c src/main/cpp/imgui/minhook_src/hde/hde64.c -I"C:/Program Files/Java/jdk-17/include" -I"C:/Program Files/Java/jdk-17/include/win32" -I"src/main/cpp" -I"src/main/cpp/imgui" -I"src/main/cpp/imgui/minhook_src" -I"src/main/cpp/imgui/minhook_src/include" -lws2_32 -lopengl32 -lgdi32 -ldwmapi -static-libgcc -static-libstdc++ -Wl,--add-stdcall-alias
+REM The helper class helper_bridge.cpp loads into the JVM is compiled from source each build.
+powershell -NoProfile -ExecutionPolicy Bypass -File tools\embed_helper.ps1
+if errorlevel 1 exit /b 1
+REM "trace" builds record TRACE macros into the binary trace buffer (trace_buffer.h).
+set "LC_BRIDGE_DEFS="
+if /I "%~1"=="trace" set "LC_BRIDGE_DEFS=-DLC_TRACE_BUILD=1"
+REM "synthetic" builds can replace the player and chest scans with generated load (synthetic_load.h).
+if /I "%~1"=="synthetic" set "LC_BRIDGE_DEFS=-DLC_SYNTHETIC_LOAD=1"
+REM "release" builds ImGui, MinHook and jni_core as cached static libraries (build_libs.bat)
+REM and compiles the bridge at -O2 with LTO.  "release pgo-gen" makes an instrumented DLL
+REM for a profiling session; "release pgo-use" rebuilds it from the collected profile.
+REM Without "release" the flags stay as below (no optimisation) for debugging.
+if /I "%~1"=="release" goto release_build
+"C:\mingw64\mingw64\bin\g++.exe" -m64 -std=c++11 -shared %LC_BRIDGE_DEFS% -o bridge_261.dll src/main/cpp/bridge_261.cpp src/main/cpp/gl_loader.cpp src/main/cpp/overlay_context.cpp src/main/cpp/async_log.cpp src/main/cpp/trace_buffer.cpp src/main/cpp/synthetic_load.cpp src/main/cpp/frame_profiler.cpp src/main/cpp/hud_cache.cpp src/main/cpp/overlay_font.cpp src/main/cpp/projection.cpp src/main/cpp/debug_panel.cpp src/main/cpp/shm_channel.cpp src/main/cpp/bridge_protocol.cpp src/main/cpp/send_queue.cpp src/main/cpp/task_scheduler.cpp src/main/cpp/scan_governor.cpp src/main/cpp/thread_policy.cpp src/main/cpp/telemetry.cpp src/main/cpp/jni_core/resolver.cpp src/main/cpp/jni_core/jni_registry.cpp src/main/cpp/jni_core/mapping_cache.cpp src/main/cpp/jni_core/helper_bridge.cpp src/main/cpp/jni_core/jni_accounting.cpp src/main/cpp/jni_core/jni_replay.cpp src/main/cpp/jni_core/member_index.cpp src/main/cpp/jni_core/ref_ledger.cpp src/main/cpp/jni_core/scan_engine.cpp src/main/cpp/imgui/imgui.cpp src/main/cpp/imgui/imgui_draw.cpp src/main/cpp/imgui/imgui_tables.cpp src/main/cpp/imgui/imgui_widgets.cpp src/main/cpp/imgui/imgui_impl_win32.cpp src/main/cpp/imgui/imgui_impl_opengl3.cpp src/main/cpp/imgui/minhook_src/buffer.c src/main/cpp/imgui/minhook_src/hook.c src/main/cpp/imgui/minhook_src/trampoline.c src/main/cpp/imgui/minhook_src/hde/hde64.c -I"C:/Program Files/Java/jdk-17/include" -I"C:/Program Files/Java/jdk-17/include/win32" -I"src/main/cpp" -I"src/main/cpp/imgui" -I"src/main/cpp/imgui/minhook_src" -I"src/main/cpp/imgui/minhook_src/include" -lws2_32 -lopengl32 -lgdi32 -ldwmapi -static-libgcc -static-libstdc++ -Wl,--add-stdcall-alias
 if %errorlevel% neq 0 exit /b %errorlevel%
+goto built
+
+:release_build
+call build_libs.bat %~2
+if errorlevel 1 exit /b 1
+"%LC_GXX%" -m64 -std=c++11 -shared %LC_BRIDGE_DEFS% %LC_REL_LDFLAGS% -o bridge_261.dll src/main/cpp/bridge_261.cpp src/main/cpp/gl_loader.cpp src/main/cpp/overlay_context.cpp src/main/cpp/async_log.cpp src/main/cpp/trace_buffer.cpp src/main/cpp/synthetic_load.cpp src/main/cpp/frame_profiler.cpp src/main/cpp/hud_cache.cpp src/main/cpp/overlay_font.cpp src/main/cpp/projection.cpp src/main/cpp/debug_panel.cpp src/main/cpp/shm_channel.cpp src/main/cpp/bridge_protocol.cpp src/main/cpp/send_queue.cpp src/main/cpp/task_scheduler.cpp src/main/cpp/scan_governor.cpp src/main/cpp/thread_policy.cpp src/main/cpp/telemetry.cpp %LC_REL_LIBS% -I"C:/Program Files/Java/jdk-17/include" -I"C:/Program Files/Java/jdk-17/include/win32" -I"src/main/cpp" -I"src/main/cpp/imgui" -I"src/main/cpp/imgui/minhook_src" -I"src/main/cpp/imgui/minhook_src/include" -lws2_32 -lopengl32 -lgdi32 -ldwmapi -static-libgcc -static-libstdc++ -Wl,--add-stdcall-alias
+if %errorlevel% neq 0 exit /b %errorlevel%
+if /I "%~2"=="pgo-gen" echo Instrumented bridge_261.dll: inject it, play a session (join a world, enable the overlays), quit the game, then run "build_261.bat release pgo-use".
+
+:built
 echo Compilation successful!
 if not exist "..\Aoko\bin\Release\net8.0-windows" mkdir "..\Aoko\bin\Release\net8.0-windows"
 copy /Y bridge_261.dll "..\Aoko\bin\Release\net8.0-windows\bridge_261.dll"
@@ -0,0 +1,85 @@
+@echo off
+REM Release support for build.bat / build_261.bat; not meant to be run on its own.
+REM
+REM   call build_libs.bat <profile>      profile: (empty) | pgo-gen | pgo-use
+REM
+REM Builds ImGui, MinHook and jni_core per profile as static libraries under
+REM obj\release[-<profile>] and leaves the matching flags for the bridge compile in
+REM LC_REL_CXXFLAGS / LC_REL_LDFLAGS / LC_REL_LIBS.  A library is rebuilt when one of
+REM its sources or headers, this script or (pgo-use) a profile is newer than the .a;
+REM tools\lib_stale.ps1 does the check.  Libraries are built with -flto too, so the
+REM link optimises across the bridge and ImGui.  Profiles are written to / read from
+REM pgo\.
+set "LC_GXX=C:\mingw64\mingw64\bin\g++.exe"
+set "LC_GCC=C:\mingw64\mingw64\bin\gcc.exe"
+set "LC_AR=C:\mingw64\mingw64\bin\gcc-ar.exe"
+set "LC_PGO_DIR=%~dp0pgo"
+set "LC_REL_PROFILE=%~1"
+set "LC_REL_DEPS="%~f0""
+
+set "LC_REL_CXXFLAGS=-O2 -flto -DNDEBUG"
+set "LC_REL_OBJ=obj\release"
+if /I "%LC_REL_PROFILE%"=="pgo-gen" (
+	set "LC_REL_CXXFLAGS=-O2 -flto -DNDEBUG -fprofile-generate -fprofile-update=atomic "-fprofile-dir=%LC_PGO_DIR%""
+	set "LC_REL_OBJ=obj\release-pgo-gen"
+)
+if /I "%LC_REL_PROFILE%"=="pgo-use" (
+	if not exist "%LC_PGO_DIR%\" (
+		echo No profile in %LC_PGO_DIR%. Run a "release pgo-gen" build through a session first.
+		exit /b 1
+	)
+	set "LC_REL_CXXFLAGS=-O2 -flto -DNDEBUG -fprofile-use -fprofile-correction -Wno-missing-profile "-fprofile-dir=%LC_PGO_DIR%""
+	set "LC_REL_OBJ=obj\release-pgo-use"
+	set "LC_REL_DEPS="%~f0" "%LC_PGO_DIR%""
+)
+set "LC_REL_LDFLAGS=%LC_REL_CXXFLAGS% -flto=auto"
+if /I "%LC_REL_PROFILE%"=="pgo-gen" set "LC_REL_LDFLAGS=%LC_REL_LDFLAGS% -lgcov"
+set "LC_REL_LIBS=%LC_REL_OBJ%\libjnicore.a %LC_REL_OBJ%\libimgui.a %LC_REL_OBJ%\libminhook.a"
+set "LC_INC=-I"C:/Program Files/Java/jdk-17/include" -I"C:/Program Files/Java/jdk-17/include/win32" -I"src/main/cpp" -I"src/main/cpp/imgui" -I"src/main/cpp/imgui/minhook_src" -I"src/main/cpp/imgui/minhook_src/include""
+
+if not exist "%LC_REL_OBJ%\" mkdir "%LC_REL_OBJ%"
+
+call :stale libimgui.a src\main\cpp\imgui\*.cpp src\main\cpp\imgui\*.h
+if errorlevel 1 goto have_imgui
+echo Building ImGui (%LC_REL_OBJ%)...
+for %%F in (imgui imgui_draw imgui_tables imgui_widgets imgui_impl_win32 imgui_impl_opengl3) do (
+	"%LC_GXX%" -m64 -std=c++11 %LC_REL_CXXFLAGS% -c src/main/cpp/imgui/%%F.cpp -o %LC_REL_OBJ%\%%F.o %LC_INC%
+	if errorlevel 1 exit /b 1
+)
+if exist "%LC_REL_OBJ%\libimgui.a" del "%LC_REL_OBJ%\libimgui.a"
+"%LC_AR%" rcs %LC_REL_OBJ%\libimgui.a %LC_REL_OBJ%\imgui.o %LC_REL_OBJ%\imgui_draw.o %LC_REL_OBJ%\imgui_tables.o %LC_REL_OBJ%\imgui_widgets.o %LC_REL_OBJ%\imgui_impl_win32.o %LC_REL_OBJ%\imgui_impl_opengl3.o
+if errorlevel 1 exit /b 1
+:have_imgui
+
+call :stale libminhook.a src\main\cpp\imgui\minhook_src
+if errorlevel 1 goto have_minhook
+echo Building MinHook (%LC_REL_OBJ%)...
+for %%F in (buffer hook trampoline) do (
+	"%LC_GCC%" -m64 %LC_REL_CXXFLAGS% -c src/main/cpp/imgui/minhook_src/%%F.c -o %LC_REL_OBJ%\mh_%%F.o %LC_INC%
+	if errorlevel 1 exit /b 1
+)
+"%LC_GCC%" -m64 %LC_REL_CXXFLAGS% -c src/main/cpp/imgui/minhook_src/hde/hde64.c -o %LC_REL_OBJ%\mh_hde64.o %LC_INC%
+if errorlevel 1 exit /b 1
+if exist "%LC_REL_OBJ%\libminhook.a" del "%LC_REL_OBJ%\libminhook.a"
+"%LC_AR%" rcs %LC_REL_OBJ%\libminhook.a %LC_REL_OBJ%\mh_buffer.o %LC_REL_OBJ%\mh_hook.o %LC_REL_OBJ%\mh_trampoline.o %LC_REL_OBJ%\mh_hde64.o
+if errorlevel 1 exit /b 1
+:have_minhook
+
+call :stale libjnicore.a src\main\cpp\jni_core src\main\cpp\*.h
+if errorlevel 1 goto have_jnicore
+echo Building jni_core (%LC_REL_OBJ%)...
+for %%F in (resolver jni_registry mapping_cache helper_bridge jni_accounting jni_replay member_index ref_ledger scan_engine) do (
+	"%LC_GXX%" -m64 -std=c++11 %LC_REL_CXXFLAGS% -c src/main/cpp/jni_core/%%F.cpp -o %LC_REL_OBJ%\jni_%%F.o %LC_INC%
+	if errorlevel 1 exit /b 1
+)
+if exist "%LC_REL_OBJ%\libjnicore.a" del "%LC_REL_OBJ%\libjnicore.a"
+"%LC_AR%" rcs %LC_REL_OBJ%\libjnicore.a %LC_REL_OBJ%\jni_resolver.o %LC_REL_OBJ%\jni_jni_registry.o %LC_REL_OBJ%\jni_mapping_cache.o %LC_REL_OBJ%\jni_helper_bridge.o %LC_REL_OBJ%\jni_jni_accounting.o %LC_REL_OBJ%\jni_jni_replay.o %LC_REL_OBJ%\jni_member_index.o %LC_REL_OBJ%\jni_ref_ledger.o %LC_REL_OBJ%\jni_scan_engine.o
+if errorlevel 1 exit /b 1
+:have_jnicore
+
+exit /b 0
+
+REM call :stale <lib> <source>...  errorlevel 0 when %LC_REL_OBJ%\<lib> must be rebuilt.
+:stale
+powershell -NoProfile -ExecutionPolicy Bypass -File "%~dp0tools\lib_stale.ps1" "%LC_REL_OBJ%\%~1" %LC_REL_DEPS% %2 %3
+exit /b %errorlevel%
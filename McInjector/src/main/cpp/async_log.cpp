@@ -0,0 +1,216 @@
+// async_log.cpp
+#include "async_log.h"
+#include <windows.h>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace AsyncLog {
+
+namespace {
+
+const LONG     kSlots     = 1024;               // power of two
+const size_t   kSlotText  = 500;                // bytes of text per line
+const DWORD    kFlushMs   = 100;                // flusher idle period
+const LONG     kWakeDepth = kSlots / 2;         // wake flusher early past this fill
+
+struct Slot {
+    volatile LONG  seq;
+    unsigned short len;
+    unsigned char  level;
+    char           text[kSlotText];
+};
+
+Slot          s_ring[kSlots];
+volatile LONG s_enqueuePos = 0;
+LONG          s_dequeuePos = 0;                 // flusher only
+volatile LONG s_dropped    = 0;                // since the last drain
+volatile LONG s_droppedAll = 0;                // since Start()
+volatile LONG s_minLevel   = LEVEL_DEBUG;
+volatile LONG s_running    = 0;
+
+HANDLE      s_file    = INVALID_HANDLE_VALUE;
+HANDLE      s_wake    = nullptr;
+HANDLE      s_thread  = nullptr;
+std::string s_path;
+
+LONG Load(volatile LONG& v) { return InterlockedCompareExchange(&v, 0, 0); }
+
+void InitRing() {
+    for (LONG i = 0; i < kSlots; i++) s_ring[i].seq = i;
+    s_enqueuePos = 0;
+    s_dequeuePos = 0;
+}
+
+void WriteSync(const std::string& line) {
+    if (s_path.empty()) return;
+    std::ofstream out(s_path.c_str(), std::ios_base::app);
+    out << line << "\n";
+}
+
+void WriteBatch(const std::string& batch) {
+    if (batch.empty() || s_file == INVALID_HANDLE_VALUE) return;
+    DWORD written = 0;
+    WriteFile(s_file, batch.data(), (DWORD)batch.size(), &written, nullptr);
+}
+
+// Move every published slot into `batch`.  Single consumer.
+void DrainInto(std::string& batch) {
+    for (;;) {
+        Slot& s = s_ring[(unsigned long)s_dequeuePos & (kSlots - 1)];
+        LONG seq = Load(s.seq);
+        if ((LONG)((unsigned long)seq - (unsigned long)(s_dequeuePos + 1)) != 0) break;
+        batch.append(s.text, s.len);
+        batch += '\n';
+        InterlockedExchange(&s.seq, s_dequeuePos + kSlots);
+        s_dequeuePos++;
+    }
+}
+
+void DrainOnce() {
+    std::string batch;
+    batch.reserve(8192);
+    DrainInto(batch);
+    LONG dropped = InterlockedExchange(&s_dropped, 0);
+    if (dropped > 0) batch += "[log] dropped " + std::to_string((long long)dropped) + " lines (ring full)\n";
+    WriteBatch(batch);
+}
+
+DWORD WINAPI FlusherThread(LPVOID) {
+    while (Load(s_running)) {
+        WaitForSingleObject(s_wake, kFlushMs);
+        DrainOnce();
+    }
+    return 0;
+}
+
+} // namespace
+
+bool Start(const std::string& path) {
+    if (Load(s_running)) return true;
+    s_path = path;
+    s_file = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                         nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (s_file == INVALID_HANDLE_VALUE) return false;
+
+    InitRing();
+    s_dropped = 0;
+    s_droppedAll = 0;
+    if (!s_wake) s_wake = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    InterlockedExchange(&s_running, 1);
+    s_thread = CreateThread(nullptr, 0, FlusherThread, nullptr, 0, nullptr);
+    if (!s_thread) {
+        InterlockedExchange(&s_running, 0);
+        CloseHandle(s_file);
+        s_file = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    return true;
+}
+
+void Stop() {
+    if (!InterlockedExchange(&s_running, 0)) return;
+    if (s_wake) SetEvent(s_wake);
+    if (s_thread) {
+        WaitForSingleObject(s_thread, 2000);
+        CloseHandle(s_thread);
+        s_thread = nullptr;
+    }
+    DrainOnce();
+    if (s_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(s_file);
+        s_file = INVALID_HANDLE_VALUE;
+    }
+}
+
+bool Flush() {
+    if (!Load(s_running)) return true;
+    LONG target = Load(s_enqueuePos);
+    DWORD start = GetTickCount();
+    while ((LONG)((unsigned long)target - (unsigned long)Load(*(volatile LONG*)&s_dequeuePos)) > 0) {
+        if (GetTickCount() - start > 500) return false;
+        SetEvent(s_wake);
+        Sleep(1);
+    }
+    return true;
+}
+
+bool Write(Level level, const std::string& line) {
+    if ((LONG)level < Load(s_minLevel)) return false;
+    if (!Load(s_running)) { WriteSync(line); return true; }
+
+    LONG pos = Load(s_enqueuePos);
+    Slot* slot = nullptr;
+    for (;;) {
+        Slot& s = s_ring[(unsigned long)pos & (kSlots - 1)];
+        LONG seq = Load(s.seq);
+        LONG dif = (LONG)((unsigned long)seq - (unsigned long)pos);
+        if (dif == 0) {
+            if (InterlockedCompareExchange(&s_enqueuePos, pos + 1, pos) == pos) { slot = &s; break; }
+            pos = Load(s_enqueuePos);
+        } else if (dif < 0) {
+            InterlockedIncrement(&s_dropped);
+            InterlockedIncrement(&s_droppedAll);
+            return false;
+        } else {
+            pos = Load(s_enqueuePos);
+        }
+    }
+
+    size_t n = line.size();
+    if (n > kSlotText) {
+        n = kSlotText;
+        std::memcpy(slot->text, line.data(), n - 3);
+        std::memcpy(slot->text + n - 3, "...", 3);
+    } else {
+        std::memcpy(slot->text, line.data(), n);
+    }
+    slot->len = (unsigned short)n;
+    slot->level = (unsigned char)level;
+    InterlockedExchange(&slot->seq, pos + 1); // publish (full barrier)
+
+    LONG depth = (LONG)((unsigned long)(pos + 1) - (unsigned long)Load(*(volatile LONG*)&s_dequeuePos));
+    if (level >= LEVEL_WARN || depth >= kWakeDepth) SetEvent(s_wake);
+    return true;
+}
+
+void SetMinLevel(Level level) { InterlockedExchange(&s_minLevel, (LONG)level); }
+Level MinLevel() { return (Level)Load(s_minLevel); }
+
+Level LevelFromText(const std::string& line) {
+    if (line.compare(0, 5, "ERROR") == 0) return LEVEL_ERROR;
+    if (line.compare(0, 4, "WARN") == 0) return LEVEL_WARN;
+    if (line.compare(0, 6, "TRACE|") == 0) return LEVEL_DEBUG;
+    return LEVEL_INFO;
+}
+
+Level ParseLevel(const char* text, Level fallback) {
+    if (!text || !text[0]) return fallback;
+    switch (std::tolower((unsigned char)text[0])) {
+        case 'd': return LEVEL_DEBUG;
+        case 'i': return LEVEL_INFO;
+        case 'w': return LEVEL_WARN;
+        case 'e': return LEVEL_ERROR;
+        default:  return fallback;
+    }
+}
+
+unsigned long Dropped() { return (unsigned long)Load(s_droppedAll); }
+
+bool Allow(RateGate& gate, unsigned long intervalMs, long* suppressed) {
+    LONG now = (LONG)GetTickCount();
+    LONG last = Load(gate.lastMs);
+    if (last != 0 && (unsigned long)(now - last) < intervalMs) {
+        InterlockedIncrement(&gate.suppressed);
+        return false;
+    }
+    if (InterlockedCompareExchange(&gate.lastMs, now ? now : 1, last) != last) {
+        InterlockedIncrement(&gate.suppressed);
+        return false;
+    }
+    LONG n = InterlockedExchange(&gate.suppressed, 0);
+    if (suppressed) *suppressed = n;
+    return true;
+}
+
+} // namespace AsyncLog
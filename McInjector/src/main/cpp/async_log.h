@@ -0,0 +1,72 @@
+#pragma once
+// async_log.h
+// Non-blocking file logger shared by both bridges.
+//
+// Producers copy each line into a fixed-size slot of a bounded lock-free MPSC
+// ring; a background flusher drains the ring into one open file handle in
+// batches.  A full ring drops the line and counts it instead of blocking, so
+// the scan, TCP and render threads never wait on disk I/O.
+//
+// Usage:
+//   AsyncLog::Start(logPath);                         // DllMain / early startup
+//   AsyncLog::Write(AsyncLog::LEVEL_INFO, line);      // from any thread
+//   static AsyncLog::RateGate s_gate;                 // per call site
+//   if (AsyncLog::Allow(s_gate, 5000)) Log("...");
+//   AsyncLog::Stop();                                 // before FreeLibrary
+//
+// After Stop(), Write() falls back to a synchronous append to the same file;
+// before the first Start() there is no path and lines are discarded.
+
+#include <string>
+
+namespace AsyncLog {
+
+enum Level {
+    LEVEL_DEBUG = 0,
+    LEVEL_INFO  = 1,
+    LEVEL_WARN  = 2,
+    LEVEL_ERROR = 3
+};
+
+// Open `path` for appending and start the flusher thread.
+bool Start(const std::string& path);
+
+// Drain everything queued, stop the flusher and close the file.  Waits on the
+// flusher thread, so from DllMain only call it at process exit (lpReserved
+// non-null), when that thread is already gone.
+void Stop();
+
+// Block until every line queued before the call has reached the file
+// (bounded wait; returns false on timeout).
+bool Flush();
+
+// Queue one line (a newline is appended).  Returns false if it was filtered
+// by level or dropped because the ring was full.
+bool Write(Level level, const std::string& line);
+
+// Lines below this level are discarded at the producer.  Default: LEVEL_DEBUG.
+void  SetMinLevel(Level level);
+Level MinLevel();
+
+// Level implied by the repo's message prefixes ("ERROR", "WARNING", "TRACE|").
+Level LevelFromText(const std::string& line);
+
+// Parse "debug" / "info" / "warn" / "error" (case-insensitive, first letter
+// suffices).  Returns `fallback` for anything else.
+Level ParseLevel(const char* text, Level fallback);
+
+// Lines dropped because the ring was full, since Start().
+unsigned long Dropped();
+
+// Per-call-site rate limiter.  Zero-initialised statics are ready to use.
+struct RateGate {
+    volatile long lastMs;
+    volatile long suppressed;
+};
+
+// True at most once per `intervalMs` for `gate`.  When it returns true and
+// `suppressed` is non-null, receives the number of calls swallowed since the
+// previous pass.
+bool Allow(RateGate& gate, unsigned long intervalMs, long* suppressed = nullptr);
+
+} // namespace AsyncLog
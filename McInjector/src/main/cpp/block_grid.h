@@ -0,0 +1,94 @@
+#pragma once
+// block_grid.h
+// Small occupancy grid around the player's feet for SpeedBridge edge probes.
+//
+// A probe through the world costs a BlockPos allocation and three to five JNI
+// calls, and the answer only changes when the game ticks or the player moves
+// into another block.  BlockGrid keeps kSpan x kHeight x kSpan cells (x, y, z)
+// centred on the feet block in x/z and reaching from the feet down two
+// blocks.  Cells start unknown and are filled by the first probe that needs
+// them; Refresh() drops them all when the stamp (game tick) changes or the
+// feet block moves, so at most one world read per cell per tick remains.
+// Filling lazily rather than all 75 cells per tick keeps the refresh cheaper
+// than the single probe per update it replaces.
+//
+// Single-threaded: owned by whichever thread runs SpeedBridge.
+
+namespace lc {
+
+class BlockGrid {
+public:
+    static const int kSpan   = 5;   // x and z, centred on the feet block
+    static const int kHeight = 3;   // feet block and the two below it
+
+    enum Cell { CELL_UNKNOWN = 0, CELL_EMPTY, CELL_SOLID };
+
+    BlockGrid() : _hits(0), _misses(0), _refreshes(0) { Invalidate(); }
+
+    // Drops every cell; the next Refresh() starts over.
+    void Invalidate()
+    {
+        _valid = false;
+        _stamp = 0;
+        _ox = _oy = _oz = 0;
+        Clear();
+    }
+
+    // Re-centres on the feet block.  Returns true when the cells were dropped.
+    bool Refresh(int feetX, int feetY, int feetZ, unsigned long long stamp)
+    {
+        if (_valid && stamp == _stamp && feetX == _ox && feetY == _oy && feetZ == _oz) return false;
+        _valid = true;
+        _stamp = stamp;
+        _ox = feetX;
+        _oy = feetY;
+        _oz = feetZ;
+        Clear();
+        _refreshes++;
+        return true;
+    }
+
+    // CELL_* for a block position; CELL_UNKNOWN outside the grid or not probed yet.
+    int Get(int bx, int by, int bz)
+    {
+        int i = Index(bx, by, bz);
+        if (i < 0 || _cells[i] == CELL_UNKNOWN) { _misses++; return CELL_UNKNOWN; }
+        _hits++;
+        return _cells[i];
+    }
+
+    // Records a probe result; ignored outside the grid.
+    void Put(int bx, int by, int bz, bool solid)
+    {
+        int i = Index(bx, by, bz);
+        if (i >= 0) _cells[i] = (unsigned char)(solid ? CELL_SOLID : CELL_EMPTY);
+    }
+
+    unsigned long Hits() const      { return _hits; }
+    unsigned long Misses() const    { return _misses; }
+    unsigned long Refreshes() const { return _refreshes; }
+
+private:
+    int Index(int bx, int by, int bz) const
+    {
+        if (!_valid) return -1;
+        int x = bx - _ox + kSpan / 2;
+        int y = _oy - by;                  // 0 = feet, 1 and 2 below
+        int z = bz - _oz + kSpan / 2;
+        if (x < 0 || x >= kSpan || y < 0 || y >= kHeight || z < 0 || z >= kSpan) return -1;
+        return (y * kSpan + z) * kSpan + x;
+    }
+
+    void Clear()
+    {
+        for (int i = 0; i < kSpan * kHeight * kSpan; i++) _cells[i] = CELL_UNKNOWN;
+    }
+
+    bool               _valid;
+    unsigned long long _stamp;
+    int                _ox, _oy, _oz;
+    unsigned char      _cells[kSpan * kHeight * kSpan];
+    unsigned long      _hits, _misses, _refreshes;
+};
+
+} // namespace lc
@@ -21,10 +21,30 @@
 #include "imgui_impl_opengl3.h"
 #include "json_config_reader.h"
 #include "bridge_capabilities.h"
+#include "bridge_endpoint.h"
 #include "jni_core/scoped_env.h"
 #include "jni_core/local_frame.h"
 #include "jni_core/matrix_reader.h"
 #include "jni_core/helper_bridge.h"
+#include "jni_core/jni_accounting.h"
+#include "jni_core/mapping_cache.h"
+#include "jni_core/class_scan.h"
+#include "jni_core/scan_engine.h"
+#include "async_log.h"
+#include "thread_policy.h"
+#include "block_grid.h"
+#include "frame_profiler.h"
+#include "debug_panel.h"
+#include "overlay_context.h"
+#include "hud_cache.h"
+#include "overlay_font.h"
+#include "text_utils.h"
+#include "sync.h"
+#include "telemetry.h"
+#include "trace_buffer.h"
+#include "entity_interp.h"
+#include "frustum.h"
+#include "snapshot_cell.h"
 
 // MinGW's <GL/gl.h> may not declare modern GL enums used while preserving
 // Minecraft's render state around ImGui backend initialization.
@@ -61,41 +81,18 @@
 
 // Custom extension in our vendored imgui_impl_opengl3.cpp.
 void ImGui_ImplOpenGL3_SetSkipGLDeletes(bool skip);
-// Custom Mutex for MinGW win32 threads
-class Mutex {
-    CRITICAL_SECTION cs;
-public:
-    Mutex() { InitializeCriticalSection(&cs); }
-    ~Mutex() { DeleteCriticalSection(&cs); }
-    void lock() { EnterCriticalSection(&cs); }
-    bool try_lock() { return TryEnterCriticalSection(&cs) != 0; }
-    void unlock() { LeaveCriticalSection(&cs); }
-};
-
-class LockGuard {
-    Mutex& m;
-public:
-    LockGuard(Mutex& m) : m(m) { m.lock(); }
-    ~LockGuard() { m.unlock(); }
-};
-
-class TryLockGuard {
-    Mutex& m;
-    bool owns;
-public:
-    TryLockGuard(Mutex& m) : m(m), owns(m.try_lock()) {}
-    ~TryLockGuard() { if (owns) m.unlock(); }
-    bool owns_lock() const { return owns; }
-};
+void ImGui_ImplOpenGL3_SetPhaseCallback(void (*callback)(int mark));
+void ImGui_ImplOpenGL3_SetSkipStateBackup(bool skip);
 
 // ===================== GLOBALS =====================
 JavaVM* g_jvm = nullptr;
 bool g_running = true;
 // Per-subsystem JNI locks (finer-grained than the old single JNI lock).
-// Render thread (SwapBuffers) holds g_renderJniMutex; LegoBridge thread holds
+// The scan thread holds g_scanJniMutex; LegoBridge thread holds
 // g_stateJniMutex.  Reach state is shared by the LegoBridge thread and WndProc,
-// so both reach paths serialize on g_stateJniMutex.
-static Mutex g_renderJniMutex;  // nametags / chest ESP / closest-player (render thread)
+// so both reach paths serialize on g_stateJniMutex.  The render thread makes
+// no JNI calls for the world overlays (see RENDER SNAPSHOTS).
+static Mutex g_scanJniMutex;    // nametags / chest ESP / closest-player (scan thread)
 static Mutex g_stateJniMutex;   // ReadGameState / reach / velocity (LegoBridge thread)
 SOCKET g_serverSocket = INVALID_SOCKET;
 SOCKET g_clientSocket = INVALID_SOCKET;
@@ -111,6 +108,9 @@ static int g_imguiWarmupFrames = 0;
 static HGLRC g_imguiGlrc = nullptr;
 static bool g_imguiPendingBackendReset = false;
 static HGLRC g_imguiPendingGlrc = nullptr;
+static bool g_overlayContextFailed = false;   // shared overlay context (overlay_context.h) unusable this session
+static HudCache::Layer g_moduleListLayer;     // module list + logo geometry, see ModuleListKey()
+static HudCache::FramePacer g_overlayPacer;   // redraws the previous ImDrawData between rebuilds (overlayUpdateHz)
 static bool g_minhookInitialized = false;
 static HWND g_imguiHwnd = nullptr;
 static bool g_guiOpen = false;
@@ -155,6 +155,7 @@ struct Config {
     bool showModuleList = true;
     int moduleListStyle = 0;
     bool showLogo = true;
+    int overlayUpdateHz = 0;   // overlay rebuilds per second, 0 = every frame
     std::string guiTheme = "Default";
     float minCPS = 10, maxCPS = 14;
     float rightMinCPS = 10, rightMaxCPS = 14;
@@ -364,6 +365,7 @@ static double g_speedBridgeLastPosX = 0.0;
 static double g_speedBridgeLastPosZ = 0.0;
 static int g_speedBridgeDirX = 0;
 static int g_speedBridgeDirZ = 0;
+static lc::BlockGrid g_speedBridgeGrid;   // main loop; stamped every 50 ms (one game tick)
 // NOTE: g_getItemMethod, g_getDisplayNameMethod, g_getUnlocalizedNameMethod,
 // g_getDamageVsEntityMethod are intentionally NOT cached globally — they must
 // be fetched from the actual object's class each call to avoid calling a
@@ -393,10 +395,10 @@ struct TagSmoothingState {
     float y = 0.0f;
     float vx = 0.0f;
     float vy = 0.0f;
-    int lastFrame = 0;
     bool init = false;
 };
-static std::unordered_map<int, TagSmoothingState> g_tagSmoothing;
+// Keyed by the nametag key below (entity hash), stamped with g_tagFrameCounter.
+static lc::SlotTable<TagSmoothingState, 256> g_tagSmoothing;
 static int g_tagFrameCounter = 0;
 
 // Commands to send to C#
@@ -411,6 +413,8 @@ static bool g_traceEnabled = false;
 // Forward declarations for player-name filtering helpers used by reach/telemetry paths.
 static bool LooksLikeFakePlayerLine(const std::string& rawName);
 static std::string GetStablePlayerName(JNIEnv* env, jobject playerObj);
+static std::string GetCachedPlayerName(JNIEnv* env, jobject playerObj);
+static void ResetPlayerNameCache(JNIEnv* env);
 
 // ===================== LOGGING =====================
 void InitLogPath(HMODULE hModule) {
@@ -433,32 +437,40 @@ void InitLogPath(HMODULE hModule) {
             || traceEnv[0] == 'y' || traceEnv[0] == 'Y'
             || traceEnv[0] == 't' || traceEnv[0] == 'T');
     }
+#if LC_TRACE_BUILD
+    TraceBuffer::SetEnabled(g_traceEnabled);
+#endif
+
+    char levelEnv[16] = {};
+    if (GetEnvironmentVariableA("LC_BRIDGE_LOG_LEVEL", levelEnv, sizeof(levelEnv)) > 0) {
+        AsyncLog::SetMinLevel(AsyncLog::ParseLevel(levelEnv, AsyncLog::LEVEL_DEBUG));
+    }
 }
 
+// Queued to the async logger; the flusher thread owns the file handle.
 void Log(const std::string& msg) {
-    std::ofstream f(g_logPath.c_str(), std::ios_base::app);
-    f << "[Bridge] " << msg << std::endl;
+    AsyncLog::Write(AsyncLog::LevelFromText(msg), "[Bridge] " + msg);
 }
 
+// Tracing exists only in trace builds (see trace_buffer.h).  Paths and
+// branches go to the binary per-thread rings; VALUE carries strings and only
+// appears on discovery paths, so it stays a text log line.
+#if LC_TRACE_BUILD
 static void TraceValue(const char* fn, const char* key, const std::string& value) {
     if (!g_traceEnabled) return;
     Log(std::string("TRACE|") + (fn ? fn : "?") + "|" + (key ? key : "?") + "|" + value);
 }
 
-static void TraceBranch(const char* fn, const char* branch, bool taken) {
-    if (!g_traceEnabled) return;
-    Log(std::string("TRACE|") + (fn ? fn : "?") + "|" + (branch ? branch : "?") + "|" + (taken ? "1" : "0"));
-}
-
-static bool TraceDecision(const char* fn, const char* branch, bool decision) {
-    TraceBranch(fn, branch, decision);
-    return decision;
-}
-
-#define TRACE_PATH(pathValue) TraceValue(__FUNCTION__, "path", (pathValue))
+#define TRACE_PATH(pathValue) LC_TRACE_EVENT('P', (pathValue), 0)
 #define TRACE_VALUE(key, value) TraceValue(__FUNCTION__, (key), (value))
-#define TRACE_BRANCH(branch, taken) TraceBranch(__FUNCTION__, (branch), (taken))
-#define TRACE_IF(branch, expr) TraceDecision(__FUNCTION__, (branch), (expr))
+#define TRACE_BRANCH(branch, taken) LC_TRACE_EVENT('B', (branch), (taken) ? 1 : 0)
+#define TRACE_IF(branch, expr) LC_TRACE_DECISION((branch), (expr))
+#else
+#define TRACE_PATH(pathValue) ((void)0)
+#define TRACE_VALUE(key, value) ((void)0)
+#define TRACE_BRANCH(branch, taken) ((void)0)
+#define TRACE_IF(branch, expr) (expr)
+#endif
 
 static std::string GetBridgeDir() {
     size_t sep = g_logPath.find_last_of("\\/");
@@ -608,6 +620,14 @@ jclass LoadClassWithLoader(JNIEnv* env, jobject cl, const char* name) {
 }
 
 // ===================== CLASS DISCOVERY =====================
+static void LogClassScan(const char* what, int hit, const ClassScan::Stats& st) {
+    char buf[192];
+    snprintf(buf, sizeof(buf), "Class scan %s: %s, %d loaded, %d candidates, %d reflected on %d thread(s), %lu ms",
+             what, hit >= 0 ? "hit" : "miss", (int)st.loaded, (int)st.candidates, (int)st.reflected,
+             st.threads, (unsigned long)st.ms);
+    Log(buf);
+}
+
 bool DiscoverMappings(JNIEnv* env) {
     TRACE_PATH("enter");
     Log("Starting dynamic class discovery...");
@@ -644,6 +664,12 @@ bool DiscoverMappings(JNIEnv* env) {
     jclass cMod = env->FindClass("java/lang/reflect/Modifier");
     jmethodID mIsStatic = env->GetStaticMethodID(cMod, "isStatic", "(I)Z");
 
+    // Fallback scans below share one filtered candidate set and run in parallel;
+    // their predicates test modifiers with kAccStatic instead of Modifier.isStatic
+    // (cMod is a local ref of this thread).
+    ClassScan::Candidates scanSet(env, jvmti, classes, classCount);
+    ClassScan::Stats scanStats = {};
+
     // Try known names first
     jclass mcClass = nullptr;
     std::string mcName;
@@ -658,50 +684,51 @@ bool DiscoverMappings(JNIEnv* env) {
     TRACE_BRANCH("needSingletonScanForMcClass", mcClass == nullptr);
     if (!mcClass) {
         TRACE_PATH("scan-for-mc-singleton");
-        for (int i = 0; i < classCount; i++) {
-            jclass cls = classes[i];
-            if (env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-            jstring jn = (jstring)env->CallObjectMethod(cls, mGetName);
-            if (!jn || env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-            const char* cn = env->GetStringUTFChars(jn, nullptr);
-            std::string name = cn; env->ReleaseStringUTFChars(jn, cn);
-            if (name.find("java.") == 0 || name.find("sun.") == 0 || name.find("javax.") == 0 ||
-                name.find("com.sun.") == 0 || name.find("org.") == 0 || name.find("jdk.") == 0 ||
-                name.find("com.google.") == 0 || name.find("io.") == 0 || name[0] == '[') continue;
-
-            jobjectArray fields = (jobjectArray)env->CallObjectMethod(cls, mGetFields);
-            if (!fields || env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-            jsize fc = env->GetArrayLength(fields);
+        // A static field of the class's own type plus more than 15 instance fields.
+        int hit = ClassScan::FindFirst(g_jvm, scanSet, [&](JNIEnv* e, jclass cls) -> bool {
+            jobjectArray fields = (jobjectArray)e->CallObjectMethod(cls, mGetFields);
+            if (!fields || e->ExceptionCheck()) { e->ExceptionClear(); return false; }
+            jsize fc = e->GetArrayLength(fields);
             bool hasSelf = false; int objCount = 0;
             for (int f = 0; f < fc; f++) {
-                jobject fld = env->GetObjectArrayElement(fields, f);
+                jobject fld = e->GetObjectArrayElement(fields, f);
                 if (!fld) continue;
-                jint mod = env->CallIntMethod(fld, mFMod);
-                bool isS = env->CallStaticBooleanMethod(cMod, mIsStatic, mod);
-                jclass ft = (jclass)env->CallObjectMethod(fld, mFType);
-                if (!ft || env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-                std::string tn = GetClassNameFromClass(env, ft);
-                if (isS && tn == name) hasSelf = true;
-                if (!isS) objCount++;
-            }
-            if (hasSelf && objCount > 15) {
-                mcClass = (jclass)env->NewGlobalRef(cls);
-                mcName = name;
-                TRACE_VALUE("mcClassSource", "singleton-scan");
-                Log("Found MC class: " + name + " fields=" + std::to_string(objCount));
-                break;
+                jint mod = e->CallIntMethod(fld, mFMod);
+                if (e->ExceptionCheck()) { e->ExceptionClear(); e->DeleteLocalRef(fld); continue; }
+                if (!(mod & ClassScan::kAccStatic)) objCount++;
+                else if (!hasSelf) {
+                    jclass ft = (jclass)e->CallObjectMethod(fld, mFType);
+                    if (e->ExceptionCheck()) e->ExceptionClear();
+                    else if (ft && e->IsSameObject(ft, cls)) hasSelf = true;
+                    if (ft) e->DeleteLocalRef(ft);
+                }
+                e->DeleteLocalRef(fld);
             }
+            return hasSelf && objCount > 15;
+        }, &scanStats);
+        LogClassScan("mc-singleton", hit, scanStats);
+        if (hit >= 0) {
+            mcClass = (jclass)env->NewGlobalRef(scanSet[hit]);
+            mcName = GetClassNameFromClass(env, mcClass);
+            TRACE_VALUE("mcClassSource", "singleton-scan");
+            Log("Found MC class: " + mcName);
         }
     }
     if (!mcClass) { Log("ERROR: MC class not found"); jvmti->Deallocate((unsigned char*)classes); return false; }
 
+    // Names found by the reflection scans below are cached per game build; a hit
+    // costs one GetFieldID instead of a hierarchy walk.
+    int cachedEntries = MappingCache::Open(GetBridgeDir() + "\\bridge_mappings.cache",
+                                           MappingCache::BuildKey(env, "legacy", mcClass, mcName));
+    Log("Mapping cache: " + std::to_string(cachedEntries) + " entries");
+
     // Find singleton field
     jobjectArray mcFields = (jobjectArray)env->CallObjectMethod(mcClass, mGetFields);
     jsize mcFC = env->GetArrayLength(mcFields);
-    jfieldID singletonField = nullptr;
+    jfieldID singletonField = MappingCache::GetField(env, mcClass, "mc.singleton", true);
     std::string playerType;
 
-    for (int f = 0; f < mcFC; f++) {
+    for (int f = 0; f < mcFC && !singletonField; f++) {
         jobject fld = env->GetObjectArrayElement(mcFields, f);
         if (!fld) continue;
         jint mod = env->CallIntMethod(fld, mFMod);
@@ -717,6 +744,7 @@ bool DiscoverMappings(JNIEnv* env) {
             std::string sig = "L" + mcName + ";"; std::replace(sig.begin(), sig.end(), '.', '/');
             singletonField = env->GetStaticFieldID(mcClass, fn.c_str(), sig.c_str());
             if (env->ExceptionCheck()) env->ExceptionClear();
+            if (singletonField) MappingCache::PutMember("mc.singleton", fn, sig);
             Log("Singleton: " + fn);
         }
     }
@@ -728,8 +756,14 @@ bool DiscoverMappings(JNIEnv* env) {
     if (!mcInst) { Log("ERROR: MC null"); jvmti->Deallocate((unsigned char*)classes); return false; }
     Log("Got MC instance");
 
+    if (!g_thePlayerField) {
+        g_thePlayerField = MappingCache::GetField(env, mcClass, "mc.player");
+        if (g_thePlayerField && !MappingCache::Get("mc.playerType", playerType)) g_thePlayerField = nullptr;
+    }
+    if (!g_currentScreenField) g_currentScreenField = MappingCache::GetField(env, mcClass, "mc.screen");
+
     // Find player & screen fields
-    for (int f = 0; f < mcFC; f++) {
+    for (int f = 0; f < mcFC && (!g_thePlayerField || !g_currentScreenField); f++) {
         jobject fld = env->GetObjectArrayElement(mcFields, f);
         if (!fld) continue;
         jint mod = env->CallIntMethod(fld, mFMod);
@@ -769,12 +803,17 @@ bool DiscoverMappings(JNIEnv* env) {
             g_thePlayerField = env->GetFieldID(mcClass, fn.c_str(), sig.c_str());
             if (env->ExceptionCheck()) env->ExceptionClear();
             playerType = tn;
+            if (g_thePlayerField) {
+                MappingCache::PutMember("mc.player", fn, sig);
+                MappingCache::Put("mc.playerType", tn);
+            }
             Log("Player field: " + fn + " type=" + tn);
         }
         if (isScreen && !g_currentScreenField) {
             std::string sig = "L" + tn + ";"; std::replace(sig.begin(), sig.end(), '.', '/');
             g_currentScreenField = env->GetFieldID(mcClass, fn.c_str(), sig.c_str());
             if (env->ExceptionCheck()) env->ExceptionClear();
+            if (g_currentScreenField) MappingCache::PutMember("mc.screen", fn, sig);
             Log("Screen field: " + fn + " type=" + tn);
         }
     }
@@ -944,17 +983,26 @@ bool DiscoverMappings(JNIEnv* env) {
     
     // Nametags Discovery
     if (g_mcClass) {
+         if (!g_theWorldField) g_theWorldField = MappingCache::GetField(env, g_mcClass, "mc.world");
          // Find theWorld
-         jobjectArray fs = (jobjectArray)env->CallObjectMethod(g_mcClass, mGetFields);
+         jobjectArray fs = g_theWorldField ? nullptr : (jobjectArray)env->CallObjectMethod(g_mcClass, mGetFields);
          // Simplified search for WorldClient field
          jint worldCount = 0;
-         jsize fc = env->GetArrayLength(fs);
+         jsize fc = fs ? env->GetArrayLength(fs) : 0;
          for(int i=0; i<fc; i++) {
              jobject f = env->GetObjectArrayElement(fs, i);
              if(!f) continue;
              jclass ft = (jclass)env->CallObjectMethod(f, mFType);
-             if (ft && GetClassNameFromClass(env, ft).find("WorldClient") != std::string::npos) {
+             std::string ftn = ft ? GetClassNameFromClass(env, ft) : "";
+             if (ftn.find("WorldClient") != std::string::npos) {
                   g_theWorldField = env->FromReflectedField(f);
+                  jstring jfn = (jstring)env->CallObjectMethod(f, mFName);
+                  const char* cfn = jfn ? env->GetStringUTFChars(jfn, nullptr) : nullptr;
+                  if (cfn) {
+                      std::string sig = "L" + ftn + ";"; std::replace(sig.begin(), sig.end(), '.', '/');
+                      MappingCache::PutMember("mc.world", cfn, sig);
+                      env->ReleaseStringUTFChars(jfn, cfn);
+                  }
                   Log("Found theWorld field");
                   break;
              }
@@ -1232,6 +1280,12 @@ bool DiscoverMappings(JNIEnv* env) {
         jclass ibClass = LoadClassWithLoader(env, gcl, "net.minecraft.item.ItemBlock");
         if (!ibClass) ibClass = env->FindClass("net/minecraft/item/ItemBlock");
         
+        std::string cachedIbName;
+        if (!ibClass && MappingCache::Get("item.blockClass", cachedIbName)) {
+             ibClass = LoadClassWithLoader(env, gcl, cachedIbName.c_str());
+             if (!ibClass) MappingCache::Invalidate("item.blockClass");
+        }
+
         // Robust Scan: Find class extending Item that has a field of type Block
         if (!ibClass) {
              Log("ItemBlock not found by name, scanning...");
@@ -1242,31 +1296,36 @@ bool DiscoverMappings(JNIEnv* env) {
              if (!blockCls) blockCls = env->FindClass("net/minecraft/block/Block");
 
              if (itemCls && blockCls) {
-                 for (int i = 0; i < classCount; i++) {
-                     jclass cls = classes[i];
-                     if (env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-                     
-                     // Check superclass
-                     jclass super = (jclass)env->CallObjectMethod(cls, mGetSuper);
-                     if (!super || !env->IsSameObject(super, itemCls)) continue;
+                 jclass itemG = (jclass)env->NewGlobalRef(itemCls);
+                 jclass blockG = (jclass)env->NewGlobalRef(blockCls);
+                 int hit = ClassScan::FindFirst(g_jvm, scanSet, [&](JNIEnv* e, jclass cls) -> bool {
+                     // Superclass first: plain JNI, no reflection for the misses
+                     jclass super = e->GetSuperclass(cls);
+                     if (!super || !e->IsSameObject(super, itemG)) return false;
 
                      // Check fields for one of type Block
-                     jobjectArray fs = (jobjectArray)env->CallObjectMethod(cls, mGetFields);
-                     bool hasBlock = false;
-                     jsize fc = fs ? env->GetArrayLength(fs) : 0;
-                     for(int f=0; f<fc; f++) {
-                          jobject fld = env->GetObjectArrayElement(fs, f);
-                          jclass ft = (jclass)env->CallObjectMethod(fld, mFType);
-                          if (ft && env->IsSameObject(ft, blockCls)) {
-                              hasBlock = true;
-                              break;
-                          }
-                     }
-                     if (hasBlock) {
-                         ibClass = cls;
-                         Log("Found ItemBlock candidate by signature");
-                         break;
+                     jobjectArray fs = (jobjectArray)e->CallObjectMethod(cls, mGetFields);
+                     if (e->ExceptionCheck()) { e->ExceptionClear(); return false; }
+                     jsize fc = fs ? e->GetArrayLength(fs) : 0;
+                     for (int f = 0; f < fc; f++) {
+                          jobject fld = e->GetObjectArrayElement(fs, f);
+                          if (!fld) continue;
+                          jclass ft = (jclass)e->CallObjectMethod(fld, mFType);
+                          if (e->ExceptionCheck()) { e->ExceptionClear(); ft = nullptr; }
+                          const bool isBlock = ft && e->IsSameObject(ft, blockG);
+                          if (ft) e->DeleteLocalRef(ft);
+                          e->DeleteLocalRef(fld);
+                          if (isBlock) return true;
                      }
+                     return false;
+                 }, &scanStats);
+                 env->DeleteGlobalRef(itemG);
+                 env->DeleteGlobalRef(blockG);
+                 LogClassScan("item-block", hit, scanStats);
+                 if (hit >= 0) {
+                     ibClass = scanSet[hit];
+                     MappingCache::Put("item.blockClass", GetClassNameFromClass(env, ibClass));
+                     Log("Found ItemBlock candidate by signature");
                  }
              }
         }
@@ -1463,38 +1522,47 @@ bool DiscoverMappings(JNIEnv* env) {
         env->ExceptionClear();
         Log("ActiveRenderInfo not found by name, scanning classes...");
         TRACE_PATH("scan-for-active-render-info");
-        for (int i = 0; i < classCount; i++) {
-            jclass cls = classes[i];
-            if (env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-            
-            // Check static fields signature: 3 FloatBuffers, 1 IntBuffer
-            jobjectArray fs = (jobjectArray)env->CallObjectMethod(cls, mGetFields);
-            if (!fs || env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-            
-            int fbCount = 0;
-            int ibCount = 0;
-            jsize fc = env->GetArrayLength(fs);
-            for (int f = 0; f < fc; f++) {
-                 jobject fld = env->GetObjectArrayElement(fs, f);
-                 if (!fld) continue;
-                 jint mod = env->CallIntMethod(fld, mFMod);
-                 if (!env->CallStaticBooleanMethod(cMod, mIsStatic, mod)) continue; // Must be static
-                 
-                 jclass ft = (jclass)env->CallObjectMethod(fld, mFType);
-                 if (!ft) continue;
-                 std::string ftn = GetClassNameFromClass(env, ft);
-                 if (ftn == "java.nio.FloatBuffer") fbCount++;
-                 else if (ftn == "java.nio.IntBuffer") ibCount++;
-            }
-            
-            if (fbCount >= 2 && ibCount >= 1) { // At least 2 FB (ModelView, Projection) and 1 IB (Viewport)
-                 jstring jn = (jstring)env->CallObjectMethod(cls, mGetName);
-                 const char* cn = env->GetStringUTFChars(jn, nullptr);
-                 Log("Found ActiveRenderInfo candidate: " + std::string(cn));
-                 g_activeRenderInfoClass = (jclass)env->NewGlobalRef(cls);
-                 env->ReleaseStringUTFChars(jn, cn);
-                 break;
-            }
+        jclass fbLocal = env->FindClass("java/nio/FloatBuffer");
+        jclass ibLocal = env->FindClass("java/nio/IntBuffer");
+        if (env->ExceptionCheck()) env->ExceptionClear();
+        jclass fbG = fbLocal ? (jclass)env->NewGlobalRef(fbLocal) : nullptr;
+        jclass ibG = ibLocal ? (jclass)env->NewGlobalRef(ibLocal) : nullptr;
+        int hit = -1;
+        if (fbG && ibG) {
+            hit = ClassScan::FindFirst(g_jvm, scanSet, [&](JNIEnv* e, jclass cls) -> bool {
+                // Check static fields signature: 3 FloatBuffers, 1 IntBuffer
+                jobjectArray fs = (jobjectArray)e->CallObjectMethod(cls, mGetFields);
+                if (!fs || e->ExceptionCheck()) { e->ExceptionClear(); return false; }
+
+                int fbCount = 0;
+                int ibCount = 0;
+                jsize fc = e->GetArrayLength(fs);
+                for (int f = 0; f < fc; f++) {
+                     jobject fld = e->GetObjectArrayElement(fs, f);
+                     if (!fld) continue;
+                     jint mod = e->CallIntMethod(fld, mFMod);
+                     jclass ft = nullptr;
+                     if (e->ExceptionCheck()) e->ExceptionClear();
+                     else if (mod & ClassScan::kAccStatic) ft = (jclass)e->CallObjectMethod(fld, mFType); // Must be static
+                     if (e->ExceptionCheck()) { e->ExceptionClear(); ft = nullptr; }
+                     if (ft) {
+                          if (e->IsSameObject(ft, fbG)) fbCount++;
+                          else if (e->IsSameObject(ft, ibG)) ibCount++;
+                          e->DeleteLocalRef(ft);
+                     }
+                     e->DeleteLocalRef(fld);
+                }
+                return fbCount >= 2 && ibCount >= 1; // At least 2 FB (ModelView, Projection) and 1 IB (Viewport)
+            }, &scanStats);
+            LogClassScan("active-render-info", hit, scanStats);
+        }
+        if (fbG) env->DeleteGlobalRef(fbG);
+        if (ibG) env->DeleteGlobalRef(ibG);
+        if (fbLocal) env->DeleteLocalRef(fbLocal);
+        if (ibLocal) env->DeleteLocalRef(ibLocal);
+        if (hit >= 0) {
+            g_activeRenderInfoClass = (jclass)env->NewGlobalRef(scanSet[hit]);
+            Log("Found ActiveRenderInfo candidate: " + GetClassNameFromClass(env, g_activeRenderInfoClass));
         }
     } else {
         g_activeRenderInfoClass = (jclass)env->NewGlobalRef(g_activeRenderInfoClass);
@@ -1609,7 +1677,10 @@ bool DiscoverMappings(JNIEnv* env) {
     Log("Name: " + std::string(g_getNameMethod ? "YES" : "NO"));
     Log("Inventory: " + std::string(g_inventoryField ? "YES" : "NO"));
     Log("ItemBlock: " + std::string(g_itemBlockClass ? "YES" : "NO"));
+    Log("Mapping cache: " + std::to_string(MappingCache::Hits()) + " hits, "
+        + std::to_string(MappingCache::Misses()) + " misses");
     Log("=== End Report ===");
+    if (g_mapped && !MappingCache::Save()) Log("WARNING: Could not write mapping cache");
     jvmti->Deallocate((unsigned char*)classes);
     return g_mapped;
 }
@@ -2452,6 +2523,7 @@ static void TrackLegacySuppressionWorldContext(JNIEnv* env, jobject worldObj) {
             g_lastLegacyNametagSuppressionWorld = nullptr;
         }
         g_lastLegacyNametagSuppressionWorld = env->NewGlobalRef(worldObj);
+        ResetPlayerNameCache(env);
         if (g_legacyNametagSuppressionActive || !g_hiddenNametagOriginalTeamByPlayerLegacy.empty()) {
             g_hiddenNametagOriginalTeamByPlayerLegacy.clear();
             g_legacyNametagSuppressionActive = false;
@@ -3280,7 +3352,7 @@ static void UpdateReach(JNIEnv* env, const Config& cfg, const GameState& state,
             continue;
         }
 
-        std::string stableName = GetStablePlayerName(env, entity);
+        std::string stableName = GetCachedPlayerName(env, entity);
         if (stableName.empty()) {
             env->DeleteLocalRef(entity);
             continue;
@@ -3554,6 +3626,7 @@ static void ResetSpeedBridgeMovementTracking() {
     g_speedBridgeHaveLastPos = false;
     g_speedBridgeDirX = 0;
     g_speedBridgeDirZ = 0;
+    g_speedBridgeGrid.Invalidate();
 }
 
 static void UpdateSpeedBridgeDirection(const GameState& state) {
@@ -3712,13 +3785,29 @@ static bool IsSolidBlockAt(JNIEnv* env, double x, double y, double z) {
     return solid;
 }
 
+// IsSolidBlockAt answered from g_speedBridgeGrid when the cell was already
+// probed this tick.  The main loop runs SpeedBridge far more often than the
+// game ticks, so most probes are hits.  Failed probes are not cached.
+static bool IsSolidBlockCached(JNIEnv* env, double x, double y, double z) {
+    int bx = (int)std::floor(x);
+    int by = (int)std::floor(y);
+    int bz = (int)std::floor(z);
+    int cell = g_speedBridgeGrid.Get(bx, by, bz);
+    if (cell != lc::BlockGrid::CELL_UNKNOWN) return cell == lc::BlockGrid::CELL_SOLID;
+
+    bool solid = IsSolidBlockAt(env, x, y, z);
+    if (g_worldGetBlockStateMethod && g_materialIsSolidMethod)
+        g_speedBridgeGrid.Put(bx, by, bz, solid);
+    return solid;
+}
+
 static bool IsSpeedBridgeEdgeUnsupported(JNIEnv* env, const Config& cfg, const GameState& state) {
     if (g_speedBridgeDirX == 0 && g_speedBridgeDirZ == 0) return false;
     double probe = SpeedBridgeSupportProbeDistance(cfg);
     double sx = state.posX + (double)g_speedBridgeDirX * probe;
     double sz = state.posZ + (double)g_speedBridgeDirZ * probe;
     double sy = state.posY - 0.05;
-    return !IsSolidBlockAt(env, sx, sy, sz);
+    return !IsSolidBlockCached(env, sx, sy, sz);
 }
 
 static void UpdateSpeedBridge(JNIEnv* env, const Config& cfg, const GameState& state) {
@@ -3740,6 +3829,8 @@ static void UpdateSpeedBridge(JNIEnv* env, const Config& cfg, const GameState& s
     }
 
     UpdateSpeedBridgeDirection(state);
+    g_speedBridgeGrid.Refresh((int)std::floor(state.posX), (int)std::floor(state.posY), (int)std::floor(state.posZ),
+                              (unsigned long long)GetTickCount64() / 50);
     bool shouldSneak = IsSpeedBridgeEdgeUnsupported(env, cfg, state);
     SetSpeedBridgeSneak(env, shouldSneak);
 }
@@ -4027,6 +4118,10 @@ static void CleanupImGuiAndHooks() {
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplOpenGL3_SetSkipGLDeletes(false);
     }
+    OverlayContext::Destroy();
+    ImGui_ImplOpenGL3_SetSkipStateBackup(false);
+    g_moduleListLayer.Invalidate();
+    g_overlayPacer.Invalidate();
     if (ImGui::GetCurrentContext()) {
         ImGui::DestroyContext();
     }
@@ -4066,6 +4161,10 @@ static void ResetImGuiBackendsForReinit(const char* reason) {
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplOpenGL3_SetSkipGLDeletes(false);
     }
+    OverlayContext::Destroy();
+    ImGui_ImplOpenGL3_SetSkipStateBackup(false);
+    g_moduleListLayer.Invalidate();
+    g_overlayPacer.Invalidate();
     if (ImGui::GetCurrentContext()) {
         ImGui::DestroyContext();
     }
@@ -4104,6 +4203,12 @@ extern "C" __declspec(dllexport) void Detach() {
     // Create a thread to free library safely
     CreateThread(nullptr, 0, [](LPVOID) -> DWORD {
         Sleep(100);
+#if LC_TRACE_BUILD
+        TraceBuffer::Dump(GetBridgeDir() + "\\bridge_trace.bin");
+#endif
+        FrameProfiler::StopCsv();
+        Log("Detach complete (log lines dropped: " + std::to_string(AsyncLog::Dropped()) + ")");
+        AsyncLog::Stop();
         FreeLibraryAndExitThread(GetModuleHandleA("bridge.dll"), 0);
         return 0;
     }, nullptr, 0, nullptr);
@@ -4233,65 +4338,14 @@ std::string StripMinecraftFormatting(const std::string& in) {
     return out;
 }
 
-static std::string NormalizeNameSpaces(const std::string& in) {
-    std::string out;
-    out.reserve(in.size());
-    bool wasSpace = false;
-    for (size_t i = 0; i < in.size(); i++) {
-        unsigned char c = (unsigned char)in[i];
-        if (c < 32) continue;
-        bool isSpace = std::isspace(c) != 0;
-        if (isSpace) {
-            if (!wasSpace && !out.empty()) out.push_back(' ');
-        }
-        else {
-            out.push_back((char)c);
-        }
-        wasSpace = isSpace;
-    }
-    while (!out.empty() && out.back() == ' ') out.pop_back();
-    return out;
-}
-
-static bool IsLikelyProfileName(const std::string& name) {
-    if (name.size() < 3 || name.size() > 16) return false;
-    for (char ch : name) {
-        unsigned char c = (unsigned char)ch;
-        if (std::isalnum(c) || c == '_') continue;
-        return false;
-    }
-    return true;
-}
+using lc::NormalizeNameSpaces;
+using lc::StableProfileName;
+using lc::TrimNameWhitespace;
 
+// 1.8.9 names are cut to printable ASCII (StripMinecraftFormatting) before
+// the shared check.
 static bool LooksLikeFakePlayerLine(const std::string& rawName) {
-    std::string name = NormalizeNameSpaces(StripMinecraftFormatting(rawName));
-    if (name.empty()) return true;
-
-    bool anyAlnum = false;
-    bool anyNonDecor = false;
-    int alnumCount = 0;
-    for (char ch : name) {
-        unsigned char c = (unsigned char)ch;
-        if (std::isalnum(c)) {
-            anyAlnum = true;
-            anyNonDecor = true;
-            alnumCount++;
-            continue;
-        }
-        if (ch == '_' || ch == ' ') {
-            anyNonDecor = true;
-            continue;
-        }
-        if (ch == '-' || ch == '=' || ch == '[' || ch == ']' || ch == '(' || ch == ')' || ch == '<' || ch == '>' || ch == '|' || ch == '*' || ch == '~' || ch == ':') {
-            continue;
-        }
-        anyNonDecor = true;
-    }
-
-    if (!anyNonDecor) return true;
-    if (!anyAlnum && name != "_") return true;
-    if (alnumCount < 2 && !IsLikelyProfileName(name)) return true;
-    return false;
+    return lc::LooksLikeFakePlayerName(NormalizeNameSpaces(StripMinecraftFormatting(rawName)));
 }
 
 static void EnsureGameProfileCaches(JNIEnv* env, jobject anyPlayerObj) {
@@ -4325,6 +4379,13 @@ static void EnsureGameProfileCaches(JNIEnv* env, jobject anyPlayerObj) {
     }
 }
 
+// Display name with formatting codes and runs of whitespace removed.
+static std::string CleanPlayerDisplayName(std::string name) {
+    TrimNameWhitespace(name);
+    return NormalizeNameSpaces(StripMinecraftFormatting(name));
+}
+
+
 static std::string GetStablePlayerName(JNIEnv* env, jobject playerObj) {
     if (!env || !playerObj) return "";
 
@@ -4365,15 +4426,7 @@ static std::string GetStablePlayerName(JNIEnv* env, jobject playerObj) {
         }
     }
 
-    auto trim = [](std::string& s) {
-        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r' || s.back() == '\n')) s.pop_back();
-        size_t i = 0;
-        while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n')) i++;
-        if (i > 0) s.erase(0, i);
-    };
-
-    trim(name);
-    std::string cleanDisplay = NormalizeNameSpaces(StripMinecraftFormatting(name));
+    std::string cleanDisplay = CleanPlayerDisplayName(name);
     if (!LooksLikeFakePlayerLine(cleanDisplay)) return cleanDisplay;
 
     EnsureGameProfileCaches(env, playerObj);
@@ -4397,10 +4450,241 @@ static std::string GetStablePlayerName(JNIEnv* env, jobject playerObj) {
     }
     env->DeleteLocalRef(gp);
 
-    trim(profileName);
-    if (IsLikelyProfileName(profileName)) return profileName;
-    if (!cleanDisplay.empty() && !LooksLikeFakePlayerLine(cleanDisplay)) return cleanDisplay;
-    return "";
+    return StableProfileName(profileName);
+}
+
+// ---- Player name cache ----
+// GetStablePlayerName() costs a String conversion and several string passes,
+// and names almost never change.  Entries are keyed by Entity.hashCode()
+// (the entity id on 1.8.9); a weak global ref confirms the key still belongs
+// to the same entity object.  A name is re-read after kPlayerNameRefreshMs,
+// entries not looked up for kPlayerNameEvictMs are dropped, and the cache is
+// cleared on world change.  The reach selector (LegoBridge thread) and the
+// scan thread both read it, so the map sits behind its own lock; JNI name
+// reads happen outside it.
+struct PlayerNameEntry {
+    jweak       ref;
+    std::string name;
+    DWORD       fetchedMs;
+    DWORD       seenMs;
+};
+static Mutex g_playerNameCacheMutex;
+static std::unordered_map<int, PlayerNameEntry> g_playerNameCache;
+static DWORD g_lastPlayerNameSweepMs = 0;
+static const DWORD kPlayerNameRefreshMs = 5000;
+static const DWORD kPlayerNameEvictMs = 30000;
+
+static void ResetPlayerNameCache(JNIEnv* env) {
+    LockGuard lk(g_playerNameCacheMutex);
+    if (env) {
+        for (auto& kv : g_playerNameCache)
+            if (kv.second.ref) env->DeleteWeakGlobalRef(kv.second.ref);
+    }
+    g_playerNameCache.clear();
+}
+
+static std::string GetCachedPlayerName(JNIEnv* env, jobject playerObj) {
+    if (!env || !playerObj) return "";
+    if (!g_objectHashCodeMethod) return GetStablePlayerName(env, playerObj);
+    jint key = env->CallIntMethod(playerObj, g_objectHashCodeMethod);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return GetStablePlayerName(env, playerObj); }
+
+    DWORD now = GetTickCount();
+    bool sameObj = false;
+    {
+        LockGuard lk(g_playerNameCacheMutex);
+        if (now - g_lastPlayerNameSweepMs >= kPlayerNameEvictMs) {
+            g_lastPlayerNameSweepMs = now;
+            for (auto it = g_playerNameCache.begin(); it != g_playerNameCache.end(); ) {
+                if (now - it->second.seenMs >= kPlayerNameEvictMs) {
+                    if (it->second.ref) env->DeleteWeakGlobalRef(it->second.ref);
+                    it = g_playerNameCache.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        auto it = g_playerNameCache.find(key);
+        sameObj = it != g_playerNameCache.end() && it->second.ref
+            && env->IsSameObject(it->second.ref, playerObj) == JNI_TRUE;
+        if (sameObj) {
+            it->second.seenMs = now;
+            if (now - it->second.fetchedMs < kPlayerNameRefreshMs) return it->second.name;
+        }
+    }
+
+    std::string name = GetStablePlayerName(env, playerObj);
+    jweak ref = sameObj ? nullptr : env->NewWeakGlobalRef(playerObj);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); ref = nullptr; }
+
+    LockGuard lk(g_playerNameCacheMutex);
+    PlayerNameEntry& e = g_playerNameCache[key];
+    if (!sameObj) {
+        if (e.ref) env->DeleteWeakGlobalRef(e.ref);
+        e.ref = ref;
+    }
+    e.name = name;
+    e.fetchedMs = now;
+    e.seenMs = now;
+    return name;
+}
+
+// ---- AokoHelper (HelperBridge) for the overlay scans ----
+// Everything here runs under g_scanJniMutex; shutdown takes the same lock
+// before HelperBridge::Unload().
+static bool g_legacyHelperLoadTried = false;   // one Load() attempt per runtime
+
+static bool EnsureLegacyHelperLoaded(JNIEnv* env) {
+    if (HelperBridge::IsLoaded()) return HelperBridge::HasLegacyCollectors();
+    if (g_legacyHelperLoadTried) return false;
+    jobject loader = EnsureGameClassLoader(env);
+    if (!loader) return false;
+    g_legacyHelperLoadTried = true;
+    HelperBridge::Load(env, loader);
+    Log(std::string("HelperBridge: loaded=") + (HelperBridge::IsLoaded() ? "1" : "0")
+        + " legacy=" + (HelperBridge::HasLegacyCollectors() ? "1" : "0"));
+    return HelperBridge::HasLegacyCollectors();
+}
+
+// Reflected handle arrays (global refs).  getName / getGameProfile bind late,
+// so the entity arrays are rebuilt whenever the set of resolved IDs grows.
+static jobjectArray g_legacyEntityFields = nullptr;    // Field[kLegacyFieldCount]
+static jobjectArray g_legacyEntityMethods = nullptr;   // Method[kLegacyMethodCount]
+static unsigned     g_legacyEntityMask = 0;
+static jobjectArray g_legacyChestKinds = nullptr;      // Class[] { TileEntityChest, TileEntityEnderChest }
+static jobject      g_legacyTilePosField = nullptr;    // Field TileEntity.pos
+static jobject      g_legacyBlockPosGet[3] = { nullptr, nullptr, nullptr };   // Method BlockPos.getX/Y/Z
+
+static void ResetLegacyHelperHandles(JNIEnv* env) {
+    jobject refs[] = { g_legacyEntityFields, g_legacyEntityMethods, g_legacyChestKinds, g_legacyTilePosField,
+                       g_legacyBlockPosGet[0], g_legacyBlockPosGet[1], g_legacyBlockPosGet[2] };
+    if (env) {
+        for (jobject r : refs) if (r) env->DeleteGlobalRef(r);
+    }
+    g_legacyEntityFields = nullptr;
+    g_legacyEntityMethods = nullptr;
+    g_legacyEntityMask = 0;
+    g_legacyChestKinds = nullptr;
+    g_legacyTilePosField = nullptr;
+    g_legacyBlockPosGet[0] = g_legacyBlockPosGet[1] = g_legacyBlockPosGet[2] = nullptr;
+}
+
+// ToReflected* wrapped in a global ref.  HotSpot reflects the member's own
+// holder, so `cls` only has to be non-null.
+static jobject ReflectedMemberGlobal(JNIEnv* env, jclass cls, jfieldID fid, jmethodID mid) {
+    jobject r = fid ? env->ToReflectedField(cls, fid, JNI_FALSE) : env->ToReflectedMethod(cls, mid, JNI_FALSE);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); r = nullptr; }
+    if (!r) return nullptr;
+    jobject g = env->NewGlobalRef(r);
+    env->DeleteLocalRef(r);
+    return g;
+}
+
+static jobjectArray ReflectedMemberArrayGlobal(JNIEnv* env, const char* elemClass, jclass anyCls,
+                                               const jfieldID* fids, const jmethodID* mids, int n, unsigned& built) {
+    built = 0;
+    jclass elemCls = env->FindClass(elemClass);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); elemCls = nullptr; }
+    if (!elemCls) return nullptr;
+    jobjectArray arr = env->NewObjectArray(n, elemCls, nullptr);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); arr = nullptr; }
+    env->DeleteLocalRef(elemCls);
+    if (!arr) return nullptr;
+    for (int i = 0; i < n; i++) {
+        if (fids ? !fids[i] : !mids[i]) continue;
+        jobject m = fids ? env->ToReflectedField(anyCls, fids[i], JNI_FALSE)
+                         : env->ToReflectedMethod(anyCls, mids[i], JNI_FALSE);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); m = nullptr; }
+        if (!m) continue;
+        env->SetObjectArrayElement(arr, i, m);
+        env->DeleteLocalRef(m);
+        built |= 1u << i;
+    }
+    jobjectArray g = (jobjectArray)env->NewGlobalRef(arr);
+    env->DeleteLocalRef(arr);
+    return g;
+}
+
+static bool EnsureLegacyEntityHandles(JNIEnv* env, jobject playerObj) {
+    if (!playerObj || !EnsureLegacyHelperLoaded(env)) return false;
+    if (!g_posXField || !g_posYField || !g_posZField) return false;
+    EnsureGameProfileCaches(env, playerObj);
+    const jfieldID fids[HelperBridge::kLegacyFieldCount] = {
+        g_posXField, g_posYField, g_posZField,
+        g_lastTickPosXField, g_lastTickPosYField, g_lastTickPosZField
+    };
+    const jmethodID mids[HelperBridge::kLegacyMethodCount] = {
+        g_getHealthMethod, g_getTotalArmorValueMethod, g_getNameMethod,
+        g_getGameProfileMethod, g_gameProfileGetNameMethod
+    };
+    unsigned mask = 0;
+    for (int i = 0; i < HelperBridge::kLegacyFieldCount; i++) if (fids[i]) mask |= 1u << i;
+    for (int i = 0; i < HelperBridge::kLegacyMethodCount; i++) if (mids[i]) mask |= 1u << (8 + i);
+    if (g_legacyEntityFields && g_legacyEntityMethods && mask == g_legacyEntityMask) return true;
+
+    jclass playerCls = env->GetObjectClass(playerObj);
+    if (!playerCls) { env->ExceptionClear(); return false; }
+    unsigned builtF = 0, builtM = 0;
+    jobjectArray fields = ReflectedMemberArrayGlobal(env, "java/lang/reflect/Field", playerCls,
+                                                     fids, nullptr, HelperBridge::kLegacyFieldCount, builtF);
+    jobjectArray methods = ReflectedMemberArrayGlobal(env, "java/lang/reflect/Method", playerCls,
+                                                      nullptr, mids, HelperBridge::kLegacyMethodCount, builtM);
+    env->DeleteLocalRef(playerCls);
+    if (!fields || !methods || (builtF & 7u) != 7u) {
+        if (fields) env->DeleteGlobalRef(fields);
+        if (methods) env->DeleteGlobalRef(methods);
+        return false;
+    }
+    if (g_legacyEntityFields) env->DeleteGlobalRef(g_legacyEntityFields);
+    if (g_legacyEntityMethods) env->DeleteGlobalRef(g_legacyEntityMethods);
+    g_legacyEntityFields = fields;
+    g_legacyEntityMethods = methods;
+    g_legacyEntityMask = mask;
+    return true;
+}
+
+static bool EnsureLegacyChestHandles(JNIEnv* env, jobject anyObj) {
+    if (g_legacyChestKinds) return true;
+    if (!anyObj || !EnsureLegacyHelperLoaded(env)) return false;
+    if (!g_tileEntityPosField || !g_blockPosGetX || !g_blockPosGetY || !g_blockPosGetZ) return false;
+
+    jclass anyCls = env->GetObjectClass(anyObj);
+    if (!anyCls) { env->ExceptionClear(); return false; }
+    jclass classCls = env->FindClass("java/lang/Class");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); classCls = nullptr; }
+    jobjectArray kinds = classCls ? env->NewObjectArray(2, classCls, nullptr) : nullptr;
+    if (env->ExceptionCheck()) { env->ExceptionClear(); kinds = nullptr; }
+    if (kinds) {
+        env->SetObjectArrayElement(kinds, 0, g_tileEntityChestClass);
+        env->SetObjectArrayElement(kinds, 1, g_tileEntityEnderChestClass);
+    }
+    jobject pos = ReflectedMemberGlobal(env, anyCls, g_tileEntityPosField, nullptr);
+    jobject gx = ReflectedMemberGlobal(env, anyCls, nullptr, g_blockPosGetX);
+    jobject gy = ReflectedMemberGlobal(env, anyCls, nullptr, g_blockPosGetY);
+    jobject gz = ReflectedMemberGlobal(env, anyCls, nullptr, g_blockPosGetZ);
+    bool ok = kinds && pos && gx && gy && gz;
+    if (ok) {
+        g_legacyChestKinds = (jobjectArray)env->NewGlobalRef(kinds);
+        g_legacyTilePosField = pos;
+        g_legacyBlockPosGet[0] = gx;
+        g_legacyBlockPosGet[1] = gy;
+        g_legacyBlockPosGet[2] = gz;
+    } else {
+        jobject made[] = { pos, gx, gy, gz };
+        for (jobject r : made) if (r) env->DeleteGlobalRef(r);
+    }
+    if (kinds) env->DeleteLocalRef(kinds);
+    if (classCls) env->DeleteLocalRef(classCls);
+    env->DeleteLocalRef(anyCls);
+    return ok;
+}
+
+// Name rule of GetStablePlayerName() applied to a helper record.
+static std::string LegacyRecordPlayerName(const HelperBridge::LegacyEntityFrame& frame,
+                                          const HelperBridge::LegacyEntityRecord& rec) {
+    std::string cleanDisplay = CleanPlayerDisplayName(frame.Str(rec.name));
+    if (!LooksLikeFakePlayerLine(cleanDisplay)) return cleanDisplay;
+    return StableProfileName(frame.Str(rec.profile));
 }
 
 std::string ToLowerAscii(std::string s) {
@@ -4910,6 +5194,27 @@ static bool ShouldHideWorldRenderModules(const GameState& state) {
 }
 
 // ===================== HUD RENDERING =====================
+// Everything the module list and logo depend on; the HudCache layer adds the
+// font atlas, font size and display metrics.
+static unsigned long long ModuleListKey(const Config& cfg) {
+    HudCache::Key key;
+    key.Add(cfg.guiTheme);
+    key.Add(cfg.moduleListStyle);
+    key.Add(cfg.showLogo);
+    key.Add(cfg.armed);
+    if (cfg.armed) {
+        key.Add((int)cfg.minCPS);
+        key.Add((int)cfg.maxCPS);
+    }
+    const bool enabled[] = {
+        cfg.clickInChests, cfg.closestPlayerInfo, cfg.rightClick, cfg.aimAssist,
+        cfg.triggerbot, cfg.speedBridge, cfg.chestEsp, cfg.nametags, cfg.gtbHelper,
+        cfg.jitter, cfg.breakBlocks, cfg.reachEnabled, cfg.velocityEnabled
+    };
+    key.Add(enabled, sizeof(enabled));
+    return key.Value();
+}
+
 void RenderHUD(int winW, int winH) {
     if (g_guiOpen) return; // hide HUD when config is open
 
@@ -4929,106 +5234,113 @@ void RenderHUD(int winW, int winH) {
     ImDrawList* fg = ImGui::GetForegroundDrawList();
     ImGuiIO& io = ImGui::GetIO();
 
-    struct ModLine { std::string text; ImU32 accent; float width; };
-    std::vector<ModLine> mods;
-    mods.reserve(16);
+    // The module list and logo only change with config/theme; replay the
+    // retained geometry until ModuleListKey() moves.
+    const unsigned long long moduleListKey = ModuleListKey(cfg);
+    if (!g_moduleListLayer.Replay(fg, moduleListKey)) {
+        g_moduleListLayer.BeginCapture(fg, moduleListKey);
+        struct ModLine { std::string text; ImU32 accent; float width; };
+        std::vector<ModLine> mods;
+        mods.reserve(16);
+
+        auto pushMod = [&](const std::string& text, ImU32 accent) {
+            if (text.empty()) return;
+            mods.push_back({ text, accent, ImGui::CalcTextSize(text.c_str()).x });
+        };
 
-    auto pushMod = [&](const std::string& text, ImU32 accent) {
-        if (text.empty()) return;
-        mods.push_back({ text, accent, ImGui::CalcTextSize(text.c_str()).x });
-    };
+        char acBuf[64];
+        if (cfg.armed) {
+            int lo = (int)cfg.minCPS;
+            int hi = (int)cfg.maxCPS;
+            if (hi < lo) std::swap(hi, lo);
+            snprintf(acBuf, sizeof(acBuf), "Autoclicker %d-%d", lo, hi);
+            pushMod(acBuf, ToImU32(theme.accentPrimary));
+        }
+        if (cfg.clickInChests)     pushMod("Click in Chests", ToImU32(theme.accentTertiary));
+        if (cfg.closestPlayerInfo) pushMod("Closest Player", ToImU32(theme.accentSecondary));
+        if (cfg.rightClick)        pushMod("Rightclick", ToImU32(theme.accentTertiary));
+        if (cfg.aimAssist)         pushMod("Aim Assist", ToImU32(theme.accentPrimary));
+        if (cfg.triggerbot)        pushMod("Triggerbot", ToImU32(theme.accentSecondary));
+        if (cfg.speedBridge)       pushMod("SpeedBridge", ToImU32(theme.accentPrimary));
+        if (cfg.chestEsp)          pushMod("Chest ESP", ToImU32(theme.accentSecondary));
+        if (cfg.nametags)          pushMod("Nametags", ToImU32(theme.accentPrimary));
+        if (cfg.gtbHelper)         pushMod("GTB Helper", ToImU32(theme.accentTertiary));
+        if (cfg.jitter)            pushMod("Jitter", ToImU32(theme.accentSecondary));
+        if (cfg.breakBlocks)       pushMod("Break Blocks", ToImU32(theme.accentTertiary));
+        if (cfg.reachEnabled)      pushMod("Reach", ToImU32(theme.accentPrimary));
+        if (cfg.velocityEnabled)   pushMod("Velocity", ToImU32(theme.accentTertiary));
+
+        std::sort(mods.begin(), mods.end(), [](const ModLine& a, const ModLine& b) {
+            if (a.width != b.width) return a.width > b.width;
+            return a.text < b.text;
+        });
+
+        const float marginX = 10.0f;
+        float y = 10.0f;
+
+        if (cfg.showLogo) {
+            const char* logoText = "aoko client";
+            ImVec2 logoSz = ImGui::CalcTextSize(logoText);
+            float logoX = io.DisplaySize.x - marginX - logoSz.x;
+            fg->AddText(ImVec2(logoX + 1, y + 1), ToImU32(theme.logoShadow), logoText);
+            fg->AddText(ImVec2(logoX, y), ToImU32(theme.logoColor), logoText);
+            y += logoSz.y + 8.0f;
+        }
+
+        const float padX = 8.0f;
+        const float padY = 3.0f;
+        const float barW = 3.0f;
+        const float gapY = 2.0f;
+        const float fontH = ImGui::GetFontSize();
+        const int style = (std::max)(0, (std::min)(4, cfg.moduleListStyle));
+
+        for (size_t i = 0; i < mods.size(); i++) {
+            const ModLine& m = mods[i];
+            ImVec2 textSz = ImGui::CalcTextSize(m.text.c_str());
+            float boxW = barW + padX + textSz.x + padX;
+            float boxH = padY + fontH + padY;
+            float x0 = io.DisplaySize.x - marginX - boxW;
+            float x1 = io.DisplaySize.x - marginX;
+            float y0 = y;
+            float y1 = y + boxH;
+
+            if (style == 0) {
+                fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleBg));
+                fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x0 + barW, y1), m.accent);
+                fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleBorder));
+                ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
+                fg->AddText(tx, ToImU32(theme.moduleText), m.text.c_str());
+            } else if (style == 1) {
+                fg->AddRectFilled(ImVec2(x1 - textSz.x - 4, y0), ImVec2(x1, y1), ToImU32(theme.moduleMinimalBg));
+                fg->AddRectFilled(ImVec2(x1 - 2, y0), ImVec2(x1, y1), m.accent);
+                ImVec2 tx = ImVec2(x1 - textSz.x - 2, y0 + padY);
+                fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
+                fg->AddText(tx, m.accent, m.text.c_str());
+            } else if (style == 2) {
+                fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleOutlinedBg));
+                fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f, 0, 1.5f);
+                ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
+                fg->AddText(tx, m.accent, m.text.c_str());
+            } else if (style == 3) {
+                fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleMinimalBg), 4.0f);
+                fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleGlassBorder), 4.0f, 0, 1.0f);
+                fg->AddRectFilled(ImVec2(x0 + 1.0f, y0 + 1.0f), ImVec2(x0 + barW + 1.0f, y1 - 1.0f), m.accent);
+                ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
+                fg->AddText(tx, ToImU32(theme.moduleText), m.text.c_str());
+            } else {
+                fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f);
+                fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleBorder), 4.0f, 0, 1.0f);
+                ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
+                fg->AddText(tx, ToImU32(theme.moduleBoldText), m.text.c_str());
+            }
 
-    char acBuf[64];
-    if (cfg.armed) {
-        int lo = (int)cfg.minCPS;
-        int hi = (int)cfg.maxCPS;
-        if (hi < lo) std::swap(hi, lo);
-        snprintf(acBuf, sizeof(acBuf), "Autoclicker %d-%d", lo, hi);
-        pushMod(acBuf, ToImU32(theme.accentPrimary));
-    }
-    if (cfg.clickInChests)     pushMod("Click in Chests", ToImU32(theme.accentTertiary));
-    if (cfg.closestPlayerInfo) pushMod("Closest Player", ToImU32(theme.accentSecondary));
-    if (cfg.rightClick)        pushMod("Rightclick", ToImU32(theme.accentTertiary));
-    if (cfg.aimAssist)         pushMod("Aim Assist", ToImU32(theme.accentPrimary));
-    if (cfg.triggerbot)        pushMod("Triggerbot", ToImU32(theme.accentSecondary));
-    if (cfg.speedBridge)       pushMod("SpeedBridge", ToImU32(theme.accentPrimary));
-    if (cfg.chestEsp)          pushMod("Chest ESP", ToImU32(theme.accentSecondary));
-    if (cfg.nametags)          pushMod("Nametags", ToImU32(theme.accentPrimary));
-    if (cfg.gtbHelper)         pushMod("GTB Helper", ToImU32(theme.accentTertiary));
-    if (cfg.jitter)            pushMod("Jitter", ToImU32(theme.accentSecondary));
-    if (cfg.breakBlocks)       pushMod("Break Blocks", ToImU32(theme.accentTertiary));
-    if (cfg.reachEnabled)      pushMod("Reach", ToImU32(theme.accentPrimary));
-    if (cfg.velocityEnabled)   pushMod("Velocity", ToImU32(theme.accentTertiary));
-
-    std::sort(mods.begin(), mods.end(), [](const ModLine& a, const ModLine& b) {
-        if (a.width != b.width) return a.width > b.width;
-        return a.text < b.text;
-    });
-
-    const float marginX = 10.0f;
-    float y = 10.0f;
-
-    if (cfg.showLogo) {
-        const char* logoText = "aoko client";
-        ImVec2 logoSz = ImGui::CalcTextSize(logoText);
-        float logoX = io.DisplaySize.x - marginX - logoSz.x;
-        fg->AddText(ImVec2(logoX + 1, y + 1), ToImU32(theme.logoShadow), logoText);
-        fg->AddText(ImVec2(logoX, y), ToImU32(theme.logoColor), logoText);
-        y += logoSz.y + 8.0f;
-    }
-
-    const float padX = 8.0f;
-    const float padY = 3.0f;
-    const float barW = 3.0f;
-    const float gapY = 2.0f;
-    const float fontH = ImGui::GetFontSize();
-    const int style = (std::max)(0, (std::min)(4, cfg.moduleListStyle));
-
-    for (size_t i = 0; i < mods.size(); i++) {
-        const ModLine& m = mods[i];
-        ImVec2 textSz = ImGui::CalcTextSize(m.text.c_str());
-        float boxW = barW + padX + textSz.x + padX;
-        float boxH = padY + fontH + padY;
-        float x0 = io.DisplaySize.x - marginX - boxW;
-        float x1 = io.DisplaySize.x - marginX;
-        float y0 = y;
-        float y1 = y + boxH;
-
-        if (style == 0) {
-            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleBg));
-            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x0 + barW, y1), m.accent);
-            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleBorder));
-            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
-            fg->AddText(tx, ToImU32(theme.moduleText), m.text.c_str());
-        } else if (style == 1) {
-            fg->AddRectFilled(ImVec2(x1 - textSz.x - 4, y0), ImVec2(x1, y1), ToImU32(theme.moduleMinimalBg));
-            fg->AddRectFilled(ImVec2(x1 - 2, y0), ImVec2(x1, y1), m.accent);
-            ImVec2 tx = ImVec2(x1 - textSz.x - 2, y0 + padY);
-            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
-            fg->AddText(tx, m.accent, m.text.c_str());
-        } else if (style == 2) {
-            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleOutlinedBg));
-            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f, 0, 1.5f);
-            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
-            fg->AddText(tx, m.accent, m.text.c_str());
-        } else if (style == 3) {
-            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleMinimalBg), 4.0f);
-            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleGlassBorder), 4.0f, 0, 1.0f);
-            fg->AddRectFilled(ImVec2(x0 + 1.0f, y0 + 1.0f), ImVec2(x0 + barW + 1.0f, y1 - 1.0f), m.accent);
-            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
-            fg->AddText(tx, ToImU32(theme.moduleText), m.text.c_str());
-        } else {
-            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f);
-            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), ToImU32(theme.moduleBorder), 4.0f, 0, 1.0f);
-            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), ToImU32(theme.moduleTextShadow), m.text.c_str());
-            fg->AddText(tx, ToImU32(theme.moduleBoldText), m.text.c_str());
+            y += boxH + gapY;
         }
-
-        y += boxH + gapY;
+        g_moduleListLayer.EndCapture(fg);
     }
 
     if (cfg.gtbHelper) {
@@ -5247,6 +5559,9 @@ Matrix4x4 GetMatrix(JNIEnv* env, jfieldID field) {
     return m;
 }
 
+// Clip w below which a point is behind the camera; the overlay frustum uses it too.
+static const float kLegacyNearW = 0.02f;
+
 bool WorldToScreen(const double x, const double y, const double z, const Matrix4x4& view, const Matrix4x4& proj, int w, int h, float& outX, float& outY) {
     // 1. View Transformation
     float vX = x * view.m[0] + y * view.m[4] + z * view.m[8] + view.m[12];
@@ -5260,7 +5575,7 @@ bool WorldToScreen(const double x, const double y, const double z, const Matrix4
     float pZ = vX * proj.m[2] + vY * proj.m[6] + vZ * proj.m[10] + proj.m[14];
     float pW = vX * proj.m[3] + vY * proj.m[7] + vZ * proj.m[11] + proj.m[15];
 
-    if (pW < 0.02f) return false; // Behind camera
+    if (pW < kLegacyNearW) return false; // Behind camera
 
     // 3. Perspective Divide
     float ndcX = pX / pW;
@@ -5272,232 +5587,238 @@ bool WorldToScreen(const double x, const double y, const double z, const Matrix4
 
     return true;
 }
-void RenderNametags(int w, int h) {
-    TRACE_PATH("enter");
-   static bool warnedMissingMappings = false;
-    bool showHealth = true;
-    bool showArmor = true;
-    bool hideVanillaTags = false;
-    bool nametagsEnabled = false;
-    bool entityTelemetryNeeded = false;
-    int nametagMaxCount = 8;
-    {
-         LockGuard lk(g_configMutex);
-         nametagsEnabled = g_config.nametags;
-         entityTelemetryNeeded = g_config.nametags || g_config.closestPlayerInfo || g_config.aimAssist || g_config.nametagHideVanilla || g_legacyNametagSuppressionActive;
-         TRACE_BRANCH("entityTelemetryNeeded", entityTelemetryNeeded);
-          if (!entityTelemetryNeeded) return;
-         showHealth = g_config.nametagShowHealth;
-         showArmor = g_config.nametagShowArmor;
-         hideVanillaTags = g_config.nametagHideVanilla;
-         nametagMaxCount = (std::max)(1, (std::min)(20, g_config.nametagMaxCount));
-    }
-
-    // Default to empty telemetry each run so stale entities are not reused.
-    {
-        LockGuard lk(g_jsonMutex);
-        g_pendingJson = "[]";
-    }
-   bool mappedReady = (g_mapped && g_mcInstance);
-   TRACE_BRANCH("mappedReady", mappedReady);
-   if (!mappedReady) return;
+// ===================== RENDER SNAPSHOTS (scan thread) =====================
+// On 1.8.9 the render thread is the client thread, so JNI made inside the
+// SwapBuffers hook stalled the very frame it was drawing, and a frame whose
+// JNI lock was taken could only skip its world overlays.  As on the 26.1
+// bridge (BgCamState), the scan thread does that work instead: once per
+// rendered frame, or every kLegacyScanMaxGapMs while frames stall, it reads
+// the camera, partial ticks, players and chests and publishes one native
+// snapshot.  RenderNametags / RenderClosestPlayerInfo / RenderChestESP only
+// project and draw what the snapshot holds.  Everything in a snapshot is
+// read in the same pass, so it is self-consistent and at most a frame old.
+
+struct LegacyCamState {
+    Matrix4x4 view = {}, proj = {};
+    bool   matsOk = false;       // ActiveRenderInfo matrices usable and not UI-space
+    double viewerX = 0, viewerY = 0, viewerZ = 0;   // RenderManager.viewerPos*
+    double localX = 0, localY = 0, localZ = 0;
+    float  localYaw = 0;
+    bool   haveLocal = false;
+};
 
-    ScopedJNIEnv env(g_jvm);
-    TRACE_BRANCH("jniEnvAvailable", env != nullptr);
-    if (!env) return;
+struct LegacyPlayerData {
+    std::string name;
+    std::string heldItem;   // read only while nametags are on, for the first kLegacyHeldItemReads in range
+    double x, y, z;         // interpolated with the pass's partial ticks
+    double dist;            // from the local player, interpolated
+    float  health;
+    int    armor;           // -1 when unknown or not shown
+    int    key;             // entity hash; keys the render thread's tag smoothing
+};
 
-    TryResolveScreenFieldDirect(env);
-    TryResolvePlayerCoreMappings(env);
-    TryResolveWorldMappings(env);
-    TryResolveRenderMappings(env, false);
+struct LegacyClosestData {
+    bool   valid = false;
+    std::string name;
+    std::string heldItem;
+    double dist = 0, dx = 0, dz = 0;   // from raw (tick) positions
+    float  health = 20.0f;
+    int    armor = -1;
+};
 
-    if (!g_theWorldField || !g_listSizeMethod || !g_listGetMethod ||
-        !g_thePlayerField || !g_posXField || !g_posYField || !g_posZField) {
-        TRACE_PATH("missing-core-player-mappings");
-        if (!warnedMissingMappings) {
-            warnedMissingMappings = true;
-            Log("Nametags missing core/player mappings.");
-        }
-        return;
-    }
+struct LegacyChestData { int x, y, z; double dist; };
 
-    if (!g_playerEntitiesField) {
-        TRACE_PATH("missing-world-entity-mappings");
-        if (!warnedMissingMappings) {
-            warnedMissingMappings = true;
-            Log("Nametags waiting for JNI world mappings.");
-        }
-        return;
-    }
+struct LegacyRenderSnapshot {
+    LegacyCamState cam;
+    std::vector<LegacyPlayerData> players;   // list order, within 48 blocks; own player and fake lines dropped
+    bool   suppressing = false;              // vanilla-tag suppression ran: tags are not capped
+    LegacyClosestData closest;
+    std::vector<LegacyChestData> chests;     // list order, within 64 blocks
+};
 
-    if (!g_activeRenderInfoClass || !g_modelViewField || !g_projectionField) {
-        TRACE_PATH("missing-render-mappings");
-        if (!warnedMissingMappings) {
-            warnedMissingMappings = true;
-            Log("Nametags waiting for render mappings.");
-        }
-        return;
-    }
+// Written only by the scan thread; the render thread holds a Ref per frame.
+static lc::SnapshotCell<LegacyRenderSnapshot> g_legacyRenderSnap;
+typedef lc::SnapshotCell<LegacyRenderSnapshot>::Ref LegacyRenderRef;
+// For telemetry: when the scan thread last committed, and the newest
+// generation the render thread has drawn.
+static volatile DWORD g_legacyRenderSnapMs = 0;
+static volatile LONG g_legacyRenderedSnapVersion = 0;
 
-   warnedMissingMappings = false;
-   g_tagFrameCounter++;
+static LegacyRenderRef AcquireLegacyRenderSnap() {
+    LegacyRenderRef ref = g_legacyRenderSnap.Acquire();
+    InterlockedExchange(&g_legacyRenderedSnapVersion, ref.Version());
+    return ref;
+}
 
-    // Safety check: Don't render if we have pending exceptions
-    if (env->ExceptionCheck()) { env->ExceptionClear(); return; }
-    
-    // Ensure we can create local references (limit to 256 for this frame)
-    if (env->PushLocalFrame(256) < 0) {
-        env->ExceptionClear();
-        return;
-    }
-    
-    // Ensure C locale for dot decimals
-    setlocale(LC_NUMERIC, "C");
+static HANDLE g_legacyScanWake = nullptr;     // auto-reset; set by every SwapBuffers
+static HANDLE g_legacyScanThread = nullptr;
+static const DWORD kLegacyScanMaxGapMs = 50;
+static const int   kLegacyHeldItemReads = 20;   // held-item lookups per pass
 
-    // 1. Get Matrices
-    Matrix4x4 view = GetMatrix(env, g_modelViewField);
-    Matrix4x4 proj = GetMatrix(env, g_projectionField);
-    bool matrixProjectionUsable = MatrixProjectionUsable(view, proj);
-    TRACE_BRANCH("matrixProjectionUsableInitial", matrixProjectionUsable);
-    bool usedCapturedMatrices = false;
-    if (!matrixProjectionUsable) {
-        TRACE_PATH("matrix-fallback-captured");
-        usedCapturedMatrices = TryUseCapturedRenderMatrices(view, proj);
-        matrixProjectionUsable = usedCapturedMatrices;
-    }
-    TRACE_BRANCH("matrixProjectionUsableAfterFallback", matrixProjectionUsable);
+struct LegacyScanConfig {
+    bool nametags, closestPlayer, chestEsp, aimAssist, hideVanilla;
+    bool showHealth, showArmor;
+};
 
-    static int logctr = 0;
-    static bool loggedCapturedMatrixFallback = false;
+// Reads matrices, partial ticks, viewer and local player position into
+// `cam`.  Returns the partial ticks (1 when unknown).
+static float ReadLegacyCamState(JNIEnv* env, LegacyCamState& cam) {
     static bool loggedUiMatrixReject = false;
-    if (logctr++ % 600 == 0) {
-         Log("Matrix Debug - View[0]: " + std::to_string(view.m[0]) + " Proj[0]: " + std::to_string(proj.m[0]));
-         if (!matrixProjectionUsable) Log("WARNING: Matrix projection unavailable.");
-         if (usedCapturedMatrices && !loggedCapturedMatrixFallback) {
-             loggedCapturedMatrixFallback = true;
-             Log("Nametags using captured GL matrix fallback.");
-         }
-    }
-
-    if (matrixProjectionUsable && IsLikelyUiOrthoMatrix(view, proj)) {
-        TRACE_PATH("matrix-ui-ortho-rebind-attempt");
-        TryResolveRenderMappings(env, false);
-        view = GetMatrix(env, g_modelViewField);
-        proj = GetMatrix(env, g_projectionField);
-        matrixProjectionUsable = MatrixProjectionUsable(view, proj);
-        usedCapturedMatrices = false;
-        if (!matrixProjectionUsable) {
-            TRACE_PATH("matrix-ui-ortho-second-fallback");
-            usedCapturedMatrices = TryUseCapturedRenderMatrices(view, proj);
-            matrixProjectionUsable = usedCapturedMatrices;
-        }
-        if (matrixProjectionUsable && IsLikelyUiOrthoMatrix(view, proj)) {
-            matrixProjectionUsable = false;
-            if (!loggedUiMatrixReject) {
-                loggedUiMatrixReject = true;
-                Log("Nametags rejected UI-space matrix projection after rebind attempt.");
+    float pt = 1.0f;
+    if (g_activeRenderInfoClass && g_modelViewField && g_projectionField) {
+        cam.view = GetMatrix(env, g_modelViewField);
+        cam.proj = GetMatrix(env, g_projectionField);
+        bool usable = MatrixProjectionUsable(cam.view, cam.proj);
+        if (usable && IsLikelyUiOrthoMatrix(cam.view, cam.proj)) {
+            TRACE_PATH("matrix-ui-ortho-rebind-attempt");
+            TryResolveRenderMappings(env, false);
+            cam.view = GetMatrix(env, g_modelViewField);
+            cam.proj = GetMatrix(env, g_projectionField);
+            usable = MatrixProjectionUsable(cam.view, cam.proj);
+            if (usable && IsLikelyUiOrthoMatrix(cam.view, cam.proj)) {
+                usable = false;
+                if (!loggedUiMatrixReject) {
+                    loggedUiMatrixReject = true;
+                    Log("Scan thread rejected UI-space matrix projection after rebind attempt.");
+                }
             }
         }
+        cam.matsOk = usable;
     }
 
-    // 2. Get Partial Ticks
-    float pt = 1.0f;
     if (g_timerField && g_renderPartialTicksField) {
         jobject timer = env->GetObjectField(g_mcInstance, g_timerField);
         if (timer) {
-             pt = env->GetFloatField(timer, g_renderPartialTicksField);
-             env->DeleteLocalRef(timer);
+            pt = env->GetFloatField(timer, g_renderPartialTicksField);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); pt = 1.0f; }
+            env->DeleteLocalRef(timer);
         }
     }
 
-    // 3. Get RenderManager Viewer Position (the matrix path expects camera-relative coords)
-    double vX = 0.0, vY = 0.0, vZ = 0.0;
+    // The matrix path expects camera-relative coordinates.
     if (g_renderManagerField && g_viewerPosXField && g_viewerPosYField && g_viewerPosZField) {
         jobject rm = env->GetObjectField(g_mcInstance, g_renderManagerField);
         if (rm) {
-            vX = env->GetDoubleField(rm, g_viewerPosXField);
-            vY = env->GetDoubleField(rm, g_viewerPosYField);
-            vZ = env->GetDoubleField(rm, g_viewerPosZField);
+            cam.viewerX = env->GetDoubleField(rm, g_viewerPosXField);
+            cam.viewerY = env->GetDoubleField(rm, g_viewerPosYField);
+            cam.viewerZ = env->GetDoubleField(rm, g_viewerPosZField);
             env->DeleteLocalRef(rm);
         }
     }
 
-    // 4. Iterate Entities
+    if (g_thePlayerField && g_posXField && g_posYField && g_posZField) {
+        jobject player = env->GetObjectField(g_mcInstance, g_thePlayerField);
+        if (player) {
+            cam.localX = env->GetDoubleField(player, g_posXField);
+            cam.localY = env->GetDoubleField(player, g_posYField);
+            cam.localZ = env->GetDoubleField(player, g_posZField);
+            if (g_rotationYawField) cam.localYaw = env->GetFloatField(player, g_rotationYawField);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); cam.localYaw = 0.0f; }
+            cam.haveLocal = true;
+            env->DeleteLocalRef(player);
+        }
+    }
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    return pt;
+}
+
+// 1.8.9 player reads for ScanEngine.  With AokoHelper loaded, positions,
+// health, armor, names and hash codes come back in one crossing; otherwise
+// each entity is read through its fields.  Names go through the ASCII-only
+// legacy fake-line check.
+struct LegacyPlayerAdapter : ScanEngine::VersionAdapter {
+    bool showArmor;
+    HelperBridge::LegacyEntityFrame frame;
+
+    LegacyPlayerAdapter() : showArmor(false) {}
+
+    bool CollectBatch(JNIEnv* env, jobject list, jobject self, std::vector<ScanEngine::PlayerSample>& out) {
+        if (!EnsureLegacyEntityHandles(env, self)) return false;
+        if (HelperBridge::CollectLegacyEntities(env, list, self, g_legacyEntityFields, g_legacyEntityMethods, frame) < 0) return false;
+        out.resize(frame.records.size());
+        for (size_t i = 0; i < frame.records.size(); i++) {
+            const HelperBridge::LegacyEntityRecord& rec = frame.records[i];
+            ScanEngine::PlayerSample& s = out[i];
+            s.index = rec.index;
+            s.key = rec.hash;
+            s.x = rec.x; s.y = rec.y; s.z = rec.z;
+            s.lastX = rec.lastX; s.lastY = rec.lastY; s.lastZ = rec.lastZ;
+            s.health = rec.health;
+            s.armor = showArmor ? rec.armor : -1;
+            s.dist = 0.0;
+            s.name = LegacyRecordPlayerName(frame, rec);
+        }
+        return true;
+    }
+
+    bool ReadPlayer(JNIEnv* env, jobject entity, ScanEngine::PlayerSample& out) {
+        out.x = env->GetDoubleField(entity, g_posXField);
+        out.y = env->GetDoubleField(entity, g_posYField);
+        out.z = env->GetDoubleField(entity, g_posZField);
+        out.lastX = g_lastTickPosXField ? env->GetDoubleField(entity, g_lastTickPosXField) : out.x;
+        out.lastY = g_lastTickPosYField ? env->GetDoubleField(entity, g_lastTickPosYField) : out.y;
+        out.lastZ = g_lastTickPosZField ? env->GetDoubleField(entity, g_lastTickPosZField) : out.z;
+        if (env->ExceptionCheck()) return false;
+        out.name = GetCachedPlayerName(env, entity);
+        if (out.name.empty()) return false;
+        if (g_getHealthMethod) {
+            out.health = env->CallFloatMethod(entity, g_getHealthMethod);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); out.health = 20.0f; }
+        }
+        if (showArmor && g_getTotalArmorValueMethod) {
+            out.armor = env->CallIntMethod(entity, g_getTotalArmorValueMethod);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); out.armor = -1; }
+        }
+        if (g_objectHashCodeMethod) {
+            out.key = env->CallIntMethod(entity, g_objectHashCodeMethod);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); out.key = 0; }
+        }
+        return true;
+    }
+
+    bool IsFakeName(const std::string& name) { return LooksLikeFakePlayerLine(name); }
+};
+
+// One walk of playerEntities feeds the nametags, the entity telemetry, the
+// vanilla-tag suppression pass and the closest-player card.
+static void CollectLegacyPlayers(JNIEnv* env, const LegacyScanConfig& cfg, float pt, LegacyRenderSnapshot& snap) {
+    TRACE_PATH("enter");
+    static bool warnedMissingMappings = false;
+    if (!g_theWorldField || !g_listSizeMethod || !g_listGetMethod ||
+        !g_thePlayerField || !g_posXField || !g_posYField || !g_posZField) {
+        TRACE_PATH("missing-core-player-mappings");
+        if (!warnedMissingMappings) {
+            warnedMissingMappings = true;
+            Log("Nametags missing core/player mappings.");
+        }
+        return;
+    }
+    if (!g_playerEntitiesField) {
+        TRACE_PATH("missing-world-entity-mappings");
+        if (!warnedMissingMappings) {
+            warnedMissingMappings = true;
+            Log("Nametags waiting for JNI world mappings.");
+        }
+        return;
+    }
+    warnedMissingMappings = false;
+
+    LocalFrame frame(env, 256);
+    if (!frame.ok()) return;
+
     jobject world = env->GetObjectField(g_mcInstance, g_theWorldField);
     if (!world) {
         if (g_legacyNametagSuppressionActive || !g_hiddenNametagOriginalTeamByPlayerLegacy.empty() || g_lastLegacyNametagSuppressionWorld) {
             ResetLegacyNametagSuppressionState(env, "world-null");
         }
-        if (logctr % 600 == 0) Log("WARNING: World is null");
-        env->PopLocalFrame(nullptr);
         return;
     }
     TrackLegacySuppressionWorldContext(env, world);
-    
-    jobject startList = env->GetObjectField(world, g_playerEntitiesField);
-    if (!startList) {
-        if (logctr % 600 == 0) Log("WARNING: playerEntities list is null");
-        env->PopLocalFrame(nullptr);
-        return;
-    }
 
-    int size = env->CallIntMethod(startList, g_listSizeMethod);
-    if (env->ExceptionCheck()) {
-        env->ExceptionClear();
-        env->PopLocalFrame(nullptr);
-        return;
-    }
-    if (logctr % 600 == 0) Log("Entity List Size: " + std::to_string(size));
-    
-    int count = 0;
-
-    bool guiOpen = g_guiOpen;
-    std::string screenName = "none";
-    if (g_currentScreenField) {
-        jobject currentScreen = env->GetObjectField(g_mcInstance, g_currentScreenField);
-        if (currentScreen) {
-            guiOpen = true;
-            jclass cls = env->GetObjectClass(currentScreen);
-            if (cls) {
-                jclass cc = env->GetObjectClass(cls);
-                jmethodID mGetName = cc ? env->GetMethodID(cc, "getName", "()Ljava/lang/String;") : nullptr;
-                if (mGetName) {
-                    jstring jn = (jstring)env->CallObjectMethod(cls, mGetName);
-                    if (env->ExceptionCheck()) {
-                        env->ExceptionClear();
-                    } else if (jn) {
-                        const char* cn = env->GetStringUTFChars(jn, nullptr);
-                        if (cn) {
-                            screenName = cn;
-                            env->ReleaseStringUTFChars(jn, cn);
-                        } else if (env->ExceptionCheck()) {
-                            env->ExceptionClear();
-                        }
-                        env->DeleteLocalRef(jn);
-                    }
-                }
-                if (cc) env->DeleteLocalRef(cc);
-                env->DeleteLocalRef(cls);
-            }
-            env->DeleteLocalRef(currentScreen);
-        }
-    }
+    jobject list = env->GetObjectField(world, g_playerEntitiesField);
+    if (!list) return;
 
-    std::stringstream ss;
-    ss << "[";
-    constexpr int kEntityJsonCap = 20;
-    const int entityProcessCap = (hideVanillaTags || g_legacyNametagSuppressionActive)
-        ? (std::max)(1, size)
-        : nametagsEnabled
-            ? (std::max)(1, (std::min)(20, nametagMaxCount))
-            : kEntityJsonCap;
-    bool suppressionAppliedThisPass = false;
-    bool suppressionAttemptedThisPass = false;
-    
-    // Get Local Player for distance & health debug
-    jobject player = env->GetObjectField(g_mcInstance, g_thePlayerField);
-    jobject hideScoreboardObj = nullptr;
-    jobject hideTeamObj = nullptr;
+    const bool hideVanillaTags = cfg.hideVanilla;
     if ((hideVanillaTags || g_legacyNametagSuppressionActive) && !EnsureLegacyNametagTeamMappings(env, world) && !g_loggedLegacyNametagSuppressionUnavailable) {
         g_loggedLegacyNametagSuppressionUnavailable = true;
         Log("NametagHideVanilla: legacy team-visibility mappings unresolved; fail-open (vanilla nametags remain visible).");
@@ -5512,6 +5833,8 @@ void RenderNametags(int w, int h) {
         }
         g_legacyNametagSuppressionActive = false;
     }
+    jobject hideScoreboardObj = nullptr;
+    jobject hideTeamObj = nullptr;
     if (hideVanillaTags) {
         hideScoreboardObj = GetLegacyScoreboard(env, world);
         if (hideScoreboardObj) {
@@ -5525,113 +5848,395 @@ void RenderNametags(int w, int h) {
             Log("NametagHideVanilla: legacy scoreboard unavailable; fail-open (vanilla nametags remain visible).");
         }
     }
-    float fallbackYaw = 0.0f;
-    float fallbackPitch = 0.0f;
-    float fallbackFov = 70.0f;
-    
-    double localPX = 0.0, localPY = 0.0, localPZ = 0.0;
-    bool haveLocalPos = false;
-    if (player) {
-        localPX = env->GetDoubleField(player, g_posXField);
-        localPY = env->GetDoubleField(player, g_posYField);
-        localPZ = env->GetDoubleField(player, g_posZField);
-        haveLocalPos = true;
-    }
-    if (!haveLocalPos) {
-        env->DeleteLocalRef(startList);
-        env->DeleteLocalRef(world);
-        goto exit_frame;
-    }
+    snap.suppressing = hideVanillaTags || g_legacyNametagSuppressionActive;
 
-    if (player) {
-        if (g_rotationYawField) {
-            fallbackYaw = env->GetFloatField(player, g_rotationYawField);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); fallbackYaw = 0.0f; }
-        }
-        if (g_rotationPitchField) {
-            fallbackPitch = env->GetFloatField(player, g_rotationPitchField);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); fallbackPitch = 0.0f; }
+    jobject player = env->GetObjectField(g_mcInstance, g_thePlayerField);
+    if (!player || !snap.cam.haveLocal) return;
+    const double localPX = snap.cam.localX, localPY = snap.cam.localY, localPZ = snap.cam.localZ;
+
+    static LegacyPlayerAdapter s_adapter;
+    static std::vector<ScanEngine::PlayerSample> s_players;
+    s_adapter.showArmor = cfg.showArmor;
+    ScanEngine::ListAccess access = { g_listSizeMethod, g_listGetMethod };
+    ScanEngine::WalkOptions opts = { localPX, localPY, localPZ, 0.0 };
+    if (ScanEngine::WalkPlayers(env, s_adapter, list, access, player, opts, s_players) < 0) s_players.clear();
+
+    bool suppressionAppliedThisPass = false;
+    bool suppressionAttemptedThisPass = false;
+    int heldReads = 0;
+
+    for (size_t i = 0; i < s_players.size(); i++) {
+        const ScanEngine::PlayerSample& p = s_players[i];
+        if (hideVanillaTags && hideScoreboardObj && hideTeamObj) {
+            suppressionAttemptedThisPass = true;
+            if (ApplyLegacyVanillaNametagSuppression(env, hideScoreboardObj, hideTeamObj, p.name)) {
+                suppressionAppliedThisPass = true;
+            }
         }
-    }
-    if (g_gameSettingsField && g_fovSettingField) {
-        jobject gs = env->GetObjectField(g_mcInstance, g_gameSettingsField);
-        if (gs) {
-            float fov = env->GetFloatField(gs, g_fovSettingField);
-            if (!env->ExceptionCheck() && fov >= 10.0f && fov <= 170.0f) {
-                fallbackFov = fov;
-            } else if (env->ExceptionCheck()) {
-                env->ExceptionClear();
+
+        double iX = p.lastX + (p.x - p.lastX) * pt;
+        double iY = p.lastY + (p.y - p.lastY) * pt;
+        double iZ = p.lastZ + (p.z - p.lastZ) * pt;
+        double dx = iX - localPX, dy = iY - localPY, dz = iZ - localPZ;
+        double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (dist > 48.0) continue;
+
+        int key = p.key;
+        if (key == 0) key = (int)(iX * 17.0 + iZ * 31.0) ^ p.index;
+
+        std::string heldText;
+        if (cfg.nametags && heldReads < kLegacyHeldItemReads) {
+            heldReads++;
+            jobject entity = env->CallObjectMethod(list, g_listGetMethod, p.index);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); entity = nullptr; }
+            if (entity) {
+                heldText = GetEntityHeldItemInfo(env, entity, nullptr);
+                env->DeleteLocalRef(entity);
             }
-            env->DeleteLocalRef(gs);
         }
+
+        snap.players.emplace_back(LegacyPlayerData{p.name, heldText, iX, iY, iZ, dist, p.health, p.armor, key});
     }
 
-    for (int i = 0; i < size && count < entityProcessCap; i++) {
-        jobject entity = env->CallObjectMethod(startList, g_listGetMethod, i);
-        if (env->ExceptionCheck()) {
-            env->ExceptionClear();
-            break;
-        }
-        if (!entity) continue;
+    int closestIndex = -1;
+    const int nearest = cfg.closestPlayer ? ScanEngine::Nearest(s_players, 96.0) : -1;
+    if (nearest >= 0) {
+        const ScanEngine::PlayerSample& p = s_players[nearest];
+        closestIndex = p.index;
+        LegacyClosestData& c = snap.closest;
+        c.valid = true;
+        c.name = p.name;
+        c.dist = p.dist;
+        c.dx = p.x - localPX;
+        c.dz = p.z - localPZ;
+        c.health = p.health;
+        c.armor = p.armor;
+    }
 
-        if (env->IsSameObject(entity, player)) {
-            env->DeleteLocalRef(entity);
-            continue;
+    if (snap.closest.valid && closestIndex >= 0) {
+        jobject closest = env->CallObjectMethod(list, g_listGetMethod, closestIndex);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); closest = nullptr; }
+        if (closest) {
+            snap.closest.heldItem = GetEntityHeldItemInfo(env, closest, nullptr);
+            env->DeleteLocalRef(closest);
         }
+    }
 
-        // Positions
-        double ex = env->GetDoubleField(entity, g_posXField);
-        double ey = env->GetDoubleField(entity, g_posYField);
-        double ez = env->GetDoubleField(entity, g_posZField);
-        
-        double lx = g_lastTickPosXField ? env->GetDoubleField(entity, g_lastTickPosXField) : ex;
-        double ly = g_lastTickPosYField ? env->GetDoubleField(entity, g_lastTickPosYField) : ey;
-        double lz = g_lastTickPosZField ? env->GetDoubleField(entity, g_lastTickPosZField) : ez;
-
-        // Interpolate
-        double iX = lx + (ex - lx) * pt;
-        double iY = ly + (ey - ly) * pt;
-        double iZ = lz + (ez - lz) * pt;
-        double rX = iX - vX;
-        double rY = iY - vY;
-        double rZ = iZ - vZ;
-
-        // Name with fake/bot line filtering parity
-        std::string displayName = GetStablePlayerName(env, entity);
-        if (displayName.empty() || LooksLikeFakePlayerLine(displayName)) {
-            env->DeleteLocalRef(entity);
-            continue;
+    if (hideTeamObj) env->DeleteLocalRef(hideTeamObj);
+    if (hideScoreboardObj) env->DeleteLocalRef(hideScoreboardObj);
+    if (hideVanillaTags && suppressionAppliedThisPass) {
+        g_legacyNametagSuppressionActive = true;
+    } else if (hideVanillaTags && suppressionAttemptedThisPass && !suppressionAppliedThisPass && !g_loggedLegacyNametagSuppressionUnavailable) {
+        g_loggedLegacyNametagSuppressionUnavailable = true;
+        Log("NametagHideVanilla: legacy player->hide-team assignment failed; fail-open on this runtime.");
+    }
+}
+
+static void CollectLegacyChests(JNIEnv* env, LegacyRenderSnapshot& snap) {
+    TRACE_PATH("enter");
+    static bool warnedChestMappings = false;
+    if (!g_theWorldField || !g_listSizeMethod || !g_listGetMethod ||
+        !g_thePlayerField || !g_posXField || !g_posYField || !g_posZField ||
+        !g_tileEntityPosField || !g_blockPosGetX || !g_blockPosGetY || !g_blockPosGetZ) {
+        TRACE_PATH("missing-core-player-chest-mappings");
+        if (!warnedChestMappings) {
+            warnedChestMappings = true;
+            Log("ChestESP waiting for core/player/chest mappings.");
         }
-        if (hideVanillaTags && hideScoreboardObj && hideTeamObj) {
-            suppressionAttemptedThisPass = true;
-            if (ApplyLegacyVanillaNametagSuppression(env, hideScoreboardObj, hideTeamObj, displayName)) {
-                suppressionAppliedThisPass = true;
-            }
+        return;
+    }
+    if (!g_loadedTileEntityListField) {
+        TRACE_PATH("missing-world-tile-list");
+        if (!warnedChestMappings) {
+            warnedChestMappings = true;
+            Log("ChestESP waiting for JNI world mappings.");
         }
-        
-        // Health
-        float health = 20.0f;
-        if (g_getHealthMethod) {
-            health = env->CallFloatMethod(entity, g_getHealthMethod);
-            if (env->ExceptionCheck()) env->ExceptionClear();
+        return;
+    }
+    warnedChestMappings = false;
+    if (!snap.cam.haveLocal) return;
+
+    LocalFrame frame(env, 256);
+    if (!frame.ok()) return;
+
+    jobject world = env->GetObjectField(g_mcInstance, g_theWorldField);
+    if (!world) return;
+    jobject tileList = env->GetObjectField(world, g_loadedTileEntityListField);
+    if (!tileList) return;
+    int size = env->CallIntMethod(tileList, g_listSizeMethod);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return; }
+
+    // With AokoHelper loaded the chest filter and BlockPos reads run in one
+    // crossing; the JNI walk below is the fallback.
+    static HelperBridge::BlockEntityFrame s_chestFrame;
+    bool usedHelper = false;
+    if (size > 0) {
+        jobject firstTe = nullptr;
+        if (!g_legacyChestKinds) {
+            firstTe = env->CallObjectMethod(tileList, g_listGetMethod, 0);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); firstTe = nullptr; }
+        }
+        usedHelper = (g_legacyChestKinds || EnsureLegacyChestHandles(env, firstTe))
+            && HelperBridge::CollectLegacyTileEntities(env, tileList, g_legacyChestKinds, g_legacyTilePosField,
+                                                       g_legacyBlockPosGet[0], g_legacyBlockPosGet[1],
+                                                       g_legacyBlockPosGet[2], s_chestFrame) == 1;
+        if (firstTe) env->DeleteLocalRef(firstTe);
+    }
+    const int iterCount = usedHelper ? (int)s_chestFrame.records.size() : size;
+
+    for (int i = 0; i < iterCount; i++) {
+        int bx = 0, by = 0, bz = 0;
+        if (usedHelper) {
+            const HelperBridge::BlockEntityRecord& rec = s_chestFrame.records[i];
+            bx = rec.x;
+            by = rec.y;
+            bz = rec.z;
+        } else {
+            jobject te = env->CallObjectMethod(tileList, g_listGetMethod, i);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); break; }
+            if (!te) continue;
+
+            bool isChest = false;
+            if (g_tileEntityChestClass && env->IsInstanceOf(te, g_tileEntityChestClass)) isChest = true;
+            if (!isChest && g_tileEntityEnderChestClass && env->IsInstanceOf(te, g_tileEntityEnderChestClass)) isChest = true;
+            if (!isChest) {
+                jclass teClass = env->GetObjectClass(te);
+                if (teClass) {
+                    std::string clsName = GetClassNameFromClass(env, teClass);
+                    if (clsName.find("Chest") != std::string::npos) isChest = true;
+                    env->DeleteLocalRef(teClass);
+                }
+            }
+            jobject posObj = isChest ? env->GetObjectField(te, g_tileEntityPosField) : nullptr;
+            env->DeleteLocalRef(te);
+            if (!posObj) continue;
+
+            bx = env->CallIntMethod(posObj, g_blockPosGetX);
+            by = env->CallIntMethod(posObj, g_blockPosGetY);
+            bz = env->CallIntMethod(posObj, g_blockPosGetZ);
+            env->DeleteLocalRef(posObj);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); continue; }
         }
 
-        // Project (prefer matrix when stable, otherwise fallback to angle/FOV)
-        float sX = 0, sY = 0;
-        bool matrixProjected = false;
-        float matrixSX = 0, matrixSY = 0;
-        if (matrixProjectionUsable) {
-            matrixProjected = WorldToScreen(rX, rY + 2.3, rZ, view, proj, w, h, matrixSX, matrixSY);
+        double dx = (double)bx + 0.5 - snap.cam.localX;
+        double dy = (double)by + 0.5 - snap.cam.localY;
+        double dz = (double)bz + 0.5 - snap.cam.localZ;
+        double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (dist > 64.0) continue;
+        LegacyChestData c = { bx, by, bz, dist };
+        snap.chests.push_back(c);
+    }
+}
+
+// One scan pass.  Publishes an empty snapshot (once) while no module needs one.
+static void RunLegacyScanPass(JNIEnv* env) {
+    LegacyScanConfig cfg;
+    {
+        LockGuard lk(g_configMutex);
+        cfg.nametags = g_config.nametags;
+        cfg.closestPlayer = g_config.closestPlayerInfo;
+        cfg.chestEsp = g_config.chestEsp;
+        cfg.aimAssist = g_config.aimAssist;
+        cfg.hideVanilla = g_config.nametagHideVanilla;
+        cfg.showHealth = g_config.nametagShowHealth;
+        cfg.showArmor = g_config.nametagShowArmor;
+    }
+    const bool wantPlayers = cfg.nametags || cfg.closestPlayer || cfg.aimAssist || cfg.hideVanilla || g_legacyNametagSuppressionActive;
+    const bool wantChests = cfg.chestEsp;
+
+    static bool s_publishedEmpty = false;
+    if (!(wantPlayers || wantChests) || !g_mapped || !g_mcInstance) {
+        if (!s_publishedEmpty) {
+            g_legacyRenderSnap.Publish(LegacyRenderSnapshot());
+            s_publishedEmpty = true;
         }
+        return;
+    }
+    s_publishedEmpty = false;
 
-        LegoVec3 camPos = { localPX, localPY + 1.62, localPZ };
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    LegacyRenderSnapshot& snap = g_legacyRenderSnap.BeginWrite();
+    snap.cam = LegacyCamState();
+    snap.players.clear();
+    snap.suppressing = false;
+    snap.closest = LegacyClosestData();
+    snap.chests.clear();
 
-        bool projected = false;
-        if (matrixProjected) {
-            sX = matrixSX;
-            sY = matrixSY;
-            projected = true;
+    float pt = 1.0f;
+    {
+        static const int s_jniAcct = JniAccounting::Register("camera", 200);
+        JniAccounting::Scope jniAcct(env, s_jniAcct);
+        TryResolveScreenFieldDirect(env);
+        TryResolvePlayerCoreMappings(env);
+        if (wantChests) TryResolveChestEspMappings(env);
+        TryResolveWorldMappings(env);
+        TryResolveRenderMappings(env, false);
+        pt = ReadLegacyCamState(env, snap.cam);
+    }
+    if (wantPlayers) {
+        static const int s_jniAcct = JniAccounting::Register("nametags", 3000);
+        JniAccounting::Scope jniAcct(env, s_jniAcct);
+        CollectLegacyPlayers(env, cfg, pt, snap);
+    }
+    if (wantChests) {
+        static const int s_jniAcct = JniAccounting::Register("chestEsp", 10000);
+        JniAccounting::Scope jniAcct(env, s_jniAcct);
+        CollectLegacyChests(env, snap);
+    }
+    g_legacyRenderSnap.Commit();
+    g_legacyRenderSnapMs = GetTickCount();
+}
+
+static DWORD WINAPI LegacyScanThreadProc(LPVOID) {
+    ThreadPolicy::Apply(ThreadPolicy::ROLE_SCAN, "scan");
+    JNIEnv* env = nullptr;
+    JavaVMAttachArgs args;
+    args.version = JNI_VERSION_1_8; args.name = (char*)"LegoBridgeScan"; args.group = nullptr;
+    if (!g_jvm || g_jvm->AttachCurrentThread((void**)&env, &args) != JNI_OK) return 1;
+    DWORD statsStartMs = GetTickCount();
+    unsigned long passes = 0;
+    while (g_running) {
+        if (g_legacyScanWake) WaitForSingleObject(g_legacyScanWake, kLegacyScanMaxGapMs);
+        else Sleep(kLegacyScanMaxGapMs);
+        {
+            LockGuard jniLk(g_scanJniMutex);
+            if (!g_running) break;
+            RunLegacyScanPass(env);
         }
+        passes++;
+
+        DWORD nowMs = GetTickCount();
+        if (nowMs - statsStartMs >= 30000) {
+            Log("ScanThread: " + std::to_string(passes) + " passes in " + std::to_string(nowMs - statsStartMs) + " ms, players " + ScanEngine::FormatStats());
+            ScanEngine::ResetStats();
+            statsStartMs = nowMs;
+            passes = 0;
+        }
+    }
+    g_jvm->DetachCurrentThread();
+    return 0;
+}
+
+static void StartLegacyScanThread() {
+    if (g_legacyScanThread) return;
+    if (!g_legacyScanWake) g_legacyScanWake = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    g_legacyScanThread = CreateThread(nullptr, 0, LegacyScanThreadProc, nullptr, 0, nullptr);
+    if (!g_legacyScanThread) Log("ERROR: scan thread not started (err=" + std::to_string(GetLastError()) + ")");
+}
+
+// Called once g_running is false.
+static void StopLegacyScanThread() {
+    if (!g_legacyScanThread) return;
+    if (g_legacyScanWake) SetEvent(g_legacyScanWake);
+    if (WaitForSingleObject(g_legacyScanThread, 2000) != WAIT_OBJECT_0) Log("WARNING: scan thread did not exit within 2000 ms");
+    CloseHandle(g_legacyScanThread);
+    g_legacyScanThread = nullptr;
+}
+
+// Picks the projection for this frame: the snapshot's ActiveRenderInfo
+// matrices, else the GL matrices captured at the top of this SwapBuffers.
+static bool SelectLegacyProjection(const LegacyCamState& cam, Matrix4x4& view, Matrix4x4& proj, bool& usedCaptured) {
+    usedCaptured = false;
+    if (cam.matsOk) {
+        view = cam.view;
+        proj = cam.proj;
+        return true;
+    }
+    if (!TryUseCapturedRenderMatrices(view, proj)) return false;
+    if (IsLikelyUiOrthoMatrix(view, proj)) return false;
+    usedCaptured = true;
+    return true;
+}
+
+void RenderNametags(int w, int h) {
+    TRACE_PATH("enter");
+    bool showHealth = true;
+    bool showArmor = true;
+    bool nametagsEnabled = false;
+    bool entityTelemetryNeeded = false;
+    int nametagMaxCount = 8;
+    {
+         LockGuard lk(g_configMutex);
+         nametagsEnabled = g_config.nametags;
+         entityTelemetryNeeded = g_config.nametags || g_config.closestPlayerInfo || g_config.aimAssist || g_config.nametagHideVanilla;
+         TRACE_BRANCH("entityTelemetryNeeded", entityTelemetryNeeded);
+          if (!entityTelemetryNeeded) return;
+         showHealth = g_config.nametagShowHealth;
+         showArmor = g_config.nametagShowArmor;
+         nametagMaxCount = (std::max)(1, (std::min)(20, g_config.nametagMaxCount));
+    }
+
+    // Default to empty telemetry each run so stale entities are not reused.
+    {
+        LockGuard lk(g_jsonMutex);
+        g_pendingJson = "[]";
+    }
+
+    LegacyRenderRef snap = AcquireLegacyRenderSnap();
+    const LegacyCamState& cam = snap->cam;
+    TRACE_BRANCH("snapshotHasLocal", cam.haveLocal);
+    if (!cam.haveLocal) return;
+    g_tagFrameCounter++;
+
+    // Ensure C locale for dot decimals
+    setlocale(LC_NUMERIC, "C");
+
+    Matrix4x4 view = {}, proj = {};
+    bool usedCapturedMatrices = false;
+    bool matrixProjectionUsable = SelectLegacyProjection(cam, view, proj, usedCapturedMatrices);
+    TRACE_BRANCH("matrixProjectionUsable", matrixProjectionUsable);
+
+    static int logctr = 0;
+    static bool loggedCapturedMatrixFallback = false;
+    if (logctr++ % 600 == 0) {
+         Log("Matrix Debug - View[0]: " + std::to_string(view.m[0]) + " Proj[0]: " + std::to_string(proj.m[0]));
+         if (!matrixProjectionUsable) Log("WARNING: Matrix projection unavailable.");
+         if (usedCapturedMatrices && !loggedCapturedMatrixFallback) {
+             loggedCapturedMatrixFallback = true;
+             Log("Nametags using captured GL matrix fallback.");
+         }
+         Log("Entity List Size: " + std::to_string(snap->players.size()));
+    }
+
+    const double vX = cam.viewerX, vY = cam.viewerY, vZ = cam.viewerZ;
+    std::stringstream ss;
+    ss << "[";
+    constexpr int kEntityJsonCap = 20;
+    const int entityProcessCap = snap->suppressing
+        ? (std::max)(1, (int)snap->players.size())
+        : nametagsEnabled
+            ? nametagMaxCount
+            : kEntityJsonCap;
+    int count = 0;
+
+    // The snapshot is in world-list order.  Players whose body and tag are
+    // outside the view frustum are dropped before anything is projected, and
+    // the nearest entityProcessCap of the rest are walked nearest first.
+    struct TagCandidate { double dist; size_t index; };
+    static std::vector<TagCandidate> s_tagPick;   // render thread only; keeps capacity
+    s_tagPick.clear();
+    if (matrixProjectionUsable) {
+        Frustum::Planes frustum;
+        Frustum::FromViewProj(frustum, vX, vY, vZ, view.m, proj.m, kLegacyNearW);
+        for (size_t i = 0; i < snap->players.size(); i++) {
+            const LegacyPlayerData& p = snap->players[i];
+            if (!Frustum::BoxVisible(frustum, p.x - 0.6, p.y, p.z - 0.6, p.x + 0.6, p.y + 2.8, p.z + 0.6)) continue;
+            TagCandidate c = { p.dist, i };
+            s_tagPick.push_back(c);
+        }
+        s_tagPick.resize(Frustum::SelectNearest(s_tagPick, (size_t)entityProcessCap,
+            [](const TagCandidate& a, const TagCandidate& b) { return a.dist < b.dist; }));
+    }
+
+    for (size_t k = 0; k < s_tagPick.size() && count < entityProcessCap; k++) {
+        const LegacyPlayerData& p = snap->players[s_tagPick[k].index];
+        const std::string& displayName = p.name;
+        const double iX = p.x, iY = p.y, iZ = p.z;
+        const double dist = p.dist;
+        const float health = p.health;
+
+        float sX = 0, sY = 0;
+        bool projected = WorldToScreen(iX - vX, iY + 2.3 - vY, iZ - vZ, view, proj, w, h, sX, sY);
         // Do not use angle/FOV fallback here. On 1.8.9 this path can be misaligned and causes ghost tracking.
 
         // Aim-assist target point: closest projected point on a player body box
@@ -5657,22 +6262,8 @@ void RenderNametags(int w, int h) {
                     for (double zo : zOffsets) {
                         float tx = 0.0f;
                         float ty = 0.0f;
-                        bool sampleProjected = false;
-
-                        if (matrixProjectionUsable) {
-                            sampleProjected = WorldToScreen(
-                                (iX + xo) - vX,
-                                (iY + yo) - vY,
-                                (iZ + zo) - vZ,
-                                view,
-                                proj,
-                                w,
-                                h,
-                                tx,
-                                ty);
-                        }
-
-                        if (!sampleProjected) continue;
+                        if (!WorldToScreen((iX + xo) - vX, (iY + yo) - vY, (iZ + zo) - vZ,
+                                           view, proj, w, h, tx, ty)) continue;
 
                         double dxCenter = tx - centerX;
                         double dyCenter = ty - centerY;
@@ -5694,216 +6285,158 @@ void RenderNametags(int w, int h) {
             }
         }
 
-        if (projected) {
-             if (logctr % 600 == 0 && count == 0) {
-                 Log("Tagged: " + displayName + " SX: " + std::to_string(sX) + " SY: " + std::to_string(sY));
-             }
-             double dx = iX - localPX;
-             double dy = iY - localPY;
-             double dz = iZ - localPZ;
-             double dist = sqrt(dx*dx + dy*dy + dz*dz);
-             if (dist > 48.0) {
-                 env->DeleteLocalRef(entity);
-                 continue;
-             }
-             if (sX < -64.0f || sX > (float)w + 64.0f || sY < -64.0f || sY > (float)h + 64.0f) {
-                 env->DeleteLocalRef(entity);
-                 continue;
-             }
-              if (!displayName.empty()) {
-                  float hpClampedSimple = health < 0 ? 0 : (health > 40 ? 40 : health);
-
-                   if (!nametagsEnabled) {
-                       if (count < kEntityJsonCap) {
-                           if (count > 0) ss << ",";
-                           ss << "{";
-                           ss << "\"sx\":" << (aimProjected ? aimSX : sX) << ",";
-                           ss << "\"sy\":" << (aimProjected ? aimSY : sY) << ",";
-                           ss << "\"dist\":" << dist << ",";
-                           ss << "\"name\":\"" << JsonEscape(displayName) << "\",";
-                           ss << "\"hp\":" << hpClampedSimple;
-                           ss << "}";
-                      }
-                      count++;
-                      if (count >= entityProcessCap) {
-                          env->DeleteLocalRef(entity);
-                          break;
-                      }
-                      continue;
-                  }
-
-                 float hpClamped = health < 0 ? 0 : (health > 40 ? 40 : health);
-                 float hpBarValue = health < 0 ? 0 : (health > 20 ? 20 : health);
-                 float hpPct = hpBarValue / 20.0f;
-                 if (hpPct < 0.0f) hpPct = 0.0f;
-                 if (hpPct > 1.0f) hpPct = 1.0f;
-
-                 int armorPoints = -1;
-                 if (showArmor && g_getTotalArmorValueMethod) {
-                     armorPoints = env->CallIntMethod(entity, g_getTotalArmorValueMethod);
-                     if (env->ExceptionCheck()) { env->ExceptionClear(); armorPoints = -1; }
-                 }
+        if (!projected) continue;
+        if (logctr % 600 == 1 && count == 0) {
+            Log("Tagged: " + displayName + " SX: " + std::to_string(sX) + " SY: " + std::to_string(sY));
+        }
+        if (sX < -64.0f || sX > (float)w + 64.0f || sY < -64.0f || sY > (float)h + 64.0f) continue;
 
-                 std::string statsText;
-                 if (showHealth) {
-                     char hpBuf[32];
-                     snprintf(hpBuf, sizeof(hpBuf), "%.0f HP", hpClamped);
-                     statsText += hpBuf;
-                 }
-                 if (showArmor && armorPoints >= 0) {
-                     if (!statsText.empty()) statsText += " | ";
-                     char armorBuf[32];
-                     snprintf(armorBuf, sizeof(armorBuf), "%d ARM", armorPoints);
-                     statsText += armorBuf;
-                 }
+        float hpClamped = health < 0 ? 0 : (health > 40 ? 40 : health);
+        if (!nametagsEnabled) {
+            if (count < kEntityJsonCap) {
+                if (count > 0) ss << ",";
+                ss << "{";
+                ss << "\"sx\":" << (aimProjected ? aimSX : sX) << ",";
+                ss << "\"sy\":" << (aimProjected ? aimSY : sY) << ",";
+                ss << "\"dist\":" << dist << ",";
+                ss << "\"name\":\"" << JsonEscape(displayName) << "\",";
+                ss << "\"hp\":" << hpClamped;
+                ss << "}";
+            }
+            count++;
+            continue;
+        }
 
-                 std::string heldText = GetEntityHeldItemInfo(env, entity, nullptr);
+        float hpBarValue = health < 0 ? 0 : (health > 20 ? 20 : health);
+        float hpPct = hpBarValue / 20.0f;
+        if (hpPct < 0.0f) hpPct = 0.0f;
+        if (hpPct > 1.0f) hpPct = 1.0f;
+
+        const int armorPoints = showArmor ? p.armor : -1;
+        std::string statsText;
+        if (showHealth) {
+            char hpBuf[32];
+            snprintf(hpBuf, sizeof(hpBuf), "%.0f HP", hpClamped);
+            statsText += hpBuf;
+        }
+        if (showArmor && armorPoints >= 0) {
+            if (!statsText.empty()) statsText += " | ";
+            char armorBuf[32];
+            snprintf(armorBuf, sizeof(armorBuf), "%d ARM", armorPoints);
+            statsText += armorBuf;
+        }
+        const std::string& heldText = p.heldItem;
+        const int key = p.key;
+
+        auto calcTextScaled = [](const char* text, float fontSize) -> ImVec2 {
+            ImVec2 sz = ImGui::CalcTextSize(text ? text : "");
+            float base = ImGui::GetFontSize();
+            if (base <= 0.0f) base = 16.0f;
+            float scale = fontSize / base;
+            sz.x *= scale;
+            sz.y *= scale;
+            return sz;
+        };
 
-                 int key = 0;
-                 if (g_objectHashCodeMethod) {
-                     key = env->CallIntMethod(entity, g_objectHashCodeMethod);
-                     if (env->ExceptionCheck()) { env->ExceptionClear(); key = 0; }
-                 }
-                 if (key == 0) {
-                     key = (int)(iX * 17.0 + iZ * 31.0) ^ i;
-                 }
+        float nameScale = 1.0f - (float)(dist / 64.0);
+        if (nameScale < 0.65f) nameScale = 0.65f;
+        if (nameScale > 1.0f) nameScale = 1.0f;
+        const float nameFontSize = std::floor(ImGui::GetFontSize() * nameScale);
+        const float infoFontSize = std::floor(nameFontSize * 0.85f);
+
+        ImVec2 nameSz = calcTextScaled(displayName.c_str(), nameFontSize);
+        ImVec2 statsSz = statsText.empty() ? ImVec2(0, 0) : calcTextScaled(statsText.c_str(), infoFontSize);
+        ImVec2 itemSz = heldText.empty() ? ImVec2(0, 0) : calcTextScaled(heldText.c_str(), infoFontSize);
+
+        float maxW = (std::max)(nameSz.x, (std::max)(statsSz.x, itemSz.x));
+        float totalH = nameSz.y;
+        if (statsSz.y > 0.0f) totalH += statsSz.y + 2.0f;
+        if (itemSz.y > 0.0f) totalH += itemSz.y + 2.0f;
+
+        float pad = std::floor(4.0f * nameScale);
+        float px = std::floor(sX - maxW * 0.5f) - pad;
+        float py = std::floor(sY - totalH - pad * 2.0f);
+        TagSmoothingState& smooth = g_tagSmoothing[g_tagSmoothing.Touch((unsigned)key, (unsigned)g_tagFrameCounter)];
+        if (!smooth.init) {
+            smooth.x = px;
+            smooth.y = py;
+            smooth.vx = 0.0f;
+            smooth.vy = 0.0f;
+            smooth.init = true;
+        }
+        else {
+            float dxs = px - smooth.x;
+            float dys = py - smooth.y;
+            float deltaSq = dxs * dxs + dys * dys;
+
+            if (deltaSq > 24000.0f) {
+                smooth.x = px;
+                smooth.y = py;
+                smooth.vx = 0.0f;
+                smooth.vy = 0.0f;
+            }
+            else {
+                float blend = 0.12f;
+                if (dist < 12.0) blend = 0.14f;
+                if (deltaSq < 6.0f) blend = 0.22f;
+                smooth.x += dxs * blend;
+                smooth.y += dys * blend;
+            }
+        }
+        px = smooth.x;
+        py = smooth.y;
 
-                 auto calcTextScaled = [](const char* text, float fontSize) -> ImVec2 {
-                     ImVec2 sz = ImGui::CalcTextSize(text ? text : "");
-                     float base = ImGui::GetFontSize();
-                     if (base <= 0.0f) base = 16.0f;
-                     float scale = fontSize / base;
-                     sz.x *= scale;
-                     sz.y *= scale;
-                     return sz;
-                 };
-
-                 float nameScale = 1.0f - (float)(dist / 64.0);
-                 if (nameScale < 0.65f) nameScale = 0.65f;
-                 if (nameScale > 1.0f) nameScale = 1.0f;
-                 const float nameFontSize = std::floor(ImGui::GetFontSize() * nameScale);
-                 const float infoFontSize = std::floor(nameFontSize * 0.85f);
-
-                 ImVec2 nameSz = calcTextScaled(displayName.c_str(), nameFontSize);
-                 ImVec2 statsSz = statsText.empty() ? ImVec2(0, 0) : calcTextScaled(statsText.c_str(), infoFontSize);
-                 ImVec2 itemSz = heldText.empty() ? ImVec2(0, 0) : calcTextScaled(heldText.c_str(), infoFontSize);
-
-                 float maxW = (std::max)(nameSz.x, (std::max)(statsSz.x, itemSz.x));
-                 float totalH = nameSz.y;
-                 if (statsSz.y > 0.0f) totalH += statsSz.y + 2.0f;
-                 if (itemSz.y > 0.0f) totalH += itemSz.y + 2.0f;
-
-                 float pad = std::floor(4.0f * nameScale);
-                 float px = std::floor(sX - maxW * 0.5f) - pad;
-                 float py = std::floor(sY - totalH - pad * 2.0f);
-                 auto& smooth = g_tagSmoothing[key];
-                 if (!smooth.init) {
-                     smooth.x = px;
-                     smooth.y = py;
-                     smooth.vx = 0.0f;
-                     smooth.vy = 0.0f;
-                     smooth.init = true;
-                 }
-                 else {
-                     float dxs = px - smooth.x;
-                     float dys = py - smooth.y;
-                     float deltaSq = dxs * dxs + dys * dys;
-
-                     if (deltaSq > 24000.0f) {
-                         smooth.x = px;
-                         smooth.y = py;
-                         smooth.vx = 0.0f;
-                         smooth.vy = 0.0f;
-                     }
-                     else {
-                         float blend = 0.12f;
-                         if (dist < 12.0) blend = 0.14f;
-                         if (deltaSq < 6.0f) blend = 0.22f;
-                         smooth.x += dxs * blend;
-                         smooth.y += dys * blend;
-                     }
-                 }
-                 smooth.lastFrame = g_tagFrameCounter;
-                 px = smooth.x;
-                 py = smooth.y;
-
-                 ImDrawList* fg = ImGui::GetForegroundDrawList();
-                 ImVec2 pMin(px, py);
-                 ImVec2 pMax(px + maxW + pad * 2.0f, py + totalH + pad * 2.0f + 2.0f);
-                 fg->AddRectFilled(pMin, pMax, IM_COL32(0, 0, 0, 160), 3.0f);
-
-                 float curY = py + pad;
-                 float centerX = px + (maxW + pad * 2.0f) * 0.5f;
-                 float nameX = std::floor(centerX - nameSz.x * 0.5f);
-                 fg->AddText(ImGui::GetFont(), nameFontSize, ImVec2(nameX + 1, curY + 1), IM_COL32(0, 0, 0, 255), displayName.c_str());
-                 fg->AddText(ImGui::GetFont(), nameFontSize, ImVec2(nameX, curY), IM_COL32(255, 255, 255, 250), displayName.c_str());
-                 curY += nameSz.y + 2.0f;
-
-                 if (!statsText.empty()) {
-                     float statsX = std::floor(centerX - statsSz.x * 0.5f);
-                     ImU32 statCol = hpClamped <= 8.0f ? IM_COL32(255, 100, 100, 250) : IM_COL32(200, 220, 255, 250);
-                     fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(statsX + 1, curY + 1), IM_COL32(0, 0, 0, 255), statsText.c_str());
-                     fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(statsX, curY), statCol, statsText.c_str());
-                     curY += statsSz.y + 2.0f;
-                 }
+        ImDrawList* fg = ImGui::GetForegroundDrawList();
+        ImVec2 pMin(px, py);
+        ImVec2 pMax(px + maxW + pad * 2.0f, py + totalH + pad * 2.0f + 2.0f);
+        fg->AddRectFilled(pMin, pMax, IM_COL32(0, 0, 0, 160), 3.0f);
 
-                 if (!heldText.empty()) {
-                     float heldX = std::floor(centerX - itemSz.x * 0.5f);
-                     fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(heldX + 1, curY + 1), IM_COL32(0, 0, 0, 255), heldText.c_str());
-                     fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(heldX, curY), IM_COL32(255, 200, 80, 250), heldText.c_str());
-                 }
+        float curY = py + pad;
+        float centerX = px + (maxW + pad * 2.0f) * 0.5f;
+        float nameX = std::floor(centerX - nameSz.x * 0.5f);
+        fg->AddText(ImGui::GetFont(), nameFontSize, ImVec2(nameX + 1, curY + 1), IM_COL32(0, 0, 0, 255), displayName.c_str());
+        fg->AddText(ImGui::GetFont(), nameFontSize, ImVec2(nameX, curY), IM_COL32(255, 255, 255, 250), displayName.c_str());
+        curY += nameSz.y + 2.0f;
 
-                 if (showHealth) {
-                     float barW = (pMax.x - pMin.x) * hpPct;
-                     ImU32 hpCol = IM_COL32((int)(255 * (1.0f - hpPct)), (int)(220 * hpPct + 35), 60, 255);
-                     fg->AddRectFilled(ImVec2(pMin.x, pMax.y),
-                                       ImVec2(pMin.x + barW, pMax.y + std::floor(3.0f * nameScale)), hpCol);
-                 }
-                 if (count < kEntityJsonCap) {
-                     if (count > 0) ss << ",";
-                     ss << "{";
-                     ss << "\"sx\":" << (aimProjected ? aimSX : sX) << ",";
-                     ss << "\"sy\":" << (aimProjected ? aimSY : sY) << ",";
-                     ss << "\"dist\":" << dist << ",";
-                     ss << "\"name\":\"" << JsonEscape(displayName) << "\",";
-                     ss << "\"hp\":" << hpClamped;
-                     ss << "}";
-                 }
+        if (!statsText.empty()) {
+            float statsX = std::floor(centerX - statsSz.x * 0.5f);
+            ImU32 statCol = hpClamped <= 8.0f ? IM_COL32(255, 100, 100, 250) : IM_COL32(200, 220, 255, 250);
+            fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(statsX + 1, curY + 1), IM_COL32(0, 0, 0, 255), statsText.c_str());
+            fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(statsX, curY), statCol, statsText.c_str());
+            curY += statsSz.y + 2.0f;
+        }
 
-                  count++;
-                  if (count >= entityProcessCap) {
-                      env->DeleteLocalRef(entity);
-                      break;
-                  }
-             }
+        if (!heldText.empty()) {
+            float heldX = std::floor(centerX - itemSz.x * 0.5f);
+            fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(heldX + 1, curY + 1), IM_COL32(0, 0, 0, 255), heldText.c_str());
+            fg->AddText(ImGui::GetFont(), infoFontSize, ImVec2(heldX, curY), IM_COL32(255, 200, 80, 250), heldText.c_str());
         }
 
-        env->DeleteLocalRef(entity);
-    }
-    if (hideTeamObj) env->DeleteLocalRef(hideTeamObj);
-    if (hideScoreboardObj) env->DeleteLocalRef(hideScoreboardObj);
-    if (hideVanillaTags && suppressionAppliedThisPass) {
-        g_legacyNametagSuppressionActive = true;
-    } else if (hideVanillaTags && suppressionAttemptedThisPass && !suppressionAppliedThisPass && !g_loggedLegacyNametagSuppressionUnavailable) {
-        g_loggedLegacyNametagSuppressionUnavailable = true;
-        Log("NametagHideVanilla: legacy player->hide-team assignment failed; fail-open on this runtime.");
-    }
-    
-    // Cleanup stale smoothing state
-    for (auto it = g_tagSmoothing.begin(); it != g_tagSmoothing.end(); ) {
-        if (g_tagFrameCounter - it->second.lastFrame > 45) {
-            it = g_tagSmoothing.erase(it);
-        } else {
-            ++it;
+        if (showHealth) {
+            float barW = (pMax.x - pMin.x) * hpPct;
+            ImU32 hpCol = IM_COL32((int)(255 * (1.0f - hpPct)), (int)(220 * hpPct + 35), 60, 255);
+            fg->AddRectFilled(ImVec2(pMin.x, pMax.y),
+                              ImVec2(pMin.x + barW, pMax.y + std::floor(3.0f * nameScale)), hpCol);
         }
+        if (count < kEntityJsonCap) {
+            if (count > 0) ss << ",";
+            ss << "{";
+            ss << "\"sx\":" << (aimProjected ? aimSX : sX) << ",";
+            ss << "\"sy\":" << (aimProjected ? aimSY : sY) << ",";
+            ss << "\"dist\":" << dist << ",";
+            ss << "\"name\":\"" << JsonEscape(displayName) << "\",";
+            ss << "\"hp\":" << hpClamped;
+            ss << "}";
+        }
+        count++;
     }
 
+    // Cleanup stale smoothing state
+    g_tagSmoothing.Expire((unsigned)g_tagFrameCounter, 45);
+
     // Close entities array
     ss << "]";
 
-    env->DeleteLocalRef(startList);
-    env->DeleteLocalRef(world);
-
     // Store entities JSON for ServerLoop injection
     {
         std::string json = ss.str();
@@ -5912,9 +6445,6 @@ void RenderNametags(int w, int h) {
             g_pendingJson = json;
         }
     }
-    
-exit_frame:
-    env->PopLocalFrame(nullptr);
 }
 
 void RenderClosestPlayerInfo(int w, int h) {
@@ -5928,111 +6458,19 @@ void RenderClosestPlayerInfo(int w, int h) {
         showArmor = g_config.nametagShowArmor;
     }
     if (!enabled) return;
-    if (!g_mapped || !g_mcInstance || !g_theWorldField || !g_listSizeMethod || !g_listGetMethod) return;
-    if (!g_thePlayerField || !g_posXField || !g_posYField || !g_posZField) return;
-
-    ScopedJNIEnv env(g_jvm);
-    if (!env) return;
-
-    TryResolveWorldMappings(env);
-    if (!g_playerEntitiesField) return;
-
-    if (env->ExceptionCheck()) { env->ExceptionClear(); return; }
-    if (env->PushLocalFrame(256) < 0) { env->ExceptionClear(); return; }
-
-    auto finish = [&]() {
-        env->PopLocalFrame(nullptr);
-    };
-
-    jobject world = env->GetObjectField(g_mcInstance, g_theWorldField);
-    if (!world) { finish(); return; }
-    jobject list = env->GetObjectField(world, g_playerEntitiesField);
-    if (!list) { finish(); return; }
-
-    jobject localPlayer = env->GetObjectField(g_mcInstance, g_thePlayerField);
-    if (!localPlayer) { finish(); return; }
-
-    double lpx = env->GetDoubleField(localPlayer, g_posXField);
-    double lpy = env->GetDoubleField(localPlayer, g_posYField);
-    double lpz = env->GetDoubleField(localPlayer, g_posZField);
-    float localYaw = 0.0f;
-    if (g_rotationYawField) localYaw = env->GetFloatField(localPlayer, g_rotationYawField);
-
-    int size = env->CallIntMethod(list, g_listSizeMethod);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); finish(); return; }
-
-    int closestIndex = -1;
-    double bestDist = 99999.0;
-    double bestDx = 0.0, bestDz = 0.0;
-
-    for (int i = 0; i < size; i++) {
-        jobject entity = env->CallObjectMethod(list, g_listGetMethod, i);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); break; }
-        if (!entity) continue;
-        if (env->IsSameObject(entity, localPlayer)) { env->DeleteLocalRef(entity); continue; }
-
-        double ex = env->GetDoubleField(entity, g_posXField);
-        double ey = env->GetDoubleField(entity, g_posYField);
-        double ez = env->GetDoubleField(entity, g_posZField);
-        double dx = ex - lpx;
-        double dy = ey - lpy;
-        double dz = ez - lpz;
-        double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
-        if (dist < bestDist) {
-            std::string candidateName = GetStablePlayerName(env, entity);
-            if (!candidateName.empty() && !LooksLikeFakePlayerLine(candidateName)) {
-                bestDist = dist;
-                closestIndex = i;
-                bestDx = dx;
-                bestDz = dz;
-            }
-        }
-
-        env->DeleteLocalRef(entity);
-    }
-
-    if (closestIndex < 0 || bestDist > 96.0) { finish(); return; }
 
-    jobject closest = env->CallObjectMethod(list, g_listGetMethod, closestIndex);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); finish(); return; }
-    if (!closest) { finish(); return; }
+    LegacyRenderRef snap = AcquireLegacyRenderSnap();
+    const LegacyClosestData& closest = snap->closest;
+    if (!closest.valid || !snap->cam.haveLocal) return;
 
-    std::string name = GetStablePlayerName(env, closest);
-    if (name.empty() || LooksLikeFakePlayerLine(name)) {
-        finish();
-        return;
-    }
-
-    float health = 20.0f;
-    if (showHealth && g_getHealthMethod) {
-        health = env->CallFloatMethod(closest, g_getHealthMethod);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); health = 20.0f; }
-    }
-
-    int armorPoints = -1;
-    if (showArmor && g_getTotalArmorValueMethod) {
-        armorPoints = env->CallIntMethod(closest, g_getTotalArmorValueMethod);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); armorPoints = -1; }
-    }
-
-    std::string heldText = GetEntityHeldItemInfo(env, closest, nullptr);
-
-    std::string statsText;
-    if (showHealth) {
-        char hp[24];
-        float hpClamped = health < 0 ? 0 : (health > 40 ? 40 : health);
-        snprintf(hp, sizeof(hp), "%.0f HP", hpClamped);
-        statsText += hp;
-    }
-    if (showArmor && armorPoints >= 0) {
-        if (!statsText.empty()) statsText += " | ";
-        char ar[24];
-        snprintf(ar, sizeof(ar), "%d ARM", armorPoints);
-        statsText += ar;
-    }
+    const std::string& name = closest.name;
+    const float health = showHealth ? closest.health : 20.0f;
+    const int armorPoints = showArmor ? closest.armor : -1;
+    const std::string& heldText = closest.heldItem;
+    const double bestDist = closest.dist;
 
     char dirArrow = '^';
-    std::string dirText = RelativeDirectionText(localYaw, bestDx, bestDz);
+    std::string dirText = RelativeDirectionText(snap->cam.localYaw, closest.dx, closest.dz);
     if (dirText == "Back") dirArrow = 'v';
     else if (dirText == "Left") dirArrow = '<';
     else if (dirText == "Right") dirArrow = '>';
@@ -6103,13 +6541,10 @@ void RenderClosestPlayerInfo(int w, int h) {
         ImU32 sCol = health <= 6.0f ? IM_COL32(255, 100, 100, 240) : IM_COL32(160, 200, 255, 230);
         fg->AddText(ImGui::GetFont(), smallSz, ImVec2(stx, curY), sCol, statsRow.c_str());
     }
-
-    finish();
 }
 
 void RenderChestESP(int w, int h) {
     TRACE_PATH("enter");
-    static bool warnedChestMappings = false;
     int chestEspMaxCount = 5;
     {
         LockGuard lk(g_configMutex);
@@ -6117,189 +6552,51 @@ void RenderChestESP(int w, int h) {
         if (!g_config.chestEsp) return;
         chestEspMaxCount = (std::max)(1, (std::min)(20, g_config.chestEspMaxCount));
     }
-    bool mappedReady = (g_mapped && g_mcInstance);
-    TRACE_BRANCH("mappedReady", mappedReady);
-    if (!mappedReady) return;
-
-    ScopedJNIEnv env(g_jvm);
-    TRACE_BRANCH("jniEnvAvailable", env != nullptr);
-    if (!env) return;
-
-    TryResolveScreenFieldDirect(env);
-    TryResolvePlayerCoreMappings(env);
-    TryResolveChestEspMappings(env);
-    TryResolveWorldMappings(env);
-    TryResolveRenderMappings(env, false);
-
-    if (!g_theWorldField || !g_listSizeMethod || !g_listGetMethod ||
-        !g_thePlayerField || !g_posXField || !g_posYField || !g_posZField ||
-        !g_tileEntityPosField || !g_blockPosGetX || !g_blockPosGetY || !g_blockPosGetZ) {
-        TRACE_PATH("missing-core-player-chest-mappings");
-        if (!warnedChestMappings) {
-            warnedChestMappings = true;
-            Log("ChestESP waiting for core/player/chest mappings.");
-        }
-        return;
-    }
-
-    if (!g_loadedTileEntityListField) {
-        TRACE_PATH("missing-world-tile-list");
-        if (!warnedChestMappings) {
-            warnedChestMappings = true;
-            Log("ChestESP waiting for JNI world mappings.");
-        }
-        return;
-    }
-    if (!g_activeRenderInfoClass || !g_modelViewField || !g_projectionField) {
-        TRACE_PATH("missing-render-mappings");
-        if (!warnedChestMappings) {
-            warnedChestMappings = true;
-            Log("ChestESP waiting for render mappings.");
-        }
-        return;
-    }
-
-    warnedChestMappings = false;
 
-    if (env->ExceptionCheck()) { env->ExceptionClear(); return; }
-    if (env->PushLocalFrame(256) < 0) { env->ExceptionClear(); return; }
+    LegacyRenderRef snap = AcquireLegacyRenderSnap();
+    if (snap->chests.empty()) return;
 
-    Matrix4x4 view = GetMatrix(env, g_modelViewField);
-    Matrix4x4 proj = GetMatrix(env, g_projectionField);
-    bool matrixProjectionUsable = MatrixProjectionUsable(view, proj);
-    TRACE_BRANCH("matrixProjectionUsableInitial", matrixProjectionUsable);
+    Matrix4x4 view = {}, proj = {};
     bool usedCapturedMatrices = false;
-    if (!matrixProjectionUsable) {
-        TRACE_PATH("matrix-fallback-captured");
-        usedCapturedMatrices = TryUseCapturedRenderMatrices(view, proj);
-        matrixProjectionUsable = usedCapturedMatrices;
-    }
-    TRACE_BRANCH("matrixProjectionUsableAfterFallback", matrixProjectionUsable);
+    bool matrixProjectionUsable = SelectLegacyProjection(snap->cam, view, proj, usedCapturedMatrices);
+    TRACE_BRANCH("matrixProjectionUsable", matrixProjectionUsable);
     static bool loggedChestCapturedMatrixFallback = false;
-    static bool loggedChestUiMatrixReject = false;
     if (usedCapturedMatrices && !loggedChestCapturedMatrixFallback) {
         loggedChestCapturedMatrixFallback = true;
         Log("ChestESP using captured GL matrix fallback.");
     }
-    if (matrixProjectionUsable && IsLikelyUiOrthoMatrix(view, proj)) {
-        TRACE_PATH("matrix-ui-ortho-rebind-attempt");
-        TryResolveRenderMappings(env, false);
-        view = GetMatrix(env, g_modelViewField);
-        proj = GetMatrix(env, g_projectionField);
-        matrixProjectionUsable = MatrixProjectionUsable(view, proj);
-        usedCapturedMatrices = false;
-        if (!matrixProjectionUsable) {
-            TRACE_PATH("matrix-ui-ortho-second-fallback");
-            usedCapturedMatrices = TryUseCapturedRenderMatrices(view, proj);
-            matrixProjectionUsable = usedCapturedMatrices;
-        }
-        if (matrixProjectionUsable && IsLikelyUiOrthoMatrix(view, proj)) {
-            matrixProjectionUsable = false;
-            if (!loggedChestUiMatrixReject) {
-                loggedChestUiMatrixReject = true;
-                Log("ChestESP rejected UI-space matrix projection after rebind attempt.");
-            }
-        }
-    }
     if (!matrixProjectionUsable) {
         static bool warnedChestMatrixUnavailable = false;
         if (!warnedChestMatrixUnavailable) {
             warnedChestMatrixUnavailable = true;
             Log("ChestESP waiting for usable projection matrices.");
         }
-        env->PopLocalFrame(nullptr);
         return;
     }
 
-    double vX = 0.0, vY = 0.0, vZ = 0.0;
-    if (g_renderManagerField && g_viewerPosXField && g_viewerPosYField && g_viewerPosZField) {
-        jobject rm = env->GetObjectField(g_mcInstance, g_renderManagerField);
-        if (rm) {
-            vX = env->GetDoubleField(rm, g_viewerPosXField);
-            vY = env->GetDoubleField(rm, g_viewerPosYField);
-            vZ = env->GetDoubleField(rm, g_viewerPosZField);
-            env->DeleteLocalRef(rm);
-        }
-    }
-
-    jobject world = env->GetObjectField(g_mcInstance, g_theWorldField);
-    if (!world) { env->PopLocalFrame(nullptr); return; }
-    jobject tileList = env->GetObjectField(world, g_loadedTileEntityListField);
-    if (!tileList) {
-        env->PopLocalFrame(nullptr);
-        return;
-    }
-
-    jobject player = env->GetObjectField(g_mcInstance, g_thePlayerField);
-    if (!player) {
-        env->PopLocalFrame(nullptr);
-        return;
-    }
-
-    double localPX = env->GetDoubleField(player, g_posXField);
-    double localPY = env->GetDoubleField(player, g_posYField);
-    double localPZ = env->GetDoubleField(player, g_posZField);
-
-    int size = env->CallIntMethod(tileList, g_listSizeMethod);
-    if (env->ExceptionCheck()) {
-        env->ExceptionClear();
-        env->PopLocalFrame(nullptr);
-        return;
-    }
-
-    int drawn = 0;
-    for (int i = 0; i < size && drawn < chestEspMaxCount; i++) {
-        jobject te = env->CallObjectMethod(tileList, g_listGetMethod, i);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); break; }
-        if (!te) continue;
-
-        bool isChest = false;
-        if (g_tileEntityChestClass && env->IsInstanceOf(te, g_tileEntityChestClass)) isChest = true;
-        if (!isChest && g_tileEntityEnderChestClass && env->IsInstanceOf(te, g_tileEntityEnderChestClass)) isChest = true;
-        if (!isChest) {
-            jclass teClass = env->GetObjectClass(te);
-            if (teClass) {
-                std::string clsName = GetClassNameFromClass(env, teClass);
-                if (clsName.find("Chest") != std::string::npos) isChest = true;
-                env->DeleteLocalRef(teClass);
-            }
-        }
-        if (!isChest) {
-            env->DeleteLocalRef(te);
-            continue;
-        }
-
-        jobject posObj = env->GetObjectField(te, g_tileEntityPosField);
-        if (!posObj) {
-            env->DeleteLocalRef(te);
-            continue;
-        }
-
-        int bx = env->CallIntMethod(posObj, g_blockPosGetX);
-        int by = env->CallIntMethod(posObj, g_blockPosGetY);
-        int bz = env->CallIntMethod(posObj, g_blockPosGetZ);
-        env->DeleteLocalRef(posObj);
-        if (env->ExceptionCheck()) {
-            env->ExceptionClear();
-            env->DeleteLocalRef(te);
-            continue;
-        }
-
-        double cx = (double)bx + 0.5;
-        double cy = (double)by + 0.5;
-        double cz = (double)bz + 0.5;
-        double dx = cx - localPX;
-        double dy = cy - localPY;
-        double dz = cz - localPZ;
-        double dist = sqrt(dx*dx + dy*dy + dz*dz);
-        if (dist > 64.0) {
-            env->DeleteLocalRef(te);
-            continue;
-        }
-
-        const double minX = (double)bx;
-        const double minY = (double)by;
-        const double minZ = (double)bz;
+    // Chests outside the view frustum are dropped before projection; the
+    // nearest chestEspMaxCount of the rest are drawn (the scan lists them in
+    // world order).
+    const double vX = snap->cam.viewerX, vY = snap->cam.viewerY, vZ = snap->cam.viewerZ;
+    struct ChestCandidate { double dist; size_t index; };
+    static std::vector<ChestCandidate> s_chestPick;   // render thread only; keeps capacity
+    s_chestPick.clear();
+    Frustum::Planes frustum;
+    Frustum::FromViewProj(frustum, vX, vY, vZ, view.m, proj.m, kLegacyNearW);
+    for (size_t i = 0; i < snap->chests.size(); i++) {
+        const LegacyChestData& chest = snap->chests[i];
+        if (!Frustum::BoxVisible(frustum, chest.x, chest.y, chest.z, chest.x + 1.0, chest.y + 1.0, chest.z + 1.0)) continue;
+        ChestCandidate c = { chest.dist, i };
+        s_chestPick.push_back(c);
+    }
+    s_chestPick.resize(Frustum::SelectNearest(s_chestPick, (size_t)chestEspMaxCount,
+        [](const ChestCandidate& a, const ChestCandidate& b) { return a.dist < b.dist; }));
+
+    for (size_t k = 0; k < s_chestPick.size(); k++) {
+        const LegacyChestData& chest = snap->chests[s_chestPick[k].index];
+        const double minX = (double)chest.x;
+        const double minY = (double)chest.y;
+        const double minZ = (double)chest.z;
         const double maxX = minX + 1.0;
         const double maxY = minY + 1.0;
         const double maxZ = minZ + 1.0;
@@ -6322,29 +6619,20 @@ void RenderChestESP(int w, int h) {
             if (sx > right) right = sx;
             if (sy > bottom) bottom = sy;
         }
+        if (!projected || right <= left || bottom <= top) continue;
 
-        if (projected && right > left && bottom > top) {
-            left = (std::max)(left, 0.0f);
-            top = (std::max)(top, 0.0f);
-            right = (std::min)(right, (float)w);
-            bottom = (std::min)(bottom, (float)h);
-            if (right <= left || bottom <= top) {
-                env->DeleteLocalRef(te);
-                continue;
-            }
+        left = (std::max)(left, 0.0f);
+        top = (std::max)(top, 0.0f);
+        right = (std::min)(right, (float)w);
+        bottom = (std::min)(bottom, (float)h);
+        if (right <= left || bottom <= top) continue;
 
-            float t = (std::min)((float)(dist / 40.0), 1.0f);
-            ImU32 boxColor = IM_COL32(255, 165 + (int)(90 * t), 0 + (int)(80 * t), (int)(220 - 40 * t));
-            ImDrawList* fg = ImGui::GetForegroundDrawList();
-            fg->AddRectFilled(ImVec2(left, top), ImVec2(right, bottom), IM_COL32(0, 0, 0, 90));
-            fg->AddRect(ImVec2(left, top), ImVec2(right, bottom), boxColor, 0.0f, 0, 1.5f);
-            drawn++;
-        }
-
-        env->DeleteLocalRef(te);
+        float t = (std::min)((float)(chest.dist / 40.0), 1.0f);
+        ImU32 boxColor = IM_COL32(255, 165 + (int)(90 * t), 0 + (int)(80 * t), (int)(220 - 40 * t));
+        ImDrawList* fg = ImGui::GetForegroundDrawList();
+        fg->AddRectFilled(ImVec2(left, top), ImVec2(right, bottom), IM_COL32(0, 0, 0, 90));
+        fg->AddRect(ImVec2(left, top), ImVec2(right, bottom), boxColor, 0.0f, 0, 1.5f);
     }
-
-    env->PopLocalFrame(nullptr);
 }
 
 // ===================== CLICKGUI =====================
@@ -7032,17 +7320,7 @@ static void ConfigureImGuiFontAndStyle(HWND hwnd) {
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
     io.IniFilename = nullptr;
 
-    float dpiScale = 1.0f;
-    UINT dpi = 96;
-    HMODULE hUser32 = GetModuleHandleA("user32.dll");
-    if (hUser32) {
-        typedef UINT (WINAPI* FnGetDpiForWindow)(HWND);
-        FnGetDpiForWindow fn = (FnGetDpiForWindow)GetProcAddress(hUser32, "GetDpiForWindow");
-        if (fn && hwnd) dpi = fn(hwnd);
-    }
-    dpiScale = (dpi > 0) ? ((float)dpi / 96.0f) : 1.0f;
-    if (dpiScale < 0.75f) dpiScale = 0.75f;
-    if (dpiScale > 2.5f) dpiScale = 2.5f;
+    float dpiScale = OverlayFont::DpiScale(hwnd);
 
     io.Fonts->Clear();
     ImFontConfig fontCfg;
@@ -7052,25 +7330,10 @@ static void ConfigureImGuiFontAndStyle(HWND hwnd) {
     fontCfg.OversampleV = 2;
     fontCfg.PixelSnapH = true;
 
-    ImFont* loadedFont = nullptr;
-    std::string bridgeDir = GetBridgeDir();
-    std::vector<std::string> fontCandidates = {
-        bridgeDir + "\\minecraftia.ttf",
-        bridgeDir + "\\Minecraftia.ttf",
-        bridgeDir + "\\Data\\minecraftia.ttf",
-        bridgeDir + "\\Data\\Minecraftia.ttf",
-        "C:\\Windows\\Fonts\\minecraftia.ttf",
-        "C:\\Windows\\Fonts\\Minecraftia.ttf"
-    };
-
-    for (const std::string& fontPath : fontCandidates) {
-        if (!FileExistsLocal(fontPath) || !IsLikelyFontBinary(fontPath)) continue;
-        loadedFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), fontCfg.SizePixels, &fontCfg);
-        if (loadedFont) {
-            Log("Loaded ImGui font: " + fontPath);
-            break;
-        }
-    }
+    // Bytes were read off-thread at injection (OverlayFont::Prefetch).
+    std::string fontPath;
+    ImFont* loadedFont = OverlayFont::AddPrefetched(io.Fonts, fontCfg, GetBridgeDir(), &fontPath);
+    if (loadedFont) Log("Loaded ImGui font: " + fontPath);
     if (!loadedFont) {
         io.Fonts->AddFontDefault(&fontCfg);
         Log("Minecraftia not found, using default ImGui font.");
@@ -7084,10 +7347,58 @@ static void ConfigureImGuiFontAndStyle(HWND hwnd) {
     st.GrabRounding = 2.0f;
     st.ScrollbarRounding = 0.0f;
     st.ScaleAllSizes(dpiScale);
+    OverlayFont::BeginContext(dpiScale);
 }
 
 // ===================== SWAPBUFFERS HOOK =====================
+// Draws this frame on the shared overlay context (LC_OVERLAY_SHARED_CONTEXT).
+// A failed context switch drops it for the session and resets the backend,
+// which then comes back on the game context with the usual state save/restore.
+static void RenderDrawDataOnSharedContext(HDC hdc) {
+    if (OverlayContext::Begin(hdc)) {
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        if (OverlayContext::End(hdc)) return;
+        wglMakeCurrent(hdc, OverlayContext::GameContext());
+    }
+    Log("WARNING: shared overlay GL context failed to switch; falling back to the game context.");
+    g_overlayContextFailed = true;
+    g_imguiPendingBackendReset = true;
+    g_imguiPendingGlrc = wglGetCurrentContext();
+    g_imguiWarmupFrames = 3;
+}
+
+// Draws the current ImDrawData and finishes the frame's profile.
+static void SubmitOverlayFrame(HDC hdc) {
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.DisplaySize.x > 1.0f && io.DisplaySize.y > 1.0f) {
+        if (OverlayContext::Active()) RenderDrawDataOnSharedContext(hdc);
+        else ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+    FrameProfiler::EndPhase(FrameProfiler::kStateRestore);
+    glFlush();
+    FrameProfiler::EndPhase(FrameProfiler::kFlush);
+    FrameProfiler::EndFrame();
+
+    static AsyncLog::RateGate s_frameStatsGate;
+    if (AsyncLog::Allow(s_frameStatsGate, 30000)) {
+        std::string frameStats = FrameProfiler::FormatStats();
+        if (!frameStats.empty()) Log("Frame cost: " + frameStats + " replayed="
+                                     + std::to_string(g_overlayPacer.Replayed()));
+    }
+}
+
+// False when nothing in the overlay would draw this frame (RenderHUD, the
+// world modules, the ClickGUI and the debug panel all idle); the hook then
+// leaves ImGui and GL alone entirely.
+static bool OverlayHasWork(const Config& cfg, const GameState& state) {
+    if (g_guiOpen || DebugPanel::EnabledFromEnvironment()) return true;
+    if (ShouldHideWorldRenderModules(state)) return false;
+    return cfg.showModuleList || cfg.nametags || cfg.closestPlayerInfo || cfg.chestEsp;
+}
+
 BOOL WINAPI HookedSwapBuffers(HDC hdc) {
+    FrameProfiler::BeginFrame();
+    if (g_legacyScanWake) SetEvent(g_legacyScanWake);   // one scan pass per rendered frame
     if (!hdc) return CallOriginalSwapBuffers(hdc);
 
     HGLRC currentRc = wglGetCurrentContext();
@@ -7112,6 +7423,8 @@ BOOL WINAPI HookedSwapBuffers(HDC hdc) {
         g_imguiWarmupFrames = 3;
         g_imguiGlrc = currentRc;
         g_imguiHwnd = currentHwnd;
+        if (FrameProfiler::StartCsvFromEnvironment(GetBridgeDir() + "\\bridge_frames.csv"))
+            Log("Frame profiler: writing per-frame CSV.");
         Log("ImGui phase-1 done for legacy bridge (context + Win32).");
         return CallOriginalSwapBuffers(hdc);
     }
@@ -7136,6 +7449,10 @@ BOOL WINAPI HookedSwapBuffers(HDC hdc) {
         ImGui_ImplOpenGL3_SetSkipGLDeletes(true);
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplOpenGL3_SetSkipGLDeletes(false);
+        OverlayContext::Destroy();
+        ImGui_ImplOpenGL3_SetSkipStateBackup(false);
+        g_moduleListLayer.Invalidate();
+        g_overlayPacer.Invalidate();
         g_imguiGlBackendReady = false;
         g_imguiInitialized = false;
         g_glInitialized = false;
@@ -7158,34 +7475,54 @@ BOOL WINAPI HookedSwapBuffers(HDC hdc) {
             glModernLoadedLogged = true;
         }
 
-        GLint last_program = 0;
-        GLint last_active_texture = 0;
-        GLint last_texture_2d = 0;
-        GLint last_array_buffer = 0;
-        GLint last_element_array_buffer = 0;
-        GLint last_vertex_array = 0;
-        GLint last_pixel_unpack_buffer = 0;
-
-        glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
-        glGetIntegerv(GL_ACTIVE_TEXTURE, &last_active_texture);
-        glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture_2d);
-        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
-        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-        if (glBindVertexArray_) glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
-        if (glBindBuffer_) glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer);
-
-        // Let the backend choose the GLSL version for 1.8.9's older GL context.
-        ImGui_ImplOpenGL3_Init(nullptr);
+        // Optional: initialise the backend on a shared overlay context (overlay_context.h).
+        bool sharedContext = false;
+        if (OverlayContext::EnabledFromEnvironment() && !g_overlayContextFailed) {
+            sharedContext = OverlayContext::Create(hdc, currentRc, false) && OverlayContext::Begin(hdc);
+            if (sharedContext) {
+                ImGui_ImplOpenGL3_Init(nullptr);
+                ImGui_ImplOpenGL3_SetPhaseCallback(FrameProfiler::GlBackendMark);
+                ImGui_ImplOpenGL3_SetSkipStateBackup(true);
+                if (!OverlayContext::End(hdc)) wglMakeCurrent(hdc, currentRc);
+                Log("ImGui legacy: overlay renders on a shared GL context.");
+            } else {
+                OverlayContext::Destroy();
+                g_overlayContextFailed = true;
+                Log("ImGui legacy: shared overlay GL context unavailable; drawing on the game context.");
+            }
+        }
 
-        if (glUseProgram_) glUseProgram_((GLuint)last_program);
-        if (glActiveTexture_) glActiveTexture_((GLenum)last_active_texture);
-        glBindTexture(GL_TEXTURE_2D, (GLuint)last_texture_2d);
-        if (glBindBuffer_) {
-            glBindBuffer_(GL_ARRAY_BUFFER, (GLuint)last_array_buffer);
-            glBindBuffer_(GL_ELEMENT_ARRAY_BUFFER, (GLuint)last_element_array_buffer);
-            glBindBuffer_(GL_PIXEL_UNPACK_BUFFER, (GLuint)last_pixel_unpack_buffer);
+        if (!sharedContext) {
+            GLint last_program = 0;
+            GLint last_active_texture = 0;
+            GLint last_texture_2d = 0;
+            GLint last_array_buffer = 0;
+            GLint last_element_array_buffer = 0;
+            GLint last_vertex_array = 0;
+            GLint last_pixel_unpack_buffer = 0;
+
+            glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+            glGetIntegerv(GL_ACTIVE_TEXTURE, &last_active_texture);
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture_2d);
+            glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+            glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
+            if (glBindVertexArray_) glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+            if (glBindBuffer_) glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer);
+
+            // Let the backend choose the GLSL version for 1.8.9's older GL context.
+            ImGui_ImplOpenGL3_Init(nullptr);
+            ImGui_ImplOpenGL3_SetPhaseCallback(FrameProfiler::GlBackendMark);
+
+            if (glUseProgram_) glUseProgram_((GLuint)last_program);
+            if (glActiveTexture_) glActiveTexture_((GLenum)last_active_texture);
+            glBindTexture(GL_TEXTURE_2D, (GLuint)last_texture_2d);
+            if (glBindBuffer_) {
+                glBindBuffer_(GL_ARRAY_BUFFER, (GLuint)last_array_buffer);
+                glBindBuffer_(GL_ELEMENT_ARRAY_BUFFER, (GLuint)last_element_array_buffer);
+                glBindBuffer_(GL_PIXEL_UNPACK_BUFFER, (GLuint)last_pixel_unpack_buffer);
+            }
+            if (glBindVertexArray_) glBindVertexArray_((GLuint)last_vertex_array);
         }
-        if (glBindVertexArray_) glBindVertexArray_((GLuint)last_vertex_array);
 
         g_imguiGlBackendReady = true;
         g_imguiInitialized = true;
@@ -7201,6 +7538,7 @@ BOOL WINAPI HookedSwapBuffers(HDC hdc) {
     int w = rect.right - rect.left;
     int h = rect.bottom - rect.top;
     if (w <= 0 || h <= 0) return CallOriginalSwapBuffers(hdc);
+    FrameProfiler::EndPhase(FrameProfiler::kValidate);
 
     GameState state;
     { LockGuard lk(g_stateMutex); state = g_gameState; }
@@ -7215,8 +7553,32 @@ BOOL WINAPI HookedSwapBuffers(HDC hdc) {
         return CallOriginalSwapBuffers(hdc);
     }
 
+    int overlayUpdateHz = 0;
+    {
+        Config cfg; { LockGuard lk(g_configMutex); cfg = g_config; }
+        // Idle: nothing to show, so no NewFrame and no GL work at all.
+        if (!OverlayHasWork(cfg, state)) {
+            g_overlayPacer.Invalidate();
+            return CallOriginalSwapBuffers(hdc);
+        }
+        overlayUpdateHz = g_guiOpen ? 0 : cfg.overlayUpdateHz;   // the ClickGUI always rebuilds
+    }
+    // Between paced rebuilds, submit the previous frame's draw data again.
+    if (g_overlayPacer.CanReplay(overlayUpdateHz, w, h)) {
+        g_overlayPacer.MarkReplayed();
+        FrameProfiler::EndPhase(FrameProfiler::kPrepare);
+        FrameProfiler::EndPhase(FrameProfiler::kBuild);
+        SubmitOverlayFrame(hdc);
+        return CallOriginalSwapBuffers(hdc);
+    }
+    g_overlayPacer.MarkBuilt(w, h);
+
     // Capture game-space matrices before ImGui renders and restores GL state.
     CaptureCurrentRenderMatrices();
+    float newDpiScale = 0.0f;
+    if (OverlayFont::UpdateDpi(currentHwnd, &newDpiScale))
+        Log("Overlay DPI scale changed to " + std::to_string(newDpiScale) + "; glyphs re-bake lazily.");
+    FrameProfiler::EndPhase(FrameProfiler::kPrepare);
 
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplWin32_NewFrame();
@@ -7224,30 +7586,17 @@ BOOL WINAPI HookedSwapBuffers(HDC hdc) {
 
     RenderHUD(w, h);
     if (!ShouldHideWorldRenderModules(state)) {
-        TryLockGuard jniTry(g_renderJniMutex);
-        if (jniTry.owns_lock()) {
-            RenderNametags(w, h);
-            RenderClosestPlayerInfo(w, h);
-            RenderChestESP(w, h);
-        } else {
-            static DWORD nextJniBusyLogAt = 0;
-            DWORD now = GetTickCount();
-            if (now >= nextJniBusyLogAt) {
-                nextJniBusyLogAt = now + 15000;
-                bool heavy = (InterlockedCompareExchange(&g_heavyDiscoveryInProgress, 0, 0) != 0);
-                Log(std::string("Skipped world overlay frame: JNI busy")
-                    + (heavy ? " (heavy discovery active)" : ""));
-            }
-        }
+        // Snapshot readers only: no JNI, no JNI lock on the render thread.
+        RenderNametags(w, h);
+        RenderClosestPlayerInfo(w, h);
+        RenderChestESP(w, h);
     }
     RenderClickGUI(w, h);
+    if (DebugPanel::EnabledFromEnvironment()) DebugPanel::DrawOverlay();
 
     ImGui::Render();
-    ImGuiIO& io = ImGui::GetIO();
-    if (io.DisplaySize.x > 1.0f && io.DisplaySize.y > 1.0f) {
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-    }
-    glFlush();
+    FrameProfiler::EndPhase(FrameProfiler::kBuild);
+    SubmitOverlayFrame(hdc);
 
     return CallOriginalSwapBuffers(hdc);
 }
@@ -7425,6 +7774,9 @@ void ParseConfig(const std::string& line) {
         std::string showLogoRaw = reader.GetString("showLogo");
         g_config.showLogo = showLogoRaw.empty() ? true : (showLogoRaw == "true");
 
+        int overlayHz = reader.GetInt("overlayUpdateHz", -1);
+        if (overlayHz >= 0) g_config.overlayUpdateHz = (std::min)(240, overlayHz);
+
         std::string guiThemeRaw = reader.GetString("guiTheme");
         g_config.guiTheme = guiThemeRaw.empty() ? "Default" : guiThemeRaw;
 
@@ -7503,11 +7855,10 @@ void ParseConfig(const std::string& line) {
     }
 }
 
-bool TrySendCapabilities(SOCKET sock) {
+bool TrySendCapabilities(SOCKET sock, const std::string& capabilitiesJson) {
     if (sock == INVALID_SOCKET) return false;
 
-    const char* capabilitiesJson = lc::LegacyCapabilitiesJson();
-    int sent = send(sock, capabilitiesJson, (int)strlen(capabilitiesJson), 0);
+    int sent = send(sock, capabilitiesJson.c_str(), (int)capabilitiesJson.size(), 0);
     if (sent == SOCKET_ERROR) {
         int err = WSAGetLastError();
         if (err == WSAEWOULDBLOCK) return false;
@@ -7519,12 +7870,14 @@ bool TrySendCapabilities(SOCKET sock) {
 
 void ServerLoop() {
     WSADATA wsaData; WSAStartup(MAKEWORD(2, 2), &wsaData);
-    g_serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-    int opt = 1; setsockopt(g_serverSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
-    sockaddr_in addr = {}; addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = INADDR_ANY; addr.sin_port = htons(25590);
-    bind(g_serverSocket, (sockaddr*)&addr, sizeof(addr));
-    listen(g_serverSocket, 1);
+    unsigned short port = 0;
+    g_serverSocket = lc::BridgeEndpoint::Listen(&port);
+    if (g_serverSocket == INVALID_SOCKET) {
+        Log("No free bridge port for this process, err=" + std::to_string(WSAGetLastError()));
+        return;
+    }
+    Log("Listening on port " + std::to_string(port));
+    unsigned sessions = 0;
 
     // FIX: Force C locale for correct JSON float formatting (dots not commas)
     setlocale(LC_NUMERIC, "C"); 
@@ -7536,21 +7889,28 @@ void ServerLoop() {
     Log("Discovering classes...");
     bool mapped = DiscoverMappings(env);
     Log(mapped ? "Discovery OK" : "Discovery FAILED");
+    StartLegacyScanThread();
 
     while (g_running) {
         Log("Waiting for client...");
         g_clientSocket = accept(g_serverSocket, nullptr, nullptr);
         if (g_clientSocket == INVALID_SOCKET) { if (!g_running) break; continue; }
-        Log("Client connected");
+        const unsigned session = ++sessions;
+        Log(session == 1 ? std::string("Client connected")
+                         : "Client connected (session " + std::to_string(session) + ", resumed)");
+        const std::string capabilities = lc::BridgeEndpoint::Announce(lc::LegacyCapabilitiesJson(), port, session);
 
         // Set non-blocking for reading config from C#
         u_long mode = 1; ioctlsocket(g_clientSocket, FIONBIO, &mode);
 
         std::string readBuf;
         bool capabilitiesSent = false;
+        lc::TelemetrySampler telemetry;
+        bool telemetryOn = false;
+        unsigned long long bytesOut = 0;
         while (g_running) {
             if (!capabilitiesSent) {
-                capabilitiesSent = TrySendCapabilities(g_clientSocket);
+                capabilitiesSent = TrySendCapabilities(g_clientSocket, capabilities);
                 if (capabilitiesSent) Log("Sent bridge capabilities packet");
             }
 
@@ -7570,6 +7930,8 @@ void ServerLoop() {
             GameState state;
             {
                 LockGuard jniLk(g_stateJniMutex);
+                static const int s_jniAcct = JniAccounting::Register("state", 1500);
+                JniAccounting::Scope jniAcct(env, s_jniAcct);
                 state = ReadGameState(env);
                 UpdateSpeedBridge(env, cfgSnapshot, state);
                 if (cfgSnapshot.reachEnabled || g_reachAllowCurrentClick || g_reachClickPrevDown) {
@@ -7593,6 +7955,13 @@ void ServerLoop() {
             }
             { LockGuard lk(g_stateMutex); g_gameState = state; }
 
+            static AsyncLog::RateGate s_jniStatsGate;
+            if (AsyncLog::Allow(s_jniStatsGate, 30000)) {
+                std::string jniStats = JniAccounting::FormatStats();
+                if (!jniStats.empty()) Log("JNI modules: " + jniStats);
+                JniAccounting::ResetStats();
+            }
+
             // Standard Logic: Build JSON from state
             std::string jsonToSend = "{";
             jsonToSend += "\"mapped\":" + std::string(state.mapped ? "true" : "false") + ",";
@@ -7632,11 +8001,13 @@ void ServerLoop() {
                 int sent = send(g_clientSocket, jsonToSend.c_str(), (int)jsonToSend.length(), 0);
                 if (sent == SOCKET_ERROR) {
                    if (WSAGetLastError() != WSAEWOULDBLOCK) break; 
+                } else {
+                    bytesOut += (unsigned long long)sent;
                 }
             }
             
             // Keep telemetry responsive without pegging CPU.
-            // 14ms (~71 Hz) avoids JNI mutex contention with the render thread
+            // 14ms (~71 Hz) keeps this thread's JNI work well clear of the scan thread
             // while staying well within the 220ms aim-assist freshness window.
             Sleep(14);
 
@@ -7649,6 +8020,12 @@ void ServerLoop() {
               cmds = g_pendingCommands;
               g_pendingCommands.clear();
             }
+            DWORD nowMs = GetTickCount();
+            if (telemetryOn && telemetry.Due(nowMs)) {
+                long lag = g_legacyRenderSnap.Version() - InterlockedCompareExchange(&g_legacyRenderedSnapVersion, 0, 0);
+                DWORD lastScanMs = g_legacyRenderSnapMs;
+                cmds.push_back(telemetry.Sample(nowMs, bytesOut, lag, lastScanMs ? nowMs - lastScanMs : 0));
+            }
 
 
             for (const auto& c : cmds) {
@@ -7656,6 +8033,7 @@ void ServerLoop() {
                  if (s == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK) {
                      break;
                  }
+                 if (s > 0) bytesOut += (unsigned long long)s;
             }
 
             // Read config from C# (non-blocking)
@@ -7667,7 +8045,12 @@ void ServerLoop() {
                 while ((pos = readBuf.find('\n')) != std::string::npos) {
                     std::string line = readBuf.substr(0, pos);
                     readBuf.erase(0, pos + 1);
-                    if (!line.empty()) ParseConfig(line);
+                    if (line.empty()) continue;
+                    if (lc::TelemetrySampler::ParseRequest(line, telemetryOn)) {
+                        telemetry.Reset(GetTickCount(), bytesOut);
+                        continue;
+                    }
+                    ParseConfig(line);
                 }
             } else if (r == 0) {
                 break;
@@ -7690,8 +8073,15 @@ void ServerLoop() {
         LockGuard jniLk(g_stateJniMutex);
         ReleaseSpeedBridgeSneak(env);
         ResetSpeedBridgeMovementTracking();
+    }
+    StopLegacyScanThread();
+    {
+        LockGuard scanLk(g_scanJniMutex);
+        ResetLegacyHelperHandles(env);
         HelperBridge::Unload(env);
+        g_legacyHelperLoadTried = false;
     }
+    ResetPlayerNameCache(env);
     g_jvm->DetachCurrentThread();
     closesocket(g_serverSocket); WSACleanup();
 }
@@ -7699,6 +8089,7 @@ void ServerLoop() {
 // ===================== MAIN THREAD & DLLMAIN =====================
 DWORD WINAPI MainThread(LPVOID lpParam) {
     Log("MainThread started | build 2026-03-29 14:40 reach-clickedge-wndproc");
+    ThreadPolicy::Apply(ThreadPolicy::ROLE_NETWORK, "main/tcp");
     HMODULE hJvm = GetModuleHandleA("jvm.dll");
     if (!hJvm) { Log("ERROR: jvm.dll not found"); return 0; }
     typedef jint(JNICALL* FnGetVMs)(JavaVM**, jsize, jsize*);
@@ -7708,6 +8099,9 @@ DWORD WINAPI MainThread(LPVOID lpParam) {
     if (res != JNI_OK || cnt == 0) { Log("ERROR: No JVM"); return 0; }
     Log("JVM found");
 
+    // Read the overlay font now so the first SwapBuffers does no file I/O.
+    OverlayFont::Prefetch(GetBridgeDir());
+
     // Install rendering hook
     InstallSwapBuffersHook();
 
@@ -7725,12 +8119,15 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID lpReserved) {
         InitLogPath(hModule);
         std::ofstream f(g_logPath.c_str(), std::ios_base::trunc);
         f << "[Bridge] DLL_PROCESS_ATTACH" << std::endl; f.close();
+        AsyncLog::Start(g_logPath);
         Log("Log path: " + g_logPath);
         CreateThread(nullptr, 0, MainThread, nullptr, 0, nullptr);
     } else if (reason == DLL_PROCESS_DETACH) {
         CleanupImGuiAndHooks();
         UnloadMinecraftiaPrivateFont();
         Log("DLL_PROCESS_DETACH");
+        // Process exit: the flusher is already gone, so this only drains.
+        if (lpReserved) AsyncLog::Stop();
     }
     return TRUE;
 }
@@ -6,7 +6,7 @@
  *  - Hooks wglSwapBuffers -> renders ImGui overlay every frame.
  *  - Hooks WndProc -> blocks game input when GUI is open.
  *  - Hooks glfwSetInputMode -> detects when Minecraft naturally re-grabs cursor.
- *  - Maintains TCP server (port 25590) for bidirectional comms with C# Loader.
+ *  - Maintains TCP server (per-process port, bridge_endpoint.h) for bidirectional comms with C# Loader.
  *
  * Cursor management (zero-flick):
  *  - Open GUI: call glfwSetInputMode(CURSOR_NORMAL), block WM_INPUT.
@@ -46,10 +46,41 @@
 #include "imgui_impl_opengl3.h"
 #include "json_config_reader.h"
 #include "bridge_capabilities.h"
+#include "bridge_endpoint.h"
+#include "bridge_protocol.h"
+#include "shm_channel.h"
+#include "send_queue.h"
+#include "snapshot_cell.h"
+#include "task_scheduler.h"
+#include "scan_governor.h"
+#include "thread_policy.h"
+#include "block_grid.h"
+#include "entity_interp.h"
 #include "jni_core/scoped_env.h"
 #include "jni_core/local_frame.h"
 #include "jni_core/resolver.h"
+#include "jni_core/jni_registry.h"
+#include "jni_core/mapping_cache.h"
+#include "jni_core/member_index.h"
+#include "async_log.h"
+#include "frame_profiler.h"
+#include "debug_panel.h"
+#include "overlay_context.h"
+#include "hud_cache.h"
+#include "overlay_font.h"
+#include "text_utils.h"
+#include "sync.h"
+#include "telemetry.h"
+#include "projection.h"
+#include "frustum.h"
+#include "trace_buffer.h"
+#include "synthetic_load.h"
 #include "jni_core/helper_bridge.h"
+#include "jni_core/jni_accounting.h"
+#include "jni_core/jni_replay.h"
+#include "jni_core/ref_ledger.h"
+#include "jni_core/scan_engine.h"
+#include "mappings_121.h"
 
 // MinGW's <GL/gl.h> may not declare modern GL enums used with glGetIntegerv.
 #ifndef GL_CURRENT_PROGRAM
@@ -85,6 +116,8 @@
 
 // Custom extension in our vendored imgui_impl_opengl3.cpp
 void ImGui_ImplOpenGL3_SetSkipGLDeletes(bool skip);
+void ImGui_ImplOpenGL3_SetPhaseCallback(void (*callback)(int mark));
+void ImGui_ImplOpenGL3_SetSkipStateBackup(bool skip);
 
 // Forward decls (some helpers are defined later in this translation unit)
 static void Log(const std::string& msg);
@@ -94,41 +127,25 @@ static std::string CallTextToString(JNIEnv* env, jobject textObj);
 
 static bool g_trace261Enabled = false;
 
+// Tracing exists only in trace builds (see trace_buffer.h).  Paths and
+// branches go to the binary per-thread rings; VALUE carries strings and only
+// appears on discovery paths, so it stays a text log line.
+#if LC_TRACE_BUILD
 static void TraceValue261(const char* fn, const char* key, const std::string& value) {
     if (!g_trace261Enabled) return;
     Log(std::string("TRACE|") + (fn ? fn : "?") + "|" + (key ? key : "?") + "|" + value);
 }
 
-static void TraceBranch261(const char* fn, const char* branch, bool taken) {
-    if (!g_trace261Enabled) return;
-    Log(std::string("TRACE|") + (fn ? fn : "?") + "|" + (branch ? branch : "?") + "|" + (taken ? "1" : "0"));
-}
-
-static bool TraceDecision261(const char* fn, const char* branch, bool decision) {
-    TraceBranch261(fn, branch, decision);
-    return decision;
-}
-
-#define TRACE261_PATH(pathValue) TraceValue261(__FUNCTION__, "path", (pathValue))
+#define TRACE261_PATH(pathValue) LC_TRACE_EVENT('P', (pathValue), 0)
 #define TRACE261_VALUE(key, value) TraceValue261(__FUNCTION__, (key), (value))
-#define TRACE261_BRANCH(branch, taken) TraceBranch261(__FUNCTION__, (branch), (taken))
-#define TRACE261_IF(branch, expr) TraceDecision261(__FUNCTION__, (branch), (expr))
-
-// ===================== MUTEX =====================
-class Mutex {
-    CRITICAL_SECTION cs;
-public:
-    Mutex()  { InitializeCriticalSection(&cs); }
-    ~Mutex() { DeleteCriticalSection(&cs); }
-    void lock()   { EnterCriticalSection(&cs); }
-    void unlock() { LeaveCriticalSection(&cs); }
-};
-class LockGuard {
-    Mutex& m;
-public:
-    LockGuard(Mutex& m) : m(m) { m.lock(); }
-    ~LockGuard() { m.unlock(); }
-};
+#define TRACE261_BRANCH(branch, taken) LC_TRACE_EVENT('B', (branch), (taken) ? 1 : 0)
+#define TRACE261_IF(branch, expr) LC_TRACE_DECISION((branch), (expr))
+#else
+#define TRACE261_PATH(pathValue) ((void)0)
+#define TRACE261_VALUE(key, value) ((void)0)
+#define TRACE261_BRANCH(branch, taken) ((void)0)
+#define TRACE261_IF(branch, expr) (expr)
+#endif
 
 // ===================== CONFIG (mirrors C# Clicker state) =====================
 struct Config {
@@ -152,6 +169,7 @@ struct Config {
     bool  rightClick     = false;
     int   moduleListStyle = 0;
     bool  showLogo       = true;
+    int   overlayUpdateHz = 0;   // overlay rebuilds per second, 0 = every frame
     std::string guiTheme = "Default";
     float rightMinCPS    = 10.0f;
     float rightMaxCPS    = 14.0f;
@@ -182,114 +200,196 @@ struct Config {
     int   autoTotemDelay = 0;
     int   autoTotemBehaviorMode = 0; // 0=Ghost (inventory only), 1=Anarchy
 };
-static Config g_config;
-static Mutex  g_configMutex;
+// Published by ParseConfig (socket thread, the only writer) as immutable
+// snapshots; readers take a ConfigRef without locking.
+static lc::SnapshotCell<Config> g_config;
+typedef lc::SnapshotCell<Config>::Ref ConfigRef;
 static volatile LONG g_forceGlobalJniRemap_121 = 0;
+// Set on every accept: the first config of a connection adopts the loader's
+// reloadMappingsNonce instead of treating it as a reload pulse.  A restarted
+// loader counts from 0 again, and reading that as "reload" threw away warm
+// mappings and rediscovered everything on each reconnect.
+static volatile LONG g_adoptMappingsNonce121 = 0;
 
 // ===================== PENDING COMMANDS (bridge -> C#) =====================
 static std::vector<std::string> g_pendingCmds;
 static Mutex g_cmdMutex;
 
+// Auto-reset; set whenever there is something new for the loader (cmds, JNI
+// state, camera, player list) so the socket loop wakes instead of polling.
+// Created once in MainThread and never closed.
+static HANDLE g_stateReadyEvent = nullptr;
+
+static void SignalStateReady() {
+    if (g_stateReadyEvent) SetEvent(g_stateReadyEvent);
+}
+
 static void SendCmd(const char* action) {
     char buf[128];
     snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"%s\"}\n", action);
-    LockGuard lk(g_cmdMutex);
-    g_pendingCmds.push_back(buf);
+    { LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+    SignalStateReady();
 }
 static void SendCmdFloat(const char* action, float val) {
     char buf[128];
     snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"%s\",\"value\":%.2f}\n", action, val);
-    LockGuard lk(g_cmdMutex);
-    g_pendingCmds.push_back(buf);
+    { LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+    SignalStateReady();
 }
 static void SendCmdInt(const char* action, int val) {
     char buf[128];
     snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"%s\",\"value\":%d}\n", action, val);
-    LockGuard lk(g_cmdMutex);
-    g_pendingCmds.push_back(buf);
+    { LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+    SignalStateReady();
+}
+// Tells the loader which configVersion is now in effect; rides the cmd queue so
+// it is framed like any other message on either transport.
+static void SendConfigAck(int version) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "{\"type\":\"configAck\",\"version\":%d}\n", version);
+    { LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+    SignalStateReady();
 }
 
 // ===================== CONFIG PARSER =====================
-static void ParseConfig(const std::string& line) {
+// Module groups ParseConfig reports as changed.  Accumulated in
+// g_configChangedModules until the scan thread takes them with
+// InterlockedExchange and re-arms only the tasks those groups drive.
+enum ConfigModule {
+    CFG_CLICKER      = 1 << 0,   // armed, clicking, CPS, jitter, right click, break blocks
+    CFG_AIM          = 1 << 1,   // aim assist, triggerbot
+    CFG_NAMETAGS     = 1 << 2,   // nametags, closest player
+    CFG_CHEST_ESP    = 1 << 3,
+    CFG_HUD          = 1 << 4,   // module list, logo, theme
+    CFG_SPEED_BRIDGE = 1 << 5,
+    CFG_GTB          = 1 << 6,
+    CFG_REACH        = 1 << 7,
+    CFG_VELOCITY     = 1 << 8,
+    CFG_AUTO_TOTEM   = 1 << 9,
+    CFG_MAPPINGS     = 1 << 10   // reloadMappingsNonce
+};
+static volatile LONG g_configChangedModules = 0;
+
+// Applies a config packet (anything else is ignored).  A new snapshot is
+// published, and the CFG_* groups it touched are added to
+// g_configChangedModules, only when something changed.  The loader pushes
+// config only when it changes, tagged with a monotonic configVersion that is
+// acknowledged once applied.
+static void ParseConfig(const lc::SimpleJsonConfigReader& reader) {
     TRACE261_PATH("enter");
-    lc::SimpleJsonConfigReader reader(line);
-
     bool isConfig = TRACE261_IF("isConfigPacket", reader.GetString("type") == "config");
     if (!isConfig) return;
+    const bool adoptNonce = InterlockedExchange(&g_adoptMappingsNonce121, 0) != 0;
+
+    Config next = *g_config.Acquire();
+    unsigned changed = 0;
+    using lc::ApplyIfChanged;
+    ApplyIfChanged(next.armed,         reader.GetBool("armed"),         (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.clicking,      reader.GetBool("clicking"),      (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.minCPS,        reader.GetFloat("minCPS"),       (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.maxCPS,        reader.GetFloat("maxCPS"),       (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.jitter,        reader.GetBool("jitter"),        (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.clickInChests, reader.GetBool("clickInChests"), (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.aimAssist,     reader.GetBool("aimAssist"),     (unsigned)CFG_AIM, changed);
+    ApplyIfChanged(next.triggerbot,    reader.GetBool("triggerbot"),    (unsigned)CFG_AIM, changed);
+    ApplyIfChanged(next.nametags,      reader.GetBool("nametags"),      (unsigned)CFG_NAMETAGS, changed);
+    ApplyIfChanged(next.chestEsp,      reader.GetBool("chestEsp"),      (unsigned)CFG_CHEST_ESP, changed);
+    ApplyIfChanged(next.showModuleList, reader.GetBool("showModuleList", true), (unsigned)CFG_HUD, changed);
+    ApplyIfChanged(next.closestPlayer, reader.GetBool("closestPlayerInfo"), (unsigned)CFG_NAMETAGS, changed);
+    ApplyIfChanged(next.nametagHealth, reader.GetBool("nametagShowHealth"), (unsigned)CFG_NAMETAGS, changed);
+    ApplyIfChanged(next.nametagArmor,  reader.GetBool("nametagShowArmor"),  (unsigned)CFG_NAMETAGS, changed);
+    ApplyIfChanged(next.nametagHideVanilla, reader.GetBool("nametagHideVanilla"), (unsigned)CFG_NAMETAGS, changed);
+    ApplyIfChanged(next.nametagMaxCount, lc::ClampInt(reader.GetInt("nametagMaxCount", next.nametagMaxCount), 1, 20), (unsigned)CFG_NAMETAGS, changed);
+    ApplyIfChanged(next.chestEspMaxCount, lc::ClampInt(reader.GetInt("chestEspMaxCount", next.chestEspMaxCount), 1, 20), (unsigned)CFG_CHEST_ESP, changed);
+    ApplyIfChanged(next.rightClick,    reader.GetBool("right"),         (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.rightMinCPS,   reader.GetFloat("rightMinCPS"),  (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.rightMaxCPS,   reader.GetFloat("rightMaxCPS"),  (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.moduleListStyle, lc::ClampInt(reader.GetInt("moduleListStyle", 0), 0, 4), (unsigned)CFG_HUD, changed);
+    ApplyIfChanged(next.showLogo,      reader.GetBool("showLogo", true), (unsigned)CFG_HUD, changed);
+    ApplyIfChanged(next.overlayUpdateHz, lc::ClampInt(reader.GetInt("overlayUpdateHz", 0), 0, 240), (unsigned)CFG_HUD, changed);
+    std::string guiTheme = reader.GetString("guiTheme");
+    if (guiTheme.empty()) guiTheme = "Default";
+    ApplyIfChanged(next.guiTheme,      guiTheme,                        (unsigned)CFG_HUD, changed);
+    ApplyIfChanged(next.rightBlockOnly, reader.GetBool("rightBlock"),   (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.breakBlocks,   reader.GetBool("breakBlocks"),   (unsigned)CFG_CLICKER, changed);
+    ApplyIfChanged(next.speedBridge,   reader.GetBool("speedBridge"),   (unsigned)CFG_SPEED_BRIDGE, changed);
+    ApplyIfChanged(next.speedBridgeBlockOnly, reader.GetBool("speedBridgeBlockOnly"), (unsigned)CFG_SPEED_BRIDGE, changed);
+    ApplyIfChanged(next.speedBridgeDelayMs, lc::ClampInt(reader.GetInt("speedBridgeDelayMs", next.speedBridgeDelayMs), 20, 250), (unsigned)CFG_SPEED_BRIDGE, changed);
+    ApplyIfChanged(next.speedBridgeHoldingShiftOnly, reader.GetBool("speedBridgeHoldingShiftOnly"), (unsigned)CFG_SPEED_BRIDGE, changed);
+    ApplyIfChanged(next.speedBridgeLookingDownOnly, reader.GetBool("speedBridgeLookingDownOnly"), (unsigned)CFG_SPEED_BRIDGE, changed);
+    ApplyIfChanged(next.gtbHelper,     reader.GetBool("gtbHelper"),     (unsigned)CFG_GTB, changed);
+    ApplyIfChanged(next.gtbHint,       reader.GetString("gtbHint"),     (unsigned)CFG_GTB, changed);
+    ApplyIfChanged(next.gtbCount,      reader.GetInt("gtbCount", 0),    (unsigned)CFG_GTB, changed);
+    ApplyIfChanged(next.gtbPreview,    reader.GetString("gtbPreview"),  (unsigned)CFG_GTB, changed);
+    ApplyIfChanged(next.reachEnabled,  reader.GetBool("reachEnabled"),  (unsigned)CFG_REACH, changed);
+    ApplyIfChanged(next.reachMin,      reader.GetFloat("reachMin"),     (unsigned)CFG_REACH, changed);
+    ApplyIfChanged(next.reachMax,      reader.GetFloat("reachMax"),     (unsigned)CFG_REACH, changed);
+    ApplyIfChanged(next.reachChance,   reader.GetInt("reachChance", 100), (unsigned)CFG_REACH, changed);
+    ApplyIfChanged(next.velocityEnabled, reader.GetBool("velocityEnabled"), (unsigned)CFG_VELOCITY, changed);
+    ApplyIfChanged(next.velocityHorizontal, lc::ClampInt(reader.GetInt("velocityHorizontal", 100), 1, 100), (unsigned)CFG_VELOCITY, changed);
+    ApplyIfChanged(next.velocityVertical, lc::ClampInt(reader.GetInt("velocityVertical", 100), 1, 100), (unsigned)CFG_VELOCITY, changed);
+    ApplyIfChanged(next.velocityChance, lc::ClampInt(reader.GetInt("velocityChance", 100), 1, 100), (unsigned)CFG_VELOCITY, changed);
+    ApplyIfChanged(next.autoTotemEnabled, reader.GetBool("autoTotemEnabled"), (unsigned)CFG_AUTO_TOTEM, changed);
+    ApplyIfChanged(next.autoTotemMode, lc::ClampInt(reader.GetInt("autoTotemMode", 0), 0, 1), (unsigned)CFG_AUTO_TOTEM, changed);
+    ApplyIfChanged(next.autoTotemHealth, lc::ClampInt(reader.GetInt("autoTotemHealth", 10), 0, 36), (unsigned)CFG_AUTO_TOTEM, changed);
+    ApplyIfChanged(next.autoTotemElytra, reader.GetBool("autoTotemElytra"), (unsigned)CFG_AUTO_TOTEM, changed);
+    ApplyIfChanged(next.autoTotemDelay, lc::ClampInt(reader.GetInt("autoTotemDelay", 0), 0, 20), (unsigned)CFG_AUTO_TOTEM, changed);
+    ApplyIfChanged(next.autoTotemBehaviorMode, lc::ClampInt(reader.GetInt("autoTotemBehaviorMode", 0), 0, 1), (unsigned)CFG_AUTO_TOTEM, changed);
+    ApplyIfChanged(next.reloadMappingsNonce, reader.GetInt("reloadMappingsNonce", next.reloadMappingsNonce), (unsigned)CFG_MAPPINGS, changed);
+    TRACE261_VALUE("changedModules", std::to_string(changed));
+    int version = reader.GetInt("configVersion", 0);
+    if (changed == 0) {
+        if (version > 0) SendConfigAck(version);
+        return;
+    }
 
-    LockGuard lk(g_configMutex);
-    int prevReloadNonce = g_config.reloadMappingsNonce;
-    g_config.armed         = reader.GetBool("armed");
-    g_config.clicking      = reader.GetBool("clicking");
-    g_config.minCPS        = reader.GetFloat("minCPS");
-    g_config.maxCPS        = reader.GetFloat("maxCPS");
-    g_config.jitter        = reader.GetBool("jitter");
-    g_config.clickInChests = reader.GetBool("clickInChests");
-    g_config.aimAssist     = reader.GetBool("aimAssist");
-    g_config.triggerbot    = reader.GetBool("triggerbot");
-    g_config.nametags      = reader.GetBool("nametags");
-    g_config.chestEsp      = reader.GetBool("chestEsp");
-    std::string showModuleListRaw = reader.GetString("showModuleList");
-    g_config.showModuleList = showModuleListRaw.empty() ? true : (showModuleListRaw == "true");
-    g_config.closestPlayer = reader.GetBool("closestPlayerInfo");
-    g_config.nametagHealth = reader.GetBool("nametagShowHealth");
-    g_config.nametagArmor  = reader.GetBool("nametagShowArmor");
-    g_config.nametagHideVanilla = reader.GetBool("nametagHideVanilla");
-    g_config.nametagMaxCount = lc::ClampInt(reader.GetInt("nametagMaxCount", g_config.nametagMaxCount), 1, 20);
-    g_config.chestEspMaxCount = lc::ClampInt(reader.GetInt("chestEspMaxCount", g_config.chestEspMaxCount), 1, 20);
-    g_config.rightClick    = reader.GetBool("right");
-    g_config.rightMinCPS   = reader.GetFloat("rightMinCPS");
-    g_config.rightMaxCPS   = reader.GetFloat("rightMaxCPS");
-    g_config.moduleListStyle = lc::ClampInt(reader.GetInt("moduleListStyle", 0), 0, 4);
-    std::string showLogoRaw = reader.GetString("showLogo");
-    g_config.showLogo = showLogoRaw.empty() ? true : (showLogoRaw == "true");
-    std::string guiThemeRaw = reader.GetString("guiTheme");
-    g_config.guiTheme = guiThemeRaw.empty() ? "Default" : guiThemeRaw;
-    g_config.rightBlockOnly= reader.GetBool("rightBlock");
-    g_config.breakBlocks   = reader.GetBool("breakBlocks");
-    g_config.speedBridge   = reader.GetBool("speedBridge");
-    g_config.speedBridgeBlockOnly = reader.GetBool("speedBridgeBlockOnly");
-    g_config.speedBridgeDelayMs = lc::ClampInt(reader.GetInt("speedBridgeDelayMs", g_config.speedBridgeDelayMs), 20, 250);
-    g_config.speedBridgeHoldingShiftOnly = reader.GetBool("speedBridgeHoldingShiftOnly");
-    g_config.speedBridgeLookingDownOnly = reader.GetBool("speedBridgeLookingDownOnly");
-    g_config.gtbHelper     = reader.GetBool("gtbHelper");
-    g_config.gtbHint       = reader.GetString("gtbHint");
-    g_config.gtbCount      = reader.GetInt("gtbCount", 0);
-    g_config.gtbPreview    = reader.GetString("gtbPreview");
-    g_config.reachEnabled  = reader.GetBool("reachEnabled");
-    g_config.reachMin      = reader.GetFloat("reachMin");
-    g_config.reachMax      = reader.GetFloat("reachMax");
-    g_config.reachChance   = reader.GetInt("reachChance", 100);
-    g_config.velocityEnabled = reader.GetBool("velocityEnabled");
-    g_config.velocityHorizontal = lc::ClampInt(reader.GetInt("velocityHorizontal", 100), 1, 100);
-    g_config.velocityVertical = lc::ClampInt(reader.GetInt("velocityVertical", 100), 1, 100);
-    g_config.velocityChance = lc::ClampInt(reader.GetInt("velocityChance", 100), 1, 100);
-    g_config.autoTotemEnabled = reader.GetBool("autoTotemEnabled");
-    g_config.autoTotemMode = lc::ClampInt(reader.GetInt("autoTotemMode", 0), 0, 1);
-    g_config.autoTotemHealth = lc::ClampInt(reader.GetInt("autoTotemHealth", 10), 0, 36);
-    g_config.autoTotemElytra = reader.GetBool("autoTotemElytra");
-    g_config.autoTotemDelay = lc::ClampInt(reader.GetInt("autoTotemDelay", 0), 0, 20);
-    g_config.autoTotemBehaviorMode = lc::ClampInt(reader.GetInt("autoTotemBehaviorMode", 0), 0, 1);
-    g_config.reloadMappingsNonce = reader.GetInt("reloadMappingsNonce", g_config.reloadMappingsNonce);
-    bool reloadPulse = (g_config.reloadMappingsNonce != prevReloadNonce);
+    g_config.Publish(next);
+    if (version > 0) SendConfigAck(version);
+    InterlockedOr(&g_configChangedModules, (LONG)changed);
+
+    bool reloadPulse = (changed & CFG_MAPPINGS) != 0 && !adoptNonce;
     TRACE261_BRANCH("reloadMappingsPulse", reloadPulse);
+    if ((changed & CFG_MAPPINGS) && adoptNonce) {
+        Log("ReloadMappings: adopted nonce " + std::to_string(next.reloadMappingsNonce)
+            + " from a new loader; keeping current mappings.");
+    }
     if (reloadPulse) {
         InterlockedExchange(&g_forceGlobalJniRemap_121, 1);
         Log("ReloadMappings: received loader pulse; scheduling full JNI remap across modules.");
     }
 }
 
-static bool TrySendCapabilities(SOCKET sock) {
-    if (sock == INVALID_SOCKET) return false;
+// Handles the loader's {"type":"format",...} request.  Returns false for any
+// other packet.  Only "lcb1" is accepted; anything else is answered with
+// "json" and the connection stays on JSON lines.
+static bool HandleFormatRequest(lc::SendQueue& out, const lc::SimpleJsonConfigReader& reader, bool& binaryState, bool& deltaState) {
+    if (reader.GetString("type") != "format") return false;
+
+    bool wantBinary = reader.GetString("state") == lc::proto::kFormatName;
+    bool wantDelta = wantBinary && reader.GetBool("delta");
+    out.Push(wantBinary ? lc::proto::FormatAckLine(wantDelta) : "{\"type\":\"format\",\"state\":\"json\"}\n");
+    binaryState = wantBinary;
+    deltaState = wantDelta;
+    Log(std::string("State format: ") + (wantBinary ? lc::proto::kFormatName : "json") + (wantDelta ? " (delta)" : ""));
+    return true;
+}
 
-    const char* capabilitiesJson = lc::ModernCapabilitiesJson();
-    int sent = send(sock, capabilitiesJson, (int)strlen(capabilitiesJson), 0);
-    if (sent == SOCKET_ERROR) {
-        int err = WSAGetLastError();
-        if (err == WSAEWOULDBLOCK) return false;
-        Log("Capabilities send failed, err=" + std::to_string(err));
-        return false;
-    }
+// Handles {"type":"transport","state":"shm"|"tcp"}.  Returns false for any
+// other packet.  The shm ack carries the object base name; if the mapping
+// cannot be created the bridge answers "tcp" and keeps using the socket.
+static bool HandleTransportRequest(lc::SendQueue& out, const lc::SimpleJsonConfigReader& reader, lc::ShmChannel& shm, bool& shmActive) {
+    if (reader.GetString("type") != "transport") return false;
+
+    bool wantShm = reader.GetString("state") == "shm";
+    if (wantShm && !shm.Open()) {
+        Log("Shared-memory channel unavailable, err=" + std::to_string(GetLastError()));
+        wantShm = false;
+    }
+    out.Push(wantShm
+        ? "{\"type\":\"transport\",\"state\":\"shm\",\"name\":\"" + shm.Name() + "\"}\n"
+        : std::string("{\"type\":\"transport\",\"state\":\"tcp\"}\n"));
+    shmActive = wantShm;
+    Log(std::string("Transport: ") + (wantShm ? "shm (" + shm.Name() + ")" : std::string("tcp")));
     return true;
 }
 
@@ -412,6 +512,29 @@ static OverlayTheme ResolveOverlayTheme(const std::string& guiTheme)
     };
 }
 
+// Everything the module list and logo depend on; the HudCache layer adds the
+// font atlas, font size and display metrics.
+static unsigned long long ModuleListKey(const Config& cfg)
+{
+    HudCache::Key key;
+    key.Add(cfg.guiTheme);
+    key.Add(cfg.moduleListStyle);
+    key.Add(cfg.showLogo);
+    key.Add(cfg.armed);
+    if (cfg.armed) {
+        key.Add((int)cfg.minCPS);
+        key.Add((int)cfg.maxCPS);
+    }
+    const bool enabled[] = {
+        cfg.clickInChests, cfg.closestPlayer, cfg.rightClick, cfg.aimAssist,
+        cfg.triggerbot, cfg.speedBridge, cfg.chestEsp, cfg.nametags, cfg.gtbHelper,
+        cfg.jitter, cfg.breakBlocks, cfg.reachEnabled, cfg.velocityEnabled,
+        cfg.autoTotemEnabled
+    };
+    key.Add(enabled, sizeof(enabled));
+    return key.Value();
+}
+
 // ===================== GLOBALS =====================
 static bool g_running          = true;
 static bool g_imguiInitialized = false;
@@ -435,6 +558,15 @@ static bool  g_imguiGlBackendReady = false;
 static bool  g_imguiPendingBackendReset = false;
 static HGLRC g_imguiPendingGlrc = nullptr;
 
+// Set once the shared overlay context (overlay_context.h) failed; the game
+// context path is used for the rest of the session.
+static bool  g_overlayContextFailed = false;
+
+// Module list + logo geometry, replayed while ModuleListKey() is unchanged.
+static HudCache::Layer g_moduleListLayer;
+// Redraws the previous ImDrawData between rebuilds (Config::overlayUpdateHz).
+static HudCache::FramePacer g_overlayPacer;
+
 // Render-thread scheduled actions (WndProc just flips these flags).
 static volatile LONG g_reqOpenMenu  = 0;
 static volatile LONG g_reqCloseMenu = 0;
@@ -465,6 +597,19 @@ static PFN_glfwGetKey            glfwGetKey_fn           = nullptr;
 #define GLFW_RAW_MOUSE_MOTION  0x00033005
 #define GLFW_PRESS             1
 
+// Owners of the bridge's global refs (jni_core/ref_ledger.h).  A cap bounds
+// how much one module can pin in the game's heap when its cleanup is missed;
+// staged remap handles move to "core" when they are adopted.
+static const int s_refCore121        = RefLedger::Register("core", 64);
+static const int s_refRemap121       = RefLedger::Register("remap", 32);
+static const int s_refPlayers121     = RefLedger::Register("players", 1024);
+static const int s_refChestEsp121    = RefLedger::Register("chestEsp", 8192);
+static const int s_refNametagHide121 = RefLedger::Register("nametagHide", 512);
+static const int s_refAutoTotem121   = RefLedger::Register("autoTotem", 16);
+static const int s_refReach121       = RefLedger::Register("reach", 16);
+static const int s_refCamera121      = RefLedger::Register("camera", 4);
+static const int s_refHudText121     = RefLedger::Register("hudText", 16);
+
 // Cached game ClassLoader (global ref) used for safe class loads.
 static jobject g_gameClassLoader = nullptr;
 
@@ -482,6 +627,7 @@ static std::string g_screenType;              // FQ name of Screen base class
 // Per-frame JNI state (read in SwapBuffers, consumed in TCP)
 static std::string g_jniScreenName;
 static std::string g_jniActionBar;
+static unsigned    g_jniActionBarRev = 1;    // bumped whenever g_jniActionBar changes; never 0
 static bool        g_jniGuiOpen     = false;
 static bool        g_jniInWorld     = false;
 static bool        g_jniLookingAtBlock = false;
@@ -492,9 +638,29 @@ static bool        g_jniHoldingBlock   = false;
 static float       g_jniAttackCooldown = 1.0f;
 static float       g_jniAttackCooldownPerTick = 0.08f;
 static unsigned long long g_jniStateMs = 0;
+static unsigned    g_jniTick = 0;             // player tickCount the tick-rate fields were read on, 0 = wall clock
+static unsigned long long g_jniTickSampleMs = 0;
+
+// Tick-rate fields from the last tick UpdateJniState read them on (see STATE
+// SAMPLING).
+struct TickSample121 {
+    bool               valid;
+    bool               fromField;     // tick came from tickCount, not wall time
+    bool               inWorld;
+    unsigned           tick;
+    unsigned long long sampleMs;
+    bool               breakingBlock; // isDestroying only; the LMB fallback stays per-frame
+    bool               holdingBlock;
+    float              attackCooldown;
+    float              attackCooldownPerTick;
+    std::string        actionBar;
+};
+static TickSample121 g_tickSample121 = {};   // FastPollThreadProc, under g_jniRemapMtx
+static bool g_tickCountLookupFailed121 = false;
+static volatile LONG g_stateSamples121 = 0;
+static volatile LONG g_stateTickReads121 = 0;
+
 static unsigned long long g_lastEntitySeenMs = 0;
-static bool        g_loggedCooldownProgressResolve = false;
-static bool        g_loggedCooldownPerTickResolve = false;
 static bool        g_loggedCooldownProgressMissing = false;
 static bool        g_loggedCooldownPerTickMissing = false;
 static bool        g_loggedCooldownPlayerFieldMissing = false;
@@ -509,6 +675,45 @@ static jfieldID    g_inGameHudField_121 = nullptr; // MinecraftClient.inGameHud
 static std::vector<jfieldID> g_hudTextFields_121;  // InGameHud Text fields
 static DWORD       g_lastHudTextProbeMs = 0;
 
+// Last Component seen in each g_hudTextFields_121 slot (weak) and its text.
+// The HUD keeps the same object until the message changes, so the string is
+// only fetched and converted for a new one.  FastPollThreadProc, under
+// g_jniRemapMtx.
+struct HudTextSlot121 {
+    jweak       obj;
+    std::string text;
+    HudTextSlot121() : obj(nullptr) {}
+};
+static std::vector<HudTextSlot121> g_hudTextSlots121;
+
+// JniRegistry slots used by the UpdateJniState hot path. The table is built and
+// published once per successful DiscoverJniMappings; remaps swap it atomically.
+// Only the state poll is on the registry: the module handles below (reach,
+// velocity, speed bridge, render, chests, ...) are still resolved lazily by their
+// own name/signature probes on the fast-poll thread and are cleared one by one in
+// ResetModernJniRuntimeCaches121.  Moving a module over means giving its lookups
+// resolver.h descriptors and slots here.
+enum StateRegClass121 {
+    REG_CLS_MC_121 = 0,
+    REG_CLS_GAME_MODE_121,
+    REG_CLS_PLAYER_121,
+    REG_CLS_ITEM_STACK_121,
+    REG_CLS_BLOCK_ITEM_121,
+    REG_CLS_JAVA_CLASS_121
+};
+enum StateRegField121 {
+    REG_FLD_GAME_MODE_121 = 0,
+    REG_FLD_IS_DESTROYING_121,
+    REG_FLD_TICK_COUNT_121
+};
+enum StateRegMethod121 {
+    REG_MID_GET_SUPERCLASS_121 = 0,
+    REG_MID_GET_MAIN_HAND_121,
+    REG_MID_STACK_GET_ITEM_121,
+    REG_MID_COOLDOWN_PROGRESS_121,
+    REG_MID_COOLDOWN_PER_TICK_121
+};
+
 // ===================== REACH MODULE JNI GLOBALS =====================
 static bool g_reachJniInit = false;
 static jmethodID g_getAttributes_121 = nullptr;
@@ -541,6 +746,7 @@ static double g_speedBridgeLastPosZ_121 = 0.0;
 static int g_speedBridgeDirX_121 = 0;
 static int g_speedBridgeDirZ_121 = 0;
 static bool g_loggedSpeedBridgeResolveFail_121 = false;
+static lc::BlockGrid g_speedBridgeGrid_121;   // scan thread; stamped with the player tick
 
 // ===================== AUTOTOTEM MODULE JNI GLOBALS =====================
 static bool g_autoTotemMethodsResolved = false;
@@ -570,6 +776,39 @@ static jmethodID g_getConnectionMethod_121 = nullptr; // Minecraft.getConnection
 static jfieldID  g_gameModeFieldCached_121 = nullptr;  // Minecraft.gameMode
 static jmethodID g_getCarriedMethod_121 = nullptr;     // AbstractContainerMenu.getCarried()
 static jmethodID g_isEmptyMethod_121 = nullptr;        // ItemStack.isEmpty()
+static jmethodID g_itemStackGetCount_121 = nullptr;    // ItemStack.getCount()
+static jfieldID  g_playerContainerMenuField_121 = nullptr; // Player.containerMenu
+static jfieldID  g_menuContainerIdField_121 = nullptr;     // AbstractContainerMenu.containerId
+static jfieldID  g_menuStateIdField_121 = nullptr;         // AbstractContainerMenu.stateId (yarn: revision)
+static jfieldID  g_inventoryTimesChangedField_121 = nullptr; // Inventory.timesChanged
+static bool      g_autoTotemMenuFieldsTried_121 = false;
+static bool      g_autoTotemInvFieldTried_121 = false;
+
+// Slot contents as of the last inventory read.  Refreshed only when the
+// player menu's stateId or Inventory.timesChanged moves, after one of our own
+// clicks, or every kInventorySnapshotMaxAgeMs as a fallback for servers and
+// versions where neither counter resolves.  kind 0 is the totem.
+struct InventorySnapshot121 {
+    bool  valid;
+    int   stateId;
+    int   timesChanged;
+    DWORD takenMs;
+    std::vector<HelperBridge::InventorySlot> slots;
+    HelperBridge::InventorySlot offhand;
+    unsigned long refreshes, helperRefreshes, reuses;
+
+    InventorySnapshot121() : valid(false), stateId(0), timesChanged(0), takenMs(0),
+                             refreshes(0), helperRefreshes(0), reuses(0) {
+        offhand.kind = HelperBridge::kSlotEmpty;
+        offhand.itemId = 0;
+        offhand.count = 0;
+    }
+};
+static InventorySnapshot121 g_invSnapshot121;                 // scan thread
+static const DWORD kInventorySnapshotMaxAgeMs = 1000;
+static jobjectArray g_invHelperHandles121 = nullptr;          // Method[] for collectInventory
+static jobjectArray g_invHelperKinds121 = nullptr;            // Object[] { Items.TOTEM_OF_UNDYING }
+static bool         g_invHelperTried121 = false;
 
 static jobject   g_lastAutoTotemWorld_121 = nullptr;   // Tracks world obj to detect transitions
 
@@ -618,6 +857,8 @@ struct BgCamState {
     bool   camFound = false;
     Matrix4x4 proj = {}, view = {};
     bool   matsOk = false;
+    Projection::Camera projection = {};   // view x proj (or the angles model), built once per snapshot
+    unsigned long seq = 0;   // bumped only when any of the above changes; 0 = never read
 };
 static BgCamState  g_bgCamState = {};
 static Mutex       g_bgCamMutex;
@@ -626,6 +867,24 @@ static jfieldID  g_optionsField_121 = nullptr; // MinecraftClient.options
 static jfieldID  g_fovField_121     = nullptr; // GameOptions.fov (SimpleOption)
 static jmethodID g_simpleOptionGet_121 = nullptr; // SimpleOption.getValue/get
 
+// Boxed value accessor of the fov option, resolved once per SimpleOption
+// instance (background thread only).
+struct FovValueCache121 {
+    jweak     option = nullptr;      // instance the accessor was resolved for
+    jmethodID optionGet = nullptr;   // g_simpleOptionGet_121 at resolve time
+    jmethodID getter = nullptr;      // Double.doubleValue or Integer.intValue
+    bool      isDouble = false;
+};
+static FovValueCache121 g_fovValue_121;
+
+static bool SameCameraState(const BgCamState& a, const BgCamState& b) {
+    return a.camFound == b.camFound && a.matsOk == b.matsOk &&
+           a.camX == b.camX && a.camY == b.camY && a.camZ == b.camZ &&
+           a.yaw == b.yaw && a.pitch == b.pitch && a.fov == b.fov &&
+           (!a.matsOk || (memcmp(a.proj.m, b.proj.m, sizeof(a.proj.m)) == 0 &&
+                          memcmp(a.view.m, b.view.m, sizeof(a.view.m)) == 0));
+}
+
 // Removed EnsureReflectInvokeCaches / FindZeroArgMethodReturningClass as we fetch Camera directly via fields now.
 
 static bool ReadMatrix4f(JNIEnv* env, jobject matObj, Matrix4x4& out) {
@@ -789,14 +1048,117 @@ struct PlayerData121 {
     double hp;
     int armor;
     std::string heldItem;
+    // From the player's g_playerTable121 row: its handle and key, what this
+    // pass changed (kPlayer* bits), and the last two positions for
+    // render-time interpolation.
+    lc::SlotHandle slot;
+    unsigned id;
+    unsigned changes;
+    lc::MotionSample motion;
 };
-static std::vector<PlayerData121> g_playerList;
-static Mutex g_playerListMutex;
+// Written only by the scan thread; readers hold a Ref instead of copying.
+// Version() is the frame's generation.
+static lc::SnapshotCell<std::vector<PlayerData121> > g_playerList;
+typedef lc::SnapshotCell<std::vector<PlayerData121> >::Ref PlayerListRef;
 static DWORD g_lastPlayerListUpdateMs = 0;
 
+// Player-list period when only overlays read it: one game tick.  Positions
+// change once per tick and the overlay interpolates between scans, so
+// scanning faster buys nothing visible.  Aim assist and triggerbot keep the
+// 8 ms period: they consume the raw positions and care about latency.
+static const DWORD kPlayerListTickMs = 50;
+static const DWORD kPlayerListAimMs  = 8;
+
+// ---- Persistent player table ----
+// One row per player the list scan saw in its last pass, keyed by
+// Entity.getId() (a name hash when the id is unknown) and stamped with the
+// pass number.  A pass updates its rows in place and drops rows it did not
+// see.  Position and health are read every pass; on the per-entity JNI path
+// armor and the held item only when the row is new or kPlayerSlowAttrMs
+// old (the helper path gets them in its one call anyway).  g_playerList is
+// built from the rows, each entry carrying what its pass changed.  Cleared
+// on world change.  Scan thread only.
+enum PlayerRowChange121 {
+    kPlayerAdded = 1 << 0,
+    kPlayerMoved = 1 << 1,
+    kPlayerAttrs = 1 << 2    // name, health, armor or held item
+};
+struct PlayerRow121 {
+    std::string name;
+    std::string heldItem;
+    double hp;
+    int armor;
+    DWORD slowAtMs;          // armor / held item last read (per-entity path)
+    lc::MotionSample motion;
+};
+struct PlayerTableStats121 {
+    unsigned long passes, added, removed, moved, attrs, slowReads;
+};
+static lc::SlotTable<PlayerRow121, 128> g_playerTable121;
+static unsigned g_playerTablePass121 = 0;
+static PlayerTableStats121 g_playerTableStats121 = {};
+static const DWORD kPlayerSlowAttrMs = 500;
+
+static unsigned PlayerRowKey121(int entityId, const std::string& name) {
+    if (entityId >= 0) return (unsigned)entityId;
+    unsigned h = 2166136261u;   // FNV-1a
+    for (size_t i = 0; i < name.size(); i++) { h ^= (unsigned char)name[i]; h *= 16777619u; }
+    return h;
+}
+
+template <typename V>
+static bool AssignIfChanged121(V& field, const V& value) {
+    if (field == value) return false;
+    field = value;
+    return true;
+}
+
+// The pass's row for `key`; *fresh when it was just added.
+static PlayerRow121& TouchPlayerRow121(unsigned key, lc::SlotHandle* handle, bool* fresh) {
+    *handle = g_playerTable121.Touch(key, g_playerTablePass121, fresh);
+    if (*fresh) g_playerTableStats121.added++;
+    return g_playerTable121[*handle];
+}
+
+// Applies this pass's reading to the row and appends its g_playerList entry.
+static void EmitPlayerRow121(std::vector<PlayerData121>& out, PlayerRow121& row, lc::SlotHandle handle,
+                             unsigned key, bool fresh, unsigned changes, double dist,
+                             double x, double y, double z, LONGLONG nowQpc) {
+    const lc::MotionSample before = row.motion;
+    row.motion.Observe(x, y, z, nowQpc, fresh);
+    if (fresh) changes |= kPlayerAdded;
+    else if (row.motion.at != before.at) changes |= kPlayerMoved;
+    if (changes & kPlayerMoved) g_playerTableStats121.moved++;
+    if (changes & kPlayerAttrs) g_playerTableStats121.attrs++;
+    out.emplace_back(PlayerData121{row.name, dist, x, y, z, row.hp, row.armor, row.heldItem});
+    PlayerData121& p = out.back();
+    p.slot = handle;
+    p.id = key;
+    p.changes = changes;
+    p.motion = row.motion;
+}
+
+static void ResetPlayerTable121() {
+    g_playerTable121.Clear();
+}
+
+static std::string FormatPlayerTableStats121() {
+    const PlayerTableStats121& s = g_playerTableStats121;
+    char buf[160];
+    snprintf(buf, sizeof(buf), "rows=%u passes=%lu added=%lu removed=%lu moved=%lu attrs=%lu slowReads=%lu",
+             g_playerTable121.Live(), s.passes, s.added, s.removed, s.moved, s.attrs, s.slowReads);
+    return buf;
+}
+
 struct ChestData121 { double x, y, z; double dist; };
-static std::vector<ChestData121> g_chestList;
-static Mutex g_chestListMutex;
+static lc::SnapshotCell<std::vector<ChestData121> > g_chestList;   // as g_playerList
+typedef lc::SnapshotCell<std::vector<ChestData121> >::Ref ChestListRef;
+
+// Scan thread only.  Publishes empty lists unless they already are.
+static void ClearScanLists121() {
+    if (!g_playerList.Acquire()->empty()) { g_playerList.BeginWrite().clear(); g_playerList.Commit(); }
+    if (!g_chestList.Acquire()->empty()) { g_chestList.BeginWrite().clear(); g_chestList.Commit(); }
+}
 static DWORD g_lastChestScanMs = 0;
 // Chunk-based block entity access (1.21: no flat list on world, BEs live in WorldChunk.blockEntities Map)
 static jmethodID g_worldGetChunkMethod_121       = nullptr; // World.getChunk(II) -> WorldChunk
@@ -820,6 +1182,8 @@ static jfieldID  g_javaHashMapTableField  = nullptr;
 static jfieldID  g_javaHMNodeValueField   = nullptr;
 static jfieldID  g_javaHMNodeNextField    = nullptr;
 static jfieldID  g_javaHMNodeKeyField     = nullptr; // Map key = BlockPos directly
+static jfieldID  g_javaHashMapModCountField = nullptr; // HashMap.modCount/size: chunk BE map change detection
+static jfieldID  g_javaHashMapSizeField   = nullptr;
 // BlockPos coordinate methods (fallback when direct fields fail)
 static jmethodID g_blockPosGetX_121       = nullptr;
 static jmethodID g_blockPosGetY_121       = nullptr;
@@ -871,14 +1235,27 @@ static jobject   g_visibilityRuleNever_121 = nullptr;          // AbstractTeam.V
 static bool g_nametagSuppressionActive_121 = false;
 static bool g_loggedNametagSuppressionUnavailable_121 = false;
 static bool g_loggedNametagRestoreUnavailable_121 = false;
-static std::unordered_map<std::string, std::string> g_hiddenNametagOriginalTeamByPlayer_121; // DEPRECATED: kept for compatibility, no longer populated
+static std::unordered_map<std::string, std::string> g_hiddenNametagOriginalTeamByPlayer_121; // player -> server team set to NEVER for them
 static std::unordered_map<std::string, jobject> g_modifiedTeamVisibility_121; // team name -> original VisibilityRule (global ref)
 static std::unordered_set<std::string> g_lcHideTagsMembers_121;
+// Suppression is kept as a diff: each pass only joins new names and releases
+// names that left; every kNametagResyncMs all names are re-applied so server
+// team updates that reset the visibility or moved a player are caught.
+static const DWORD kNametagResyncMs = 2000;
+static DWORD g_nextNametagResyncMs_121 = 0;
+static jobjectArray g_nametagHelperHandles121 = nullptr;   // Method[] for applyNametagHide
+static bool g_nametagHelperTried121 = false;
+struct NametagSyncStats121 {
+    unsigned long passes, joins, leaves, resyncs, helperCalls;
+    NametagSyncStats121() : passes(0), joins(0), leaves(0), resyncs(0), helperCalls(0) {}
+};
+static NametagSyncStats121 g_nametagSyncStats121;
 static jobject g_lastNametagSuppressionWorld_121 = nullptr;
 static DWORD g_nextNametagSuppressionResolveRetryMs_121 = 0;
 static int g_nametagSuppressionResolveRetryCount_121 = 0;
 static jmethodID g_textGetString_121 = nullptr; // Text.getString() -> String
 static jmethodID g_getArmor_121 = nullptr;      // LivingEntity.getArmor() -> I
+static jmethodID g_getEntityId_121 = nullptr;   // Entity.getId() -> I
 static jmethodID g_getMainHandStack_121 = nullptr; // LivingEntity.getMainHandStack() -> ItemStack
 static jmethodID g_itemStackGetName_121 = nullptr; // ItemStack.getName() -> Text
 static jmethodID g_itemStackGetDamage_121 = nullptr; // ItemStack.getDamage() -> I
@@ -900,6 +1277,17 @@ static int GetEntityArmor(JNIEnv* env, jobject entity) {
 
 static std::string CallTextToString(JNIEnv* env, jobject textObj); // forward decl
 
+// "Name (left/max)" as shown in the player list; the name is cut to ~14 chars.
+static std::string FormatHeldItem(std::string name, int dmg, int maxDmg) {
+    if (name.length() > 14) name = name.substr(0, 14) + "..";
+    if (maxDmg > 0) { // maxDmg > 0 means it's a damagable tool
+        char buf[32];
+        snprintf(buf, sizeof(buf), " (%d/%d)", maxDmg - dmg, maxDmg);
+        name += buf;
+    }
+    return name;
+}
+
 static std::string GetHeldItemInfo(JNIEnv* env, jobject entity) {
     if (!env || !entity || !g_getMainHandStack_121 || !g_itemStackGetName_121) return "";
     jobject stack = env->CallObjectMethod(entity, g_getMainHandStack_121);
@@ -915,26 +1303,17 @@ static std::string GetHeldItemInfo(JNIEnv* env, jobject entity) {
         env->DeleteLocalRef(textObj);
     } else env->ExceptionClear();
 
-    // Limit item name to ~14 chars
-    if (result.length() > 14) result = result.substr(0, 14) + "..";
-
     // Damage
+    int dmg = 0, maxDmg = 0;
     if (g_itemStackGetDamage_121 && g_itemStackGetMaxDamage_121) {
-        int dmg = env->CallIntMethod(stack, g_itemStackGetDamage_121);
+        dmg = env->CallIntMethod(stack, g_itemStackGetDamage_121);
         if (env->ExceptionCheck()) env->ExceptionClear();
-        int maxDmg = env->CallIntMethod(stack, g_itemStackGetMaxDamage_121);
+        maxDmg = env->CallIntMethod(stack, g_itemStackGetMaxDamage_121);
         if (env->ExceptionCheck()) env->ExceptionClear();
-        
-        if (maxDmg > 0) { // maxDmg > 0 means it's a damagable tool
-            int remaining = maxDmg - dmg;
-            char buf[32];
-            snprintf(buf, sizeof(buf), " (%d/%d)", remaining, maxDmg);
-            result += buf;
-        }
     }
 
     env->DeleteLocalRef(stack);
-    return result;
+    return FormatHeldItem(result, dmg, maxDmg);
 }
 
 static void EnsureGameProfileCaches(JNIEnv* env, jobject anyPlayerObj) {
@@ -942,7 +1321,7 @@ static void EnsureGameProfileCaches(JNIEnv* env, jobject anyPlayerObj) {
     if (!g_gameProfileClass_121) {
         jclass c = env->FindClass("com/mojang/authlib/GameProfile");
         if (env->ExceptionCheck()) { env->ExceptionClear(); c = nullptr; }
-        if (c) { g_gameProfileClass_121 = (jclass)env->NewGlobalRef(c); env->DeleteLocalRef(c); }
+        if (c) { g_gameProfileClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refPlayers121); env->DeleteLocalRef(c); }
     }
     if (g_gameProfileClass_121 && !g_gameProfileGetName_121) {
         g_gameProfileGetName_121 = env->GetMethodID(g_gameProfileClass_121, "getName", "()Ljava/lang/String;");
@@ -965,83 +1344,21 @@ static void EnsureGameProfileCaches(JNIEnv* env, jobject anyPlayerObj) {
     }
 }
 
-static std::string NormalizeNameSpaces(const std::string& in) {
-    std::string out;
-    out.reserve(in.size());
-    bool wasSpace = false;
-    for (size_t i = 0; i < in.size(); i++) {
-        unsigned char c = (unsigned char)in[i];
-        if (c < 32) continue;
-        bool isSpace = std::isspace(c) != 0;
-        if (isSpace) {
-            if (!wasSpace && !out.empty()) out.push_back(' ');
-        } else {
-            out.push_back((char)c);
-        }
-        wasSpace = isSpace;
-    }
-    while (!out.empty() && out.back() == ' ') out.pop_back();
-    return out;
-}
+using lc::NormalizeNameSpaces;
+using lc::StripMinecraftFormattingCodes;
+using lc::StableProfileName;
+using lc::TrimNameWhitespace;
 
-static std::string StripMinecraftFormattingCodes(const std::string& in) {
-    std::string out;
-    out.reserve(in.size());
-    for (size_t i = 0; i < in.size(); i++) {
-        unsigned char c = (unsigned char)in[i];
-        if (c == 0xC2 && i + 2 < in.size() && (unsigned char)in[i + 1] == 0xA7) {
-            i += 2;
-            continue;
-        }
-        if (c == 0xA7) {
-            if (i + 1 < in.size()) i++;
-            continue;
-        }
-        out.push_back((char)c);
-    }
-    return out;
+static bool LooksLikeFakePlayerLine(const std::string& rawName) {
+    return lc::LooksLikeFakePlayerName(NormalizeNameSpaces(StripMinecraftFormattingCodes(rawName)));
 }
 
-static bool IsLikelyProfileName(const std::string& name) {
-    if (name.size() < 3 || name.size() > 16) return false;
-    for (char ch : name) {
-        unsigned char c = (unsigned char)ch;
-        if (std::isalnum(c) || c == '_') continue;
-        return false;
-    }
-    return true;
+// Display name with formatting codes and runs of whitespace removed.
+static std::string CleanPlayerDisplayName(std::string name) {
+    TrimNameWhitespace(name);
+    return NormalizeNameSpaces(StripMinecraftFormattingCodes(name));
 }
 
-static bool LooksLikeFakePlayerLine(const std::string& rawName) {
-    std::string name = NormalizeNameSpaces(StripMinecraftFormattingCodes(rawName));
-    if (name.empty()) return true;
-
-    bool anyAlnum = false;
-    bool anyNonDecor = false;
-    int alnumCount = 0;
-    for (char ch : name) {
-        unsigned char c = (unsigned char)ch;
-        if (std::isalnum(c)) {
-            anyAlnum = true;
-            anyNonDecor = true;
-            alnumCount++;
-            continue;
-        }
-        if (ch == '_' || ch == ' ') {
-            anyNonDecor = true;
-            continue;
-        }
-        if (ch == '-' || ch == '=' || ch == '[' || ch == ']' || ch == '(' || ch == ')' || ch == '<' || ch == '>' || ch == '|' || ch == '*' || ch == '~' || ch == ':') {
-            continue;
-        }
-        anyNonDecor = true;
-    }
-
-    if (!anyNonDecor) return true;
-    if (!anyAlnum && name != "_") return true;
-    if (alnumCount < 2 && !IsLikelyProfileName(name)) return true;
-    return false;
-}
 
 static std::string GetStablePlayerName(JNIEnv* env, jobject playerObj) {
     if (!env || !playerObj) return "";
@@ -1055,14 +1372,7 @@ static std::string GetStablePlayerName(JNIEnv* env, jobject playerObj) {
         if (textObj) env->DeleteLocalRef(textObj);
     }
 
-    auto trim = [](std::string& s) {
-        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r' || s.back() == '\n')) s.pop_back();
-        size_t i = 0;
-        while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n')) i++;
-        if (i > 0) s.erase(0, i);
-    };
-    trim(name);
-    std::string cleanDisplay = NormalizeNameSpaces(StripMinecraftFormattingCodes(name));
+    std::string cleanDisplay = CleanPlayerDisplayName(name);
 
     // If display name looks sane, use it directly.
     if (!LooksLikeFakePlayerLine(cleanDisplay)) return cleanDisplay;
@@ -1085,13 +1395,76 @@ static std::string GetStablePlayerName(JNIEnv* env, jobject playerObj) {
         env->DeleteLocalRef(js);
     }
     env->DeleteLocalRef(gp);
-    trim(profileName);
-    if (IsLikelyProfileName(profileName)) return profileName;
+    return StableProfileName(profileName);
+}
+
+// ---- Player name cache ----
+// GetStablePlayerName() costs a Text->String conversion and several string
+// passes, and names almost never change.  Entries are keyed by Entity.getId();
+// a weak global ref confirms the id still belongs to the same entity object.
+// A name is re-read after kPlayerNameRefreshMs, entries not looked up for
+// kPlayerNameEvictMs are dropped, and the cache is cleared with the AutoTotem
+// caches on world change.  Scan thread only.
+struct PlayerNameEntry121 {
+    jweak       ref;
+    std::string name;
+    DWORD       fetchedMs;
+    DWORD       seenMs;
+};
+static std::unordered_map<int, PlayerNameEntry121> g_playerNameCache121;
+static DWORD g_lastPlayerNameSweepMs121 = 0;
+static const DWORD kPlayerNameRefreshMs = 5000;
+static const DWORD kPlayerNameEvictMs = 30000;
+
+static void ResetPlayerNameCache121(JNIEnv* env) {
+    if (env) {
+        for (auto& kv : g_playerNameCache121)
+            if (kv.second.ref) RefLedger::Delete(env, kv.second.ref);
+    }
+    g_playerNameCache121.clear();
+}
+
+// *idOut receives the entity id the lookup used, -1 when there was none.
+static std::string GetCachedPlayerName(JNIEnv* env, jobject playerObj, int* idOut = nullptr) {
+    if (idOut) *idOut = -1;
+    if (!env || !playerObj) return "";
+    if (!g_getEntityId_121) return GetStablePlayerName(env, playerObj);
+    jint id = env->CallIntMethod(playerObj, g_getEntityId_121);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return GetStablePlayerName(env, playerObj); }
+    if (idOut) *idOut = (int)id;
+
+    DWORD now = GetTickCount();
+    if (now - g_lastPlayerNameSweepMs121 >= kPlayerNameEvictMs) {
+        g_lastPlayerNameSweepMs121 = now;
+        for (auto it = g_playerNameCache121.begin(); it != g_playerNameCache121.end(); ) {
+            if (now - it->second.seenMs >= kPlayerNameEvictMs) {
+                if (it->second.ref) RefLedger::Delete(env, it->second.ref);
+                it = g_playerNameCache121.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    auto it = g_playerNameCache121.find(id);
+    bool sameObj = it != g_playerNameCache121.end() && it->second.ref
+        && env->IsSameObject(it->second.ref, playerObj) == JNI_TRUE;
+    if (sameObj) {
+        it->second.seenMs = now;
+        if (now - it->second.fetchedMs < kPlayerNameRefreshMs) return it->second.name;
+    }
 
-    // Last fallback: if cleaned display had useful content but profile name lookup failed,
-    // keep the cleaned display rather than dropping everything.
-    if (!cleanDisplay.empty() && !LooksLikeFakePlayerLine(cleanDisplay)) return cleanDisplay;
-    return "";
+    std::string name = GetStablePlayerName(env, playerObj);
+    PlayerNameEntry121& e = g_playerNameCache121[id];
+    if (!sameObj) {
+        if (e.ref) RefLedger::Delete(env, e.ref);
+        e.ref = LC_NEW_WEAK_REF(env, playerObj, s_refPlayers121);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); e.ref = nullptr; }
+    }
+    e.name = name;
+    e.fetchedMs = now;
+    e.seenMs = now;
+    return name;
 }
 
 // HitResult / crosshair target caches (for lookingAtBlock)
@@ -1116,7 +1489,7 @@ static void EnsureHitResultCaches(JNIEnv* env) {
             if (env->ExceptionCheck()) env->ExceptionClear();
             TRACE261_BRANCH("hitResultClassCandidateHit", c != nullptr);
             if (c) {
-                g_hitResultClass_121 = (jclass)env->NewGlobalRef(c);
+                g_hitResultClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refCore121);
                 TRACE261_VALUE("hitResultClassSource", names[i]);
                 env->DeleteLocalRef(c);
             }
@@ -1136,7 +1509,7 @@ static void EnsureHitResultCaches(JNIEnv* env) {
             if (env->ExceptionCheck()) env->ExceptionClear();
             TRACE261_BRANCH("blockHitResultClassCandidateHit", c != nullptr);
             if (c) {
-                g_blockHitResultClass_121 = (jclass)env->NewGlobalRef(c);
+                g_blockHitResultClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refCore121);
                 TRACE261_VALUE("blockHitResultClassSource", names[i]);
                 env->DeleteLocalRef(c);
                 break;
@@ -1243,6 +1616,19 @@ static bool IsJavaList(JNIEnv* env, jobject obj) {
     return ok;
 }
 
+// Whether a type name from the member index is `base` or a subtype of it.
+// Primitives never are; other names are loaded through the game loader.
+static bool IndexedTypeIsA121(JNIEnv* env, const std::string& typeName, jclass base) {
+    if (!base || MemberIndex::Descriptor(typeName).size() == 1) return false;
+    jclass t = LoadClassWithLoader(env, g_gameClassLoader, typeName.c_str());
+    if (env->ExceptionCheck()) { env->ExceptionClear(); t = nullptr; }
+    if (!t) return false;
+    bool is = env->IsAssignableFrom(t, base) == JNI_TRUE;
+    if (env->ExceptionCheck()) { env->ExceptionClear(); is = false; }
+    env->DeleteLocalRef(t);
+    return is;
+}
+
 static jmethodID FindZeroArgMethodReturning(JNIEnv* env, jclass owner, const std::string& returnTypeName, const char* preferredName1, const char* preferredName2, const char* sig) {
     if (!owner) return nullptr;
 
@@ -1257,71 +1643,16 @@ static jmethodID FindZeroArgMethodReturning(JNIEnv* env, jclass owner, const std
         env->ExceptionClear();
     }
 
-    // Reflection scan fallback: find a 0-arg method with the expected return type.
-    jclass cClass = env->FindClass("java/lang/Class");
-    jmethodID mGetMethods = cClass ? env->GetMethodID(cClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mGetMethods = nullptr; }
-
-    jclass cMethod = env->FindClass("java/lang/reflect/Method");
-    jmethodID mParams = cMethod ? env->GetMethodID(cMethod, "getParameterTypes", "()[Ljava/lang/Class;") : nullptr;
-    jmethodID mRet    = cMethod ? env->GetMethodID(cMethod, "getReturnType", "()Ljava/lang/Class;") : nullptr;
-    jmethodID mName   = cMethod ? env->GetMethodID(cMethod, "getName", "()Ljava/lang/String;") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mParams = nullptr; mRet = nullptr; mName = nullptr; }
-
-    if (!cClass || !cMethod || !mGetMethods || !mParams || !mRet || !mName) {
-        env->ExceptionClear();
-        if (cClass) env->DeleteLocalRef(cClass);
-        if (cMethod) env->DeleteLocalRef(cMethod);
-        return nullptr;
-    }
-
-    jobjectArray methods = (jobjectArray)env->CallObjectMethod(owner, mGetMethods);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); methods = nullptr; }
-    if (!methods) {
-        env->DeleteLocalRef(cClass);
-        env->DeleteLocalRef(cMethod);
-        return nullptr;
-    }
-
-    jsize mc = env->GetArrayLength(methods);
-    for (int i = 0; i < mc; i++) {
-        jobject m = env->GetObjectArrayElement(methods, i);
-        if (!m) continue;
-        jobjectArray params = (jobjectArray)env->CallObjectMethod(m, mParams);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); params = nullptr; }
-        if (!params) { env->DeleteLocalRef(m); continue; }
-        if (env->GetArrayLength(params) != 0) { env->DeleteLocalRef(params); env->DeleteLocalRef(m); continue; }
-        env->DeleteLocalRef(params);
-
-        jclass rt = (jclass)env->CallObjectMethod(m, mRet);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); rt = nullptr; }
-        if (!rt) { env->DeleteLocalRef(m); continue; }
-        std::string rtn = GetClassNameFromClass(env, rt);
-        env->DeleteLocalRef(rt);
-        if (rtn != returnTypeName) { env->DeleteLocalRef(m); continue; }
-
-        jstring jmn = (jstring)env->CallObjectMethod(m, mName);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); jmn = nullptr; }
-        if (!jmn) { env->DeleteLocalRef(m); continue; }
-        const char* cmn = env->GetStringUTFChars(jmn, nullptr);
-        std::string name = cmn ? cmn : "";
-        if (cmn) env->ReleaseStringUTFChars(jmn, cmn);
-        env->DeleteLocalRef(jmn);
-
-        jmethodID mid = env->GetMethodID(owner, name.c_str(), sig);
+    // Reflection fallback: find a 0-arg method with the expected return type.
+    MemberIndex::Query q(env);
+    const std::vector<MemberIndex::Method>& methods = q.Methods(owner);
+    for (size_t i = 0; i < methods.size(); i++) {
+        const MemberIndex::Method& m = methods[i];
+        if (!m.params.empty() || *m.ret != returnTypeName) continue;
+        jmethodID mid = env->GetMethodID(owner, m.name->c_str(), sig);
         if (env->ExceptionCheck()) { env->ExceptionClear(); mid = nullptr; }
-        env->DeleteLocalRef(m);
-        if (mid) {
-            env->DeleteLocalRef(methods);
-            env->DeleteLocalRef(cClass);
-            env->DeleteLocalRef(cMethod);
-            return mid;
-        }
+        if (mid) return mid;
     }
-
-    env->DeleteLocalRef(methods);
-    env->DeleteLocalRef(cClass);
-    env->DeleteLocalRef(cMethod);
     return nullptr;
 }
 
@@ -1339,79 +1670,22 @@ static jmethodID FindZeroArgMethodReturningClass(JNIEnv* env, jclass owner, jcla
         env->ExceptionClear();
     }
 
-    // Reflection scan fallback: find a 0-arg method with the exact expected return type class.
-    jclass cClass = env->FindClass("java/lang/Class");
-    jmethodID mGetMethods = cClass ? env->GetMethodID(cClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mGetMethods = nullptr; }
-
-    jclass cMethod = env->FindClass("java/lang/reflect/Method");
-    jmethodID mParams = cMethod ? env->GetMethodID(cMethod, "getParameterTypes", "()[Ljava/lang/Class;") : nullptr;
-    jmethodID mRet    = cMethod ? env->GetMethodID(cMethod, "getReturnType", "()Ljava/lang/Class;") : nullptr;
-    jmethodID mName   = cMethod ? env->GetMethodID(cMethod, "getName", "()Ljava/lang/String;") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mParams = nullptr; mRet = nullptr; mName = nullptr; }
-
-    if (!cClass || !cMethod || !mGetMethods || !mParams || !mRet || !mName) {
-        env->ExceptionClear();
-        if (cClass) env->DeleteLocalRef(cClass);
-        if (cMethod) env->DeleteLocalRef(cMethod);
-        return nullptr;
-    }
-
-    jobjectArray methods = (jobjectArray)env->CallObjectMethod(owner, mGetMethods);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); methods = nullptr; }
-    if (!methods) {
-        env->DeleteLocalRef(cClass);
-        env->DeleteLocalRef(cMethod);
-        return nullptr;
-    }
-
-    jsize mc = env->GetArrayLength(methods);
-    for (int i = 0; i < mc; i++) {
-        jobject m = env->GetObjectArrayElement(methods, i);
-        if (!m) continue;
-        jobjectArray params = (jobjectArray)env->CallObjectMethod(m, mParams);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); params = nullptr; }
-        if (!params) { env->DeleteLocalRef(m); continue; }
-        if (env->GetArrayLength(params) != 0) { env->DeleteLocalRef(params); env->DeleteLocalRef(m); continue; }
-        env->DeleteLocalRef(params);
-
-        jclass rt = (jclass)env->CallObjectMethod(m, mRet);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); rt = nullptr; }
-        if (!rt) { env->DeleteLocalRef(m); continue; }
-        
-        bool match = env->IsSameObject(rt, expectedRetClass);
-        env->DeleteLocalRef(rt);
-        if (!match) { env->DeleteLocalRef(m); continue; }
-
-        jstring jmn = (jstring)env->CallObjectMethod(m, mName);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); jmn = nullptr; }
-        if (!jmn) { env->DeleteLocalRef(m); continue; }
-        const char* cmn = env->GetStringUTFChars(jmn, nullptr);
-        std::string name = cmn ? cmn : "";
-        if (cmn) env->ReleaseStringUTFChars(jmn, cmn);
-        env->DeleteLocalRef(jmn);
-
-        // We found a method returning exactly the right class!
-        // We still need its signature, since the return type might be obfuscated. 
-        // Calling GetMethodID with the original sig might fail.
-        // Wait, if we found it through reflection, we can just get the method ID by calling env->FromReflectedMethod(m)!
-        jmethodID mid = env->FromReflectedMethod(m);
-        env->DeleteLocalRef(m);
-        if (mid) {
-            env->DeleteLocalRef(methods);
-            env->DeleteLocalRef(cClass);
-            env->DeleteLocalRef(cMethod);
-            return mid;
-        }
+    // Reflection fallback: find a 0-arg method with the exact expected return type class.
+    const std::string expected = GetClassNameFromClass(env, expectedRetClass);
+    if (expected.empty()) return nullptr;
+    MemberIndex::Query q(env);
+    const std::vector<MemberIndex::Method>& methods = q.Methods(owner);
+    for (size_t i = 0; i < methods.size(); i++) {
+        const MemberIndex::Method& m = methods[i];
+        // The return type may be obfuscated, so `sig` need not match: use the
+        // reflected method's own ID.
+        if (m.params.empty() && m.id && *m.ret == expected) return m.id;
     }
-
-    env->DeleteLocalRef(methods);
-    env->DeleteLocalRef(cClass);
-    env->DeleteLocalRef(cMethod);
     return nullptr;
 }
 
 static jclass g_chestBlockEntityClasses[4] = { nullptr, nullptr, nullptr, nullptr };
+static bool g_chestBlockEntityClassesTried = false;
 
 static bool IsChestLikeToken(const std::string& valueLower) {
     return valueLower.find("chest") != std::string::npos
@@ -1438,7 +1712,7 @@ static void EnsureChestStateDetectionCaches(JNIEnv* env, jobject be) {
                 c = env->FindClass(alt.c_str());
                 if (env->ExceptionCheck()) { env->ExceptionClear(); c = nullptr; }
             }
-            if (c) { g_blockStateClass_121 = (jclass)env->NewGlobalRef(c); env->DeleteLocalRef(c); }
+            if (c) { g_blockStateClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refChestEsp121); env->DeleteLocalRef(c); }
         }
     }
     if (!g_blockClass_121) {
@@ -1457,7 +1731,7 @@ static void EnsureChestStateDetectionCaches(JNIEnv* env, jobject be) {
                 c = env->FindClass(alt.c_str());
                 if (env->ExceptionCheck()) { env->ExceptionClear(); c = nullptr; }
             }
-            if (c) { g_blockClass_121 = (jclass)env->NewGlobalRef(c); env->DeleteLocalRef(c); }
+            if (c) { g_blockClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refChestEsp121); env->DeleteLocalRef(c); }
         }
     }
 
@@ -1512,13 +1786,9 @@ static void EnsureChestStateDetectionCaches(JNIEnv* env, jobject be) {
     }
 }
 
-static bool IsChestBlockEntity(JNIEnv* env, jobject be) {
-    if (!env || !be) return false;
-    
-    static bool init = false;
-    static bool s_initLogged = false;
-    if (!init) {
-        init = true;
+static void EnsureChestBlockEntityClasses(JNIEnv* env) {
+    if (!g_chestBlockEntityClassesTried) {
+        g_chestBlockEntityClassesTried = true;
         const char* yarn[] = { "net.minecraft.class_2595", "net.minecraft.class_2611", "net.minecraft.class_3719", "net.minecraft.class_2627" };
         const char* moj[]  = { "net.minecraft.world.level.block.entity.ChestBlockEntity", "net.minecraft.world.level.block.entity.EnderChestBlockEntity", "net.minecraft.world.level.block.entity.BarrelBlockEntity", "net.minecraft.world.level.block.entity.ShulkerBoxBlockEntity" };
         
@@ -1536,10 +1806,17 @@ static bool IsChestBlockEntity(JNIEnv* env, jobject be) {
                 c = env->FindClass(alt.c_str());
                 if (env->ExceptionCheck()) { env->ExceptionClear(); c = nullptr; }
             }
-            if (c) { g_chestBlockEntityClasses[i] = (jclass)env->NewGlobalRef(c); env->DeleteLocalRef(c); }
+            if (c) { g_chestBlockEntityClasses[i] = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refChestEsp121); env->DeleteLocalRef(c); }
         }
         Log("IsChestBlockEntity init: classes loaded = " + std::to_string(g_chestBlockEntityClasses[0] ? 1 : 0) + "," + std::to_string(g_chestBlockEntityClasses[1] ? 1 : 0) + "," + std::to_string(g_chestBlockEntityClasses[2] ? 1 : 0) + "," + std::to_string(g_chestBlockEntityClasses[3] ? 1 : 0));
     }
+}
+
+static bool IsChestBlockEntity(JNIEnv* env, jobject be) {
+    if (!env || !be) return false;
+
+    static bool s_initLogged = false;
+    EnsureChestBlockEntityClasses(env);
 
     // Diagnostic: log BE class name on first call
     if (!s_initLogged) {
@@ -1618,86 +1895,29 @@ static jobject   g_entityReachIdentifier_121 = nullptr; // minecraft:player.enti
 static jobject   g_blockReachIdentifier_121 = nullptr; // minecraft:player.block_interaction_range
 
 static jmethodID FindMethodBySignature(JNIEnv* env, jclass tgtCls, const std::string& retTypeStr, int paramCount, const std::string& p1TypeStr = "") {
-    jclass cClass = env->FindClass("java/lang/Class");
-    jclass cMethod = env->FindClass("java/lang/reflect/Method");
-    jmethodID mGetMethods = env->GetMethodID(cClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;");
-    jmethodID mGetName = env->GetMethodID(cMethod, "getName", "()Ljava/lang/String;");
-    jmethodID mGetRetType = env->GetMethodID(cMethod, "getReturnType", "()Ljava/lang/Class;");
-    jmethodID mGetParamTypes = env->GetMethodID(cMethod, "getParameterTypes", "()[Ljava/lang/Class;");
-
-    jobjectArray methods = (jobjectArray)env->CallObjectMethod(tgtCls, mGetMethods);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); methods = nullptr; }
-    if (!methods) return nullptr;
-    
-    jsize count = env->GetArrayLength(methods);
-    jmethodID found = nullptr;
-    
-    for (int i=0; i<count; ++i) {
-        jobject m = env->GetObjectArrayElement(methods, i);
-        if (!m) continue;
-        jclass rType = (jclass)env->CallObjectMethod(m, mGetRetType);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); rType = nullptr; }
-        jobjectArray pTypes = (jobjectArray)env->CallObjectMethod(m, mGetParamTypes);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); pTypes = nullptr; }
-        jsize pCount = pTypes ? env->GetArrayLength(pTypes) : 0;
-        
-        if (pCount == paramCount) {
-            std::string rName = rType ? GetClassNameFromClass(env, rType) : "";
-            if (rName == retTypeStr || (retTypeStr == "V" && rName == "void") || (retTypeStr == "D" && rName == "double") || (retTypeStr == "Z" && rName == "boolean")) {
-                bool pMatch = true;
-                if (paramCount == 1 && !p1TypeStr.empty() && pTypes) {
-                    jclass p1Cls = (jclass)env->GetObjectArrayElement(pTypes, 0);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); p1Cls = nullptr; }
-                    std::string p1Name = p1Cls ? GetClassNameFromClass(env, p1Cls) : "";
-                    if (p1Name != p1TypeStr && !(p1TypeStr == "D" && p1Name == "double")) {
-                        pMatch = false;
-                    }
-                    if (p1Cls) env->DeleteLocalRef(p1Cls);
-                }
-                if (pMatch) {
-                    jstring nameStr = (jstring)env->CallObjectMethod(m, mGetName);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); nameStr = nullptr; }
-                    if (nameStr) {
-                        const char* nameC = env->GetStringUTFChars(nameStr, nullptr);
-                        
-                        std::string sig = "(";
-                        if (paramCount == 1 && p1TypeStr == "D") sig += "D";
-                        else if (paramCount == 1) {
-                            std::string fixedP = p1TypeStr;
-                            for(size_t pos=0; pos<fixedP.length(); pos++) { if (fixedP[pos] == '.') fixedP[pos] = '/'; }
-                            sig += "L" + fixedP + ";";
-                        }
-                        sig += ")";
-                        
-                        if (retTypeStr == "V") sig += "V";
-                        else if (retTypeStr == "D") sig += "D";
-                        else if (retTypeStr == "Z") sig += "Z";
-                        else {
-                            std::string fixedR = retTypeStr;
-                            for(size_t pos=0; pos<fixedR.length(); pos++) { if (fixedR[pos] == '.') fixedR[pos] = '/'; }
-                            sig += "L" + fixedR + ";";
-                        }
-                        
-                        found = env->GetMethodID(tgtCls, nameC, sig.c_str());
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); found = nullptr; }
-                        
-                        if (found) Log("FindMethodBySignature: Found " + std::string(nameC) + sig);
-                        
-                        env->ReleaseStringUTFChars(nameStr, nameC);
-                        env->DeleteLocalRef(nameStr);
-                    }
-                }
-            }
+    if (!tgtCls) return nullptr;
+    // "V" / "D" / "Z" stand for the primitive they name.
+    struct Local {
+        static bool TypeMatches(const std::string& have, const std::string& want) {
+            return have == want || (want == "V" && have == "void") || (want == "D" && have == "double") || (want == "Z" && have == "boolean");
+        }
+    };
+
+    MemberIndex::Query q(env);
+    const std::vector<MemberIndex::Method>& methods = q.Methods(tgtCls);
+    for (size_t i = 0; i < methods.size(); i++) {
+        const MemberIndex::Method& m = methods[i];
+        if ((int)m.params.size() != paramCount || !Local::TypeMatches(*m.ret, retTypeStr)) continue;
+        if (paramCount == 1 && !p1TypeStr.empty() && !Local::TypeMatches(*m.params[0], p1TypeStr)) continue;
+
+        jmethodID found = env->GetMethodID(tgtCls, m.name->c_str(), m.sig->c_str());
+        if (env->ExceptionCheck()) { env->ExceptionClear(); found = nullptr; }
+        if (found) {
+            Log("FindMethodBySignature: Found " + *m.name + *m.sig);
+            return found;
         }
-        if (rType) env->DeleteLocalRef(rType);
-        if (pTypes) env->DeleteLocalRef(pTypes);
-        env->DeleteLocalRef(m);
-        if (found) break;
     }
-    env->DeleteLocalRef(methods);
-    env->DeleteLocalRef(cMethod);
-    env->DeleteLocalRef(cClass);
-    return found;
+    return nullptr;
 }
 
 static void EnsureClosestPlayerCaches(JNIEnv* env);
@@ -1708,13 +1928,18 @@ static bool AreNametagSuppressionRestoreMappingsReady121();
 static void LogNametagSuppressionMissingMappings121(JNIEnv* env, jobject worldObj);
 static void ResetNametagSuppressionCaches121(JNIEnv* env, const char* reason);
 static void ResetAutoTotemCaches(JNIEnv* env);
+static bool EnsureHelperBridgeLoaded121(JNIEnv* env);
 static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason);
+static void DiscardPendingRemap121(JNIEnv* env);
 static bool TrackSuppressionWorldContext121(JNIEnv* env, jobject worldObj);
 static bool EnsureNametagSuppressionTeamMappings121(JNIEnv* env, jobject worldObj);
 static jobject GetScoreboard121(JNIEnv* env, jobject worldObj);
 static jobject EnsureNametagHideTeam121(JNIEnv* env, jobject scoreboardObj);
 static bool ApplyVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj, jobject hideTeamObj, const std::string& playerName);
 static void RestoreVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj);
+static void SyncNametagSuppression121(JNIEnv* env, jobject scoreboardObj, jobject hideTeamObj,
+                                      const std::vector<std::string>& names, DWORD now,
+                                      bool& attempted, bool& applied);
 
 static std::string NormalizeReachKey(const std::string& raw) {
     std::string out;
@@ -1775,7 +2000,7 @@ static void EnsureReachIdentifiers(JNIEnv* env) {
             if (env->ExceptionCheck()) { env->ExceptionClear(); idCls = nullptr; }
         }
         if (idCls) {
-            g_identifierClass_121 = (jclass)env->NewGlobalRef(idCls);
+            g_identifierClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, idCls, s_refReach121);
             env->DeleteLocalRef(idCls);
         }
     }
@@ -1826,7 +2051,7 @@ static void EnsureReachIdentifiers(JNIEnv* env) {
         if (!id) id = makeId("player.entity_interaction_range");
         if (id) {
             Log("EnsureReachIdentifiers: entity identifier = " + SafeObjectToString(env, id));
-            g_entityReachIdentifier_121 = env->NewGlobalRef(id);
+            g_entityReachIdentifier_121 = LC_NEW_GLOBAL_REF(env, id, s_refReach121);
             env->DeleteLocalRef(id);
         } else {
             Log("EnsureReachIdentifiers: FAILED to create entity reach identifier.");
@@ -1838,7 +2063,7 @@ static void EnsureReachIdentifiers(JNIEnv* env) {
         if (!id) id = makeId("player.block_interaction_range");
         if (id) {
             Log("EnsureReachIdentifiers: block identifier = " + SafeObjectToString(env, id));
-            g_blockReachIdentifier_121 = env->NewGlobalRef(id);
+            g_blockReachIdentifier_121 = LC_NEW_GLOBAL_REF(env, id, s_refReach121);
             env->DeleteLocalRef(id);
         } else {
             Log("EnsureReachIdentifiers: FAILED to create block reach identifier.");
@@ -1895,53 +2120,37 @@ static jobject TryResolveReachAttributeFromRegistry(JNIEnv* env, jobject attrCon
     std::string bestLabel;
     std::vector<std::string> sampledLabels;
 
-    jclass cClass = env->FindClass("java/lang/Class");
-    jclass cField = env->FindClass("java/lang/reflect/Field");
-    jclass cMod = env->FindClass("java/lang/reflect/Modifier");
-    jmethodID mGetFields = cClass ? env->GetMethodID(cClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;") : nullptr;
-    jmethodID mFType = cField ? env->GetMethodID(cField, "getType", "()Ljava/lang/Class;") : nullptr;
-    jmethodID mFMod = cField ? env->GetMethodID(cField, "getModifiers", "()I") : nullptr;
-    jmethodID mFGet = cField ? env->GetMethodID(cField, "get", "(Ljava/lang/Object;)Ljava/lang/Object;") : nullptr;
-    jmethodID mIsStatic = cMod ? env->GetStaticMethodID(cMod, "isStatic", "(I)Z") : nullptr;
-    if (env->ExceptionCheck()) {
-        env->ExceptionClear();
-        mGetFields = mFType = mFMod = mFGet = mIsStatic = nullptr;
-    }
-
-    jobjectArray fields = nullptr;
     jclass regEntryCls = nullptr;
     int scannedFields = 0;
     int scannedEntries = 0;
-    if (mGetFields && mFType && mFMod && mFGet && mIsStatic) {
-        fields = (jobjectArray)env->CallObjectMethod(attrsCls, mGetFields);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); fields = nullptr; }
+    {
         const char* regEntryNames[] = { "net.minecraft.core.Holder", "net.minecraft.class_6880", nullptr };
         for (int i = 0; regEntryNames[i] && !regEntryCls; i++) {
             regEntryCls = LoadClassWithLoader(env, g_gameClassLoader, regEntryNames[i]);
             if (env->ExceptionCheck()) { env->ExceptionClear(); regEntryCls = nullptr; }
         }
-        if (fields && regEntryCls) {
-            jsize fc = env->GetArrayLength(fields);
-            for (int i = 0; i < fc; ++i) {
-                jobject fld = env->GetObjectArrayElement(fields, i);
-                if (!fld) continue;
+        MemberIndex::Query q(env);
+        const std::vector<MemberIndex::Field>& fields = q.Fields(attrsCls);
+        if (!fields.empty() && regEntryCls) {
+            // Attributes declares dozens of fields of one or two types.
+            std::vector<std::pair<const std::string*, bool> > entryTypes;
+            for (size_t i = 0; i < fields.size(); ++i) {
+                const MemberIndex::Field& fd = fields[i];
                 ++scannedFields;
+                if (!fd.IsStatic() || !fd.id) continue;
+
+                int known = -1;
+                for (size_t t = 0; t < entryTypes.size() && known < 0; t++)
+                    if (entryTypes[t].first == fd.type) known = entryTypes[t].second ? 1 : 0;
+                if (known < 0) {
+                    known = IndexedTypeIsA121(env, *fd.type, regEntryCls) ? 1 : 0;
+                    entryTypes.push_back(std::make_pair(fd.type, known == 1));
+                }
+                if (!known) continue;
 
-                jint mod = env->CallIntMethod(fld, mFMod);
-                if (env->ExceptionCheck()) { env->ExceptionClear(); env->DeleteLocalRef(fld); continue; }
-                bool isStatic = (env->CallStaticBooleanMethod(cMod, mIsStatic, mod) == JNI_TRUE);
-                if (env->ExceptionCheck()) { env->ExceptionClear(); env->DeleteLocalRef(fld); continue; }
-                if (!isStatic) { env->DeleteLocalRef(fld); continue; }
-
-                jclass ft = (jclass)env->CallObjectMethod(fld, mFType);
-                if (env->ExceptionCheck()) { env->ExceptionClear(); ft = nullptr; }
-                bool isRegistryEntry = (ft && env->IsAssignableFrom(ft, regEntryCls));
-                if (ft) env->DeleteLocalRef(ft);
-                if (!isRegistryEntry) { env->DeleteLocalRef(fld); continue; }
-
-                jobject registryEntry = env->CallObjectMethod(fld, mFGet, nullptr);
+                jobject registryEntry = env->GetStaticObjectField(attrsCls, fd.id);
                 if (env->ExceptionCheck()) { env->ExceptionClear(); registryEntry = nullptr; }
-                if (!registryEntry) { env->DeleteLocalRef(fld); continue; }
+                if (!registryEntry) continue;
                 ++scannedEntries;
 
                 bool isEntityReachEntry = false;
@@ -1959,7 +2168,6 @@ static jobject TryResolveReachAttributeFromRegistry(JNIEnv* env, jobject attrCon
 
                 if (isBlockReachEntry) {
                     env->DeleteLocalRef(registryEntry);
-                    env->DeleteLocalRef(fld);
                     continue;
                 }
 
@@ -1972,7 +2180,6 @@ static jobject TryResolveReachAttributeFromRegistry(JNIEnv* env, jobject attrCon
                         bestLabel = "identifier:player.entity_interaction_range";
                     }
                     env->DeleteLocalRef(registryEntry);
-                    env->DeleteLocalRef(fld);
                     continue;
                 }
 
@@ -2014,7 +2221,6 @@ static jobject TryResolveReachAttributeFromRegistry(JNIEnv* env, jobject attrCon
                 if (IsBlockReachKey(lookupLabel)) {
                     if (instCandidate) env->DeleteLocalRef(instCandidate);
                     env->DeleteLocalRef(registryEntry);
-                    env->DeleteLocalRef(fld);
                     continue;
                 }
 
@@ -2038,7 +2244,6 @@ static jobject TryResolveReachAttributeFromRegistry(JNIEnv* env, jobject attrCon
                 }
 
                 env->DeleteLocalRef(registryEntry);
-                env->DeleteLocalRef(fld);
             }
         }
     }
@@ -2061,10 +2266,6 @@ static jobject TryResolveReachAttributeFromRegistry(JNIEnv* env, jobject attrCon
     }
 
     if (regEntryCls) env->DeleteLocalRef(regEntryCls);
-    if (fields) env->DeleteLocalRef(fields);
-    if (cMod) env->DeleteLocalRef(cMod);
-    if (cField) env->DeleteLocalRef(cField);
-    if (cClass) env->DeleteLocalRef(cClass);
     env->DeleteLocalRef(objCls);
     env->DeleteLocalRef(attrsCls);
     return bestInst;
@@ -2165,20 +2366,20 @@ static void UpdateReach(JNIEnv* env, const Config& cfg) {
 
     if (!selfObj) {
         if (g_cachedReachAttrInst) {
-            env->DeleteGlobalRef(g_cachedReachAttrInst);
+            RefLedger::Delete(env, g_cachedReachAttrInst);
             g_cachedReachAttrInst = nullptr;
         }
         if (g_cachedLocalPlayer) {
-            env->DeleteGlobalRef(g_cachedLocalPlayer);
+            RefLedger::Delete(env, g_cachedLocalPlayer);
             g_cachedLocalPlayer = nullptr;
         }
         return;
     }
 
     if (!g_cachedLocalPlayer || !env->IsSameObject(selfObj, g_cachedLocalPlayer)) {
-        if (g_cachedLocalPlayer) env->DeleteGlobalRef(g_cachedLocalPlayer);
-        if (g_cachedReachAttrInst) env->DeleteGlobalRef(g_cachedReachAttrInst);
-        g_cachedLocalPlayer = env->NewGlobalRef(selfObj);
+        if (g_cachedLocalPlayer) RefLedger::Delete(env, g_cachedLocalPlayer);
+        if (g_cachedReachAttrInst) RefLedger::Delete(env, g_cachedReachAttrInst);
+        g_cachedLocalPlayer = LC_NEW_GLOBAL_REF(env, selfObj, s_refReach121);
         g_cachedReachAttrInst = nullptr;
 
         jobject attrCont = env->CallObjectMethod(selfObj, g_dynGetAttributes);
@@ -2186,7 +2387,7 @@ static void UpdateReach(JNIEnv* env, const Config& cfg) {
         if (attrCont) {
             jobject directInst = TryResolveReachAttributeFromRegistry(env, attrCont);
             if (directInst) {
-                g_cachedReachAttrInst = env->NewGlobalRef(directInst);
+                g_cachedReachAttrInst = LC_NEW_GLOBAL_REF(env, directInst, s_refReach121);
                 env->DeleteLocalRef(directInst);
             }
 
@@ -2533,6 +2734,7 @@ static void ResetSpeedBridgeMovementTracking121() {
     g_speedBridgeHaveLastPos_121 = false;
     g_speedBridgeDirX_121 = 0;
     g_speedBridgeDirZ_121 = 0;
+    g_speedBridgeGrid_121.Invalidate();
 }
 
 static void UpdateSpeedBridgeDirection121(double posX, double posZ) {
@@ -2577,7 +2779,7 @@ static void EnsureSpeedBridgeBlockProbeJni(JNIEnv* env, jobject worldObj, jobjec
             jclass c = LoadClassWithLoader(env, g_gameClassLoader, names[i]);
             if (env->ExceptionCheck()) { env->ExceptionClear(); c = nullptr; }
             if (c) {
-                g_blockPosClass_121 = (jclass)env->NewGlobalRef(c);
+                g_blockPosClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refCore121);
                 env->DeleteLocalRef(c);
             }
         }
@@ -2677,13 +2879,41 @@ static bool IsSolidBlockAt121(JNIEnv* env, double x, double y, double z) {
     return solid;
 }
 
+// Grid stamp: the player's tickCount from the state sampler, or 50 ms of wall
+// time while the sampler has none.  The top bit keeps the two clocks apart.
+static unsigned long long SpeedBridgeGridStamp121() {
+    unsigned tick = 0;
+    {
+        LockGuard lk(g_jniStateMtx);
+        tick = g_jniTick;
+    }
+    if (tick) return tick;
+    return (GetTickCount64() / 50) | (1ULL << 63);
+}
+
+// IsSolidBlockAt121 answered from g_speedBridgeGrid_121 when the cell was
+// already probed this tick.  Failed probes (probe JNI unresolved) are not
+// cached so a later resolve is picked up at once.
+static bool IsSolidBlockCached121(JNIEnv* env, double x, double y, double z) {
+    int bx = (int)std::floor(x);
+    int by = (int)std::floor(y);
+    int bz = (int)std::floor(z);
+    int cell = g_speedBridgeGrid_121.Get(bx, by, bz);
+    if (cell != lc::BlockGrid::CELL_UNKNOWN) return cell == lc::BlockGrid::CELL_SOLID;
+
+    bool solid = IsSolidBlockAt121(env, x, y, z);
+    if (g_speedBridgeWorldGetBlockState_121 && g_speedBridgeBlockStateIsAir_121)
+        g_speedBridgeGrid_121.Put(bx, by, bz, solid);
+    return solid;
+}
+
 static bool IsSpeedBridgeEdgeUnsupported121(JNIEnv* env, const Config& cfg, double posX, double posY, double posZ) {
     if (g_speedBridgeDirX_121 == 0 && g_speedBridgeDirZ_121 == 0) return false;
     double probe = SpeedBridgeSupportProbeDistance121(cfg);
     double sx = posX + (double)g_speedBridgeDirX_121 * probe;
     double sz = posZ + (double)g_speedBridgeDirZ_121 * probe;
     double sy = posY - 0.05;
-    return !IsSolidBlockAt121(env, sx, sy, sz);
+    return !IsSolidBlockCached121(env, sx, sy, sz);
 }
 
 static void UpdateSpeedBridge(JNIEnv* env, const Config& cfg, bool inWorldNow) {
@@ -2747,6 +2977,8 @@ static void UpdateSpeedBridge(JNIEnv* env, const Config& cfg, bool inWorldNow) {
     }
 
     UpdateSpeedBridgeDirection121(posX, posZ);
+    g_speedBridgeGrid_121.Refresh((int)std::floor(posX), (int)std::floor(posY), (int)std::floor(posZ),
+                                  SpeedBridgeGridStamp121());
     bool shouldSneak = IsSpeedBridgeEdgeUnsupported121(env, cfg, posX, posY, posZ);
     SetSpeedBridgeSneak121(env, shouldSneak);
 }
@@ -3000,7 +3232,7 @@ static void EnsureAutoTotemJni(JNIEnv* env) {
             g_itemsClass_121 = LoadClassWithLoader(env, g_gameClassLoader, itemsNames[i]);
             if (env->ExceptionCheck()) { env->ExceptionClear(); g_itemsClass_121 = nullptr; }
             if (g_itemsClass_121) {
-                g_itemsClass_121 = (jclass)env->NewGlobalRef(g_itemsClass_121);
+                g_itemsClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, g_itemsClass_121, s_refAutoTotem121);
             }
         }
         if (g_itemsClass_121) {
@@ -3114,7 +3346,7 @@ static void EnsureAutoTotemJni(JNIEnv* env) {
             g_equipmentSlotClass_121 = LoadClassWithLoader(env, g_gameClassLoader, esNames[i]);
             if (env->ExceptionCheck()) { env->ExceptionClear(); g_equipmentSlotClass_121 = nullptr; }
             if (g_equipmentSlotClass_121) {
-                g_equipmentSlotClass_121 = (jclass)env->NewGlobalRef(g_equipmentSlotClass_121);
+                g_equipmentSlotClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, g_equipmentSlotClass_121, s_refAutoTotem121);
             }
         }
         if (g_equipmentSlotClass_121) {
@@ -3128,7 +3360,7 @@ static void EnsureAutoTotemJni(JNIEnv* env) {
                 g_equipmentSlotChest_121 = env->GetStaticObjectField(g_equipmentSlotClass_121, chestField);
                 if (env->ExceptionCheck()) { env->ExceptionClear(); g_equipmentSlotChest_121 = nullptr; }
                 if (g_equipmentSlotChest_121) {
-                    g_equipmentSlotChest_121 = env->NewGlobalRef(g_equipmentSlotChest_121);
+                    g_equipmentSlotChest_121 = LC_NEW_GLOBAL_REF(env, g_equipmentSlotChest_121, s_refAutoTotem121);
                 }
             }
         }
@@ -3195,6 +3427,11 @@ static void EnsureAutoTotemJni(JNIEnv* env) {
         if (stkCls) {
             g_isEmptyMethod_121 = env->GetMethodID(stkCls, "isEmpty", "()Z");
             if (env->ExceptionCheck()) { env->ExceptionClear(); g_isEmptyMethod_121 = nullptr; }
+            const char* countNames[] = { "getCount", "method_7947", nullptr };
+            for (int i = 0; countNames[i] && !g_itemStackGetCount_121; i++) {
+                g_itemStackGetCount_121 = env->GetMethodID(stkCls, countNames[i], "()I");
+                if (env->ExceptionCheck()) { env->ExceptionClear(); g_itemStackGetCount_121 = nullptr; }
+            }
             env->DeleteLocalRef(stkCls);
         }
     }
@@ -3293,103 +3530,296 @@ static bool IsInventoryScreenOpen() {
     return g_jniScreenName.find("InventoryScreen") != std::string::npos;
 }
 
-static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
-    if (!env || !g_mcInstance || !g_playerField_121) return;
-    if (!cfg.autoTotemEnabled) return;
-
-    if (!g_jniInWorld) return;
-    DWORD nowMs = GetTickCount();
-    if (nowMs < g_worldTransitionEndMs) return;
-
-    // Throttle to game tick rate (~20 tps)
-    if (nowMs - g_lastAutoTotemTickMs < 50) return;
+// Player.containerMenu plus AbstractContainerMenu.containerId / stateId,
+// resolved once per runtime.  stateId may stay null; the snapshot then
+// leans on Inventory.timesChanged and the age limit.
+static void EnsureAutoTotemMenuFields121(JNIEnv* env, jobject selfObj) {
+    if (g_autoTotemMenuFieldsTried_121 || !selfObj) return;
+    g_autoTotemMenuFieldsTried_121 = true;
 
-    // --- Ghost mode: only act when inventory GUI is open ---
-    if (cfg.autoTotemBehaviorMode == 0) {
-        if (!g_jniGuiOpen || !IsInventoryScreenOpen()) {
-            // Reset any pending anarchy state when switching / closing GUI
-            g_autoTotemPendingSlot = -1;
-            return;
+    jclass playerCls = env->GetObjectClass(selfObj);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); playerCls = nullptr; }
+    if (playerCls) {
+        g_playerContainerMenuField_121 = env->GetFieldID(playerCls, "containerMenu", "Lnet/minecraft/world/inventory/AbstractContainerMenu;");
+        if (env->ExceptionCheck() || !g_playerContainerMenuField_121) {
+            env->ExceptionClear();
+            g_playerContainerMenuField_121 = env->GetFieldID(playerCls, "field_7512", "Lnet/minecraft/class_1703;");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); g_playerContainerMenuField_121 = nullptr; }
         }
+        env->DeleteLocalRef(playerCls);
     }
-    // Anarchy mode: abort if any GUI is open (chests, crafting, etc.)
-    else if (g_jniGuiOpen) {
-        g_autoTotemPendingSlot = -1;
-        return;
-    }
-
-    EnsureAutoTotemJni(env);
-    if (!g_autoTotemMethodsResolved) return;
 
-    jobject selfObj = env->GetObjectField(g_mcInstance, g_playerField_121);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); selfObj = nullptr; }
-    if (!selfObj) return;
+    const char* menuNames[] = {
+        "net.minecraft.world.inventory.AbstractContainerMenu",
+        "net.minecraft.class_1703",
+        nullptr
+    };
+    jclass menuCls = nullptr;
+    for (int i = 0; menuNames[i] && !menuCls; i++) {
+        menuCls = LoadClassWithLoader(env, g_gameClassLoader, menuNames[i]);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); menuCls = nullptr; }
+    }
+    if (menuCls) {
+        const char* idNames[] = { "containerId", "field_7760", nullptr };
+        for (int i = 0; idNames[i] && !g_menuContainerIdField_121; i++) {
+            g_menuContainerIdField_121 = env->GetFieldID(menuCls, idNames[i], "I");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); g_menuContainerIdField_121 = nullptr; }
+        }
+        const char* stateNames[] = { "stateId", "revision", nullptr };
+        for (int i = 0; stateNames[i] && !g_menuStateIdField_121; i++) {
+            g_menuStateIdField_121 = env->GetFieldID(menuCls, stateNames[i], "I");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); g_menuStateIdField_121 = nullptr; }
+        }
+        env->DeleteLocalRef(menuCls);
+    }
+    Log(std::string("AutoTotem: containerMenu=") + (g_playerContainerMenuField_121 ? "1" : "0") +
+        " containerId=" + (g_menuContainerIdField_121 ? "1" : "0") +
+        " stateId=" + (g_menuStateIdField_121 ? "1" : "0"));
+}
 
-    // Tick delay (Meteor pattern)
-    if (g_autoTotemTicks < cfg.autoTotemDelay) {
-        g_autoTotemTicks++;
-        env->DeleteLocalRef(selfObj);
-        return;
+// Method[] and kinds for AokoHelper.collectInventory, built once.  False
+// keeps UpdateInventorySnapshot121 on the per-slot JNI walk.
+static bool EnsureInventoryHelper121(JNIEnv* env, jobject selfObj) {
+    if (g_invHelperKinds121) return HelperBridge::HasInventoryCollector();
+    if (g_invHelperTried121 || !g_itemStackGetCount_121) return false;
+    if (!EnsureHelperBridgeLoaded121(env) || !HelperBridge::HasInventoryCollector()) return false;
+    g_invHelperTried121 = true;
+
+    const jmethodID ids[HelperBridge::kInventoryHandleCount] = {
+        g_inventoryGetContainerSize_121, g_inventoryGetItem_121, g_getOffhandItem_121,
+        g_itemStackGetItem_121, g_itemStackGetCount_121, g_isEmptyMethod_121
+    };
+    jclass methodCls = env->FindClass("java/lang/reflect/Method");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); methodCls = nullptr; }
+    jclass objectCls = env->FindClass("java/lang/Object");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); objectCls = nullptr; }
+    jclass selfCls = env->GetObjectClass(selfObj);
+    jobjectArray handles = (methodCls && selfCls) ? env->NewObjectArray(HelperBridge::kInventoryHandleCount, methodCls, nullptr) : nullptr;
+    if (env->ExceptionCheck()) { env->ExceptionClear(); handles = nullptr; }
+    jobjectArray kinds = objectCls ? env->NewObjectArray(1, objectCls, nullptr) : nullptr;
+    if (env->ExceptionCheck()) { env->ExceptionClear(); kinds = nullptr; }
+
+    bool ok = handles && kinds;
+    for (int i = 0; ok && i < HelperBridge::kInventoryHandleCount; i++) {
+        if (!ids[i]) continue;
+        jobject m = env->ToReflectedMethod(selfCls, ids[i], JNI_FALSE);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); m = nullptr; }
+        if (!m) { ok = i == HelperBridge::kInvGetOffhand || i == HelperBridge::kInvStackEmpty; continue; }
+        env->SetObjectArrayElement(handles, i, m);
+        env->DeleteLocalRef(m);
     }
-    g_autoTotemTicks = 0;
+    if (ok) {
+        jobject totemItem = env->GetStaticObjectField(g_itemsClass_121, g_totemOfUndyingField_121);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); totemItem = nullptr; }
+        if (totemItem) {
+            env->SetObjectArrayElement(kinds, 0, totemItem);
+            env->DeleteLocalRef(totemItem);
+        } else {
+            ok = false;
+        }
+    }
+    if (ok) {
+        g_invHelperHandles121 = (jobjectArray)LC_NEW_GLOBAL_REF(env, handles, s_refAutoTotem121);
+        g_invHelperKinds121 = (jobjectArray)LC_NEW_GLOBAL_REF(env, kinds, s_refAutoTotem121);
+        if (!g_invHelperHandles121 || !g_invHelperKinds121) {
+            if (g_invHelperHandles121) RefLedger::Delete(env, g_invHelperHandles121);
+            if (g_invHelperKinds121) RefLedger::Delete(env, g_invHelperKinds121);
+            g_invHelperHandles121 = nullptr;
+            g_invHelperKinds121 = nullptr;
+            ok = false;
+        }
+    }
+    if (handles) env->DeleteLocalRef(handles);
+    if (kinds) env->DeleteLocalRef(kinds);
+    if (selfCls) env->DeleteLocalRef(selfCls);
+    if (objectCls) env->DeleteLocalRef(objectCls);
+    if (methodCls) env->DeleteLocalRef(methodCls);
+    Log(std::string("AutoTotem: inventory helper path ") + (ok ? "ready." : "unavailable; using per-slot JNI."));
+    return ok;
+}
 
-    // Get inventory
-    jobject invObj = env->CallObjectMethod(selfObj, g_getInventory_121);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); invObj = nullptr; }
-    if (!invObj) {
-        env->DeleteLocalRef(selfObj);
-        return;
+// One stack classified the way collectInventory does it.  itemId stays 0 on
+// this path; nothing reads it yet and it would cost a call per slot.
+static HelperBridge::InventorySlot ClassifyStack121(JNIEnv* env, jobject stack, jobject totemItem) {
+    HelperBridge::InventorySlot slot = { HelperBridge::kSlotEmpty, 0, 0 };
+    if (!stack) return slot;
+    jobject item = env->CallObjectMethod(stack, g_itemStackGetItem_121);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); item = nullptr; }
+    if (!item) return slot;
+    slot.kind = (totemItem && env->IsSameObject(item, totemItem)) ? 0 : HelperBridge::kSlotOther;
+    env->DeleteLocalRef(item);
+    if (g_itemStackGetCount_121) {
+        slot.count = env->CallIntMethod(stack, g_itemStackGetCount_121);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); slot.count = 1; }
+        if (slot.count <= 0) slot.kind = HelperBridge::kSlotEmpty;   // ItemStack.EMPTY (air)
+    } else {
+        slot.count = 1;
     }
+    return slot;
+}
 
+static bool RefreshInventorySnapshotJni121(JNIEnv* env, jobject selfObj, jobject invObj, InventorySnapshot121& snap) {
     int containerSize = env->CallIntMethod(invObj, g_inventoryGetContainerSize_121);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); containerSize = 0; }
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return false; }
+    if (containerSize < 0) return false;
 
     jobject totemItem = env->GetStaticObjectField(g_itemsClass_121, g_totemOfUndyingField_121);
     if (env->ExceptionCheck()) { env->ExceptionClear(); totemItem = nullptr; }
+    if (!totemItem) return false;
 
-    int totemSlot = -1;
-    if (totemItem) {
-        for (int i = 0; i < containerSize && totemSlot == -1; i++) {
-            jobject stack = env->CallObjectMethod(invObj, g_inventoryGetItem_121, i);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); stack = nullptr; }
-            if (stack) {
-                jobject item = env->CallObjectMethod(stack, g_itemStackGetItem_121);
-                if (env->ExceptionCheck()) { env->ExceptionClear(); item = nullptr; }
-                if (item && env->IsSameObject(item, totemItem)) {
-                    totemSlot = i;
-                }
-                if (item) env->DeleteLocalRef(item);
-                env->DeleteLocalRef(stack);
-            }
-        }
+    snap.slots.resize((size_t)containerSize);
+    for (int i = 0; i < containerSize; i++) {
+        jobject stack = env->CallObjectMethod(invObj, g_inventoryGetItem_121, i);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); stack = nullptr; }
+        snap.slots[i] = ClassifyStack121(env, stack, totemItem);
+        if (stack) env->DeleteLocalRef(stack);
     }
 
-    env->DeleteLocalRef(invObj);
-
-    if (totemSlot == -1) {
+    jobject offhandStack = env->CallObjectMethod(selfObj, g_getOffhandItem_121);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); offhandStack = nullptr; }
+    snap.offhand = ClassifyStack121(env, offhandStack, totemItem);
+    if (offhandStack) env->DeleteLocalRef(offhandStack);
+
+    env->DeleteLocalRef(totemItem);
+    return true;
+}
+
+// Brings g_invSnapshot121 up to date, reading the inventory only when one of
+// its change counters moved or the snapshot is older than the age limit.
+// False when the inventory could not be read.
+static bool UpdateInventorySnapshot121(JNIEnv* env, jobject selfObj, DWORD nowMs) {
+    InventorySnapshot121& snap = g_invSnapshot121;
+    EnsureAutoTotemMenuFields121(env, selfObj);
+
+    int stateId = 0;
+    bool haveStateId = false;
+    if (g_playerContainerMenuField_121 && g_menuStateIdField_121) {
+        jobject menuObj = env->GetObjectField(selfObj, g_playerContainerMenuField_121);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); menuObj = nullptr; }
+        if (menuObj) {
+            stateId = env->GetIntField(menuObj, g_menuStateIdField_121);
+            haveStateId = !env->ExceptionCheck();
+            if (!haveStateId) env->ExceptionClear();
+            env->DeleteLocalRef(menuObj);
+        }
+    }
+
+    jobject invObj = env->CallObjectMethod(selfObj, g_getInventory_121);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); invObj = nullptr; }
+    if (!invObj) return false;
+
+    if (!g_autoTotemInvFieldTried_121) {
+        g_autoTotemInvFieldTried_121 = true;
+        jclass invCls = env->GetObjectClass(invObj);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); invCls = nullptr; }
+        if (invCls) {
+            const char* names[] = { "timesChanged", "changeCount", nullptr };
+            for (int i = 0; names[i] && !g_inventoryTimesChangedField_121; i++) {
+                g_inventoryTimesChangedField_121 = env->GetFieldID(invCls, names[i], "I");
+                if (env->ExceptionCheck()) { env->ExceptionClear(); g_inventoryTimesChangedField_121 = nullptr; }
+            }
+            env->DeleteLocalRef(invCls);
+        }
+    }
+    int timesChanged = 0;
+    bool haveTimesChanged = false;
+    if (g_inventoryTimesChangedField_121) {
+        timesChanged = env->GetIntField(invObj, g_inventoryTimesChangedField_121);
+        haveTimesChanged = !env->ExceptionCheck();
+        if (!haveTimesChanged) env->ExceptionClear();
+    }
+
+    // Without either counter only the age limit can tell a change apart.
+    bool keyed = haveStateId || haveTimesChanged;
+    if (snap.valid && nowMs - snap.takenMs < kInventorySnapshotMaxAgeMs
+        && (!keyed || (stateId == snap.stateId && timesChanged == snap.timesChanged))) {
+        snap.reuses++;
+        env->DeleteLocalRef(invObj);
+        return true;
+    }
+
+    bool ok = false;
+    if (EnsureInventoryHelper121(env, selfObj)) {
+        static HelperBridge::InventoryFrame s_frame;   // scan thread only; keeps capacity
+        if (HelperBridge::CollectInventory(env, invObj, selfObj, g_invHelperHandles121, g_invHelperKinds121, s_frame) >= 0) {
+            snap.slots.swap(s_frame.slots);
+            snap.offhand = s_frame.offhand;
+            snap.helperRefreshes++;
+            ok = true;
+        }
+    }
+    if (!ok) ok = RefreshInventorySnapshotJni121(env, selfObj, invObj, snap);
+    env->DeleteLocalRef(invObj);
+
+    snap.valid = ok;
+    if (ok) {
+        snap.stateId = stateId;
+        snap.timesChanged = timesChanged;
+        snap.takenMs = nowMs;
+        snap.refreshes++;
+    }
+    return ok;
+}
+
+static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
+    if (!env || !g_mcInstance || !g_playerField_121) return;
+    if (!cfg.autoTotemEnabled) return;
+
+    if (!g_jniInWorld) return;
+    DWORD nowMs = GetTickCount();
+    if (nowMs < g_worldTransitionEndMs) return;
+
+    // Throttle to game tick rate (~20 tps)
+    if (nowMs - g_lastAutoTotemTickMs < 50) return;
+
+    // --- Ghost mode: only act when inventory GUI is open ---
+    if (cfg.autoTotemBehaviorMode == 0) {
+        if (!g_jniGuiOpen || !IsInventoryScreenOpen()) {
+            // Reset any pending anarchy state when switching / closing GUI
+            g_autoTotemPendingSlot = -1;
+            return;
+        }
+    }
+    // Anarchy mode: abort if any GUI is open (chests, crafting, etc.)
+    else if (g_jniGuiOpen) {
+        g_autoTotemPendingSlot = -1;
+        return;
+    }
+
+    EnsureAutoTotemJni(env);
+    if (!g_autoTotemMethodsResolved) return;
+
+    jobject selfObj = env->GetObjectField(g_mcInstance, g_playerField_121);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); selfObj = nullptr; }
+    if (!selfObj) return;
+
+    // Tick delay (Meteor pattern)
+    if (g_autoTotemTicks < cfg.autoTotemDelay) {
+        g_autoTotemTicks++;
+        env->DeleteLocalRef(selfObj);
+        return;
+    }
+    g_autoTotemTicks = 0;
+
+    // Slot contents come from the snapshot; inventory JNI only runs when it changed.
+    if (!UpdateInventorySnapshot121(env, selfObj, nowMs)) {
+        env->DeleteLocalRef(selfObj);
+        return;
+    }
+
+    int totemSlot = -1;
+    for (size_t i = 0; i < g_invSnapshot121.slots.size() && totemSlot == -1; i++)
+        if (g_invSnapshot121.slots[i].kind == 0) totemSlot = (int)i;
+
+    if (totemSlot == -1) {
         g_autoTotemLocked = false;
-        if (totemItem) env->DeleteLocalRef(totemItem);
         env->DeleteLocalRef(selfObj);
         g_autoTotemPendingSlot = -1;
         return;
     }
 
     // Check offhand
-    jobject offhandStack = env->CallObjectMethod(selfObj, g_getOffhandItem_121);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); offhandStack = nullptr; }
-    bool offhandHasTotem = false;
-    if (offhandStack && totemItem) {
-        jobject offhandItem = env->CallObjectMethod(offhandStack, g_itemStackGetItem_121);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); offhandItem = nullptr; }
-        if (offhandItem) {
-            offhandHasTotem = env->IsSameObject(offhandItem, totemItem);
-            env->DeleteLocalRef(offhandItem);
-        }
-    }
-    if (offhandStack) env->DeleteLocalRef(offhandStack);
-
-    if (offhandHasTotem) {
-        if (totemItem) env->DeleteLocalRef(totemItem);
+    if (g_invSnapshot121.offhand.kind == 0) {
         env->DeleteLocalRef(selfObj);
         g_autoTotemPendingSlot = -1;
         return;
@@ -3436,7 +3866,6 @@ static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
     g_autoTotemLocked = shouldLock;
 
     if (!g_autoTotemLocked) {
-        if (totemItem) env->DeleteLocalRef(totemItem);
         env->DeleteLocalRef(selfObj);
         g_autoTotemTicks = 0;
         g_autoTotemPendingSlot = -1;
@@ -3448,7 +3877,6 @@ static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
         jobject conn = env->CallObjectMethod(g_mcInstance, g_getConnectionMethod_121);
         if (env->ExceptionCheck() || !conn) {
             env->ExceptionClear();
-            if (totemItem) env->DeleteLocalRef(totemItem);
             env->DeleteLocalRef(selfObj);
             return;
         }
@@ -3456,7 +3884,6 @@ static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
     }
 
     if (!g_gameModeFieldCached_121) {
-        if (totemItem) env->DeleteLocalRef(totemItem);
         env->DeleteLocalRef(selfObj);
         return;
     }
@@ -3464,53 +3891,25 @@ static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
     jobject gameModeObj = env->GetObjectField(g_mcInstance, g_gameModeFieldCached_121);
     if (env->ExceptionCheck()) { env->ExceptionClear(); gameModeObj = nullptr; }
     if (!gameModeObj) {
-        if (totemItem) env->DeleteLocalRef(totemItem);
         env->DeleteLocalRef(selfObj);
         return;
     }
 
-    // Resolve containerMenu for containerId & carried-item safety
-    jclass playerCls = env->GetObjectClass(selfObj);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); playerCls = nullptr; }
-    jfieldID containerMenuField = nullptr;
-    if (playerCls) {
-        containerMenuField = env->GetFieldID(playerCls, "containerMenu", "Lnet/minecraft/world/inventory/AbstractContainerMenu;");
-        if (env->ExceptionCheck() || !containerMenuField) {
-            env->ExceptionClear();
-            containerMenuField = env->GetFieldID(playerCls, "field_7512", "Lnet/minecraft/class_1703;");
-            if (env->ExceptionCheck()) { env->ExceptionClear(); containerMenuField = nullptr; }
-        }
-        env->DeleteLocalRef(playerCls);
-    }
-
+    // containerMenu for containerId & carried-item safety
     int containerId = 0;
     jobject menuObj = nullptr;
-    if (containerMenuField) {
-        menuObj = env->GetObjectField(selfObj, containerMenuField);
+    if (g_playerContainerMenuField_121) {
+        menuObj = env->GetObjectField(selfObj, g_playerContainerMenuField_121);
         if (env->ExceptionCheck()) { env->ExceptionClear(); menuObj = nullptr; }
-        if (menuObj) {
-            jclass menuCls = env->GetObjectClass(menuObj);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); menuCls = nullptr; }
-            jfieldID containerIdField = nullptr;
-            if (menuCls) {
-                containerIdField = env->GetFieldID(menuCls, "containerId", "I");
-                if (env->ExceptionCheck() || !containerIdField) {
-                    env->ExceptionClear();
-                    containerIdField = env->GetFieldID(menuCls, "field_7760", "I");
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); containerIdField = nullptr; }
-                }
-                env->DeleteLocalRef(menuCls);
-            }
-            if (containerIdField) {
-                containerId = env->GetIntField(menuObj, containerIdField);
-            }
+        if (menuObj && g_menuContainerIdField_121) {
+            containerId = env->GetIntField(menuObj, g_menuContainerIdField_121);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); containerId = 0; }
         }
     }
 
     if (containerId != 0) {
         if (menuObj) env->DeleteLocalRef(menuObj);
         env->DeleteLocalRef(gameModeObj);
-        if (totemItem) env->DeleteLocalRef(totemItem);
         env->DeleteLocalRef(selfObj);
         g_autoTotemPendingSlot = -1;
         return;
@@ -3521,7 +3920,6 @@ static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
     if (fromSlotId < 0 || fromSlotId == toSlotId) {
         if (menuObj) env->DeleteLocalRef(menuObj);
         env->DeleteLocalRef(gameModeObj);
-        if (totemItem) env->DeleteLocalRef(totemItem);
         env->DeleteLocalRef(selfObj);
         g_autoTotemPendingSlot = -1;
         return;
@@ -3531,7 +3929,6 @@ static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
     if (!pickupValue) {
         if (menuObj) env->DeleteLocalRef(menuObj);
         env->DeleteLocalRef(gameModeObj);
-        if (totemItem) env->DeleteLocalRef(totemItem);
         env->DeleteLocalRef(selfObj);
         g_autoTotemPendingSlot = -1;
         return;
@@ -3582,26 +3979,262 @@ static void UpdateAutoTotem(JNIEnv* env, const Config& cfg) {
             g_lastAutoTotemTickMs = nowMs;
         }
     }
+    g_invSnapshot121.valid = false;   // our clicks moved items; do not wait for the stateId echo
 
     env->DeleteLocalRef(pickupValue);
     if (menuObj) env->DeleteLocalRef(menuObj);
     env->DeleteLocalRef(gameModeObj);
-    if (totemItem) env->DeleteLocalRef(totemItem);
     env->DeleteLocalRef(selfObj);
 }
 
+// ---- AokoHelper (HelperBridge) shared by the player list and chest scan ----
+static bool g_helperLoadTried121 = false;   // one Load() attempt per runtime
+
+static bool EnsureHelperBridgeLoaded121(JNIEnv* env) {
+    if (HelperBridge::IsLoaded()) return true;
+    if (g_helperLoadTried121 || !g_gameClassLoader) return false;
+    g_helperLoadTried121 = true;
+    HelperBridge::Load(env, g_gameClassLoader);
+    Log(std::string("HelperBridge: loaded=") + (HelperBridge::IsLoaded() ? "1" : "0")
+        + " wide=" + (HelperBridge::HasWideCollector() ? "1" : "0")
+        + " blockCollector=" + (HelperBridge::HasBlockEntityCollector() ? "1" : "0"));
+    return HelperBridge::IsLoaded();
+}
+
+static jobject ReflectedFieldGlobal121(JNIEnv* env, jclass cls, jfieldID fid) {
+    jobject r = env->ToReflectedField(cls, fid, JNI_FALSE);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); r = nullptr; }
+    if (!r) return nullptr;
+    jobject g = LC_NEW_GLOBAL_REF(env, r, s_refChestEsp121);
+    env->DeleteLocalRef(r);
+    return g;
+}
+
+// Method[] for AokoHelper.collectEntityFrameWide (global ref).  Several of the
+// method IDs resolve lazily, so the array is rebuilt whenever the set of
+// resolved IDs grows.
+static jobjectArray g_wideHandles121 = nullptr;
+static unsigned     g_wideHandlesMask121 = 0;
+
+static void ResetWideHandles121(JNIEnv* env) {
+    if (g_wideHandles121 && env) RefLedger::Delete(env, g_wideHandles121);
+    g_wideHandles121 = nullptr;
+    g_wideHandlesMask121 = 0;
+}
+
+static bool EnsureWideHandles121(JNIEnv* env, jobject selfObj) {
+    if (!EnsureHelperBridgeLoaded121(env) || !HelperBridge::HasWideCollector()) return false;
+    const jmethodID ids[HelperBridge::kWideHandleCount] = {
+        g_getX_121, g_getY_121, g_getZ_121, g_getHealth_121, g_getArmor_121,
+        g_getMainHandStack_121, g_itemStackGetName_121, g_itemStackGetDamage_121, g_itemStackGetMaxDamage_121,
+        g_getName_121, g_textGetString_121, g_getGameProfile_121, g_gameProfileGetName_121,
+        g_getEntityId_121, g_scoreboardGetHolderTeam_121, g_abstractTeamGetName_121
+    };
+    unsigned mask = 0;
+    for (int i = 0; i < HelperBridge::kWideHandleCount; i++) if (ids[i]) mask |= 1u << i;
+    if (!(ids[HelperBridge::kGetX] && ids[HelperBridge::kGetY] && ids[HelperBridge::kGetZ])) return false;
+    if (g_wideHandles121 && mask == g_wideHandlesMask121) return true;
+
+    jclass methodCls = env->FindClass("java/lang/reflect/Method");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); methodCls = nullptr; }
+    jclass selfCls = selfObj ? env->GetObjectClass(selfObj) : nullptr;
+    jobjectArray arr = (methodCls && selfCls) ? env->NewObjectArray(HelperBridge::kWideHandleCount, methodCls, nullptr) : nullptr;
+    if (env->ExceptionCheck()) { env->ExceptionClear(); arr = nullptr; }
+    unsigned built = 0;
+    if (arr) {
+        for (int i = 0; i < HelperBridge::kWideHandleCount; i++) {
+            if (!ids[i]) continue;
+            // HotSpot reflects the method's own holder; the class argument only has to be non-null.
+            jobject m = env->ToReflectedMethod(selfCls, ids[i], JNI_FALSE);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m = nullptr; }
+            if (!m) continue;
+            env->SetObjectArrayElement(arr, i, m);
+            env->DeleteLocalRef(m);
+            built |= 1u << i;
+        }
+    }
+    bool ok = arr && (built & 7u) == 7u;
+    if (ok) {
+        ResetWideHandles121(env);
+        g_wideHandles121 = (jobjectArray)LC_NEW_GLOBAL_REF(env, arr, s_refPlayers121);
+        g_wideHandlesMask121 = mask;
+    }
+    if (arr) env->DeleteLocalRef(arr);
+    if (selfCls) env->DeleteLocalRef(selfCls);
+    if (methodCls) env->DeleteLocalRef(methodCls);
+    return ok && g_wideHandles121;
+}
+
+// List.size / List.get on the list's own class, for ScanEngine::WalkPlayers.
+static bool GetListAccess121(JNIEnv* env, jobject list, ScanEngine::ListAccess& access) {
+    access.size = access.get = nullptr;
+    jclass cls = env->GetObjectClass(list);
+    if (cls) {
+        access.size = env->GetMethodID(cls, "size", "()I");
+        access.get = env->GetMethodID(cls, "get", "(I)Ljava/lang/Object;");
+        env->DeleteLocalRef(cls);
+    }
+    if (env->ExceptionCheck()) { env->ExceptionClear(); access.size = access.get = nullptr; }
+    return access.size && access.get;
+}
+
+// Player-list read for ScanEngine.  The batch is one collectEntityFrameWide
+// call over List.toArray() (or the synthetic frame); the per-entity read
+// takes Entity.pos when it is mapped and reads armor and the held item only
+// when the player's row is due for them.  What the table needs beyond a
+// PlayerSample is kept per list index in `extras`; only the first 128
+// entries are read, as many as the table has rows.
+struct PlayerListAdapter121 : ScanEngine::VersionAdapter {
+    struct Extra {
+        int entityId;            // -1 when unknown
+        bool nameless;           // named "Player_<n>" in distance order by the caller
+        bool hasAttrs;           // armor and heldItem were read this pass
+        std::string heldItem;
+    };
+    static const int kMaxEntities = 128;
+    Extra extras[kMaxEntities];
+
+    // Set by UpdatePlayerListOverlay before each walk.
+    jobject worldObj = nullptr;
+    jobject hideScoreboardObj = nullptr;   // reused for team names; may be null
+    bool synthetic = false;
+    double originX = 0, originY = 0, originZ = 0;
+    LONGLONG scanQpc = 0;
+    DWORD now = 0;
+    // Set by the walk: the samples came from CollectBatch.
+    bool batched = false;
+
+    bool CollectBatch(JNIEnv* env, jobject list, jobject self, std::vector<ScanEngine::PlayerSample>& out) {
+        batched = false;
+        static HelperBridge::WideEntityFrame s_frame;   // scan thread only; keeps capacity
+        int n = -1;
+#if LC_SYNTHETIC_LOAD
+        if (synthetic) n = SyntheticLoad::FillEntities(originX, originY, originZ, (double)scanQpc / (double)lc::QpcFrequency(), s_frame);
+#endif
+        if (!synthetic) {
+            if (!EnsureWideHandles121(env, self)) return false;
+            jobjectArray entities = ToArray(env, list);
+            if (!entities) return false;
+            jobject teamScoreboard = hideScoreboardObj;
+            if (!teamScoreboard && g_scoreboardGetHolderTeam_121 && g_abstractTeamGetName_121)
+                teamScoreboard = GetScoreboard121(env, worldObj);
+            n = HelperBridge::CollectEntitiesWide(env, entities, self, g_wideHandles121, teamScoreboard, s_frame);
+            if (teamScoreboard && teamScoreboard != hideScoreboardObj) env->DeleteLocalRef(teamScoreboard);
+            env->DeleteLocalRef(entities);
+        }
+        if (n < 0) return false;
+
+        ScanEngine::PlayerSample sample;
+        for (int r = 0; r < n; r++) {
+            const HelperBridge::WideEntityRecord& rec = s_frame.records[r];
+            if (rec.index < 0 || rec.index >= kMaxEntities) continue;
+            std::string name = CleanPlayerDisplayName(s_frame.Str(rec.name));
+            if (LooksLikeFakePlayerLine(name)) name = StableProfileName(s_frame.Str(rec.profile));
+            Extra& e = extras[rec.index];
+            e.entityId = rec.entityId;
+            e.nameless = name.empty();
+            e.hasAttrs = true;
+            e.heldItem.clear();
+            if (rec.held.len > 0) e.heldItem = FormatHeldItem(s_frame.Str(rec.held), rec.heldDamage, rec.heldMaxDamage);
+
+            sample.index = rec.index;
+            sample.key = rec.entityId >= 0 ? rec.entityId : 0;
+            sample.x = sample.lastX = rec.x;
+            sample.y = sample.lastY = rec.y;
+            sample.z = sample.lastZ = rec.z;
+            sample.health = rec.health;
+            sample.armor = rec.armor;
+            sample.dist = 0.0;
+            sample.name = e.nameless ? "Player" : name;
+            out.push_back(sample);
+        }
+        batched = true;
+        return true;
+    }
+
+    bool ReadPlayer(JNIEnv* env, jobject entity, ScanEngine::PlayerSample& out) {
+        if (out.index >= kMaxEntities) return false;
+        EnsureEntityMethods(env, entity);
+        Extra& e = extras[out.index];
+        e.entityId = -1;
+        std::string name = GetCachedPlayerName(env, entity, &e.entityId);
+        e.nameless = name.empty();
+        if (!e.nameless && LooksLikeFakePlayerLine(name)) return false;
+        out.name = e.nameless ? "Player" : name;
+        out.key = e.entityId >= 0 ? e.entityId : 0;
+
+        // Prefer the Entity.pos field (no CallDoubleMethod).
+        jobject posVec = nullptr;
+        if (g_entityPosField_121 && g_vec3dX_121 && g_vec3dY_121 && g_vec3dZ_121) {
+            posVec = env->GetObjectField(entity, g_entityPosField_121);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); posVec = nullptr; }
+        }
+        if (posVec) {
+            out.x = env->GetDoubleField(posVec, g_vec3dX_121);
+            out.y = env->GetDoubleField(posVec, g_vec3dY_121);
+            out.z = env->GetDoubleField(posVec, g_vec3dZ_121);
+            env->ExceptionClear();
+            env->DeleteLocalRef(posVec);
+        } else {
+            out.x = CallDoubleNoArgs(env, entity, g_getX_121);
+            out.y = CallDoubleNoArgs(env, entity, g_getY_121);
+            out.z = CallDoubleNoArgs(env, entity, g_getZ_121);
+        }
+        out.lastX = out.x; out.lastY = out.y; out.lastZ = out.z;
+
+        if (g_getHealth_121) {
+            out.health = env->CallFloatMethod(entity, g_getHealth_121);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); out.health = 20.0f; }
+        }
+
+        // A nameless player without an id gets its key from the "Player_<n>"
+        // name later, so it finds no row here and is read like a new one.
+        const PlayerRow121* row = g_playerTable121.Find(PlayerRowKey121(e.entityId, name));
+        e.hasAttrs = !row || now - row->slowAtMs >= kPlayerSlowAttrMs;
+        e.heldItem.clear();
+        if (e.hasAttrs) {
+            out.armor = GetEntityArmor(env, entity);
+            e.heldItem = GetHeldItemInfo(env, entity);
+        }
+        return true;
+    }
+
+private:
+    static jobjectArray ToArray(JNIEnv* env, jobject list) {
+        static jmethodID s_toArray = nullptr;   // java.util.Collection is a bootstrap class
+        if (!s_toArray) {
+            jclass colCls = env->FindClass("java/util/Collection");
+            if (colCls) {
+                s_toArray = env->GetMethodID(colCls, "toArray", "()[Ljava/lang/Object;");
+                env->DeleteLocalRef(colCls);
+            }
+            if (env->ExceptionCheck()) { env->ExceptionClear(); s_toArray = nullptr; }
+            if (!s_toArray) return nullptr;
+        }
+        jobjectArray arr = (jobjectArray)env->CallObjectMethod(list, s_toArray);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); arr = nullptr; }
+        return arr;
+    }
+};
+
+// Nearest first; list order between equal distances.
+static bool PlayerSampleCloser121(const ScanEngine::PlayerSample& a, const ScanEngine::PlayerSample& b) {
+    return a.dist < b.dist || (a.dist == b.dist && a.index < b.index);
+}
+
 static void UpdatePlayerListOverlay(JNIEnv* env) {
-    Config cfg;
-    { LockGuard lk(g_configMutex); cfg = g_config; }
+    ConfigRef cfgRef = g_config.Acquire();
+    const Config& cfg = *cfgRef;
     const bool hideVanillaTags = cfg.nametagHideVanilla;
     const bool restoreVanillaTags = (!hideVanillaTags && g_nametagSuppressionActive_121);
     bool suppressionAppliedThisPass = false;
     bool suppressionAttemptedThisPass = false;
 
     DWORD now = GetTickCount();
-    DWORD throttle = (cfg.aimAssist || cfg.triggerbot) ? 8 : 100;
+    DWORD throttle = (cfg.aimAssist || cfg.triggerbot) ? kPlayerListAimMs : kPlayerListTickMs;
     if (now - g_lastPlayerListUpdateMs < throttle) return;
     g_lastPlayerListUpdateMs = now;
+    LC_SYNTH_STAGE(synthStage, SyntheticLoad::kPlayerScan);
     EnsureClosestPlayerCaches(env);
     if (!g_mcInstance || !g_worldField_121 || !g_playerField_121) return;
 
@@ -3660,10 +4293,12 @@ static void UpdatePlayerListOverlay(JNIEnv* env) {
             env->DeleteLocalRef(restoreScoreboard);
         } else {
             for (auto& entry : g_modifiedTeamVisibility_121) {
-                if (entry.second && env) env->DeleteGlobalRef(entry.second);
+                if (entry.second && env) RefLedger::Delete(env, entry.second);
             }
             g_modifiedTeamVisibility_121.clear();
             g_lcHideTagsMembers_121.clear();
+            g_hiddenNametagOriginalTeamByPlayer_121.clear();
+            g_nextNametagResyncMs_121 = 0;
         }
         g_nametagSuppressionActive_121 = false;
     }
@@ -3679,21 +4314,6 @@ static void UpdatePlayerListOverlay(JNIEnv* env) {
     if (env->ExceptionCheck()) { env->ExceptionClear(); listObj = nullptr; }
     if (!listObj) { env->DeleteLocalRef(worldObj); env->DeleteLocalRef(selfObj); return; }
 
-    // Use Collection.toArray() — one CallObjectMethod instead of N get(i) calls
-    jclass colCls2 = env->FindClass("java/util/Collection");
-    jmethodID mToArr = colCls2 ? env->GetMethodID(colCls2, "toArray", "()[Ljava/lang/Object;") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mToArr = nullptr; }
-    if (colCls2) env->DeleteLocalRef(colCls2);
-    if (!mToArr) { env->DeleteLocalRef(listObj); env->DeleteLocalRef(worldObj); env->DeleteLocalRef(selfObj); return; }
-
-    jobjectArray entArr = (jobjectArray)env->CallObjectMethod(listObj, mToArr);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); entArr = nullptr; }
-    if (!entArr) { env->DeleteLocalRef(listObj); env->DeleteLocalRef(worldObj); env->DeleteLocalRef(selfObj); return; }
-    
-    int size = (int)env->GetArrayLength(entArr);
-    int maxPlayersToProcess = size; // Process all players to avoid target flickering
-    if (maxPlayersToProcess > 200) maxPlayersToProcess = 200; // safety sanity limit
-
     jobject hideScoreboardObj = nullptr;
     jobject hideTeamObj = nullptr;
     if (hideVanillaTags && suppressionMappingsReady) {
@@ -3710,13 +4330,6 @@ static void UpdatePlayerListOverlay(JNIEnv* env) {
         }
     }
 
-    // Accumulate in localList; atomically publish to g_playerList at scope exit.
-    std::vector<PlayerData121> localList;
-    struct PublishOnExit {
-        std::vector<PlayerData121>& local;
-        ~PublishOnExit() { LockGuard lk(g_playerListMutex); g_playerList.swap(local); }
-    } pub{localList};
-
     // Get self position — use bgCamState for XZ, or fallback to CallDoubleMethod
     double sx = 0, sy = 0, sz = 0;
     { LockGuard lk(g_bgCamMutex); sx = g_bgCamState.camX; sy = g_bgCamState.camY; sz = g_bgCamState.camZ; }
@@ -3725,185 +4338,97 @@ static void UpdatePlayerListOverlay(JNIEnv* env) {
         sy = CallDoubleNoArgs(env, selfObj, g_getY_121);
         sz = CallDoubleNoArgs(env, selfObj, g_getZ_121);
     }
+    const LONGLONG scanQpc = lc::QpcNow();
 
-    // 1. Fetch lightweight info (XYZ only) — use Entity.pos field if available
-    struct LightweightEntity {
-        jobject obj;
-        double dist;
-        double x, y, z;
-    };
-    std::vector<LightweightEntity> lwList;
-
-    for (int i = 0; i < size && i < 128; i++) {
-        jobject entObj = env->GetObjectArrayElement(entArr, i);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); entObj = nullptr; }
-        if (!entObj) continue;
-
-        // Skip self
-        if (env->IsSameObject(entObj, selfObj)) { env->DeleteLocalRef(entObj); continue; }
-
-        EnsureEntityMethods(env, entObj);
-        if (hideVanillaTags && hideScoreboardObj && hideTeamObj) {
-            std::string suppressionName = GetStablePlayerName(env, entObj);
-            if (!suppressionName.empty() && !LooksLikeFakePlayerLine(suppressionName)) {
-                suppressionAttemptedThisPass = true;
-                bool applied = ApplyVanillaNametagSuppression121(env, hideScoreboardObj, hideTeamObj, suppressionName);
-                if (applied) suppressionAppliedThisPass = true;
-            }
-        }
-        double ex = 0, ey = 0, ez = 0;
-        // Prefer direct Entity.pos field (zero CallDoubleMethod)
-        if (g_entityPosField_121 && g_vec3dX_121 && g_vec3dY_121 && g_vec3dZ_121) {
-            jobject posVec = env->GetObjectField(entObj, g_entityPosField_121);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); posVec = nullptr; }
-            if (posVec) {
-                ex = env->GetDoubleField(posVec, g_vec3dX_121);
-                ey = env->GetDoubleField(posVec, g_vec3dY_121);
-                ez = env->GetDoubleField(posVec, g_vec3dZ_121);
-                env->ExceptionClear();
-                env->DeleteLocalRef(posVec);
-            } else {
-                ex = CallDoubleNoArgs(env, entObj, g_getX_121);
-                ey = CallDoubleNoArgs(env, entObj, g_getY_121);
-                ez = CallDoubleNoArgs(env, entObj, g_getZ_121);
-            }
-        } else {
-            ex = CallDoubleNoArgs(env, entObj, g_getX_121);
-            ey = CallDoubleNoArgs(env, entObj, g_getY_121);
-            ez = CallDoubleNoArgs(env, entObj, g_getZ_121);
-        }
-        double dx = ex - sx, dy = ey - sy, dz = ez - sz;
-        double dist = sqrt(dx*dx + dy*dy + dz*dz);
-
-        lwList.push_back({entObj, dist, ex, ey, ez});
+    // One walk: the helper's batch when it is loaded (synthetic-load builds
+    // can take the frame from SyntheticLoad instead; its players are never
+    // put on the hide team), else a read per entity.
+#if LC_SYNTHETIC_LOAD
+    const bool synthetic = SyntheticLoad::Active();
+#else
+    const bool synthetic = false;
+#endif
+    static PlayerListAdapter121 s_adapter;
+    static std::vector<ScanEngine::PlayerSample> s_players;
+    s_adapter.worldObj = worldObj;
+    s_adapter.hideScoreboardObj = hideScoreboardObj;
+    s_adapter.synthetic = synthetic;
+    s_adapter.originX = sx; s_adapter.originY = sy; s_adapter.originZ = sz;
+    s_adapter.scanQpc = scanQpc;
+    s_adapter.now = now;
+    ScanEngine::ListAccess access;
+    GetListAccess121(env, listObj, access);
+    ScanEngine::WalkOptions opts = { sx, sy, sz, 0.0 };
+    const int walked = ScanEngine::WalkPlayers(env, s_adapter, listObj, access, selfObj, opts, s_players);
+    s_adapter.worldObj = s_adapter.hideScoreboardObj = nullptr;
+    if (walked < 0) {
+        if (hideTeamObj) env->DeleteLocalRef(hideTeamObj);
+        if (hideScoreboardObj) env->DeleteLocalRef(hideScoreboardObj);
+        env->DeleteLocalRef(listObj);
+        env->DeleteLocalRef(worldObj);
+        env->DeleteLocalRef(selfObj);
+        return;
     }
-    env->DeleteLocalRef(entArr);
-
-    // Sort by distance
-    std::sort(lwList.begin(), lwList.end(), [](const LightweightEntity& a, const LightweightEntity& b) {
-        return a.dist < b.dist;
-    });
+    std::sort(s_players.begin(), s_players.end(), PlayerSampleCloser121);
 
-    // 2. Process heavy JNI only on nearest N (config-driven).
-    // Fast path: use HelperBridge to pack all entity data in one JNI call.
-    int processedCount = 0;
-    bool usedHelper = false;
-
-    if (HelperBridge::IsLoaded() && !hideVanillaTags) {
-        // Build a java.util.List view from lwList objects for the helper.
-        // We pass listObj directly (already the world players list) and let the
-        // helper iterate it; selfObj is passed so the helper skips the local player.
-        // Reflection handles: use global refs cached during discovery.
-        // fPosVec / vec fields: g_entityPosField_121 / g_vec3dX_121 etc. are jfieldIDs,
-        // not reflect.Field objects — pass nullptr and let the helper use getX/Y/Z methods.
-        // mGetX/Y/Z / mGetHealth: wrap jmethodID as reflect.Method via ToReflectedMethod.
-        // To avoid the ToReflectedMethod overhead every call, cache the reflect.Method globals.
-        static jobject s_reflGetX = nullptr, s_reflGetY = nullptr, s_reflGetZ = nullptr;
-        static jobject s_reflGetHealth = nullptr, s_reflGetName = nullptr;
-
-        if (!s_reflGetX && g_getX_121 && g_mcInstance) {
-            // Resolve the entity class to get ToReflectedMethod
-            jclass entCls = nullptr;
-            if (g_mcInstance) {
-                jobject plObj = g_playerField_121 ? env->GetObjectField(g_mcInstance, g_playerField_121) : nullptr;
-                if (plObj) { entCls = env->GetObjectClass(plObj); env->DeleteLocalRef(plObj); }
-            }
-            if (entCls) {
-                jobject r = env->ToReflectedMethod(entCls, g_getX_121, JNI_FALSE);
-                if (!env->ExceptionCheck() && r) s_reflGetX = env->NewGlobalRef(r);
-                else env->ExceptionClear();
-                if (r) env->DeleteLocalRef(r);
-
-                r = env->ToReflectedMethod(entCls, g_getY_121, JNI_FALSE);
-                if (!env->ExceptionCheck() && r) s_reflGetY = env->NewGlobalRef(r);
-                else env->ExceptionClear();
-                if (r) env->DeleteLocalRef(r);
-
-                r = env->ToReflectedMethod(entCls, g_getZ_121, JNI_FALSE);
-                if (!env->ExceptionCheck() && r) s_reflGetZ = env->NewGlobalRef(r);
-                else env->ExceptionClear();
-                if (r) env->DeleteLocalRef(r);
-
-                if (g_getHealth_121) {
-                    r = env->ToReflectedMethod(entCls, g_getHealth_121, JNI_FALSE);
-                    if (!env->ExceptionCheck() && r) s_reflGetHealth = env->NewGlobalRef(r);
-                    else env->ExceptionClear();
-                    if (r) env->DeleteLocalRef(r);
-                }
-                env->DeleteLocalRef(entCls);
-            }
-        }
-
-        if (s_reflGetX && s_reflGetY && s_reflGetZ) {
-            HelperBridge::EntityFrame frame;
-            int n = HelperBridge::CollectEntities(
-                env, listObj, selfObj,
-                nullptr,       // fPosVec (use method path)
-                nullptr, nullptr, nullptr,  // fVecX/Y/Z
-                s_reflGetX, s_reflGetY, s_reflGetZ,
-                s_reflGetHealth, s_reflGetName,
-                frame);
-
-            if (n >= 0) {
-                usedHelper = true;
-                // Merge helper results with lwList distance data
-                // (helper iterates in list order; lwList is sorted by distance)
-                // Build a name→snapshot map for O(1) lookup
-                std::unordered_map<std::string, const HelperBridge::EntitySnapshot*> snapMap;
-                for (auto& snap : frame.entities) {
-                    if (!snap.name.empty()) snapMap[snap.name] = &snap;
-                }
-
-                for (auto& lw : lwList) {
-                    if (processedCount >= maxPlayersToProcess) { env->DeleteLocalRef(lw.obj); continue; }
-                    // Get name via stable helper (still one JNI call per entity for name only)
-                    std::string name = GetStablePlayerName(env, lw.obj);
-                    env->DeleteLocalRef(lw.obj);
-                    if (name.empty() || LooksLikeFakePlayerLine(name)) continue;
-
-                    float hp = 20.0f;
-                    auto it = snapMap.find(name);
-                    if (it != snapMap.end()) hp = it->second->health;
-
-                    int armor = GetEntityArmor(env, nullptr); // skip armor in fast path
-                    std::string held;
-                    localList.emplace_back(PlayerData121{name, lw.dist, lw.x, lw.y, lw.z, hp, armor, held});
-                    processedCount++;
-                }
-            }
+    // Accumulate in a recycled g_playerList buffer; publish it at scope exit.
+    std::vector<PlayerData121>& localList = g_playerList.BeginWrite();
+    localList.clear();
+    g_playerTablePass121++;
+    g_playerTableStats121.passes++;
+    struct PublishOnExit {
+        ~PublishOnExit() {
+            g_playerList.Commit();
+            SignalStateReady();
         }
-    }
+    } pub;
 
-    if (!usedHelper) {
-        // Slow path: original per-entity JNI calls
-        for (auto& lw : lwList) {
-            if (processedCount < maxPlayersToProcess) {
-                std::string name = GetStablePlayerName(env, lw.obj);
-                if (name.empty()) {
-                    char fallback[24];
-                    snprintf(fallback, sizeof(fallback), "Player_%d", processedCount + 1);
-                    name = fallback;
-                }
-                if (LooksLikeFakePlayerLine(name)) {
-                    env->DeleteLocalRef(lw.obj);
-                    continue;
-                }
-
-                double hp = 20.0;
-                if (g_getHealth_121) {
-                    hp = env->CallFloatMethod(lw.obj, g_getHealth_121);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); hp = 20.0; }
-                }
-
-                int armor = GetEntityArmor(env, lw.obj);
-                std::string held = GetHeldItemInfo(env, lw.obj);
+    // Names to hide this pass; SyncNametagSuppression121 diffs them against
+    // what is already applied.
+    static std::vector<std::string> s_hideNames;
+    s_hideNames.clear();
 
-                localList.emplace_back(PlayerData121{name, lw.dist, lw.x, lw.y, lw.z, hp, armor, held});
-                processedCount++;
-            }
-            env->DeleteLocalRef(lw.obj);
-        }
-    }
+    int processedCount = 0;
+    for (size_t k = 0; k < s_players.size(); k++) {
+        const ScanEngine::PlayerSample& p = s_players[k];
+        const PlayerListAdapter121::Extra& e = s_adapter.extras[p.index];
+        std::string name = p.name;
+        if (e.nameless) {
+            char fallback[24];
+            snprintf(fallback, sizeof(fallback), "Player_%d", processedCount + 1);
+            name = fallback;
+        } else if (hideVanillaTags && hideScoreboardObj && hideTeamObj && !synthetic) {
+            s_hideNames.push_back(name);
+        }
+
+        const unsigned key = PlayerRowKey121(e.entityId, name);
+        lc::SlotHandle handle;
+        bool fresh = false;
+        PlayerRow121& row = TouchPlayerRow121(key, &handle, &fresh);
+        unsigned changes = 0;
+        if (AssignIfChanged121(row.name, name)) changes |= kPlayerAttrs;
+        if (AssignIfChanged121(row.hp, (double)p.health)) changes |= kPlayerAttrs;
+        if (e.hasAttrs) {
+            if (!s_adapter.batched) {
+                row.slowAtMs = now;
+                g_playerTableStats121.slowReads++;
+            }
+            if (AssignIfChanged121(row.armor, p.armor)) changes |= kPlayerAttrs;
+            if (AssignIfChanged121(row.heldItem, e.heldItem)) changes |= kPlayerAttrs;
+        }
+        EmitPlayerRow121(localList, row, handle, key, fresh, changes, p.dist, p.x, p.y, p.z, scanQpc);
+        processedCount++;
+    }
+
+    LC_SYNTH_ITEMS(synthStage, localList.size());
+
+    // Rows this pass did not reach are gone.
+    g_playerTable121.Expire(g_playerTablePass121, 0,
+        [](unsigned, PlayerRow121&) { g_playerTableStats121.removed++; });
+
+    if (hideVanillaTags && hideScoreboardObj && hideTeamObj)
+        SyncNametagSuppression121(env, hideScoreboardObj, hideTeamObj, s_hideNames, now,
+                                  suppressionAttemptedThisPass, suppressionAppliedThisPass);
 
     // Clean up local references exactly once.
     if (hideTeamObj) env->DeleteLocalRef(hideTeamObj);
@@ -3935,7 +4460,7 @@ static void EnsureBlockEntityClass(JNIEnv* env) {
             if (env->ExceptionCheck()) { env->ExceptionClear(); be = nullptr; }
         }
     }
-    if (be) { g_blockEntityClass_121 = (jclass)env->NewGlobalRef(be); env->DeleteLocalRef(be); }
+    if (be) { g_blockEntityClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, be, s_refChestEsp121); env->DeleteLocalRef(be); }
     if (!g_blockEntityClass_121) {
         static bool logged = false;
         if (!logged) { Log("EnsureBlockEntityClass: failed to find BlockEntity!"); logged = true; }
@@ -3971,101 +4496,30 @@ static bool EnsureChunkAccess(JNIEnv* env, jobject worldObj) {
     }
 
     // 2) Reflection fallback – walk superclass chain for any (int,int)->Object method.
-    jclass cClass  = env->FindClass("java/lang/Class");
-    jclass cMethod = env->FindClass("java/lang/reflect/Method");
-    if (env->ExceptionCheck() || !cClass || !cMethod) {
-        env->ExceptionClear();
-        if (cClass ) env->DeleteLocalRef(cClass);
-        if (cMethod) env->DeleteLocalRef(cMethod);
-        env->DeleteLocalRef(worldCls);
-        return false;
-    }
-
-    jmethodID mDeclMethods = env->GetMethodID(cClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;");
-    jmethodID mGetSuper    = env->GetMethodID(cClass, "getSuperclass",      "()Ljava/lang/Class;");
-    jmethodID mMName       = env->GetMethodID(cMethod,"getName",            "()Ljava/lang/String;");
-    jmethodID mMParams     = env->GetMethodID(cMethod,"getParameterTypes",  "()[Ljava/lang/Class;");
-    jmethodID mMRet        = env->GetMethodID(cMethod,"getReturnType",      "()Ljava/lang/Class;");
-    if (env->ExceptionCheck()) env->ExceptionClear();
-
-    if (!mDeclMethods || !mGetSuper || !mMName || !mMParams || !mMRet) {
-        env->DeleteLocalRef(cClass); env->DeleteLocalRef(cMethod); env->DeleteLocalRef(worldCls);
-        static bool lg = false;
-        if (!lg) { Log("EnsureChunkAccess: reflection method IDs unavailable"); lg = true; }
-        return false;
-    }
-
-    std::vector<jclass> chain;
-    jclass cur = (jclass)env->NewLocalRef(worldCls);
-    while (cur) {
-        chain.push_back(cur);
-        jclass sup = (jclass)env->CallObjectMethod(cur, mGetSuper);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); sup = nullptr; }
-        cur = sup;
-    }
-
     bool found = false;
-    for (jclass cls : chain) {
-        if (found) break;
-        jobjectArray methods = (jobjectArray)env->CallObjectMethod(cls, mDeclMethods);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-        if (!methods) continue;
-
-        jsize mc = env->GetArrayLength(methods);
-        for (int i = 0; i < mc && !found; i++) {
-            jobject m = env->GetObjectArrayElement(methods, i);
-            if (!m) continue;
-
-            jobjectArray params = (jobjectArray)env->CallObjectMethod(m, mMParams);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); params = nullptr; }
-            bool intInt = false;
-            if (params && env->GetArrayLength(params) == 2) {
-                jobject p0 = env->GetObjectArrayElement(params, 0);
-                jobject p1 = env->GetObjectArrayElement(params, 1);
-                std::string n0 = p0 ? GetClassNameFromClass(env, (jclass)p0) : "";
-                std::string n1 = p1 ? GetClassNameFromClass(env, (jclass)p1) : "";
-                intInt = (n0 == "int" && n1 == "int");
-                if (p0) env->DeleteLocalRef(p0);
-                if (p1) env->DeleteLocalRef(p1);
-            }
-            if (params) env->DeleteLocalRef(params);
-            if (!intInt) { env->DeleteLocalRef(m); continue; }
-
-            jstring jmn = (jstring)env->CallObjectMethod(m, mMName);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); env->DeleteLocalRef(m); continue; }
-            const char* cmn = jmn ? env->GetStringUTFChars(jmn, nullptr) : nullptr;
-            std::string mname = cmn ? cmn : "";
-            if (cmn) env->ReleaseStringUTFChars(jmn, cmn);
-            if (jmn) env->DeleteLocalRef(jmn);
-
-            jobject retCls = env->CallObjectMethod(m, mMRet);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); retCls = nullptr; }
-            std::string retName = retCls ? GetClassNameFromClass(env, (jclass)retCls) : "";
-            if (retCls) env->DeleteLocalRef(retCls);
-            env->DeleteLocalRef(m);
-
-            if (retName.empty() || retName == "void" || retName == "int" ||
-                retName == "long" || retName == "boolean" || retName == "float" || retName == "double")
-                continue;
-
-            std::string retDesc = retName;
-            for (char& c : retDesc) if (c == '.') c = '/';
-            std::string sig = "(II)L" + retDesc + ";";
-
-            jmethodID mid = env->GetMethodID(cls, mname.c_str(), sig.c_str());
+    MemberIndex::Query q(env);
+    jclass cls = (jclass)env->NewLocalRef(worldCls);
+    while (cls && !found) {
+        const std::vector<MemberIndex::Method>& methods = q.Methods(cls);
+        for (size_t i = 0; i < methods.size() && !found; i++) {
+            const MemberIndex::Method& m = methods[i];
+            if (m.params.size() != 2 || *m.params[0] != "int" || *m.params[1] != "int") continue;
+            // Object return types only
+            if ((*m.sig)[m.sig->size() - 1] != ';') continue;
+
+            jmethodID mid = env->GetMethodID(cls, m.name->c_str(), m.sig->c_str());
             if (env->ExceptionCheck()) { env->ExceptionClear(); mid = nullptr; }
             if (mid) {
                 g_worldGetChunkMethod_121 = mid;
-                Log("Found getChunk (reflection): " + mname + " " + sig);
+                Log("Found getChunk (reflection): " + *m.name + " " + *m.sig);
                 found = true;
             }
         }
-        env->DeleteLocalRef(methods);
+        jclass sup = env->GetSuperclass(cls);
+        env->DeleteLocalRef(cls);
+        cls = sup;
     }
-
-    for (jclass cls : chain) env->DeleteLocalRef(cls);
-    env->DeleteLocalRef(cClass);
-    env->DeleteLocalRef(cMethod);
+    if (cls) env->DeleteLocalRef(cls);
     env->DeleteLocalRef(worldCls);
 
     if (!found) {
@@ -4113,14 +4567,6 @@ static bool EnsureChunkBEMap(JNIEnv* env, jobject chunkObj) {
     }
 
     // ---------- Step 2: Reflection helpers ----------
-    jclass cClass = env->FindClass("java/lang/Class");
-    jclass cField = env->FindClass("java/lang/reflect/Field");
-    jmethodID mGetDeclFields = cClass ? env->GetMethodID(cClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;") : nullptr;
-    jmethodID mGetSuper      = cClass ? env->GetMethodID(cClass, "getSuperclass", "()Ljava/lang/Class;") : nullptr;
-    jmethodID mFName  = cField ? env->GetMethodID(cField, "getName", "()Ljava/lang/String;") : nullptr;
-    jmethodID mFType  = cField ? env->GetMethodID(cField, "getType", "()Ljava/lang/Class;")  : nullptr;
-    if (env->ExceptionCheck()) env->ExceptionClear();
-
     jclass mapInterface = env->FindClass("java/util/Map");
     jmethodID mSize = mapInterface ? env->GetMethodID(mapInterface, "size", "()I") : nullptr;
     jmethodID mVals = mapInterface ? env->GetMethodID(mapInterface, "values", "()Ljava/util/Collection;") : nullptr;
@@ -4133,144 +4579,98 @@ static bool EnsureChunkBEMap(JNIEnv* env, jobject chunkObj) {
     jmethodID mNxt = itCls ? env->GetMethodID(itCls, "next", "()Ljava/lang/Object;") : nullptr;
     if (env->ExceptionCheck()) env->ExceptionClear();
 
-    bool canReflect = mGetDeclFields && mGetSuper && mFName && mFType
-                   && mSize && mVals && mIter && mHN && mNxt;
+    bool canReflect = mSize && mVals && mIter && mHN && mNxt;
 
     // ---------- Step 3: Walk the class hierarchy and find validated Map field ----------
+    // Retried on every scan until a chunk holds a block entity: the member
+    // index keeps those retries free of reflection.
+    bool found = false;
     if (canReflect) {
+        MemberIndex::Query q(env);
         jclass currentClass = (jclass)env->NewLocalRef(chunkRootCls);
         int depth = 0;
-        while (currentClass && depth < 10) {
+        while (currentClass && depth < 10 && !found) {
             std::string clsName = GetClassNameFromClass(env, currentClass);
-            if (clsName == "java.lang.Object") { env->DeleteLocalRef(currentClass); break; }
-
-            jobjectArray fields = (jobjectArray)env->CallObjectMethod(currentClass, mGetDeclFields);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); fields = nullptr; }
-            if (fields) {
-                jsize fc = env->GetArrayLength(fields);
-                Log("EnsureChunkBEMap scanning " + clsName + " (" + std::to_string(fc) + " fields)");
-
-                for (int i = 0; i < fc; i++) {
-                    jobject fld = env->GetObjectArrayElement(fields, i);
-                    if (!fld) continue;
-
-                    jclass ft = (jclass)env->CallObjectMethod(fld, mFType);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); ft = nullptr; }
-
-                    bool isMap = ft && mapInterface && (env->IsAssignableFrom(ft, mapInterface) == JNI_TRUE);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); isMap = false; }
-
-                    if (isMap) {
-                        // Get field name
-                        jstring jfn = (jstring)env->CallObjectMethod(fld, mFName);
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); jfn = nullptr; }
-                        std::string fn = "?";
-                        if (jfn) {
-                            const char* c = env->GetStringUTFChars(jfn, nullptr);
-                            fn = c ? c : "?"; if (c) env->ReleaseStringUTFChars(jfn, c);
-                            env->DeleteLocalRef(jfn);
-                        }
-
-                        // Get fieldID — try Ljava/util/Map; first, then actual type
-                        jfieldID fid = env->GetFieldID(chunkRootCls, fn.c_str(), "Ljava/util/Map;");
+            if (clsName == "java.lang.Object") break;
+
+            const std::vector<MemberIndex::Field>& fields = q.Fields(currentClass);
+            if (!fields.empty()) {
+                Log("EnsureChunkBEMap scanning " + clsName + " (" + std::to_string(fields.size()) + " fields)");
+
+                for (size_t i = 0; i < fields.size() && !found; i++) {
+                    const MemberIndex::Field& fd = fields[i];
+                    if (fd.IsStatic() || !IndexedTypeIsA121(env, *fd.type, mapInterface)) continue;
+                    const std::string& fn = *fd.name;
+
+                    // Get fieldID — try Ljava/util/Map; first, then actual type
+                    jfieldID fid = env->GetFieldID(chunkRootCls, fn.c_str(), "Ljava/util/Map;");
+                    if (env->ExceptionCheck()) { env->ExceptionClear(); fid = nullptr; }
+                    if (!fid) {
+                        fid = env->GetFieldID(chunkRootCls, fn.c_str(), fd.sig->c_str());
                         if (env->ExceptionCheck()) { env->ExceptionClear(); fid = nullptr; }
-                        if (!fid) {
-                            std::string tn = GetClassNameFromClass(env, ft);
-                            std::string desc = "L" + tn + ";";
-                            for (char& cc : desc) if (cc == '.') cc = '/';
-                            fid = env->GetFieldID(chunkRootCls, fn.c_str(), desc.c_str());
-                            if (env->ExceptionCheck()) { env->ExceptionClear(); fid = nullptr; }
-                        }
-
-                        if (fid) {
-                            jobject mapObj = env->GetObjectField(chunkObj, fid);
-                            if (env->ExceptionCheck()) { env->ExceptionClear(); mapObj = nullptr; }
-                            if (mapObj) {
-                                int mapSz = env->CallIntMethod(mapObj, mSize);
-                                if (env->ExceptionCheck()) { env->ExceptionClear(); mapSz = 0; }
-
-                                Log("  Map candidate: " + fn + " on " + clsName + " size=" + std::to_string(mapSz));
-
-                                if (mapSz > 0 && g_blockEntityClass_121) {
-                                    // Validate: check if first value is instanceof BlockEntity
-                                    jobject col = env->CallObjectMethod(mapObj, mVals);
-                                    if (env->ExceptionCheck()) { env->ExceptionClear(); col = nullptr; }
-                                    if (col) {
-                                        jobject it = env->CallObjectMethod(col, mIter);
-                                        if (env->ExceptionCheck()) { env->ExceptionClear(); it = nullptr; }
-                                        if (it) {
-                                            jboolean hn = env->CallBooleanMethod(it, mHN);
-                                            if (env->ExceptionCheck()) { env->ExceptionClear(); hn = false; }
-                                            if (hn) {
-                                                jobject val = env->CallObjectMethod(it, mNxt);
-                                                if (env->ExceptionCheck()) { env->ExceptionClear(); val = nullptr; }
-                                                if (val) {
-                                                    bool isBE = (env->IsInstanceOf(val, g_blockEntityClass_121) == JNI_TRUE);
-                                                    if (env->ExceptionCheck()) { env->ExceptionClear(); isBE = false; }
-                                                    jclass vCls = env->GetObjectClass(val);
-                                                    std::string vType = vCls ? GetClassNameFromClass(env, vCls) : "?";
-                                                    if (vCls) env->DeleteLocalRef(vCls);
-                                                    Log("    First value: " + vType + " isBE=" + (isBE ? "true" : "false"));
-
-                                                    if (isBE) {
-                                                        g_chunkBlockEntitiesMapField_121 = fid;
-                                                        Log("VALIDATED blockEntities map: " + fn + " on " + clsName);
-                                                        env->DeleteLocalRef(val);
-                                                        env->DeleteLocalRef(it);
-                                                        env->DeleteLocalRef(col);
-                                                        env->DeleteLocalRef(mapObj);
-                                                        if (ft) env->DeleteLocalRef(ft);
-                                                        env->DeleteLocalRef(fld);
-                                                        env->DeleteLocalRef(fields);
-                                                        env->DeleteLocalRef(currentClass);
-                                                        if (cClass) env->DeleteLocalRef(cClass);
-                                                        if (cField) env->DeleteLocalRef(cField);
-                                                        if (mapInterface) env->DeleteLocalRef(mapInterface);
-                                                        if (colCls) env->DeleteLocalRef(colCls);
-                                                        if (itCls) env->DeleteLocalRef(itCls);
-                                                        env->DeleteLocalRef(chunkRootCls);
-                                                        return true;
-                                                    }
-                                                    env->DeleteLocalRef(val);
-                                                }
-                                            }
-                                            env->DeleteLocalRef(it);
-                                        }
-                                        env->DeleteLocalRef(col);
-                                    }
-                                }
-                                env->DeleteLocalRef(mapObj);
+                    }
+                    if (!fid) continue;
+
+                    jobject mapObj = env->GetObjectField(chunkObj, fid);
+                    if (env->ExceptionCheck()) { env->ExceptionClear(); mapObj = nullptr; }
+                    if (!mapObj) continue;
+                    int mapSz = env->CallIntMethod(mapObj, mSize);
+                    if (env->ExceptionCheck()) { env->ExceptionClear(); mapSz = 0; }
+
+                    Log("  Map candidate: " + fn + " on " + clsName + " size=" + std::to_string(mapSz));
+
+                    if (mapSz > 0 && g_blockEntityClass_121) {
+                        // Validate: check if first value is instanceof BlockEntity
+                        jobject col = env->CallObjectMethod(mapObj, mVals);
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); col = nullptr; }
+                        jobject it = col ? env->CallObjectMethod(col, mIter) : nullptr;
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); it = nullptr; }
+                        jboolean hn = it ? env->CallBooleanMethod(it, mHN) : JNI_FALSE;
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); hn = JNI_FALSE; }
+                        jobject val = hn ? env->CallObjectMethod(it, mNxt) : nullptr;
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); val = nullptr; }
+                        if (val) {
+                            bool isBE = (env->IsInstanceOf(val, g_blockEntityClass_121) == JNI_TRUE);
+                            if (env->ExceptionCheck()) { env->ExceptionClear(); isBE = false; }
+                            jclass vCls = env->GetObjectClass(val);
+                            std::string vType = vCls ? GetClassNameFromClass(env, vCls) : "?";
+                            if (vCls) env->DeleteLocalRef(vCls);
+                            Log("    First value: " + vType + " isBE=" + (isBE ? "true" : "false"));
+
+                            if (isBE) {
+                                g_chunkBlockEntitiesMapField_121 = fid;
+                                Log("VALIDATED blockEntities map: " + fn + " on " + clsName);
+                                found = true;
                             }
+                            env->DeleteLocalRef(val);
                         }
+                        if (it) env->DeleteLocalRef(it);
+                        if (col) env->DeleteLocalRef(col);
                     }
-                    if (ft) env->DeleteLocalRef(ft);
-                    env->DeleteLocalRef(fld);
+                    env->DeleteLocalRef(mapObj);
                 }
-                env->DeleteLocalRef(fields);
             }
 
             // Move to parent class
-            jclass parent = (jclass)env->CallObjectMethod(currentClass, mGetSuper);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); parent = nullptr; }
+            jclass parent = env->GetSuperclass(currentClass);
             env->DeleteLocalRef(currentClass);
             currentClass = parent;
             depth++;
         }
+        if (currentClass) env->DeleteLocalRef(currentClass);
     }
 
     // ---------- Cleanup ----------
     static bool loggedFail = false;
-    if (!loggedFail) {
+    if (!found && !loggedFail) {
         loggedFail = true;
         Log("EnsureChunkBEMap: no Map with BlockEntity values found in hierarchy (chunk may be empty — will retry)");
     }
-    if (cClass) env->DeleteLocalRef(cClass);
-    if (cField) env->DeleteLocalRef(cField);
     if (mapInterface) env->DeleteLocalRef(mapInterface);
     if (colCls) env->DeleteLocalRef(colCls);
     if (itCls) env->DeleteLocalRef(itCls);
     env->DeleteLocalRef(chunkRootCls);
-    return false;
+    return found;
 }
 
 static void EnsureBlockPosCache(JNIEnv* env, jobject beObj) {
@@ -4305,7 +4705,7 @@ static void EnsureBlockPosCache(JNIEnv* env, jobject beObj) {
             }
         }
         if (bp) {
-            g_blockPosClass_121 = (jclass)env->NewGlobalRef(bp);
+            g_blockPosClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, bp, s_refCore121);
             env->DeleteLocalRef(bp);
             
             const char* xNames[] = { "x", "field_11175", "field_13358", "f_123290_", nullptr };
@@ -4361,43 +4761,20 @@ static void EnsureBlockPosCache(JNIEnv* env, jobject beObj) {
         if (!vec3iCls2) vec3iCls2 = env->FindClass("net/minecraft/class_2382");
         if (env->ExceptionCheck()) { env->ExceptionClear(); vec3iCls2 = nullptr; }
         if (vec3iCls2) {
-            jclass cCls = env->FindClass("java/lang/Class");
-            jmethodID mGDF = cCls ? env->GetMethodID(cCls, "getDeclaredFields", "()[Ljava/lang/reflect/Field;") : nullptr;
-            jclass fCls = env->FindClass("java/lang/reflect/Field");
-            jmethodID mGT = fCls ? env->GetMethodID(fCls, "getType", "()Ljava/lang/Class;") : nullptr;
-            jmethodID mGN = fCls ? env->GetMethodID(fCls, "getName", "()Ljava/lang/String;") : nullptr;
-            if (mGDF && mGT && mGN) {
-                jobjectArray fields = (jobjectArray)env->CallObjectMethod(vec3iCls2, mGDF);
-                if (fields && !env->ExceptionCheck()) {
-                    jclass intTypeCls = env->FindClass("java/lang/Integer");
-                    jfieldID intTypeField = intTypeCls ? env->GetStaticFieldID(intTypeCls, "TYPE", "Ljava/lang/Class;") : nullptr;
-                    jobject intPrimCls = intTypeField ? env->GetStaticObjectField(intTypeCls, intTypeField) : nullptr;
-                    jsize fc = env->GetArrayLength(fields);
-                    std::vector<std::string> intNames;
-                    for (jsize i = 0; i < fc && intNames.size() < 3; i++) {
-                        jobject f = env->GetObjectArrayElement(fields, i);
-                        jobject ft = env->CallObjectMethod(f, mGT);
-                        if (ft && intPrimCls && env->IsSameObject(ft, intPrimCls)) {
-                            jstring jn = (jstring)env->CallObjectMethod(f, mGN);
-                            const char* cn = env->GetStringUTFChars(jn, nullptr);
-                            if (cn) { intNames.push_back(cn); env->ReleaseStringUTFChars(jn, cn); }
-                            env->DeleteLocalRef(jn);
-                        }
-                        if (ft) env->DeleteLocalRef(ft);
-                        env->DeleteLocalRef(f);
-                    }
-                    if (intNames.size() >= 3) {
-                        if (!g_blockPosX_121) g_blockPosX_121 = env->GetFieldID(vec3iCls2, intNames[0].c_str(), "I");
-                        if (!g_blockPosY_121) g_blockPosY_121 = env->GetFieldID(vec3iCls2, intNames[1].c_str(), "I");
-                        if (!g_blockPosZ_121) g_blockPosZ_121 = env->GetFieldID(vec3iCls2, intNames[2].c_str(), "I");
-                        if (env->ExceptionCheck()) env->ExceptionClear();
-                    }
-                    if (intTypeCls) env->DeleteLocalRef(intTypeCls);
+            std::vector<std::string> intNames;
+            {
+                MemberIndex::Query q(env);
+                const std::vector<MemberIndex::Field>& fields = q.Fields(vec3iCls2);
+                for (size_t i = 0; i < fields.size() && intNames.size() < 3; i++) {
+                    if (!fields[i].IsStatic() && *fields[i].type == "int") intNames.push_back(*fields[i].name);
                 }
-                if (fields) env->DeleteLocalRef(fields);
             }
-            if (cCls) env->DeleteLocalRef(cCls);
-            if (fCls) env->DeleteLocalRef(fCls);
+            if (intNames.size() >= 3) {
+                if (!g_blockPosX_121) g_blockPosX_121 = env->GetFieldID(vec3iCls2, intNames[0].c_str(), "I");
+                if (!g_blockPosY_121) g_blockPosY_121 = env->GetFieldID(vec3iCls2, intNames[1].c_str(), "I");
+                if (!g_blockPosZ_121) g_blockPosZ_121 = env->GetFieldID(vec3iCls2, intNames[2].c_str(), "I");
+                if (env->ExceptionCheck()) env->ExceptionClear();
+            }
             env->DeleteLocalRef(vec3iCls2);
         }
     }
@@ -4461,9 +4838,13 @@ static void EnsureHashMapDirectFields(JNIEnv* env) {
     if (!hmCls) { env->ExceptionClear(); return; }
     g_javaHashMapTableField = env->GetFieldID(hmCls, "table", "[Ljava/util/HashMap$Node;");
     if (env->ExceptionCheck()) { env->ExceptionClear(); g_javaHashMapTableField = nullptr; }
+    g_javaHashMapModCountField = env->GetFieldID(hmCls, "modCount", "I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); g_javaHashMapModCountField = nullptr; }
+    g_javaHashMapSizeField = env->GetFieldID(hmCls, "size", "I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); g_javaHashMapSizeField = nullptr; }
     // Keep a global ref so we can IsInstanceOf-check every map before direct access
     if (!g_javaHashMapClass)
-        g_javaHashMapClass = (jclass)env->NewGlobalRef(hmCls);
+        g_javaHashMapClass = (jclass)LC_NEW_GLOBAL_REF(env, hmCls, s_refChestEsp121);
     env->DeleteLocalRef(hmCls);
     jclass nodeCls = env->FindClass("java/util/HashMap$Node");
     if (!nodeCls) { env->ExceptionClear(); return; }
@@ -4492,6 +4873,103 @@ static bool ReadBlockPosCoords(JNIEnv* env, jobject bp, double& outX, double& ou
     return hasX && hasY && hasZ;
 }
 
+// Per-chunk chest index for UpdateChestList.  A chunk's block-entity map is
+// walked again only when the chunk object is a different one (reloaded), the
+// HashMap's modCount/size moved, or the chunk just entered the scan window;
+// otherwise its cached chest positions are reused.  Scan thread only.
+struct ChestChunkEntry121 {
+    jweak chunk = nullptr;      // identity of the chunk the positions came from
+    jint  modCount = -1;        // -1: not cacheable (non-HashMap map or changed mid-walk)
+    jint  size = -1;
+    unsigned seenPass = 0;
+    std::vector<ChestData121> chests;   // dist is filled per pass
+};
+static std::unordered_map<long long, ChestChunkEntry121> g_chestChunkCache121;
+static unsigned g_chestScanPass121 = 0;
+
+static void ResetChestChunkCache121(JNIEnv* env) {
+    for (auto& kv : g_chestChunkCache121)
+        if (kv.second.chunk && env) RefLedger::Delete(env, kv.second.chunk);
+    g_chestChunkCache121.clear();
+}
+
+static bool ReadMapChangeStamp121(JNIEnv* env, jobject mapObj, jint& modCount, jint& size) {
+    if (!g_javaHashMapModCountField || !g_javaHashMapSizeField) return false;
+    modCount = env->GetIntField(mapObj, g_javaHashMapModCountField);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return false; }
+    size = env->GetIntField(mapObj, g_javaHashMapSizeField);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return false; }
+    return true;
+}
+
+// Reflection handles for AokoHelper.collectBlockEntities (global refs).
+struct ChestHelperHandles121 {
+    jobject getChunk = nullptr;     // reflect.Method World.getChunk(int,int)
+    jobject beMap = nullptr;        // reflect.Field Chunk.blockEntities
+    jobject posX = nullptr, posY = nullptr, posZ = nullptr;
+    jobjectArray kinds = nullptr;   // Class[] of g_chestBlockEntityClasses
+};
+static ChestHelperHandles121 g_chestHelper121;
+
+static void ResetChestHelper121(JNIEnv* env) {
+    jobject refs[] = { g_chestHelper121.getChunk, g_chestHelper121.beMap, g_chestHelper121.posX,
+                       g_chestHelper121.posY, g_chestHelper121.posZ, g_chestHelper121.kinds };
+    for (jobject r : refs)
+        if (r && env) RefLedger::Delete(env, r);
+    g_chestHelper121 = ChestHelperHandles121();
+}
+
+// True once every handle collectBlockEntities needs is resolved.  The
+// blockEntities field and BlockPos fields come from the JNI walk's discovery,
+// so the first passes of a session always take the JNI path.
+static bool EnsureChestHelper121(JNIEnv* env, jobject worldObj) {
+    if (g_chestHelper121.kinds) return HelperBridge::HasBlockEntityCollector();
+    if (!g_chunkBlockEntitiesMapField_121 || !g_worldGetChunkMethod_121 || !g_blockPosClass_121
+        || !g_blockPosX_121 || !g_blockPosY_121 || !g_blockPosZ_121)
+        return false;
+    if (!EnsureHelperBridgeLoaded121(env) || !HelperBridge::HasBlockEntityCollector()) return false;
+
+    EnsureChestBlockEntityClasses(env);
+    bool anyKind = false;
+    for (int i = 0; i < 4; i++) anyKind = anyKind || g_chestBlockEntityClasses[i] != nullptr;
+    if (!anyKind) return false;   // only the translation-key fallback can classify; keep the JNI walk
+
+    jclass worldCls = env->GetObjectClass(worldObj);
+    jobject chunkObj = env->CallObjectMethod(worldObj, g_worldGetChunkMethod_121, 0, 0);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); chunkObj = nullptr; }
+    jclass chunkCls = chunkObj ? env->GetObjectClass(chunkObj) : nullptr;
+    if (chunkObj) env->DeleteLocalRef(chunkObj);
+    if (worldCls && chunkCls) {
+        jobject m = env->ToReflectedMethod(worldCls, g_worldGetChunkMethod_121, JNI_FALSE);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); m = nullptr; }
+        if (m) { g_chestHelper121.getChunk = LC_NEW_GLOBAL_REF(env, m, s_refChestEsp121); env->DeleteLocalRef(m); }
+        g_chestHelper121.beMap = ReflectedFieldGlobal121(env, chunkCls, g_chunkBlockEntitiesMapField_121);
+        g_chestHelper121.posX = ReflectedFieldGlobal121(env, g_blockPosClass_121, g_blockPosX_121);
+        g_chestHelper121.posY = ReflectedFieldGlobal121(env, g_blockPosClass_121, g_blockPosY_121);
+        g_chestHelper121.posZ = ReflectedFieldGlobal121(env, g_blockPosClass_121, g_blockPosZ_121);
+        jclass classCls = env->FindClass("java/lang/Class");
+        if (env->ExceptionCheck()) { env->ExceptionClear(); classCls = nullptr; }
+        jobjectArray arr = classCls ? env->NewObjectArray(4, classCls, nullptr) : nullptr;
+        if (env->ExceptionCheck()) { env->ExceptionClear(); arr = nullptr; }
+        if (arr) {
+            for (int i = 0; i < 4; i++) env->SetObjectArrayElement(arr, i, g_chestBlockEntityClasses[i]);
+            if (g_chestHelper121.getChunk && g_chestHelper121.beMap && g_chestHelper121.posX
+                && g_chestHelper121.posY && g_chestHelper121.posZ)
+                g_chestHelper121.kinds = (jobjectArray)LC_NEW_GLOBAL_REF(env, arr, s_refChestEsp121);
+            env->DeleteLocalRef(arr);
+        }
+        if (classCls) env->DeleteLocalRef(classCls);
+    }
+    if (worldCls) env->DeleteLocalRef(worldCls);
+    if (chunkCls) env->DeleteLocalRef(chunkCls);
+    if (!g_chestHelper121.kinds) {
+        ResetChestHelper121(env);   // partial handles: retry on a later pass
+        return false;
+    }
+    Log("ChestESP: block-entity helper path ready.");
+    return true;
+}
+
 static void UpdateChestList(JNIEnv* env) {
     DWORD now = GetTickCount();
     if (now - g_lastChestScanMs < 100) return;
@@ -4507,12 +4985,12 @@ static void UpdateChestList(JNIEnv* env) {
             sn.find("AbstractContainerScreen") != std::string::npos) return;
     }
     g_lastChestScanMs = now;
+    LC_SYNTH_STAGE(synthStage, SyntheticLoad::kChestScan);
     std::vector<ChestData121> localList;
 
     // Diagnostic: log entry every 5 seconds
-    static DWORD s_chestEntryLogMs = 0;
-    bool entryLog = (now - s_chestEntryLogMs > 5000);
-    if (entryLog) s_chestEntryLogMs = now;
+    static AsyncLog::RateGate s_chestEntryGate;
+    bool entryLog = AsyncLog::Allow(s_chestEntryGate, 5000);
 
     if (!g_mcInstance || !g_worldField_121 || !g_playerField_121) {
         if (entryLog) Log("ChestESP: precondition fail mc=" + std::to_string((long long)g_mcInstance) + " world=" + std::to_string((long long)g_worldField_121) + " player=" + std::to_string((long long)g_playerField_121));
@@ -4553,8 +5031,58 @@ static void UpdateChestList(JNIEnv* env) {
     bool usedFallbackPath = false;
     int chunksScanned = 0;
     int chunksWithBEMap = 0;
+    int chunksReused = 0;
+    const unsigned pass = ++g_chestScanPass121;
+
+    // Fast path: one AokoHelper crossing walks the whole window and returns
+    // packed (x, y, z, kind) records.  A chunk whose map changed under the
+    // helper's walk keeps its previous positions for this pass.
+    HelperBridge::BlockEntityFrame beFrame;
+    const int windowChunks = (2 * RANGE + 1) * (2 * RANGE + 1);
+    bool usedHelper;
+#if LC_SYNTHETIC_LOAD
+    if (SyntheticLoad::Active())
+        usedHelper = SyntheticLoad::FillBlockEntities(sx, sy, sz, pcx, pcz, RANGE, beFrame) == windowChunks;
+    else
+#endif
+    usedHelper = EnsureChestHelper121(env, worldObj)
+        && HelperBridge::CollectBlockEntities(env, worldObj, g_chestHelper121.getChunk, pcx, pcz, RANGE,
+                                              g_chestHelper121.beMap, g_chestHelper121.kinds,
+                                              g_chestHelper121.posX, g_chestHelper121.posY, g_chestHelper121.posZ,
+                                              beFrame) == windowChunks;
+    if (usedHelper) {
+        size_t ci = 0;
+        for (int dx = -RANGE; dx <= RANGE; dx++) {
+            for (int dz = -RANGE; dz <= RANGE; dz++) {
+                const HelperBridge::BlockEntityChunk& c = beFrame.chunks[ci++];
+                if (c.count == HelperBridge::kChunkMissing) continue;
+                chunksScanned++;
+                chunksWithBEMap++;
+                totalBEsScanned += c.scanned;
+                const long long chunkKey = ((long long)(pcx + dx) << 32) ^ (long long)(unsigned)(pcz + dz);
+                ChestChunkEntry121& entry = g_chestChunkCache121[chunkKey];
+                entry.seenPass = pass;
+                if (c.count == HelperBridge::kChunkFailed) {
+                    chunksReused++;
+                } else {
+                    entry.chests.clear();
+                    for (int r = 0; r < c.count; r++) {
+                        const HelperBridge::BlockEntityRecord& rec = beFrame.records[c.first + r];
+                        entry.chests.push_back({rec.x + 0.5, (double)rec.y, rec.z + 0.5, 0.0});
+                    }
+                    entry.modCount = -1;   // the helper has no change stamps; the JNI walk re-reads
+                    entry.size = -1;
+                }
+                totalChests += (int)entry.chests.size();
+                for (const auto& ch : entry.chests) {
+                    double ddx = ch.x-sx, ddy = ch.y-sy, ddz = ch.z-sz;
+                    localList.push_back({ch.x, ch.y, ch.z, std::sqrt(ddx*ddx+ddy*ddy+ddz*ddz)});
+                }
+            }
+        }
+    }
 
-    for (int dx = -RANGE; dx <= RANGE; dx++) {
+    for (int dx = -RANGE; !usedHelper && dx <= RANGE; dx++) {
         for (int dz = -RANGE; dz <= RANGE; dz++) {
             // Re-check transition guard inside the loop too
             if (GetTickCount() < g_worldTransitionEndMs) break;
@@ -4575,13 +5103,34 @@ static void UpdateChestList(JNIEnv* env) {
                         loggedMapDiag = true;
                         Log("ChestESP: blockEntities map found on chunk.");
                     }
-                    // Iterate via HashMap.table[] — zero Call*Method
                     // SAFETY: only use direct field access if mapObj is actually a HashMap
                     // (Lunar might use a custom Map impl; wrong field offset = ACCESS_VIOLATION)
-                    bool iterated = false;
-                    bool isHashMap = (g_javaHashMapClass && 
+                    bool isHashMap = (g_javaHashMapClass &&
                                       env->IsInstanceOf(mapObj, g_javaHashMapClass) == JNI_TRUE);
                     if (isHashMap) sawHashMap = true;
+
+                    const long long chunkKey = ((long long)(pcx + dx) << 32) ^ (long long)(unsigned)(pcz + dz);
+                    ChestChunkEntry121& entry = g_chestChunkCache121[chunkKey];
+                    entry.seenPass = pass;
+                    jint modCount = -1, mapSize = -1;
+                    bool stamped = isHashMap && ReadMapChangeStamp121(env, mapObj, modCount, mapSize);
+                    bool reuse = stamped && entry.modCount >= 0 && entry.modCount == modCount && entry.size == mapSize
+                        && entry.chunk && env->IsSameObject(chunkObj, entry.chunk) == JNI_TRUE;
+                    if (reuse) {
+                        chunksReused++;
+                        totalChests += (int)entry.chests.size();
+                        for (const auto& ch : entry.chests) {
+                            double ddx = ch.x-sx, ddy = ch.y-sy, ddz = ch.z-sz;
+                            localList.push_back({ch.x, ch.y, ch.z, std::sqrt(ddx*ddx+ddy*ddy+ddz*ddz)});
+                        }
+                        env->DeleteLocalRef(mapObj);
+                        env->DeleteLocalRef(chunkObj);
+                        continue;
+                    }
+                    const size_t chunkFirst = localList.size();
+
+                    // Iterate via HashMap.table[] — zero Call*Method
+                    bool iterated = false;
                     if (isHashMap && g_javaHashMapTableField && g_javaHMNodeValueField && g_javaHMNodeNextField) {
                         jobjectArray tbl = (jobjectArray)env->GetObjectField(mapObj, g_javaHashMapTableField);
                         if (env->ExceptionCheck()) { env->ExceptionClear(); tbl = nullptr; }
@@ -4756,6 +5305,18 @@ static void UpdateChestList(JNIEnv* env) {
                         if (itCls)  env->DeleteLocalRef(itCls);
                         if (entryCls) env->DeleteLocalRef(entryCls);
                     }
+
+                    // Cache this chunk's chests unless the map changed while we walked it.
+                    jint modAfter = -1, sizeAfter = -1;
+                    bool stable = stamped && iterated && ReadMapChangeStamp121(env, mapObj, modAfter, sizeAfter)
+                        && modAfter == modCount && sizeAfter == mapSize;
+                    entry.chests.assign(localList.begin() + (std::ptrdiff_t)chunkFirst, localList.end());
+                    entry.modCount = stable ? modCount : -1;
+                    entry.size = mapSize;
+                    if (!entry.chunk || env->IsSameObject(chunkObj, entry.chunk) != JNI_TRUE) {
+                        if (entry.chunk) RefLedger::Delete(env, entry.chunk);
+                        entry.chunk = LC_NEW_WEAK_REF(env, chunkObj, s_refChestEsp121);
+                    }
                     env->DeleteLocalRef(mapObj);
                 }
             }
@@ -4763,12 +5324,22 @@ static void UpdateChestList(JNIEnv* env) {
         }
     }
 
-    if (shouldLog) { lastLogMs = now; Log("UpdateChestList: chunks=" + std::to_string(chunksScanned) + " withMap=" + std::to_string(chunksWithBEMap) + " chests=" + std::to_string(totalChests) + " listed=" + std::to_string(localList.size()) + " BEs=" + std::to_string(totalBEsScanned) + " hmDirect=" + std::to_string(g_javaHashMapTableField ? 1 : 0) + " hashMapSeen=" + std::to_string(sawHashMap ? 1 : 0) + " usedDirect=" + std::to_string(usedDirectPath ? 1 : 0) + " usedFallback=" + std::to_string(usedFallbackPath ? 1 : 0)); }
+    // Chunks that left the window or unloaded.
+    for (auto it = g_chestChunkCache121.begin(); it != g_chestChunkCache121.end(); ) {
+        if (it->second.seenPass == pass) { ++it; continue; }
+        if (it->second.chunk) RefLedger::Delete(env, it->second.chunk);
+        it = g_chestChunkCache121.erase(it);
+    }
+
+    if (shouldLog) { lastLogMs = now; Log("UpdateChestList: chunks=" + std::to_string(chunksScanned) + " withMap=" + std::to_string(chunksWithBEMap) + " reused=" + std::to_string(chunksReused) + " chests=" + std::to_string(totalChests) + " listed=" + std::to_string(localList.size()) + " BEs=" + std::to_string(totalBEsScanned) + " hmDirect=" + std::to_string(g_javaHashMapTableField ? 1 : 0) + " hashMapSeen=" + std::to_string(sawHashMap ? 1 : 0) + " usedDirect=" + std::to_string(usedDirectPath ? 1 : 0) + " usedFallback=" + std::to_string(usedFallbackPath ? 1 : 0) + " helper=" + std::to_string(usedHelper ? 1 : 0)); }
 
     env->DeleteLocalRef(worldObj);
 
-    std::sort(localList.begin(), localList.end(), [](const ChestData121& a, const ChestData121& b){ return a.dist < b.dist; });
-    { LockGuard lk(g_chestListMutex); g_chestList.swap(localList); }
+    LC_SYNTH_ITEMS(synthStage, localList.size());
+
+    // Unordered: the overlay culls against the frustum and picks the nearest N itself.
+    g_chestList.BeginWrite().assign(localList.begin(), localList.end());   // POD copy into recycled capacity
+    g_chestList.Commit();
 }
 
 static std::string CallTextToString(JNIEnv* env, jobject textObj) {
@@ -4803,62 +5374,8 @@ static std::string CallTextToString(JNIEnv* env, jobject textObj) {
         // Last resort: some clients rename this method differently.
 
         // Scan declared methods for any 0-arg method returning String and cache it.
-        if (!g_textGetString_121) {
-            jclass cClass = env->FindClass("java/lang/Class");
-            jclass cMethod = env->FindClass("java/lang/reflect/Method");
-            jclass cString = env->FindClass("java/lang/String");
-            jmethodID mGetMethods = cClass ? env->GetMethodID(cClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;") : nullptr;
-            jmethodID mParams = cMethod ? env->GetMethodID(cMethod, "getParameterTypes", "()[Ljava/lang/Class;") : nullptr;
-            jmethodID mRet    = cMethod ? env->GetMethodID(cMethod, "getReturnType", "()Ljava/lang/Class;") : nullptr;
-            jmethodID mName   = cMethod ? env->GetMethodID(cMethod, "getName", "()Ljava/lang/String;") : nullptr;
-            if (env->ExceptionCheck()) { env->ExceptionClear(); mGetMethods = nullptr; mParams = nullptr; mRet = nullptr; mName = nullptr; }
-
-            if (cClass && cMethod && cString && mGetMethods && mParams && mRet && mName) {
-                jobjectArray methods = (jobjectArray)env->CallObjectMethod(textCls, mGetMethods);
-                if (env->ExceptionCheck()) { env->ExceptionClear(); methods = nullptr; }
-                if (methods) {
-                    jsize mc = env->GetArrayLength(methods);
-                    if (mc > 128) mc = 128;
-                    for (int i = 0; i < mc; i++) {
-                        jobject m = env->GetObjectArrayElement(methods, i);
-                        if (!m) continue;
-
-                        jobjectArray params = (jobjectArray)env->CallObjectMethod(m, mParams);
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); params = nullptr; }
-                        if (!params) { env->DeleteLocalRef(m); continue; }
-                        bool zeroArgs = (env->GetArrayLength(params) == 0);
-                        env->DeleteLocalRef(params);
-                        if (!zeroArgs) { env->DeleteLocalRef(m); continue; }
-
-                        jobject rt = env->CallObjectMethod(m, mRet);
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); rt = nullptr; }
-                        bool isString = (rt && env->IsSameObject(rt, cString) == JNI_TRUE);
-                        if (rt) env->DeleteLocalRef(rt);
-                        if (!isString) { env->DeleteLocalRef(m); continue; }
-
-                        jstring jmn = (jstring)env->CallObjectMethod(m, mName);
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); jmn = nullptr; }
-                        if (!jmn) { env->DeleteLocalRef(m); continue; }
-                        const char* cmn = env->GetStringUTFChars(jmn, nullptr);
-                        std::string name = cmn ? cmn : "";
-                        if (cmn) env->ReleaseStringUTFChars(jmn, cmn);
-                        env->DeleteLocalRef(jmn);
-
-                        jmethodID mid = env->GetMethodID(textCls, name.c_str(), "()Ljava/lang/String;");
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); mid = nullptr; }
-                        env->DeleteLocalRef(m);
-                        if (mid) { g_textGetString_121 = mid; break; }
-                    }
-                    env->DeleteLocalRef(methods);
-                }
-            } else {
-                if (env->ExceptionCheck()) env->ExceptionClear();
-            }
-
-            if (cClass) env->DeleteLocalRef(cClass);
-            if (cMethod) env->DeleteLocalRef(cMethod);
-            if (cString) env->DeleteLocalRef(cString);
-        }
+        if (!g_textGetString_121)
+            g_textGetString_121 = FindZeroArgMethodReturning(env, textCls, "java.lang.String", nullptr, nullptr, "()Ljava/lang/String;");
     }
     std::string r;
     if (g_textGetString_121) {
@@ -4902,7 +5419,7 @@ static void EnsureClosestPlayerCaches(JNIEnv* env) {
                 if (env->ExceptionCheck()) { env->ExceptionClear(); c = nullptr; }
             }
         }
-        if (c) { g_playerEntityClass_121 = (jclass)env->NewGlobalRef(c); env->DeleteLocalRef(c); }
+        if (c) { g_playerEntityClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refPlayers121); env->DeleteLocalRef(c); }
     }
 
     jclass mcCls = env->GetObjectClass(g_mcInstance);
@@ -4974,64 +5491,19 @@ static void DiscoverWorldPlayersListField(JNIEnv* env, jobject worldObj) {
     }
 
     // Use reflection once to find a List field that contains PlayerEntity.
-    jclass cClass = env->FindClass("java/lang/Class");
-    jmethodID mGetFields = cClass ? env->GetMethodID(cClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mGetFields = nullptr; }
-    if (!mGetFields) { if (cClass) env->DeleteLocalRef(cClass); env->DeleteLocalRef(worldCls); return; }
-
-    jclass cField = env->FindClass("java/lang/reflect/Field");
-    jmethodID mFType = cField ? env->GetMethodID(cField, "getType", "()Ljava/lang/Class;") : nullptr;
-    jmethodID mFName = cField ? env->GetMethodID(cField, "getName", "()Ljava/lang/String;") : nullptr;
-    jmethodID mFMod  = cField ? env->GetMethodID(cField, "getModifiers", "()I") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mFType = mFName = mFMod = nullptr; }
-
-    jclass cMod = env->FindClass("java/lang/reflect/Modifier");
-    jmethodID mIsStatic = cMod ? env->GetStaticMethodID(cMod, "isStatic", "(I)Z") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mIsStatic = nullptr; }
-
     jclass collectionClass = env->FindClass("java/util/Collection");
     jmethodID mToArray = collectionClass ? env->GetMethodID(collectionClass, "toArray", "()[Ljava/lang/Object;") : nullptr;
     if (env->ExceptionCheck()) { env->ExceptionClear(); mToArray = nullptr; }
 
-    jobjectArray fields = (jobjectArray)env->CallObjectMethod(worldCls, mGetFields);
-    if (env->ExceptionCheck() || !fields) {
-        env->ExceptionClear();
-        if (collectionClass) env->DeleteLocalRef(collectionClass);
-        if (cMod) env->DeleteLocalRef(cMod);
-        if (cField) env->DeleteLocalRef(cField);
-        if (cClass) env->DeleteLocalRef(cClass);
-        env->DeleteLocalRef(worldCls);
-        return;
-    }
-
-    jsize fc = env->GetArrayLength(fields);
-    for (int i = 0; i < fc; i++) {
-        jobject fld = env->GetObjectArrayElement(fields, i);
-        if (!fld) continue;
-        jint mod = mFMod ? env->CallIntMethod(fld, mFMod) : 0;
-        if (mIsStatic && env->CallStaticBooleanMethod(cMod, mIsStatic, mod)) { env->DeleteLocalRef(fld); continue; }
-        jclass ft = mFType ? (jclass)env->CallObjectMethod(fld, mFType) : nullptr;
-        if (env->ExceptionCheck()) { env->ExceptionClear(); ft = nullptr; }
-        if (!ft) { env->DeleteLocalRef(fld); continue; }
-        bool isCollection = (collectionClass && env->IsAssignableFrom(ft, collectionClass));
-        if (env->ExceptionCheck()) { env->ExceptionClear(); isCollection = false; }
-        if (!isCollection) { env->DeleteLocalRef(ft); env->DeleteLocalRef(fld); continue; }
-
-        // Get field name
-        jstring jfn = mFName ? (jstring)env->CallObjectMethod(fld, mFName) : nullptr;
-        if (env->ExceptionCheck() || !jfn) { env->ExceptionClear(); env->DeleteLocalRef(ft); env->DeleteLocalRef(fld); continue; }
-        const char* cfn = env->GetStringUTFChars(jfn, nullptr);
-        std::string fn = cfn ? cfn : "";
-        if (cfn) env->ReleaseStringUTFChars(jfn, cfn);
-        env->DeleteLocalRef(jfn);
+    MemberIndex::Query q(env);
+    const std::vector<MemberIndex::Field>& fields = q.Fields(worldCls);
+    for (size_t i = 0; i < fields.size(); i++) {
+        const MemberIndex::Field& fd = fields[i];
+        if (fd.IsStatic() || !IndexedTypeIsA121(env, *fd.type, collectionClass)) continue;
+        const std::string& fn = *fd.name;
 
         // Resolve jfieldID using declared type descriptor first, then interface descriptors.
-        std::string ftName = GetClassNameFromClass(env, ft);
-        std::string exactSig;
-        if (!ftName.empty()) {
-            exactSig = "L" + ftName + ";";
-            for (char& ch : exactSig) if (ch == '.') ch = '/';
-        }
+        const std::string& exactSig = *fd.sig;
         jfieldID fid = nullptr;
         if (!exactSig.empty()) {
             fid = env->GetFieldID(worldCls, fn.c_str(), exactSig.c_str());
@@ -5084,8 +5556,6 @@ static void DiscoverWorldPlayersListField(JNIEnv* env, jobject worldObj) {
                     g_worldPlayersListField_121 = fid;
                     Log("Discovered world players list field: " + fn + (exactSig.empty() ? "" : (" " + exactSig)));
                     env->DeleteLocalRef(listObj);
-                    env->DeleteLocalRef(ft);
-                    env->DeleteLocalRef(fld);
                     break;
                 }
                 env->DeleteLocalRef(listObj);
@@ -5094,16 +5564,10 @@ static void DiscoverWorldPlayersListField(JNIEnv* env, jobject worldObj) {
             }
         }
 
-        env->DeleteLocalRef(ft);
-        env->DeleteLocalRef(fld);
         if (g_worldPlayersListField_121) break;
     }
 
-    env->DeleteLocalRef(fields);
     if (collectionClass) env->DeleteLocalRef(collectionClass);
-    if (cMod) env->DeleteLocalRef(cMod);
-    if (cField) env->DeleteLocalRef(cField);
-    if (cClass) env->DeleteLocalRef(cClass);
     env->DeleteLocalRef(worldCls);
 }
 
@@ -5194,6 +5658,13 @@ static void EnsureEntityMethods(JNIEnv* env, jobject entObj) {
                 if (env->ExceptionCheck()) { env->ExceptionClear(); g_getArmor_121 = nullptr; }
             }
         }
+        if (!g_getEntityId_121) {
+            const char* names[] = { "getId", "method_5628", nullptr };
+            for (int i = 0; names[i] && !g_getEntityId_121; i++) {
+                g_getEntityId_121 = env->GetMethodID(entCls, names[i], "()I");
+                if (env->ExceptionCheck()) { env->ExceptionClear(); g_getEntityId_121 = nullptr; }
+            }
+        }
         if (!g_entityPosField_121) {
             // Mojmap: pos, Yarn: field_5979
             const char* posNames[] = { "pos", "position", "field_5979", "f_19854_", nullptr };
@@ -5228,7 +5699,7 @@ static void EnsureEntityMethods(JNIEnv* env, jobject entObj) {
                 }
             }
             if (c) { 
-                g_itemStackClass_121 = (jclass)env->NewGlobalRef(c); 
+                g_itemStackClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refPlayers121); 
                 env->DeleteLocalRef(c); 
                 
                 const char* nNames[] = { "getHoverName", "getName", "method_7964", nullptr };
@@ -5324,29 +5795,29 @@ static void LogNametagSuppressionMissingMappings121(JNIEnv* env, jobject worldOb
 
 static void ResetNametagSuppressionCaches121(JNIEnv* env, const char* reason) {
     if (g_lastNametagSuppressionWorld_121 && env) {
-        env->DeleteGlobalRef(g_lastNametagSuppressionWorld_121);
+        RefLedger::Delete(env, g_lastNametagSuppressionWorld_121);
         g_lastNametagSuppressionWorld_121 = nullptr;
     }
 
     if (g_visibilityRuleNever_121 && env) {
-        env->DeleteGlobalRef(g_visibilityRuleNever_121);
+        RefLedger::Delete(env, g_visibilityRuleNever_121);
         g_visibilityRuleNever_121 = nullptr;
     }
 
     if (g_scoreboardClass_121 && env) {
-        env->DeleteGlobalRef(g_scoreboardClass_121);
+        RefLedger::Delete(env, g_scoreboardClass_121);
         g_scoreboardClass_121 = nullptr;
     }
     if (g_teamClass_121 && env) {
-        env->DeleteGlobalRef(g_teamClass_121);
+        RefLedger::Delete(env, g_teamClass_121);
         g_teamClass_121 = nullptr;
     }
     if (g_abstractTeamClass_121 && env) {
-        env->DeleteGlobalRef(g_abstractTeamClass_121);
+        RefLedger::Delete(env, g_abstractTeamClass_121);
         g_abstractTeamClass_121 = nullptr;
     }
     if (g_visibilityRuleClass_121 && env) {
-        env->DeleteGlobalRef(g_visibilityRuleClass_121);
+        RefLedger::Delete(env, g_visibilityRuleClass_121);
         g_visibilityRuleClass_121 = nullptr;
     }
 
@@ -5363,11 +5834,15 @@ static void ResetNametagSuppressionCaches121(JNIEnv* env, const char* reason) {
     g_worldPlayersListField_121 = nullptr;
 
     for (auto& entry : g_modifiedTeamVisibility_121) {
-        if (entry.second && env) env->DeleteGlobalRef(entry.second);
+        if (entry.second && env) RefLedger::Delete(env, entry.second);
     }
     g_modifiedTeamVisibility_121.clear();
     g_lcHideTagsMembers_121.clear();
     g_hiddenNametagOriginalTeamByPlayer_121.clear();
+    g_nextNametagResyncMs_121 = 0;
+    if (g_nametagHelperHandles121 && env) RefLedger::Delete(env, g_nametagHelperHandles121);
+    g_nametagHelperHandles121 = nullptr;
+    g_nametagHelperTried121 = false;
     g_nametagSuppressionActive_121 = false;
     g_loggedNametagSuppressionUnavailable_121 = false;
     g_loggedNametagRestoreUnavailable_121 = false;
@@ -5382,7 +5857,7 @@ static void ResetNametagSuppressionCaches121(JNIEnv* env, const char* reason) {
 static bool TrackSuppressionWorldContext121(JNIEnv* env, jobject worldObj) {
     if (!env || !worldObj) return false;
     if (!g_lastNametagSuppressionWorld_121) {
-        g_lastNametagSuppressionWorld_121 = env->NewGlobalRef(worldObj);
+        g_lastNametagSuppressionWorld_121 = LC_NEW_GLOBAL_REF(env, worldObj, s_refNametagHide121);
         return false;
     }
 
@@ -5393,7 +5868,7 @@ static bool TrackSuppressionWorldContext121(JNIEnv* env, jobject worldObj) {
     }
     if (changed) {
         ResetNametagSuppressionCaches121(env, "world-context-changed");
-        g_lastNametagSuppressionWorld_121 = env->NewGlobalRef(worldObj);
+        g_lastNametagSuppressionWorld_121 = LC_NEW_GLOBAL_REF(env, worldObj, s_refNametagHide121);
     }
     return changed;
 }
@@ -5422,7 +5897,7 @@ static bool EnsureNametagSuppressionTeamMappings121(JNIEnv* env, jobject worldOb
             }
         }
         if (c) {
-            g_scoreboardClass_121 = (jclass)env->NewGlobalRef(c);
+            g_scoreboardClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refNametagHide121);
             env->DeleteLocalRef(c);
         }
     }
@@ -5439,7 +5914,7 @@ static bool EnsureNametagSuppressionTeamMappings121(JNIEnv* env, jobject worldOb
             }
         }
         if (c) {
-            g_teamClass_121 = (jclass)env->NewGlobalRef(c);
+            g_teamClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refNametagHide121);
             env->DeleteLocalRef(c);
         }
     }
@@ -5456,7 +5931,7 @@ static bool EnsureNametagSuppressionTeamMappings121(JNIEnv* env, jobject worldOb
             }
         }
         if (c) {
-            g_abstractTeamClass_121 = (jclass)env->NewGlobalRef(c);
+            g_abstractTeamClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refNametagHide121);
             env->DeleteLocalRef(c);
         }
     }
@@ -5479,7 +5954,7 @@ static bool EnsureNametagSuppressionTeamMappings121(JNIEnv* env, jobject worldOb
             }
         }
         if (c) {
-            g_visibilityRuleClass_121 = (jclass)env->NewGlobalRef(c);
+            g_visibilityRuleClass_121 = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refNametagHide121);
             env->DeleteLocalRef(c);
         }
     }
@@ -5655,7 +6130,7 @@ static bool EnsureNametagSuppressionTeamMappings121(JNIEnv* env, jobject worldOb
             jobject neverObj = env->GetStaticObjectField(g_visibilityRuleClass_121, neverField);
             if (env->ExceptionCheck()) { env->ExceptionClear(); neverObj = nullptr; }
             if (neverObj) {
-                g_visibilityRuleNever_121 = env->NewGlobalRef(neverObj);
+                g_visibilityRuleNever_121 = LC_NEW_GLOBAL_REF(env, neverObj, s_refNametagHide121);
                 env->DeleteLocalRef(neverObj);
             }
         }
@@ -5680,7 +6155,7 @@ static bool EnsureNametagSuppressionTeamMappings121(JNIEnv* env, jobject worldOb
                     if (len > 1) {
                         jobject neverObj = env->GetObjectArrayElement(vals, 1);
                         if (neverObj) {
-                            g_visibilityRuleNever_121 = env->NewGlobalRef(neverObj);
+                            g_visibilityRuleNever_121 = LC_NEW_GLOBAL_REF(env, neverObj, s_refNametagHide121);
                             env->DeleteLocalRef(neverObj);
                         }
                     }
@@ -5740,6 +6215,14 @@ static bool ApplyVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj
         if (env->ExceptionCheck()) { env->ExceptionClear(); currentTeamObj = nullptr; }
     }
 
+    if (currentTeamObj && hideTeamObj && env->IsSameObject(currentTeamObj, hideTeamObj)) {
+        env->DeleteLocalRef(currentTeamObj);
+        env->DeleteLocalRef(jPlayerName);
+        g_lcHideTagsMembers_121.insert(playerName);
+        g_hiddenNametagOriginalTeamByPlayer_121.erase(playerName);
+        return true;
+    }
+
     if (currentTeamObj) {
         // Player is on a server-managed team.  Instead of moving them (which
         // desyncs the client scoreboard and causes protocol kicks), we modify
@@ -5754,8 +6237,8 @@ static bool ApplyVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj
         // Cache the original visibility on first encounter (for restore).
         // If naming/getter methods are unresolved we still suppress below,
         // just can't restore the exact original visibility on toggle-off.
+        std::string teamName;
         if (g_abstractTeamGetName_121 && g_teamGetNameTagVisibilityRule_121) {
-            std::string teamName;
             jstring jTeamName = (jstring)env->CallObjectMethod(currentTeamObj, g_abstractTeamGetName_121);
             if (!env->ExceptionCheck() && jTeamName) {
                 teamName = Utf8FromJString(env, jTeamName);
@@ -5767,7 +6250,7 @@ static bool ApplyVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj
             if (!teamName.empty() && g_modifiedTeamVisibility_121.find(teamName) == g_modifiedTeamVisibility_121.end()) {
                 jobject originalVis = env->CallObjectMethod(currentTeamObj, g_teamGetNameTagVisibilityRule_121);
                 if (!env->ExceptionCheck() && originalVis) {
-                    g_modifiedTeamVisibility_121[teamName] = env->NewGlobalRef(originalVis);
+                    g_modifiedTeamVisibility_121[teamName] = LC_NEW_GLOBAL_REF(env, originalVis, s_refNametagHide121);
                     env->DeleteLocalRef(originalVis);
                 } else {
                     env->ExceptionClear();
@@ -5775,12 +6258,17 @@ static bool ApplyVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj
             }
         }
 
-        // Always apply NEVER (server may have reset it since last frame).
+        // Always apply NEVER (server may have reset it since the last resync).
         env->CallVoidMethod(currentTeamObj, g_teamSetNameTagVisibilityRule_121, g_visibilityRuleNever_121);
-        if (env->ExceptionCheck()) env->ExceptionClear();
+        bool ok = !env->ExceptionCheck();
+        if (!ok) env->ExceptionClear();
 
         env->DeleteLocalRef(currentTeamObj);
-        return true;
+        if (ok) {
+            g_hiddenNametagOriginalTeamByPlayer_121[playerName] = teamName;
+            g_lcHideTagsMembers_121.erase(playerName);
+        }
+        return ok;
     } else {
         // Player is not on any team.  It is safe to add them to a client-only
         // hide team because the server does not track them.
@@ -5795,6 +6283,7 @@ static bool ApplyVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj
 
         if (ok) {
             g_lcHideTagsMembers_121.insert(playerName);
+            g_hiddenNametagOriginalTeamByPlayer_121.erase(playerName);
         }
 
         env->DeleteLocalRef(jPlayerName);
@@ -5802,13 +6291,182 @@ static bool ApplyVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj
     }
 }
 
+// Method[] for AokoHelper.applyNametagHide, built once the scoreboard
+// mappings are in.  False keeps SyncNametagSuppression121 on per-name JNI.
+static bool EnsureNametagHelper121(JNIEnv* env) {
+    if (g_nametagHelperHandles121) return HelperBridge::HasNametagApplier();
+    if (g_nametagHelperTried121 || !g_scoreboardClass_121 || !g_scoreboardGetHolderTeam_121) return false;
+    if (!EnsureHelperBridgeLoaded121(env) || !HelperBridge::HasNametagApplier()) return false;
+    g_nametagHelperTried121 = true;
+
+    const jmethodID ids[HelperBridge::kNametagHandleCount] = {
+        g_scoreboardGetHolderTeam_121, g_scoreboardAddHolderToTeam_121, g_scoreboardClearTeam_121,
+        g_abstractTeamGetName_121, g_teamGetNameTagVisibilityRule_121, g_teamSetNameTagVisibilityRule_121
+    };
+    jclass methodCls = env->FindClass("java/lang/reflect/Method");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); methodCls = nullptr; }
+    jobjectArray arr = methodCls ? env->NewObjectArray(HelperBridge::kNametagHandleCount, methodCls, nullptr) : nullptr;
+    if (env->ExceptionCheck()) { env->ExceptionClear(); arr = nullptr; }
+    bool ok = arr != nullptr;
+    for (int i = 0; ok && i < HelperBridge::kNametagHandleCount; i++) {
+        if (!ids[i]) continue;
+        jobject m = env->ToReflectedMethod(g_scoreboardClass_121, ids[i], JNI_FALSE);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); m = nullptr; }
+        if (!m) { ok = i != HelperBridge::kNtHolderTeam; continue; }
+        env->SetObjectArrayElement(arr, i, m);
+        env->DeleteLocalRef(m);
+    }
+    if (ok) g_nametagHelperHandles121 = (jobjectArray)LC_NEW_GLOBAL_REF(env, arr, s_refNametagHide121);
+    if (arr) env->DeleteLocalRef(arr);
+    if (methodCls) env->DeleteLocalRef(methodCls);
+    Log(std::string("NametagHideVanilla: helper path ") + (g_nametagHelperHandles121 ? "ready." : "unavailable; using per-name JNI."));
+    return g_nametagHelperHandles121 != nullptr;
+}
+
+static jobjectArray NewStringArray121(JNIEnv* env, jclass stringCls, const std::vector<std::string>& names) {
+    jobjectArray arr = env->NewObjectArray((jsize)names.size(), stringCls, nullptr);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return nullptr; }
+    for (size_t i = 0; arr && i < names.size(); i++) {
+        jstring js = env->NewStringUTF(names[i].c_str());
+        if (env->ExceptionCheck()) { env->ExceptionClear(); js = nullptr; }
+        if (!js) continue;
+        env->SetObjectArrayElement(arr, (jsize)i, js);
+        env->DeleteLocalRef(js);
+    }
+    return arr;
+}
+
+// Takes a team-less player back off the hide team, unless the server has
+// since put them on a team of its own.
+static void ReleaseHideTeamMember121(JNIEnv* env, jobject scoreboardObj, jobject hideTeamObj, const std::string& playerName) {
+    if (!g_scoreboardClearTeam_121 || !g_scoreboardGetHolderTeam_121) return;
+    jstring jPlayerName = env->NewStringUTF(playerName.c_str());
+    if (!jPlayerName) { env->ExceptionClear(); return; }
+    jobject teamObj = env->CallObjectMethod(scoreboardObj, g_scoreboardGetHolderTeam_121, jPlayerName);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); teamObj = nullptr; }
+    if (teamObj && env->IsSameObject(teamObj, hideTeamObj)) {
+        env->CallBooleanMethod(scoreboardObj, g_scoreboardClearTeam_121, jPlayerName);
+        if (env->ExceptionCheck()) env->ExceptionClear();
+    }
+    if (teamObj) env->DeleteLocalRef(teamObj);
+    env->DeleteLocalRef(jPlayerName);
+}
+
+// Brings the scoreboard in line with `names`, the players that should have
+// their vanilla nametag hidden this pass.  Only names that joined or left
+// since the last pass cost scoreboard calls (all names on a resync), and with
+// the helper loaded those go out as one applyNametagHide call.
+static void SyncNametagSuppression121(JNIEnv* env, jobject scoreboardObj, jobject hideTeamObj,
+                                      const std::vector<std::string>& names, DWORD now,
+                                      bool& attempted, bool& applied) {
+    static std::unordered_set<std::string> s_wanted;
+    static std::vector<std::string> s_joins, s_leaves;
+    s_wanted.clear();
+    s_joins.clear();
+    s_leaves.clear();
+    g_nametagSyncStats121.passes++;
+
+    const bool resync = g_nextNametagResyncMs_121 == 0 || (LONG)(now - g_nextNametagResyncMs_121) >= 0;
+    if (resync) {
+        g_nextNametagResyncMs_121 = now + kNametagResyncMs;
+        g_nametagSyncStats121.resyncs++;
+    }
+
+    for (size_t i = 0; i < names.size(); i++) {
+        if (!s_wanted.insert(names[i]).second) continue;
+        if (resync || (!g_lcHideTagsMembers_121.count(names[i]) && !g_hiddenNametagOriginalTeamByPlayer_121.count(names[i])))
+            s_joins.push_back(names[i]);
+    }
+    for (const auto& member : g_lcHideTagsMembers_121)
+        if (!s_wanted.count(member)) s_leaves.push_back(member);
+    // Players on a server team only had their team's visibility changed;
+    // the team keeps it until restore, so leaving costs no call.
+    for (auto it = g_hiddenNametagOriginalTeamByPlayer_121.begin(); it != g_hiddenNametagOriginalTeamByPlayer_121.end(); ) {
+        if (s_wanted.count(it->first)) ++it;
+        else it = g_hiddenNametagOriginalTeamByPlayer_121.erase(it);
+    }
+
+    attempted = !s_wanted.empty();
+    if (!s_joins.empty() || !s_leaves.empty()) {
+        g_nametagSyncStats121.joins += (unsigned long)s_joins.size();
+        g_nametagSyncStats121.leaves += (unsigned long)s_leaves.size();
+
+        bool done = false;
+        if (EnsureNametagHelper121(env)) {
+            jclass stringCls = env->FindClass("java/lang/String");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); stringCls = nullptr; }
+            jclass objectCls = env->FindClass("java/lang/Object");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); objectCls = nullptr; }
+            jobjectArray joins = stringCls ? NewStringArray121(env, stringCls, s_joins) : nullptr;
+            jobjectArray leaves = stringCls ? NewStringArray121(env, stringCls, s_leaves) : nullptr;
+            jobjectArray originals = objectCls ? env->NewObjectArray((jsize)s_joins.size(), objectCls, nullptr) : nullptr;
+            if (env->ExceptionCheck()) { env->ExceptionClear(); originals = nullptr; }
+
+            static std::vector<HelperBridge::NametagJoinResult> s_results;
+            if (joins && leaves && originals
+                && HelperBridge::ApplyNametagHide(env, scoreboardObj, hideTeamObj, g_visibilityRuleNever_121,
+                                                  joins, leaves, g_nametagHelperHandles121, originals,
+                                                  s_results) == (int)s_joins.size()) {
+                done = true;
+                g_nametagSyncStats121.helperCalls++;
+                for (size_t i = 0; i < s_leaves.size(); i++) g_lcHideTagsMembers_121.erase(s_leaves[i]);
+                for (size_t i = 0; i < s_joins.size(); i++) {
+                    const std::string& name = s_joins[i];
+                    const HelperBridge::NametagJoinResult& r = s_results[i];
+                    if (r.status == HelperBridge::kNtOnHideTeam) {
+                        g_lcHideTagsMembers_121.insert(name);
+                        g_hiddenNametagOriginalTeamByPlayer_121.erase(name);
+                    } else if (r.status == HelperBridge::kNtOnServerTeam) {
+                        g_hiddenNametagOriginalTeamByPlayer_121[name] = r.team;
+                        g_lcHideTagsMembers_121.erase(name);
+                        // First sighting of this team: keep what it had for restore.
+                        if (!r.team.empty() && g_modifiedTeamVisibility_121.find(r.team) == g_modifiedTeamVisibility_121.end()) {
+                            jobject original = env->GetObjectArrayElement(originals, (jsize)i);
+                            if (env->ExceptionCheck()) { env->ExceptionClear(); original = nullptr; }
+                            if (original) {
+                                g_modifiedTeamVisibility_121[r.team] = LC_NEW_GLOBAL_REF(env, original, s_refNametagHide121);
+                                env->DeleteLocalRef(original);
+                            }
+                        }
+                    } else {
+                        // Dropped so the next pass retries it as a join.
+                        g_lcHideTagsMembers_121.erase(name);
+                        g_hiddenNametagOriginalTeamByPlayer_121.erase(name);
+                    }
+                }
+            }
+            if (originals) env->DeleteLocalRef(originals);
+            if (leaves) env->DeleteLocalRef(leaves);
+            if (joins) env->DeleteLocalRef(joins);
+            if (objectCls) env->DeleteLocalRef(objectCls);
+            if (stringCls) env->DeleteLocalRef(stringCls);
+        }
+
+        if (!done) {
+            for (size_t i = 0; i < s_leaves.size(); i++) {
+                ReleaseHideTeamMember121(env, scoreboardObj, hideTeamObj, s_leaves[i]);
+                g_lcHideTagsMembers_121.erase(s_leaves[i]);
+            }
+            for (size_t i = 0; i < s_joins.size(); i++) {
+                if (ApplyVanillaNametagSuppression121(env, scoreboardObj, hideTeamObj, s_joins[i])) continue;
+                g_lcHideTagsMembers_121.erase(s_joins[i]);
+                g_hiddenNametagOriginalTeamByPlayer_121.erase(s_joins[i]);
+            }
+        }
+    }
+
+    applied = !g_lcHideTagsMembers_121.empty() || !g_hiddenNametagOriginalTeamByPlayer_121.empty();
+}
+
 static void RestoreVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardObj) {
     if (!env || !scoreboardObj) {
         for (auto& entry : g_modifiedTeamVisibility_121) {
-            if (entry.second && env) env->DeleteGlobalRef(entry.second);
+            if (entry.second && env) RefLedger::Delete(env, entry.second);
         }
         g_modifiedTeamVisibility_121.clear();
         g_lcHideTagsMembers_121.clear();
+        g_hiddenNametagOriginalTeamByPlayer_121.clear();
+        g_nextNametagResyncMs_121 = 0;
         return;
     }
 
@@ -5827,12 +6485,12 @@ static void RestoreVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardO
                 }
                 env->DeleteLocalRef(jTeamName);
             }
-            if (it->second) env->DeleteGlobalRef(it->second);
+            if (it->second) RefLedger::Delete(env, it->second);
             it = g_modifiedTeamVisibility_121.erase(it);
         }
     } else {
         for (auto& entry : g_modifiedTeamVisibility_121) {
-            if (entry.second) env->DeleteGlobalRef(entry.second);
+            if (entry.second) RefLedger::Delete(env, entry.second);
         }
         g_modifiedTeamVisibility_121.clear();
     }
@@ -5852,6 +6510,8 @@ static void RestoreVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardO
         Log("NametagHideVanilla: Scoreboard.clearTeam missing; team-less players may remain hidden.");
     }
     g_lcHideTagsMembers_121.clear();
+    g_hiddenNametagOriginalTeamByPlayer_121.clear();
+    g_nextNametagResyncMs_121 = 0;
 
     // 3. Delete the client-only hide team.
     if (g_scoreboardGetTeam_121 && g_scoreboardRemoveTeam_121) {
@@ -5869,6 +6529,21 @@ static void RestoreVanillaNametagSuppression121(JNIEnv* env, jobject scoreboardO
     }
 }
 
+// Closest-player overlay read for ScanEngine: getter positions and the
+// cached display name.  Nothing else is shown, so health/armor stay unknown.
+// The card has always named whoever is nearest, so names are not screened
+// for scoreboard/bot lines here.
+struct ClosestPlayerAdapter121 : ScanEngine::VersionAdapter {
+    bool ReadPlayer(JNIEnv* env, jobject entity, ScanEngine::PlayerSample& out) {
+        out.x = out.lastX = CallDoubleNoArgs(env, entity, g_getX_121);
+        out.y = out.lastY = CallDoubleNoArgs(env, entity, g_getY_121);
+        out.z = out.lastZ = CallDoubleNoArgs(env, entity, g_getZ_121);
+        out.name = GetCachedPlayerName(env, entity);
+        return true;
+    }
+    bool IsFakeName(const std::string&) { return false; }
+};
+
 static void UpdateClosestPlayerOverlay(JNIEnv* env) {
     // Throttle heavy JNI work.
     DWORD now = GetTickCount();
@@ -5914,50 +6589,31 @@ static void UpdateClosestPlayerOverlay(JNIEnv* env) {
         return;
     }
 
-    jclass lCls = env->GetObjectClass(listObj);
-    jmethodID mSize = lCls ? env->GetMethodID(lCls, "size", "()I") : nullptr;
-    jmethodID mGet  = lCls ? env->GetMethodID(lCls, "get", "(I)Ljava/lang/Object;") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mSize = mGet = nullptr; }
-    if (!mSize || !mGet) {
-        if (lCls) env->DeleteLocalRef(lCls);
+    ScanEngine::ListAccess access;
+    if (!GetListAccess121(env, listObj, access)) {
         env->DeleteLocalRef(listObj);
         env->DeleteLocalRef(worldObj);
         env->DeleteLocalRef(selfObj);
         return;
     }
 
-    jint count = env->CallIntMethod(listObj, mSize);
-    if (env->ExceptionCheck()) { env->ExceptionClear(); count = 0; }
-
-    std::string bestName;
-    double bestDist = -1.0;
+    static ClosestPlayerAdapter121 s_adapter;
+    static std::vector<ScanEngine::PlayerSample> s_players;
+    ScanEngine::WalkOptions opts = { sx, sy, sz, 0.0 };
+    ScanEngine::WalkPlayers(env, s_adapter, listObj, access, selfObj, opts, s_players);
+    int best = ScanEngine::Nearest(s_players, 0.0);
 
-    for (int i = 0; i < count; i++) {
-        jobject p = env->CallObjectMethod(listObj, mGet, (jint)i);
-        if (env->ExceptionCheck()) { env->ExceptionClear(); p = nullptr; }
-        if (!p) continue;
-        if (env->IsSameObject(p, selfObj)) { env->DeleteLocalRef(p); continue; }
-
-        double px = CallDoubleNoArgs(env, p, g_getX_121);
-        double py = CallDoubleNoArgs(env, p, g_getY_121);
-        double pz = CallDoubleNoArgs(env, p, g_getZ_121);
-        double dx = px - sx, dy = py - sy, dz = pz - sz;
-        double dist = std::sqrt(dx*dx + dy*dy + dz*dz);
-        if (bestDist < 0 || dist < bestDist) {
-            bestDist = dist;
-            bestName = GetStablePlayerName(env, p);
-        }
-
-        env->DeleteLocalRef(p);
-    }
-
-    if (lCls) env->DeleteLocalRef(lCls);
     env->DeleteLocalRef(listObj);
     env->DeleteLocalRef(worldObj);
     env->DeleteLocalRef(selfObj);
 
-    g_closestName = bestName;
-    g_closestDist = bestDist;
+    if (best >= 0) {
+        g_closestName = s_players[best].name;
+        g_closestDist = s_players[best].dist;
+    } else {
+        g_closestName.clear();
+        g_closestDist = -1.0;
+    }
 }
 
 typedef BOOL (WINAPI* TwglSwapBuffers)(HDC);
@@ -5967,33 +6623,28 @@ static HMODULE g_hModule121 = nullptr;
 static HANDLE  g_mainThreadHandle = nullptr;
 static HANDLE  g_chestThreadHandle = nullptr;
 static HANDLE  g_fastPollThreadHandle = nullptr;
+static HANDLE  g_glPhaseThreadHandle = nullptr;
+static HANDLE  g_remapThreadHandle121 = nullptr;
+
+// Startup readiness (see MainThread).  Manual-reset events, never closed: the
+// ClassPrepare callback and the swap hook may still signal them late.
+static HANDLE        g_mcClassPreparedEvent = nullptr;
+static HANDLE        g_firstSwapEvent = nullptr;
+static DWORD         g_startupTickMs = 0;
+static volatile LONG g_mcClassPreparedTickMs = 0;
+static volatile LONG g_firstSwapTickMs = 0;
+
+// Game-progress signal for state sampling: the swap hook counts GLFW frames and
+// pulses this auto-reset event (created in MainThread, never closed).
+static HANDLE        g_swapFrameEvent121 = nullptr;
+static volatile LONG g_swapFrameSeq121 = 0;
 
 // ===================== LOGGER =====================
 static std::string g_logPath = "bridge_261_debug.log";
 
+// Queued to the async logger; the flusher thread owns the file handle.
 static void Log(const std::string& msg) {
-    std::ofstream out(g_logPath, std::ios_base::app);
-    out << msg << "\n";
-}
-
-static bool FileExistsA(const std::string& path) {
-    std::ifstream f(path, std::ios::binary);
-    return f.good();
-}
-
-static bool IsLikelyFontBinary(const std::string& path) {
-    std::ifstream f(path, std::ios::binary);
-    if (!f.good()) return false;
-    unsigned char hdr[4] = {0};
-    f.read((char*)hdr, 4);
-    if (f.gcount() < 4) return false;
-
-    // TrueType/OpenType headers: 00 01 00 00, "OTTO", "true", "ttcf"
-    if (hdr[0] == 0x00 && hdr[1] == 0x01 && hdr[2] == 0x00 && hdr[3] == 0x00) return true;
-    if (hdr[0] == 'O' && hdr[1] == 'T' && hdr[2] == 'T' && hdr[3] == 'O') return true;
-    if (hdr[0] == 't' && hdr[1] == 'r' && hdr[2] == 'u' && hdr[3] == 'e') return true;
-    if (hdr[0] == 't' && hdr[1] == 't' && hdr[2] == 'c' && hdr[3] == 'f') return true;
-    return false;
+    AsyncLog::Write(AsyncLog::LevelFromText(msg), msg);
 }
 
 static std::string GetBridgeDir() {
@@ -6004,14 +6655,14 @@ static std::string GetBridgeDir() {
 
 static void DeleteGlobalRefSafe(JNIEnv* env, jobject& obj) {
     if (env && obj) {
-        env->DeleteGlobalRef(obj);
+        RefLedger::Delete(env, obj);
         obj = nullptr;
     }
 }
 
 static void DeleteGlobalRefSafe(JNIEnv* env, jclass& cls) {
     if (env && cls) {
-        env->DeleteGlobalRef(cls);
+        RefLedger::Delete(env, cls);
         cls = nullptr;
     }
 }
@@ -6034,10 +6685,23 @@ static void ResetAutoTotemCaches(JNIEnv* env) {
     g_gameModeFieldCached_121 = nullptr;
     g_getCarriedMethod_121 = nullptr;
     g_isEmptyMethod_121 = nullptr;
+    g_itemStackGetCount_121 = nullptr;
+    g_playerContainerMenuField_121 = nullptr;
+    g_menuContainerIdField_121 = nullptr;
+    g_menuStateIdField_121 = nullptr;
+    g_inventoryTimesChangedField_121 = nullptr;
+    g_autoTotemMenuFieldsTried_121 = false;
+    g_autoTotemInvFieldTried_121 = false;
 
     DeleteGlobalRefSafe(env, g_itemsClass_121);
     DeleteGlobalRefSafe(env, g_equipmentSlotClass_121);
     DeleteGlobalRefSafe(env, g_equipmentSlotChest_121);
+    if (env && g_invHelperHandles121) RefLedger::Delete(env, g_invHelperHandles121);
+    if (env && g_invHelperKinds121) RefLedger::Delete(env, g_invHelperKinds121);
+    g_invHelperHandles121 = nullptr;
+    g_invHelperKinds121 = nullptr;
+    g_invHelperTried121 = false;
+    g_invSnapshot121.valid = false;
 
     g_autoTotemMethodsResolved = false;
     g_loggedAutoTotemResolveFail_121 = false;
@@ -6046,11 +6710,23 @@ static void ResetAutoTotemCaches(JNIEnv* env) {
     g_lastAutoTotemTickMs = 0;
     g_autoTotemPrevHealth = 20.0f;
     g_autoTotemPendingSlot = -1;
+
+    ResetPlayerNameCache121(env);
+    ResetPlayerTable121();
+    g_speedBridgeGrid_121.Invalidate();
+}
+
+static void LogMemberIndex121(const char* when, const MemberIndex::Stats& st) {
+    if (!st.builds && !st.hits) return;
+    Log(std::string("Member index (") + when + "): " + std::to_string(st.classes) + " classes, " +
+        std::to_string(st.builds) + " member lists built with " + std::to_string(st.reflected) +
+        " reflection calls, " + std::to_string(st.hits) + " served from the index");
 }
 
 static void CleanupJniGlobals(JNIEnv* env) {
     if (!env) return;
 
+    LogMemberIndex121("cleanup", MemberIndex::Clear(env));
     DeleteGlobalRefSafe(env, g_gameClassLoader);
     DeleteGlobalRefSafe(env, g_mcInstance);
     DeleteGlobalRefSafe(env, g_chatScreenClass);
@@ -6064,6 +6740,8 @@ static void CleanupJniGlobals(JNIEnv* env) {
     DeleteGlobalRefSafe(env, g_hitResultClass_121);
     DeleteGlobalRefSafe(env, g_blockHitResultClass_121);
     for (int i = 0; i < 4; i++) DeleteGlobalRefSafe(env, g_chestBlockEntityClasses[i]);
+    DeleteGlobalRefSafe(env, g_blockStateClass_121);
+    DeleteGlobalRefSafe(env, g_blockClass_121);
     DeleteGlobalRefSafe(env, g_blockEntityClass_121);
     DeleteGlobalRefSafe(env, g_blockPosClass_121);
     DeleteGlobalRefSafe(env, g_javaHashMapClass);
@@ -6086,14 +6764,33 @@ static void CleanupJniGlobals(JNIEnv* env) {
 
     DeleteGlobalRefSafe(env, g_cachedLocalPlayer);
     DeleteGlobalRefSafe(env, g_cachedReachAttrInst);
+    ResetChestHelper121(env);
+    ResetWideHandles121(env);
     HelperBridge::Unload(env);
+    g_helperLoadTried121 = false;
+
+    // Module caches that hold refs of their own.
+    ResetPlayerNameCache121(env);
+    ResetChestChunkCache121(env);
+    ResetNametagSuppressionCaches121(env, nullptr);
+    RefLedger::Delete(env, g_fovValue_121.option);
+    g_fovValue_121 = FovValueCache121();
+    for (size_t i = 0; i < g_hudTextSlots121.size(); i++)
+        if (g_hudTextSlots121[i].obj) RefLedger::Delete(env, g_hudTextSlots121[i].obj);
+    g_hudTextSlots121.clear();
+
+    // Anything still in the ledger has no owner left.  A staged remap set is
+    // owned by the remap task and freed by DiscardCoreMappings121.
+    Log("Global refs at cleanup: " + RefLedger::FormatLive());
+    RefLedger::ReportLeaks(env, "CleanupJniGlobals", true, s_refRemap121);
 }
 
+// Clears the loose per-module handles; the state-poll handles live in the
+// JniRegistry table and are replaced by the next Publish instead.
 static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason) {
     if (!env) return;
 
     CleanupJniGlobals(env);
-    ResetNametagSuppressionCaches121(env, nullptr);
 
     g_setScreenMethod = nullptr;
     g_chatScreenCtor = nullptr;
@@ -6106,6 +6803,7 @@ static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason) {
 
     g_jniScreenName.clear();
     g_jniActionBar.clear();
+    if (++g_jniActionBarRev == 0) g_jniActionBarRev = 1;
     g_jniGuiOpen = false;
     g_jniInWorld = false;
     g_jniLookingAtBlock = false;
@@ -6116,9 +6814,11 @@ static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason) {
     g_jniAttackCooldown = 1.0f;
     g_jniAttackCooldownPerTick = 0.08f;
     g_jniStateMs = 0;
+    g_jniTick = 0;
+    g_jniTickSampleMs = 0;
+    g_tickSample121.valid = false;
+    g_tickCountLookupFailed121 = false;
     g_lastEntitySeenMs = 0;
-    g_loggedCooldownProgressResolve = false;
-    g_loggedCooldownPerTickResolve = false;
     g_loggedCooldownProgressMissing = false;
     g_loggedCooldownPerTickMissing = false;
     g_loggedCooldownPlayerFieldMissing = false;
@@ -6200,6 +6900,9 @@ static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason) {
     g_javaHMNodeValueField = nullptr;
     g_javaHMNodeNextField = nullptr;
     g_javaHMNodeKeyField = nullptr;
+    g_javaHashMapModCountField = nullptr;
+    g_javaHashMapSizeField = nullptr;
+    ResetChestChunkCache121(env);
     g_blockPosGetX_121 = nullptr;
     g_blockPosGetY_121 = nullptr;
     g_blockPosGetZ_121 = nullptr;
@@ -6207,6 +6910,7 @@ static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason) {
     g_stateGetBlock_121 = nullptr;
     g_blockGetTranslationKey_121 = nullptr;
     for (int i = 0; i < 4; i++) g_chestBlockEntityClasses[i] = nullptr;
+    g_chestBlockEntityClassesTried = false;
 
     g_hitResultGetType_121 = nullptr;
     g_crosshairTargetField_121 = nullptr;
@@ -6226,6 +6930,7 @@ static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason) {
     g_shouldRenderName_121 = nullptr;
     g_textGetString_121 = nullptr;
     g_getArmor_121 = nullptr;
+    g_getEntityId_121 = nullptr;
     g_getMainHandStack_121 = nullptr;
     g_itemStackGetName_121 = nullptr;
     g_itemStackGetDamage_121 = nullptr;
@@ -6238,14 +6943,7 @@ static void ResetModernJniRuntimeCaches121(JNIEnv* env, const char* reason) {
     g_lastChestScanMs = 0;
     g_worldTransitionEndMs = GetTickCount() + 1000;
 
-    {
-        LockGuard lk(g_playerListMutex);
-        g_playerList.clear();
-    }
-    {
-        LockGuard lk(g_chestListMutex);
-        g_chestList.clear();
-    }
+    ClearScanLists121();
     {
         LockGuard lk(g_bgCamMutex);
         g_bgCamState = BgCamState();
@@ -6271,6 +6969,10 @@ static void CleanupImGuiAndHooks() {
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplOpenGL3_SetSkipGLDeletes(false);
     }
+    OverlayContext::Destroy();
+    ImGui_ImplOpenGL3_SetSkipStateBackup(false);
+    g_moduleListLayer.Invalidate();
+    g_overlayPacer.Invalidate();
     if (ImGui::GetCurrentContext()) {
         ImGui::DestroyContext();
     }
@@ -6311,12 +7013,16 @@ extern "C" __declspec(dllexport) void Detach() {
         for (int i = 0; i < 30; i++) {
             bool chestDone = !g_chestThreadHandle || WaitForSingleObject(g_chestThreadHandle, 50) == WAIT_OBJECT_0;
             bool pollDone = !g_fastPollThreadHandle || WaitForSingleObject(g_fastPollThreadHandle, 50) == WAIT_OBJECT_0;
-            if (chestDone && pollDone) break;
+            bool glDone = !g_glPhaseThreadHandle || WaitForSingleObject(g_glPhaseThreadHandle, 50) == WAIT_OBJECT_0;
+            bool remapDone = !g_remapThreadHandle121 || WaitForSingleObject(g_remapThreadHandle121, 50) == WAIT_OBJECT_0;
+            if (chestDone && pollDone && glDone && remapDone) break;
             Sleep(25);
         }
 
         if (g_chestThreadHandle) { CloseHandle(g_chestThreadHandle); g_chestThreadHandle = nullptr; }
         if (g_fastPollThreadHandle) { CloseHandle(g_fastPollThreadHandle); g_fastPollThreadHandle = nullptr; }
+        if (g_glPhaseThreadHandle) { CloseHandle(g_glPhaseThreadHandle); g_glPhaseThreadHandle = nullptr; }
+        if (g_remapThreadHandle121) { CloseHandle(g_remapThreadHandle121); g_remapThreadHandle121 = nullptr; }
 
         JNIEnv* env = nullptr;
         bool attached = false;
@@ -6331,7 +7037,9 @@ extern "C" __declspec(dllexport) void Detach() {
         }
 
         CleanupImGuiAndHooks();
+        DiscardPendingRemap121(env);
         CleanupJniGlobals(env);
+        JniRegistry::Shutdown(env);
 
         if (attached && g_jvm) g_jvm->DetachCurrentThread();
 
@@ -6340,6 +7048,13 @@ extern "C" __declspec(dllexport) void Detach() {
             g_mainThreadHandle = nullptr;
         }
 
+#if LC_TRACE_BUILD
+        TraceBuffer::Dump(GetBridgeDir() + "\\bridge_261_trace.bin");
+#endif
+        FrameProfiler::StopCsv();
+        Log("Detach complete (log lines dropped: " + std::to_string(AsyncLog::Dropped()) + ")");
+        AsyncLog::Stop();
+
         HMODULE self = g_hModule121;
         if (!self) self = GetModuleHandleA("bridge_261.dll");
         if (self) {
@@ -6371,46 +7086,19 @@ static std::string GetClassNameFromClass(JNIEnv* env, jclass cls) {
     return r;
 }
 
-static jfieldID FindFieldByType(JNIEnv* env, jclass targetClass, const std::string& typeSig) {
+static jfieldID FindFieldByType(JNIEnv* env, jclass targetClass, const std::string& typeSig, std::string* outName = nullptr) {
     if (!targetClass) return nullptr;
-    jclass cls = env->FindClass("java/lang/Class");
-    jmethodID getFields = env->GetMethodID(cls, "getDeclaredFields", "()[Ljava/lang/reflect/Field;");
-    jclass fldCls = env->FindClass("java/lang/reflect/Field");
-    jmethodID getType = env->GetMethodID(fldCls, "getType", "()Ljava/lang/Class;");
-    jmethodID getName = env->GetMethodID(fldCls, "getName", "()Ljava/lang/String;");
-    
-    jobjectArray fields = (jobjectArray)env->CallObjectMethod(targetClass, getFields);
-    jsize count = fields ? env->GetArrayLength(fields) : 0;
-    jfieldID res = nullptr;
-    
-    for (int i = 0; i < count; i++) {
-        jobject f = env->GetObjectArrayElement(fields, i);
-        if (!f) continue;
-        jclass t = (jclass)env->CallObjectMethod(f, getType);
-        std::string tName = GetClassNameFromClass(env, t);
-        if (t) env->DeleteLocalRef(t);
-        
-        std::string expected = typeSig;
-        if (expected.length() > 2 && expected[0] == 'L' && expected.back() == ';') {
-            expected = expected.substr(1, expected.length() - 2);
-            std::replace(expected.begin(), expected.end(), '/', '.');
-        }
-        if (tName == expected) {
-            jstring jName = (jstring)env->CallObjectMethod(f, getName);
-            const char* n = env->GetStringUTFChars(jName, nullptr);
-            res = env->GetFieldID(targetClass, n, typeSig.c_str());
-            env->ReleaseStringUTFChars(jName, n);
-            env->DeleteLocalRef(jName);
-            env->DeleteLocalRef(f);
-            break;
-        }
-        env->DeleteLocalRef(f);
-    }
-    if (fields) env->DeleteLocalRef(fields);
-    env->DeleteLocalRef(fldCls);
-    env->DeleteLocalRef(cls);
-    if (env->ExceptionCheck()) env->ExceptionClear();
-    return res;
+    MemberIndex::Query q(env);
+    const std::vector<MemberIndex::Field>& fields = q.Fields(targetClass);
+    for (size_t i = 0; i < fields.size(); i++) {
+        const MemberIndex::Field& f = fields[i];
+        if (*f.sig != typeSig) continue;
+        jfieldID res = env->GetFieldID(targetClass, f.name->c_str(), typeSig.c_str());
+        if (env->ExceptionCheck()) { env->ExceptionClear(); res = nullptr; }
+        if (res && outName) *outName = *f.name;
+        return res;
+    }
+    return nullptr;
 }
 
 static jobject GetGameClassLoader(JNIEnv* env) {
@@ -6552,10 +7240,84 @@ static jclass LoadClassWithLoader(JNIEnv* env, jobject cl, const char* name) {
     return cls;
 }
 
+// Everything DiscoverJniMappings resolves, built off to the side so a remap
+// never leaves the hot paths looking at a half-filled set.  Global refs and
+// the registry table are owned by the set until PublishCoreMappings121 adopts
+// them (or DiscardCoreMappings121 frees them).
+struct CoreMappings121 {
+    jobject     gameClassLoader = nullptr;
+    jobject     mcInstance = nullptr;
+    jfieldID    screenField = nullptr;
+    std::string screenType;
+    jmethodID   setScreenMethod = nullptr;
+    jclass      chatScreenClass = nullptr;
+    jmethodID   chatScreenCtor = nullptr;
+    int         chatCtorKind = 0;
+    jfieldID    optionsField = nullptr;
+    jfieldID    fovField = nullptr;
+    jmethodID   simpleOptionGet = nullptr;
+    jclass      renderSystemClass = nullptr;
+    jmethodID   getProjectionMatrix = nullptr;
+    jmethodID   getModelViewMatrix = nullptr;
+    jclass      matrix4fClass = nullptr;
+    jfieldID    matrixM00 = nullptr, matrixM01 = nullptr, matrixM02 = nullptr, matrixM03 = nullptr;
+    jfieldID    matrixM10 = nullptr, matrixM11 = nullptr, matrixM12 = nullptr, matrixM13 = nullptr;
+    jfieldID    matrixM20 = nullptr, matrixM21 = nullptr, matrixM22 = nullptr, matrixM23 = nullptr;
+    jfieldID    matrixM30 = nullptr, matrixM31 = nullptr, matrixM32 = nullptr, matrixM33 = nullptr;
+    jmethodID   matrixGetFloatArray = nullptr;
+    jfieldID    gameRendererField = nullptr;
+    jfieldID    gameRendererCameraField = nullptr;
+    jclass      cameraClass = nullptr;
+    jfieldID    cameraPosF = nullptr;
+    jfieldID    cameraYawF = nullptr;
+    jfieldID    cameraPitchF = nullptr;
+    jclass      vec3dClass = nullptr;
+    jfieldID    vec3dX = nullptr, vec3dY = nullptr, vec3dZ = nullptr;
+    JniRegistry::Table* registry = nullptr;
+    bool        stateReady = false;   // screen field + singleton: UpdateJniState can run
+    bool        chatReady = false;
+};
+
+// Build the state-poll handle table off to the side; it goes live with the
+// rest of its CoreMappings121 in one swap.
+// mcCls is the live Minecraft class; every other class goes through the game loader.
+static JniRegistry::Table* BuildStateRegistry121(JNIEnv* env, jobject gcl, jclass mcCls) {
+    using namespace mc121;
+    JniRegistry::Table* t = JniRegistry::BeginBuild();
+
+    JniRegistry::BindClass(env, *t, REG_CLS_MC_121, CLS_MC, gcl, mcCls);
+    JniRegistry::BindClass(env, *t, REG_CLS_GAME_MODE_121, CLS_GAME_MODE, gcl);
+    JniRegistry::BindClass(env, *t, REG_CLS_PLAYER_121, CLS_PLAYER, gcl);
+    JniRegistry::BindClass(env, *t, REG_CLS_ITEM_STACK_121, CLS_ITEM_STACK, gcl);
+    JniRegistry::BindClass(env, *t, REG_CLS_BLOCK_ITEM_121, CLS_BLOCK_ITEM, gcl);
+    JniRegistry::BindClass(env, *t, REG_CLS_JAVA_CLASS_121, CLS_JAVA_CLASS, gcl);
+
+    bool gameMode    = JniRegistry::BindField(env, *t, REG_FLD_GAME_MODE_121, FIELD_GAME_MODE);
+    bool destroying  = JniRegistry::BindField(env, *t, REG_FLD_IS_DESTROYING_121, FIELD_IS_DESTROYING);
+    bool tickCount   = JniRegistry::BindField(env, *t, REG_FLD_TICK_COUNT_121, FIELD_ENTITY_TICK_COUNT);
+    bool getSuper    = JniRegistry::BindMethod(env, *t, REG_MID_GET_SUPERCLASS_121, METHOD_GET_SUPERCLASS);
+    bool mainHand    = JniRegistry::BindMethod(env, *t, REG_MID_GET_MAIN_HAND_121, METHOD_GET_MAIN_HAND);
+    bool getItem     = JniRegistry::BindMethod(env, *t, REG_MID_STACK_GET_ITEM_121, METHOD_STACK_GET_ITEM);
+    bool cdProgress  = JniRegistry::BindMethod(env, *t, REG_MID_COOLDOWN_PROGRESS_121, METHOD_COOLDOWN_PROGRESS);
+    bool cdPerTick   = JniRegistry::BindMethod(env, *t, REG_MID_COOLDOWN_PER_TICK_121, METHOD_COOLDOWN_PER_TICK);
+    bool blockItem   = t->classes[REG_CLS_BLOCK_ITEM_121] != nullptr;
+
+    Log(std::string("State registry built: gameMode=") + (gameMode ? "ok" : "missing")
+        + " isDestroying=" + (destroying ? "ok" : "missing")
+        + " tickCount=" + (tickCount ? "ok" : "missing")
+        + " getSuperclass=" + (getSuper ? "ok" : "missing")
+        + " mainHand=" + (mainHand ? "ok" : "missing")
+        + " getItem=" + (getItem ? "ok" : "missing")
+        + " blockItem=" + (blockItem ? "ok" : "missing")
+        + " cooldownProgress=" + (cdProgress ? "ok" : "missing")
+        + " cooldownPerTick=" + (cdPerTick ? "ok" : "missing"));
+    return t;
+}
+
 // ===================== JNI DISCOVERY (ported from 1.8.9, adapted for 1.21) =====================
 // Uses JVMTI to scan loaded classes, finds Minecraft by singleton pattern,
 // discovers screen field by method hierarchy walking, finds ChatScreen + setScreen.
-static bool DiscoverJniMappings(JNIEnv* env) {
+static bool DiscoverJniMappings(JNIEnv* env, CoreMappings121& m) {
     TRACE261_PATH("enter");
     Log("Starting JNI discovery for 26.1...");
 
@@ -6575,32 +7337,15 @@ static bool DiscoverJniMappings(JNIEnv* env) {
     if (!gcl) { Log("ERROR: No game classloader found"); jvmti->Deallocate((unsigned char*)classes); return false; }
     Log("Game classloader found.");
 
-    // Store classloader globally for later lazy class loads.
-    if (!g_gameClassLoader) {
-        g_gameClassLoader = env->NewGlobalRef(gcl);
-        Log("Stored game classloader global ref.");
-    }
-
-    // Reflection setup
-    jclass cClass = env->FindClass("java/lang/Class");
-    jmethodID mGetName    = env->GetMethodID(cClass, "getName", "()Ljava/lang/String;");
-    jmethodID mGetFields  = env->GetMethodID(cClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;");
-    jmethodID mGetMethods = env->GetMethodID(cClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;");
-    jmethodID mGetSuper   = env->GetMethodID(cClass, "getSuperclass", "()Ljava/lang/Class;");
-
-    jclass cField = env->FindClass("java/lang/reflect/Field");
-    jmethodID mFType = env->GetMethodID(cField, "getType", "()Ljava/lang/Class;");
-    jmethodID mFName = env->GetMethodID(cField, "getName", "()Ljava/lang/String;");
-    jmethodID mFMod  = env->GetMethodID(cField, "getModifiers", "()I");
+    // Kept for later lazy class loads once the set is adopted.
+    m.gameClassLoader = LC_NEW_GLOBAL_REF(env, gcl, s_refRemap121);
 
-    jclass cMethod = env->FindClass("java/lang/reflect/Method");
-    jmethodID mMName   = env->GetMethodID(cMethod, "getName", "()Ljava/lang/String;");
-    jmethodID mMRet    = env->GetMethodID(cMethod, "getReturnType", "()Ljava/lang/Class;");
-    jmethodID mMParams = env->GetMethodID(cMethod, "getParameterTypes", "()[Ljava/lang/Class;");
-    jmethodID mMMod    = env->GetMethodID(cMethod, "getModifiers", "()I");
-
-    jclass cMod = env->FindClass("java/lang/reflect/Modifier");
-    jmethodID mIsStatic = env->GetStaticMethodID(cMod, "isStatic", "(I)Z");
+    // Member lists reflected by the resolvers below are shared through the
+    // member index for the length of the pass, then dropped.
+    struct MemberIndexRelease {
+        JNIEnv* env;
+        ~MemberIndexRelease() { LogMemberIndex121("discovery", MemberIndex::Clear(env)); }
+    } memberIndexRelease = { env };
 
     // ---- Step 1: Find Minecraft class by known name or singleton scan ----
     jclass mcClass = nullptr;
@@ -6621,28 +7366,25 @@ static bool DiscoverJniMappings(JNIEnv* env) {
 
     if (!mcClass) { Log("ERROR: Minecraft class not found"); jvmti->Deallocate((unsigned char*)classes); return false; }
 
+    // Names found by the reflection scans below are cached per game build; a hit
+    // costs one GetFieldID instead of a declared-fields walk.
+    int cachedEntries = MappingCache::Open(GetBridgeDir() + "\\bridge_261_mappings.cache",
+                                           MappingCache::BuildKey(env, "261", mcClass, mcName));
+    Log("Mapping cache: " + std::to_string(cachedEntries) + " entries");
+
     // ---- Step 2: Find MC singleton instance ----
-    jobjectArray mcFields = (jobjectArray)env->CallObjectMethod(mcClass, mGetFields);
-    jsize mcFC = env->GetArrayLength(mcFields);
-    jfieldID singletonField = nullptr;
-
-    for (int f = 0; f < mcFC; f++) {
-        jobject fld = env->GetObjectArrayElement(mcFields, f);
-        if (!fld) continue;
-        jint mod = env->CallIntMethod(fld, mFMod);
-        bool isS = env->CallStaticBooleanMethod(cMod, mIsStatic, mod);
-        jclass ft = (jclass)env->CallObjectMethod(fld, mFType);
-        if (!ft || env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-        std::string tn = GetClassNameFromClass(env, ft);
-        jstring jfn = (jstring)env->CallObjectMethod(fld, mFName);
-        const char* cfn = env->GetStringUTFChars(jfn, nullptr);
-        std::string fn = cfn ? cfn : "";
-        if (cfn) env->ReleaseStringUTFChars(jfn, cfn);
-        if (isS && tn == mcName) {
-            std::string sig = "L" + mcName + ";"; std::replace(sig.begin(), sig.end(), '.', '/');
-            singletonField = env->GetStaticFieldID(mcClass, fn.c_str(), sig.c_str());
+    jfieldID singletonField = MappingCache::GetField(env, mcClass, "mc.singleton", true);
+    if (!singletonField) {
+        MemberIndex::Query q(env);
+        const std::string mcSig = MemberIndex::Descriptor(mcName);
+        const std::vector<MemberIndex::Field>& mcFields = q.Fields(mcClass);
+        for (size_t f = 0; f < mcFields.size(); f++) {
+            const MemberIndex::Field& fd = mcFields[f];
+            if (!fd.IsStatic() || *fd.sig != mcSig) continue;
+            singletonField = env->GetStaticFieldID(mcClass, fd.name->c_str(), mcSig.c_str());
             if (env->ExceptionCheck()) env->ExceptionClear();
-            Log("Singleton field: " + fn);
+            if (singletonField) MappingCache::PutMember("mc.singleton", *fd.name, mcSig);
+            Log("Singleton field: " + *fd.name);
         }
     }
     TRACE261_BRANCH("singletonFieldResolved", singletonField != nullptr);
@@ -6659,19 +7401,19 @@ static bool DiscoverJniMappings(JNIEnv* env) {
     // In 26.x some clients use Mojmap/official names, others use intermediary.
     std::string screenType;
     auto tryScreenField = [&](const char* fieldName, const char* fieldSig) -> bool {
-        if (!fieldName || !fieldSig || g_screenField) return false;
+        if (!fieldName || !fieldSig || m.screenField) return false;
         jfieldID fid = env->GetFieldID(mcClass, fieldName, fieldSig);
         if (env->ExceptionCheck()) { env->ExceptionClear(); fid = nullptr; }
         if (!fid) return false;
 
-        g_screenField = fid;
+        m.screenField = fid;
         std::string tn = fieldSig;
         if (tn.size() > 2 && tn[0] == 'L' && tn.back() == ';') {
             tn = tn.substr(1, tn.size() - 2);
             std::replace(tn.begin(), tn.end(), '/', '.');
         }
         screenType = tn;
-        g_screenType = tn;
+        m.screenType = tn;
         Log("Screen field (direct): " + std::string(fieldName) + " type=" + tn);
         return true;
     };
@@ -6689,14 +7431,14 @@ static bool DiscoverJniMappings(JNIEnv* env) {
         "Lnet/minecraft/client/gui/GuiScreen;",
         nullptr
     };
-    for (int ni = 0; directScreenNames[ni] && !g_screenField; ni++) {
-        for (int si = 0; directScreenSigs[si] && !g_screenField; si++) {
+    for (int ni = 0; directScreenNames[ni] && !m.screenField; ni++) {
+        for (int si = 0; directScreenSigs[si] && !m.screenField; si++) {
             bool hit = tryScreenField(directScreenNames[ni], directScreenSigs[si]);
             TRACE261_BRANCH("screenDirectLookupHit", hit);
         }
     }
 
-    if (g_screenField && !screenType.empty()) {
+    if (m.screenField && !screenType.empty()) {
         TRACE261_VALUE("screenType", screenType);
     }
 
@@ -6708,15 +7450,15 @@ static bool DiscoverJniMappings(JNIEnv* env) {
         std::string fullSig = "(" + screenSig + ")V";
 
         // Prefer known method names first (Yarn commonly: method_1507).
-        g_setScreenMethod = env->GetMethodID(mcClass, "setScreen", fullSig.c_str());
-        if (env->ExceptionCheck()) { env->ExceptionClear(); g_setScreenMethod = nullptr; }
-        TRACE261_BRANCH("setScreenPreferredSetScreenHit", g_setScreenMethod != nullptr);
-        if (!g_setScreenMethod) {
-            g_setScreenMethod = env->GetMethodID(mcClass, "method_1507", fullSig.c_str());
-            if (env->ExceptionCheck()) { env->ExceptionClear(); g_setScreenMethod = nullptr; }
-            TRACE261_BRANCH("setScreenPreferredMethod1507Hit", g_setScreenMethod != nullptr);
-        }
-        if (g_setScreenMethod) {
+        m.setScreenMethod = env->GetMethodID(mcClass, "setScreen", fullSig.c_str());
+        if (env->ExceptionCheck()) { env->ExceptionClear(); m.setScreenMethod = nullptr; }
+        TRACE261_BRANCH("setScreenPreferredSetScreenHit", m.setScreenMethod != nullptr);
+        if (!m.setScreenMethod) {
+            m.setScreenMethod = env->GetMethodID(mcClass, "method_1507", fullSig.c_str());
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m.setScreenMethod = nullptr; }
+            TRACE261_BRANCH("setScreenPreferredMethod1507Hit", m.setScreenMethod != nullptr);
+        }
+        if (m.setScreenMethod) {
             Log(std::string("setScreen method (preferred): sig=") + fullSig);
         }
 
@@ -6801,13 +7543,13 @@ static bool DiscoverJniMappings(JNIEnv* env) {
                     jmethodID ctor = env->GetMethodID(c, "<init>", sig.c_str());
                     if (env->ExceptionCheck()) { env->ExceptionClear(); ctor = nullptr; }
                     if (ctor) {
-                        if (g_chatScreenClass) {
-                            env->DeleteGlobalRef(g_chatScreenClass);
-                            g_chatScreenClass = nullptr;
+                        if (m.chatScreenClass) {
+                            RefLedger::Delete(env, m.chatScreenClass);
+                            m.chatScreenClass = nullptr;
                         }
-                        g_chatScreenClass = (jclass)env->NewGlobalRef(c);
-                        g_chatScreenCtor  = ctor;
-                        g_chatCtorKind    = kind;
+                        m.chatScreenClass = (jclass)LC_NEW_GLOBAL_REF(env, c, s_refRemap121);
+                        m.chatScreenCtor  = ctor;
+                        m.chatCtorKind    = kind;
                         TRACE261_VALUE("chatScreenSource", knownChat[i]);
                         Log("Found ChatScreen by name: " + std::string(knownChat[i]) + " ctorSig=" + sig);
                         break;
@@ -6819,34 +7561,34 @@ static bool DiscoverJniMappings(JNIEnv* env) {
 
     // ---- Step 6: Find options field and FOV ----
     const char* optionsNames[] = { "options", "field_1690", nullptr };
-    for (int i = 0; optionsNames[i] && !g_optionsField_121; i++) {
+    for (int i = 0; optionsNames[i] && !m.optionsField; i++) {
         const char* optionsSigs[] = { "Lnet/minecraft/client/Options;", "Lnet/minecraft/class_315;", nullptr };
-        for (int si = 0; optionsSigs[si] && !g_optionsField_121; si++) {
-            g_optionsField_121 = env->GetFieldID(mcClass, optionsNames[i], optionsSigs[si]);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); g_optionsField_121 = nullptr; }
+        for (int si = 0; optionsSigs[si] && !m.optionsField; si++) {
+            m.optionsField = env->GetFieldID(mcClass, optionsNames[i], optionsSigs[si]);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m.optionsField = nullptr; }
         }
-        if (g_optionsField_121) Log("Found options field: " + std::string(optionsNames[i]));
+        if (m.optionsField) Log("Found options field: " + std::string(optionsNames[i]));
     }
 
-    if (g_optionsField_121) {
-        jobject optsObj = env->GetObjectField(mcInst, g_optionsField_121);
+    if (m.optionsField) {
+        jobject optsObj = env->GetObjectField(mcInst, m.optionsField);
         if (optsObj && !env->ExceptionCheck()) {
             jclass optsCls = env->GetObjectClass(optsObj);
             const char* fovNames[] = { "fov", "field_1903", nullptr };
-            for (int i = 0; fovNames[i] && !g_fovField_121; i++) {
+            for (int i = 0; fovNames[i] && !m.fovField; i++) {
                 const char* fovSigs[] = { "Lnet/minecraft/client/OptionInstance;", "Lnet/minecraft/class_7172;", nullptr };
-                for (int si = 0; fovSigs[si] && !g_fovField_121; si++) {
-                    g_fovField_121 = env->GetFieldID(optsCls, fovNames[i], fovSigs[si]);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); g_fovField_121 = nullptr; }
+                for (int si = 0; fovSigs[si] && !m.fovField; si++) {
+                    m.fovField = env->GetFieldID(optsCls, fovNames[i], fovSigs[si]);
+                    if (env->ExceptionCheck()) { env->ExceptionClear(); m.fovField = nullptr; }
                 }
-                if (g_fovField_121) {
+                if (m.fovField) {
                     Log("Found fov field: " + std::string(fovNames[i]));
                     // Resolve OptionInstance.get() / SimpleOption.getValue()
                     jclass optInstCls = LoadClassWithLoader(env, gcl, "net.minecraft.client.OptionInstance");
                     if (!optInstCls) optInstCls = LoadClassWithLoader(env, gcl, "net.minecraft.class_7172");
                     if (optInstCls) {
-                        g_simpleOptionGet_121 = env->GetMethodID(optInstCls, "get", "()Ljava/lang/Object;");
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); g_simpleOptionGet_121 = env->GetMethodID(optInstCls, "method_41753", "()Ljava/lang/Object;"); if (env->ExceptionCheck()) env->ExceptionClear(); }
+                        m.simpleOptionGet = env->GetMethodID(optInstCls, "get", "()Ljava/lang/Object;");
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); m.simpleOptionGet = env->GetMethodID(optInstCls, "method_41753", "()Ljava/lang/Object;"); if (env->ExceptionCheck()) env->ExceptionClear(); }
                         env->DeleteLocalRef(optInstCls);
                     }
                 }
@@ -6856,34 +7598,36 @@ static bool DiscoverJniMappings(JNIEnv* env) {
         } else if (env->ExceptionCheck()) env->ExceptionClear();
     }
 
-    // ---- Step 7: Store globals ----
-    if (g_mcInstance) {
-        env->DeleteGlobalRef(g_mcInstance);
-        g_mcInstance = nullptr;
+    // ---- Step 7: Keep what the set needs beyond this call ----
+    m.mcInstance = LC_NEW_GLOBAL_REF(env, mcInst, s_refRemap121);
+    {
+        jclass mcCls = env->GetObjectClass(mcInst);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); mcCls = nullptr; }
+        m.registry = BuildStateRegistry121(env, gcl, mcCls);
+        if (mcCls) env->DeleteLocalRef(mcCls);
     }
-    g_mcInstance = env->NewGlobalRef(mcInst);
-    g_stateJniReady = (g_screenField != nullptr);
-    g_chatJniReady  = (g_setScreenMethod != nullptr && g_chatScreenClass != nullptr && g_chatScreenCtor != nullptr);
-    TRACE261_BRANCH("stateJniReady", g_stateJniReady);
-    TRACE261_BRANCH("chatJniReady", g_chatJniReady);
+    m.stateReady = (m.screenField != nullptr);
+    m.chatReady  = (m.setScreenMethod != nullptr && m.chatScreenClass != nullptr && m.chatScreenCtor != nullptr);
+    TRACE261_BRANCH("stateJniReady", m.stateReady);
+    TRACE261_BRANCH("chatJniReady", m.chatReady);
 
 
-    if (!g_renderSystemClass_121) {
+    if (!m.renderSystemClass) {
         Log("Attempting to load RenderSystem class...");
         jclass rsCls = LoadClassWithLoader(env, gcl, "com.mojang.blaze3d.systems.RenderSystem");
         if (rsCls) {
             Log("Loaded RenderSystem class");
-            g_renderSystemClass_121 = (jclass)env->NewGlobalRef(rsCls);
+            m.renderSystemClass = (jclass)LC_NEW_GLOBAL_REF(env, rsCls, s_refRemap121);
             
             Log("Trying getProjectionMatrix() -> Matrix4f");
-            g_getProjectionMatrix_121 = env->GetStaticMethodID(rsCls, "getProjectionMatrix", "()Lorg/joml/Matrix4f;");
-            if (g_getProjectionMatrix_121) {
+            m.getProjectionMatrix = env->GetStaticMethodID(rsCls, "getProjectionMatrix", "()Lorg/joml/Matrix4f;");
+            if (m.getProjectionMatrix) {
                 Log("Found getProjectionMatrix with JOML Matrix4f signature");
             } else {
                 env->ExceptionClear();
                 Log("Trying getProjectionMatrix() -> Minecraft Matrix4f");
-                g_getProjectionMatrix_121 = env->GetStaticMethodID(rsCls, "getProjectionMatrix", "()Lnet/minecraft/class_10366;");
-                if (g_getProjectionMatrix_121) {
+                m.getProjectionMatrix = env->GetStaticMethodID(rsCls, "getProjectionMatrix", "()Lnet/minecraft/class_10366;");
+                if (m.getProjectionMatrix) {
                     Log("Found getProjectionMatrix with Minecraft Matrix4f signature");
                 } else {
                     env->ExceptionClear();
@@ -6901,8 +7645,8 @@ static bool DiscoverJniMappings(JNIEnv* env) {
             }
             
             Log("Trying getModelViewMatrix() -> Matrix4f");
-            g_getModelViewMatrix_121 = env->GetStaticMethodID(rsCls, "getModelViewMatrix", "()Lorg/joml/Matrix4f;");
-            if (g_getModelViewMatrix_121) {
+            m.getModelViewMatrix = env->GetStaticMethodID(rsCls, "getModelViewMatrix", "()Lorg/joml/Matrix4f;");
+            if (m.getModelViewMatrix) {
                 Log("Found getModelViewMatrix");
             } else {
                 env->ExceptionClear();
@@ -6915,17 +7659,17 @@ static bool DiscoverJniMappings(JNIEnv* env) {
         }
     }
 
-    if (!g_matrix4fClass_121) {
+    if (!m.matrix4fClass) {
         jclass m4Cls = LoadClassWithLoader(env, gcl, "org.joml.Matrix4f");
         if (m4Cls) {
-            g_matrix4fClass_121 = (jclass)env->NewGlobalRef(m4Cls);
-            g_matrixM00 = env->GetFieldID(m4Cls, "m00", "F"); g_matrixM01 = env->GetFieldID(m4Cls, "m01", "F"); g_matrixM02 = env->GetFieldID(m4Cls, "m02", "F"); g_matrixM03 = env->GetFieldID(m4Cls, "m03", "F");
-            g_matrixM10 = env->GetFieldID(m4Cls, "m10", "F"); g_matrixM11 = env->GetFieldID(m4Cls, "m11", "F"); g_matrixM12 = env->GetFieldID(m4Cls, "m12", "F"); g_matrixM13 = env->GetFieldID(m4Cls, "m13", "F");
-            g_matrixM20 = env->GetFieldID(m4Cls, "m20", "F"); g_matrixM21 = env->GetFieldID(m4Cls, "m21", "F"); g_matrixM22 = env->GetFieldID(m4Cls, "m22", "F"); g_matrixM23 = env->GetFieldID(m4Cls, "m23", "F");
-            g_matrixM30 = env->GetFieldID(m4Cls, "m30", "F"); g_matrixM31 = env->GetFieldID(m4Cls, "m31", "F"); g_matrixM32 = env->GetFieldID(m4Cls, "m32", "F"); g_matrixM33 = env->GetFieldID(m4Cls, "m33", "F");
-            if (!g_matrixGetFloatArray_121) {
-                g_matrixGetFloatArray_121 = env->GetMethodID(m4Cls, "get", "([F)[F");
-                if (env->ExceptionCheck()) { env->ExceptionClear(); g_matrixGetFloatArray_121 = nullptr; }
+            m.matrix4fClass = (jclass)LC_NEW_GLOBAL_REF(env, m4Cls, s_refRemap121);
+            m.matrixM00 = env->GetFieldID(m4Cls, "m00", "F"); m.matrixM01 = env->GetFieldID(m4Cls, "m01", "F"); m.matrixM02 = env->GetFieldID(m4Cls, "m02", "F"); m.matrixM03 = env->GetFieldID(m4Cls, "m03", "F");
+            m.matrixM10 = env->GetFieldID(m4Cls, "m10", "F"); m.matrixM11 = env->GetFieldID(m4Cls, "m11", "F"); m.matrixM12 = env->GetFieldID(m4Cls, "m12", "F"); m.matrixM13 = env->GetFieldID(m4Cls, "m13", "F");
+            m.matrixM20 = env->GetFieldID(m4Cls, "m20", "F"); m.matrixM21 = env->GetFieldID(m4Cls, "m21", "F"); m.matrixM22 = env->GetFieldID(m4Cls, "m22", "F"); m.matrixM23 = env->GetFieldID(m4Cls, "m23", "F");
+            m.matrixM30 = env->GetFieldID(m4Cls, "m30", "F"); m.matrixM31 = env->GetFieldID(m4Cls, "m31", "F"); m.matrixM32 = env->GetFieldID(m4Cls, "m32", "F"); m.matrixM33 = env->GetFieldID(m4Cls, "m33", "F");
+            if (!m.matrixGetFloatArray) {
+                m.matrixGetFloatArray = env->GetMethodID(m4Cls, "get", "([F)[F");
+                if (env->ExceptionCheck()) { env->ExceptionClear(); m.matrixGetFloatArray = nullptr; }
             }
             if (env->ExceptionCheck()) env->ExceptionClear();
             env->DeleteLocalRef(m4Cls);
@@ -6935,7 +7679,8 @@ static bool DiscoverJniMappings(JNIEnv* env) {
     }
 
     // Resolve GameRenderer to get Camera without invoking crashing reflection scans.
-    if (!g_gameRendererField_121) {
+    if (!m.gameRendererField) m.gameRendererField = MappingCache::GetField(env, mcClass, "mc.gameRenderer");
+    if (!m.gameRendererField) {
         TRACE261_PATH("resolve-gamerenderer-field");
         const char* gameRendererSigs[] = {
             "Lnet/minecraft/class_757;",
@@ -6943,19 +7688,21 @@ static bool DiscoverJniMappings(JNIEnv* env) {
             "Lnet/minecraft/client/renderer/GameRenderer;",
             nullptr
         };
-        for (int i = 0; gameRendererSigs[i] && !g_gameRendererField_121; i++) {
+        for (int i = 0; gameRendererSigs[i] && !m.gameRendererField; i++) {
             Log(std::string("Trying GameRenderer sig: ") + gameRendererSigs[i]);
-            g_gameRendererField_121 = FindFieldByType(env, mcClass, gameRendererSigs[i]);
-            if (g_gameRendererField_121) {
+            std::string grFieldName;
+            m.gameRendererField = FindFieldByType(env, mcClass, gameRendererSigs[i], &grFieldName);
+            if (m.gameRendererField) {
+                MappingCache::PutMember("mc.gameRenderer", grFieldName, gameRendererSigs[i]);
                 TRACE261_VALUE("gameRendererFieldSource", gameRendererSigs[i]);
                 Log("Found GameRenderer field with sig: " + std::string(gameRendererSigs[i]));
             }
         }
-        if (!g_gameRendererField_121) {
+        if (!m.gameRendererField) {
             Log("WARNING: GameRenderer field not found with any known signature");
         }
     }
-    if (g_gameRendererField_121) {
+    if (m.gameRendererField) {
         jclass grCls = nullptr;
         const char* gameRendererNames[] = {
             "net.minecraft.class_757",
@@ -6981,12 +7728,12 @@ static bool DiscoverJniMappings(JNIEnv* env) {
                 "Lcom/mojang/blaze3d/platform/Camera;",
                 nullptr
             };
-            for (int ni = 0; cameraFieldNames[ni] && !g_gameRendererCameraField_121; ni++) {
-                for (int si = 0; cameraFieldSigs[si] && !g_gameRendererCameraField_121; si++) {
+            for (int ni = 0; cameraFieldNames[ni] && !m.gameRendererCameraField; ni++) {
+                for (int si = 0; cameraFieldSigs[si] && !m.gameRendererCameraField; si++) {
                     Log(std::string("Trying camera field: ") + cameraFieldNames[ni] + " sig: " + cameraFieldSigs[si]);
-                    g_gameRendererCameraField_121 = env->GetFieldID(grCls, cameraFieldNames[ni], cameraFieldSigs[si]);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); g_gameRendererCameraField_121 = nullptr; }
-                    else if (g_gameRendererCameraField_121) {
+                    m.gameRendererCameraField = env->GetFieldID(grCls, cameraFieldNames[ni], cameraFieldSigs[si]);
+                    if (env->ExceptionCheck()) { env->ExceptionClear(); m.gameRendererCameraField = nullptr; }
+                    else if (m.gameRendererCameraField) {
                         TRACE261_VALUE("cameraFieldSource", std::string(cameraFieldNames[ni]) + "|" + cameraFieldSigs[si]);
                         Log(std::string("Found camera field: ") + cameraFieldNames[ni] + " with sig: " + cameraFieldSigs[si]);
                         break;
@@ -6994,62 +7741,35 @@ static bool DiscoverJniMappings(JNIEnv* env) {
                 }
             }
             
+            if (!m.gameRendererCameraField) m.gameRendererCameraField = MappingCache::GetField(env, grCls, "gameRenderer.camera");
+
             // Reflection scan fallback: find first field with "Camera" in its type
-            if (!g_gameRendererCameraField_121) {
+            if (!m.gameRendererCameraField) {
                 TRACE261_PATH("camera-field-reflection-fallback");
                 Log("Scanning GameRenderer fields via reflection...");
-                jclass cClass = env->FindClass("java/lang/Class");
-                jclass cField = env->FindClass("java/lang/reflect/Field");
-                jmethodID mGetFields = cClass ? env->GetMethodID(cClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;") : nullptr;
-                jmethodID mFType = cField ? env->GetMethodID(cField, "getType", "()Ljava/lang/Class;") : nullptr;
-                jmethodID mFName = cField ? env->GetMethodID(cField, "getName", "()Ljava/lang/String;") : nullptr;
-                if (env->ExceptionCheck()) env->ExceptionClear();
-                
-                if (mGetFields && mFType && mFName) {
-                    jobjectArray fields = (jobjectArray)env->CallObjectMethod(grCls, mGetFields);
-                    if (fields && !env->ExceptionCheck()) {
-                        jsize fc = env->GetArrayLength(fields);
-                        for (int i = 0; i < fc && !g_gameRendererCameraField_121; i++) {
-                            jobject fld = env->GetObjectArrayElement(fields, i);
-                            if (!fld) continue;
-                            
-                            jclass ftype = (jclass)env->CallObjectMethod(fld, mFType);
-                            jstring fname = (jstring)env->CallObjectMethod(fld, mFName);
-                            if (env->ExceptionCheck()) { env->ExceptionClear(); continue; }
-                            
-                            std::string ftypeName = ftype ? GetClassNameFromClass(env, ftype) : "";
-                            const char* fnameC = fname ? env->GetStringUTFChars(fname, nullptr) : nullptr;
-                            std::string fnameStr = fnameC ? fnameC : "";
-                            if (fnameC) env->ReleaseStringUTFChars(fname, fnameC);
-                            
-                            if (ftypeName.find("Camera") != std::string::npos || ftypeName.find("camera") != std::string::npos) {
-                                Log("Found Camera-like field via reflection: " + fnameStr + " type=" + ftypeName);
-                                // Try to get the field ID using the discovered name
-                                std::string sig = "L" + ftypeName + ";";
-                                std::replace(sig.begin(), sig.end(), '.', '/');
-                                g_gameRendererCameraField_121 = env->GetFieldID(grCls, fnameStr.c_str(), sig.c_str());
-                                if (env->ExceptionCheck()) { 
-                                    env->ExceptionClear(); 
-                                    g_gameRendererCameraField_121 = nullptr; 
-                                } else if (g_gameRendererCameraField_121) {
-                                    TRACE261_VALUE("cameraFieldSource", std::string("reflection|") + fnameStr + "|" + sig);
-                                    Log("Successfully got field ID for camera field");
-                                    break;
-                                }
-                            }
-                            
-                            if (ftype) env->DeleteLocalRef(ftype);
-                            if (fname) env->DeleteLocalRef(fname);
-                            env->DeleteLocalRef(fld);
-                        }
-                        env->DeleteLocalRef(fields);
-                    } else if (env->ExceptionCheck()) env->ExceptionClear();
+                MemberIndex::Query q(env);
+                const std::vector<MemberIndex::Field>& fields = q.Fields(grCls);
+                for (size_t i = 0; i < fields.size() && !m.gameRendererCameraField; i++) {
+                    const std::string& ftypeName = *fields[i].type;
+                    const std::string& fnameStr = *fields[i].name;
+                    if (ftypeName.find("Camera") == std::string::npos && ftypeName.find("camera") == std::string::npos) continue;
+
+                    Log("Found Camera-like field via reflection: " + fnameStr + " type=" + ftypeName);
+                    // Try to get the field ID using the discovered name
+                    const std::string& sig = *fields[i].sig;
+                    m.gameRendererCameraField = env->GetFieldID(grCls, fnameStr.c_str(), sig.c_str());
+                    if (env->ExceptionCheck()) {
+                        env->ExceptionClear();
+                        m.gameRendererCameraField = nullptr;
+                    } else if (m.gameRendererCameraField) {
+                        TRACE261_VALUE("cameraFieldSource", std::string("reflection|") + fnameStr + "|" + sig);
+                        MappingCache::PutMember("gameRenderer.camera", fnameStr, sig);
+                        Log("Successfully got field ID for camera field");
+                    }
                 }
-                if (cClass) env->DeleteLocalRef(cClass);
-                if (cField) env->DeleteLocalRef(cField);
             }
             
-            if (!g_gameRendererCameraField_121) {
+            if (!m.gameRendererCameraField) {
                 Log("WARNING: Camera field not found in GameRenderer even after reflection scan");
             }
             env->DeleteLocalRef(grCls);
@@ -7060,12 +7780,12 @@ static bool DiscoverJniMappings(JNIEnv* env) {
 
     // Get Camera class by actually getting the camera instance from GameRenderer
     jclass camCls = nullptr;
-    if (!camCls && g_gameRendererCameraField_121 && g_gameRendererField_121) {
+    if (!camCls && m.gameRendererCameraField && m.gameRendererField) {
         TRACE261_PATH("camera-class-runtime-path");
         Log("Getting Camera class from runtime instance...");
-        jobject grObj = env->GetObjectField(g_mcInstance, g_gameRendererField_121);
+        jobject grObj = env->GetObjectField(m.mcInstance, m.gameRendererField);
         if (grObj && !env->ExceptionCheck()) {
-            jobject camObj = env->GetObjectField(grObj, g_gameRendererCameraField_121);
+            jobject camObj = env->GetObjectField(grObj, m.gameRendererCameraField);
             if (camObj && !env->ExceptionCheck()) {
                 camCls = env->GetObjectClass(camObj);
                 if (camCls) {
@@ -7083,7 +7803,7 @@ static bool DiscoverJniMappings(JNIEnv* env) {
     }
     
     if (camCls) {
-        g_cameraClass_121 = (jclass)env->NewGlobalRef(camCls);
+        m.cameraClass = (jclass)LC_NEW_GLOBAL_REF(env, camCls, s_refRemap121);
         
         // Try direct field lookups first
         const char* cameraPosNames[] = { "field_18712", "pos", "position", "f_90570_", nullptr };
@@ -7094,12 +7814,12 @@ static bool DiscoverJniMappings(JNIEnv* env) {
             "Lorg/joml/Vector3f;",
             nullptr
         };
-        for (int ni = 0; cameraPosNames[ni] && !g_cameraPosF_121; ni++) {
-            for (int si = 0; cameraPosSigs[si] && !g_cameraPosF_121; si++) {
+        for (int ni = 0; cameraPosNames[ni] && !m.cameraPosF; ni++) {
+            for (int si = 0; cameraPosSigs[si] && !m.cameraPosF; si++) {
                 Log(std::string("Trying camera pos field: ") + cameraPosNames[ni] + " sig: " + cameraPosSigs[si]);
-                g_cameraPosF_121 = env->GetFieldID(camCls, cameraPosNames[ni], cameraPosSigs[si]);
-                if (env->ExceptionCheck()) { env->ExceptionClear(); g_cameraPosF_121 = nullptr; }
-                else if (g_cameraPosF_121) {
+                m.cameraPosF = env->GetFieldID(camCls, cameraPosNames[ni], cameraPosSigs[si]);
+                if (env->ExceptionCheck()) { env->ExceptionClear(); m.cameraPosF = nullptr; }
+                else if (m.cameraPosF) {
                     TRACE261_VALUE("cameraPosFieldSource", std::string(cameraPosNames[ni]) + "|" + cameraPosSigs[si]);
                     Log(std::string("Found camera pos field: ") + cameraPosNames[ni] + " with sig: " + cameraPosSigs[si]);
                     break;
@@ -7108,22 +7828,22 @@ static bool DiscoverJniMappings(JNIEnv* env) {
         }
         
         const char* yawNames[] = { "field_18715", "yaw", "yRot", "f_90571_", "yRotation", nullptr };
-        for (int i = 0; yawNames[i] && !g_cameraYawF_121; i++) {
+        for (int i = 0; yawNames[i] && !m.cameraYawF; i++) {
             Log(std::string("Trying camera yaw field: ") + yawNames[i]);
-            g_cameraYawF_121 = env->GetFieldID(camCls, yawNames[i], "F");
-            if (env->ExceptionCheck()) { env->ExceptionClear(); g_cameraYawF_121 = nullptr; }
-            else if (g_cameraYawF_121) {
+            m.cameraYawF = env->GetFieldID(camCls, yawNames[i], "F");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m.cameraYawF = nullptr; }
+            else if (m.cameraYawF) {
                 Log(std::string("Found camera yaw field: ") + yawNames[i]);
                 break;
             }
         }
 
         const char* pitchNames[] = { "field_18714", "pitch", "xRot", "f_90572_", "xRotation", nullptr };
-        for (int i = 0; pitchNames[i] && !g_cameraPitchF_121; i++) {
+        for (int i = 0; pitchNames[i] && !m.cameraPitchF; i++) {
             Log(std::string("Trying camera pitch field: ") + pitchNames[i]);
-            g_cameraPitchF_121 = env->GetFieldID(camCls, pitchNames[i], "F");
-            if (env->ExceptionCheck()) { env->ExceptionClear(); g_cameraPitchF_121 = nullptr; }
-            else if (g_cameraPitchF_121) {
+            m.cameraPitchF = env->GetFieldID(camCls, pitchNames[i], "F");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m.cameraPitchF = nullptr; }
+            else if (m.cameraPitchF) {
                 Log(std::string("Found camera pitch field: ") + pitchNames[i]);
                 break;
             }
@@ -7136,13 +7856,13 @@ static bool DiscoverJniMappings(JNIEnv* env) {
 
     // Get Vec3d class from camera position field if we found it
     jclass vecCls = nullptr;
-    if (g_cameraPosF_121 && g_cameraClass_121 && g_gameRendererField_121 && g_gameRendererCameraField_121) {
+    if (m.cameraPosF && m.cameraClass && m.gameRendererField && m.gameRendererCameraField) {
         Log("Getting Vec3d class from camera position runtime instance...");
-        jobject grObj = env->GetObjectField(g_mcInstance, g_gameRendererField_121);
+        jobject grObj = env->GetObjectField(m.mcInstance, m.gameRendererField);
         if (grObj && !env->ExceptionCheck()) {
-            jobject camObj = env->GetObjectField(grObj, g_gameRendererCameraField_121);
+            jobject camObj = env->GetObjectField(grObj, m.gameRendererCameraField);
             if (camObj && !env->ExceptionCheck()) {
-                jobject posObj = env->GetObjectField(camObj, g_cameraPosF_121);
+                jobject posObj = env->GetObjectField(camObj, m.cameraPosF);
                 if (posObj && !env->ExceptionCheck()) {
                     vecCls = env->GetObjectClass(posObj);
                     if (vecCls) {
@@ -7164,35 +7884,35 @@ static bool DiscoverJniMappings(JNIEnv* env) {
     }
     
     if (vecCls) {
-        g_vec3dClass_121 = (jclass)env->NewGlobalRef(vecCls);
+        m.vec3dClass = (jclass)LC_NEW_GLOBAL_REF(env, vecCls, s_refRemap121);
         const char* vecXNames[] = { "field_1352", "x", "f_82479_", "xCoord", nullptr };
         const char* vecYNames[] = { "field_1351", "y", "f_82480_", "yCoord", nullptr };
         const char* vecZNames[] = { "field_1350", "field_1353", "z", "f_82481_", "zCoord", nullptr };
         
         // Try both double and float types
-        for (int i = 0; vecXNames[i] && !g_vec3dX_121; i++) {
+        for (int i = 0; vecXNames[i] && !m.vec3dX; i++) {
             Log(std::string("Trying Vec3d x field: ") + vecXNames[i]);
-            g_vec3dX_121 = env->GetFieldID(vecCls, vecXNames[i], "D");
-            if (env->ExceptionCheck()) { env->ExceptionClear(); g_vec3dX_121 = nullptr; }
-            else if (g_vec3dX_121) {
+            m.vec3dX = env->GetFieldID(vecCls, vecXNames[i], "D");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m.vec3dX = nullptr; }
+            else if (m.vec3dX) {
                 Log(std::string("Found Vec3d x field (double): ") + vecXNames[i]);
                 break;
             }
         }
-        for (int i = 0; vecYNames[i] && !g_vec3dY_121; i++) {
+        for (int i = 0; vecYNames[i] && !m.vec3dY; i++) {
             Log(std::string("Trying Vec3d y field: ") + vecYNames[i]);
-            g_vec3dY_121 = env->GetFieldID(vecCls, vecYNames[i], "D");
-            if (env->ExceptionCheck()) { env->ExceptionClear(); g_vec3dY_121 = nullptr; }
-            else if (g_vec3dY_121) {
+            m.vec3dY = env->GetFieldID(vecCls, vecYNames[i], "D");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m.vec3dY = nullptr; }
+            else if (m.vec3dY) {
                 Log(std::string("Found Vec3d y field (double): ") + vecYNames[i]);
                 break;
             }
         }
-        for (int i = 0; vecZNames[i] && !g_vec3dZ_121; i++) {
+        for (int i = 0; vecZNames[i] && !m.vec3dZ; i++) {
             Log(std::string("Trying Vec3d z field: ") + vecZNames[i]);
-            g_vec3dZ_121 = env->GetFieldID(vecCls, vecZNames[i], "D");
-            if (env->ExceptionCheck()) { env->ExceptionClear(); g_vec3dZ_121 = nullptr; }
-            else if (g_vec3dZ_121) {
+            m.vec3dZ = env->GetFieldID(vecCls, vecZNames[i], "D");
+            if (env->ExceptionCheck()) { env->ExceptionClear(); m.vec3dZ = nullptr; }
+            else if (m.vec3dZ) {
                 Log(std::string("Found Vec3d z field (double): ") + vecZNames[i]);
                 break;
             }
@@ -7204,29 +7924,289 @@ static bool DiscoverJniMappings(JNIEnv* env) {
 
 
     // Resolution diagnostics
-    Log(std::string("Mapped GameRenderer=") + (g_gameRendererField_121 ? "1" : "0") + 
-        ", cameraField=" + (g_gameRendererCameraField_121 ? "1" : "0"));
-    Log(std::string("Mapped camPos=") + (g_cameraPosF_121 ? "1" : "0") +
-        ", camYaw=" + (g_cameraYawF_121 ? "1" : "0") +
-        ", camPitch=" + (g_cameraPitchF_121 ? "1" : "0"));
-    Log(std::string("Mapped vec3dX=") + (g_vec3dX_121 ? "1" : "0") +
-        ", vec3dY=" + (g_vec3dY_121 ? "1" : "0") +
-        ", vec3dZ=" + (g_vec3dZ_121 ? "1" : "0"));
-    Log(std::string("Mapped RenderSystem=") + (g_renderSystemClass_121 ? "1" : "0") +
-        ", getProj=" + (g_getProjectionMatrix_121 ? "1" : "0") +
-        ", getModelView=" + (g_getModelViewMatrix_121 ? "1" : "0"));
-    Log(std::string("Mapped Matrix4f=") + (g_matrix4fClass_121 ? "1" : "0") +
-        ", getFloatArray=" + (g_matrixGetFloatArray_121 ? "1" : "0") +
-        ", m00=" + (g_matrixM00 ? "1" : "0") + " m11=" + (g_matrixM11 ? "1" : "0") +
-        " m22=" + (g_matrixM22 ? "1" : "0") + " m33=" + (g_matrixM33 ? "1" : "0"));
-
-    Log("Discovery complete: stateJniReady=" + std::string(g_stateJniReady ? "true" : "false")
-        + " chatJniReady=" + std::string(g_chatJniReady ? "true" : "false"));
+    Log(std::string("Mapped GameRenderer=") + (m.gameRendererField ? "1" : "0") + 
+        ", cameraField=" + (m.gameRendererCameraField ? "1" : "0"));
+    Log(std::string("Mapped camPos=") + (m.cameraPosF ? "1" : "0") +
+        ", camYaw=" + (m.cameraYawF ? "1" : "0") +
+        ", camPitch=" + (m.cameraPitchF ? "1" : "0"));
+    Log(std::string("Mapped vec3dX=") + (m.vec3dX ? "1" : "0") +
+        ", vec3dY=" + (m.vec3dY ? "1" : "0") +
+        ", vec3dZ=" + (m.vec3dZ ? "1" : "0"));
+    Log(std::string("Mapped RenderSystem=") + (m.renderSystemClass ? "1" : "0") +
+        ", getProj=" + (m.getProjectionMatrix ? "1" : "0") +
+        ", getModelView=" + (m.getModelViewMatrix ? "1" : "0"));
+    Log(std::string("Mapped Matrix4f=") + (m.matrix4fClass ? "1" : "0") +
+        ", getFloatArray=" + (m.matrixGetFloatArray ? "1" : "0") +
+        ", m00=" + (m.matrixM00 ? "1" : "0") + " m11=" + (m.matrixM11 ? "1" : "0") +
+        " m22=" + (m.matrixM22 ? "1" : "0") + " m33=" + (m.matrixM33 ? "1" : "0"));
+
+    Log("Discovery complete: stateJniReady=" + std::string(m.stateReady ? "true" : "false")
+        + " chatJniReady=" + std::string(m.chatReady ? "true" : "false"));
+    Log("Mapping cache: " + std::to_string(MappingCache::Hits()) + " hits, "
+        + std::to_string(MappingCache::Misses()) + " misses");
+    if (!MappingCache::Save()) Log("WARNING: Could not write mapping cache");
 
     jvmti->Deallocate((unsigned char*)classes);
     return true;
 }
 
+template <typename T>
+static void AdoptId121(T& live, T staged, bool replaceAll) {
+    if (replaceAll || staged) live = staged;
+}
+
+template <typename T>
+static void AdoptRef121(JNIEnv* env, T& live, T& staged) {
+    if (!staged) return;
+    DeleteGlobalRefSafe(env, live);
+    live = staged;
+    staged = nullptr;
+    RefLedger::Retag(live, s_refCore121);
+}
+
+// Makes a staged set current.  replaceAll (a forced remap, after
+// ResetModernJniRuntimeCaches121) takes the set as it is; otherwise (startup,
+// auto-retry) it only fills in what it found, keeping live handles it lacks.
+// Caller holds g_jniRemapMtx and runs where the module tasks cannot be
+// mid-call: the scan thread, or startup before it polls.
+static void PublishCoreMappings121(JNIEnv* env, CoreMappings121& m, bool replaceAll) {
+    if (g_gameClassLoader) DeleteGlobalRefSafe(env, m.gameClassLoader);
+    else AdoptRef121(env, g_gameClassLoader, m.gameClassLoader);
+    AdoptRef121(env, g_mcInstance, m.mcInstance);
+    AdoptId121(g_screenField, m.screenField, replaceAll);
+    if (replaceAll || !m.screenType.empty()) g_screenType = m.screenType;
+    AdoptId121(g_setScreenMethod, m.setScreenMethod, replaceAll);
+    if (m.chatScreenClass) {
+        AdoptRef121(env, g_chatScreenClass, m.chatScreenClass);
+        g_chatScreenCtor = m.chatScreenCtor;
+        g_chatCtorKind = m.chatCtorKind;
+    }
+    AdoptId121(g_optionsField_121, m.optionsField, replaceAll);
+    AdoptId121(g_fovField_121, m.fovField, replaceAll);
+    AdoptId121(g_simpleOptionGet_121, m.simpleOptionGet, replaceAll);
+    AdoptRef121(env, g_renderSystemClass_121, m.renderSystemClass);
+    AdoptId121(g_getProjectionMatrix_121, m.getProjectionMatrix, replaceAll);
+    AdoptId121(g_getModelViewMatrix_121, m.getModelViewMatrix, replaceAll);
+    if (m.matrix4fClass) {
+        AdoptRef121(env, g_matrix4fClass_121, m.matrix4fClass);
+        g_matrixM00 = m.matrixM00; g_matrixM01 = m.matrixM01; g_matrixM02 = m.matrixM02; g_matrixM03 = m.matrixM03;
+        g_matrixM10 = m.matrixM10; g_matrixM11 = m.matrixM11; g_matrixM12 = m.matrixM12; g_matrixM13 = m.matrixM13;
+        g_matrixM20 = m.matrixM20; g_matrixM21 = m.matrixM21; g_matrixM22 = m.matrixM22; g_matrixM23 = m.matrixM23;
+        g_matrixM30 = m.matrixM30; g_matrixM31 = m.matrixM31; g_matrixM32 = m.matrixM32; g_matrixM33 = m.matrixM33;
+    }
+    AdoptId121(g_matrixGetFloatArray_121, m.matrixGetFloatArray, replaceAll);
+    AdoptId121(g_gameRendererField_121, m.gameRendererField, replaceAll);
+    AdoptId121(g_gameRendererCameraField_121, m.gameRendererCameraField, replaceAll);
+    AdoptRef121(env, g_cameraClass_121, m.cameraClass);
+    AdoptId121(g_cameraPosF_121, m.cameraPosF, replaceAll);
+    AdoptId121(g_cameraYawF_121, m.cameraYawF, replaceAll);
+    AdoptId121(g_cameraPitchF_121, m.cameraPitchF, replaceAll);
+    AdoptRef121(env, g_vec3dClass_121, m.vec3dClass);
+    AdoptId121(g_vec3dX_121, m.vec3dX, replaceAll);
+    AdoptId121(g_vec3dY_121, m.vec3dY, replaceAll);
+    AdoptId121(g_vec3dZ_121, m.vec3dZ, replaceAll);
+    if (m.registry) {
+        unsigned long gen = JniRegistry::Publish(env, m.registry);
+        m.registry = nullptr;
+        Log("State registry gen " + std::to_string(gen) + " published.");
+    }
+    g_stateJniReady = (g_screenField != nullptr && g_mcInstance != nullptr);
+    g_chatJniReady  = (g_setScreenMethod != nullptr && g_chatScreenClass != nullptr && g_chatScreenCtor != nullptr);
+}
+
+// Frees whatever a staged set still owns (a rejected remap, or what
+// PublishCoreMappings121 did not adopt).
+static void DiscardCoreMappings121(JNIEnv* env, CoreMappings121& m) {
+    DeleteGlobalRefSafe(env, m.gameClassLoader);
+    DeleteGlobalRefSafe(env, m.mcInstance);
+    DeleteGlobalRefSafe(env, m.chatScreenClass);
+    DeleteGlobalRefSafe(env, m.renderSystemClass);
+    DeleteGlobalRefSafe(env, m.matrix4fClass);
+    DeleteGlobalRefSafe(env, m.cameraClass);
+    DeleteGlobalRefSafe(env, m.vec3dClass);
+    if (m.registry) { JniRegistry::Discard(env, m.registry); m.registry = nullptr; }
+}
+
+// ===================== LAZY MODULE MAPPINGS =====================
+// DiscoverJniMappings resolves only the core set every module shares.  A
+// module's own lookups resolve on the scan thread's "resolve" task the first
+// time its config flag is on, one group per run, and the module's task stays
+// idle until its group is ready.  Every change is sent to the loader as
+// {"type":"moduleState","module":"reach","state":"resolving"}; a forced remap
+// clears the caches and sends the groups it had touched back to "idle".
+enum ResolveGroup121 {
+    RES_REACH = 0, RES_VELOCITY, RES_AUTO_TOTEM, RES_CHEST_ESP, RES_NAMETAGS, RES_CLOSEST_PLAYER,
+    kResolveGroupCount121
+};
+enum ResolveState121 { kResolveIdle121 = 0, kResolveResolving121, kResolveReady121, kResolveFailed121 };
+static const char* const kResolveModule121[kResolveGroupCount121] = {
+    "reach", "velocity", "autototem", "chestesp", "nametags", "closestplayer"
+};
+static const char* const kResolveStateName121[] = { "idle", "resolving", "ready", "failed" };
+// Written by the scan thread only; the socket thread reads it to replay the
+// states to a loader that connects later.
+static volatile LONG g_resolveState121[kResolveGroupCount121] = {};
+
+static std::string ModuleStateLine121(int group, LONG state) {
+    char buf[96];
+    snprintf(buf, sizeof(buf), "{\"type\":\"moduleState\",\"module\":\"%s\",\"state\":\"%s\"}\n",
+             kResolveModule121[group], kResolveStateName121[state]);
+    return buf;
+}
+
+static void SetResolveState121(int group, LONG state) {
+    if (InterlockedExchange(&g_resolveState121[group], state) == state) return;
+    { LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(ModuleStateLine121(group, state)); }
+    SignalStateReady();
+}
+
+static bool ResolveReady121(int group) {
+    return g_resolveState121[group] == kResolveReady121;
+}
+
+static void ResetResolveStates121() {
+    for (int g = 0; g < kResolveGroupCount121; g++) SetResolveState121(g, kResolveIdle121);
+}
+
+static bool ResolveWanted121(const Config& cfg, int group) {
+    switch (group) {
+    case RES_REACH:          return cfg.reachEnabled;
+    case RES_VELOCITY:       return cfg.velocityEnabled;
+    case RES_AUTO_TOTEM:     return cfg.autoTotemEnabled;
+    case RES_CHEST_ESP:      return cfg.chestEsp;
+    case RES_NAMETAGS:       return cfg.nametags;
+    case RES_CLOSEST_PLAYER: return cfg.closestPlayer;
+    }
+    return false;
+}
+
+// One attempt at a group's lookups.  The Ensure* helpers remember a miss
+// until the next remap, so Failed is final until then.  Resolving means a
+// prerequisite (the local player) is not there yet: try again next run.
+static LONG ResolveGroup121(JNIEnv* env, int group) {
+    switch (group) {
+    case RES_REACH:
+        EnsureReachJni(env);
+        return g_reachMethodsResolved ? kResolveReady121 : kResolveFailed121;
+    case RES_VELOCITY: {
+        EnsureClosestPlayerCaches(env);
+        if (!g_playerField_121) return kResolveFailed121;
+        jobject selfObj = env->GetObjectField(g_mcInstance, g_playerField_121);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); selfObj = nullptr; }
+        if (!selfObj) return kResolveResolving121;
+        EnsureVelocityJni(env, selfObj);
+        env->DeleteLocalRef(selfObj);
+        return g_velocityMethodsResolved ? kResolveReady121 : kResolveFailed121;
+    }
+    case RES_AUTO_TOTEM:
+        EnsureAutoTotemJni(env);
+        return g_autoTotemMethodsResolved ? kResolveReady121 : kResolveFailed121;
+    case RES_CHEST_ESP: {
+        EnsureBlockEntityClass(env);
+        EnsureChestBlockEntityClasses(env);
+        bool any = g_blockEntityClass_121 != nullptr;
+        for (int i = 0; i < 4; i++) any = any || g_chestBlockEntityClasses[i] != nullptr;
+        return any ? kResolveReady121 : kResolveFailed121;
+    }
+    case RES_NAMETAGS:
+    case RES_CLOSEST_PLAYER:
+        EnsureClosestPlayerCaches(env);
+        return (g_playerField_121 && g_worldField_121) ? kResolveReady121 : kResolveFailed121;
+    }
+    return kResolveFailed121;
+}
+
+// ===================== BACKGROUND REMAP =====================
+// A remap (the loader's reload pulse, or the 5 s retry while the state core is
+// missing) runs DiscoverJniMappings on its own attached thread into a staged
+// CoreMappings121.  The scan thread's remap task adopts the result between two
+// task runs, holding g_jniRemapMtx only for the swap, so the 200 Hz state poll
+// and the module tasks keep running on the last good set meanwhile.  A forced
+// remap that cannot resolve the state core is dropped and the old set kept.
+enum RemapState121 { kRemapIdle121 = 0, kRemapRunning121, kRemapDone121 };
+static volatile LONG    g_remapState121 = kRemapIdle121;
+static bool             g_remapForced121 = false;      // written before Running
+static CoreMappings121* g_remapResult121 = nullptr;    // written by the worker before Done
+static Mutex            g_jniDiscoverMtx;              // one DiscoverJniMappings at a time
+
+static DWORD WINAPI RemapThreadProc121(LPVOID) {
+    ThreadPolicy::Apply(ThreadPolicy::ROLE_BACKGROUND, "remap");
+    JNIEnv* env = nullptr;
+    CoreMappings121* result = nullptr;
+    if (g_jvm && g_jvm->AttachCurrentThread((void**)&env, nullptr) == JNI_OK) {
+        const int attempts = g_remapForced121 ? 8 : 1;
+        for (int attempt = 0; attempt < attempts && g_running && !result; ++attempt) {
+            if (attempt) Sleep(500);
+            CoreMappings121* m = new CoreMappings121();
+            bool ok;
+            {
+                LockGuard discoverGuard(g_jniDiscoverMtx);
+                ok = DiscoverJniMappings(env, *m);
+            }
+            if (ok && (m->stateReady || !g_remapForced121)) {
+                result = m;
+            } else {
+                DiscardCoreMappings121(env, *m);
+                delete m;
+            }
+        }
+        g_jvm->DetachCurrentThread();
+    }
+    g_remapResult121 = result;
+    InterlockedExchange(&g_remapState121, kRemapDone121);
+    return 0;
+}
+
+// Scan thread.  False while a remap is still running.
+static bool StartRemap121(bool forced) {
+    if (g_remapState121 != kRemapIdle121) return false;
+    if (g_remapThreadHandle121) { CloseHandle(g_remapThreadHandle121); g_remapThreadHandle121 = nullptr; }
+    g_remapForced121 = forced;
+    InterlockedExchange(&g_remapState121, kRemapRunning121);
+    g_remapThreadHandle121 = CreateThread(nullptr, 0, RemapThreadProc121, nullptr, 0, nullptr);
+    if (!g_remapThreadHandle121) {
+        InterlockedExchange(&g_remapState121, kRemapIdle121);
+        Log("Remap thread could not be started, err=" + std::to_string(GetLastError()));
+        return false;
+    }
+    return true;
+}
+
+// Scan thread: adopts a finished remap, if there is one.
+static void CollectRemap121(JNIEnv* env) {
+    if (g_remapState121 != kRemapDone121) return;
+    CoreMappings121* m = g_remapResult121;
+    g_remapResult121 = nullptr;
+    const bool forced = g_remapForced121;
+    if (m) {
+        LockGuard remapGuard(g_jniRemapMtx);
+        if (forced) {
+            TRACE261_PATH("manual-remap-cycle");
+            ReleaseSpeedBridgeSneak121(env);
+            ResetSpeedBridgeMovementTracking121();
+            ResetModernJniRuntimeCaches121(env, "manual-reload-request");
+            ResetResolveStates121();
+        }
+        PublishCoreMappings121(env, *m, forced);
+        DiscardCoreMappings121(env, *m);
+        delete m;
+    }
+    if (forced) {
+        Log(std::string("ReloadMappings: full JNI remap ")
+            + (m ? "completed." : "still unresolved; keeping the previous mappings, auto-retry will continue."));
+    }
+    InterlockedExchange(&g_remapState121, kRemapIdle121);
+}
+
+// Detach, after the scan and remap threads stopped: a result nobody collected.
+static void DiscardPendingRemap121(JNIEnv* env) {
+    CoreMappings121* m = g_remapResult121;
+    g_remapResult121 = nullptr;
+    if (!m) return;
+    if (env) DiscardCoreMappings121(env, *m);
+    delete m;
+}
+
 // ===================== CHAT SCREEN HELPERS (cursor) =====================
 // Like 1.8.9: open a real MC screen so MC releases mouse natively.
 // Falls back to direct GLFW call if JNI not ready.
@@ -7425,62 +8405,100 @@ static void EnsureHudTextFields(JNIEnv* env, jclass mcCls, jobject hudObj) {
     };
 
     TRACE261_PATH("hudtext-reflection-fallback");
-    jclass cClass = env->FindClass("java/lang/Class");
-    jclass cField = env->FindClass("java/lang/reflect/Field");
-    jclass cMod = env->FindClass("java/lang/reflect/Modifier");
-    if (env->ExceptionCheck()) { env->ExceptionClear(); cClass = nullptr; cField = nullptr; cMod = nullptr; }
-    if (cClass && cField && cMod) {
-        jmethodID mGetFields = env->GetMethodID(cClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;");
-        jmethodID mFName = env->GetMethodID(cField, "getName", "()Ljava/lang/String;");
-        jmethodID mFType = env->GetMethodID(cField, "getType", "()Ljava/lang/Class;");
-        jmethodID mFMod  = env->GetMethodID(cField, "getModifiers", "()I");
-        jmethodID mIsStatic = env->GetStaticMethodID(cMod, "isStatic", "(I)Z");
-        if (env->ExceptionCheck()) { env->ExceptionClear(); mGetFields = nullptr; }
-
-        if (mGetFields && mFName && mFType && mFMod && mIsStatic) {
-            jobjectArray fields = (jobjectArray)env->CallObjectMethod(hudCls, mGetFields);
-            if (env->ExceptionCheck()) { env->ExceptionClear(); fields = nullptr; }
-            if (fields) {
-                jsize count = env->GetArrayLength(fields);
-                for (jsize i = 0; i < count; i++) {
-                    jobject fld = env->GetObjectArrayElement(fields, i);
-                    if (!fld) continue;
-
-                    jint mod = env->CallIntMethod(fld, mFMod);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); env->DeleteLocalRef(fld); continue; }
-                    if (env->CallStaticBooleanMethod(cMod, mIsStatic, mod) == JNI_TRUE) {
-                        env->DeleteLocalRef(fld);
-                        continue;
-                    }
-
-                    jclass ft = (jclass)env->CallObjectMethod(fld, mFType);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); ft = nullptr; }
-                    std::string typeName = ft ? GetClassNameFromClass(env, ft) : "";
-                    if (ft) env->DeleteLocalRef(ft);
-                    if (typeName != "net.minecraft.class_2561" && typeName != "net.minecraft.network.chat.Component" && typeName != "net.minecraft.text.Text") { env->DeleteLocalRef(fld); continue; }
-
-                    jstring jfn = (jstring)env->CallObjectMethod(fld, mFName);
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); jfn = nullptr; }
-                    if (!jfn) { env->DeleteLocalRef(fld); continue; }
-                    const char* cfn = env->GetStringUTFChars(jfn, nullptr);
-                    std::string fn = cfn ? cfn : "";
-                    if (cfn) env->ReleaseStringUTFChars(jfn, cfn);
-                    env->DeleteLocalRef(jfn);
-
-                    if (!fn.empty()) addHudTextField(fn.c_str());
-                    env->DeleteLocalRef(fld);
-                }
-                env->DeleteLocalRef(fields);
-            }
+    {
+        MemberIndex::Query q(env);
+        const std::vector<MemberIndex::Field>& fields = q.Fields(hudCls);
+        for (size_t i = 0; i < fields.size(); i++) {
+            const MemberIndex::Field& fd = fields[i];
+            if (fd.IsStatic()) continue;
+            const std::string& typeName = *fd.type;
+            if (typeName != "net.minecraft.class_2561" && typeName != "net.minecraft.network.chat.Component" && typeName != "net.minecraft.text.Text") continue;
+            if (!fd.name->empty()) addHudTextField(fd.name->c_str());
         }
     }
-    if (cClass) env->DeleteLocalRef(cClass);
-    if (cField) env->DeleteLocalRef(cField);
-    if (cMod) env->DeleteLocalRef(cMod);
 
     env->DeleteLocalRef(hudCls);
 }
 
+// The longest HUD text with a '_' in it (the GTB hint), read through
+// g_hudTextSlots121: a slot still holding the same Component keeps its text.
+static std::string ReadActionBar121(JNIEnv* env, jobject hudObj) {
+    g_hudTextSlots121.resize(g_hudTextFields_121.size());
+    const std::string* best = nullptr;
+    for (size_t i = 0; i < g_hudTextFields_121.size(); i++) {
+        HudTextSlot121& slot = g_hudTextSlots121[i];
+        jobject txtObj = env->GetObjectField(hudObj, g_hudTextFields_121[i]);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); txtObj = nullptr; }
+        bool same = txtObj ? (slot.obj && env->IsSameObject(txtObj, slot.obj)) : !slot.obj;
+        if (!same) {
+            if (slot.obj) RefLedger::Delete(env, slot.obj);
+            slot.obj = nullptr;
+            slot.text.clear();
+            if (txtObj) {
+                slot.text = CallTextToString(env, txtObj);
+                slot.obj = LC_NEW_WEAK_REF(env, txtObj, s_refHudText121);
+                if (env->ExceptionCheck()) { env->ExceptionClear(); slot.obj = nullptr; }
+            }
+        }
+        if (txtObj) env->DeleteLocalRef(txtObj);
+
+        const std::string& txt = slot.text;
+        if (txt.empty() || txt.find('_') == std::string::npos) continue;
+        if (!best || txt.size() > best->size()) best = &txt;
+    }
+    return best ? *best : std::string();
+}
+
+// Caller holds g_jniStateMtx.  The socket loop copies and escapes the text
+// only when the revision moves.
+static void PublishActionBar121(const std::string& text) {
+    if (text == g_jniActionBar) return;
+    g_jniActionBar = text;
+    if (++g_jniActionBarRev == 0) g_jniActionBarRev = 1;
+}
+
+// ===================== STATE SAMPLING =====================
+// FastPollThreadProc samples once per rendered frame (the swap hook pulses
+// g_swapFrameEvent121) instead of every 5 ms.  Each sample reads the screen
+// chain and crosshair; breakingBlock, holdingBlock, the cooldown pair and the
+// action bar only change on a game tick, so they are read when the local
+// player's tickCount moves and reused by the samples in between.  Without a
+// player or a tickCount field the tick clock falls back to 50 ms of wall time.
+static const DWORD kStateSampleMaxGapMs = 16;           // sample anyway when frames stall
+static const unsigned long long kTickFallbackMs = 50;
+static const unsigned long long kTickSampleMaxAgeMs = 250; // re-read even if the clock stalls
+
+// Reads the local player's tickCount.  False when there is no player or the
+// field cannot be resolved; a failed late lookup is not retried until remap.
+static bool ReadPlayerTick121(JNIEnv* env, const JniRegistry::Table* reg, jfieldID plFld, unsigned* tick) {
+    if (!plFld) return false;
+    jfieldID tickFld = reg->fields[REG_FLD_TICK_COUNT_121];
+    if (!tickFld && g_tickCountLookupFailed121) return false;
+    jobject plObj = env->GetObjectField(g_mcInstance, plFld);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return false; }
+    if (!plObj) return false;
+    if (!tickFld) {
+        jclass plCls = env->GetObjectClass(plObj);
+        if (plCls) {
+            JniRegistry::FillField(reg, REG_FLD_TICK_COUNT_121, LookupField(env, plCls, mc121::FIELD_ENTITY_TICK_COUNT));
+            env->DeleteLocalRef(plCls);
+        }
+        tickFld = reg->fields[REG_FLD_TICK_COUNT_121];
+        if (!tickFld) {
+            g_tickCountLookupFailed121 = true;
+            Log("StateSampler: player tickCount not found; tick-rate fields follow a 50 ms clock.");
+        }
+    }
+    bool ok = false;
+    if (tickFld) {
+        jint t = env->GetIntField(plObj, tickFld);
+        if (env->ExceptionCheck()) env->ExceptionClear();
+        else { *tick = (unsigned)t; ok = true; }
+    }
+    env->DeleteLocalRef(plObj);
+    return ok;
+}
+
 static void UpdateJniState() {
     TRACE261_PATH("enter");
     bool prerequisites = TRACE261_IF("prerequisitesMet", (g_stateJniReady && g_jvm && g_mcInstance && g_screenField));
@@ -7490,6 +8508,11 @@ static void UpdateJniState() {
     if (!envReady) return;
     unsigned long long nowMs = (unsigned long long)GetTickCount64();
 
+    // Pin the handle table for this iteration; a concurrent remap publishes a new
+    // generation and frees this one only after we unpin.
+    JniRegistry::Pin reg;
+    if (!reg) return;
+
     jobject scr = env->GetObjectField(g_mcInstance, g_screenField);
     if (env->ExceptionCheck()) { env->ExceptionClear(); return; }
 
@@ -7501,14 +8524,7 @@ static void UpdateJniState() {
     if (scr) {
         // Build a name chain: "thisClass|super1|super2...".
         // This makes C# GUI detection robust even when only base classes are known.
-        jclass classClass = env->FindClass("java/lang/Class");
-        jmethodID mGetSuper = nullptr;
-        if (classClass) {
-            mGetSuper = env->GetMethodID(classClass, "getSuperclass", "()Ljava/lang/Class;");
-            if (env->ExceptionCheck()) { env->ExceptionClear(); mGetSuper = nullptr; }
-        } else if (env->ExceptionCheck()) {
-            env->ExceptionClear();
-        }
+        jmethodID mGetSuper = reg->methods[REG_MID_GET_SUPERCLASS_121];
 
         jclass walk = env->GetObjectClass(scr);
         int depth = 0;
@@ -7529,7 +8545,6 @@ static void UpdateJniState() {
             depth++;
         }
         if (walk) env->DeleteLocalRef(walk);
-        if (classClass) env->DeleteLocalRef(classClass);
         env->DeleteLocalRef(scr);
     }
 
@@ -7583,60 +8598,6 @@ static void UpdateJniState() {
             }
         }
 
-        // ===== breakingBlock (actual mining) =====
-        // Use cached descriptors instead of repeated GetFieldID on every call.
-        bool breakingBlock = false;
-        {
-            static const char* s_gameModeNames[] = { "field_1761", "gameMode", nullptr };
-            static const char* s_gameModeSigs[]  = {
-                "Lnet/minecraft/class_636;",
-                "Lnet/minecraft/client/multiplayer/MultiPlayerGameMode;",
-                nullptr
-            };
-            static jfieldID s_gameModeField = nullptr;
-            if (!s_gameModeField) {
-                for (int ni = 0; s_gameModeNames[ni] && !s_gameModeField; ni++) {
-                    for (int si = 0; s_gameModeSigs[si] && !s_gameModeField; si++) {
-                        s_gameModeField = env->GetFieldID(mcCls, s_gameModeNames[ni], s_gameModeSigs[si]);
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); s_gameModeField = nullptr; }
-                    }
-                }
-            }
-            if (s_gameModeField) {
-                jobject imObj = env->GetObjectField(g_mcInstance, s_gameModeField);
-                if (imObj && !env->ExceptionCheck()) {
-                    jclass imCls = env->GetObjectClass(imObj);
-                    if (imCls) {
-                        static jfieldID s_brkFld = nullptr;
-                        if (!s_brkFld) {
-                            s_brkFld = env->GetFieldID(imCls, "field_3716", "Z");
-                            if (env->ExceptionCheck()) { env->ExceptionClear(); s_brkFld = nullptr; }
-                            if (!s_brkFld) {
-                                s_brkFld = env->GetFieldID(imCls, "isDestroying", "Z");
-                                if (env->ExceptionCheck()) { env->ExceptionClear(); s_brkFld = nullptr; }
-                            }
-                        }
-                        if (s_brkFld) {
-                            breakingBlock = (env->GetBooleanField(imObj, s_brkFld) == JNI_TRUE);
-                            if (env->ExceptionCheck()) { env->ExceptionClear(); breakingBlock = false; }
-                        }
-                        env->DeleteLocalRef(imCls);
-                    }
-                    env->DeleteLocalRef(imObj);
-                } else env->ExceptionClear();
-            }
-        }
-
-        // Fallback: if we can't read the internal breaking flag, derive it from input + target.
-        // This is more reliable across clients/mappings and avoids "pause just by looking".
-        if (!breakingBlock) {
-            SHORT lmb = GetAsyncKeyState(VK_LBUTTON);
-            bool lmbDown = (lmb & 0x8000) != 0;
-            // Consider it "breaking" when LMB is held and hit result is a block.
-            // (Don't depend on cursor mode; and don't require guiOpen==false here because GUI clicks are blocked anyway.)
-            if (!guiOpen && lmbDown && lookingAtBlock) breakingBlock = true;
-        }
-
         // Resolve and cache Minecraft.player field across known mappings.
         auto ResolvePlayerField = [&]() -> jfieldID {
             if (g_playerField_121) return g_playerField_121;
@@ -7663,92 +8624,98 @@ static void UpdateJniState() {
             return nullptr;
         };
 
-        // ===== holdingBlock (main hand item is BlockItem) =====
-        bool holdingBlock = false;
-        jfieldID plFld = ResolvePlayerField();
-        if (plFld) {
-            jobject plObj = env->GetObjectField(g_mcInstance, plFld);
-            if (plObj && !env->ExceptionCheck()) {
-                jclass plCls = env->GetObjectClass(plObj);
-                if (plCls) {
-                    // Resolve getMainHandStack() lazily.
-                    static jmethodID s_getMainHand = nullptr;
-                    if (!s_getMainHand) {
-                        const char* names[] = { "getMainHandItem", "getMainHandStack", "method_6047", nullptr };
-                        const char* sigs[] = { "()Lnet/minecraft/world/item/ItemStack;", "()Lnet/minecraft/class_1799;", nullptr };
-                        for (int ni = 0; names[ni] && !s_getMainHand; ni++) {
-                            for (int si = 0; sigs[si] && !s_getMainHand; si++) {
-                                s_getMainHand = env->GetMethodID(plCls, names[ni], sigs[si]);
-                                if (env->ExceptionCheck()) { env->ExceptionClear(); s_getMainHand = nullptr; }
-                            }
+        // ===== tick clock =====
+        unsigned tick = 0;
+        bool tickFromField = inWorld && ReadPlayerTick121(env, reg.get(), ResolvePlayerField(), &tick);
+        if (!tickFromField) tick = (unsigned)(nowMs / kTickFallbackMs);
+        TickSample121& ts = g_tickSample121;
+        bool readTick = !ts.valid || tick != ts.tick || tickFromField != ts.fromField
+            || inWorld != ts.inWorld || nowMs - ts.sampleMs >= kTickSampleMaxAgeMs;
+        TRACE261_BRANCH("tickChanged", readTick);
+        InterlockedIncrement(&g_stateSamples121);
+
+        // ===== breakingBlock (actual mining) =====
+        // Handles come from the registry; slots the build could not bind are
+        // late-bound once against the live object's class.
+        bool breakingBlock = false;
+        if (readTick) {
+            jfieldID gameModeFld = reg->fields[REG_FLD_GAME_MODE_121];
+            if (!gameModeFld) {
+                JniRegistry::FillField(reg.get(), REG_FLD_GAME_MODE_121, LookupField(env, mcCls, mc121::FIELD_GAME_MODE));
+                gameModeFld = reg->fields[REG_FLD_GAME_MODE_121];
+            }
+            if (gameModeFld) {
+                jobject imObj = env->GetObjectField(g_mcInstance, gameModeFld);
+                if (imObj && !env->ExceptionCheck()) {
+                    jfieldID brkFld = reg->fields[REG_FLD_IS_DESTROYING_121];
+                    if (!brkFld) {
+                        jclass imCls = env->GetObjectClass(imObj);
+                        if (imCls) {
+                            JniRegistry::FillField(reg.get(), REG_FLD_IS_DESTROYING_121, LookupField(env, imCls, mc121::FIELD_IS_DESTROYING));
+                            env->DeleteLocalRef(imCls);
                         }
+                        brkFld = reg->fields[REG_FLD_IS_DESTROYING_121];
                     }
+                    if (brkFld) {
+                        breakingBlock = (env->GetBooleanField(imObj, brkFld) == JNI_TRUE);
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); breakingBlock = false; }
+                    }
+                    env->DeleteLocalRef(imObj);
+                } else env->ExceptionClear();
+            }
+            ts.breakingBlock = breakingBlock;
+        } else {
+            breakingBlock = ts.breakingBlock;
+        }
 
-                    jobject stackObj = (s_getMainHand) ? env->CallObjectMethod(plObj, s_getMainHand) : nullptr;
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); stackObj = nullptr; }
-                    if (stackObj) {
-                        jclass stCls = env->GetObjectClass(stackObj);
-                        static jmethodID s_getItem = nullptr;
-                        if (stCls) {
-                            if (!s_getItem) {
-                                const char* names[] = { "getItem", "method_7909", nullptr };
-                                const char* sigs[] = {
-                                    "()Lnet/minecraft/world/item/Item;",
-                                    "()Lnet/minecraft/item/Item;",
-                                    "()Lnet/minecraft/class_1792;",
-                                    nullptr
-                                };
-                                for (int ni = 0; names[ni] && !s_getItem; ni++) {
-                                    for (int si = 0; sigs[si] && !s_getItem; si++) {
-                                        s_getItem = env->GetMethodID(stCls, names[ni], sigs[si]);
-                                        if (env->ExceptionCheck()) { env->ExceptionClear(); s_getItem = nullptr; }
-                                    }
-                                }
-                            }
-                            if (s_getItem) {
-                                jobject itemObj = env->CallObjectMethod(stackObj, s_getItem);
-                                if (env->ExceptionCheck()) { env->ExceptionClear(); itemObj = nullptr; }
-
-                                // Resolve BlockItem class lazily.
-                                static jclass s_blockItemCls = nullptr;
-                                if (!s_blockItemCls) {
-                                    const char* names[] = {
-                                        "net.minecraft.world.item.BlockItem",
-                                        "net.minecraft.item.BlockItem",
-                                        "net.minecraft.class_1747",
-                                        nullptr
-                                    };
-                                    for (int i = 0; names[i] && !s_blockItemCls; i++) {
-                                        jclass c = LoadClassWithLoader(env, g_gameClassLoader, names[i]);
-                                        if (c) s_blockItemCls = (jclass)env->NewGlobalRef(c);
-                                        if (env->ExceptionCheck()) env->ExceptionClear();
-                                    }
-                                    if (!s_blockItemCls) {
-                                        const char* slashNames[] = {
-                                            "net/minecraft/world/item/BlockItem",
-                                            "net/minecraft/item/BlockItem",
-                                            "net/minecraft/class_1747",
-                                            nullptr
-                                        };
-                                        for (int i = 0; slashNames[i] && !s_blockItemCls; i++) {
-                                            jclass c = env->FindClass(slashNames[i]);
-                                            if (env->ExceptionCheck()) { env->ExceptionClear(); c = nullptr; }
-                                            if (c) s_blockItemCls = (jclass)env->NewGlobalRef(c);
-                                        }
-                                    }
-                                }
+        // Fallback: if we can't read the internal breaking flag, derive it from input + target.
+        // This is more reliable across clients/mappings and avoids "pause just by looking".
+        if (!breakingBlock) {
+            SHORT lmb = GetAsyncKeyState(VK_LBUTTON);
+            bool lmbDown = (lmb & 0x8000) != 0;
+            // Consider it "breaking" when LMB is held and hit result is a block.
+            // (Don't depend on cursor mode; and don't require guiOpen==false here because GUI clicks are blocked anyway.)
+            if (!guiOpen && lmbDown && lookingAtBlock) breakingBlock = true;
+        }
 
-                                if (itemObj && s_blockItemCls) {
-                                    holdingBlock = (env->IsInstanceOf(itemObj, s_blockItemCls) == JNI_TRUE);
-                                }
+        // ===== holdingBlock (main hand item is BlockItem) =====
+        bool holdingBlock = false;
+        jfieldID plFld = ResolvePlayerField();
+        if (readTick && plFld) {
+            jobject plObj = env->GetObjectField(g_mcInstance, plFld);
+            if (plObj && !env->ExceptionCheck()) {
+                jmethodID getMainHand = reg->methods[REG_MID_GET_MAIN_HAND_121];
+                if (!getMainHand) {
+                    jclass plCls = env->GetObjectClass(plObj);
+                    if (plCls) {
+                        JniRegistry::FillMethod(reg.get(), REG_MID_GET_MAIN_HAND_121, LookupMethod(env, plCls, mc121::METHOD_GET_MAIN_HAND));
+                        env->DeleteLocalRef(plCls);
+                    }
+                    getMainHand = reg->methods[REG_MID_GET_MAIN_HAND_121];
+                }
 
-                                if (itemObj) env->DeleteLocalRef(itemObj);
-                            }
+                jobject stackObj = getMainHand ? env->CallObjectMethod(plObj, getMainHand) : nullptr;
+                if (env->ExceptionCheck()) { env->ExceptionClear(); stackObj = nullptr; }
+                if (stackObj) {
+                    jmethodID getItem = reg->methods[REG_MID_STACK_GET_ITEM_121];
+                    if (!getItem) {
+                        jclass stCls = env->GetObjectClass(stackObj);
+                        if (stCls) {
+                            JniRegistry::FillMethod(reg.get(), REG_MID_STACK_GET_ITEM_121, LookupMethod(env, stCls, mc121::METHOD_STACK_GET_ITEM));
                             env->DeleteLocalRef(stCls);
                         }
-                        env->DeleteLocalRef(stackObj);
+                        getItem = reg->methods[REG_MID_STACK_GET_ITEM_121];
+                    }
+                    jclass blockItemCls = reg->classes[REG_CLS_BLOCK_ITEM_121];
+                    if (getItem && blockItemCls) {
+                        jobject itemObj = env->CallObjectMethod(stackObj, getItem);
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); itemObj = nullptr; }
+                        if (itemObj) {
+                            holdingBlock = (env->IsInstanceOf(itemObj, blockItemCls) == JNI_TRUE);
+                            env->DeleteLocalRef(itemObj);
+                        }
                     }
-                    env->DeleteLocalRef(plCls);
+                    env->DeleteLocalRef(stackObj);
                 }
                 env->DeleteLocalRef(plObj);
             } else env->ExceptionClear();
@@ -7756,7 +8723,7 @@ static void UpdateJniState() {
 
         float attackCooldown = 1.0f;
         float attackCooldownPerTick = 0.08f;
-        if (inWorld) {
+        if (readTick && inWorld) {
             jfieldID plFld2 = ResolvePlayerField();
             if (!plFld2 && !g_loggedCooldownPlayerFieldMissing) {
                 g_loggedCooldownPlayerFieldMissing = true;
@@ -7765,67 +8732,48 @@ static void UpdateJniState() {
             if (plFld2) {
                 jobject plObj2 = env->GetObjectField(g_mcInstance, plFld2);
                 if (plObj2 && !env->ExceptionCheck()) {
-                    jclass plCls2 = env->GetObjectClass(plObj2);
-                    if (plCls2) {
-                        static jmethodID s_getAttackCooldownProgress = nullptr;
-                        static jmethodID s_getAttackCooldownPerTick = nullptr;
-                        if (!s_getAttackCooldownProgress) {
-                            const char* names[] = { "getAttackStrengthScale", "getAttackCooldownProgress", "method_7261", nullptr };
-                            for (int ni = 0; names[ni] && !s_getAttackCooldownProgress; ni++) {
-                                s_getAttackCooldownProgress = env->GetMethodID(plCls2, names[ni], "(F)F");
-                                if (s_getAttackCooldownProgress && !g_loggedCooldownProgressResolve) {
-                                    g_loggedCooldownProgressResolve = true;
-                                    Log(std::string("CooldownJNI: resolved progress method: ") + names[ni] + "(F)F");
-                                }
-                                if (env->ExceptionCheck()) { env->ExceptionClear(); s_getAttackCooldownProgress = nullptr; }
-                            }
-                            if (!s_getAttackCooldownProgress && !g_loggedCooldownProgressMissing) {
-                                g_loggedCooldownProgressMissing = true;
-                                Log("CooldownJNI: failed to resolve progress method; progress will fallback to 1.0.");
-                            }
+                    jmethodID cdProgress = reg->methods[REG_MID_COOLDOWN_PROGRESS_121];
+                    jmethodID cdPerTick = reg->methods[REG_MID_COOLDOWN_PER_TICK_121];
+                    if (!cdProgress || !cdPerTick) {
+                        jclass plCls2 = env->GetObjectClass(plObj2);
+                        if (plCls2) {
+                            if (!cdProgress) JniRegistry::FillMethod(reg.get(), REG_MID_COOLDOWN_PROGRESS_121, LookupMethod(env, plCls2, mc121::METHOD_COOLDOWN_PROGRESS));
+                            if (!cdPerTick) JniRegistry::FillMethod(reg.get(), REG_MID_COOLDOWN_PER_TICK_121, LookupMethod(env, plCls2, mc121::METHOD_COOLDOWN_PER_TICK));
+                            env->DeleteLocalRef(plCls2);
                         }
-
-                        if (!s_getAttackCooldownPerTick) {
-                            const char* names[] = { "getCurrentItemAttackStrengthDelay", "getAttackCooldownProgressPerTick", "method_7279", nullptr };
-                            for (int ni = 0; names[ni] && !s_getAttackCooldownPerTick; ni++) {
-                                s_getAttackCooldownPerTick = env->GetMethodID(plCls2, names[ni], "()F");
-                                if (s_getAttackCooldownPerTick && !g_loggedCooldownPerTickResolve) {
-                                    g_loggedCooldownPerTickResolve = true;
-                                    Log(std::string("CooldownJNI: resolved perTick method: ") + names[ni] + "()F");
-                                }
-                                if (env->ExceptionCheck()) { env->ExceptionClear(); s_getAttackCooldownPerTick = nullptr; }
-                            }
-                            if (!s_getAttackCooldownPerTick && !g_loggedCooldownPerTickMissing) {
-                                g_loggedCooldownPerTickMissing = true;
-                                Log("CooldownJNI: failed to resolve perTick method; perTick will fallback to 0.08.");
-                            }
+                        cdProgress = reg->methods[REG_MID_COOLDOWN_PROGRESS_121];
+                        cdPerTick = reg->methods[REG_MID_COOLDOWN_PER_TICK_121];
+                        if (!cdProgress && !g_loggedCooldownProgressMissing) {
+                            g_loggedCooldownProgressMissing = true;
+                            Log("CooldownJNI: failed to resolve progress method; progress will fallback to 1.0.");
                         }
-
-                        if (s_getAttackCooldownProgress) {
-                            attackCooldown = env->CallFloatMethod(plObj2, s_getAttackCooldownProgress, 0.0f);
-                            if (env->ExceptionCheck()) {
-                                env->ExceptionClear();
-                                attackCooldown = 1.0f;
-                                if ((nowMs - g_lastCooldownProgressFallbackLogMs) > 5000ULL) {
-                                    g_lastCooldownProgressFallbackLogMs = nowMs;
-                                    Log("CooldownJNI: progress call threw; fallback to 1.0.");
-                                }
+                        if (!cdPerTick && !g_loggedCooldownPerTickMissing) {
+                            g_loggedCooldownPerTickMissing = true;
+                            Log("CooldownJNI: failed to resolve perTick method; perTick will fallback to 0.08.");
+                        }
+                    }
+                    if (cdProgress) {
+                        attackCooldown = env->CallFloatMethod(plObj2, cdProgress, 0.0f);
+                        if (env->ExceptionCheck()) {
+                            env->ExceptionClear();
+                            attackCooldown = 1.0f;
+                            if ((nowMs - g_lastCooldownProgressFallbackLogMs) > 5000ULL) {
+                                g_lastCooldownProgressFallbackLogMs = nowMs;
+                                Log("CooldownJNI: progress call threw; fallback to 1.0.");
                             }
                         }
+                    }
 
-                        if (s_getAttackCooldownPerTick) {
-                            attackCooldownPerTick = env->CallFloatMethod(plObj2, s_getAttackCooldownPerTick);
-                            if (env->ExceptionCheck()) {
-                                env->ExceptionClear();
-                                attackCooldownPerTick = 0.08f;
-                                if ((nowMs - g_lastCooldownPerTickFallbackLogMs) > 5000ULL) {
-                                    g_lastCooldownPerTickFallbackLogMs = nowMs;
-                                    Log("CooldownJNI: perTick call threw; fallback to 0.08.");
-                                }
+                    if (cdPerTick) {
+                        attackCooldownPerTick = env->CallFloatMethod(plObj2, cdPerTick);
+                        if (env->ExceptionCheck()) {
+                            env->ExceptionClear();
+                            attackCooldownPerTick = 0.08f;
+                            if ((nowMs - g_lastCooldownPerTickFallbackLogMs) > 5000ULL) {
+                                g_lastCooldownPerTickFallbackLogMs = nowMs;
+                                Log("CooldownJNI: perTick call threw; fallback to 0.08.");
                             }
                         }
-
-                        env->DeleteLocalRef(plCls2);
                     }
                     env->DeleteLocalRef(plObj2);
                 } else {
@@ -7845,35 +8793,43 @@ static void UpdateJniState() {
         if (attackCooldownPerTick <= 0.0f) attackCooldownPerTick = 0.08f;
         // Keep values > 1.0f intact: some mappings return cooldown period in ticks
         // (e.g., sword ~= 12.5), and C# normalizes by inverting these values.
-        if (inWorld && (nowMs - g_lastCooldownSampleLogMs) > 5000ULL) {
+        if (readTick && inWorld && (nowMs - g_lastCooldownSampleLogMs) > 5000ULL) {
             g_lastCooldownSampleLogMs = nowMs;
             Log("CooldownJNI sample: attackCooldown=" + std::to_string(attackCooldown)
                 + " perTick=" + std::to_string(attackCooldownPerTick));
         }
 
-        if (inWorld) {
+        if (readTick && inWorld) {
             EnsureHudTextFields(env, mcCls, nullptr);
             if (g_inGameHudField_121) {
                 jobject hudObj = env->GetObjectField(g_mcInstance, g_inGameHudField_121);
                 if (env->ExceptionCheck()) { env->ExceptionClear(); hudObj = nullptr; }
                 if (hudObj) {
                     EnsureHudTextFields(env, mcCls, hudObj);
-                    for (auto fid : g_hudTextFields_121) {
-                        jobject txtObj = env->GetObjectField(hudObj, fid);
-                        if (env->ExceptionCheck()) { env->ExceptionClear(); txtObj = nullptr; }
-                        if (!txtObj) continue;
-
-                        std::string txt = CallTextToString(env, txtObj);
-                        env->DeleteLocalRef(txtObj);
-                        if (txt.empty() || txt.find('_') == std::string::npos) continue;
-                        if (actionBarText.empty() || txt.size() > actionBarText.size())
-                            actionBarText = txt;
-                    }
+                    actionBarText = ReadActionBar121(env, hudObj);
                     env->DeleteLocalRef(hudObj);
                 }
             }
         }
 
+        if (readTick) {
+            ts.valid = true;
+            ts.fromField = tickFromField;
+            ts.inWorld = inWorld;
+            ts.tick = tick;
+            ts.sampleMs = nowMs;
+            ts.holdingBlock = holdingBlock;
+            ts.attackCooldown = attackCooldown;
+            ts.attackCooldownPerTick = attackCooldownPerTick;
+            ts.actionBar = actionBarText;
+            InterlockedIncrement(&g_stateTickReads121);
+        } else {
+            holdingBlock = ts.holdingBlock;
+            attackCooldown = ts.attackCooldown;
+            attackCooldownPerTick = ts.attackCooldownPerTick;
+            actionBarText = ts.actionBar;
+        }
+
         env->DeleteLocalRef(mcCls);
 
         { LockGuard lk(g_jniStateMtx);
@@ -7882,10 +8838,13 @@ static void UpdateJniState() {
             } else if (lookingAtEntity) {
                 g_lastEntitySeenMs = nowMs;
             }
-            bool lookingAtEntityLatched = g_lastEntitySeenMs != 0 && (nowMs - g_lastEntitySeenMs) <= 12ULL;
+            // Hold an entity hit across one sample gap so a single missed frame
+            // does not drop the latch.
+            unsigned long long sampleGapMs = g_jniStateMs ? (std::min)(nowMs - g_jniStateMs, 50ULL) : 0ULL;
+            bool lookingAtEntityLatched = g_lastEntitySeenMs != 0 && (nowMs - g_lastEntitySeenMs) <= 12ULL + sampleGapMs;
 
             g_jniScreenName = screenName;
-            g_jniActionBar = actionBarText;
+            PublishActionBar121(actionBarText);
             g_jniGuiOpen = guiOpen;
             g_jniInWorld = inWorld;
             g_jniLookingAtBlock = lookingAtBlock;
@@ -7896,13 +8855,16 @@ static void UpdateJniState() {
             g_jniAttackCooldown = attackCooldown;
             g_jniAttackCooldownPerTick = attackCooldownPerTick;
             g_jniStateMs = nowMs;
+            g_jniTick = ts.fromField ? ts.tick : 0;
+            g_jniTickSampleMs = ts.sampleMs;
         }
+        SignalStateReady();
         return;
     }
 
     { LockGuard lk(g_jniStateMtx);
         g_jniScreenName = screenName;
-        g_jniActionBar = actionBarText;
+        PublishActionBar121(actionBarText);
         g_jniGuiOpen = guiOpen;
         g_jniInWorld = inWorld;
         g_jniLookingAtBlock = lookingAtBlock;
@@ -7915,6 +8877,7 @@ static void UpdateJniState() {
         g_jniStateMs = nowMs;
         g_lastEntitySeenMs = 0;
     }
+    SignalStateReady();
 }
 
 // ===================== WNDPROC HOOK =====================
@@ -8058,8 +9021,8 @@ static void RenderClickGUI() {
     const float SET_W    = WIN_W - ACCENT_W - SIDE_W - GAP*2 - MOD_W - GAP; // 294
 
     // Get config snapshot
-    Config cfg;
-    { LockGuard lk(g_configMutex); cfg = g_config; }
+    ConfigRef cfgRef = g_config.Acquire();
+    const Config& cfg = *cfgRef;
 
     // --- Sidebar (Categories) ---
     ImGui::SetCursorPos(ImVec2(ACCENT_W, PANEL_Y));
@@ -8084,6 +9047,11 @@ static void RenderClickGUI() {
         if (selCategory != 2) { selCategory = 2; selModule = 0; }
     }
     ImGui::PopStyleColor();
+    catStyle(selCategory == 3);
+    if (ImGui::Selectable("  Debug", selCategory == 3, 0, ImVec2(SIDE_W-4, 28))) {
+        if (selCategory != 3) { selCategory = 3; selModule = 0; }
+    }
+    ImGui::PopStyleColor();
     ImGui::EndChild();
 
     // --- Modules ---
@@ -8123,10 +9091,20 @@ static void RenderClickGUI() {
         ModuleRow("nt",  "Nametags",       cfg.nametags,   1, "toggleNametags");
         ModuleRow("cp",  "Closest Player", cfg.closestPlayer, 2, "toggleClosestPlayerInfo");
         ModuleRow("gtb", "GTB Helper",     cfg.gtbHelper,  3, "toggleGtbHelper");
-    } else {
+    } else if (selCategory == 2) {
         // Risky
         ModuleRow("rh",  "Reach",          cfg.reachEnabled, 0, "toggleReach");
         ModuleRow("vl",  "Velocity",       cfg.velocityEnabled, 1, "toggleVelocity");
+    } else {
+        // Debug (read-only panels, nothing to toggle)
+        bool sel = (selModule == 0);
+        if (ImGui::Selectable("  JNI Budget", &sel, 0, ImVec2(MOD_W - 8, 22))) selModule = 0;
+        sel = (selModule == 1);
+        if (ImGui::Selectable("  Frame Cost", &sel, 0, ImVec2(MOD_W - 8, 22))) selModule = 1;
+        sel = (selModule == 2);
+        if (ImGui::Selectable("  Scan Governor", &sel, 0, ImVec2(MOD_W - 8, 22))) selModule = 2;
+        sel = (selModule == 3);
+        if (ImGui::Selectable("  Global Refs", &sel, 0, ImVec2(MOD_W - 8, 22))) selModule = 3;
     }
     ImGui::EndChild();
 
@@ -8240,7 +9218,7 @@ static void RenderClickGUI() {
 
         int rChance = cfg.reachChance;
         if (ImGui::SliderInt("Chance %", &rChance, 0, 100))
-            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setReachChance\",\"value\":%d}\n", rChance); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setReachChance\",\"value\":%d}\n", rChance); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); SignalStateReady(); }
             
         ImGui::Spacing();
         ImGui::TextDisabled("Attribute modification for 1.21.");
@@ -8250,18 +9228,26 @@ static void RenderClickGUI() {
 
         int vHorizontal = cfg.velocityHorizontal;
         if (ImGui::SliderInt("Horizontal %", &vHorizontal, 1, 100))
-            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setVelocityHorizontal\",\"value\":%d}\n", vHorizontal); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setVelocityHorizontal\",\"value\":%d}\n", vHorizontal); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); SignalStateReady(); }
 
         int vVertical = cfg.velocityVertical;
         if (ImGui::SliderInt("Vertical %", &vVertical, 1, 100))
-            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setVelocityVertical\",\"value\":%d}\n", vVertical); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setVelocityVertical\",\"value\":%d}\n", vVertical); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); SignalStateReady(); }
 
         int vChance = cfg.velocityChance;
         if (ImGui::SliderInt("Chance %", &vChance, 1, 100))
-            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setVelocityChance\",\"value\":%d}\n", vChance); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); }
+            { char buf[128]; snprintf(buf, sizeof(buf), "{\"type\":\"cmd\",\"action\":\"setVelocityChance\",\"value\":%d}\n", vChance); LockGuard lk(g_cmdMutex); g_pendingCmds.push_back(buf); SignalStateReady(); }
 
         ImGui::Spacing();
         ImGui::TextDisabled("Scales incoming knockback vectors.");
+    } else if (selCategory == 3 && selModule == 0) {
+        DebugPanel::DrawJniBudget();
+    } else if (selCategory == 3 && selModule == 1) {
+        DebugPanel::DrawFrameCost();
+    } else if (selCategory == 3 && selModule == 2) {
+        DebugPanel::DrawScanGovernor();
+    } else if (selCategory == 3 && selModule == 3) {
+        DebugPanel::DrawGlobalRefs();
     }
 
     ImGui::EndChild();
@@ -8301,7 +9287,7 @@ static void UpdateRealGuiState() {
 // ===================== CHEST SCAN BACKGROUND THREAD =====================
 // UpdateChestList calls Java methods (CallObjectMethod) which MUST NOT run on the render thread
 // (see 1.21_MAPPINGS.md critical warning). This thread attaches its own JNI env and runs the
-// chest scan independently, protecting g_chestList with g_chestListMutex.
+// chest scan independently, publishing g_chestList snapshots.
 
 // Reads camera position, yaw, pitch, and Lunar projection/view matrices on the BACKGROUND thread.
 // Stores the result in g_bgCamState (under g_bgCamMutex) so the render thread can use it with
@@ -8321,16 +9307,28 @@ static void ReadCameraState(JNIEnv* env) {
             if (fovOpt && !env->ExceptionCheck()) {
                 jobject valObj = env->CallObjectMethod(fovOpt, g_simpleOptionGet_121);
                 if (valObj && !env->ExceptionCheck()) {
-                    jclass valCls = env->GetObjectClass(valObj);
-                    jmethodID doubleVal = env->GetMethodID(valCls, "doubleValue", "()D");
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); doubleVal = env->GetMethodID(valCls, "intValue", "()I"); if (env->ExceptionCheck()) env->ExceptionClear(); }
-                    
-                    if (doubleVal) {
-                        std::string cn = GetClassNameFromClass(env, valCls);
-                        if (cn.find("Double") != std::string::npos) cs.fov = (float)env->CallDoubleMethod(valObj, doubleVal);
-                        else cs.fov = (float)env->CallIntMethod(valObj, doubleVal);
+                    FovValueCache121& fc = g_fovValue_121;
+                    if (!fc.option || fc.optionGet != g_simpleOptionGet_121 || !env->IsSameObject(fovOpt, fc.option)) {
+                        // New option instance (first read, world reload, remap): pick the accessor once.
+                        if (fc.option) RefLedger::Delete(env, fc.option);
+                        fc = FovValueCache121();
+                        jclass valCls = env->GetObjectClass(valObj);
+                        jmethodID getter = env->GetMethodID(valCls, "doubleValue", "()D");
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); getter = env->GetMethodID(valCls, "intValue", "()I"); if (env->ExceptionCheck()) env->ExceptionClear(); }
+                        if (getter) {
+                            std::string cn = GetClassNameFromClass(env, valCls);
+                            fc.getter = getter;
+                            fc.isDouble = cn.find("Double") != std::string::npos;
+                            fc.optionGet = g_simpleOptionGet_121;
+                            fc.option = LC_NEW_WEAK_REF(env, fovOpt, s_refCamera121);
+                        }
+                        env->DeleteLocalRef(valCls);
+                    }
+                    if (fc.getter) {
+                        if (fc.isDouble) cs.fov = (float)env->CallDoubleMethod(valObj, fc.getter);
+                        else cs.fov = (float)env->CallIntMethod(valObj, fc.getter);
+                        if (env->ExceptionCheck()) { env->ExceptionClear(); cs.fov = 70.0f; }
                     }
-                    env->DeleteLocalRef(valCls);
                     env->DeleteLocalRef(valObj);
                 }
                 env->DeleteLocalRef(fovOpt);
@@ -8414,49 +9412,24 @@ static void ReadCameraState(JNIEnv* env) {
 
                 // Reflection fallback for unknown suffixes
                 if (!g_lunarProjField_121 || !g_lunarViewField_121) {
-                    jclass cCls = env->FindClass("java/lang/Class");
-                    jclass cFld = env->FindClass("java/lang/reflect/Field");
-                    jmethodID mGF = cCls ? env->GetMethodID(cCls, "getDeclaredFields", "()[Ljava/lang/reflect/Field;") : nullptr;
-                    jmethodID mFT = cFld ? env->GetMethodID(cFld, "getType", "()Ljava/lang/Class;") : nullptr;
-                    jmethodID mFN = cFld ? env->GetMethodID(cFld, "getName", "()Ljava/lang/String;") : nullptr;
-                    if (env->ExceptionCheck()) { env->ExceptionClear(); mGF = mFT = mFN = nullptr; }
-                    if (mGF && mFT && mFN) {
-                        jobjectArray fields = (jobjectArray)env->CallObjectMethod(grCls, mGF);
-                        if (fields && !env->ExceptionCheck()) {
-                            jsize fc = env->GetArrayLength(fields);
-                            for (int i = 0; i < fc; i++) {
-                                jobject f = env->GetObjectArrayElement(fields, i);
-                                if (!f) continue;
-                                jclass ft = (jclass)env->CallObjectMethod(f, mFT);
-                                std::string ftn = ft ? GetClassNameFromClass(env, ft) : "";
-                                if (ft) env->DeleteLocalRef(ft);
-                                if (ftn != "org.joml.Matrix4f") { env->DeleteLocalRef(f); continue; }
-                                
-                                jstring jfn = (jstring)env->CallObjectMethod(f, mFN);
-                                const char* cfn = env->GetStringUTFChars(jfn, nullptr);
-                                std::string fn = cfn ? cfn : "";
-                                if (cfn) env->ReleaseStringUTFChars(jfn, cfn);
-                                env->DeleteLocalRef(jfn);
-                                env->DeleteLocalRef(f);
-
-                                if (!g_lunarProjField_121 && fn.find("lunar$savedProjection") != std::string::npos) {
-                                    g_lunarProjField_121 = env->GetFieldID(grCls, fn.c_str(), matSig);
-                                    if (env->ExceptionCheck()) { env->ExceptionClear(); g_lunarProjField_121 = nullptr; }
-                                    else Log("Discovered Lunar projection matrix: " + fn);
-                                }
-                                if (!g_lunarViewField_121 && fn.find("lunar$savedModelView") != std::string::npos) {
-                                    g_lunarViewField_121 = env->GetFieldID(grCls, fn.c_str(), matSig);
-                                    if (env->ExceptionCheck()) { env->ExceptionClear(); g_lunarViewField_121 = nullptr; }
-                                    else Log("Discovered Lunar modelview matrix: " + fn);
-                                }
-                                if (g_lunarProjField_121 && g_lunarViewField_121) break;
-                            }
+                    MemberIndex::Query q(env);
+                    const std::vector<MemberIndex::Field>& fields = q.Fields(grCls);
+                    for (size_t i = 0; i < fields.size(); i++) {
+                        if (*fields[i].type != "org.joml.Matrix4f") continue;
+                        const std::string& fn = *fields[i].name;
+
+                        if (!g_lunarProjField_121 && fn.find("lunar$savedProjection") != std::string::npos) {
+                            g_lunarProjField_121 = env->GetFieldID(grCls, fn.c_str(), matSig);
+                            if (env->ExceptionCheck()) { env->ExceptionClear(); g_lunarProjField_121 = nullptr; }
+                            else Log("Discovered Lunar projection matrix: " + fn);
                         }
-                        if (fields) env->DeleteLocalRef(fields);
+                        if (!g_lunarViewField_121 && fn.find("lunar$savedModelView") != std::string::npos) {
+                            g_lunarViewField_121 = env->GetFieldID(grCls, fn.c_str(), matSig);
+                            if (env->ExceptionCheck()) { env->ExceptionClear(); g_lunarViewField_121 = nullptr; }
+                            else Log("Discovered Lunar modelview matrix: " + fn);
+                        }
+                        if (g_lunarProjField_121 && g_lunarViewField_121) break;
                     }
-                    if (cCls) env->DeleteLocalRef(cCls);
-                    if (cFld) env->DeleteLocalRef(cFld);
-                    if (env->ExceptionCheck()) env->ExceptionClear();
                 }
                 env->DeleteLocalRef(grCls);
             }
@@ -8483,12 +9456,31 @@ static void ReadCameraState(JNIEnv* env) {
             + " matsOk=" + (cs.matsOk ? "1" : "0"));
     }
 
-    { LockGuard lk(g_bgCamMutex); g_bgCamState = cs; }
+    if (cs.camFound) {
+        if (cs.matsOk) Projection::FromMatrices(cs.projection, cs.camX, cs.camY, cs.camZ, cs.view.m, cs.proj.m);
+        else           Projection::FromAngles(cs.projection, cs.camX, cs.camY, cs.camZ, cs.yaw, cs.pitch, cs.fov);
+    }
+
+    // Consumers key reprojection on seq, so only a moved camera gets a new one.
+    static unsigned long s_camSeq = 0;
+    {
+        LockGuard lk(g_bgCamMutex);
+        if (g_bgCamState.seq == 0 || !SameCameraState(g_bgCamState, cs)) {
+            cs.seq = ++s_camSeq;
+            g_bgCamState = cs;
+        }
+    }
+    SignalStateReady();
 }
 
+// Samples state once per rendered frame, or every kStateSampleMaxGapMs while
+// frames stall (minimised, loading), so stateMs never goes stale.
 static DWORD WINAPI FastPollThreadProc(LPVOID) {
+    ThreadPolicy::Apply(ThreadPolicy::ROLE_STATE, "state poll");
     JNIEnv* env = nullptr;
     if (!g_jvm || g_jvm->AttachCurrentThread((void**)&env, nullptr) != JNI_OK) return 1;
+    DWORD statsStartMs = GetTickCount();
+    LONG statsFrameSeq = g_swapFrameSeq121;
     while (g_running) {
         if (g_stateJniReady) {
             LockGuard remapGuard(g_jniRemapMtx);
@@ -8496,41 +9488,66 @@ static DWORD WINAPI FastPollThreadProc(LPVOID) {
                 UpdateJniState();
             }
         }
-        Sleep(5); // 200Hz poll
+
+        DWORD nowMs = GetTickCount();
+        if (nowMs - statsStartMs >= 30000) {
+            LONG frames = g_swapFrameSeq121;
+            Log("StateSampler: " + std::to_string(InterlockedExchange(&g_stateSamples121, 0)) + " samples, "
+                + std::to_string(InterlockedExchange(&g_stateTickReads121, 0)) + " tick reads, "
+                + std::to_string(frames - statsFrameSeq) + " frames in "
+                + std::to_string(nowMs - statsStartMs) + " ms");
+            statsStartMs = nowMs;
+            statsFrameSeq = frames;
+        }
+
+        if (g_swapFrameEvent121) WaitForSingleObject(g_swapFrameEvent121, kStateSampleMaxGapMs);
+        else Sleep(5);
     }
     g_jvm->DetachCurrentThread();
     return 0;
 }
 
+// Every module on the scan thread is a task on one scheduler: they share this
+// thread's JNIEnv and the lazily resolved JNI caches, so they stay on it, but a
+// slow task (chest scan) no longer holds back a cheap one that is due.
 static DWORD WINAPI ChestScanThreadProc(LPVOID) {
+    ThreadPolicy::Apply(ThreadPolicy::ROLE_SCAN, "scan");
     JNIEnv* env = nullptr;
     if (!g_jvm || g_jvm->AttachCurrentThread((void**)&env, nullptr) != JNI_OK) return 1;
     TRACE261_PATH("thread-start");
     DWORD lastAutoRemapRetryMs = 0;
-    while (g_running) {
-        Config cfg;
-        { LockGuard lk(g_configMutex); cfg = g_config; }
+    ConfigRef cfgRef;   // re-acquired only when ParseConfig published a new version
+    bool inWorldNow = false;
+    lc::TaskScheduler sched;
+
+    // JNI accounting: each task run is one JniAccounting scope under the task's
+    // name.  A run over its transition budget also defers the task one more
+    // period, so a module that starts walking far more objects than usual
+    // backs off even while it stays inside its CPU budget.
+    auto Accounted = [&](const char* name, unsigned jniBudget, const std::function<void()>& run) -> std::function<void()> {
+        int acct = JniAccounting::Register(name, jniBudget);
+        return [&sched, env, acct, run]() {
+            {
+                JniAccounting::Scope scope(env, acct);
+                JniReplay::RecordScope rec(env);   // no-op unless LC_JNI_RECORD is recording
+                run();
+            }
+            if (JniAccounting::LastRunOverBudget(acct)) sched.DeferCurrent();
+        };
+    };
+
+    // Mapping upkeep: the loader's reload pulse and the 5 s auto-retry.  The
+    // discovery itself runs on the remap thread; this only starts it and
+    // swaps in what it built.  A pulse that arrives mid-remap waits for it.
+    const int remapTask = sched.Add("remap", 50, 0, 0, Accounted("remap", 0, [&]() {
+        CollectRemap121(env);
+        if (g_remapState121 != kRemapIdle121) return;
 
         bool forcedRemap = (InterlockedExchange(&g_forceGlobalJniRemap_121, 0) != 0);
         TRACE261_BRANCH("forcedGlobalRemapPulse", forcedRemap);
         if (forcedRemap) {
-            bool remapReady = false;
-            {
-                LockGuard remapGuard(g_jniRemapMtx);
-                TRACE261_PATH("manual-remap-cycle");
-                ReleaseSpeedBridgeSneak121(env);
-                ResetSpeedBridgeMovementTracking121();
-                ResetModernJniRuntimeCaches121(env, "manual-reload-request");
-                for (int attempt = 0; attempt < 8 && g_running; ++attempt) {
-                    if (DiscoverJniMappings(env)) {
-                        remapReady = true;
-                        break;
-                    }
-                    Sleep(500);
-                }
-            }
-            Log(std::string("ReloadMappings: full JNI remap ")
-                + (remapReady ? "completed." : "still unresolved; auto-retry will continue."));
+            StartRemap121(true);
+            return;
         }
 
         DWORD loopNow = GetTickCount();
@@ -8538,15 +9555,19 @@ static DWORD WINAPI ChestScanThreadProc(LPVOID) {
         TRACE261_BRANCH("autoRemapRetryDue", needAutoRetry);
         if (needAutoRetry) {
             lastAutoRemapRetryMs = loopNow;
-            LockGuard remapGuard(g_jniRemapMtx);
             TRACE261_PATH("auto-remap-retry");
-            DiscoverJniMappings(env);
+            StartRemap121(false);
         }
+    }));
 
+    // Camera, in-world and world-change detection; the module tasks below
+    // only run while this last saw the player in a world.
+    const int worldTask = sched.Add("world", 50, 1, 2000, Accounted("world", 400, [&]() {
+        const Config& cfg = *cfgRef;
         if (g_stateJniReady) {
             // All CallObjectMethod work runs here — never on the render thread.
             ReadCameraState(env);   // camera pos/yaw/pitch/matrices → g_bgCamState
-            bool inWorldNow = IsInWorldNow(env);
+            inWorldNow = IsInWorldNow(env);
             { LockGuard lk(g_jniStateMtx); g_jniInWorld = inWorldNow; }
             if (inWorldNow) {
                 // Detect world changes to reset stale JNI caches (prevents crash on server switch)
@@ -8557,51 +9578,18 @@ static DWORD WINAPI ChestScanThreadProc(LPVOID) {
                         if (!g_lastAutoTotemWorld_121 || env->IsSameObject(worldObj, g_lastAutoTotemWorld_121) == JNI_FALSE) {
                             if (env->ExceptionCheck()) env->ExceptionClear();
                             ResetAutoTotemCaches(env);
-                            if (g_lastAutoTotemWorld_121) env->DeleteGlobalRef(g_lastAutoTotemWorld_121);
-                            g_lastAutoTotemWorld_121 = env->NewGlobalRef(worldObj);
+                            if (g_lastAutoTotemWorld_121) RefLedger::Delete(env, g_lastAutoTotemWorld_121);
+                            g_lastAutoTotemWorld_121 = LC_NEW_GLOBAL_REF(env, worldObj, s_refAutoTotem121);
                         }
                         env->DeleteLocalRef(worldObj);
                     }
                 }
 
                 // Periodic diagnostic for chest esp config state
-                static DWORD s_cfgLogMs = 0;
-                DWORD nowMs = GetTickCount();
-                if (nowMs - s_cfgLogMs > 10000) {
-                    s_cfgLogMs = nowMs;
+                static AsyncLog::RateGate s_cfgLogGate;
+                if (AsyncLog::Allow(s_cfgLogGate, 10000)) {
                     Log("ScanThread cfg: chestEsp=" + std::to_string(cfg.chestEsp) + " nametags=" + std::to_string(cfg.nametags) + " closestPlayer=" + std::to_string(cfg.closestPlayer) + " hideVanilla=" + std::to_string(cfg.nametagHideVanilla));
                 }
-
-                static bool s_reachWasEnabled = false;
-                if (cfg.reachEnabled || s_reachWasEnabled) {
-                    UpdateReach(env, cfg);
-                    s_reachWasEnabled = cfg.reachEnabled;
-                }
-
-                static bool s_velocityWasEnabled = false;
-                if (cfg.velocityEnabled || s_velocityWasEnabled) {
-                    UpdateVelocity(env, cfg);
-                    s_velocityWasEnabled = cfg.velocityEnabled;
-                }
-
-                static bool s_autoTotemWasEnabled = false;
-                if (cfg.autoTotemEnabled || s_autoTotemWasEnabled) {
-                    UpdateAutoTotem(env, cfg);
-                    s_autoTotemWasEnabled = cfg.autoTotemEnabled;
-                }
-
-                static bool s_speedBridgeWasEnabled = false;
-                if (cfg.speedBridge || s_speedBridgeWasEnabled || g_speedBridgeManagingSneak_121) {
-                    UpdateSpeedBridge(env, cfg, inWorldNow);
-                    s_speedBridgeWasEnabled = cfg.speedBridge;
-                }
-
-                if (cfg.closestPlayer)
-                    UpdateClosestPlayerOverlay(env);
-                if (cfg.nametags || cfg.closestPlayer || cfg.aimAssist || cfg.nametagHideVanilla || g_nametagSuppressionActive_121)
-                    UpdatePlayerListOverlay(env);
-                if (cfg.chestEsp)
-                    UpdateChestList(env);
             } else {
                 // Left world — reset caches so next world gets fresh JNI lookups
                 ResetAutoTotemCaches(env);
@@ -8611,22 +9599,204 @@ static DWORD WINAPI ChestScanThreadProc(LPVOID) {
                 }
                 ReleaseSpeedBridgeSneak121(env);
                 ResetSpeedBridgeMovementTracking121();
-                { LockGuard lk(g_playerListMutex); g_playerList.clear(); }
-                { LockGuard lk2(g_chestListMutex); g_chestList.clear(); }
+                ClearScanLists121();
                 { LockGuard lk3(g_bgCamMutex); g_bgCamState = BgCamState(); }
             }
         } else {
+            inWorldNow = false;
             if (g_nametagSuppressionActive_121 || !g_modifiedTeamVisibility_121.empty() || !g_lcHideTagsMembers_121.empty()) {
                 ResetNametagSuppressionCaches121(env, "jni-not-ready");
             }
             ReleaseSpeedBridgeSneak121(env);
             ResetSpeedBridgeMovementTracking121();
-            { LockGuard lk(g_playerListMutex); g_playerList.clear(); }
-            { LockGuard lk2(g_chestListMutex); g_chestList.clear(); }
+            ClearScanLists121();
             { LockGuard lk3(g_bgCamMutex); g_bgCamState = BgCamState(); }
         }
-        Sleep(cfg.aimAssist ? 5 : 50); // very fast poll for aim assist
+    }));
+
+    // Ghost-safe writes; each keeps running one pass after being switched off
+    // so it can restore what it changed.
+    const int reachTask = sched.Add("reach", 50, 2, 1000, Accounted("reach", 200, [&]() {
+        static bool s_reachWasEnabled = false;
+        const Config& cfg = *cfgRef;
+        if (!g_stateJniReady || !inWorldNow || !ResolveReady121(RES_REACH)) return;
+        if (cfg.reachEnabled || s_reachWasEnabled) {
+            UpdateReach(env, cfg);
+            s_reachWasEnabled = cfg.reachEnabled;
+        }
+    }));
+    const int velocityTask = sched.Add("velocity", 50, 2, 1000, Accounted("velocity", 200, [&]() {
+        static bool s_velocityWasEnabled = false;
+        const Config& cfg = *cfgRef;
+        if (!g_stateJniReady || !inWorldNow || !ResolveReady121(RES_VELOCITY)) return;
+        if (cfg.velocityEnabled || s_velocityWasEnabled) {
+            UpdateVelocity(env, cfg);
+            s_velocityWasEnabled = cfg.velocityEnabled;
+        }
+    }));
+    const int speedBridgeTask = sched.Add("speedBridge", 50, 2, 1000, Accounted("speedBridge", 300, [&]() {
+        static bool s_speedBridgeWasEnabled = false;
+        const Config& cfg = *cfgRef;
+        if (!g_stateJniReady || !inWorldNow) return;
+        if (cfg.speedBridge || s_speedBridgeWasEnabled || g_speedBridgeManagingSneak_121) {
+            UpdateSpeedBridge(env, cfg, inWorldNow);
+            s_speedBridgeWasEnabled = cfg.speedBridge;
+        }
+    }));
+    const int autoTotemTask = sched.Add("autoTotem", 50, 3, 2000, Accounted("autoTotem", 600, [&]() {
+        static bool s_autoTotemWasEnabled = false;
+        const Config& cfg = *cfgRef;
+        if (!g_stateJniReady || !inWorldNow || !ResolveReady121(RES_AUTO_TOTEM)) return;
+        if (cfg.autoTotemEnabled || s_autoTotemWasEnabled) {
+            UpdateAutoTotem(env, cfg);
+            s_autoTotemWasEnabled = cfg.autoTotemEnabled;
+        }
+    }));
+    const int closestPlayerTask = sched.Add("closestPlayer", 100, 4, 2000, Accounted("closestPlayer", 1500, [&]() {
+        if (!g_stateJniReady || !inWorldNow || !cfgRef->closestPlayer || !ResolveReady121(RES_CLOSEST_PLAYER)) return;
+        UpdateClosestPlayerOverlay(env);
+    }));
+    const int playerListTask = sched.Add("playerList", kPlayerListTickMs, 3, 4000, Accounted("playerList", 4000, [&]() {
+        const Config& cfg = *cfgRef;
+        if (!g_stateJniReady || !inWorldNow) return;
+        const bool overlays = (cfg.nametags && ResolveReady121(RES_NAMETAGS))
+            || (cfg.closestPlayer && ResolveReady121(RES_CLOSEST_PLAYER));
+        if (overlays || cfg.aimAssist || cfg.nametagHideVanilla || g_nametagSuppressionActive_121)
+            UpdatePlayerListOverlay(env);
+    }));
+    const int chestEspTask = sched.Add("chestEsp", 100, 5, 8000, Accounted("chestEsp", 10000, [&]() {
+        if (!g_stateJniReady || !inWorldNow || !cfgRef->chestEsp || !ResolveReady121(RES_CHEST_ESP)) return;
+        UpdateChestList(env);
+    }));
+
+    // Module lookups for whatever was just switched on, one group per run;
+    // the module's task runs as soon as its group is ready.  Needs only the
+    // core mappings, not a world, except velocity which waits for the player.
+    const int resolveTargets[kResolveGroupCount121] = {
+        reachTask, velocityTask, autoTotemTask, chestEspTask, playerListTask, closestPlayerTask
+    };
+    const int resolveTask = sched.Add("resolve", 50, 6, 0, Accounted("resolve", 0, [&]() {
+        if (!g_stateJniReady || !g_gameClassLoader || !g_mcInstance) return;
+        const Config& cfg = *cfgRef;
+        for (int g = 0; g < kResolveGroupCount121; g++) {
+            LONG state = g_resolveState121[g];
+            if (state == kResolveReady121 || state == kResolveFailed121 || !ResolveWanted121(cfg, g)) continue;
+            SetResolveState121(g, kResolveResolving121);
+            LONG result = ResolveGroup121(env, g);
+            SetResolveState121(g, result);
+            if (result == kResolveResolving121) continue;
+            if (result == kResolveReady121) sched.RunSoon(resolveTargets[g]);
+            Log(std::string("Module mappings: ") + kResolveModule121[g] + " " + kResolveStateName121[result]);
+            return;
+        }
+    }));
+    const int perTickTasks[] = { worldTask, reachTask, velocityTask, speedBridgeTask, autoTotemTask };   // follow the aim-assist rate
+
+    // Tasks each CFG_* group drives; a config change runs just those now
+    // instead of leaving the switch to wait out their period.
+    struct ConfigWake { unsigned modules; int task; };
+    const ConfigWake configWakes[] = {
+        { CFG_REACH,                    reachTask },
+        { CFG_VELOCITY,                 velocityTask },
+        { CFG_SPEED_BRIDGE,             speedBridgeTask },
+        { CFG_AUTO_TOTEM,               autoTotemTask },
+        { CFG_NAMETAGS | CFG_AIM,       playerListTask },
+        { CFG_NAMETAGS,                 closestPlayerTask },
+        { CFG_CHEST_ESP,                chestEspTask },
+        { CFG_REACH | CFG_VELOCITY | CFG_AUTO_TOTEM | CFG_CHEST_ESP | CFG_NAMETAGS, resolveTask },
+        { CFG_MAPPINGS,                 remapTask },
+    };
+
+    // Overlay-only tasks give way when the game runs short of frame time.
+    // The player list also feeds aim assist / triggerbot (and carries the
+    // nametag suppression pass); with either on it stays pinned.
+    lc::ScanGovernor governor(sched);
+    governor.Manage(closestPlayerTask, 100, 500);
+    governor.Manage(chestEspTask, 100, 800);
+    governor.Manage(playerListTask, kPlayerListTickMs, 4 * kPlayerListTickMs);
+
+    // LC_JNI_RECORD=1 records every task's JNI traffic from the first pass in a
+    // world, for tests/jni_replay, until the time or size cap is reached.
+    const DWORD kJniRecordMs = 30000;
+    const unsigned long kJniRecordBytes = 64UL << 20;
+    char recordEnv[16] = {};
+    bool jniRecordPending = GetEnvironmentVariableA("LC_JNI_RECORD", recordEnv, sizeof(recordEnv)) > 0
+        && (recordEnv[0] == '1' || recordEnv[0] == 'y' || recordEnv[0] == 'Y'
+            || recordEnv[0] == 't' || recordEnv[0] == 'T');
+    DWORD jniRecordStartMs = 0;
+
+    static AsyncLog::RateGate s_statsGate;
+#if LC_SYNTHETIC_LOAD
+    static AsyncLog::RateGate s_syntheticGate;
+#endif
+    while (g_running) {
+        if (jniRecordPending && inWorldNow) {
+            jniRecordPending = false;
+            std::string recordPath = GetBridgeDir() + "\\bridge_261_scan.lcjr";
+            if (JniReplay::StartRecording(recordPath, kJniRecordBytes)) {
+                jniRecordStartMs = GetTickCount();
+                if (!jniRecordStartMs) jniRecordStartMs = 1;
+                Log("JNI recording started: " + recordPath);
+            } else {
+                Log("WARNING: cannot create JNI recording " + recordPath);
+            }
+        }
+        if (jniRecordStartMs && (!JniReplay::Recording() || GetTickCount() - jniRecordStartMs >= kJniRecordMs)) {
+            JniReplay::StopRecording();
+            Log("JNI recording stopped after " + std::to_string(JniReplay::RecordedCalls()) + " calls.");
+            jniRecordStartMs = 0;
+        }
+
+        // ParseConfig publishes before it sets the mask, so a group taken
+        // here is never ahead of cfgRef.
+        g_config.Refresh(cfgRef);
+        const unsigned configChanged = (unsigned)InterlockedExchange(&g_configChangedModules, 0);
+        if (configChanged & CFG_AIM) {
+            const Config& cfg = *cfgRef;
+            DWORD tickMs = cfg.aimAssist ? 5 : 50;   // very fast poll for aim assist
+            for (size_t i = 0; i < sizeof(perTickTasks) / sizeof(perTickTasks[0]); i++)
+                sched.SetPeriod(perTickTasks[i], tickMs);
+            if (cfg.aimAssist || cfg.triggerbot) governor.SetBase(playerListTask, kPlayerListAimMs, kPlayerListAimMs);
+            else                                 governor.SetBase(playerListTask, kPlayerListTickMs, 4 * kPlayerListTickMs);
+        }
+        for (size_t i = 0; i < sizeof(configWakes) / sizeof(configWakes[0]); i++) {
+            if (configChanged & configWakes[i].modules) sched.RunSoon(configWakes[i].task);
+        }
+
+        DWORD idleMs = sched.RunDue();
+        if (governor.Update()) Log("Scan governor: " + governor.Describe());
+
+        if (AsyncLog::Allow(s_statsGate, 30000)) {
+            Log("ScanThread tasks: " + sched.FormatStats());
+            Log("ScanThread governor: " + governor.Describe());
+            Log("ScanThread players: " + FormatPlayerTableStats121());
+            g_playerTableStats121 = PlayerTableStats121();
+            Log("ScanThread JNI: " + JniAccounting::FormatStats());
+            Log("ScanThread refs: " + RefLedger::FormatLive());
+            if (g_nametagSyncStats121.passes) {
+                const NametagSyncStats121& nt = g_nametagSyncStats121;
+                Log("ScanThread nametag hide: " + std::to_string(nt.passes) + " passes, " + std::to_string(nt.joins) +
+                    " joins, " + std::to_string(nt.leaves) + " leaves, " + std::to_string(nt.resyncs) + " resyncs, " +
+                    std::to_string(nt.helperCalls) + " helper calls");
+                g_nametagSyncStats121 = NametagSyncStats121();
+            }
+            Log("ScanThread speedBridge grid: " + std::to_string(g_speedBridgeGrid_121.Hits()) + " hits, " +
+                std::to_string(g_speedBridgeGrid_121.Misses()) + " misses, " +
+                std::to_string(g_speedBridgeGrid_121.Refreshes()) + " refreshes");
+            if (g_invSnapshot121.refreshes || g_invSnapshot121.reuses)
+                Log("ScanThread autoTotem inventory: " + std::to_string(g_invSnapshot121.refreshes) + " reads (" +
+                    std::to_string(g_invSnapshot121.helperRefreshes) + " via helper), " +
+                    std::to_string(g_invSnapshot121.reuses) + " served from the snapshot");
+            sched.ResetStats();
+            JniAccounting::ResetStats();
+        }
+#if LC_SYNTHETIC_LOAD
+        if (SyntheticLoad::Active() && AsyncLog::Allow(s_syntheticGate, 5000))
+            Log("SyntheticLoad: " + SyntheticLoad::FormatAndReset(GetTickCount()));
+#endif
+        Sleep(idleMs ? idleMs : 1);
     }
+    JniReplay::StopRecording();
     ReleaseSpeedBridgeSneak121(env);
     ResetSpeedBridgeMovementTracking121();
     g_jvm->DetachCurrentThread();
@@ -8634,11 +9804,67 @@ static DWORD WINAPI ChestScanThreadProc(LPVOID) {
 }
 
 // ===================== HOOKED SwapBuffers =====================
+// Draws this frame on the shared overlay context (LC_OVERLAY_SHARED_CONTEXT).
+// If a context switch fails the shared context is dropped for the session and
+// the backend is reset, so it is rebuilt on the game context with the usual
+// state save/restore a few frames later.
+static void RenderDrawDataOnSharedContext(HDC hDc) {
+    if (OverlayContext::Begin(hDc)) {
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        if (OverlayContext::End(hDc)) return;
+        wglMakeCurrent(hDc, OverlayContext::GameContext());
+    }
+    Log("WARNING: shared overlay GL context failed to switch; falling back to the game context.");
+    g_overlayContextFailed = true;
+    g_imguiPendingBackendReset = true;
+    g_imguiPendingGlrc = wglGetCurrentContext();
+    g_imguiWarmupFrames = 3;
+}
+
+// Draws the current ImDrawData and finishes the frame's profile.
+static void SubmitOverlayFrame(HDC hDc) {
+    // Avoid driver issues when minimized / zero-sized backbuffer.
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.DisplaySize.x > 1.0f && io.DisplaySize.y > 1.0f) {
+        if (OverlayContext::Active()) RenderDrawDataOnSharedContext(hDc);
+        else ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+    FrameProfiler::EndPhase(FrameProfiler::kStateRestore);
+
+    // Flush all ImGui GL commands before handing control back to the NVIDIA driver's
+    // swap implementation.  Without this, pending draw calls may reference ImGui GL
+    // objects that the driver hasn't seen yet, causing an EXCEPTION_ACCESS_VIOLATION
+    // inside nvoglv64.dll.
+    glFlush();
+    FrameProfiler::EndPhase(FrameProfiler::kFlush);
+    FrameProfiler::EndFrame();
+
+    static AsyncLog::RateGate s_frameStatsGate;
+    if (AsyncLog::Allow(s_frameStatsGate, 30000)) {
+        std::string frameStats = FrameProfiler::FormatStats();
+        if (!frameStats.empty()) Log("Frame cost: " + frameStats + " replayed="
+                                     + std::to_string(g_overlayPacer.Replayed()));
+    }
+}
+
+// False when no overlay layer would draw anything this frame; the hook then
+// leaves ImGui and GL alone entirely.  Mirrors the render conditions below
+// loosely: a layer that might draw counts as work.
+static bool OverlayHasWork(const Config& cfg) {
+    if (DebugPanel::EnabledFromEnvironment()) return true;
+    if (g_ShowMenu) return true;
+    bool inWorld = false;
+    { LockGuard lk(g_jniStateMtx); inWorld = g_jniInWorld; }
+    if (!inWorld) return false;
+    return cfg.showModuleList || cfg.gtbHelper || cfg.closestPlayer || cfg.nametags || cfg.chestEsp;
+}
+
 // Frame counter: skip first few frames after GL backend init to let driver stabilize.
 // Two-phase init: phase 1 = ImGui context + Win32 (no GL), phase 2 = GL backend (deferred).
 
 BOOL WINAPI hwglSwapBuffers(HDC hDc) {
     TRACE261_PATH("enter");
+    FrameProfiler::BeginFrame();
     bool hasHdc = TRACE261_IF("hasHdc", hDc != nullptr);
     if (!hasHdc) return o_wglSwapBuffers(hDc);
 
@@ -8659,12 +9885,17 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
     bool isGlfwGameWindow = TRACE261_IF("isGlfwGameWindow", strcmp(cls, "GLFW30") == 0);
     if (!isGlfwGameWindow)
         return o_wglSwapBuffers(hDc);
+    InterlockedIncrement(&g_swapFrameSeq121);
+    if (g_swapFrameEvent121) SetEvent(g_swapFrameEvent121);
+    FrameProfiler::EndPhase(FrameProfiler::kValidate);
 
     // ── Phase 1: ImGui context + Win32 backend (NO OpenGL calls at all) ──
     // Runs on the very first GLFW swap call.  We must not touch GL here so the
     // NVIDIA driver's internal swap-chain state is completely undisturbed.
     if (!g_imguiPhase1Done) {
         TRACE261_PATH("imgui-phase1-init");
+        InterlockedCompareExchange(&g_firstSwapTickMs, (LONG)GetTickCount(), 0);
+        if (g_firstSwapEvent) SetEvent(g_firstSwapEvent);
         g_hwnd = window;
         g_imguiGlrc = currentRc;
 
@@ -8674,19 +9905,7 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
         io.IniFilename = nullptr;
 
         // DPI-aware font config (no GL – just configures atlas data)
-        float dpiScale = 1.0f;
-        {
-            UINT dpi = 96;
-            HMODULE hUser32 = GetModuleHandleA("user32.dll");
-            if (hUser32) {
-                typedef UINT (WINAPI* FnGetDpiForWindow)(HWND);
-                auto fn = (FnGetDpiForWindow)GetProcAddress(hUser32, "GetDpiForWindow");
-                if (fn) dpi = fn(g_hwnd);
-            }
-            dpiScale = (dpi > 0) ? ((float)dpi / 96.0f) : 1.0f;
-            if (dpiScale < 0.75f) dpiScale = 0.75f;
-            if (dpiScale > 2.5f) dpiScale = 2.5f;
-        }
+        float dpiScale = OverlayFont::DpiScale(g_hwnd);
         io.Fonts->Clear();
         ImFontConfig fontCfg;
         fontCfg.RasterizerDensity = 1.0f;
@@ -8694,29 +9913,10 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
         fontCfg.OversampleH = 3;
         fontCfg.OversampleV = 2;
         fontCfg.PixelSnapH = true;
-        ImFont* loadedFont = nullptr;
-        std::string bridgeDir = GetBridgeDir();
-        std::vector<std::string> fontCandidates = {
-            bridgeDir + "\\minecraftia.ttf",
-            bridgeDir + "\\Minecraftia.ttf",
-            bridgeDir + "\\Data\\minecraftia.ttf",
-            bridgeDir + "\\Data\\Minecraftia.ttf",
-            "C:\\Windows\\Fonts\\minecraftia.ttf",
-            "C:\\Windows\\Fonts\\Minecraftia.ttf"
-        };
-
-        for (const auto& fontPath : fontCandidates) {
-            if (!FileExistsA(fontPath)) continue;
-            if (!IsLikelyFontBinary(fontPath)) {
-                Log("Skipping invalid font file (not binary TTF/OTF): " + fontPath);
-                continue;
-            }
-            loadedFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), fontCfg.SizePixels, &fontCfg);
-            if (loadedFont) {
-                Log("Loaded ImGui font: " + fontPath);
-                break;
-            }
-        }
+        // Bytes were read off-thread at injection (OverlayFont::Prefetch).
+        std::string fontPath;
+        ImFont* loadedFont = OverlayFont::AddPrefetched(io.Fonts, fontCfg, GetBridgeDir(), &fontPath);
+        if (loadedFont) Log("Loaded ImGui font: " + fontPath);
 
         if (!loadedFont) {
             io.Fonts->AddFontDefault(&fontCfg);
@@ -8725,9 +9925,12 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
         io.FontGlobalScale = 1.0f;
         ImGuiStyle& st = ImGui::GetStyle();
         st.ScaleAllSizes(dpiScale);
+        OverlayFont::BeginContext(dpiScale);
 
         ImGui_ImplWin32_InitForOpenGL(g_hwnd);
         o_WndProc = (WNDPROC)SetWindowLongPtr(g_hwnd, GWLP_WNDPROC, (LONG_PTR)hkWndProc);
+        if (FrameProfiler::StartCsvFromEnvironment(GetBridgeDir() + "\\bridge_261_frames.csv"))
+            Log("Frame profiler: writing per-frame CSV.");
 
         g_imguiPhase1Done = true;
         g_imguiWarmupFrames = 3; // let 3 clean frames pass before touching GL
@@ -8761,6 +9964,10 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
         ImGui_ImplOpenGL3_SetSkipGLDeletes(true);
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplOpenGL3_SetSkipGLDeletes(false);
+        OverlayContext::Destroy();
+        ImGui_ImplOpenGL3_SetSkipStateBackup(false);
+        g_moduleListLayer.Invalidate();
+        g_overlayPacer.Invalidate();
 
         g_imguiGlBackendReady = false;
         g_imguiInitialized = false;
@@ -8783,49 +9990,70 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
             glModernLoadedLogged = true;
         }
 
-        // ImGui init can touch GL bindings. Backup/restore the critical state so we don't
-        // leave Minecraft/Lunar in a weird state for the next frame.
-        GLint last_program = 0;
-        GLint last_active_texture = 0;
-        GLint last_texture_2d = 0;
-        GLint last_array_buffer = 0;
-        GLint last_element_array_buffer = 0;
-        GLint last_vertex_array = 0;
-    #ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
-        GLint last_pixel_unpack_buffer = 0;
-    #endif
-
-        glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
-        glGetIntegerv(GL_ACTIVE_TEXTURE, &last_active_texture);
-        glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture_2d);
-        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
-        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-    #ifdef GL_VERTEX_ARRAY_BINDING
-        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
-    #endif
-    #ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
-        glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer);
-    #endif
-
-        ImGui_ImplOpenGL3_Init("#version 330 core");
-
-        if (glUseProgram_)
-            glUseProgram_((GLuint)last_program);
-        if (glActiveTexture_)
-            glActiveTexture_((GLenum)last_active_texture);
-        glBindTexture(GL_TEXTURE_2D, (GLuint)last_texture_2d);
-        if (glBindBuffer_) {
-            glBindBuffer_(GL_ARRAY_BUFFER, (GLuint)last_array_buffer);
-            glBindBuffer_(GL_ELEMENT_ARRAY_BUFFER, (GLuint)last_element_array_buffer);
-        }
-    #ifdef GL_VERTEX_ARRAY_BINDING
-        if (glBindVertexArray_)
-            glBindVertexArray_((GLuint)last_vertex_array);
-    #endif
-    #ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
-        if (glBindBuffer_)
-            glBindBuffer_(GL_PIXEL_UNPACK_BUFFER, (GLuint)last_pixel_unpack_buffer);
-    #endif
+        // Optional: initialise the backend on a bridge-owned context that shares
+        // objects with the game's, so frames can skip the GL state save/restore.
+        bool sharedContext = false;
+        if (OverlayContext::EnabledFromEnvironment() && !g_overlayContextFailed) {
+            sharedContext = OverlayContext::Create(hDc, currentRc, true) && OverlayContext::Begin(hDc);
+            if (sharedContext) {
+                ImGui_ImplOpenGL3_Init("#version 330 core");
+                ImGui_ImplOpenGL3_SetPhaseCallback(FrameProfiler::GlBackendMark);
+                ImGui_ImplOpenGL3_SetSkipStateBackup(true);
+                if (!OverlayContext::End(hDc)) wglMakeCurrent(hDc, currentRc);
+                Log("ImGui: overlay renders on a shared GL context.");
+            } else {
+                OverlayContext::Destroy();
+                g_overlayContextFailed = true;
+                Log("ImGui: shared overlay GL context unavailable; drawing on the game context.");
+            }
+        }
+
+        if (!sharedContext) {
+            // ImGui init can touch GL bindings. Backup/restore the critical state so we don't
+            // leave Minecraft/Lunar in a weird state for the next frame.
+            GLint last_program = 0;
+            GLint last_active_texture = 0;
+            GLint last_texture_2d = 0;
+            GLint last_array_buffer = 0;
+            GLint last_element_array_buffer = 0;
+            GLint last_vertex_array = 0;
+        #ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
+            GLint last_pixel_unpack_buffer = 0;
+        #endif
+
+            glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+            glGetIntegerv(GL_ACTIVE_TEXTURE, &last_active_texture);
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture_2d);
+            glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+            glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
+        #ifdef GL_VERTEX_ARRAY_BINDING
+            glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+        #endif
+        #ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
+            glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer);
+        #endif
+
+            ImGui_ImplOpenGL3_Init("#version 330 core");
+            ImGui_ImplOpenGL3_SetPhaseCallback(FrameProfiler::GlBackendMark);
+
+            if (glUseProgram_)
+                glUseProgram_((GLuint)last_program);
+            if (glActiveTexture_)
+                glActiveTexture_((GLenum)last_active_texture);
+            glBindTexture(GL_TEXTURE_2D, (GLuint)last_texture_2d);
+            if (glBindBuffer_) {
+                glBindBuffer_(GL_ARRAY_BUFFER, (GLuint)last_array_buffer);
+                glBindBuffer_(GL_ELEMENT_ARRAY_BUFFER, (GLuint)last_element_array_buffer);
+            }
+        #ifdef GL_VERTEX_ARRAY_BINDING
+            if (glBindVertexArray_)
+                glBindVertexArray_((GLuint)last_vertex_array);
+        #endif
+        #ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
+            if (glBindBuffer_)
+                glBindBuffer_(GL_PIXEL_UNPACK_BUFFER, (GLuint)last_pixel_unpack_buffer);
+        #endif
+        }
 
         g_imguiGlBackendReady = true;
         g_imguiInitialized = true;
@@ -8854,7 +10082,37 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
     // Update inventory detection
     UpdateRealGuiState();
 
+    {
+        ConfigRef cfgRef = g_config.Acquire();
+        // Idle: nothing to show, so no NewFrame and no GL work at all.
+        if (!OverlayHasWork(*cfgRef)) {
+            TRACE261_PATH("overlay-idle-bypass");
+            g_overlayPacer.Invalidate();
+            return o_wglSwapBuffers(hDc);
+        }
+        // Between paced rebuilds, submit the previous frame's draw data again.
+        RECT client{};
+        int clientW = 0, clientH = 0;
+        if (GetClientRect(window, &client)) {
+            clientW = client.right - client.left;
+            clientH = client.bottom - client.top;
+        }
+        if (g_overlayPacer.CanReplay(cfgRef->overlayUpdateHz, clientW, clientH)) {
+            TRACE261_PATH("overlay-paced-replay");
+            g_overlayPacer.MarkReplayed();
+            FrameProfiler::EndPhase(FrameProfiler::kPrepare);
+            FrameProfiler::EndPhase(FrameProfiler::kBuild);
+            SubmitOverlayFrame(hDc);
+            return o_wglSwapBuffers(hDc);
+        }
+        g_overlayPacer.MarkBuilt(clientW, clientH);
+    }
+
     // Render ImGui
+    float newDpiScale = 0.0f;
+    if (OverlayFont::UpdateDpi(g_hwnd, &newDpiScale))
+        Log("Overlay DPI scale changed to " + std::to_string(newDpiScale) + "; glyphs re-bake lazily.");
+    FrameProfiler::EndPhase(FrameProfiler::kPrepare);
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplWin32_NewFrame();
     ImGui::NewFrame();
@@ -8863,8 +10121,8 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
 
     // Render overlay text for closest player (when enabled and menu closed)
     {
-        Config cfg;
-        { LockGuard lk(g_configMutex); cfg = g_config; }
+        ConfigRef cfgRef = g_config.Acquire();
+        const Config& cfg = *cfgRef;
         OverlayTheme overlayTheme = ResolveOverlayTheme(cfg.guiTheme);
         bool inWorld = false;
         { LockGuard lk(g_jniStateMtx); inWorld = g_jniInWorld; }
@@ -8885,9 +10143,9 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
             BgCamState cpCamState;
             { LockGuard lk(g_bgCamMutex); cpCamState = g_bgCamState; }
 
-            // Snapshot player list under lock (background thread updates it concurrently).
-            std::vector<PlayerData121> playerSnap;
-            { LockGuard lk(g_playerListMutex); playerSnap = g_playerList; }
+            // Hold the published player list (background thread publishes new ones concurrently).
+            PlayerListRef playerSnapRef = g_playerList.Acquire();
+            const std::vector<PlayerData121>& playerSnap = *playerSnapRef;
 
             // ── Closest Player: styled HUD box above hotbar ───
             bool renderClosestPlayer = TRACE261_IF("renderClosestPlayer", (cfg.closestPlayer && !playerSnap.empty()));
@@ -8907,14 +10165,10 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
 
                 bool dirResolved = false;
                 if (cpCamState.camFound) {
-                    LegoVec3 camPos = { cpCamState.camX, cpCamState.camY, cpCamState.camZ };
-                    LegoVec3 targetPos = { cp.ex, cp.ey + 1.2, cp.ez };
                     float sx = 0.0f, sy = 0.0f;
-                    bool projected = cpCamState.matsOk
-                        ? WorldToScreen(targetPos, camPos, cpCamState.view, cpCamState.proj,
-                                        (int)io.DisplaySize.x, (int)io.DisplaySize.y, &sx, &sy)
-                        : WorldToScreen_Angles(targetPos, camPos, cpCamState.yaw, cpCamState.pitch, cpCamState.fov,
-                                               (int)io.DisplaySize.x, (int)io.DisplaySize.y, &sx, &sy);
+                    bool projected = Projection::ProjectPoint(cpCamState.projection,
+                                                              (int)io.DisplaySize.x, (int)io.DisplaySize.y,
+                                                              cp.ex, cp.ey + 1.2, cp.ez, &sx, &sy);
 
                     if (projected) {
                         float dxScreen = sx - (io.DisplaySize.x * 0.5f);
@@ -9012,8 +10266,9 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
             LegoVec3 sharedCam = {0,0,0};
             float sharedYaw = 0.0f, sharedPitch = 0.0f;
             bool sharedCamFound = false;
-            Matrix4x4 sharedProj = {}, sharedView = {};
             bool sharedMatsOk = false;
+            Projection::Camera sharedProjection = {};
+            unsigned long sharedCamSeq = 0;
 
             if (cfg.nametags || cfg.chestEsp) {
                 BgCamState cs;
@@ -9022,19 +10277,19 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
                 sharedYaw      = cs.yaw;
                 sharedPitch    = cs.pitch;
                 sharedCamFound = cs.camFound;
-                sharedProj     = cs.proj;
-                sharedView     = cs.view;
                 sharedMatsOk   = cs.matsOk;
+                sharedProjection = cs.projection;
+                sharedCamSeq   = cs.seq;
             }
 
             const DWORD overlayNowMs = GetTickCount();
             const float overlaySmoothAlpha = (std::max)(0.15f, (std::min)(0.65f, io.DeltaTime * 14.0f));
-            struct SmoothedPoint { std::string key; float sx, sy; DWORD lastSeenMs; };
+            struct SmoothedPoint { float sx, sy; };
             struct SmoothedRect  { std::string key; float minSX, minSY, maxSX, maxSY; DWORD lastSeenMs; };
-            static std::vector<SmoothedPoint> s_nametagSmooth;
+            // Indexed by the players' g_playerTable121 handles.
+            static lc::SlotTable<SmoothedPoint, 128> s_nametagSmooth;
             static std::vector<SmoothedRect>  s_chestSmooth;
-            s_nametagSmooth.erase(std::remove_if(s_nametagSmooth.begin(), s_nametagSmooth.end(),
-                [&](const SmoothedPoint& p) { return (overlayNowMs - p.lastSeenMs) > 1200; }), s_nametagSmooth.end());
+            s_nametagSmooth.Expire(overlayNowMs, 1200);
             s_chestSmooth.erase(std::remove_if(s_chestSmooth.begin(), s_chestSmooth.end(),
                 [&](const SmoothedRect& r) { return (overlayNowMs - r.lastSeenMs) > 1200; }), s_chestSmooth.end());
 
@@ -9043,61 +10298,80 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
             // ── Nametags: no JNI on render thread, all data from background-thread snapshots ──
             bool renderNametags = TRACE261_IF("renderNametags", (!g_realGuiOpen && cfg.nametags && sharedCamFound));
             if (renderNametags) {
+                LC_SYNTH_STAGE(synthTags, SyntheticLoad::kNametags);
+                LC_SYNTH_ITEMS(synthTags, playerSnap.size());
                 drawnTags = 0;
                 const int nametagRenderCap = (std::max)(1, (std::min)(20, cfg.nametagMaxCount));
 
                 if (!playerSnap.empty()) {
-                    const LegoVec3  cam      = sharedCam;
-                    const float     yaw      = sharedYaw;
-                    const float     pitch    = sharedPitch;
-                    const Matrix4x4 projMat  = sharedProj;
-                    const Matrix4x4 viewMat  = sharedView;
-                    const bool      matsOk   = sharedMatsOk;
-                    const float fov  = cpCamState.fov;
                     const int   winW = (int)io.DisplaySize.x;
                     const int   winH = (int)io.DisplaySize.y;
+                    TRACE261_BRANCH("nametagUseMatrices", sharedMatsOk);
+
+                    // Each player at this frame's QPC time, between the last two
+                    // positions the scan saw, is culled against the view frustum
+                    // (body plus tag, padded for the label width); the nearest
+                    // nametagRenderCap survivors have their head centres
+                    // projected in one batch.  Kept while the camera, the
+                    // snapshot and the cap are unchanged and every player has
+                    // come to rest on its newest position.
+                    struct TagCandidate { double dist; size_t index; };
+                    static std::vector<TagCandidate> s_tagPick;
+                    static Projection::Points   s_headPts;
+                    static Projection::Screen   s_headScreen;
+                    static Projection::BatchKey s_headKey = {};
+                    static bool s_headMoving = false;
+                    static int  s_headCap = 0;
+                    if (s_headMoving || s_headCap != nametagRenderCap) s_headKey.Invalidate();
+                    if (!s_headKey.Reuse(sharedCamSeq, playerSnapRef.Version(), (int)playerSnap.size(), winW, winH)) {
+                        const LONGLONG frameQpc = lc::QpcNow();
+                        const LONGLONG maxSpan = lc::QpcFromMs(4 * kPlayerListTickMs);
+                        Frustum::Planes frustum;
+                        Frustum::FromCamera(frustum, sharedProjection, winW, winH);
+                        s_headCap = nametagRenderCap;
+                        s_headMoving = false;
+                        s_tagPick.clear();
+                        s_headPts.Clear();
+                        for (size_t ti = 0; ti < playerSnap.size(); ti++) {
+                            const auto& it = playerSnap[ti];
+                            if (LooksLikeFakePlayerLine(it.name)) continue;
+                            double ix, iy, iz;
+                            if (it.motion.Sample(frameQpc, maxSpan, &ix, &iy, &iz) < 1.0) s_headMoving = true;
+                            if (!Frustum::BoxVisible(frustum, ix - 0.6, iy, iz - 0.6, ix + 0.6, iy + 2.6, iz + 0.6)) continue;
+                            TagCandidate c = { it.dist, ti };
+                            s_tagPick.push_back(c);
+                        }
+                        s_tagPick.resize(Frustum::SelectNearest(s_tagPick, (size_t)nametagRenderCap,
+                            [](const TagCandidate& a, const TagCandidate& b) { return a.dist < b.dist; }));
+                        for (const auto& c : s_tagPick) {
+                            double ix, iy, iz;
+                            playerSnap[c.index].motion.Sample(frameQpc, maxSpan, &ix, &iy, &iz);
+                            s_headPts.Push(ix, iy + 1.9, iz);
+                        }
+                        LC_SYNTH_STAGE(synthProject, SyntheticLoad::kProjection);
+                        LC_SYNTH_ITEMS(synthProject, s_headPts.Size());
+                        Projection::Project(sharedProjection, winW, winH, s_headPts, s_headScreen);
+                    }
 
-                    for (const auto& it : playerSnap) {
+                    for (size_t pi = 0; pi < s_tagPick.size(); pi++) {
+                        const auto& it = playerSnap[s_tagPick[pi].index];
                         if (drawnTags >= nametagRenderCap) break;
-                        if (LooksLikeFakePlayerLine(it.name)) continue;
-
-                        // Centre of player's head
-                        const LegoVec3 headPos = { it.ex, it.ey + 1.9, it.ez };
+                        if (!(s_headScreen.flags[pi] & Projection::kInFront)) continue;
 
-                        float sx = 0, sy = 0;
-
-                        bool projected = false;
-                        bool useMatrices = TRACE261_IF("nametagUseMatrices", matsOk);
-                        if (useMatrices) {
-                            projected = WorldToScreen(headPos, cam, viewMat, projMat, winW, winH, &sx, &sy);
-                        } else {
-                            projected = WorldToScreen_Angles(headPos, cam, yaw, pitch, fov, winW, winH, &sx, &sy);
-                        }
-
-                        if (!projected) continue;
+                        float sx = s_headScreen.sx[pi], sy = s_headScreen.sy[pi];
 
                         // Overlay-only smoothing for visual nametags.
                         // Keep telemetry JSON coordinates raw (server loop path) so Aim Assist behavior is unchanged.
-                        std::string nametagKey = it.name;
-                        if (nametagKey.empty()) {
-                            char fallbackKey[96];
-                            snprintf(fallbackKey, sizeof(fallbackKey), "p_%.1f_%.1f_%.1f", it.ex, it.ey, it.ez);
-                            nametagKey = fallbackKey;
-                        }
-                        bool tagSmoothFound = false;
-                        for (auto& sm : s_nametagSmooth) {
-                            if (sm.key == nametagKey) {
-                                sm.sx += (sx - sm.sx) * overlaySmoothAlpha;
-                                sm.sy += (sy - sm.sy) * overlaySmoothAlpha;
-                                sm.lastSeenMs = overlayNowMs;
-                                sx = sm.sx;
-                                sy = sm.sy;
-                                tagSmoothFound = true;
-                                break;
-                            }
-                        }
-                        if (!tagSmoothFound) {
-                            s_nametagSmooth.push_back({ nametagKey, sx, sy, overlayNowMs });
+                        bool tagSmoothFresh = false;
+                        SmoothedPoint& sm = s_nametagSmooth.At(it.slot, overlayNowMs, &tagSmoothFresh);
+                        if (tagSmoothFresh) {
+                            sm.sx = sx;
+                            sm.sy = sy;
+                        } else {
+                            sm.sx += (sx - sm.sx) * overlaySmoothAlpha;
+                            sm.sy += (sy - sm.sy) * overlaySmoothAlpha;
+                            sx = sm.sx;
+                            sy = sm.sy;
                         }
 
                         // Scale text down with distance, keep readable minimum
@@ -9188,25 +10462,25 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
             // ── Chest ESP: draw bounding rect over each nearby chest ──
             bool renderChestEsp = TRACE261_IF("renderChestEsp", (!g_realGuiOpen && cfg.chestEsp && sharedCamFound));
             if (renderChestEsp) {
-                LockGuard chestLk(g_chestListMutex); // protect g_chestList from background scan thread
+                ChestListRef chestRef = g_chestList.Acquire();   // immutable while held
+                const std::vector<ChestData121>& chestList = *chestRef;
+                LC_SYNTH_STAGE(synthEsp, SyntheticLoad::kChestEsp);
+                LC_SYNTH_ITEMS(synthEsp, chestList.size());
                 // Use shared camera data (same source as nametags – no redundant JNI fetch)
                 const LegoVec3   espCam   = sharedCam;
                 const float      espYaw   = sharedYaw;
                 const float      espPitch = sharedPitch;
                 const bool       espMatsOk = sharedMatsOk;
-                const Matrix4x4  espProj  = sharedProj;
-                const Matrix4x4  espView  = sharedView;
 
                 // One-time diagnostic: log projection state on first ESP frame
                 static bool s_espDiagLogged = false;
-                if (!s_espDiagLogged && !g_chestList.empty()) {
+                if (!s_espDiagLogged && !chestList.empty()) {
                     s_espDiagLogged = true;
-                    const auto& ch0 = g_chestList[0];
+                    const auto& ch0 = chestList[0];
                     float csx = 0, csy = 0;
                     LegoVec3 center = { ch0.x, ch0.y + 0.5, ch0.z };
-                    bool ok = espMatsOk
-                        ? WorldToScreen(center, espCam, espView, espProj, (int)io.DisplaySize.x, (int)io.DisplaySize.y, &csx, &csy)
-                        : WorldToScreen_Angles(center, espCam, espYaw, espPitch, cpCamState.fov, (int)io.DisplaySize.x, (int)io.DisplaySize.y, &csx, &csy);
+                    bool ok = Projection::ProjectPoint(sharedProjection, (int)io.DisplaySize.x, (int)io.DisplaySize.y,
+                                                       center.x, center.y, center.z, &csx, &csy);
                     Log(std::string("ChestESP diag: matsOk=") + (espMatsOk?"1":"0")
                         + " yaw=" + std::to_string(espYaw) + " pitch=" + std::to_string(espPitch)
                         + " cam=(" + std::to_string(espCam.x) + "," + std::to_string(espCam.y) + "," + std::to_string(espCam.z) + ")"
@@ -9216,7 +10490,6 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
                 {
                     const int winW = (int)io.DisplaySize.x;
                     const int winH = (int)io.DisplaySize.y;
-                    const float fov = cpCamState.fov;
                     const ImU32 espColor    = IM_COL32(255, 165, 0, 220);  // orange
                     const ImU32 espColorFar = IM_COL32(255, 255, 80, 180); // yellow-ish far
                     const ImU32 espBg       = IM_COL32(0, 0, 0, 90);
@@ -9224,42 +10497,70 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
 
                     constexpr double kChestEspMaxRenderDist = 64.0;
                     const size_t maxChestRenderCount = (size_t)(std::max)(1, (std::min)(20, cfg.chestEspMaxCount));
-                    struct RenderChestCandidate { const ChestData121* chest; double dist; };
-                    std::vector<RenderChestCandidate> renderChests;
-                    renderChests.reserve((std::min)(g_chestList.size(), maxChestRenderCount));
-                    for (const auto& ch : g_chestList) {
-                        double dx = ch.x - espCam.x;
-                        double dy = ch.y - espCam.y;
-                        double dz = ch.z - espCam.z;
-                        double distNow = std::sqrt(dx*dx + dy*dy + dz*dz);
-                        if (distNow > kChestEspMaxRenderDist) continue;
-                        size_t insertAt = 0;
-                        while (insertAt < renderChests.size() && renderChests[insertAt].dist <= distNow) insertAt++;
-                        if (insertAt >= maxChestRenderCount) continue;
-                        renderChests.insert(renderChests.begin() + static_cast<std::vector<RenderChestCandidate>::difference_type>(insertAt), { &ch, distNow });
-                        if (renderChests.size() > maxChestRenderCount) renderChests.pop_back();
+
+                    // A chest occupies one block: x±0.5 (from center), y to y+1, z±0.5.
+                    // Boxes outside the view frustum or range are dropped first; the
+                    // nearest maxChestRenderCount of the rest have all 8 corners
+                    // projected in one batch, and each box's screen AABB comes from
+                    // its in-front corners.
+                    const double offsets[8][3] = {
+                        {-0.5, 0.0, -0.5}, {0.5, 0.0, -0.5}, {-0.5, 0.0, 0.5}, {0.5, 0.0, 0.5},
+                        {-0.5, 1.0, -0.5}, {0.5, 1.0, -0.5}, {-0.5, 1.0, 0.5}, {0.5, 1.0, 0.5}
+                    };
+                    TRACE261_BRANCH("chestEspUseMatrices", espMatsOk);
+                    // The selection is a function of the camera, the chest snapshot and
+                    // the cap, so the projection key covers it too.  Indices stay valid
+                    // while the snapshot version is unchanged.
+                    struct RenderChestCandidate { size_t index; double dist; };
+                    static std::vector<RenderChestCandidate> s_renderChests;
+                    static Projection::Points   s_cornerPts;
+                    static Projection::Screen   s_cornerScreen;
+                    static Projection::BatchKey s_cornerKey = {};
+                    static size_t s_cornerCap = 0;
+                    if (s_cornerCap != maxChestRenderCount) s_cornerKey.Invalidate();
+                    if (!s_cornerKey.Reuse(sharedCamSeq, chestRef.Version(), (int)chestList.size(), winW, winH)) {
+                        Frustum::Planes frustum;
+                        Frustum::FromCamera(frustum, sharedProjection, winW, winH);
+                        s_cornerCap = maxChestRenderCount;
+                        s_renderChests.clear();
+                        for (size_t i = 0; i < chestList.size(); i++) {
+                            const auto& ch = chestList[i];
+                            if (!Frustum::BoxVisible(frustum, ch.x - 0.5, ch.y, ch.z - 0.5, ch.x + 0.5, ch.y + 1.0, ch.z + 0.5))
+                                continue;
+                            double dx = ch.x - espCam.x;
+                            double dy = ch.y - espCam.y;
+                            double dz = ch.z - espCam.z;
+                            double distNow = std::sqrt(dx*dx + dy*dy + dz*dz);
+                            if (distNow > kChestEspMaxRenderDist) continue;
+                            RenderChestCandidate c = { i, distNow };
+                            s_renderChests.push_back(c);
+                        }
+                        s_renderChests.resize(Frustum::SelectNearest(s_renderChests, maxChestRenderCount,
+                            [](const RenderChestCandidate& a, const RenderChestCandidate& b) { return a.dist < b.dist; }));
+
+                        s_cornerPts.Clear();
+                        for (const auto& candidate : s_renderChests) {
+                            const auto& ch = chestList[candidate.index];
+                            for (int c = 0; c < 8; c++)
+                                s_cornerPts.Push(ch.x + offsets[c][0], ch.y + offsets[c][1], ch.z + offsets[c][2]);
+                        }
+                        LC_SYNTH_STAGE(synthProject, SyntheticLoad::kProjection);
+                        LC_SYNTH_ITEMS(synthProject, s_cornerPts.Size());
+                        Projection::Project(sharedProjection, winW, winH, s_cornerPts, s_cornerScreen);
                     }
 
-                    for (const auto& candidate : renderChests) {
-                        const auto& ch = *candidate.chest;
+                    for (size_t ci = 0; ci < s_renderChests.size(); ci++) {
+                        const auto& candidate = s_renderChests[ci];
+                        const auto& ch = chestList[candidate.index];
                         const double chestDist = candidate.dist;
-                        // A chest occupies one block: x±0.5 (from center), y to y+1, z±0.5
-                        // We project 8 corners and find screen AABB
-                        const double offsets[8][3] = {
-                            {-0.5, 0.0, -0.5}, {0.5, 0.0, -0.5}, {-0.5, 0.0, 0.5}, {0.5, 0.0, 0.5},
-                            {-0.5, 1.0, -0.5}, {0.5, 1.0, -0.5}, {-0.5, 1.0, 0.5}, {0.5, 1.0, 0.5}
-                        };
 
                         float minSX = 999999, minSY = 999999, maxSX = -999999, maxSY = -999999;
                         int projectedCorners = 0;
                         for (int c = 0; c < 8; c++) {
-                            LegoVec3 corner = { ch.x + offsets[c][0], ch.y + offsets[c][1], ch.z + offsets[c][2] };
-                            float csx = 0, csy = 0;
-                            bool useMatrices = TRACE261_IF("chestEspUseMatrices", espMatsOk);
-                            bool ok = useMatrices
-                                ? WorldToScreen(corner, espCam, espView, espProj, winW, winH, &csx, &csy)
-                                : WorldToScreen_Angles(corner, espCam, espYaw, espPitch, fov, winW, winH, &csx, &csy);
-                            if (!ok) continue;
+                            const size_t pi = ci * 8 + (size_t)c;
+                            if (!(s_cornerScreen.flags[pi] & Projection::kInFront)) continue;
+                            const float csx = s_cornerScreen.sx[pi];
+                            const float csy = s_cornerScreen.sy[pi];
                             if (csx < minSX) minSX = csx;
                             if (csy < minSY) minSY = csy;
                             if (csx > maxSX) maxSX = csx;
@@ -9393,114 +10694,120 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
 
             bool renderModuleList = TRACE261_IF("renderModuleList", cfg.showModuleList);
             if (renderModuleList) {
-                // Module list (top-right) - original-like (right aligned colored bars)
-                struct ModLine { const char* text; ImU32 accent; float width; };
-                ModLine mods[16];
-                int modCount = 0;
-
-                auto pushMod = [&](const char* text, ImU32 accent) {
-                    if (!text || !*text) return;
-                    ModLine m{ text, accent, ImGui::CalcTextSize(text).x };
-                    mods[modCount++] = m;
-                };
-
-                char acBuf[64];
-                if (cfg.armed) {
-                    int lo = (int)cfg.minCPS;
-                    int hi = (int)cfg.maxCPS;
-                    if (hi < lo) std::swap(hi, lo);
-                    snprintf(acBuf, sizeof(acBuf), "Autoclicker %d-%d", lo, hi);
-                    pushMod(acBuf, overlayTheme.accentPrimary);
-                }
-                if (cfg.clickInChests) pushMod("Click in Chests", overlayTheme.accentTertiary);
-                if (cfg.closestPlayer) pushMod("Closest Player", overlayTheme.accentSecondary);
-                if (cfg.rightClick)    pushMod("Rightclick", overlayTheme.accentTertiary);
-                if (cfg.aimAssist)     pushMod("Aim Assist", overlayTheme.accentPrimary);
-                if (cfg.triggerbot)    pushMod("Triggerbot", overlayTheme.accentSecondary);
-                if (cfg.speedBridge)   pushMod("SpeedBridge", overlayTheme.accentPrimary);
-                if (cfg.chestEsp)      pushMod("Chest ESP", overlayTheme.accentSecondary);
-                if (cfg.nametags)      pushMod("Nametags", overlayTheme.accentPrimary);
-                if (cfg.gtbHelper)     pushMod("GTB Helper", overlayTheme.accentTertiary);
-                if (cfg.jitter)        pushMod("Jitter", overlayTheme.accentSecondary);
-                if (cfg.breakBlocks)   pushMod("Break Blocks", overlayTheme.accentTertiary);
-                if (cfg.reachEnabled)  pushMod("Reach", overlayTheme.accentPrimary);
-                if (cfg.velocityEnabled) pushMod("Velocity", overlayTheme.accentTertiary);
-                if (cfg.autoTotemEnabled) pushMod("AutoTotem", overlayTheme.accentPrimary);
-
-                // Sort by width descending (staggered original look)
-                for (int a = 0; a < modCount; a++) {
-                    for (int b = a + 1; b < modCount; b++) {
-                        if (mods[b].width > mods[a].width) {
-                            ModLine tmp = mods[a]; mods[a] = mods[b]; mods[b] = tmp;
+                // Module list (top-right) - original-like (right aligned colored bars).
+                // Only changes with config/theme, so the geometry is retained.
+                const unsigned long long moduleListKey = ModuleListKey(cfg);
+                if (!g_moduleListLayer.Replay(fg, moduleListKey)) {
+                    g_moduleListLayer.BeginCapture(fg, moduleListKey);
+                    struct ModLine { const char* text; ImU32 accent; float width; };
+                    ModLine mods[16];
+                    int modCount = 0;
+
+                    auto pushMod = [&](const char* text, ImU32 accent) {
+                        if (!text || !*text) return;
+                        ModLine m{ text, accent, ImGui::CalcTextSize(text).x };
+                        mods[modCount++] = m;
+                    };
+
+                    char acBuf[64];
+                    if (cfg.armed) {
+                        int lo = (int)cfg.minCPS;
+                        int hi = (int)cfg.maxCPS;
+                        if (hi < lo) std::swap(hi, lo);
+                        snprintf(acBuf, sizeof(acBuf), "Autoclicker %d-%d", lo, hi);
+                        pushMod(acBuf, overlayTheme.accentPrimary);
+                    }
+                    if (cfg.clickInChests) pushMod("Click in Chests", overlayTheme.accentTertiary);
+                    if (cfg.closestPlayer) pushMod("Closest Player", overlayTheme.accentSecondary);
+                    if (cfg.rightClick)    pushMod("Rightclick", overlayTheme.accentTertiary);
+                    if (cfg.aimAssist)     pushMod("Aim Assist", overlayTheme.accentPrimary);
+                    if (cfg.triggerbot)    pushMod("Triggerbot", overlayTheme.accentSecondary);
+                    if (cfg.speedBridge)   pushMod("SpeedBridge", overlayTheme.accentPrimary);
+                    if (cfg.chestEsp)      pushMod("Chest ESP", overlayTheme.accentSecondary);
+                    if (cfg.nametags)      pushMod("Nametags", overlayTheme.accentPrimary);
+                    if (cfg.gtbHelper)     pushMod("GTB Helper", overlayTheme.accentTertiary);
+                    if (cfg.jitter)        pushMod("Jitter", overlayTheme.accentSecondary);
+                    if (cfg.breakBlocks)   pushMod("Break Blocks", overlayTheme.accentTertiary);
+                    if (cfg.reachEnabled)  pushMod("Reach", overlayTheme.accentPrimary);
+                    if (cfg.velocityEnabled) pushMod("Velocity", overlayTheme.accentTertiary);
+                    if (cfg.autoTotemEnabled) pushMod("AutoTotem", overlayTheme.accentPrimary);
+
+                    // Sort by width descending (staggered original look)
+                    for (int a = 0; a < modCount; a++) {
+                        for (int b = a + 1; b < modCount; b++) {
+                            if (mods[b].width > mods[a].width) {
+                                ModLine tmp = mods[a]; mods[a] = mods[b]; mods[b] = tmp;
+                            }
                         }
                     }
-                }
 
-                const float marginX = 10.0f;
-                float y = 10.0f;
+                    const float marginX = 10.0f;
+                    float y = 10.0f;
                 
-                if (cfg.showLogo) {
-                    const char* logoText = "aoko client";
-                    ImVec2 logoSz = ImGui::CalcTextSize(logoText);
-                    float logoX = io.DisplaySize.x - marginX - logoSz.x;
-                    // Logo Shadow
-                    fg->AddText(ImVec2(logoX + 1, y + 1), overlayTheme.logoShadow, logoText);
-                    fg->AddText(ImVec2(logoX, y), overlayTheme.logoColor, logoText);
-                    y += logoSz.y + 8.0f;
-                }
+                    if (cfg.showLogo) {
+                        const char* logoText = "aoko client";
+                        ImVec2 logoSz = ImGui::CalcTextSize(logoText);
+                        float logoX = io.DisplaySize.x - marginX - logoSz.x;
+                        // Logo Shadow
+                        fg->AddText(ImVec2(logoX + 1, y + 1), overlayTheme.logoShadow, logoText);
+                        fg->AddText(ImVec2(logoX, y), overlayTheme.logoColor, logoText);
+                        y += logoSz.y + 8.0f;
+                    }
 
-                const float padX = 8.0f;
-                const float padY = 3.0f;
-                const float barW = 3.0f;
-                const float gapY = 2.0f;
-                const float fontH = ImGui::GetFontSize();
-                const int style = (std::max)(0, (std::min)(4, cfg.moduleListStyle));
+                    const float padX = 8.0f;
+                    const float padY = 3.0f;
+                    const float barW = 3.0f;
+                    const float gapY = 2.0f;
+                    const float fontH = ImGui::GetFontSize();
+                    const int style = (std::max)(0, (std::min)(4, cfg.moduleListStyle));
                 
-                for (int i = 0; i < modCount; i++) {
-                    const ModLine& m = mods[i];
-                    ImVec2 textSz = ImGui::CalcTextSize(m.text);
-                    float boxW = barW + padX + textSz.x + padX;
-                    float boxH = padY + fontH + padY;
-                    float x0 = io.DisplaySize.x - marginX - boxW;
-                    float x1 = io.DisplaySize.x - marginX;
-                    float y0 = y;
-                    float y1 = y + boxH;
-
-                    if (style == 0) {
-                        fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleBg);
-                        fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x0 + barW, y1), m.accent);
-                        fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleBorder);
-                        ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-                        fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
-                        fg->AddText(tx, overlayTheme.moduleText, m.text);
-                    } else if (style == 1) {
-                        fg->AddRectFilled(ImVec2(x1 - textSz.x - 4, y0), ImVec2(x1, y1), overlayTheme.moduleMinimalBg);
-                        fg->AddRectFilled(ImVec2(x1 - 2, y0), ImVec2(x1, y1), m.accent);
-                        ImVec2 tx = ImVec2(x1 - textSz.x - 2, y0 + padY);
-                        fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
-                        fg->AddText(tx, m.accent, m.text);
-                    } else if (style == 2) {
-                        fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleOutlinedBg);
-                        fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f, 0, 1.5f);
-                        ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-                        fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
-                        fg->AddText(tx, m.accent, m.text);
-                    } else if (style == 3) {
-                        fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleMinimalBg, 4.0f);
-                        fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleGlassBorder, 4.0f, 0, 1.0f);
-                        fg->AddRectFilled(ImVec2(x0 + 1.0f, y0 + 1.0f), ImVec2(x0 + barW + 1.0f, y1 - 1.0f), m.accent);
-                        ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-                        fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
-                        fg->AddText(tx, overlayTheme.moduleText, m.text);
-                    } else {
-                        fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f);
-                        fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleBorder, 4.0f, 0, 1.0f);
-                        ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
-                        fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
-                        fg->AddText(tx, overlayTheme.moduleBoldText, m.text);
-                    }
+                    for (int i = 0; i < modCount; i++) {
+                        const ModLine& m = mods[i];
+                        ImVec2 textSz = ImGui::CalcTextSize(m.text);
+                        float boxW = barW + padX + textSz.x + padX;
+                        float boxH = padY + fontH + padY;
+                        float x0 = io.DisplaySize.x - marginX - boxW;
+                        float x1 = io.DisplaySize.x - marginX;
+                        float y0 = y;
+                        float y1 = y + boxH;
+
+                        if (style == 0) {
+                            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleBg);
+                            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x0 + barW, y1), m.accent);
+                            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleBorder);
+                            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
+                            fg->AddText(tx, overlayTheme.moduleText, m.text);
+                        } else if (style == 1) {
+                            fg->AddRectFilled(ImVec2(x1 - textSz.x - 4, y0), ImVec2(x1, y1), overlayTheme.moduleMinimalBg);
+                            fg->AddRectFilled(ImVec2(x1 - 2, y0), ImVec2(x1, y1), m.accent);
+                            ImVec2 tx = ImVec2(x1 - textSz.x - 2, y0 + padY);
+                            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
+                            fg->AddText(tx, m.accent, m.text);
+                        } else if (style == 2) {
+                            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleOutlinedBg);
+                            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f, 0, 1.5f);
+                            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
+                            fg->AddText(tx, m.accent, m.text);
+                        } else if (style == 3) {
+                            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleMinimalBg, 4.0f);
+                            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleGlassBorder, 4.0f, 0, 1.0f);
+                            fg->AddRectFilled(ImVec2(x0 + 1.0f, y0 + 1.0f), ImVec2(x0 + barW + 1.0f, y1 - 1.0f), m.accent);
+                            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
+                            fg->AddText(tx, overlayTheme.moduleText, m.text);
+                        } else {
+                            fg->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), m.accent, 4.0f);
+                            fg->AddRect(ImVec2(x0, y0), ImVec2(x1, y1), overlayTheme.moduleBorder, 4.0f, 0, 1.0f);
+                            ImVec2 tx = ImVec2(x0 + barW + padX, y0 + padY);
+                            fg->AddText(ImVec2(tx.x + 1, tx.y + 1), overlayTheme.moduleTextShadow, m.text);
+                            fg->AddText(tx, overlayTheme.moduleBoldText, m.text);
+                        }
 
-                    y += boxH + gapY;
+                        y += boxH + gapY;
+                    }
+                    g_moduleListLayer.EndCapture(fg);
                 }
             }
         } else {
@@ -9508,32 +10815,146 @@ BOOL WINAPI hwglSwapBuffers(HDC hDc) {
         }
     }
 
-    ImGui::Render();
-    // Avoid driver issues when minimized / zero-sized backbuffer.
-    ImGuiIO& io = ImGui::GetIO();
-    if (io.DisplaySize.x > 1.0f && io.DisplaySize.y > 1.0f) {
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-    }
+    if (DebugPanel::EnabledFromEnvironment()) DebugPanel::DrawOverlay();
 
-    // Flush all ImGui GL commands before handing control back to the NVIDIA driver's
-    // swap implementation.  Without this, pending draw calls may reference ImGui GL
-    // objects that the driver hasn't seen yet, causing an EXCEPTION_ACCESS_VIOLATION
-    // inside nvoglv64.dll.
-    glFlush();
+    ImGui::Render();
+    FrameProfiler::EndPhase(FrameProfiler::kBuild);
+    SubmitOverlayFrame(hDc);
 
     return o_wglSwapBuffers(hDc);
 }
 
 // ===================== MAIN THREAD =====================
+// ===================== STARTUP READINESS =====================
+// Discovery starts once the Minecraft client class is prepared (JVMTI
+// ClassPrepare, or already loaded when injected late) and the game window has
+// presented its first frame.  GLFW pointers are resolved on their own thread
+// off the first swap, so the GL and JNI phases overlap.
+
+static const char* const kMcClassSigs261[] = {
+    "Lnet/minecraft/client/Minecraft;",
+    "Lnet/minecraft/client/MinecraftClient;",
+    "Lnet/minecraft/class_310;",
+    nullptr
+};
+
+static jvmtiEnv* g_startupJvmti = nullptr;
+
+static bool IsMcClassSignature(const char* sig) {
+    if (!sig) return false;
+    for (int i = 0; kMcClassSigs261[i]; i++) {
+        if (strcmp(sig, kMcClassSigs261[i]) == 0) return true;
+    }
+    return false;
+}
+
+static void MarkMcClassPrepared() {
+    InterlockedCompareExchange(&g_mcClassPreparedTickMs, (LONG)GetTickCount(), 0);
+    if (g_mcClassPreparedEvent) SetEvent(g_mcClassPreparedEvent);
+}
+
+static void JNICALL OnStartupClassPrepare(jvmtiEnv* jvmti, JNIEnv*, jthread, jclass klass) {
+    char* sig = nullptr;
+    if (jvmti->GetClassSignature(klass, &sig, nullptr) != JVMTI_ERROR_NONE || !sig) return;
+    bool match = IsMcClassSignature(sig);
+    jvmti->Deallocate((unsigned char*)sig);
+    if (match) MarkMcClassPrepared();
+}
+
+// Arm the ClassPrepare watch first, then check classes prepared before it was
+// armed (the usual case when injecting into a running client).
+static void ArmMcClassWatch(JNIEnv* env) {
+    jvmtiEnv* jvmti = nullptr;
+    if (g_jvm->GetEnv((void**)&jvmti, JVMTI_VERSION_1_2) != JNI_OK || !jvmti) {
+        Log("WARNING: JVMTI unavailable; not waiting for the Minecraft class.");
+        MarkMcClassPrepared();
+        return;
+    }
+    g_startupJvmti = jvmti;
+
+    jvmtiEventCallbacks cb;
+    memset(&cb, 0, sizeof(cb));
+    cb.ClassPrepare = &OnStartupClassPrepare;
+    if (jvmti->SetEventCallbacks(&cb, (jint)sizeof(cb)) == JVMTI_ERROR_NONE) {
+        jvmti->SetEventNotificationMode(JVMTI_ENABLE, JVMTI_EVENT_CLASS_PREPARE, nullptr);
+    }
+
+    jint count = 0; jclass* classes = nullptr;
+    if (jvmti->GetLoadedClasses(&count, &classes) == JVMTI_ERROR_NONE && classes) {
+        bool found = false;
+        for (jint i = 0; i < count; i++) {
+            if (!found) {
+                char* sig = nullptr;
+                if (jvmti->GetClassSignature(classes[i], &sig, nullptr) == JVMTI_ERROR_NONE && sig) {
+                    found = IsMcClassSignature(sig);
+                    jvmti->Deallocate((unsigned char*)sig);
+                }
+            }
+            env->DeleteLocalRef(classes[i]);
+        }
+        jvmti->Deallocate((unsigned char*)classes);
+        if (found) MarkMcClassPrepared();
+    }
+}
+
+static void DisarmMcClassWatch() {
+    if (!g_startupJvmti) return;
+    g_startupJvmti->SetEventNotificationMode(JVMTI_DISABLE, JVMTI_EVENT_CLASS_PREPARE, nullptr);
+    g_startupJvmti->DisposeEnvironment();
+    g_startupJvmti = nullptr;
+}
+
+static bool LoadGlfwPointers() {
+    const char* names[] = { "glfw.dll", "glfw64.dll", nullptr };
+    for (int i = 0; names[i]; i++) {
+        HMODULE hGlfw = GetModuleHandleA(names[i]);
+        if (!hGlfw) continue;
+        glfwGetCurrentContext_fn = (PFN_glfwGetCurrentContext)GetProcAddress(hGlfw, "glfwGetCurrentContext");
+        glfwSetInputMode_fn      = (PFN_glfwSetInputMode)     GetProcAddress(hGlfw, "glfwSetInputMode");
+        glfwGetInputMode_fn      = (PFN_glfwGetInputMode)     GetProcAddress(hGlfw, "glfwGetInputMode");
+        glfwGetKey_fn            = (PFN_glfwGetKey)           GetProcAddress(hGlfw, "glfwGetKey");
+        if (glfwGetCurrentContext_fn && glfwSetInputMode_fn) {
+            Log("GLFW function pointers loaded from: " + std::string(names[i]));
+            return true;
+        }
+    }
+    return false;
+}
+
+// GL phase: GLFW is loaded by the time the game window swaps, so one lookup
+// normally suffices; the retries only cover odd launchers.
+static DWORD WINAPI GlPhaseThread(LPVOID) {
+    WaitForSingleObject(g_firstSwapEvent, 30000);
+    for (int attempt = 0; attempt < 30 && g_running; attempt++) {
+        if (LoadGlfwPointers()) return 0;
+        Sleep(500);
+    }
+    Log("WARNING: GLFW not found. Cursor control will use fallback.");
+    return 0;
+}
+
+static std::string StartupMark(volatile LONG& tick) {
+    LONG t = InterlockedCompareExchange(&tick, 0, 0);
+    if (!t) return "n/a";
+    return std::to_string((DWORD)t - g_startupTickMs) + "ms";
+}
+
 DWORD WINAPI MainThread(LPVOID) {
     TRACE261_PATH("enter");
     Log("=== bridge_261.dll loaded ===");
-
-    // Wait for JVM
+    ThreadPolicy::Apply(ThreadPolicy::ROLE_NETWORK, "main/tcp");
+    g_startupTickMs = GetTickCount();
+    g_mcClassPreparedEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    g_firstSwapEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    g_swapFrameEvent121 = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    g_stateReadyEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+
+    // Wait for JVM.  Module load and VM creation have no event to wait on, so
+    // poll at a short interval with the same overall ceilings as before.
     HMODULE hJvm = nullptr;
-    for (int i = 0; i < 60 && !hJvm; i++) {
+    for (int i = 0; i < 600 && !hJvm; i++) {
         hJvm = GetModuleHandleA("jvm.dll");
-        if (!hJvm) Sleep(500);
+        if (!hJvm) Sleep(50);
     }
     TRACE261_BRANCH("jvmModuleFound", hJvm != nullptr);
     if (!hJvm) { Log("ERROR: jvm.dll not found."); return 0; }
@@ -9544,15 +10965,18 @@ DWORD WINAPI MainThread(LPVOID) {
     if (!fn) { Log("ERROR: JNI_GetCreatedJavaVMs not found."); return 0; }
 
     JavaVM* jvm = nullptr; jsize cnt = 0;
-    for (int i = 0; i < 10; i++) {
+    for (int i = 0; i < 100; i++) {
         fn(&jvm, 1, &cnt);
         if (jvm && cnt > 0) break;
-        Sleep(1000);
+        Sleep(100);
     }
     TRACE261_BRANCH("jvmInstanceFound", (jvm && cnt > 0));
     if (!jvm || cnt == 0) { Log("ERROR: No JVM."); return 0; }
     g_jvm = jvm;
-    Log("JVM found.");
+    Log("JVM found after " + std::to_string(GetTickCount() - g_startupTickMs) + "ms.");
+
+    // Read the overlay font now so the first SwapBuffers does no file I/O.
+    OverlayFont::Prefetch(GetBridgeDir());
 
     // Install MinHook
     if (MH_Initialize() != MH_OK) { Log("ERROR: MinHook init failed."); return 0; }
@@ -9568,30 +10992,12 @@ DWORD WINAPI MainThread(LPVOID) {
     }
     Log("wglSwapBuffers hooked.");
 
-    // ---- Load GLFW function pointers (no hook needed; just direct calls) ----
-    for (int attempt = 0; attempt < 30; attempt++) {
-        const char* names[] = { "glfw.dll", "glfw64.dll", nullptr };
-        for (int i = 0; names[i]; i++) {
-            HMODULE hGlfw = GetModuleHandleA(names[i]);
-            if (!hGlfw) continue;
-            glfwGetCurrentContext_fn = (PFN_glfwGetCurrentContext)GetProcAddress(hGlfw, "glfwGetCurrentContext");
-            glfwSetInputMode_fn      = (PFN_glfwSetInputMode)     GetProcAddress(hGlfw, "glfwSetInputMode");
-            glfwGetInputMode_fn      = (PFN_glfwGetInputMode)     GetProcAddress(hGlfw, "glfwGetInputMode");
-            glfwGetKey_fn            = (PFN_glfwGetKey)           GetProcAddress(hGlfw, "glfwGetKey");
-            if (glfwGetCurrentContext_fn && glfwSetInputMode_fn) {
-                Log("GLFW function pointers loaded from: " + std::string(names[i]));
-                goto glfw_done;
-            }
-        }
-        Sleep(500);
-    }
-    Log("WARNING: GLFW not found. Cursor control will use fallback.");
-glfw_done:;
+    // ---- GL phase (GLFW function pointers) runs alongside JNI discovery ----
+    g_glPhaseThreadHandle = CreateThread(nullptr, 0, GlPhaseThread, nullptr, 0, nullptr);
 
     // ---- JNI Discovery (JVMTI class scan, like 1.8.9 bridge) ----
-    // Run on this thread which we attach to the JVM.
-    // Wait a bit for Minecraft to finish initializing.
-    Sleep(5000);
+    // Run on this thread which we attach to the JVM, as soon as the client
+    // class is prepared and the first frame has been presented.
     {
         JNIEnv* denv = nullptr;
         bool attached = false;
@@ -9600,54 +11006,141 @@ glfw_done:;
             attached = true;
         }
         if (denv) {
-            // Retry discovery a few times (MC may not be fully loaded yet)
-            for (int attempt = 0; attempt < 5; attempt++) {
+            ArmMcClassWatch(denv);
+            HANDLE readyEvents[2] = { g_mcClassPreparedEvent, g_firstSwapEvent };
+            DWORD readyRc = WAIT_TIMEOUT;
+            DWORD waitStart = GetTickCount();
+            while (g_running && readyRc == WAIT_TIMEOUT && GetTickCount() - waitStart < 60000) {
+                readyRc = WaitForMultipleObjects(2, readyEvents, TRUE, 250);
+            }
+            DisarmMcClassWatch();
+            if (readyRc != WAIT_OBJECT_0) Log("WARNING: Startup readiness wait timed out; discovering anyway.");
+            Log("Startup ready: mcClass=" + StartupMark(g_mcClassPreparedTickMs)
+                + " firstSwap=" + StartupMark(g_firstSwapTickMs));
+
+            // Retry discovery a few times (the singleton may lag the first frame slightly)
+            bool discovered = false;
+            for (int attempt = 0; attempt < 15 && g_running; attempt++) {
                 {
-                    LockGuard remapGuard(g_jniRemapMtx);
-                    if (DiscoverJniMappings(denv)) break;
+                    CoreMappings121 m;
+                    bool ok;
+                    {
+                        LockGuard discoverGuard(g_jniDiscoverMtx);
+                        ok = DiscoverJniMappings(denv, m);
+                    }
+                    if (ok) {
+                        LockGuard remapGuard(g_jniRemapMtx);
+                        PublishCoreMappings121(denv, m, false);
+                    }
+                    DiscardCoreMappings121(denv, m);
+                    if (ok) { discovered = true; break; }
                 }
-                Log("Discovery attempt " + std::to_string(attempt+1) + " failed, retrying in 3s...");
-                Sleep(3000);
+                Log("Discovery attempt " + std::to_string(attempt+1) + " failed, retrying in 1s...");
+                Sleep(1000);
             }
+            Log("Time to ready: " + std::to_string(GetTickCount() - g_startupTickMs) + "ms"
+                + (discovered ? "" : " (discovery failed)"));
         }
         if (attached) g_jvm->DetachCurrentThread();
     }
 
     // TCP Server
     WSADATA wsa; WSAStartup(MAKEWORD(2,2), &wsa);
-    SOCKET srv = socket(AF_INET, SOCK_STREAM, 0);
+    unsigned short port = 0;
+    SOCKET srv = lc::BridgeEndpoint::Listen(&port);
+    if (srv == INVALID_SOCKET) {
+        Log("TCP server: no free bridge port for this process, err=" + std::to_string(WSAGetLastError()));
+        WSACleanup();
+        return 0;
+    }
     g_serverSocket = srv;
-    int opt = 1; setsockopt(srv, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
-    sockaddr_in addr = {}; addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = INADDR_ANY; addr.sin_port = htons(25590);
-    bind(srv, (sockaddr*)&addr, sizeof(addr));
-    listen(srv, 1);
-    Log("TCP server listening on port 25590.");
+    Log("TCP server listening on port " + std::to_string(port) + ".");
 
     setlocale(LC_NUMERIC, "C");
 
+    // Opened on the first loader request; outlives individual connections.
+    lc::ShmChannel shm;
+    unsigned sessions = 0;
+
     while (g_running) {
         SOCKET cli = accept(srv, nullptr, nullptr);
         TRACE261_BRANCH("clientAccepted", cli != INVALID_SOCKET);
         if (cli == INVALID_SOCKET) { Sleep(100); continue; }
         g_clientSocket = cli;
-        Log("C# Loader connected.");
+        // The bridge stays resident between loaders: mappings, helper class,
+        // hooks and snapshots survive, so a returning loader only needs the
+        // capabilities, module states and a keyframe (fresh stateEncoder).
+        const unsigned session = ++sessions;
+        InterlockedExchange(&g_adoptMappingsNonce121, 1);
+        Log(session == 1 ? std::string("C# Loader connected.")
+                         : "C# Loader connected (session " + std::to_string(session) + ", resumed).");
         u_long nb = 1; ioctlsocket(cli, FIONBIO, &nb);
 
+        // The loop sleeps until the socket, a producer (g_stateReadyEvent) or
+        // the shm config mailbox has something, with a heartbeat so latched
+        // and time-based state still goes out when nothing signals.
+        WSAEVENT sockEvent = WSACreateEvent();
+        if (sockEvent == WSA_INVALID_EVENT
+            || WSAEventSelect(cli, sockEvent, FD_READ | FD_WRITE | FD_CLOSE) == SOCKET_ERROR) {
+            Log("Socket event setup failed, err=" + std::to_string(WSAGetLastError()) + "; dropping loader.");
+            if (sockEvent != WSA_INVALID_EVENT) WSACloseEvent(sockEvent);
+            closesocket(cli);
+            g_clientSocket = INVALID_SOCKET;
+            continue;
+        }
+        const DWORD kHeartbeatMs = 50;
+        const DWORD kMinStateIntervalMs = 5;
+
         std::string readBuf;
-        bool capabilitiesSent = false;
+        bool binaryState = false;
+        bool deltaState = false;
+        bool shmActive = false;
+        lc::proto::DeltaEncoder stateEncoder;
+        lc::SendQueue outbox;
+        outbox.Push(lc::BridgeEndpoint::Announce(lc::ModernCapabilitiesJson(), port, session));
+        for (int g = 0; g < kResolveGroupCount121; g++) {
+            LONG resolveState = g_resolveState121[g];
+            if (resolveState != kResolveIdle121) outbox.Push(ModuleStateLine121(g, resolveState));
+        }
+        lc::TelemetrySampler telemetry;
+        bool telemetryOn = false;
+        unsigned long long shmBytes = 0;
+        Log("Queued bridge capabilities packet");
+        std::string state;
+        state.reserve(4096);
+        std::string cmdFrames;
+        // Action bar as of actionBarRev; copied (and escaped) only when it moves.
+        // JSON lines carry the text only when it differs from jsonActionBarRev.
+        std::string actionBar;
+        std::string actionEsc;
+        unsigned actionBarRev = 0;
+        unsigned jsonActionBarRev = 0;
+        PlayerListRef playersRef;
+        DWORD lastStateMs = GetTickCount() - kMinStateIntervalMs;
         while (g_running) {
             TRACE261_PATH("client-loop-iteration");
-            if (!capabilitiesSent) {
-                capabilitiesSent = TrySendCapabilities(cli);
-                TRACE261_BRANCH("capabilitiesSent", capabilitiesSent);
-                if (capabilitiesSent) Log("Sent bridge capabilities packet");
+            // Acks and a partly sent frame go first.
+            if (outbox.HasBacklog() && !outbox.Send(cli, nullptr, 0)) {
+                Log("Loader send failed, err=" + std::to_string(outbox.LastError()) + "; dropping loader.");
+                break;
             }
-
-            // Send state
-            {
+            // Bytes the socket refused on the last attempt; only bytes queued
+            // after it justify another pass without waiting.
+            size_t refusedBytes = outbox.Pending();
+
+            // Build state.  State is latest-wins, so while the socket is
+            // backed up it is skipped rather than queued.
+            state.clear();
+            bool stateDeferred = false;
+            DWORD nowMs = GetTickCount();
+            bool stateBlocked = !shmActive && outbox.HasBacklog();
+            TRACE261_BRANCH("stateBlocked", stateBlocked);
+            if (!stateBlocked && nowMs - lastStateMs < kMinStateIntervalMs) {
+                stateDeferred = true;
+            } else if (!stateBlocked) {
+                lastStateMs = nowMs;
+                LC_SYNTH_STAGE(synthSerialize, SyntheticLoad::kSerialize);
                 std::string sn;
-                std::string actionBar;
                 bool jniGui;
                 bool lookBlock;
                 bool lookEntity;
@@ -9657,9 +11150,14 @@ glfw_done:;
                 float attackCooldown;
                 float attackCooldownPerTick;
                 unsigned long long stateMs;
+                unsigned tick;
+                unsigned long long tickSampleMs;
                 { LockGuard lk(g_jniStateMtx);
                     sn = g_jniScreenName;
-                    actionBar = g_jniActionBar;
+                    if (actionBarRev != g_jniActionBarRev) {
+                        actionBar = g_jniActionBar;
+                        actionBarRev = g_jniActionBarRev;
+                    }
                     jniGui = g_jniGuiOpen;
                     lookBlock = g_jniLookingAtBlock;
                     lookEntity = g_jniLookingAtEntity;
@@ -9669,6 +11167,8 @@ glfw_done:;
                     attackCooldown = g_jniAttackCooldown;
                     attackCooldownPerTick = g_jniAttackCooldownPerTick;
                     stateMs = g_jniStateMs;
+                    tick = g_jniTick;
+                    tickSampleMs = g_jniTickSampleMs;
                 }
 
                 // guiOpen = our menu OR JNI reports a Minecraft screen is open
@@ -9676,14 +11176,8 @@ glfw_done:;
                 bool anyGui = g_ShowMenu || (jniGui && sn != "ChatScreen");
                 TRACE261_BRANCH("stateAnyGui", anyGui);
 
-                // JSON-escape the screen name
-                std::string snEsc;
-                for (char c : sn) { if (c == '"' || c == '\\') snEsc += '\\'; snEsc += c; }
-                std::string actionEsc;
-                for (char c : actionBar) { if (c == '"' || c == '\\') actionEsc += '\\'; actionEsc += c; }
-
-                std::vector<PlayerData121> players;
-                { LockGuard lk(g_playerListMutex); players = g_playerList; }
+                g_playerList.Refresh(playersRef);   // held across iterations; re-acquired per generation
+                const std::vector<PlayerData121>& players = *playersRef;
 
                 BgCamState camState;
                 { LockGuard lk(g_bgCamMutex); camState = g_bgCamState; }
@@ -9697,42 +11191,81 @@ glfw_done:;
                     }
                 }
 
-                std::string state;
-                state.reserve(4096);
-                state += "{\"type\":\"state\",\"guiOpen\":";
-                state += anyGui ? "true" : "false";
-                state += ",\"screenName\":\"";
-                state += snEsc;
-                state += "\",\"actionBar\":\"";
-                state += actionEsc;
-                state += "\",\"health\":20,\"posX\":0,\"posY\":0,\"posZ\":0";
-                char fovBuf[32];
-                snprintf(fovBuf, sizeof(fovBuf), "%.2f", camState.fov);
-                state += ",\"fov\":";
-                state += fovBuf;
-                state += ",\"holdingBlock\":";
-                state += holdBlock ? "true" : "false";
-                state += ",\"lookingAtBlock\":";
-                state += lookBlock ? "true" : "false";
-                state += ",\"lookingAtEntity\":";
-                state += lookEntity ? "true" : "false";
-                state += ",\"lookingAtEntityLatched\":";
-                state += lookEntityLatched ? "true" : "false";
-                state += ",\"breakingBlock\":";
-                state += breakBlock ? "true" : "false";
-                char stateMsBuf[32];
-                snprintf(stateMsBuf, sizeof(stateMsBuf), "%llu", stateMs);
-                state += ",\"stateMs\":";
-                state += stateMsBuf;
-                char attackCooldownBuf[32];
-                snprintf(attackCooldownBuf, sizeof(attackCooldownBuf), "%.3f", attackCooldown);
-                state += ",\"attackCooldown\":";
-                state += attackCooldownBuf;
-                char attackCooldownPerTickBuf[32];
-                snprintf(attackCooldownPerTickBuf, sizeof(attackCooldownPerTickBuf), "%.3f", attackCooldownPerTick);
-                state += ",\"attackCooldownPerTick\":";
-                state += attackCooldownPerTickBuf;
-                state += ",\"entities\":[";
+                // The shared-memory ring only carries lcb1 frames.
+                bool framed = binaryState || shmActive;
+                lc::proto::StateSnapshot snap;
+                if (framed) {
+                    snap.flags = lc::proto::STATE_MAPPED;
+                    if (anyGui) snap.flags |= lc::proto::STATE_GUI_OPEN;
+                    if (holdBlock) snap.flags |= lc::proto::STATE_HOLDING_BLOCK;
+                    if (lookBlock) snap.flags |= lc::proto::STATE_LOOKING_AT_BLOCK;
+                    if (lookEntity) snap.flags |= lc::proto::STATE_LOOKING_AT_ENTITY;
+                    if (lookEntityLatched) snap.flags |= lc::proto::STATE_LOOKING_AT_ENTITY_LATCHED;
+                    if (breakBlock) snap.flags |= lc::proto::STATE_BREAKING_BLOCK;
+                    snap.fov = camState.fov;
+                    snap.attackCooldown = attackCooldown;
+                    snap.attackCooldownPerTick = attackCooldownPerTick;
+                    snap.stateMs = stateMs;
+                    snap.tick = tick;
+                    snap.tickSampleMs = tickSampleMs;
+                    snap.screenName = sn;
+                    snap.actionBar = actionBar;
+                    snap.actionBarRev = actionBarRev;
+                    snap.entities.reserve((std::min)(players.size(), (size_t)32));
+                } else {
+                    // JSON-escape the screen name
+                    std::string snEsc;
+                    for (char c : sn) { if (c == '"' || c == '\\') snEsc += '\\'; snEsc += c; }
+                    bool sendActionBar = jsonActionBarRev != actionBarRev;
+                    if (sendActionBar) {
+                        actionEsc.clear();
+                        for (char c : actionBar) { if (c == '"' || c == '\\') actionEsc += '\\'; actionEsc += c; }
+                        jsonActionBarRev = actionBarRev;
+                    }
+
+                    state += "{\"type\":\"state\",\"guiOpen\":";
+                    state += anyGui ? "true" : "false";
+                    state += ",\"screenName\":\"";
+                    state += snEsc;
+                    if (sendActionBar) {
+                        state += "\",\"actionBar\":\"";
+                        state += actionEsc;
+                    }
+                    char revBuf[32];
+                    snprintf(revBuf, sizeof(revBuf), "\",\"actionBarRev\":%u", actionBarRev);
+                    state += revBuf;
+                    state += ",\"health\":20,\"posX\":0,\"posY\":0,\"posZ\":0";
+                    char fovBuf[32];
+                    snprintf(fovBuf, sizeof(fovBuf), "%.2f", camState.fov);
+                    state += ",\"fov\":";
+                    state += fovBuf;
+                    state += ",\"holdingBlock\":";
+                    state += holdBlock ? "true" : "false";
+                    state += ",\"lookingAtBlock\":";
+                    state += lookBlock ? "true" : "false";
+                    state += ",\"lookingAtEntity\":";
+                    state += lookEntity ? "true" : "false";
+                    state += ",\"lookingAtEntityLatched\":";
+                    state += lookEntityLatched ? "true" : "false";
+                    state += ",\"breakingBlock\":";
+                    state += breakBlock ? "true" : "false";
+                    char stateMsBuf[32];
+                    snprintf(stateMsBuf, sizeof(stateMsBuf), "%llu", stateMs);
+                    state += ",\"stateMs\":";
+                    state += stateMsBuf;
+                    char tickBuf[48];
+                    snprintf(tickBuf, sizeof(tickBuf), ",\"tick\":%u,\"tickSampleMs\":%llu", tick, tickSampleMs);
+                    state += tickBuf;
+                    char attackCooldownBuf[32];
+                    snprintf(attackCooldownBuf, sizeof(attackCooldownBuf), "%.3f", attackCooldown);
+                    state += ",\"attackCooldown\":";
+                    state += attackCooldownBuf;
+                    char attackCooldownPerTickBuf[32];
+                    snprintf(attackCooldownPerTickBuf, sizeof(attackCooldownPerTickBuf), "%.3f", attackCooldownPerTick);
+                    state += ",\"attackCooldownPerTick\":";
+                    state += attackCooldownPerTickBuf;
+                    state += ",\"entities\":[";
+                }
 
                 bool first = true;
                 LegoVec3 camPos = { camState.camX, camState.camY, camState.camZ };
@@ -9795,6 +11328,18 @@ glfw_done:;
                         }
                     }
 
+                    if (framed) {
+                        lc::proto::EntitySnapshot e;
+                        e.name = p.name;
+                        e.sx = projected ? sx : -1.0f;
+                        e.sy = projected ? sy : -1.0f;
+                        e.dist = p.dist;
+                        e.hp = (float)p.hp;
+                        snap.entities.push_back(e);
+                        sentEntities++;
+                        continue;
+                    }
+
                     std::string nameEsc;
                     for (char c : p.name) { if (c == '"' || c == '\\') nameEsc += '\\'; nameEsc += c; }
 
@@ -9813,35 +11358,130 @@ glfw_done:;
                     state += "}";
                     sentEntities++;
                 }
-                state += "]}\n";
-                send(cli, state.c_str(), (int)state.size(), 0);
+                bool haveState = true;
+                if (framed) {
+                    if (deltaState) haveState = stateEncoder.Encode(state, snap, GetTickCount());
+                    else lc::proto::AppendStateFrame(state, snap);
+                } else {
+                    state += "]}\n";
+                }
+                LC_SYNTH_ITEMS(synthSerialize, sentEntities);
+                LC_SYNTH_BYTES(synthSerialize, haveState ? state.size() : 0);
+                // haveState is false when a delta would be empty.  A frame too
+                // big for the shm ring stays in `state` and goes out on the
+                // socket below; the loader feeds both into one assembler.
+                if (!haveState) {
+                    state.clear();
+                } else if (shmActive) {
+                    if (shm.Publish(state)) {
+                        shmBytes += state.size();
+                        state.clear();
+                    } else if (!binaryState) {
+                        static AsyncLog::RateGate s_oversizeGate;
+                        if (AsyncLog::Allow(s_oversizeGate, 5000))
+                            Log("WARNING: state frame of " + std::to_string(state.size()) + " bytes exceeds shm ring on a JSON socket");
+                        state.clear();
+                    }
+                }
             }
 
-            // Send pending GUI commands
+            // Pending GUI commands are never dropped; on TCP they queue behind
+            // any backlog.
+            cmdFrames.clear();
             {
                 std::vector<std::string> cmds;
                 { LockGuard lk(g_cmdMutex); cmds.swap(g_pendingCmds); }
-                for (const auto& c : cmds)
-                    send(cli, c.c_str(), (int)c.size(), 0);
+                if (telemetryOn && telemetry.Due(nowMs)) {
+                    long lag = g_playerList.Version() - playersRef.Version();
+                    DWORD lastScanMs = g_lastPlayerListUpdateMs;
+                    DWORD ageMs = lastScanMs ? nowMs - lastScanMs : 0;
+                    cmds.push_back(telemetry.Sample(nowMs, outbox.SentBytes() + shmBytes, lag, ageMs));
+                }
+                if (shmActive) {
+                    std::string frame;
+                    for (const auto& c : cmds) {
+                        frame.clear();
+                        lc::proto::AppendJsonFrame(frame, c);
+                        if (shm.Publish(frame)) shmBytes += frame.size();
+                        else if (binaryState) cmdFrames += frame;
+                        else cmdFrames += c;
+                    }
+                } else if (binaryState) {
+                    for (const auto& c : cmds) lc::proto::AppendJsonFrame(cmdFrames, c);
+                } else {
+                    for (const auto& c : cmds) cmdFrames += c;
+                }
             }
 
-            // Receive config from C#
-            {
+            // State then cmds in one gathered send.
+            if (!state.empty() || !cmdFrames.empty()) {
+                const std::string* bufs[2] = { &state, &cmdFrames };
+                if (!outbox.Send(cli, bufs, 2)) {
+                    Log("Loader send failed, err=" + std::to_string(outbox.LastError()) + "; dropping loader.");
+                    break;
+                }
+                refusedBytes = outbox.Pending();
+            }
+
+            // Receive config from C#: drain everything the socket has.
+            bool peerGone = false;
+            for (;;) {
                 char buf[4096];
-                int r = recv(cli, buf, sizeof(buf)-1, 0);
+                int r = recv(cli, buf, sizeof(buf), 0);
                 if (r > 0) {
-                    buf[r] = 0; readBuf += buf;
-                    size_t pos;
-                    while ((pos = readBuf.find('\n')) != std::string::npos) {
-                        std::string pkt = readBuf.substr(0, pos);
-                        readBuf.erase(0, pos+1);
-                        if (!pkt.empty()) ParseConfig(pkt);
+                    readBuf.append(buf, r);
+                    continue;
+                }
+                if (r == 0 || WSAGetLastError() != WSAEWOULDBLOCK) peerGone = true;
+                break;
+            }
+            {
+                size_t pos;
+                while ((pos = readBuf.find('\n')) != std::string::npos) {
+                    std::string pkt = readBuf.substr(0, pos);
+                    readBuf.erase(0, pos+1);
+                    if (pkt.empty()) continue;
+                    lc::SimpleJsonConfigReader reader(pkt);   // tokenized once for every handler
+                    if (HandleFormatRequest(outbox, reader, binaryState, deltaState)) { stateEncoder.RequestKeyframe(); continue; }
+                    if (reader.GetString("type") == "keyframe") { stateEncoder.RequestKeyframe(); continue; }
+                    if (HandleTransportRequest(outbox, reader, shm, shmActive)) continue;
+                    if (lc::TelemetrySampler::ParseRequest(pkt, telemetryOn)) {
+                        telemetry.Reset(GetTickCount(), outbox.SentBytes() + shmBytes);
+                        continue;
                     }
-                } else if (r == 0) break;
+                    ParseConfig(reader);
+                }
+            }
+            if (peerGone) break;
+
+            // Config mailbox (shared-memory transport)
+            if (shmActive) {
+                std::string cfg;
+                if (shm.TakeConfig(cfg)) ParseConfig(lc::SimpleJsonConfigReader(cfg));
             }
 
-            Sleep(5);
+            // A freshly queued ack goes out on the next pass without waiting.
+            // A backlog the socket already refused waits for FD_WRITE (or the
+            // heartbeat) like everything else, shm transport or not, so a
+            // loader that stops reading cannot make this loop spin.
+            if (outbox.Pending() > refusedBytes) continue;
+
+            HANDLE waits[3];
+            DWORD waitCount = 0;
+            waits[waitCount++] = sockEvent;
+            if (g_stateReadyEvent) waits[waitCount++] = g_stateReadyEvent;
+            if (shmActive && shm.ConfigEvent()) waits[waitCount++] = shm.ConfigEvent();
+            DWORD timeoutMs = kHeartbeatMs;
+            if (stateDeferred) {
+                DWORD since = GetTickCount() - lastStateMs;
+                timeoutMs = since < kMinStateIntervalMs ? kMinStateIntervalMs - since : 0;
+            }
+            WaitForMultipleObjects(waitCount, waits, FALSE, timeoutMs);
+            WSANETWORKEVENTS netEvents;
+            WSAEnumNetworkEvents(cli, sockEvent, &netEvents);   // resets sockEvent
         }
+        WSAEventSelect(cli, sockEvent, 0);
+        WSACloseEvent(sockEvent);
         closesocket(cli);
         g_clientSocket = INVALID_SOCKET;
         Log("C# Loader disconnected.");
@@ -9856,7 +11496,7 @@ glfw_done:;
 // ===================== DLL ENTRY =====================
 extern "C" __declspec(dllexport) void Dummy261() {}
 
-BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID) {
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID lpReserved) {
     if (reason == DLL_PROCESS_ATTACH) {
         g_hModule121 = hModule;
         DisableThreadLibraryCalls(hModule);
@@ -9877,12 +11517,30 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID) {
                 || traceEnv[0] == 'y' || traceEnv[0] == 'Y'
                 || traceEnv[0] == 't' || traceEnv[0] == 'T');
         }
+#if LC_TRACE_BUILD
+        TraceBuffer::SetEnabled(g_trace261Enabled);
+#endif
+        
+        char levelEnv[16] = {};
+        if (GetEnvironmentVariableA("LC_BRIDGE_LOG_LEVEL", levelEnv, sizeof(levelEnv)) > 0) {
+            AsyncLog::SetMinLevel(AsyncLog::ParseLevel(levelEnv, AsyncLog::LEVEL_DEBUG));
+        }
         
         std::ofstream(g_logPath, std::ios_base::trunc)
             << "=== bridge_261.dll DLL_PROCESS_ATTACH ===\n";
+        AsyncLog::Start(g_logPath);
+#if LC_SYNTHETIC_LOAD
+        if (SyntheticLoad::Active()) {
+            const SyntheticLoad::Settings& synth = SyntheticLoad::Current();
+            Log("SyntheticLoad: " + std::to_string(synth.players) + " players, " + std::to_string(synth.chests)
+                + " chests replace the helper frames");
+        }
+#endif
         g_mainThreadHandle = CreateThread(nullptr, 0, MainThread, nullptr, 0, nullptr);
     } else if (reason == DLL_PROCESS_DETACH) {
         g_running = false;
+        // Process exit: the flusher is already gone, so this only drains.
+        if (lpReserved) AsyncLog::Stop();
     }
     return TRUE;
 }
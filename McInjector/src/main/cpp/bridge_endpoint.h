@@ -0,0 +1,88 @@
+#pragma once
+// bridge_endpoint.h
+// Loopback port of the bridge's TCP server, derived from the game's PID so
+// several injected clients on one machine each get their own.
+//
+// A process's home port is kBasePort + 1 + (pid / 4) % kPortRange (Windows
+// PIDs are multiples of four).  When that is taken, the next kProbes - 1
+// ports of the range are tried in order.  The loader computes the same list
+// from the PID it injected and keeps the connection whose capabilities
+// packet carries that PID.  LC_BRIDGE_PORT, set in the game's environment,
+// pins the server to one port instead.
+//
+// The shared-memory channel is already per process (shm_channel.h), and its
+// name travels in the transport ack.
+
+#include <winsock2.h>
+#include <windows.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace lc {
+
+struct BridgeEndpoint {
+    static const unsigned short kBasePort  = 25590;
+    static const unsigned       kPortRange = 4096;
+    static const unsigned       kProbes    = 8;
+
+    // i-th port tried for `pid`, i < kProbes.
+    static unsigned short PortFor(DWORD pid, unsigned i)
+    {
+        return (unsigned short)(kBasePort + 1 + ((pid / 4) + i) % kPortRange);
+    }
+
+    // LC_BRIDGE_PORT, or 0 when unset or not a port.
+    static unsigned short OverridePort()
+    {
+        char env[16] = {};
+        DWORD len = GetEnvironmentVariableA("LC_BRIDGE_PORT", env, sizeof(env));
+        if (len == 0 || len >= sizeof(env)) return 0;
+        long v = strtol(env, nullptr, 10);
+        return v > 0 && v < 65536 ? (unsigned short)v : 0;
+    }
+
+    // Binds and listens on the first free port for this process; *portOut
+    // gets it.  INVALID_SOCKET when none of the candidates could be bound.
+    static SOCKET Listen(unsigned short* portOut)
+    {
+        const DWORD pid = GetCurrentProcessId();
+        const unsigned short pinned = OverridePort();
+        const unsigned tries = pinned ? 1 : kProbes;
+        for (unsigned i = 0; i < tries; i++) {
+            const unsigned short port = pinned ? pinned : PortFor(pid, i);
+            SOCKET s = socket(AF_INET, SOCK_STREAM, 0);
+            if (s == INVALID_SOCKET) return INVALID_SOCKET;
+            // Exclusive: SO_REUSEADDR would let a second game's bridge bind the
+            // port this one already listens on.
+            int opt = 1; setsockopt(s, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, (const char*)&opt, sizeof(opt));
+            sockaddr_in addr = {}; addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); addr.sin_port = htons(port);
+            if (bind(s, (sockaddr*)&addr, sizeof(addr)) == 0 && listen(s, 1) == 0) {
+                if (portOut) *portOut = port;
+                return s;
+            }
+            closesocket(s);
+        }
+        return INVALID_SOCKET;
+    }
+
+    // A capabilities packet (one JSON object + '\n') with "pid" and "port"
+    // added, so the loader can tell which game it reached, and "session":
+    // loaders this bridge has served, this one included.  Above 1 the loader
+    // resumed a resident bridge whose mappings and snapshots are still warm.
+    static std::string Announce(const char* capabilitiesJson, unsigned short port, unsigned session)
+    {
+        std::string out = capabilitiesJson;
+        size_t end = out.rfind('}');
+        if (end == std::string::npos) return out;
+        char buf[72];
+        snprintf(buf, sizeof(buf), ",\"pid\":%lu,\"port\":%u,\"session\":%u",
+                 (unsigned long)GetCurrentProcessId(), (unsigned)port, session);
+        out.insert(end, buf);
+        return out;
+    }
+};
+
+} // namespace lc
@@ -0,0 +1,128 @@
+// bridge_protocol.cpp
+#include "bridge_protocol.h"
+
+namespace lc {
+namespace proto {
+
+namespace {
+
+void PutEntity(FrameWriter& w, const EntitySnapshot& e) {
+    w.PutF32(e.sx);
+    w.PutF32(e.sy);
+    w.PutF64(e.dist);
+    w.PutF32(e.hp);
+    w.PutStr(e.name);
+}
+
+bool SameEntity(const EntitySnapshot& a, const EntitySnapshot& b) {
+    return a.sx == b.sx && a.sy == b.sy && a.dist == b.dist && a.hp == b.hp;
+}
+
+unsigned ChangedMask(const StateSnapshot& a, const StateSnapshot& b) {
+    unsigned m = 0;
+    if (a.flags != b.flags) m |= DELTA_FLAGS;
+    if (a.health != b.health) m |= DELTA_HEALTH;
+    if (a.fov != b.fov) m |= DELTA_FOV;
+    if (a.pitch != b.pitch) m |= DELTA_PITCH;
+    if (a.attackCooldown != b.attackCooldown) m |= DELTA_ATTACK_COOLDOWN;
+    if (a.attackCooldownPerTick != b.attackCooldownPerTick) m |= DELTA_ATTACK_COOLDOWN_PER_TICK;
+    if (a.posX != b.posX || a.posY != b.posY || a.posZ != b.posZ) m |= DELTA_POS;
+    if (a.stateMs != b.stateMs) m |= DELTA_STATE_MS;
+    if (a.screenName != b.screenName) m |= DELTA_SCREEN_NAME;
+    if (a.actionBarRev || b.actionBarRev) {
+        if (a.actionBarRev != b.actionBarRev) m |= DELTA_ACTION_BAR | DELTA_ACTION_BAR_REV;
+    } else if (a.actionBar != b.actionBar) {
+        m |= DELTA_ACTION_BAR;
+    }
+    if (a.entities.size() != b.entities.size()) {
+        m |= DELTA_ENTITIES;
+    } else {
+        for (size_t i = 0; i < a.entities.size(); i++) {
+            if (a.entities[i].name != b.entities[i].name || !SameEntity(a.entities[i], b.entities[i])) {
+                m |= DELTA_ENTITIES;
+                break;
+            }
+        }
+    }
+    if (a.tick != b.tick || a.tickSampleMs != b.tickSampleMs) m |= DELTA_TICK;
+    return m;
+}
+
+} // namespace
+
+void AppendStateFrame(std::string& out, const StateSnapshot& s) {
+    FrameWriter w(out);
+    w.Begin(FRAME_STATE);
+    w.PutU16(s.flags);
+    w.PutF32(s.health);
+    w.PutF32(s.fov);
+    w.PutF32(s.pitch);
+    w.PutF32(s.attackCooldown);
+    w.PutF32(s.attackCooldownPerTick);
+    w.PutF64(s.posX);
+    w.PutF64(s.posY);
+    w.PutF64(s.posZ);
+    w.PutU64(s.stateMs);
+    w.PutStr(s.screenName);
+    w.PutStr(s.actionBar);
+    size_t n = s.entities.size() > 0xFFFF ? 0xFFFF : s.entities.size();
+    w.PutU16((unsigned)n);
+    for (size_t i = 0; i < n; i++) PutEntity(w, s.entities[i]);
+    w.PutU32(s.tick);
+    w.PutU64(s.tickSampleMs);
+    w.PutU32(s.actionBarRev);
+    w.End();
+}
+
+bool DeltaEncoder::Encode(std::string& out, const StateSnapshot& cur, unsigned long nowMs) {
+    if (!_haveLast || nowMs - _lastKeyframeMs >= _keyframeMs) {
+        AppendStateFrame(out, cur);
+        _last = cur;
+        _haveLast = true;
+        _seq = 0;
+        _lastKeyframeMs = nowMs;
+        return true;
+    }
+
+    unsigned mask = ChangedMask(_last, cur);
+    if (mask == 0) return false;
+
+    FrameWriter w(out);
+    w.Begin(FRAME_STATE_DELTA);
+    w.PutU32(++_seq);
+    w.PutU16(mask);
+    if (mask & DELTA_FLAGS) w.PutU16(cur.flags);
+    if (mask & DELTA_HEALTH) w.PutF32(cur.health);
+    if (mask & DELTA_FOV) w.PutF32(cur.fov);
+    if (mask & DELTA_PITCH) w.PutF32(cur.pitch);
+    if (mask & DELTA_ATTACK_COOLDOWN) w.PutF32(cur.attackCooldown);
+    if (mask & DELTA_ATTACK_COOLDOWN_PER_TICK) w.PutF32(cur.attackCooldownPerTick);
+    if (mask & DELTA_POS) { w.PutF64(cur.posX); w.PutF64(cur.posY); w.PutF64(cur.posZ); }
+    if (mask & DELTA_STATE_MS) w.PutU64(cur.stateMs);
+    if (mask & DELTA_SCREEN_NAME) w.PutStr(cur.screenName);
+    if (mask & DELTA_ACTION_BAR) w.PutStr(cur.actionBar);
+    if (mask & DELTA_ENTITIES) {
+        size_t n = cur.entities.size() > 0xFFFF ? 0xFFFF : cur.entities.size();
+        w.PutU16((unsigned)n);
+        size_t countAt = w.Offset();
+        unsigned changed = 0;
+        w.PutU16(0);
+        for (size_t i = 0; i < n; i++) {
+            const EntitySnapshot& e = cur.entities[i];
+            if (i < _last.entities.size() && _last.entities[i].name == e.name && SameEntity(_last.entities[i], e)) continue;
+            w.PutU16((unsigned)i);
+            PutEntity(w, e);
+            changed++;
+        }
+        w.PatchU16(countAt, changed);
+    }
+    if (mask & DELTA_TICK) { w.PutU32(cur.tick); w.PutU64(cur.tickSampleMs); }
+    if (mask & DELTA_ACTION_BAR_REV) w.PutU32(cur.actionBarRev);
+    w.End();
+
+    _last = cur;
+    return true;
+}
+
+} // namespace proto
+} // namespace lc
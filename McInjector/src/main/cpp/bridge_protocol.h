@@ -0,0 +1,255 @@
+#pragma once
+// bridge_protocol.h
+// "lcb1": binary framing for the bridge -> loader TCP stream.
+//
+// The stream starts as newline-delimited JSON.  A bridge that lists "lcb1" in
+// its capabilities "formats" array switches when the loader asks for it:
+//
+//   loader -> bridge   {"type":"format","state":"lcb1"}\n
+//   bridge -> loader   {"type":"format","state":"lcb1"}\n     (last JSON line)
+//   bridge -> loader   frame, frame, ...
+//
+// Adding "delta":true to the request (echoed in the ack) switches state to
+// keyframes plus FRAME_STATE_DELTA; {"type":"keyframe"} asks for a fresh one.
+//
+// Loader -> bridge config stays JSON lines.  Every frame is an 8-byte header
+// followed by `length` payload bytes, all little-endian:
+//
+//   u8 type | u8 version | u16 reserved (0) | u32 length
+//
+//   FRAME_STATE        one full state snapshot, i.e. a keyframe (layout below)
+//   FRAME_JSON         one JSON message without its trailing newline (cmd packets)
+//   FRAME_STATE_DELTA  changes since the previous state frame (layout below)
+//
+// STATE payload (unchanged since version 1):
+//   u16 flags (STATE_*) | f32 health | f32 fov | f32 pitch
+//   f32 attackCooldown | f32 attackCooldownPerTick
+//   f64 posX | f64 posY | f64 posZ | u64 stateMs
+//   str screenName | str actionBar
+//   u16 entityCount, then per entity: f32 sx | f32 sy | f64 dist | f32 hp | str name
+//   u32 tick | u64 tickSampleMs | u32 actionBarRev
+//
+// `tick` is the local player's tickCount the tick-rate fields (breakingBlock,
+// holdingBlock, attack cooldown, actionBar) were last read on, 0 when they
+// follow a wall clock, and `tickSampleMs` when that read happened; stateMs is
+// the newer per-frame sample (screen, crosshair).
+// Bridges that predate them end the payload after the entities.
+// `actionBarRev` moves whenever the bridge's action bar text changes (0 =
+// not tracked), so neither side has to compare the text to notice a change.
+//
+// STATE_DELTA payload, version 2 (only after {"delta":true} was negotiated):
+//   u32 seq (1, 2, ... since the last keyframe) | u16 mask (DELTA_*)
+//   then, for each set bit in bit order, the field as in STATE; DELTA_POS is
+//   all three f64.  DELTA_ENTITIES adds:
+//   u16 count (length of the new entity list)
+//   u16 changed, each u16 index | full STATE entity record
+// The list is cut or grown to `count`; an index not sent keeps the previous
+// frame's entity at that position, so the list stays in the bridge's order
+// and names (which repeat) are never used as keys.  Version 1 matched
+// upserts and removals by name.
+// DELTA_TICK is both tick fields.  DELTA_ACTION_BAR_REV (u32) always comes
+// with DELTA_ACTION_BAR when the bridge tracks revisions.
+// A reader that sees a seq gap drops deltas and sends {"type":"keyframe"}.
+//
+// `str` is a u16 byte length followed by UTF-8 bytes (no terminator).  Readers
+// must ignore payload bytes past what they understand, so fields can only be
+// appended within a version.
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace lc {
+namespace proto {
+
+const char* const kFormatName = "lcb1";
+const unsigned char kVersion = 2;
+const unsigned kHeaderSize = 8;
+
+enum FrameType {
+    FRAME_STATE       = 1,
+    FRAME_JSON        = 2,
+    FRAME_STATE_DELTA = 3
+};
+
+enum StateFlags {
+    STATE_GUI_OPEN                   = 1 << 0,
+    STATE_HOLDING_BLOCK              = 1 << 1,
+    STATE_LOOKING_AT_BLOCK           = 1 << 2,
+    STATE_LOOKING_AT_ENTITY          = 1 << 3,
+    STATE_LOOKING_AT_ENTITY_LATCHED  = 1 << 4,
+    STATE_BREAKING_BLOCK             = 1 << 5,
+    STATE_MAPPED                     = 1 << 6
+};
+
+enum DeltaFields {
+    DELTA_FLAGS                    = 1 << 0,
+    DELTA_HEALTH                   = 1 << 1,
+    DELTA_FOV                      = 1 << 2,
+    DELTA_PITCH                    = 1 << 3,
+    DELTA_ATTACK_COOLDOWN          = 1 << 4,
+    DELTA_ATTACK_COOLDOWN_PER_TICK = 1 << 5,
+    DELTA_POS                      = 1 << 6,
+    DELTA_STATE_MS                 = 1 << 7,
+    DELTA_SCREEN_NAME              = 1 << 8,
+    DELTA_ACTION_BAR               = 1 << 9,
+    DELTA_ENTITIES                 = 1 << 10,
+    DELTA_TICK                     = 1 << 11,
+    DELTA_ACTION_BAR_REV           = 1 << 12
+};
+
+inline const char* FormatAckLine(bool delta = false)
+{
+    return delta
+        ? "{\"type\":\"format\",\"state\":\"lcb1\",\"delta\":true}\n"
+        : "{\"type\":\"format\",\"state\":\"lcb1\"}\n";
+}
+
+struct EntitySnapshot {
+    std::string name;
+    float  sx;
+    float  sy;
+    double dist;
+    float  hp;
+};
+
+// Everything a STATE frame carries, in wire order.
+struct StateSnapshot {
+    unsigned flags;
+    float  health;
+    float  fov;
+    float  pitch;
+    float  attackCooldown;
+    float  attackCooldownPerTick;
+    double posX, posY, posZ;
+    unsigned long long stateMs;
+    std::string screenName;
+    std::string actionBar;
+    std::vector<EntitySnapshot> entities;
+    unsigned tick;
+    unsigned long long tickSampleMs;
+    unsigned actionBarRev;
+
+    StateSnapshot()
+        : flags(0), health(20.0f), fov(70.0f), pitch(0.0f), attackCooldown(1.0f),
+          attackCooldownPerTick(0.0f), posX(0.0), posY(0.0), posZ(0.0), stateMs(0),
+          tick(0), tickSampleMs(0), actionBarRev(0) {}
+};
+
+// Appends little-endian fields to a frame held in a caller-owned string, so a
+// send buffer reserved once per connection is reused across frames.
+class FrameWriter {
+public:
+    explicit FrameWriter(std::string& out) : _out(out), _start(0) {}
+
+    void Begin(FrameType type)
+    {
+        _start = _out.size();
+        PutU8((unsigned char)type);
+        PutU8(kVersion);
+        PutU16(0);
+        PutU32(0);   // patched by End()
+    }
+
+    void End()
+    {
+        unsigned len = (unsigned)(_out.size() - _start - kHeaderSize);
+        for (int i = 0; i < 4; i++)
+            _out[_start + 4 + i] = (char)((len >> (8 * i)) & 0xFF);
+    }
+
+    void PutU8(unsigned char v) { _out.push_back((char)v); }
+
+    void PutU16(unsigned v)
+    {
+        _out.push_back((char)(v & 0xFF));
+        _out.push_back((char)((v >> 8) & 0xFF));
+    }
+
+    void PutU32(unsigned v)
+    {
+        for (int i = 0; i < 4; i++) _out.push_back((char)((v >> (8 * i)) & 0xFF));
+    }
+
+    void PutU64(unsigned long long v)
+    {
+        for (int i = 0; i < 8; i++) _out.push_back((char)((v >> (8 * i)) & 0xFF));
+    }
+
+    void PutF32(float v)
+    {
+        unsigned bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        PutU32(bits);
+    }
+
+    void PutF64(double v)
+    {
+        unsigned long long bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        PutU64(bits);
+    }
+
+    // Longer strings are truncated to 65535 bytes.
+    void PutStr(const std::string& s)
+    {
+        size_t n = s.size() > 0xFFFF ? 0xFFFF : s.size();
+        PutU16((unsigned)n);
+        _out.append(s, 0, n);
+    }
+
+    void PutBytes(const char* data, size_t n) { _out.append(data, n); }
+
+    // For counts only known after the items are written: note Offset(), put a
+    // placeholder, then PatchU16() it.
+    size_t Offset() const { return _out.size(); }
+
+    void PatchU16(size_t at, unsigned v)
+    {
+        _out[at]     = (char)(v & 0xFF);
+        _out[at + 1] = (char)((v >> 8) & 0xFF);
+    }
+
+private:
+    std::string& _out;
+    size_t _start;
+};
+
+// Wraps one newline-terminated JSON message as a FRAME_JSON frame.
+inline void AppendJsonFrame(std::string& out, const std::string& jsonLine)
+{
+    size_t n = jsonLine.size();
+    while (n > 0 && (jsonLine[n - 1] == '\n' || jsonLine[n - 1] == '\r')) n--;
+    FrameWriter w(out);
+    w.Begin(FRAME_JSON);
+    w.PutBytes(jsonLine.data(), n);
+    w.End();
+}
+
+// Appends one FRAME_STATE (keyframe) for `s`.
+void AppendStateFrame(std::string& out, const StateSnapshot& s);
+
+// Per-connection encoder for negotiated delta mode: a keyframe first, every
+// `keyframeMs`, and after RequestKeyframe(); otherwise a FRAME_STATE_DELTA
+// against the last snapshot it encoded.
+class DeltaEncoder {
+public:
+    explicit DeltaEncoder(unsigned long keyframeMs = 1000)
+        : _keyframeMs(keyframeMs), _haveLast(false), _seq(0), _lastKeyframeMs(0) {}
+
+    void RequestKeyframe() { _haveLast = false; }
+
+    // Appends a keyframe or delta frame to `out`.  Returns false, appending
+    // nothing, when `cur` equals the last snapshot sent.
+    bool Encode(std::string& out, const StateSnapshot& cur, unsigned long nowMs);
+
+private:
+    unsigned long _keyframeMs;
+    bool          _haveLast;
+    unsigned      _seq;
+    unsigned long _lastKeyframeMs;
+    StateSnapshot _last;
+};
+
+} // namespace proto
+} // namespace lc
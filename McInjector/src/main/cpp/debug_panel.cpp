@@ -0,0 +1,134 @@
+// debug_panel.cpp
+#include "debug_panel.h"
+#include "frame_profiler.h"
+#include "jni_core/jni_accounting.h"
+#include "jni_core/ref_ledger.h"
+#include "scan_governor.h"
+#include "imgui.h"
+
+#include <windows.h>
+
+namespace DebugPanel {
+
+bool EnabledFromEnvironment() {
+    static int s_enabled = -1;
+    if (s_enabled < 0) {
+        char env[16] = {};
+        DWORD len = GetEnvironmentVariableA("LC_BRIDGE_DEBUG_PANEL", env, sizeof(env));
+        s_enabled = (len > 0 && (env[0] == '1' || env[0] == 'y' || env[0] == 'Y'
+                                 || env[0] == 't' || env[0] == 'T')) ? 1 : 0;
+    }
+    return s_enabled == 1;
+}
+
+void DrawFrameCost() {
+    FrameProfiler::DrawStatsTable();
+}
+
+// Scan-thread / render-pass JNI transitions per module since the last 30 s
+// stats log (which resets them).
+void DrawJniBudget() {
+    int shown = 0;
+    for (int i = 0; i < JniAccounting::ModuleCount(); i++) {
+        JniAccounting::ModuleStats s;
+        if (!JniAccounting::Get(i, s) || !s.runs) continue;
+        bool hot = s.budget && s.lastRun > s.budget;
+        ImGui::TextColored(hot ? ImVec4(0.95f, 0.45f, 0.40f, 1.0f) : ImVec4(0.55f, 0.90f, 0.70f, 1.0f),
+                           "%s", s.name);
+        ImGui::SameLine(110);
+        if (s.budget) ImGui::Text("last %u / %u", s.lastRun, s.budget);
+        else          ImGui::Text("last %u", s.lastRun);
+        ImGui::TextDisabled("  call %lu  fld %lu  ref %lu  str %lu  exc %lu",
+                            s.counts[JniAccounting::kCalls],
+                            s.counts[JniAccounting::kFieldReads] + s.counts[JniAccounting::kFieldWrites],
+                            s.counts[JniAccounting::kRefs], s.counts[JniAccounting::kStrings],
+                            s.counts[JniAccounting::kExceptions]);
+        ImGui::TextDisabled("  runs %lu  avg %lluus  max %uus  over %lu",
+                            s.runs, s.totalUs / s.runs, s.maxUs, s.overBudget);
+        shown++;
+    }
+    if (!shown) ImGui::TextDisabled("No accounted JNI runs yet.");
+}
+
+// Back-off level and the periods the governor currently gives its tasks.
+void DrawScanGovernor() {
+    lc::SnapshotCell<lc::GovernorStatus>::Ref ref = lc::ScanGovernor::Published();
+    const lc::GovernorStatus& st = *ref;
+    if (!st.running) { ImGui::TextDisabled("Scan governor not running."); return; }
+    const bool backedOff = st.level > 0;
+    ImGui::TextColored(backedOff ? ImVec4(0.95f, 0.45f, 0.40f, 1.0f) : ImVec4(0.55f, 0.90f, 0.70f, 1.0f),
+                       "%s", !st.enabled ? "disabled" : backedOff ? "backing off" : "calm");
+    ImGui::SameLine(110);
+    ImGui::Text("level %d / %d  for %lus", st.level, lc::ScanGovernor::kMaxLevel,
+                (unsigned long)((GetTickCount() - st.levelSinceMs) / 1000));
+    if (st.frameMs > 0.0f)
+        ImGui::TextDisabled("  frame %.1f ms  baseline %.1f ms%s", st.frameMs, st.baselineMs,
+                            st.pressured ? "  (pressured)" : "");
+    else
+        ImGui::TextDisabled("  no frame time");
+    ImGui::TextDisabled("  scan busy %.1f%%  raises %u  drops %u", st.busyPct, st.raises, st.drops);
+    for (int i = 0; i < st.taskCount; i++) {
+        const lc::GovernorStatus::Task& t = st.tasks[i];
+        bool stretched = t.periodMs > t.baseMs;
+        ImGui::TextColored(stretched ? ImVec4(0.95f, 0.45f, 0.40f, 1.0f) : ImVec4(0.80f, 0.82f, 0.85f, 1.0f),
+                           "%s", t.name);
+        ImGui::SameLine(110);
+        if (t.maxMs > t.baseMs) ImGui::Text("%lu ms  (%lu..%lu)", (unsigned long)t.periodMs,
+                                            (unsigned long)t.baseMs, (unsigned long)t.maxMs);
+        else                    ImGui::Text("%lu ms  (pinned)", (unsigned long)t.periodMs);
+        ImGui::TextDisabled("  busy %.2f%%", t.busyPct);
+    }
+}
+
+// Live global / weak global refs per owning module, against its cap.
+void DrawGlobalRefs() {
+    int shown = 0;
+    for (int i = 0; i < RefLedger::ModuleCount(); i++) {
+        RefLedger::ModuleStats s;
+        if (!RefLedger::Get(i, s) || !s.created) continue;
+        bool hot = s.rejected || (s.cap && s.live * 4 >= s.cap * 3);
+        ImGui::TextColored(hot ? ImVec4(0.95f, 0.45f, 0.40f, 1.0f) : ImVec4(0.55f, 0.90f, 0.70f, 1.0f),
+                           "%s", s.name);
+        ImGui::SameLine(110);
+        if (s.cap) ImGui::Text("live %lu / %u", s.live, s.cap);
+        else       ImGui::Text("live %lu", s.live);
+        ImGui::TextDisabled("  weak %lu  peak %lu  made %lu  freed %lu  refused %lu",
+                            s.liveWeak, s.peak, s.created, s.deleted, s.rejected);
+        shown++;
+    }
+    if (!shown) ImGui::TextDisabled("No ledgered refs yet.");
+    else        ImGui::TextDisabled("total live %lu  untracked deletes %lu",
+                                    RefLedger::LiveTotal(), RefLedger::UntrackedDeletes());
+}
+
+void DrawOverlay() {
+    ImGuiIO& io = ImGui::GetIO();
+    const float width = 300.0f;
+    ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - width - 8.0f, 8.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(width, 0.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.72f);
+    ImGui::Begin("##lc_debug_panel", nullptr,
+        ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs |
+        ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav |
+        ImGuiWindowFlags_NoSavedSettings);
+    ImGui::TextColored(ImVec4(0.781f, 0.384f, 0.353f, 1.0f), "Frame cost");
+    ImGui::Separator();
+    DrawFrameCost();
+    ImGui::Spacing();
+    ImGui::TextColored(ImVec4(0.781f, 0.384f, 0.353f, 1.0f), "JNI budget");
+    ImGui::Separator();
+    DrawJniBudget();
+    ImGui::Spacing();
+    ImGui::TextColored(ImVec4(0.781f, 0.384f, 0.353f, 1.0f), "Global refs");
+    ImGui::Separator();
+    DrawGlobalRefs();
+    if (lc::ScanGovernor::Published()->running) {
+        ImGui::Spacing();
+        ImGui::TextColored(ImVec4(0.781f, 0.384f, 0.353f, 1.0f), "Scan governor");
+        ImGui::Separator();
+        DrawScanGovernor();
+    }
+    ImGui::End();
+}
+
+} // namespace DebugPanel
@@ -0,0 +1,26 @@
+#pragma once
+// debug_panel.h
+// Read-only ImGui panes for the bridge's own instrumentation (hook frame
+// cost, per-module JNI accounting, scan governor, global-ref ledger), shared
+// by both bridges.
+//
+// The panes draw into whatever window the caller has open (a ClickGUI
+// settings column).  DrawOverlay() puts them in a small click-through window
+// of their own; the bridges call it each frame when LC_BRIDGE_DEBUG_PANEL is
+// set, since 26.1 has no in-game GUI and the legacy one is drawn in raw GL.
+
+namespace DebugPanel {
+
+// Reads LC_BRIDGE_DEBUG_PANEL (1 / y / t) once; later calls return the
+// cached answer.
+bool EnabledFromEnvironment();
+
+void DrawFrameCost();
+void DrawJniBudget();
+void DrawScanGovernor();   // "not running" unless a ScanGovernor published
+void DrawGlobalRefs();
+
+// The panes in a click-through window pinned to the top-right corner.
+void DrawOverlay();
+
+} // namespace DebugPanel
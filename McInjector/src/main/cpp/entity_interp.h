@@ -0,0 +1,233 @@
+#pragma once
+// entity_interp.h
+// Per-entity state that outlives one scan, and render-time interpolation
+// between the last two positions a scan saw for an entity.
+//
+// SlotTable keeps T in a fixed array of N slots (a power of two).  An entity
+// id maps to slot id & (N - 1); on a collision the next kProbe slots are
+// tried, and when all of them are live the least recently seen one is taken
+// over.  Taking a slot bumps its generation, so a SlotHandle (index +
+// generation) handed out earlier stops matching once the slot belongs to
+// another entity.  A second table of the same N can be indexed by those
+// handles directly with At(): the render thread keeps its own per-entity
+// state that way, without a lookup.  No allocation; Expire() frees slots not
+// touched within maxAge stamps (frames, milliseconds: whatever the caller
+// passes as stamp).
+//
+// Interpolation: the scan thread feeds each entity's position to its
+// MotionSample, which starts a new interval only when the position changed,
+// stamped with the QPC time the change was seen.  Scans faster than the
+// game's tick therefore still yield tick-long intervals.  The render thread
+// draws prev + (cur - prev) * alpha, where alpha reaches 1 one interval after
+// the newest sample was seen: the overlay runs one interval behind and never
+// extrapolates.
+
+#include <windows.h>
+
+namespace lc {
+
+inline LONGLONG QpcNow()
+{
+    LARGE_INTEGER c;
+    QueryPerformanceCounter(&c);
+    return c.QuadPart;
+}
+
+inline LONGLONG QpcFrequency()
+{
+    static LONGLONG s_freq = 0;
+    if (!s_freq) {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        s_freq = f.QuadPart ? f.QuadPart : 1;
+    }
+    return s_freq;
+}
+
+inline LONGLONG QpcFromMs(unsigned ms) { return QpcFrequency() * ms / 1000; }
+
+// Fraction of the way from the previous sample to the newest one at `now`,
+// in [0, 1].  The interval is capped at maxSpan so an entity that stood still
+// for a while does not glide for as long; 1 when there is no earlier sample.
+inline double InterpAlpha(LONGLONG prevAt, LONGLONG at, LONGLONG now, LONGLONG maxSpan)
+{
+    if (at <= prevAt) return 1.0;
+    if (now <= at) return 0.0;
+    LONGLONG span = at - prevAt;
+    if (maxSpan > 0 && span > maxSpan) span = maxSpan;
+    double a = (double)(now - at) / (double)span;
+    return a < 1.0 ? a : 1.0;
+}
+
+struct MotionSample {
+    double   x, y, z;
+    double   prevX, prevY, prevZ;
+    LONGLONG at, prevAt;   // QPC times the two positions were first seen
+
+    // Records the position a scan saw at `now`.  `fresh` (a newly claimed
+    // slot) starts from rest at that position.
+    void Observe(double nx, double ny, double nz, LONGLONG now, bool fresh)
+    {
+        if (fresh) {
+            x = prevX = nx; y = prevY = ny; z = prevZ = nz;
+            at = prevAt = now;
+            return;
+        }
+        if (nx == x && ny == y && nz == z) return;
+        prevX = x; prevY = y; prevZ = z; prevAt = at;
+        x = nx; y = ny; z = nz; at = now;
+    }
+
+    // Interpolated position at `now`; returns alpha (1 = at rest on x/y/z).
+    double Sample(LONGLONG now, LONGLONG maxSpan, double* ox, double* oy, double* oz) const
+    {
+        double a = InterpAlpha(prevAt, at, now, maxSpan);
+        *ox = prevX + (x - prevX) * a;
+        *oy = prevY + (y - prevY) * a;
+        *oz = prevZ + (z - prevZ) * a;
+        return a;
+    }
+};
+
+struct SlotHandle {
+    unsigned short index;
+    unsigned short gen;   // 0: no slot
+};
+
+template <typename T, unsigned N>
+class SlotTable {
+    static_assert(N > 0 && (N & (N - 1)) == 0 && N <= 65536, "N must be a power of two up to 65536");
+
+    struct Slot {
+        unsigned       key;
+        unsigned       lastSeen;
+        unsigned short gen;
+        bool           used;
+        T              value;
+    };
+
+public:
+    static const unsigned kProbe = 8;
+
+    SlotTable()
+    {
+        for (unsigned i = 0; i < N; i++) {
+            _slots[i].key = 0;
+            _slots[i].lastSeen = 0;
+            _slots[i].gen = 0;
+            _slots[i].used = false;
+        }
+    }
+
+    // The slot holding `key`, claimed (value reset to T(), *fresh = true)
+    // when the key has none.
+    SlotHandle Touch(unsigned key, unsigned stamp, bool* fresh = nullptr)
+    {
+        const unsigned home = key & (N - 1);
+        unsigned victim = home;
+        bool haveFree = false;
+        for (unsigned p = 0; p < kProbe && p < N; p++) {
+            const unsigned i = (home + p) & (N - 1);
+            Slot& s = _slots[i];
+            if (s.used && s.key == key) {
+                s.lastSeen = stamp;
+                if (fresh) *fresh = false;
+                return Handle(i);
+            }
+            if (!s.used) {
+                if (!haveFree) { victim = i; haveFree = true; }
+            } else if (!haveFree && stamp - s.lastSeen > stamp - _slots[victim].lastSeen) {
+                victim = i;
+            }
+        }
+        Claim(_slots[victim], key, stamp);
+        if (fresh) *fresh = true;
+        return Handle(victim);
+    }
+
+    // Value for `key` if it has a slot, else null; claims and stamps nothing.
+    const T* Find(unsigned key) const
+    {
+        const unsigned home = key & (N - 1);
+        for (unsigned p = 0; p < kProbe && p < N; p++) {
+            const Slot& s = _slots[(home + p) & (N - 1)];
+            if (s.used && s.key == key) return &s.value;
+        }
+        return nullptr;
+    }
+
+    // Value of a handle this table's Touch() returned.
+    T&       operator[](SlotHandle h)       { return _slots[h.index & (N - 1)].value; }
+    const T& operator[](SlotHandle h) const { return _slots[h.index & (N - 1)].value; }
+
+    // Value for a handle from another table of the same N; reset to T()
+    // (*fresh = true) when the slot last served a different generation.
+    T& At(SlotHandle h, unsigned stamp, bool* fresh = nullptr)
+    {
+        Slot& s = _slots[h.index & (N - 1)];
+        const bool reset = !s.used || s.gen != h.gen;
+        if (reset) {
+            s.used = true;
+            s.key = h.index;
+            s.gen = h.gen;
+            s.value = T();
+        }
+        s.lastSeen = stamp;
+        if (fresh) *fresh = reset;
+        return s.value;
+    }
+
+    // Frees slots whose last Touch()/At() is more than maxAge stamps old,
+    // calling onExpire(key, value) for each first.
+    template <typename F>
+    void Expire(unsigned stamp, unsigned maxAge, F onExpire)
+    {
+        for (unsigned i = 0; i < N; i++) {
+            Slot& s = _slots[i];
+            if (s.used && stamp - s.lastSeen > maxAge) {
+                onExpire(s.key, s.value);
+                s.used = false;
+            }
+        }
+    }
+
+    void Expire(unsigned stamp, unsigned maxAge) { Expire(stamp, maxAge, IgnoreExpired()); }
+
+    // Frees every slot; generations survive, so older handles stay stale.
+    void Clear()
+    {
+        for (unsigned i = 0; i < N; i++) _slots[i].used = false;
+    }
+
+    unsigned Live() const
+    {
+        unsigned n = 0;
+        for (unsigned i = 0; i < N; i++) n += _slots[i].used ? 1u : 0u;
+        return n;
+    }
+
+private:
+    struct IgnoreExpired { void operator()(unsigned, T&) const {} };
+
+    SlotTable(const SlotTable&);
+    SlotTable& operator=(const SlotTable&);
+
+    SlotHandle Handle(unsigned i) const
+    {
+        SlotHandle h = { (unsigned short)i, _slots[i].gen };
+        return h;
+    }
+
+    static void Claim(Slot& s, unsigned key, unsigned stamp)
+    {
+        s.used = true;
+        s.key = key;
+        s.lastSeen = stamp;
+        if (++s.gen == 0) s.gen = 1;
+        s.value = T();
+    }
+
+    Slot _slots[N];
+};
+
+} // namespace lc
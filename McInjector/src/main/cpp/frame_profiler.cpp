@@ -0,0 +1,273 @@
+// frame_profiler.cpp
+#include "frame_profiler.h"
+#include "imgui.h"
+
+#include <windows.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace FrameProfiler {
+
+namespace {
+
+const int   kSeries       = kPhaseCount + 1;   // phases + total
+const DWORD kStatsMs      = 250;
+const int   kCsvFlushRows = 60;
+const DWORD kFrameGapMs   = 500;   // longer hook gaps are not frame times
+
+const char* const kPhaseNames[kSeries] = {
+    "validate", "prepare", "build", "save", "draw", "restore", "flush", "total"
+};
+
+double    s_usPerTick = 0.0;
+long long s_frameStart = 0;
+long long s_phaseStart = 0;
+bool      s_inFrame = false;
+float     s_current[kPhaseCount];
+long long s_lastBegin = 0;
+
+// Written by the render thread, read by any: interlocked.
+volatile LONG s_gameFrameUs = 0;
+volatile LONG s_lastBeginMs = 0;
+
+float s_samples[kSeries][kWindow];
+int   s_head = 0;    // next slot to write
+int   s_count = 0;
+unsigned long s_frameNo = 0;
+
+PhaseStats s_stats[kSeries];
+bool       s_statsValid = false;
+DWORD      s_statsAtMs = 0;
+
+struct CsvLock {
+    CRITICAL_SECTION cs;
+    CsvLock()  { InitializeCriticalSection(&cs); }
+    ~CsvLock() { DeleteCriticalSection(&cs); }
+};
+
+CsvLock& Csv() {
+    static CsvLock s_lock;
+    return s_lock;
+}
+
+HANDLE      s_csvFile = INVALID_HANDLE_VALUE;
+std::string s_csvBuf;
+int         s_csvRows = 0;
+
+long long Now() {
+    LARGE_INTEGER c;
+    QueryPerformanceCounter(&c);
+    return c.QuadPart;
+}
+
+void EnsureFreq() {
+    if (s_usPerTick != 0.0) return;
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    s_usPerTick = 1000000.0 / (double)f.QuadPart;
+}
+
+// Caller holds Csv().
+void FlushCsvLocked() {
+    if (s_csvFile == INVALID_HANDLE_VALUE || s_csvBuf.empty()) return;
+    DWORD written = 0;
+    WriteFile(s_csvFile, s_csvBuf.data(), (DWORD)s_csvBuf.size(), &written, nullptr);
+    s_csvBuf.clear();
+    s_csvRows = 0;
+}
+
+void AppendCsvRow(const float* phases, float total) {
+    EnterCriticalSection(&Csv().cs);
+    if (s_csvFile != INVALID_HANDLE_VALUE) {
+        char row[192];
+        int n = snprintf(row, sizeof(row), "%lu", s_frameNo);
+        for (int i = 0; i < kPhaseCount && n > 0 && n < (int)sizeof(row); i++)
+            n += snprintf(row + n, sizeof(row) - n, ",%.1f", phases[i]);
+        if (n > 0 && n < (int)sizeof(row))
+            n += snprintf(row + n, sizeof(row) - n, ",%.1f\n", total);
+        if (n > 0 && n < (int)sizeof(row)) s_csvBuf.append(row, (size_t)n);
+        if (++s_csvRows >= kCsvFlushRows) FlushCsvLocked();
+    }
+    LeaveCriticalSection(&Csv().cs);
+}
+
+void ComputeStats() {
+    static float s_scratch[kWindow];
+    for (int k = 0; k < kSeries; k++) {
+        int n = Samples(k, s_scratch);
+        PhaseStats& st = s_stats[k];
+        if (!n) { st.p50Us = st.p99Us = st.maxUs = st.meanUs = 0.0f; continue; }
+        double sum = 0.0;
+        float mx = 0.0f;
+        for (int i = 0; i < n; i++) { sum += s_scratch[i]; if (s_scratch[i] > mx) mx = s_scratch[i]; }
+        int i50 = n / 2;
+        int i99 = (n * 99) / 100;
+        if (i99 >= n) i99 = n - 1;
+        std::nth_element(s_scratch, s_scratch + i99, s_scratch + n);
+        st.p99Us = s_scratch[i99];
+        std::nth_element(s_scratch, s_scratch + i50, s_scratch + i99);
+        st.p50Us = s_scratch[i50];
+        st.maxUs = mx;
+        st.meanUs = (float)(sum / n);
+    }
+}
+
+} // namespace
+
+const char* PhaseName(int phase) {
+    return (phase >= 0 && phase < kSeries) ? kPhaseNames[phase] : "?";
+}
+
+void BeginFrame() {
+    EnsureFreq();
+    s_frameStart = s_phaseStart = Now();
+    if (s_lastBegin) {
+        double us = (s_frameStart - s_lastBegin) * s_usPerTick;
+        LONG avg = s_gameFrameUs;
+        if (us >= kFrameGapMs * 1000.0) avg = 0;
+        else if (!avg) avg = (LONG)us;
+        else avg += ((LONG)us - avg) / 16;
+        InterlockedExchange(&s_gameFrameUs, avg);
+    }
+    s_lastBegin = s_frameStart;
+    InterlockedExchange(&s_lastBeginMs, (LONG)GetTickCount());
+    for (int i = 0; i < kPhaseCount; i++) s_current[i] = 0.0f;
+    s_inFrame = true;
+}
+
+void EndPhase(Phase phase) {
+    if (!s_inFrame) return;
+    long long now = Now();
+    s_current[phase] += (float)((now - s_phaseStart) * s_usPerTick);
+    s_phaseStart = now;
+}
+
+void GlBackendMark(int mark) {
+    if (mark == 0) EndPhase(kStateSave);
+    else if (mark == 1) EndPhase(kDraw);
+}
+
+void EndFrame() {
+    if (!s_inFrame) return;
+    s_inFrame = false;
+    float total = (float)((Now() - s_frameStart) * s_usPerTick);
+    for (int i = 0; i < kPhaseCount; i++) s_samples[i][s_head] = s_current[i];
+    s_samples[kTotal][s_head] = total;
+    s_head = (s_head + 1) % kWindow;
+    if (s_count < kWindow) s_count++;
+    s_frameNo++;
+    if (s_csvFile != INVALID_HANDLE_VALUE) AppendCsvRow(s_current, total);
+}
+
+int Frames() {
+    return s_count;
+}
+
+unsigned GameFrameUs() {
+    LONG last = InterlockedCompareExchange(&s_lastBeginMs, 0, 0);
+    if (!last || GetTickCount() - (DWORD)last > kFrameGapMs) return 0;
+    LONG us = InterlockedCompareExchange(&s_gameFrameUs, 0, 0);
+    return us > 0 ? (unsigned)us : 0;
+}
+
+int Samples(int phase, float* out) {
+    if (phase < 0 || phase >= kSeries) return 0;
+    int start = (s_head - s_count + kWindow) % kWindow;
+    for (int i = 0; i < s_count; i++) out[i] = s_samples[phase][(start + i) % kWindow];
+    return s_count;
+}
+
+bool Percentiles(int phase, PhaseStats& out) {
+    if (phase < 0 || phase >= kSeries || !s_count) return false;
+    DWORD now = GetTickCount();
+    if (!s_statsValid || now - s_statsAtMs >= kStatsMs) {
+        ComputeStats();
+        s_statsValid = true;
+        s_statsAtMs = now;
+    }
+    out = s_stats[phase];
+    return true;
+}
+
+std::string FormatStats() {
+    if (!s_count) return std::string();
+    s_statsValid = false;   // fresh numbers for the log line
+    std::string out;
+    char buf[96];
+    for (int k = 0; k < kSeries; k++) {
+        PhaseStats st;
+        if (!Percentiles(k, st)) continue;
+        if (k == kTotal)
+            snprintf(buf, sizeof(buf), "%s%s p50=%.0fus p99=%.0fus max=%.0fus (%d frames)",
+                     out.empty() ? "" : "; ", kPhaseNames[k], st.p50Us, st.p99Us, st.maxUs, s_count);
+        else
+            snprintf(buf, sizeof(buf), "%s%s p50=%.0fus p99=%.0fus",
+                     out.empty() ? "" : "; ", kPhaseNames[k], st.p50Us, st.p99Us);
+        out += buf;
+    }
+    return out;
+}
+
+bool StartCsvFromEnvironment(const std::string& defaultPath) {
+    char env[MAX_PATH] = {};
+    DWORD len = GetEnvironmentVariableA("LC_FRAME_PROFILE_CSV", env, sizeof(env));
+    if (len == 0 || len >= sizeof(env)) return false;
+    bool flag = len == 1 && (env[0] == '1' || env[0] == 'y' || env[0] == 'Y' || env[0] == 't' || env[0] == 'T');
+    if (len == 1 && !flag) return false;
+    std::string path = flag ? defaultPath : std::string(env, len);
+
+    EnterCriticalSection(&Csv().cs);
+    if (s_csvFile == INVALID_HANDLE_VALUE) {
+        s_csvFile = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (s_csvFile != INVALID_HANDLE_VALUE) {
+            s_csvBuf = "frame";
+            for (int i = 0; i < kSeries; i++) { s_csvBuf += ','; s_csvBuf += kPhaseNames[i]; s_csvBuf += "_us"; }
+            s_csvBuf += '\n';
+            FlushCsvLocked();
+        }
+    }
+    bool ok = s_csvFile != INVALID_HANDLE_VALUE;
+    LeaveCriticalSection(&Csv().cs);
+    return ok;
+}
+
+void StopCsv() {
+    EnterCriticalSection(&Csv().cs);
+    FlushCsvLocked();
+    if (s_csvFile != INVALID_HANDLE_VALUE) CloseHandle(s_csvFile);
+    s_csvFile = INVALID_HANDLE_VALUE;
+    LeaveCriticalSection(&Csv().cs);
+}
+
+void DrawStatsTable() {
+    if (!s_count) {
+        ImGui::TextDisabled("No frames measured yet.");
+        return;
+    }
+    ImGui::TextDisabled("Hook cost over the last %d frames", s_count);
+    ImGui::Spacing();
+    ImGui::Text("phase");
+    ImGui::SameLine(90);  ImGui::Text("p50 us");
+    ImGui::SameLine(150); ImGui::Text("p99 us");
+    ImGui::SameLine(210); ImGui::Text("max us");
+    for (int k = 0; k < kSeries; k++) {
+        PhaseStats st;
+        if (!Percentiles(k, st)) continue;
+        if (k == kTotal) ImGui::Separator();
+        ImGui::Text("%s", kPhaseNames[k]);
+        ImGui::SameLine(90);  ImGui::Text("%.0f", st.p50Us);
+        ImGui::SameLine(150); ImGui::Text("%.0f", st.p99Us);
+        ImGui::SameLine(210); ImGui::Text("%.0f", st.maxUs);
+    }
+    static float s_plot[kWindow];
+    int n = Samples(kTotal, s_plot);
+    PhaseStats total;
+    Percentiles(kTotal, total);
+    ImGui::Spacing();
+    ImGui::PlotLines("##lc_frame_total", s_plot, n, 0, "total us", 0.0f, total.p99Us * 1.5f + 1.0f,
+                     ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+}
+
+} // namespace FrameProfiler
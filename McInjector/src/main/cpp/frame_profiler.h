@@ -0,0 +1,82 @@
+#pragma once
+// frame_profiler.h
+// Per-phase cost of the SwapBuffers hook, shared by both bridges.
+//
+// The hook calls BeginFrame() on entry, EndPhase() as each phase finishes and
+// EndFrame() once the overlay has been drawn; frames that bail out early
+// (warmup, wrong window, minimised) never reach EndFrame() and are dropped.
+// The GL backend reports the end of its state backup and the start of its
+// restore through GlBackendMark(), so the time ImGui_ImplOpenGL3_RenderDrawData
+// spends saving and restoring GL state is separated from the draws.
+//
+// BeginFrame() also times the interval since the previous hook entry: the
+// game's own frame time, hook included.  GameFrameUs() is readable from any
+// thread (the 26.1 scan governor polls it).
+//
+// The last kWindow frames are kept per phase; percentiles are computed on
+// demand (panel, log), never per frame.  With LC_FRAME_PROFILE_CSV set, every
+// frame is also appended as a CSV row.
+//
+// Render thread only, except StopCsv() and GameFrameUs().
+
+#include <string>
+
+namespace FrameProfiler {
+
+enum Phase {
+    kValidate,       // hook entry to the end of the early-out checks
+    kPrepare,        // GUI state, matrix capture and other per-frame reads
+    kBuild,          // NewFrame through ImGui::Render(): overlay draw lists
+    kStateSave,      // backend: texture updates + GL state backup
+    kDraw,           // backend: buffer uploads and draw calls
+    kStateRestore,   // backend: GL state restore
+    kFlush,          // glFlush before the real swap
+    kPhaseCount
+};
+
+static const int kWindow = 600;   // frames kept per phase (~10 s at 60 FPS)
+static const int kTotal  = kPhaseCount;   // Percentiles()/Samples() index for the frame total
+
+const char* PhaseName(int phase);
+
+void BeginFrame();
+// Closes `phase` at now; the next phase starts here.
+void EndPhase(Phase phase);
+void EndFrame();
+
+// ImGui_ImplOpenGL3_SetPhaseCallback target: 0 = state saved, 1 = draws done.
+void GlBackendMark(int mark);
+
+struct PhaseStats {
+    float p50Us;
+    float p99Us;
+    float maxUs;
+    float meanUs;
+};
+
+// Frames currently in the window.
+int Frames();
+
+// Smoothed interval between hook entries in microseconds (about the last 16
+// frames).  0 before the first two frames and while no frame arrived in the
+// last 500 ms (minimised, loading); a gap that long also restarts the average.
+unsigned GameFrameUs();
+// Percentiles over the window for a phase, or kTotal.  Recomputed at most
+// every 250 ms.  False while the window is empty.
+bool Percentiles(int phase, PhaseStats& out);
+// Oldest-first copy of the window for a phase (or kTotal) into `out`
+// (kWindow floats).  Returns the number written.
+int Samples(int phase, float* out);
+
+// "validate p50=Xus p99=Yus; ...; total p50=Xus p99=Yus max=Zus (N frames)".
+std::string FormatStats();
+
+// Per-frame CSV (microseconds per phase).  StartCsv from startup code; it
+// is a no-op unless LC_FRAME_PROFILE_CSV is set to 1 / y / t, or to a path.
+bool StartCsvFromEnvironment(const std::string& defaultPath);
+void StopCsv();
+
+// ImGui widgets for a debug pane; the caller owns the window.
+void DrawStatsTable();
+
+} // namespace FrameProfiler
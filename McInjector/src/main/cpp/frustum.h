@@ -0,0 +1,110 @@
+#pragma once
+// frustum.h
+// View-frustum culling and nearest-N selection for the world overlays.
+//
+// The overlays used to project every loaded player or chest and throw away
+// the ones behind the camera or off screen afterwards, so their cost grew
+// with what the world had loaded.  Planes are extracted once per camera
+// snapshot from the same clip matrix the projection uses (Gribb/Hartmann);
+// BoxVisible() then rejects a world-space box with at most five dot products
+// before anything is projected.  SelectNearest() keeps the N closest
+// survivors with std::nth_element and orders only those N.
+//
+//   Frustum::Planes fr;
+//   Frustum::FromCamera(fr, cam, winW, winH);          // 26.1 (Projection::Camera)
+//   Frustum::FromViewProj(fr, vX, vY, vZ, view, proj, 0.02f);   // 1.8.9 matrices
+//   if (Frustum::BoxVisible(fr, minX, minY, minZ, maxX, maxY, maxZ)) keep.push_back(...);
+//   keep.resize(Frustum::SelectNearest(keep, maxCount, ByDist()));
+//
+// The test is conservative: a box near a frustum corner can pass while being
+// just off screen, never the other way round.  There is no far plane; the
+// overlays cap distance themselves.  Header-only so the 1.8.9 bridge, which
+// does not link projection.cpp, can use it.
+
+#include "projection.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Frustum {
+
+enum Plane { kLeft, kRight, kBottom, kTop, kNear, kPlaneCount };
+
+struct Planes {
+    double ox, oy, oz;              // camera position; boxes are tested relative to it
+    float  p[kPlaneCount][4];       // a*x + b*y + c*z + d >= 0 inside
+    bool   valid;                   // false: BoxVisible() keeps everything
+};
+
+// clip = m * (p - o, 1), column-major; x is multiplied by xScale before the
+// divide (1 for real matrices, h/w for Projection's angles model).  Points
+// with clip w below nearW count as behind the camera.
+inline void FromClip(Planes& out, double ox, double oy, double oz, const float m[16],
+                     float xScale, float nearW) {
+    const float rx[4] = { m[0] * xScale, m[4] * xScale, m[8] * xScale, m[12] * xScale };
+    const float ry[4] = { m[1], m[5], m[9], m[13] };
+    const float rw[4] = { m[3], m[7], m[11], m[15] };
+    for (int k = 0; k < 4; k++) {
+        out.p[kLeft][k]   = rw[k] + rx[k];
+        out.p[kRight][k]  = rw[k] - rx[k];
+        out.p[kBottom][k] = rw[k] + ry[k];
+        out.p[kTop][k]    = rw[k] - ry[k];
+        out.p[kNear][k]   = rw[k];
+    }
+    out.p[kNear][3] -= nearW;
+    out.ox = ox; out.oy = oy; out.oz = oz;
+    out.valid = true;
+}
+
+// Same clip space as Projection::Project() for this camera and viewport.
+inline void FromCamera(Planes& out, const Projection::Camera& cam, int winW, int winH) {
+    if (!cam.valid || winW <= 0 || winH <= 0) { out.valid = false; return; }
+    const float xScale = cam.aspectFromViewport ? (float)winH / (float)winW : 1.0f;
+    FromClip(out, cam.ox, cam.oy, cam.oz, cam.m, xScale, Projection::kNearW);
+}
+
+// view/proj column-major, as the 1.8.9 WorldToScreen takes them.
+inline void FromViewProj(Planes& out, double ox, double oy, double oz,
+                         const float view[16], const float proj[16], float nearW) {
+    float m[16];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            float s = 0.0f;
+            for (int k = 0; k < 4; k++) s += proj[k * 4 + r] * view[c * 4 + k];
+            m[c * 4 + r] = s;
+        }
+    }
+    FromClip(out, ox, oy, oz, m, 1.0f, nearW);
+}
+
+// False only when the box lies entirely outside one plane: for each plane
+// the corner furthest along its normal is tested.
+inline bool BoxVisible(const Planes& f, double minX, double minY, double minZ,
+                       double maxX, double maxY, double maxZ) {
+    if (!f.valid) return true;
+    const float x0 = (float)(minX - f.ox), x1 = (float)(maxX - f.ox);
+    const float y0 = (float)(minY - f.oy), y1 = (float)(maxY - f.oy);
+    const float z0 = (float)(minZ - f.oz), z1 = (float)(maxZ - f.oz);
+    for (int i = 0; i < kPlaneCount; i++) {
+        const float* p = f.p[i];
+        const float x = p[0] >= 0.0f ? x1 : x0;
+        const float y = p[1] >= 0.0f ? y1 : y0;
+        const float z = p[2] >= 0.0f ? z1 : z0;
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) return false;
+    }
+    return true;
+}
+
+// Moves the n smallest items (by less) to the front, in order, and returns
+// how many that is.  O(size + n log n) instead of sorting everything.
+template <typename T, typename Less>
+inline size_t SelectNearest(std::vector<T>& items, size_t n, Less less) {
+    if (n > items.size()) n = items.size();
+    if (n == 0) return 0;
+    if (n < items.size())
+        std::nth_element(items.begin(), items.begin() + (std::ptrdiff_t)(n - 1), items.end(), less);
+    std::sort(items.begin(), items.begin() + (std::ptrdiff_t)n, less);
+    return n;
+}
+
+} // namespace Frustum
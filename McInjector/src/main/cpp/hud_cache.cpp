@@ -0,0 +1,139 @@
+// hud_cache.cpp
+#include "hud_cache.h"
+
+#include <windows.h>
+#include <cstring>
+
+namespace HudCache {
+
+namespace {
+
+// Atlas texture (a grow/repack allocates a new one), font size and display
+// metrics: anything that moves glyph UVs or pixel positions.
+unsigned long long FullKey(unsigned long long key) {
+    ImGuiIO& io = ImGui::GetIO();
+    Key k;
+    k.Add(&key, sizeof(key));
+    ImTextureData* tex = io.Fonts ? io.Fonts->TexData : nullptr;
+    k.Add(tex ? tex->UniqueID : -1);
+    k.Add(tex ? tex->Width : 0);
+    k.Add(tex ? tex->Height : 0);
+    ImFont* font = ImGui::GetFont();
+    k.Add(&font, sizeof(font));
+    k.Add(ImGui::GetFontSize());
+    k.Add(io.DisplaySize.x);
+    k.Add(io.DisplaySize.y);
+    k.Add(io.DisplayFramebufferScale.x);
+    k.Add(io.DisplayFramebufferScale.y);
+    return k.Value();
+}
+
+long long QpcNow() {
+    LARGE_INTEGER c;
+    QueryPerformanceCounter(&c);
+    return c.QuadPart;
+}
+
+long long QpcFreq() {
+    static long long s_freq = 0;
+    if (!s_freq) {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        s_freq = f.QuadPart;
+    }
+    return s_freq;
+}
+
+} // namespace
+
+void Key::Add(const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        _h ^= p[i];
+        _h *= 1099511628211ULL;
+    }
+}
+
+void Key::Add(const char* s) {
+    if (!s) s = "";
+    size_t n = strlen(s);
+    Add(s, n);
+    Add((unsigned)n);
+}
+
+Layer::Layer()
+    : _key(0), _valid(false), _pendingUserKey(0), _pendingKey(0), _cmdCount(0), _vtxStart(0),
+      _idxStart(0), _baseIdx(0), _capturing(false), _hits(0), _misses(0) {}
+
+bool Layer::Replay(ImDrawList* dst, unsigned long long key) {
+    if (!_valid || _key != FullKey(key)) {
+        _misses++;
+        return false;
+    }
+    _hits++;
+    if (_idx.Size == 0) return true;
+
+    dst->PrimReserve(_idx.Size, _vtx.Size);
+    unsigned int base = dst->_VtxCurrentIdx;
+    memcpy(dst->_VtxWritePtr, _vtx.Data, (size_t)_vtx.Size * sizeof(ImDrawVert));
+    for (int i = 0; i < _idx.Size; i++) dst->_IdxWritePtr[i] = (ImDrawIdx)(base + _idx.Data[i]);
+    dst->_VtxWritePtr += _vtx.Size;
+    dst->_IdxWritePtr += _idx.Size;
+    dst->_VtxCurrentIdx += (unsigned int)_vtx.Size;
+    return true;
+}
+
+void Layer::BeginCapture(ImDrawList* dst, unsigned long long key) {
+    _pendingUserKey = key;
+    _pendingKey = FullKey(key);
+    _cmdCount = dst->CmdBuffer.Size;
+    _vtxStart = dst->VtxBuffer.Size;
+    _idxStart = dst->IdxBuffer.Size;
+    _baseIdx = dst->_VtxCurrentIdx;
+    _capturing = true;
+}
+
+void Layer::EndCapture(ImDrawList* dst) {
+    if (!_capturing) return;
+    _capturing = false;
+    _valid = false;
+
+    // A new command means the build changed texture/clip or rolled the vertex
+    // offset; its indices are not relative to one base, so rebuild next frame.
+    // Glyphs rasterised during the build may have grown the atlas, in which
+    // case the captured UVs belong to the old texture.
+    if (dst->CmdBuffer.Size != _cmdCount || FullKey(_pendingUserKey) != _pendingKey) return;
+
+    int vtxCount = dst->VtxBuffer.Size - _vtxStart;
+    int idxCount = dst->IdxBuffer.Size - _idxStart;
+    if (vtxCount < 0 || idxCount < 0) return;
+
+    _vtx.resize(vtxCount);
+    _idx.resize(idxCount);
+    if (vtxCount) memcpy(_vtx.Data, dst->VtxBuffer.Data + _vtxStart, (size_t)vtxCount * sizeof(ImDrawVert));
+    for (int i = 0; i < idxCount; i++)
+        _idx.Data[i] = (ImDrawIdx)(dst->IdxBuffer.Data[_idxStart + i] - _baseIdx);
+    _key = _pendingKey;
+    _valid = true;
+}
+
+void Layer::Invalidate() {
+    _valid = false;
+    _capturing = false;
+}
+
+FramePacer::FramePacer() : _builtAt(0), _w(0), _h(0), _valid(false), _replayed(0) {}
+
+bool FramePacer::CanReplay(int hz, int w, int h) const {
+    if (hz <= 0 || !_valid || w != _w || h != _h) return false;
+    return QpcNow() - _builtAt < QpcFreq() / hz;
+}
+
+void FramePacer::MarkBuilt(int w, int h) {
+    _builtAt = QpcNow();
+    _w = w;
+    _h = h;
+    _valid = true;
+}
+
+} // namespace HudCache
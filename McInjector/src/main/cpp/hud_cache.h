@@ -0,0 +1,117 @@
+#pragma once
+// hud_cache.h
+// Retained geometry for overlay layers that only change with config.
+//
+// The module list and logo are the same vertices frame after frame until the
+// theme, style, enabled modules or display change.  A Layer captures what a
+// build appended to a draw list and, while the caller's key is unchanged,
+// copies those vertices/indices straight back in place of the Add* calls.
+//
+//   HudCache::Key key;
+//   key.Add(cfg.moduleListStyle); key.Add(cfg.guiTheme); ...
+//   if (!s_layer.Replay(fg, key.Value())) {
+//       s_layer.BeginCapture(fg, key.Value());
+//       ... fg->AddRectFilled / AddText ...
+//       s_layer.EndCapture(fg);
+//   }
+//
+// The key always folds in the font atlas texture, font size and display size
+// and framebuffer scale, so an atlas grow or repack (new UVs) or a resize
+// rebuilds on its own.  Captured geometry must use the font atlas texture and
+// the list's current clip rect, which holds for everything drawn with
+// AddRect*/AddText on the foreground list.  A build that opened a new draw
+// command (texture or clip change, 64K vertex rollover) is not retained.
+//
+// FramePacer covers the whole overlay: between rebuilds at the configured
+// rate the SwapBuffers hook skips NewFrame..Render and submits the previous
+// ImDrawData again, which stays valid until the next NewFrame.
+//
+// Render thread only.
+
+#include "imgui.h"
+#include <string>
+
+namespace HudCache {
+
+// FNV-1a over the inputs that shape a layer.
+class Key {
+public:
+    Key() : _h(14695981039346656037ULL) {}
+
+    void Add(const void* data, size_t size);
+    void Add(bool v)               { Add(&v, sizeof(v)); }
+    void Add(int v)                { Add(&v, sizeof(v)); }
+    void Add(unsigned v)           { Add(&v, sizeof(v)); }
+    void Add(float v)              { Add(&v, sizeof(v)); }
+    void Add(const char* s);
+    void Add(const std::string& s) { Add(s.data(), s.size()); Add((unsigned)s.size()); }
+
+    unsigned long long Value() const { return _h; }
+
+private:
+    unsigned long long _h;
+};
+
+class Layer {
+public:
+    Layer();
+
+    // Appends the retained geometry to dst if it was captured for `key`
+    // under the current atlas/font/display.  False means rebuild.
+    bool Replay(ImDrawList* dst, unsigned long long key);
+
+    // Bracket a rebuild; everything appended to dst in between is retained.
+    void BeginCapture(ImDrawList* dst, unsigned long long key);
+    void EndCapture(ImDrawList* dst);
+
+    void Invalidate();
+
+    unsigned long Hits() const   { return _hits; }
+    unsigned long Misses() const { return _misses; }
+
+private:
+    ImVector<ImDrawVert> _vtx;
+    ImVector<ImDrawIdx>  _idx;
+    unsigned long long   _key;
+    bool                 _valid;
+
+    // Capture bookkeeping.
+    unsigned long long   _pendingUserKey;
+    unsigned long long   _pendingKey;
+    int                  _cmdCount;
+    int                  _vtxStart;
+    int                  _idxStart;
+    unsigned int         _baseIdx;
+    bool                 _capturing;
+
+    unsigned long        _hits;
+    unsigned long        _misses;
+};
+
+// Overlay rebuild pacing.  hz <= 0 rebuilds every frame.
+class FramePacer {
+public:
+    FramePacer();
+
+    // True if the last built frame may be submitted again instead of
+    // rebuilding: pacing is on, the period has not elapsed and the client
+    // area is still w x h.
+    bool CanReplay(int hz, int w, int h) const;
+    void MarkBuilt(int w, int h);
+    void MarkReplayed() { _replayed++; }
+
+    // Call when the last draw data must not be submitted again (backend
+    // reset, frames the overlay was skipped).
+    void Invalidate() { _valid = false; }
+
+    unsigned long Replayed() const { return _replayed; }
+
+private:
+    long long     _builtAt;   // QPC ticks
+    int           _w;
+    int           _h;
+    bool          _valid;
+    unsigned long _replayed;
+};
+
+} // namespace HudCache
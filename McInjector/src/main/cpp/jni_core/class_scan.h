@@ -0,0 +1,208 @@
+#pragma once
+// jni_core/class_scan.h
+// Parallel "first loaded class that matches" scan for discovery fallbacks.
+//
+// JVMTI GetLoadedClasses returns tens of thousands of classes on modded
+// installs, and the fallbacks reflect on each one (getDeclaredFields,
+// getType, ...).  Two things keep that short:
+//
+//   * Candidates drops every class whose JVMTI signature is an array, a
+//     primitive or a JDK / library package before any reflection runs.  The
+//     survivors are held as global refs, so other threads can use them.
+//   * FindFirst() hands the candidates out in blocks to the calling thread
+//     plus up to kMaxHelpers attached helper threads.  Each thread runs the
+//     predicate on its blocks in order and stops at its first match or when
+//     a lower index already matched.  The result is the lowest matching index,
+//     the same class a serial loop would return.
+//
+// Usage (discovery thread):
+//   ClassScan::Candidates set(env, jvmti, classes, classCount);
+//   int hit = ClassScan::FindFirst(g_jvm, set,
+//       [&](JNIEnv* e, jclass cls) { return /* reflection on cls via e */; });
+//   if (hit >= 0) keep = (jclass)env->NewGlobalRef(set[hit]);
+//
+// The predicate runs concurrently on several threads: it may only use the env
+// it is given, jmethodIDs / jfieldIDs and global refs.  Each call gets its own
+// local frame.  Candidates is not thread-safe; build and read it on the thread
+// that owns `env`.
+
+#include <jni.h>
+#include <jvmti.h>
+#include <windows.h>
+#include <cstring>
+#include <vector>
+#include "jni_core/scoped_env.h"
+#include "jni_core/local_frame.h"
+#include "thread_policy.h"
+
+namespace ClassScan {
+
+static const int  kMaxHelpers   = 3;     // plus the calling thread
+static const jint kBlock        = 64;    // candidates claimed at a time
+static const jint kPerThreadMin = 512;   // below this per thread, fewer threads
+static const jint kAccStatic    = 0x0008;
+
+// Game classes never live in these packages (JVM signature form).
+inline bool IsLibrarySignature(const char* sig) {
+    static const char* const kSkip[] = {
+        "Ljava/", "Lsun/", "Ljavax/", "Lcom/sun/", "Lorg/", "Ljdk/", "Lcom/google/", "Lio/", nullptr
+    };
+    if (!sig || sig[0] != 'L') return true;   // arrays, primitives
+    for (int i = 0; kSkip[i]; i++)
+        if (strncmp(sig, kSkip[i], strlen(kSkip[i])) == 0) return true;
+    return false;
+}
+
+struct Stats {
+    jint  loaded;       // classes JVMTI returned
+    jint  candidates;   // after the signature filter
+    jint  reflected;    // predicate calls
+    int   threads;      // including the caller
+    DWORD ms;
+};
+
+// Loaded classes that pass the signature filter.  Built on first use, so a
+// discovery pass that never needs a fallback scan pays nothing.
+class Candidates {
+public:
+    Candidates(JNIEnv* env, jvmtiEnv* jvmti, const jclass* classes, jint count)
+        : m_env(env), m_jvmti(jvmti), m_classes(classes), m_count(count), m_built(false) {}
+
+    ~Candidates() {
+        for (size_t i = 0; i < m_refs.size(); i++) m_env->DeleteGlobalRef(m_refs[i]);
+    }
+
+    void Ensure() {
+        if (m_built) return;
+        m_built = true;
+        m_refs.reserve(m_count > 0 ? (size_t)m_count : 0);
+        for (jint i = 0; i < m_count; i++) {
+            jclass cls = m_classes[i];
+            if (!cls) continue;
+            char* sig = nullptr;
+            if (m_jvmti->GetClassSignature(cls, &sig, nullptr) != JVMTI_ERROR_NONE) continue;
+            const bool skip = IsLibrarySignature(sig);
+            m_jvmti->Deallocate((unsigned char*)sig);
+            if (skip) continue;
+            jclass ref = (jclass)m_env->NewGlobalRef(cls);
+            if (ref) m_refs.push_back(ref);
+        }
+    }
+
+    JNIEnv* Env() const { return m_env; }
+    jint   Loaded() const { return m_count; }
+    jint   Size() const { return (jint)m_refs.size(); }
+    jclass operator[](jint i) const { return m_refs[(size_t)i]; }
+
+private:
+    Candidates(const Candidates&);
+    Candidates& operator=(const Candidates&);
+
+    JNIEnv*             m_env;
+    jvmtiEnv*           m_jvmti;
+    const jclass*       m_classes;
+    jint                m_count;
+    bool                m_built;
+    std::vector<jclass> m_refs;
+};
+
+namespace detail {
+
+template <typename Match>
+struct Pool {
+    JavaVM*           vm;
+    const Candidates* set;
+    Match*            match;
+    volatile LONG     cursor;      // next unclaimed block start
+    volatile LONG     best;        // lowest matching index, Size() when none
+    volatile LONG     reflected;
+
+    void Run(JNIEnv* env) {
+        const LONG size = set->Size();
+        LONG calls = 0;
+        for (;;) {
+            const LONG begin = InterlockedExchangeAdd(&cursor, kBlock);
+            if (begin >= size || begin >= best) break;
+            const LONG end = begin + kBlock < size ? begin + kBlock : size;
+            for (LONG i = begin; i < end && i < best; i++) {
+                LocalFrame frame(env, 32);
+                if (!frame.ok()) continue;
+                calls++;
+                const bool hit = (*match)(env, (*set)[i]);
+                if (env->ExceptionCheck()) env->ExceptionClear();
+                if (!hit) continue;
+                LONG seen = best;
+                while (i < seen) {
+                    const LONG prev = InterlockedCompareExchange(&best, i, seen);
+                    if (prev == seen) break;
+                    seen = prev;
+                }
+                break;   // the rest of this block is higher
+            }
+        }
+        InterlockedExchangeAdd(&reflected, calls);
+    }
+
+    static DWORD WINAPI HelperProc(LPVOID p) {
+        ThreadPolicy::Apply(ThreadPolicy::ROLE_BACKGROUND, "class-scan helper");
+        Pool* self = static_cast<Pool*>(p);
+        JNIEnv* env = JniEnv::Get(self->vm);
+        if (env) self->Run(env);
+        JniEnv::DetachThisThread(self->vm);
+        return 0;
+    }
+};
+
+inline int ThreadsFor(jint candidates) {
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    int n = (int)si.dwNumberOfProcessors;
+    if (n > kMaxHelpers + 1) n = kMaxHelpers + 1;
+    const int bySize = (int)(candidates / kPerThreadMin);
+    if (n > bySize) n = bySize;
+    return n < 1 ? 1 : n;
+}
+
+} // namespace detail
+
+// Index into `set` of the first candidate `match(env, cls)` accepts, or -1.
+// Runs on the calling thread (which must own the env `set` was built with)
+// and, for large sets, on helper threads attached to `vm` for the call.
+template <typename Match>
+int FindFirst(JavaVM* vm, Candidates& set, Match match, Stats* stats = nullptr) {
+    const DWORD startMs = GetTickCount();
+    set.Ensure();
+
+    detail::Pool<Match> pool;
+    pool.vm = vm;
+    pool.set = &set;
+    pool.match = &match;
+    pool.cursor = 0;
+    pool.best = set.Size();
+    pool.reflected = 0;
+
+    JNIEnv* env = set.Env();
+    const int threads = detail::ThreadsFor(set.Size());
+    HANDLE helpers[kMaxHelpers];
+    int helperCount = 0;
+    for (int i = 1; i < threads; i++) {
+        HANDLE h = CreateThread(nullptr, 0, &detail::Pool<Match>::HelperProc, &pool, 0, nullptr);
+        if (h) helpers[helperCount++] = h;
+    }
+    if (env) pool.Run(env);
+    if (helperCount) {
+        WaitForMultipleObjects((DWORD)helperCount, helpers, TRUE, INFINITE);
+        for (int i = 0; i < helperCount; i++) CloseHandle(helpers[i]);
+    }
+
+    if (stats) {
+        stats->loaded = set.Loaded();
+        stats->candidates = set.Size();
+        stats->reflected = pool.reflected;
+        stats->threads = helperCount + 1;
+        stats->ms = GetTickCount() - startMs;
+    }
+    return pool.best < set.Size() ? (int)pool.best : -1;
+}
+
+} // namespace ClassScan
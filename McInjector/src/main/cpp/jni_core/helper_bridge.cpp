@@ -1,6 +1,7 @@
 // jni_core/helper_bridge.cpp
 #include "helper_bridge.h"
 #include "aoko_helper.inc"   // kAokoHelperClassBytes[], kAokoHelperClassLen
+#include "ref_ledger.h"
 #include <cstring>
 
 namespace HelperBridge {
@@ -9,6 +10,13 @@ namespace HelperBridge {
 
 static jclass    s_helperClass   = nullptr; // global ref
 static jmethodID s_collectMethod = nullptr;
+static jmethodID s_collectWideMethod = nullptr;   // absent in older class bytes
+static jmethodID s_collectBlocksMethod = nullptr; // absent in older class bytes
+static jmethodID s_collectLegacyMethod = nullptr; // absent in older class bytes
+static jmethodID s_collectLegacyTilesMethod = nullptr;
+static jmethodID s_collectInventoryMethod = nullptr; // absent in older class bytes
+static jmethodID s_applyNametagMethod = nullptr;     // absent in older class bytes
+static jmethodID s_limitMethod   = nullptr; // ByteBuffer.limit()
 static jobject   s_directBuffer  = nullptr; // global ref, 256 KB
 static int       s_bufCapacity   = 0;
 
@@ -50,7 +58,20 @@ bool Load(JNIEnv* env, jobject classLoader) {
     env->DeleteLocalRef(ba);
 
     if (!defined) {
-        // Class may already be defined — try loading it
+        // Class may already be defined (re-Load after Unload) — ask the same loader for it
+        jclass loaderCls = env->GetObjectClass(classLoader);
+        jmethodID loadClass = loaderCls ? env->GetMethodID(loaderCls, "loadClass",
+                                                           "(Ljava/lang/String;)Ljava/lang/Class;") : nullptr;
+        if (env->ExceptionCheck()) { env->ExceptionClear(); loadClass = nullptr; }
+        jstring dotted = loadClass ? env->NewStringUTF("com.aoko.helper.AokoHelper") : nullptr;
+        if (dotted) {
+            defined = (jclass)env->CallObjectMethod(classLoader, loadClass, dotted);
+            if (env->ExceptionCheck()) { env->ExceptionClear(); defined = nullptr; }
+            env->DeleteLocalRef(dotted);
+        }
+        if (loaderCls) env->DeleteLocalRef(loaderCls);
+    }
+    if (!defined) {
         defined = (jclass)env->FindClass("com/aoko/helper/AokoHelper");
         if (env->ExceptionCheck()) { env->ExceptionClear(); defined = nullptr; }
     }
@@ -74,6 +95,73 @@ bool Load(JNIEnv* env, jobject classLoader) {
     if (env->ExceptionCheck()) { env->ExceptionClear(); s_collectMethod = nullptr; }
     if (!s_collectMethod) { env->DeleteLocalRef(defined); return false; }
 
+    // Resolve collectEntityFrameWide (optional)
+    s_collectWideMethod = env->GetStaticMethodID(defined, "collectEntityFrameWide",
+        "([Ljava/lang/Object;"
+        "Ljava/lang/Object;"
+        "[Ljava/lang/reflect/Method;"
+        "Ljava/lang/Object;"
+        "Ljava/nio/ByteBuffer;"
+        ")I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); s_collectWideMethod = nullptr; }
+
+    // Resolve collectBlockEntities (optional)
+    s_collectBlocksMethod = env->GetStaticMethodID(defined, "collectBlockEntities",
+        "(Ljava/lang/Object;"
+        "Ljava/lang/reflect/Method;"
+        "III"
+        "Ljava/lang/reflect/Field;"
+        "[Ljava/lang/Class;"
+        "Ljava/lang/reflect/Field;"
+        "Ljava/lang/reflect/Field;"
+        "Ljava/lang/reflect/Field;"
+        "Ljava/nio/ByteBuffer;"
+        ")I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); s_collectBlocksMethod = nullptr; }
+
+    // Resolve the 1.8.9 collectors (optional)
+    s_collectLegacyMethod = env->GetStaticMethodID(defined, "collectLegacyEntityFrame",
+        "(Ljava/util/List;"
+        "Ljava/lang/Object;"
+        "[Ljava/lang/reflect/Field;"
+        "[Ljava/lang/reflect/Method;"
+        "Ljava/nio/ByteBuffer;"
+        ")I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); s_collectLegacyMethod = nullptr; }
+    s_collectLegacyTilesMethod = env->GetStaticMethodID(defined, "collectLegacyTileEntities",
+        "(Ljava/util/List;"
+        "[Ljava/lang/Class;"
+        "Ljava/lang/reflect/Field;"
+        "Ljava/lang/reflect/Method;"
+        "Ljava/lang/reflect/Method;"
+        "Ljava/lang/reflect/Method;"
+        "Ljava/nio/ByteBuffer;"
+        ")I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); s_collectLegacyTilesMethod = nullptr; }
+
+    // Resolve collectInventory (optional)
+    s_collectInventoryMethod = env->GetStaticMethodID(defined, "collectInventory",
+        "(Ljava/lang/Object;"
+        "Ljava/lang/Object;"
+        "[Ljava/lang/reflect/Method;"
+        "[Ljava/lang/Object;"
+        "Ljava/nio/ByteBuffer;"
+        ")I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); s_collectInventoryMethod = nullptr; }
+
+    // Resolve applyNametagHide (optional)
+    s_applyNametagMethod = env->GetStaticMethodID(defined, "applyNametagHide",
+        "(Ljava/lang/Object;"
+        "Ljava/lang/Object;"
+        "Ljava/lang/Object;"
+        "[Ljava/lang/String;"
+        "[Ljava/lang/String;"
+        "[Ljava/lang/reflect/Method;"
+        "[Ljava/lang/Object;"
+        "Ljava/nio/ByteBuffer;"
+        ")I");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); s_applyNametagMethod = nullptr; }
+
     // Allocate direct ByteBuffer (native memory, owned by us)
     void* mem = malloc(kBufSize);
     if (!mem) { env->DeleteLocalRef(defined); return false; }
@@ -85,8 +173,9 @@ bool Load(JNIEnv* env, jobject classLoader) {
         return false;
     }
 
-    s_helperClass  = (jclass)env->NewGlobalRef(defined);
-    s_directBuffer = env->NewGlobalRef(localBuf);
+    static const int s_refs = RefLedger::Register("helper", 8);
+    s_helperClass  = (jclass)LC_NEW_GLOBAL_REF(env, defined, s_refs);
+    s_directBuffer = LC_NEW_GLOBAL_REF(env, localBuf, s_refs);
     s_bufCapacity  = kBufSize;
 
     env->DeleteLocalRef(localBuf);
@@ -102,18 +191,51 @@ void Unload(JNIEnv* env) {
         if (env) {
             void* addr = env->GetDirectBufferAddress(s_directBuffer);
             if (addr) free(addr);
-            env->DeleteGlobalRef(s_directBuffer);
+            RefLedger::Delete(env, s_directBuffer);
         }
         s_directBuffer = nullptr;
     }
     if (s_helperClass && env) {
-        env->DeleteGlobalRef(s_helperClass);
+        RefLedger::Delete(env, s_helperClass);
         s_helperClass = nullptr;
     }
     s_collectMethod = nullptr;
+    s_collectWideMethod = nullptr;
+    s_collectBlocksMethod = nullptr;
+    s_collectLegacyMethod = nullptr;
+    s_collectLegacyTilesMethod = nullptr;
+    s_collectInventoryMethod = nullptr;
+    s_applyNametagMethod = nullptr;
+    s_limitMethod   = nullptr;
     s_bufCapacity   = 0;
 }
 
+bool HasWideCollector() { return IsLoaded() && s_collectWideMethod != nullptr; }
+
+bool HasBlockEntityCollector() { return IsLoaded() && s_collectBlocksMethod != nullptr; }
+
+bool HasLegacyCollectors() {
+    return IsLoaded() && s_collectLegacyMethod != nullptr && s_collectLegacyTilesMethod != nullptr;
+}
+
+bool HasInventoryCollector() { return IsLoaded() && s_collectInventoryMethod != nullptr; }
+
+bool HasNametagApplier() { return IsLoaded() && s_applyNametagMethod != nullptr; }
+
+// Bytes the helper wrote: ByteBuffer.limit() after its flip().
+static jint BufferLimit(JNIEnv* env) {
+    jint cap = (jint)env->GetDirectBufferCapacity(s_directBuffer);
+    if (!s_limitMethod) {
+        jclass bbCls = env->GetObjectClass(s_directBuffer);
+        s_limitMethod = bbCls ? env->GetMethodID(bbCls, "limit", "()I") : nullptr;
+        if (env->ExceptionCheck()) { env->ExceptionClear(); s_limitMethod = nullptr; }
+        if (bbCls) env->DeleteLocalRef(bbCls);
+    }
+    jint limit = s_limitMethod ? env->CallIntMethod(s_directBuffer, s_limitMethod) : cap;
+    if (env->ExceptionCheck()) { env->ExceptionClear(); limit = cap; }
+    return (limit < 0 || limit > cap) ? cap : limit;
+}
+
 // ── CollectEntities ───────────────────────────────────────────────────────────
 
 int CollectEntities(
@@ -149,17 +271,13 @@ int CollectEntities(
     // Decode the ByteBuffer (little-endian, position=0 after flip() in Java)
     const unsigned char* buf = static_cast<const unsigned char*>(
         env->GetDirectBufferAddress(s_directBuffer));
-    jlong cap = env->GetDirectBufferCapacity(s_directBuffer);
     if (!buf) return -1;
+    return DecodeEntityFrame(buf, BufferLimit(env), n, out);
+}
 
-    // Read limit from ByteBuffer.limit()
-    jclass bbCls = env->GetObjectClass(s_directBuffer);
-    jmethodID mLimit = bbCls ? env->GetMethodID(bbCls, "limit", "()I") : nullptr;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); mLimit = nullptr; }
-    jint limit = mLimit ? env->CallIntMethod(s_directBuffer, mLimit) : (jint)cap;
-    if (env->ExceptionCheck()) { env->ExceptionClear(); limit = (jint)cap; }
-    if (bbCls) env->DeleteLocalRef(bbCls);
-
+int DecodeEntityFrame(const unsigned char* buf, int limit, int n, EntityFrame& out)
+{
+    out.entities.clear();
     out.entities.reserve(n);
     int pos = 0;
     for (int i = 0; i < n && pos + 32 <= limit; i++) {
@@ -179,4 +297,285 @@ int CollectEntities(
     return (int)out.entities.size();
 }
 
+// ── CollectEntitiesWide ───────────────────────────────────────────────────────
+
+static_assert(sizeof(WideEntityRecord) == 80, "records are copied straight from the buffer");
+
+int CollectEntitiesWide(
+    JNIEnv*      env,
+    jobjectArray entities,
+    jobject      selfEntity,
+    jobjectArray handles,
+    jobject      scoreboard,
+    WideEntityFrame& out)
+{
+    out.records.clear();
+    out.pool.clear();
+    if (!HasWideCollector() || !env || !entities || !handles) return -1;
+
+    jint n = env->CallStaticIntMethod(
+        s_helperClass, s_collectWideMethod,
+        entities, selfEntity, handles, scoreboard,
+        s_directBuffer);
+
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return -1; }
+    if (n < 0) return -1;
+
+    const unsigned char* buf = static_cast<const unsigned char*>(
+        env->GetDirectBufferAddress(s_directBuffer));
+    if (!buf) return -1;
+    return DecodeWideFrame(buf, BufferLimit(env), n, out);
+}
+
+int DecodeWideFrame(const unsigned char* buf, int limit, int n, WideEntityFrame& out)
+{
+    out.records.clear();
+    out.pool.clear();
+    if (limit < 8) return -1;
+
+    // Header { int count; int poolStart; }, records, then the string pool.
+    int count = 0, poolStart = 0;
+    memcpy(&count,     buf,     4);
+    memcpy(&poolStart, buf + 4, 4);
+    if (count != n || poolStart < 8 || poolStart > limit || count > (poolStart - 8) / 80) return -1;
+
+    out.records.resize(count);
+    if (count > 0) memcpy(&out.records[0], buf + 8, (size_t)count * 80);
+    out.pool.assign(reinterpret_cast<const char*>(buf + poolStart), (size_t)(limit - poolStart));
+    return count;
+}
+
+// ── CollectLegacyEntities ─────────────────────────────────────────────────────
+
+static_assert(sizeof(LegacyEntityRecord) == 80, "records are copied straight from the buffer");
+
+int CollectLegacyEntities(
+    JNIEnv*      env,
+    jobject      entityList,
+    jobject      selfEntity,
+    jobjectArray fields,
+    jobjectArray methods,
+    LegacyEntityFrame& out)
+{
+    out.records.clear();
+    out.pool.clear();
+    if (!HasLegacyCollectors() || !env || !entityList || !fields || !methods) return -1;
+
+    jint n = env->CallStaticIntMethod(
+        s_helperClass, s_collectLegacyMethod,
+        entityList, selfEntity, fields, methods,
+        s_directBuffer);
+
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return -1; }
+    if (n < 0) return -1;
+
+    const unsigned char* buf = static_cast<const unsigned char*>(
+        env->GetDirectBufferAddress(s_directBuffer));
+    if (!buf) return -1;
+    jint limit = BufferLimit(env);
+    if (limit < 8) return -1;
+
+    int count = 0, poolStart = 0;
+    memcpy(&count,     buf,     4);
+    memcpy(&poolStart, buf + 4, 4);
+    if (count != n || poolStart < 8 || poolStart > limit || count > (poolStart - 8) / 80) return -1;
+
+    out.records.resize(count);
+    if (count > 0) memcpy(&out.records[0], buf + 8, (size_t)count * 80);
+    out.pool.assign(reinterpret_cast<const char*>(buf + poolStart), (size_t)(limit - poolStart));
+    return count;
+}
+
+// ── CollectLegacyTileEntities ─────────────────────────────────────────────────
+
+int CollectLegacyTileEntities(
+    JNIEnv*      env,
+    jobject      tileList,
+    jobjectArray kinds,
+    jobject      fTilePos,
+    jobject      mPosX,
+    jobject      mPosY,
+    jobject      mPosZ,
+    BlockEntityFrame& out)
+{
+    out.chunks.clear();
+    out.records.clear();
+    if (!HasLegacyCollectors() || !env || !tileList || !kinds || !fTilePos
+        || !mPosX || !mPosY || !mPosZ)
+        return -1;
+
+    jint n = env->CallStaticIntMethod(
+        s_helperClass, s_collectLegacyTilesMethod,
+        tileList, kinds, fTilePos, mPosX, mPosY, mPosZ,
+        s_directBuffer);
+
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return -1; }
+    if (n != 1) return -1;
+
+    const unsigned char* buf = static_cast<const unsigned char*>(
+        env->GetDirectBufferAddress(s_directBuffer));
+    if (!buf) return -1;
+    jint limit = BufferLimit(env);
+    if (limit < 8) return -1;
+
+    BlockEntityChunk c;
+    memcpy(&c.count,   buf,     4);
+    memcpy(&c.scanned, buf + 4, 4);
+    c.first = 0;
+    if (c.count < 0 || c.count > (limit - 8) / 16) return -1;
+    out.records.resize(c.count);
+    if (c.count > 0) memcpy(&out.records[0], buf + 8, (size_t)c.count * 16);
+    out.chunks.push_back(c);
+    return 1;
+}
+
+// ── CollectBlockEntities ──────────────────────────────────────────────────────
+
+static_assert(sizeof(BlockEntityRecord) == 16, "records are copied straight from the buffer");
+
+int CollectBlockEntities(
+    JNIEnv*      env,
+    jobject      world,
+    jobject      mGetChunk,
+    int          centerX,
+    int          centerZ,
+    int          range,
+    jobject      fBlockEntities,
+    jobjectArray kinds,
+    jobject      fPosX,
+    jobject      fPosY,
+    jobject      fPosZ,
+    BlockEntityFrame& out)
+{
+    out.chunks.clear();
+    out.records.clear();
+    if (!HasBlockEntityCollector() || !env || !world || !mGetChunk || !fBlockEntities
+        || !kinds || !fPosX || !fPosY || !fPosZ || range < 0)
+        return -1;
+
+    jint n = env->CallStaticIntMethod(
+        s_helperClass, s_collectBlocksMethod,
+        world, mGetChunk,
+        (jint)centerX, (jint)centerZ, (jint)range,
+        fBlockEntities, kinds,
+        fPosX, fPosY, fPosZ,
+        s_directBuffer);
+
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return -1; }
+    if (n < 0) return -1;
+
+    const unsigned char* buf = static_cast<const unsigned char*>(
+        env->GetDirectBufferAddress(s_directBuffer));
+    if (!buf) return -1;
+    jint limit = BufferLimit(env);
+
+    // Header { int count; int scanned; } then count x { int x, y, z, kind; }
+    out.chunks.reserve(n);
+    int pos = 0;
+    for (int i = 0; i < n && pos + 8 <= limit; i++) {
+        BlockEntityChunk c;
+        memcpy(&c.count,   buf + pos, 4); pos += 4;
+        memcpy(&c.scanned, buf + pos, 4); pos += 4;
+        c.first = (int)out.records.size();
+        if (c.count > 0) {
+            if (c.count > (limit - pos) / 16) return -1;
+            size_t base = out.records.size();
+            out.records.resize(base + c.count);
+            memcpy(&out.records[base], buf + pos, (size_t)c.count * 16);
+            pos += c.count * 16;
+        }
+        out.chunks.push_back(c);
+    }
+
+    return (int)out.chunks.size();
+}
+
+// ── CollectInventory ──────────────────────────────────────────────────────────
+
+static_assert(sizeof(InventorySlot) == 12, "slots are copied straight from the buffer");
+
+int CollectInventory(
+    JNIEnv*      env,
+    jobject      inventory,
+    jobject      player,
+    jobjectArray handles,
+    jobjectArray kinds,
+    InventoryFrame& out)
+{
+    out.slots.clear();
+    out.offhand.kind = kSlotEmpty;
+    out.offhand.itemId = 0;
+    out.offhand.count = 0;
+    if (!HasInventoryCollector() || !env || !inventory || !handles || !kinds) return -1;
+
+    jint n = env->CallStaticIntMethod(
+        s_helperClass, s_collectInventoryMethod,
+        inventory, player, handles, kinds,
+        s_directBuffer);
+
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return -1; }
+    if (n < 0) return -1;
+
+    const unsigned char* buf = static_cast<const unsigned char*>(
+        env->GetDirectBufferAddress(s_directBuffer));
+    if (!buf) return -1;
+    jint limit = BufferLimit(env);
+
+    // int slots, then (slots + 1) x { int kind, itemId, count; }, offhand last
+    int slots = 0;
+    if (limit < 4) return -1;
+    memcpy(&slots, buf, 4);
+    if (slots != n || slots > (limit - 4) / 12 - 1) return -1;
+    out.slots.resize(slots);
+    if (slots > 0) memcpy(&out.slots[0], buf + 4, (size_t)slots * 12);
+    memcpy(&out.offhand, buf + 4 + (size_t)slots * 12, 12);
+    return slots;
+}
+
+// ── ApplyNametagHide ──────────────────────────────────────────────────────────
+
+int ApplyNametagHide(
+    JNIEnv*      env,
+    jobject      scoreboard,
+    jobject      hideTeam,
+    jobject      never,
+    jobjectArray joins,
+    jobjectArray leaves,
+    jobjectArray handles,
+    jobjectArray originals,
+    std::vector<NametagJoinResult>& out)
+{
+    out.clear();
+    if (!HasNametagApplier() || !env || !scoreboard || !joins || !leaves || !handles || !originals) return -1;
+
+    jint n = env->CallStaticIntMethod(
+        s_helperClass, s_applyNametagMethod,
+        scoreboard, hideTeam, never, joins, leaves, handles, originals,
+        s_directBuffer);
+
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return -1; }
+    if (n < 0) return -1;
+
+    const unsigned char* buf = static_cast<const unsigned char*>(
+        env->GetDirectBufferAddress(s_directBuffer));
+    if (!buf) return -1;
+    jint limit = BufferLimit(env);
+
+    // int count, int poolStart, count x { int status, teamOff, teamLen; }, pool
+    if (limit < 8) return -1;
+    int count = 0, poolStart = 0;
+    memcpy(&count, buf, 4);
+    memcpy(&poolStart, buf + 4, 4);
+    if (count != n || poolStart < 8 || poolStart > limit || count > (poolStart - 8) / 12) return -1;
+    out.resize(count);
+    for (int i = 0; i < count; i++) {
+        int rec[3];
+        memcpy(rec, buf + 8 + i * 12, 12);
+        out[i].status = rec[0];
+        if (rec[2] > 0 && rec[1] >= 0 && rec[1] + rec[2] <= limit - poolStart)
+            out[i].team.assign(reinterpret_cast<const char*>(buf + poolStart + rec[1]), (size_t)rec[2]);
+    }
+    return count;
+}
+
 } // namespace HelperBridge
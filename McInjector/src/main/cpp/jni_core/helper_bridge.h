@@ -1,7 +1,9 @@
 #pragma once
 // jni_core/helper_bridge.h
-// Loads AokoHelper.class into the game JVM and exposes a typed C++ call to
-// collectEntityFrame().
+// Loads AokoHelper.class into the game JVM and exposes typed C++ calls to
+// collectEntityFrame(), collectEntityFrameWide(), collectBlockEntities(),
+// collectInventory() and applyNametagHide(), plus the 1.8.9 variants
+// collectLegacyEntityFrame() and collectLegacyTileEntities().
 //
 // Usage (once, during discovery):
 //   HelperBridge::Load(env, gameClassLoader);
@@ -14,6 +16,12 @@
 //                                         getHealthMethod, getNameMethod,
 //                                         frame);
 //   for (int i = 0; i < n; i++) { auto& e = frame.entities[i]; ... }
+//
+//   HelperBridge::BlockEntityFrame beFrame;
+//   if (HelperBridge::CollectBlockEntities(env, world, getChunkMethod, cx, cz, range,
+//                                          blockEntitiesField, kindClasses,
+//                                          posXField, posYField, posZField, beFrame) >= 0)
+//       for (auto& c : beFrame.chunks) { beFrame.records[c.first .. c.first + c.count) ... }
 
 #include <jni.h>
 #include <string>
@@ -33,6 +41,144 @@ struct EntityFrame {
     std::vector<EntitySnapshot> entities;
 };
 
+// Indices into the Method[] handed to CollectEntitiesWide (AokoHelper.H_*).
+enum WideHandle {
+    kGetX, kGetY, kGetZ, kGetHealth, kGetArmor,
+    kMainHand, kStackName, kStackDamage, kStackMaxDamage,
+    kGetName, kTextString, kGameProfile, kProfileName,
+    kGetId, kHolderTeam, kTeamName,
+    kWideHandleCount
+};
+
+// Offset/length of a string in WideEntityFrame::pool.
+struct PoolString {
+    int off, len;
+};
+
+// One fixed-stride record from collectEntityFrameWide(), copied as-is.
+struct WideEntityRecord {
+    int    index;          // position in the entity array that was passed in
+    int    entityId;       // Entity.getId(), -1 if unavailable
+    double x, y, z;
+    float  health;
+    int    armor;
+    int    heldDamage, heldMaxDamage;
+    PoolString name;       // display name
+    PoolString profile;    // GameProfile name
+    PoolString held;       // held item display name
+    PoolString team;       // scoreboard team name
+};
+
+// Decoded wide frame: records in array order plus the shared string pool.
+struct WideEntityFrame {
+    std::vector<WideEntityRecord> records;
+    std::string pool;
+
+    std::string Str(const PoolString& s) const {
+        if (s.len <= 0 || s.off < 0 || (size_t)s.off + (size_t)s.len > pool.size()) return std::string();
+        return pool.substr((size_t)s.off, (size_t)s.len);
+    }
+};
+
+// Indices into the Field[] / Method[] handed to CollectLegacyEntities
+// (AokoHelper.LF_* / LM_*).
+enum LegacyField {
+    kLegacyPosX, kLegacyPosY, kLegacyPosZ,
+    kLegacyLastX, kLegacyLastY, kLegacyLastZ,
+    kLegacyFieldCount
+};
+enum LegacyMethod {
+    kLegacyGetHealth, kLegacyGetArmor, kLegacyGetName,
+    kLegacyGameProfile, kLegacyProfileName,
+    kLegacyMethodCount
+};
+
+// One fixed-stride record from collectLegacyEntityFrame(), copied as-is.
+struct LegacyEntityRecord {
+    int    index;          // position in World.playerEntities
+    int    hash;           // Object.hashCode()
+    double x, y, z;
+    double lastX, lastY, lastZ;
+    float  health;
+    int    armor;          // -1 if unavailable
+    PoolString name;       // getName()
+    PoolString profile;    // GameProfile name
+};
+
+// Decoded legacy frame; same header/pool layout as WideEntityFrame.
+struct LegacyEntityFrame {
+    std::vector<LegacyEntityRecord> records;
+    std::string pool;
+
+    std::string Str(const PoolString& s) const {
+        if (s.len <= 0 || s.off < 0 || (size_t)s.off + (size_t)s.len > pool.size()) return std::string();
+        return pool.substr((size_t)s.off, (size_t)s.len);
+    }
+};
+
+// One block entity from collectBlockEntities(): block coordinates and the
+// index of the matching class in the kinds array.
+struct BlockEntityRecord {
+    int x, y, z;
+    int kind;
+};
+
+// Per-chunk result, in the helper's dx-major window order.
+struct BlockEntityChunk {
+    int count;     // records in this chunk; kChunkMissing / kChunkFailed otherwise
+    int scanned;   // block entities the helper looked at
+    int first;     // index of the chunk's first record in BlockEntityFrame::records
+};
+
+static const int kChunkMissing = -1;   // chunk or its block-entity map not available
+static const int kChunkFailed  = -2;   // map changed under the walk; no records
+
+struct BlockEntityFrame {
+    std::vector<BlockEntityChunk>  chunks;
+    std::vector<BlockEntityRecord> records;
+};
+
+// Indices into the Method[] handed to CollectInventory (AokoHelper.INV_*).
+enum InventoryHandle {
+    kInvGetSize, kInvGetItem, kInvGetOffhand,
+    kInvStackItem, kInvStackCount, kInvStackEmpty,
+    kInventoryHandleCount
+};
+
+// One slot from collectInventory(), copied as-is.
+struct InventorySlot {
+    int kind;      // index into the kinds array, kSlotOther or kSlotEmpty
+    int itemId;    // System.identityHashCode of the Item, 0 when empty
+    int count;
+};
+
+static const int kSlotOther = -1;   // an item not in kinds
+static const int kSlotEmpty = -2;
+
+struct InventoryFrame {
+    std::vector<InventorySlot> slots;   // Inventory.getItem(0 .. getContainerSize() - 1)
+    InventorySlot offhand;
+};
+
+// Indices into the Method[] handed to ApplyNametagHide (AokoHelper.NT_*).
+enum NametagHandle {
+    kNtHolderTeam, kNtAddHolder, kNtRemoveHolder,
+    kNtTeamName, kNtGetVisibility, kNtSetVisibility,
+    kNametagHandleCount
+};
+
+// Per-join outcome of applyNametagHide() (AokoHelper.NT_STATUS_*).
+enum NametagStatus {
+    kNtFailed = 0,
+    kNtOnHideTeam = 1,     // on the client-only hide team (added now or already)
+    kNtOnServerTeam = 2    // on a server team whose visibility was set to never
+};
+
+struct NametagJoinResult {
+    int status;
+    std::string team;      // server team name for kNtOnServerTeam, may be empty
+};
+
 // Load AokoHelper.class into the JVM via classLoader.defineClass().
 // Safe to call multiple times — no-op if already loaded.
 // Returns true if the class is ready.
@@ -41,6 +187,22 @@ bool Load(JNIEnv* env, jobject classLoader);
 // Returns true if Load() has succeeded.
 bool IsLoaded();
 
+// Returns true if the loaded class also has collectBlockEntities (older
+// embedded class bytes only carry collectEntityFrame).
+bool HasBlockEntityCollector();
+
+// Same for collectEntityFrameWide.
+bool HasWideCollector();
+
+// Same for collectLegacyEntityFrame / collectLegacyTileEntities.
+bool HasLegacyCollectors();
+
+// Same for collectInventory.
+bool HasInventoryCollector();
+
+// Same for applyNametagHide.
+bool HasNametagApplier();
+
 // Release all JNI global refs and free the native buffer.
 // Call during DLL detach or bridge shutdown.
 void Unload(JNIEnv* env);
@@ -63,4 +225,96 @@ int CollectEntities(
     jobject    mGetName,    // java.lang.reflect.Method (Entity.getName)
     EntityFrame& out);
 
+// Call AokoHelper.collectEntityFrameWide() over an Object[] of entities.
+// handles is a java.lang.reflect.Method[kWideHandleCount]; only the getX/Y/Z
+// entries must be set.  scoreboard may be nullptr (no team names).  One JNI
+// crossing per call; out keeps its capacity between calls.
+// Returns the number of records, or -1 on error.
+int CollectEntitiesWide(
+    JNIEnv*      env,
+    jobjectArray entities,
+    jobject      selfEntity,
+    jobjectArray handles,
+    jobject      scoreboard,
+    WideEntityFrame& out);
+
+// The decoders behind CollectEntities / CollectEntitiesWide, on a filled
+// buffer region [buf, buf + limit) for which the helper reported n entries.
+// No JNI; the native bench runs them over synthetic frames.
+int DecodeEntityFrame(const unsigned char* buf, int limit, int n, EntityFrame& out);
+int DecodeWideFrame(const unsigned char* buf, int limit, int n, WideEntityFrame& out);
+
+// Call AokoHelper.collectBlockEntities() over the (2*range+1)^2 chunk window
+// around (centerX, centerZ) and decode the result into out.  kinds is a
+// Class[] of block-entity classes to report (entries may be null).
+// Returns the number of chunks decoded, or -1 on error or a full buffer.
+int CollectBlockEntities(
+    JNIEnv*      env,
+    jobject      world,
+    jobject      mGetChunk,       // java.lang.reflect.Method (World.getChunk(int,int))
+    int          centerX,
+    int          centerZ,
+    int          range,
+    jobject      fBlockEntities,  // java.lang.reflect.Field (Chunk.blockEntities)
+    jobjectArray kinds,           // java.lang.Class[]
+    jobject      fPosX,           // java.lang.reflect.Field (BlockPos x)
+    jobject      fPosY,
+    jobject      fPosZ,
+    BlockEntityFrame& out);
+
+// Call AokoHelper.collectLegacyEntityFrame() over World.playerEntities.
+// fields is a java.lang.reflect.Field[kLegacyFieldCount] (posX/Y/Z required),
+// methods a java.lang.reflect.Method[kLegacyMethodCount] (entries may be null).
+// Returns the number of records, or -1 on error.
+int CollectLegacyEntities(
+    JNIEnv*      env,
+    jobject      entityList,
+    jobject      selfEntity,
+    jobjectArray fields,
+    jobjectArray methods,
+    LegacyEntityFrame& out);
+
+// Call AokoHelper.collectLegacyTileEntities() over World.loadedTileEntityList.
+// Decodes into a single chunk entry; a kind equal to the length of kinds
+// means "class name contains Chest".
+// Returns 1 on success, or -1 on error or a full buffer.
+int CollectLegacyTileEntities(
+    JNIEnv*      env,
+    jobject      tileList,
+    jobjectArray kinds,           // java.lang.Class[]
+    jobject      fTilePos,        // java.lang.reflect.Field (TileEntity.pos)
+    jobject      mPosX,           // java.lang.reflect.Method (BlockPos.getX)
+    jobject      mPosY,
+    jobject      mPosZ,
+    BlockEntityFrame& out);
+
+// Call AokoHelper.collectInventory() and decode every slot plus the offhand
+// into out.  handles is a java.lang.reflect.Method[kInventoryHandleCount]
+// (offhand and isEmpty may be null); kinds is an Object[] of Item objects
+// matched by identity.  player may be nullptr (offhand reported empty).
+// Returns the number of slots, or -1 on error.
+int CollectInventory(
+    JNIEnv*      env,
+    jobject      inventory,
+    jobject      player,
+    jobjectArray handles,
+    jobjectArray kinds,
+    InventoryFrame& out);
+
+// Call AokoHelper.applyNametagHide() with String[] joins and leaves and
+// decode one result per join into out.  handles is a
+// java.lang.reflect.Method[kNametagHandleCount]; originals is an
+// Object[joins length] the helper fills with the previous visibility of
+// every server team it changed.  Returns the number of joins, or -1 on error.
+int ApplyNametagHide(
+    JNIEnv*      env,
+    jobject      scoreboard,
+    jobject      hideTeam,
+    jobject      never,
+    jobjectArray joins,
+    jobjectArray leaves,
+    jobjectArray handles,
+    jobjectArray originals,
+    std::vector<NametagJoinResult>& out);
+
 } // namespace HelperBridge
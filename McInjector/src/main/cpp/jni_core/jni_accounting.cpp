@@ -0,0 +1,444 @@
+// jni_core/jni_accounting.cpp
+#include "jni_accounting.h"
+#include "../async_log.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace JniAccounting {
+
+namespace {
+
+struct Module {
+    const char*   name;
+    volatile LONG budget;
+    volatile LONG counts[kCounterCount];
+    volatile LONG runs;
+    volatile LONG overBudget;
+    volatile LONG64 totalUs;
+    volatile LONG maxUs;
+    volatile LONG lastRun;
+    volatile LONG lastOver;
+    AsyncLog::RateGate warnGate;
+};
+
+Module        s_modules[kMaxModules];
+volatile LONG s_moduleCount = 0;
+
+// The JVM's table and the counting copy, built on the first Scope.
+const JNINativeInterface_* volatile s_real = nullptr;
+JNINativeInterface_ s_counting;
+volatile LONG s_tableState = 0;   // 0 = not built, 1 = building, 2 = ready
+
+DWORD TlsSlot() {
+    static DWORD s_slot = TlsAlloc();
+    return s_slot;
+}
+
+long long NowQpc() {
+    LARGE_INTEGER c;
+    QueryPerformanceCounter(&c);
+    return c.QuadPart;
+}
+
+long long QpcFreq() {
+    static LARGE_INTEGER s_freq = { { 0, 0 } };
+    if (s_freq.QuadPart == 0) QueryPerformanceFrequency(&s_freq);
+    return s_freq.QuadPart;
+}
+
+// Module of the innermost open Scope on this thread, as id + 1 (0 = none).
+inline LONG_PTR CurrentTag() {
+    DWORD slot = TlsSlot();
+    return slot == TLS_OUT_OF_INDEXES ? 0 : (LONG_PTR)TlsGetValue(slot);
+}
+
+inline void Bump(int counter) {
+    LONG_PTR tag = CurrentTag();
+    if (tag > 0) InterlockedIncrement(&s_modules[tag - 1].counts[counter]);
+}
+
+unsigned long SumCounts(const Module& m) {
+    unsigned long n = 0;
+    for (int i = 0; i < kCounterCount; i++) n += (unsigned long)m.counts[i];
+    return n;
+}
+
+// ── Counting wrappers ─────────────────────────────────────────────────────────
+// Each bumps the tagged module and forwards to the JVM's entry.  The variadic
+// forms forward through the ...V entries.
+
+#define LC_ACCT_CALLS(Type, jtype)                                                                     \
+    jtype JNICALL Acct_Call##Type##Method(JNIEnv* env, jobject obj, jmethodID mid, ...) {              \
+        Bump(kCalls);                                                                                  \
+        va_list args;                                                                                  \
+        va_start(args, mid);                                                                           \
+        jtype r = s_real->Call##Type##MethodV(env, obj, mid, args);                                    \
+        va_end(args);                                                                                  \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Acct_Call##Type##MethodV(JNIEnv* env, jobject obj, jmethodID mid, va_list args) {    \
+        Bump(kCalls);                                                                                  \
+        return s_real->Call##Type##MethodV(env, obj, mid, args);                                       \
+    }                                                                                                  \
+    jtype JNICALL Acct_Call##Type##MethodA(JNIEnv* env, jobject obj, jmethodID mid, const jvalue* a) { \
+        Bump(kCalls);                                                                                  \
+        return s_real->Call##Type##MethodA(env, obj, mid, a);                                          \
+    }                                                                                                  \
+    jtype JNICALL Acct_CallNonvirtual##Type##Method(JNIEnv* env, jobject obj, jclass cls,              \
+                                                    jmethodID mid, ...) {                              \
+        Bump(kCalls);                                                                                  \
+        va_list args;                                                                                  \
+        va_start(args, mid);                                                                           \
+        jtype r = s_real->CallNonvirtual##Type##MethodV(env, obj, cls, mid, args);                     \
+        va_end(args);                                                                                  \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Acct_CallNonvirtual##Type##MethodV(JNIEnv* env, jobject obj, jclass cls,             \
+                                                     jmethodID mid, va_list args) {                    \
+        Bump(kCalls);                                                                                  \
+        return s_real->CallNonvirtual##Type##MethodV(env, obj, cls, mid, args);                        \
+    }                                                                                                  \
+    jtype JNICALL Acct_CallNonvirtual##Type##MethodA(JNIEnv* env, jobject obj, jclass cls,             \
+                                                     jmethodID mid, const jvalue* a) {                 \
+        Bump(kCalls);                                                                                  \
+        return s_real->CallNonvirtual##Type##MethodA(env, obj, cls, mid, a);                           \
+    }                                                                                                  \
+    jtype JNICALL Acct_CallStatic##Type##Method(JNIEnv* env, jclass cls, jmethodID mid, ...) {         \
+        Bump(kCalls);                                                                                  \
+        va_list args;                                                                                  \
+        va_start(args, mid);                                                                           \
+        jtype r = s_real->CallStatic##Type##MethodV(env, cls, mid, args);                              \
+        va_end(args);                                                                                  \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Acct_CallStatic##Type##MethodV(JNIEnv* env, jclass cls, jmethodID mid, va_list args) { \
+        Bump(kCalls);                                                                                  \
+        return s_real->CallStatic##Type##MethodV(env, cls, mid, args);                                 \
+    }                                                                                                  \
+    jtype JNICALL Acct_CallStatic##Type##MethodA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue* a) { \
+        Bump(kCalls);                                                                                  \
+        return s_real->CallStatic##Type##MethodA(env, cls, mid, a);                                    \
+    }
+
+#define LC_ACCT_FIELDS(Type, jtype)                                                                    \
+    jtype JNICALL Acct_Get##Type##Field(JNIEnv* env, jobject obj, jfieldID fid) {                      \
+        Bump(kFieldReads);                                                                             \
+        return s_real->Get##Type##Field(env, obj, fid);                                                \
+    }                                                                                                  \
+    void JNICALL Acct_Set##Type##Field(JNIEnv* env, jobject obj, jfieldID fid, jtype v) {              \
+        Bump(kFieldWrites);                                                                            \
+        s_real->Set##Type##Field(env, obj, fid, v);                                                    \
+    }                                                                                                  \
+    jtype JNICALL Acct_GetStatic##Type##Field(JNIEnv* env, jclass cls, jfieldID fid) {                 \
+        Bump(kFieldReads);                                                                             \
+        return s_real->GetStatic##Type##Field(env, cls, fid);                                          \
+    }                                                                                                  \
+    void JNICALL Acct_SetStatic##Type##Field(JNIEnv* env, jclass cls, jfieldID fid, jtype v) {         \
+        Bump(kFieldWrites);                                                                            \
+        s_real->SetStatic##Type##Field(env, cls, fid, v);                                              \
+    }
+
+#define LC_ACCT_TYPES(X) \
+    X(Object, jobject) X(Boolean, jboolean) X(Byte, jbyte) X(Char, jchar) X(Short, jshort) \
+    X(Int, jint) X(Long, jlong) X(Float, jfloat) X(Double, jdouble)
+
+LC_ACCT_TYPES(LC_ACCT_CALLS)
+LC_ACCT_TYPES(LC_ACCT_FIELDS)
+
+void JNICALL Acct_CallVoidMethod(JNIEnv* env, jobject obj, jmethodID mid, ...) {
+    Bump(kCalls);
+    va_list args;
+    va_start(args, mid);
+    s_real->CallVoidMethodV(env, obj, mid, args);
+    va_end(args);
+}
+void JNICALL Acct_CallVoidMethodV(JNIEnv* env, jobject obj, jmethodID mid, va_list args) {
+    Bump(kCalls);
+    s_real->CallVoidMethodV(env, obj, mid, args);
+}
+void JNICALL Acct_CallVoidMethodA(JNIEnv* env, jobject obj, jmethodID mid, const jvalue* a) {
+    Bump(kCalls);
+    s_real->CallVoidMethodA(env, obj, mid, a);
+}
+void JNICALL Acct_CallNonvirtualVoidMethod(JNIEnv* env, jobject obj, jclass cls, jmethodID mid, ...) {
+    Bump(kCalls);
+    va_list args;
+    va_start(args, mid);
+    s_real->CallNonvirtualVoidMethodV(env, obj, cls, mid, args);
+    va_end(args);
+}
+void JNICALL Acct_CallNonvirtualVoidMethodV(JNIEnv* env, jobject obj, jclass cls, jmethodID mid, va_list args) {
+    Bump(kCalls);
+    s_real->CallNonvirtualVoidMethodV(env, obj, cls, mid, args);
+}
+void JNICALL Acct_CallNonvirtualVoidMethodA(JNIEnv* env, jobject obj, jclass cls, jmethodID mid, const jvalue* a) {
+    Bump(kCalls);
+    s_real->CallNonvirtualVoidMethodA(env, obj, cls, mid, a);
+}
+void JNICALL Acct_CallStaticVoidMethod(JNIEnv* env, jclass cls, jmethodID mid, ...) {
+    Bump(kCalls);
+    va_list args;
+    va_start(args, mid);
+    s_real->CallStaticVoidMethodV(env, cls, mid, args);
+    va_end(args);
+}
+void JNICALL Acct_CallStaticVoidMethodV(JNIEnv* env, jclass cls, jmethodID mid, va_list args) {
+    Bump(kCalls);
+    s_real->CallStaticVoidMethodV(env, cls, mid, args);
+}
+void JNICALL Acct_CallStaticVoidMethodA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue* a) {
+    Bump(kCalls);
+    s_real->CallStaticVoidMethodA(env, cls, mid, a);
+}
+
+jobject JNICALL Acct_NewObject(JNIEnv* env, jclass cls, jmethodID mid, ...) {
+    Bump(kCalls);
+    va_list args;
+    va_start(args, mid);
+    jobject r = s_real->NewObjectV(env, cls, mid, args);
+    va_end(args);
+    return r;
+}
+jobject JNICALL Acct_NewObjectV(JNIEnv* env, jclass cls, jmethodID mid, va_list args) {
+    Bump(kCalls);
+    return s_real->NewObjectV(env, cls, mid, args);
+}
+jobject JNICALL Acct_NewObjectA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue* a) {
+    Bump(kCalls);
+    return s_real->NewObjectA(env, cls, mid, a);
+}
+
+jobject JNICALL Acct_NewGlobalRef(JNIEnv* env, jobject obj) {
+    Bump(kRefs);
+    return s_real->NewGlobalRef(env, obj);
+}
+void JNICALL Acct_DeleteGlobalRef(JNIEnv* env, jobject obj) {
+    Bump(kRefs);
+    s_real->DeleteGlobalRef(env, obj);
+}
+jweak JNICALL Acct_NewWeakGlobalRef(JNIEnv* env, jobject obj) {
+    Bump(kRefs);
+    return s_real->NewWeakGlobalRef(env, obj);
+}
+void JNICALL Acct_DeleteWeakGlobalRef(JNIEnv* env, jweak obj) {
+    Bump(kRefs);
+    s_real->DeleteWeakGlobalRef(env, obj);
+}
+
+const char* JNICALL Acct_GetStringUTFChars(JNIEnv* env, jstring s, jboolean* isCopy) {
+    Bump(kStrings);
+    return s_real->GetStringUTFChars(env, s, isCopy);
+}
+jstring JNICALL Acct_NewStringUTF(JNIEnv* env, const char* utf) {
+    Bump(kStrings);
+    return s_real->NewStringUTF(env, utf);
+}
+
+jclass JNICALL Acct_FindClass(JNIEnv* env, const char* name) {
+    Bump(kLookups);
+    return s_real->FindClass(env, name);
+}
+jclass JNICALL Acct_GetObjectClass(JNIEnv* env, jobject obj) {
+    Bump(kLookups);
+    return s_real->GetObjectClass(env, obj);
+}
+jmethodID JNICALL Acct_GetMethodID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    Bump(kLookups);
+    return s_real->GetMethodID(env, cls, name, sig);
+}
+jmethodID JNICALL Acct_GetStaticMethodID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    Bump(kLookups);
+    return s_real->GetStaticMethodID(env, cls, name, sig);
+}
+jfieldID JNICALL Acct_GetFieldID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    Bump(kLookups);
+    return s_real->GetFieldID(env, cls, name, sig);
+}
+jfieldID JNICALL Acct_GetStaticFieldID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    Bump(kLookups);
+    return s_real->GetStaticFieldID(env, cls, name, sig);
+}
+
+void JNICALL Acct_ExceptionClear(JNIEnv* env) {
+    Bump(kExceptions);
+    s_real->ExceptionClear(env);
+}
+
+#define LC_ACCT_INSTALL_CALLS(Type, jtype)                                  \
+    t.Call##Type##Method = Acct_Call##Type##Method;                         \
+    t.Call##Type##MethodV = Acct_Call##Type##MethodV;                       \
+    t.Call##Type##MethodA = Acct_Call##Type##MethodA;                       \
+    t.CallNonvirtual##Type##Method = Acct_CallNonvirtual##Type##Method;     \
+    t.CallNonvirtual##Type##MethodV = Acct_CallNonvirtual##Type##MethodV;   \
+    t.CallNonvirtual##Type##MethodA = Acct_CallNonvirtual##Type##MethodA;   \
+    t.CallStatic##Type##Method = Acct_CallStatic##Type##Method;             \
+    t.CallStatic##Type##MethodV = Acct_CallStatic##Type##MethodV;           \
+    t.CallStatic##Type##MethodA = Acct_CallStatic##Type##MethodA;
+
+#define LC_ACCT_INSTALL_FIELDS(Type, jtype)                \
+    t.Get##Type##Field = Acct_Get##Type##Field;            \
+    t.Set##Type##Field = Acct_Set##Type##Field;            \
+    t.GetStatic##Type##Field = Acct_GetStatic##Type##Field; \
+    t.SetStatic##Type##Field = Acct_SetStatic##Type##Field;
+
+// Copies the JVM's table and overrides the counted entries.  Returns true once
+// the counting table is ready; a thread that loses the race skips accounting
+// for that scope instead of waiting.
+bool EnsureCountingTable(JNIEnv* env) {
+    if (InterlockedCompareExchange(&s_tableState, 0, 0) == 2) return true;
+    if (InterlockedCompareExchange(&s_tableState, 1, 0) != 0) return false;
+    JNINativeInterface_& t = s_counting;
+    t = *env->functions;
+    LC_ACCT_TYPES(LC_ACCT_INSTALL_CALLS)
+    LC_ACCT_TYPES(LC_ACCT_INSTALL_FIELDS)
+    t.CallVoidMethod = Acct_CallVoidMethod;
+    t.CallVoidMethodV = Acct_CallVoidMethodV;
+    t.CallVoidMethodA = Acct_CallVoidMethodA;
+    t.CallNonvirtualVoidMethod = Acct_CallNonvirtualVoidMethod;
+    t.CallNonvirtualVoidMethodV = Acct_CallNonvirtualVoidMethodV;
+    t.CallNonvirtualVoidMethodA = Acct_CallNonvirtualVoidMethodA;
+    t.CallStaticVoidMethod = Acct_CallStaticVoidMethod;
+    t.CallStaticVoidMethodV = Acct_CallStaticVoidMethodV;
+    t.CallStaticVoidMethodA = Acct_CallStaticVoidMethodA;
+    t.NewObject = Acct_NewObject;
+    t.NewObjectV = Acct_NewObjectV;
+    t.NewObjectA = Acct_NewObjectA;
+    t.NewGlobalRef = Acct_NewGlobalRef;
+    t.DeleteGlobalRef = Acct_DeleteGlobalRef;
+    t.NewWeakGlobalRef = Acct_NewWeakGlobalRef;
+    t.DeleteWeakGlobalRef = Acct_DeleteWeakGlobalRef;
+    t.GetStringUTFChars = Acct_GetStringUTFChars;
+    t.NewStringUTF = Acct_NewStringUTF;
+    t.FindClass = Acct_FindClass;
+    t.GetObjectClass = Acct_GetObjectClass;
+    t.GetMethodID = Acct_GetMethodID;
+    t.GetStaticMethodID = Acct_GetStaticMethodID;
+    t.GetFieldID = Acct_GetFieldID;
+    t.GetStaticFieldID = Acct_GetStaticFieldID;
+    t.ExceptionClear = Acct_ExceptionClear;
+    InterlockedExchangePointer((PVOID volatile*)&s_real, (PVOID)env->functions);
+    InterlockedExchange(&s_tableState, 2);
+    return true;
+}
+
+} // namespace
+
+int Register(const char* name, unsigned budget) {
+    if (!name) return -1;
+    LONG n = InterlockedCompareExchange(&s_moduleCount, 0, 0);
+    for (LONG i = 0; i < n && i < kMaxModules; i++)
+        if (s_modules[i].name && std::strcmp(s_modules[i].name, name) == 0) return (int)i;
+    LONG id = InterlockedIncrement(&s_moduleCount) - 1;
+    if (id >= kMaxModules) return -1;
+    s_modules[id].budget = (LONG)budget;
+    InterlockedExchangePointer((PVOID volatile*)&s_modules[id].name, (PVOID)name);
+    return (int)id;
+}
+
+void SetBudget(int module, unsigned budget) {
+    if (module < 0 || module >= kMaxModules) return;
+    InterlockedExchange(&s_modules[module].budget, (LONG)budget);
+}
+
+Scope::Scope(JNIEnv* env, int module)
+    : _env(env), _savedTable(nullptr), _savedTag(0), _module(module), _startTransitions(0), _startQpc(0) {
+    if (!env || module < 0 || module >= kMaxModules) { _module = -1; return; }
+    DWORD slot = TlsSlot();
+    if (slot == TLS_OUT_OF_INDEXES) { _module = -1; return; }
+    if (!EnsureCountingTable(env)) { _module = -1; return; }
+    if (env->functions == s_real) {
+        _savedTable = env->functions;
+        env->functions = &s_counting;
+    } else if (env->functions != &s_counting) {
+        _module = -1;   // some other table (e.g. -Xcheck:jni on a new thread); leave it alone
+        return;
+    }
+    _savedTag = (LONG_PTR)TlsGetValue(slot);
+    TlsSetValue(slot, (LPVOID)(LONG_PTR)(module + 1));
+    _startTransitions = SumCounts(s_modules[module]);
+    _startQpc = NowQpc();
+}
+
+Scope::~Scope() {
+    if (_module < 0) return;
+    Module& m = s_modules[_module];
+    long long elapsed = NowQpc() - _startQpc;
+    TlsSetValue(TlsSlot(), (LPVOID)_savedTag);
+    if (_savedTable) _env->functions = (const JNINativeInterface_*)_savedTable;
+
+    LONG us = (LONG)(elapsed * 1000000LL / QpcFreq());
+    LONG used = (LONG)(SumCounts(m) - _startTransitions);
+    InterlockedIncrement(&m.runs);
+    InterlockedExchangeAdd64(&m.totalUs, us);
+    for (LONG prev = m.maxUs; us > prev; prev = m.maxUs)
+        if (InterlockedCompareExchange(&m.maxUs, us, prev) == prev) break;
+    InterlockedExchange(&m.lastRun, used);
+
+    LONG budget = m.budget;
+    bool over = budget > 0 && used > budget;
+    InterlockedExchange(&m.lastOver, over ? 1 : 0);
+    if (!over) return;
+    InterlockedIncrement(&m.overBudget);
+    long suppressed = 0;
+    if (AsyncLog::Allow(m.warnGate, 10000, &suppressed)) {
+        char buf[160];
+        snprintf(buf, sizeof(buf), "WARNING: JNI budget: %s used %ld transitions (budget %ld, %ld more over since last warning)",
+                 m.name, (long)used, (long)budget, suppressed);
+        AsyncLog::Write(AsyncLog::LEVEL_WARN, buf);
+    }
+}
+
+bool LastRunOverBudget(int module) {
+    if (module < 0 || module >= kMaxModules) return false;
+    return InterlockedCompareExchange(&s_modules[module].lastOver, 0, 0) != 0;
+}
+
+int ModuleCount() {
+    LONG n = InterlockedCompareExchange(&s_moduleCount, 0, 0);
+    return n < kMaxModules ? (int)n : kMaxModules;
+}
+
+bool Get(int module, ModuleStats& out) {
+    if (module < 0 || module >= ModuleCount()) return false;
+    const Module& m = s_modules[module];
+    out.name = m.name ? m.name : "?";
+    out.budget = (unsigned)m.budget;
+    for (int i = 0; i < kCounterCount; i++) out.counts[i] = (unsigned long)m.counts[i];
+    out.runs = (unsigned long)m.runs;
+    out.overBudget = (unsigned long)m.overBudget;
+    out.totalUs = (unsigned long long)m.totalUs;
+    out.maxUs = (unsigned)m.maxUs;
+    out.lastRun = (unsigned)m.lastRun;
+    return true;
+}
+
+std::string FormatStats() {
+    std::string out;
+    char buf[224];
+    for (int i = 0; i < ModuleCount(); i++) {
+        ModuleStats s;
+        if (!Get(i, s) || !s.runs) continue;
+        snprintf(buf, sizeof(buf), "%s%s calls=%lu fields=%lu refs=%lu str=%lu exc=%lu runs=%lu avg=%lluus max=%uus over=%lu",
+                 out.empty() ? "" : "; ", s.name,
+                 s.counts[kCalls], s.counts[kFieldReads] + s.counts[kFieldWrites], s.counts[kRefs],
+                 s.counts[kStrings], s.counts[kExceptions], s.runs,
+                 s.totalUs / s.runs, s.maxUs, s.overBudget);
+        out += buf;
+    }
+    return out;
+}
+
+void ResetStats() {
+    for (int i = 0; i < ModuleCount(); i++) {
+        Module& m = s_modules[i];
+        for (int k = 0; k < kCounterCount; k++) InterlockedExchange(&m.counts[k], 0);
+        InterlockedExchange(&m.runs, 0);
+        InterlockedExchange(&m.overBudget, 0);
+        InterlockedExchange64(&m.totalUs, 0);
+        InterlockedExchange(&m.maxUs, 0);
+    }
+}
+
+} // namespace JniAccounting
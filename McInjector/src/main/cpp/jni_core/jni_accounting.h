@@ -0,0 +1,95 @@
+#pragma once
+// jni_core/jni_accounting.h
+// Per-module JNI transition counters with interval timings and soft budgets.
+//
+// A Scope tags the calling thread with a module and, for its lifetime, points
+// the thread's JNIEnv at a copy of the JVM's function table whose Call*,
+// Get/Set*Field, ref, string, lookup and ExceptionClear entries bump that
+// module's counters before forwarding.  Everything else in the table is the
+// JVM's own entry, and the env is restored when the scope closes, so code
+// outside a scope (and other threads) pays nothing.  Nested scopes attribute
+// to the innermost module.
+//
+// Usage:
+//   static const int s_acct = JniAccounting::Register("chestEsp", 8000);
+//   JniAccounting::Scope acct(env, s_acct);      // around one module run
+//   ...
+//   if (JniAccounting::LastRunOverBudget(s_acct)) ...   // soft throttle
+//   Log("JNI: " + JniAccounting::FormatStats());
+//
+// A run whose transitions exceed the module's budget counts as over budget
+// and logs a rate-limited warning.
+
+#include <jni.h>
+#include <windows.h>
+#include <string>
+
+namespace JniAccounting {
+
+enum Counter {
+    kCalls,        // Call*Method / CallStatic* / CallNonvirtual* / NewObject
+    kFieldReads,   // Get*Field / GetStatic*Field
+    kFieldWrites,  // Set*Field / SetStatic*Field
+    kRefs,         // NewGlobalRef / NewWeakGlobalRef / DeleteGlobalRef / DeleteWeakGlobalRef
+    kStrings,      // GetStringUTFChars / NewStringUTF
+    kLookups,      // FindClass / GetObjectClass / Get*MethodID / Get*FieldID
+    kExceptions,   // ExceptionClear
+    kCounterCount
+};
+
+static const int kMaxModules = 32;
+
+struct ModuleStats {
+    const char*        name;
+    unsigned           budget;       // transitions per run, 0 = none
+    unsigned long      counts[kCounterCount];
+    unsigned long      runs;
+    unsigned long      overBudget;
+    unsigned long long totalUs;
+    unsigned           maxUs;
+    unsigned           lastRun;      // transitions in the most recent run
+
+    unsigned long Transitions() const {
+        unsigned long n = 0;
+        for (int i = 0; i < kCounterCount; i++) n += counts[i];
+        return n;
+    }
+};
+
+// Returns the id for `name` (string literal), registering it on first use.
+// budget is the soft limit of JNI transitions per Scope; 0 disables it.
+// Returns -1 once kMaxModules are taken.
+int Register(const char* name, unsigned budget);
+
+// Changes a module's budget.
+void SetBudget(int module, unsigned budget);
+
+class Scope {
+public:
+    Scope(JNIEnv* env, int module);
+    ~Scope();
+
+private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+    JNIEnv*       _env;
+    const void*   _savedTable;   // non-null when this scope swapped the table
+    LONG_PTR      _savedTag;
+    int           _module;
+    unsigned long _startTransitions;
+    long long     _startQpc;
+};
+
+// True if the module's most recent run went over its budget.
+bool LastRunOverBudget(int module);
+
+int  ModuleCount();
+bool Get(int module, ModuleStats& out);
+
+// "name calls=N fields=N refs=N str=N exc=N runs=N avg=Xus max=Yus over=Z"
+// for each module that ran, "; "-separated.
+std::string FormatStats();
+void ResetStats();
+
+} // namespace JniAccounting
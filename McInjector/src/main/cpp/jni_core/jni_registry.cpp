@@ -0,0 +1,161 @@
+// jni_core/jni_registry.cpp
+#include "jni_registry.h"
+#include <windows.h>
+#include <cstring>
+#include <vector>
+
+namespace JniRegistry {
+
+namespace {
+
+Table* volatile s_current    = nullptr;
+volatile LONG   s_readers    = 0;
+unsigned long   s_generation = 0;
+
+// Tables that were still pinned when their grace period ran out.  Freed at
+// Shutdown() instead of risking a use-after-free on a slow reader.
+std::vector<Table*> s_graveyard;
+
+// Serialises writers (Publish/Shutdown).  Readers never take it.
+struct WriterLock {
+    CRITICAL_SECTION cs;
+    WriterLock()  { InitializeCriticalSection(&cs); }
+    ~WriterLock() { DeleteCriticalSection(&cs); }
+};
+
+WriterLock& Writers() {
+    static WriterLock s_lock;
+    return s_lock;
+}
+
+const DWORD kGraceTimeoutMs = 2000;
+
+void FreeTable(JNIEnv* env, Table* t) {
+    if (!t) return;
+    if (env) {
+        for (int i = 0; i < kMaxSlots; i++) {
+            if (t->classes[i]) env->DeleteGlobalRef(t->classes[i]);
+        }
+    }
+    delete t;
+}
+
+// Wait until no reader pins any table.  Readers hold a pin for one poll
+// iteration, so this normally returns within a few milliseconds.
+bool WaitForReaders() {
+    DWORD start = GetTickCount();
+    while (InterlockedCompareExchange(&s_readers, 0, 0) != 0) {
+        if (GetTickCount() - start > kGraceTimeoutMs) return false;
+        Sleep(1);
+    }
+    return true;
+}
+
+void Retire(JNIEnv* env, Table* old) {
+    if (!old) return;
+    if (WaitForReaders()) FreeTable(env, old);
+    else s_graveyard.push_back(old);
+}
+
+int FindClassSlot(const Table& t, const ClassDesc& desc) {
+    for (int i = 0; i < kMaxSlots; i++) {
+        if (t.classDescs[i] == &desc && t.classes[i]) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+// ── Build side ───────────────────────────────────────────────────────────────
+
+Table* BeginBuild() {
+    Table* t = new Table;
+    std::memset(t, 0, sizeof(*t));
+    return t;
+}
+
+bool BindClass(JNIEnv* env, Table& t, int slot, const ClassDesc& desc,
+               jobject classLoader, jclass preferred) {
+    if (!env || slot < 0 || slot >= kMaxSlots) return false;
+
+    jclass local = preferred ? (jclass)env->NewLocalRef(preferred)
+                             : LoadDescClass(env, desc, classLoader);
+    if (!local) return false;
+
+    if (t.classes[slot]) env->DeleteGlobalRef(t.classes[slot]);
+    t.classes[slot] = (jclass)env->NewGlobalRef(local);
+    t.classDescs[slot] = &desc;
+    env->DeleteLocalRef(local);
+    return t.classes[slot] != nullptr;
+}
+
+bool BindField(JNIEnv* env, Table& t, int slot, const FieldDesc& desc) {
+    if (!env || slot < 0 || slot >= kMaxSlots) return false;
+    int owner = FindClassSlot(t, desc.owner);
+    if (owner < 0) return false;
+    t.fields[slot] = LookupField(env, t.classes[owner], desc);
+    return t.fields[slot] != nullptr;
+}
+
+bool BindMethod(JNIEnv* env, Table& t, int slot, const MethodDesc& desc) {
+    if (!env || slot < 0 || slot >= kMaxSlots) return false;
+    int owner = FindClassSlot(t, desc.owner);
+    if (owner < 0) return false;
+    t.methods[slot] = LookupMethod(env, t.classes[owner], desc);
+    return t.methods[slot] != nullptr;
+}
+
+unsigned long Publish(JNIEnv* env, Table* next) {
+    if (!next) return Generation();
+
+    EnterCriticalSection(&Writers().cs);
+    next->generation = ++s_generation;
+    Table* old = (Table*)InterlockedExchangePointer((PVOID volatile*)&s_current, next);
+    Retire(env, old);
+    unsigned long gen = next->generation;
+    LeaveCriticalSection(&Writers().cs);
+    return gen;
+}
+
+void Discard(JNIEnv* env, Table* t) {
+    FreeTable(env, t);
+}
+
+void Shutdown(JNIEnv* env) {
+    EnterCriticalSection(&Writers().cs);
+    Table* old = (Table*)InterlockedExchangePointer((PVOID volatile*)&s_current, nullptr);
+    Retire(env, old);
+    for (size_t i = 0; i < s_graveyard.size(); i++) FreeTable(env, s_graveyard[i]);
+    s_graveyard.clear();
+    LeaveCriticalSection(&Writers().cs);
+}
+
+// ── Read side ────────────────────────────────────────────────────────────────
+
+unsigned long Generation() {
+    const Table* t = (const Table*)InterlockedCompareExchangePointer((PVOID volatile*)&s_current, nullptr, nullptr);
+    return t ? t->generation : 0;
+}
+
+void FillField(const Table* t, int slot, jfieldID fid) {
+    if (!t || !fid || slot < 0 || slot >= kMaxSlots) return;
+    Table* mt = const_cast<Table*>(t);
+    InterlockedCompareExchangePointer((PVOID volatile*)&mt->fields[slot], (PVOID)fid, nullptr);
+}
+
+void FillMethod(const Table* t, int slot, jmethodID mid) {
+    if (!t || !mid || slot < 0 || slot >= kMaxSlots) return;
+    Table* mt = const_cast<Table*>(t);
+    InterlockedCompareExchangePointer((PVOID volatile*)&mt->methods[slot], (PVOID)mid, nullptr);
+}
+
+const Table* Acquire() {
+    InterlockedIncrement(&s_readers);
+    return (const Table*)InterlockedCompareExchangePointer((PVOID volatile*)&s_current, nullptr, nullptr);
+}
+
+void Release() {
+    InterlockedDecrement(&s_readers);
+}
+
+} // namespace JniRegistry
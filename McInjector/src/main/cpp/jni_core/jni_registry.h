@@ -0,0 +1,94 @@
+#pragma once
+// jni_core/jni_registry.h
+// Versioned, swappable table of resolved JNI handles.
+//
+// A bridge declares slot enums for the classes, fields and methods its hot paths
+// use, builds a complete Table off to the side from resolver.h descriptors, and
+// publishes it with one pointer swap.  Readers pin the current table for the
+// duration of one poll iteration and never see a half-built or half-cleared set.
+//
+// Usage (discovery / remap):
+//   JniRegistry::Table* t = JniRegistry::BeginBuild();
+//   JniRegistry::BindClass(env, *t, REG_CLS_MC, mc121::CLS_MC, gcl, mcCls);
+//   JniRegistry::BindField(env, *t, REG_FLD_GAME_MODE, mc121::FIELD_GAME_MODE);
+//   JniRegistry::Publish(env, t);          // old table is freed once unpinned
+//
+// Usage (per poll):
+//   JniRegistry::Pin reg;                  // pins the current generation
+//   if (reg && reg->fields[REG_FLD_GAME_MODE]) { ... }
+//
+// bridge_261 currently keeps only its state-poll handles here; handles that are
+// resolved lazily by ad-hoc probes stay in their module globals.
+//
+// Thread safety: Publish()/Shutdown() may be called from any attached thread.
+// A Table is immutable once published except for Fill*(), which only ever
+// moves a slot from nullptr to a value.
+
+#include <jni.h>
+#include "resolver.h"
+
+namespace JniRegistry {
+
+static const int kMaxSlots = 64;
+
+struct Table {
+    unsigned long    generation;
+    const ClassDesc* classDescs[kMaxSlots]; // descriptor each class slot was built from
+    jclass           classes[kMaxSlots];    // global refs owned by the table
+    jfieldID         fields[kMaxSlots];
+    jmethodID        methods[kMaxSlots];
+};
+
+// ── Build side ───────────────────────────────────────────────────────────────
+
+// Allocate a zeroed, unpublished table.
+Table* BeginBuild();
+
+// Bind a class slot.  `preferred` (a live runtime class, may be nullptr) wins over
+// the descriptor's candidate names.  Returns true if the slot is set.
+bool BindClass(JNIEnv* env, Table& t, int slot, const ClassDesc& desc,
+               jobject classLoader, jclass preferred = nullptr);
+
+// Bind a field/method slot against the class slot bound from desc.owner.
+// Returns false if the owner slot is not bound or no candidate matched.
+bool BindField (JNIEnv* env, Table& t, int slot, const FieldDesc&  desc);
+bool BindMethod(JNIEnv* env, Table& t, int slot, const MethodDesc& desc);
+
+// Make `next` current and free the previous table once no reader pins it.
+// Returns the new generation.
+unsigned long Publish(JNIEnv* env, Table* next);
+
+// Free an unpublished table (build aborted).
+void Discard(JNIEnv* env, Table* t);
+
+// Unpublish and free everything (DLL detach).
+void Shutdown(JNIEnv* env);
+
+// ── Read side ────────────────────────────────────────────────────────────────
+
+// Generation of the current table (0 = nothing published).
+unsigned long Generation();
+
+// Late-bind a slot that can only be resolved against a live object's class.
+// No-op if the slot is already set.
+void FillField (const Table* t, int slot, jfieldID  fid);
+void FillMethod(const Table* t, int slot, jmethodID mid);
+
+const Table* Acquire();
+void         Release();
+
+// RAII pin on the current table.
+class Pin {
+public:
+    Pin() : m_table(Acquire()) {}
+    ~Pin() { Release(); }
+    const Table* operator->() const { return m_table; }
+    const Table* get() const { return m_table; }
+    explicit operator bool() const { return m_table != nullptr; }
+private:
+    Pin(const Pin&);
+    Pin& operator=(const Pin&);
+    const Table* m_table;
+};
+
+} // namespace JniRegistry
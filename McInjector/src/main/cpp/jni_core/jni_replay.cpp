@@ -0,0 +1,1136 @@
+// jni_core/jni_replay.cpp
+#include "jni_replay.h"
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+namespace JniReplay {
+
+// Record layout per op (a, b, value; "blob" where present):
+//   FindClass                 -, -, cls; blob name
+//   GetObjectClass            obj, -, cls
+//   Get[Static]MethodID / FieldID  cls, -, id; blob "name\0sig"
+//   FromReflectedMethod       method, -, mid
+//   ToReflectedMethod / Field cls, member, obj
+//   IsInstanceOf / IsAssignableFrom / IsSameObject   x, y, bool
+//   NewObject                 cls, mid, obj
+//   GetArrayLength            arr, -, length
+//   GetObjectArrayElement     arr, index, obj
+//   SetObjectArrayElement     arr, index, stored obj
+//   NewObjectArray            cls, length, arr
+//   NewByteArray              -, length, arr
+//   SetByteArrayRegion        arr, start, length; blob bytes
+//   GetFloatArrayRegion       arr, start, length; blob floats
+//   GetStringUTFChars         str, -, -; blob chars
+//   ReleaseStringUTFChars     str, -, -
+//   NewStringUTF              -, -, str; blob chars
+//   New/Delete[Weak]GlobalRef, NewLocalRef, DeleteLocalRef   obj, -, new ref
+//   PushLocalFrame            -, capacity, result
+//   PopLocalFrame             obj, -, result
+//   ExceptionCheck / Occurred -, -, result
+//   GetDirectBufferAddress    buf, capacity, address
+//   GetDirectBufferCapacity   buf, -, capacity
+//   NewDirectByteBuffer       address, capacity, buf
+//   Call<T> / CallStatic<T>   obj or cls, mid, result
+//   Get<T>Field / GetStatic   obj or cls, fid, value
+//   Set<T>Field               obj, fid, stored value
+// Handles are ids, integers zigzag-encoded, floats / doubles their bit
+// patterns.
+
+namespace {
+
+const unsigned kVersion = 1;
+const size_t   kFlushBytes = 64 * 1024;
+
+typedef unsigned long long u64;
+
+bool OpHasBlob(int op) {
+    switch (op) {
+    case kFindClass: case kGetMethodID: case kGetStaticMethodID: case kGetFieldID: case kGetStaticFieldID:
+    case kSetByteArrayRegion: case kGetFloatArrayRegion: case kGetStringUTFChars: case kNewStringUTF:
+        return true;
+    default:
+        return false;
+    }
+}
+
+inline u64 Zig(long long v) { return ((u64)v << 1) ^ (u64)(v >> 63); }
+inline long long Unzig(u64 v) { return (long long)(v >> 1) ^ -(long long)(v & 1); }
+
+void PutVarint(std::string& out, u64 v) {
+    while (v >= 0x80) {
+        out += (char)((v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    out += (char)v;
+}
+
+bool GetVarint(const unsigned char*& p, const unsigned char* end, u64& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        unsigned char c = *p++;
+        v |= (u64)(c & 0x7F) << shift;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+template <class T> inline u64 Bits(T v) { return Zig((long long)v); }
+template <> inline u64 Bits<jfloat>(jfloat v) { uint32_t u; std::memcpy(&u, &v, 4); return u; }
+template <> inline u64 Bits<jdouble>(jdouble v) { u64 u; std::memcpy(&u, &v, 8); return u; }
+
+template <class T> inline T FromBits(u64 v) { return (T)Unzig(v); }
+template <> inline jfloat FromBits<jfloat>(u64 v) { uint32_t u = (uint32_t)v; jfloat f; std::memcpy(&f, &u, 4); return f; }
+template <> inline jdouble FromBits<jdouble>(u64 v) { jdouble d; std::memcpy(&d, &v, 8); return d; }
+template <> inline jobject FromBits<jobject>(u64 v) { return (jobject)Player::Handle(v); }
+
+// ── Recorder ─────────────────────────────────────────────────────────────────
+
+struct RecLock {
+    CRITICAL_SECTION cs;
+    RecLock()  { InitializeCriticalSection(&cs); }
+    ~RecLock() { DeleteCriticalSection(&cs); }
+};
+
+RecLock& Lock() {
+    static RecLock s_lock;
+    return s_lock;
+}
+
+struct Guard {
+    Guard()  { EnterCriticalSection(&Lock().cs); }
+    ~Guard() { LeaveCriticalSection(&Lock().cs); }
+};
+
+// Guarded by Lock().  The lock is re-entrant, so a wrapper holds it across
+// id lookups and the append.
+std::FILE*                              s_file = nullptr;
+std::string                             s_buf;
+unsigned long                           s_written = 0;
+unsigned long                           s_maxBytes = 0;
+std::unordered_map<const void*, u64>    s_ids;
+u64                                     s_nextId = 0;
+volatile LONG                           s_calls = 0;
+volatile LONG                           s_active = 0;
+
+// The table the recording table was copied from (and forwards to), built on
+// the first scope of a recording.
+const JNINativeInterface_* volatile s_next = nullptr;
+JNINativeInterface_ s_recording;
+volatile LONG s_tableState = 0;   // 0 = not built, 1 = building, 2 = ready
+
+u64 Id(const void* p) {
+    if (!p) return 0;
+    std::unordered_map<const void*, u64>::iterator it = s_ids.find(p);
+    if (it != s_ids.end()) return it->second;
+    u64 id = ++s_nextId;
+    s_ids[p] = id;
+    return id;
+}
+
+template <class T> inline u64 RecBits(T v) { return Bits(v); }
+template <> inline u64 RecBits<jobject>(jobject v) { return Id(v); }
+
+void FlushLocked() {
+    if (!s_file || s_buf.empty()) return;
+    std::fwrite(s_buf.data(), 1, s_buf.size(), s_file);
+    s_written += (unsigned long)s_buf.size();
+    s_buf.clear();
+}
+
+void CloseLocked() {
+    if (!s_file) return;
+    FlushLocked();
+    std::fclose(s_file);
+    s_file = nullptr;
+    s_ids.clear();
+    InterlockedExchange(&s_active, 0);
+}
+
+void Put(int op, u64 a, u64 b, u64 value, const void* blob, size_t n) {
+    if (!s_file) return;
+    s_buf += (char)op;
+    PutVarint(s_buf, a);
+    PutVarint(s_buf, b);
+    PutVarint(s_buf, value);
+    if (OpHasBlob(op)) {
+        PutVarint(s_buf, n);
+        if (n) s_buf.append((const char*)blob, n);
+    }
+    InterlockedIncrement(&s_calls);
+    if (s_buf.size() >= kFlushBytes) {
+        FlushLocked();
+        if (s_written >= s_maxBytes) CloseLocked();
+    }
+}
+
+// Evaluates the inputs under the lock, after the call has been forwarded.
+#define LC_REC(op, a, b, value) \
+    do { Guard g_; Put((op), (a), (b), (value), nullptr, 0); } while (0)
+#define LC_REC_BLOB(op, a, b, value, blob, n) \
+    do { Guard g_; Put((op), (a), (b), (value), (blob), (n)); } while (0)
+
+std::string NameSig(const char* name, const char* sig) {
+    std::string s(name ? name : "");
+    s += '\0';
+    if (sig) s += sig;
+    return s;
+}
+
+#define LC_REC_CALLS(Type, jtype, tag)                                                                 \
+    jtype JNICALL Rec_Call##Type##Method(JNIEnv* env, jobject obj, jmethodID mid, ...) {               \
+        va_list args;                                                                                  \
+        va_start(args, mid);                                                                           \
+        jtype r = s_next->Call##Type##MethodV(env, obj, mid, args);                                    \
+        va_end(args);                                                                                  \
+        LC_REC(kCall + tag, Id(obj), Id(mid), RecBits<jtype>(r));                                      \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_Call##Type##MethodV(JNIEnv* env, jobject obj, jmethodID mid, va_list args) {     \
+        jtype r = s_next->Call##Type##MethodV(env, obj, mid, args);                                    \
+        LC_REC(kCall + tag, Id(obj), Id(mid), RecBits<jtype>(r));                                      \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_Call##Type##MethodA(JNIEnv* env, jobject obj, jmethodID mid, const jvalue* a) {  \
+        jtype r = s_next->Call##Type##MethodA(env, obj, mid, a);                                       \
+        LC_REC(kCall + tag, Id(obj), Id(mid), RecBits<jtype>(r));                                      \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_CallNonvirtual##Type##Method(JNIEnv* env, jobject obj, jclass cls,               \
+                                                   jmethodID mid, ...) {                               \
+        va_list args;                                                                                  \
+        va_start(args, mid);                                                                           \
+        jtype r = s_next->CallNonvirtual##Type##MethodV(env, obj, cls, mid, args);                     \
+        va_end(args);                                                                                  \
+        LC_REC(kCall + tag, Id(obj), Id(mid), RecBits<jtype>(r));                                      \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_CallNonvirtual##Type##MethodV(JNIEnv* env, jobject obj, jclass cls,              \
+                                                    jmethodID mid, va_list args) {                     \
+        jtype r = s_next->CallNonvirtual##Type##MethodV(env, obj, cls, mid, args);                     \
+        LC_REC(kCall + tag, Id(obj), Id(mid), RecBits<jtype>(r));                                      \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_CallNonvirtual##Type##MethodA(JNIEnv* env, jobject obj, jclass cls,              \
+                                                    jmethodID mid, const jvalue* a) {                  \
+        jtype r = s_next->CallNonvirtual##Type##MethodA(env, obj, cls, mid, a);                        \
+        LC_REC(kCall + tag, Id(obj), Id(mid), RecBits<jtype>(r));                                      \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_CallStatic##Type##Method(JNIEnv* env, jclass cls, jmethodID mid, ...) {          \
+        va_list args;                                                                                  \
+        va_start(args, mid);                                                                           \
+        jtype r = s_next->CallStatic##Type##MethodV(env, cls, mid, args);                              \
+        va_end(args);                                                                                  \
+        LC_REC(kCallStatic + tag, Id(cls), Id(mid), RecBits<jtype>(r));                                \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_CallStatic##Type##MethodV(JNIEnv* env, jclass cls, jmethodID mid, va_list args) { \
+        jtype r = s_next->CallStatic##Type##MethodV(env, cls, mid, args);                              \
+        LC_REC(kCallStatic + tag, Id(cls), Id(mid), RecBits<jtype>(r));                                \
+        return r;                                                                                      \
+    }                                                                                                  \
+    jtype JNICALL Rec_CallStatic##Type##MethodA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue* a) { \
+        jtype r = s_next->CallStatic##Type##MethodA(env, cls, mid, a);                                 \
+        LC_REC(kCallStatic + tag, Id(cls), Id(mid), RecBits<jtype>(r));                                \
+        return r;                                                                                      \
+    }
+
+#define LC_REC_FIELDS(Type, jtype, tag)                                                                \
+    jtype JNICALL Rec_Get##Type##Field(JNIEnv* env, jobject obj, jfieldID fid) {                       \
+        jtype r = s_next->Get##Type##Field(env, obj, fid);                                             \
+        LC_REC(kGetField + tag, Id(obj), Id(fid), RecBits<jtype>(r));                                  \
+        return r;                                                                                      \
+    }                                                                                                  \
+    void JNICALL Rec_Set##Type##Field(JNIEnv* env, jobject obj, jfieldID fid, jtype v) {               \
+        s_next->Set##Type##Field(env, obj, fid, v);                                                    \
+        LC_REC(kSetField + tag, Id(obj), Id(fid), RecBits<jtype>(v));                                  \
+    }                                                                                                  \
+    jtype JNICALL Rec_GetStatic##Type##Field(JNIEnv* env, jclass cls, jfieldID fid) {                  \
+        jtype r = s_next->GetStatic##Type##Field(env, cls, fid);                                       \
+        LC_REC(kGetStatic + tag, Id(cls), Id(fid), RecBits<jtype>(r));                                 \
+        return r;                                                                                      \
+    }
+
+#define LC_REPLAY_TYPES(X) \
+    X(Object, jobject, kObject) X(Boolean, jboolean, kBoolean) X(Byte, jbyte, kByte) \
+    X(Char, jchar, kChar) X(Short, jshort, kShort) X(Int, jint, kInt) X(Long, jlong, kLong) \
+    X(Float, jfloat, kFloat) X(Double, jdouble, kDouble)
+
+LC_REPLAY_TYPES(LC_REC_CALLS)
+LC_REPLAY_TYPES(LC_REC_FIELDS)
+
+void JNICALL Rec_CallVoidMethod(JNIEnv* env, jobject obj, jmethodID mid, ...) {
+    va_list args;
+    va_start(args, mid);
+    s_next->CallVoidMethodV(env, obj, mid, args);
+    va_end(args);
+    LC_REC(kCall + kVoid, Id(obj), Id(mid), 0);
+}
+void JNICALL Rec_CallVoidMethodV(JNIEnv* env, jobject obj, jmethodID mid, va_list args) {
+    s_next->CallVoidMethodV(env, obj, mid, args);
+    LC_REC(kCall + kVoid, Id(obj), Id(mid), 0);
+}
+void JNICALL Rec_CallVoidMethodA(JNIEnv* env, jobject obj, jmethodID mid, const jvalue* a) {
+    s_next->CallVoidMethodA(env, obj, mid, a);
+    LC_REC(kCall + kVoid, Id(obj), Id(mid), 0);
+}
+void JNICALL Rec_CallNonvirtualVoidMethod(JNIEnv* env, jobject obj, jclass cls, jmethodID mid, ...) {
+    va_list args;
+    va_start(args, mid);
+    s_next->CallNonvirtualVoidMethodV(env, obj, cls, mid, args);
+    va_end(args);
+    LC_REC(kCall + kVoid, Id(obj), Id(mid), 0);
+}
+void JNICALL Rec_CallNonvirtualVoidMethodV(JNIEnv* env, jobject obj, jclass cls, jmethodID mid, va_list args) {
+    s_next->CallNonvirtualVoidMethodV(env, obj, cls, mid, args);
+    LC_REC(kCall + kVoid, Id(obj), Id(mid), 0);
+}
+void JNICALL Rec_CallNonvirtualVoidMethodA(JNIEnv* env, jobject obj, jclass cls, jmethodID mid, const jvalue* a) {
+    s_next->CallNonvirtualVoidMethodA(env, obj, cls, mid, a);
+    LC_REC(kCall + kVoid, Id(obj), Id(mid), 0);
+}
+void JNICALL Rec_CallStaticVoidMethod(JNIEnv* env, jclass cls, jmethodID mid, ...) {
+    va_list args;
+    va_start(args, mid);
+    s_next->CallStaticVoidMethodV(env, cls, mid, args);
+    va_end(args);
+    LC_REC(kCallStatic + kVoid, Id(cls), Id(mid), 0);
+}
+void JNICALL Rec_CallStaticVoidMethodV(JNIEnv* env, jclass cls, jmethodID mid, va_list args) {
+    s_next->CallStaticVoidMethodV(env, cls, mid, args);
+    LC_REC(kCallStatic + kVoid, Id(cls), Id(mid), 0);
+}
+void JNICALL Rec_CallStaticVoidMethodA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue* a) {
+    s_next->CallStaticVoidMethodA(env, cls, mid, a);
+    LC_REC(kCallStatic + kVoid, Id(cls), Id(mid), 0);
+}
+
+jobject JNICALL Rec_NewObject(JNIEnv* env, jclass cls, jmethodID mid, ...) {
+    va_list args;
+    va_start(args, mid);
+    jobject r = s_next->NewObjectV(env, cls, mid, args);
+    va_end(args);
+    LC_REC(kNewObject, Id(cls), Id(mid), Id(r));
+    return r;
+}
+jobject JNICALL Rec_NewObjectV(JNIEnv* env, jclass cls, jmethodID mid, va_list args) {
+    jobject r = s_next->NewObjectV(env, cls, mid, args);
+    LC_REC(kNewObject, Id(cls), Id(mid), Id(r));
+    return r;
+}
+jobject JNICALL Rec_NewObjectA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue* a) {
+    jobject r = s_next->NewObjectA(env, cls, mid, a);
+    LC_REC(kNewObject, Id(cls), Id(mid), Id(r));
+    return r;
+}
+
+jclass JNICALL Rec_FindClass(JNIEnv* env, const char* name) {
+    jclass r = s_next->FindClass(env, name);
+    LC_REC_BLOB(kFindClass, 0, 0, Id(r), name, name ? std::strlen(name) : 0);
+    return r;
+}
+jclass JNICALL Rec_GetObjectClass(JNIEnv* env, jobject obj) {
+    jclass r = s_next->GetObjectClass(env, obj);
+    LC_REC(kGetObjectClass, Id(obj), 0, Id(r));
+    return r;
+}
+jmethodID JNICALL Rec_GetMethodID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    jmethodID r = s_next->GetMethodID(env, cls, name, sig);
+    std::string ns = NameSig(name, sig);
+    LC_REC_BLOB(kGetMethodID, Id(cls), 0, Id(r), ns.data(), ns.size());
+    return r;
+}
+jmethodID JNICALL Rec_GetStaticMethodID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    jmethodID r = s_next->GetStaticMethodID(env, cls, name, sig);
+    std::string ns = NameSig(name, sig);
+    LC_REC_BLOB(kGetStaticMethodID, Id(cls), 0, Id(r), ns.data(), ns.size());
+    return r;
+}
+jfieldID JNICALL Rec_GetFieldID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    jfieldID r = s_next->GetFieldID(env, cls, name, sig);
+    std::string ns = NameSig(name, sig);
+    LC_REC_BLOB(kGetFieldID, Id(cls), 0, Id(r), ns.data(), ns.size());
+    return r;
+}
+jfieldID JNICALL Rec_GetStaticFieldID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    jfieldID r = s_next->GetStaticFieldID(env, cls, name, sig);
+    std::string ns = NameSig(name, sig);
+    LC_REC_BLOB(kGetStaticFieldID, Id(cls), 0, Id(r), ns.data(), ns.size());
+    return r;
+}
+jmethodID JNICALL Rec_FromReflectedMethod(JNIEnv* env, jobject method) {
+    jmethodID r = s_next->FromReflectedMethod(env, method);
+    LC_REC(kFromReflectedMethod, Id(method), 0, Id(r));
+    return r;
+}
+jobject JNICALL Rec_ToReflectedMethod(JNIEnv* env, jclass cls, jmethodID mid, jboolean isStatic) {
+    jobject r = s_next->ToReflectedMethod(env, cls, mid, isStatic);
+    LC_REC(kToReflectedMethod, Id(cls), Id(mid), Id(r));
+    return r;
+}
+jobject JNICALL Rec_ToReflectedField(JNIEnv* env, jclass cls, jfieldID fid, jboolean isStatic) {
+    jobject r = s_next->ToReflectedField(env, cls, fid, isStatic);
+    LC_REC(kToReflectedField, Id(cls), Id(fid), Id(r));
+    return r;
+}
+jboolean JNICALL Rec_IsInstanceOf(JNIEnv* env, jobject obj, jclass cls) {
+    jboolean r = s_next->IsInstanceOf(env, obj, cls);
+    LC_REC(kIsInstanceOf, Id(obj), Id(cls), r);
+    return r;
+}
+jboolean JNICALL Rec_IsAssignableFrom(JNIEnv* env, jclass sub, jclass sup) {
+    jboolean r = s_next->IsAssignableFrom(env, sub, sup);
+    LC_REC(kIsAssignableFrom, Id(sub), Id(sup), r);
+    return r;
+}
+jboolean JNICALL Rec_IsSameObject(JNIEnv* env, jobject x, jobject y) {
+    jboolean r = s_next->IsSameObject(env, x, y);
+    LC_REC(kIsSameObject, Id(x), Id(y), r);
+    return r;
+}
+
+jsize JNICALL Rec_GetArrayLength(JNIEnv* env, jarray arr) {
+    jsize r = s_next->GetArrayLength(env, arr);
+    LC_REC(kGetArrayLength, Id(arr), 0, Zig(r));
+    return r;
+}
+jobject JNICALL Rec_GetObjectArrayElement(JNIEnv* env, jobjectArray arr, jsize i) {
+    jobject r = s_next->GetObjectArrayElement(env, arr, i);
+    LC_REC(kGetObjectArrayElement, Id(arr), Zig(i), Id(r));
+    return r;
+}
+void JNICALL Rec_SetObjectArrayElement(JNIEnv* env, jobjectArray arr, jsize i, jobject v) {
+    s_next->SetObjectArrayElement(env, arr, i, v);
+    LC_REC(kSetObjectArrayElement, Id(arr), Zig(i), Id(v));
+}
+jobjectArray JNICALL Rec_NewObjectArray(JNIEnv* env, jsize len, jclass cls, jobject init) {
+    jobjectArray r = s_next->NewObjectArray(env, len, cls, init);
+    LC_REC(kNewObjectArray, Id(cls), Zig(len), Id(r));
+    return r;
+}
+jbyteArray JNICALL Rec_NewByteArray(JNIEnv* env, jsize len) {
+    jbyteArray r = s_next->NewByteArray(env, len);
+    LC_REC(kNewByteArray, 0, Zig(len), Id(r));
+    return r;
+}
+void JNICALL Rec_SetByteArrayRegion(JNIEnv* env, jbyteArray arr, jsize start, jsize len, const jbyte* buf) {
+    s_next->SetByteArrayRegion(env, arr, start, len, buf);
+    LC_REC_BLOB(kSetByteArrayRegion, Id(arr), Zig(start), Zig(len), buf, (buf && len > 0) ? (size_t)len : 0);
+}
+void JNICALL Rec_GetFloatArrayRegion(JNIEnv* env, jfloatArray arr, jsize start, jsize len, jfloat* buf) {
+    s_next->GetFloatArrayRegion(env, arr, start, len, buf);
+    bool ok = buf && len > 0 && !s_next->ExceptionCheck(env);
+    LC_REC_BLOB(kGetFloatArrayRegion, Id(arr), Zig(start), Zig(len), buf, ok ? (size_t)len * sizeof(jfloat) : 0);
+}
+
+const char* JNICALL Rec_GetStringUTFChars(JNIEnv* env, jstring s, jboolean* isCopy) {
+    const char* r = s_next->GetStringUTFChars(env, s, isCopy);
+    LC_REC_BLOB(kGetStringUTFChars, Id(s), 0, r ? 1 : 0, r, r ? std::strlen(r) : 0);
+    return r;
+}
+void JNICALL Rec_ReleaseStringUTFChars(JNIEnv* env, jstring s, const char* chars) {
+    s_next->ReleaseStringUTFChars(env, s, chars);
+    LC_REC(kReleaseStringUTFChars, Id(s), 0, 0);
+}
+jstring JNICALL Rec_NewStringUTF(JNIEnv* env, const char* utf) {
+    jstring r = s_next->NewStringUTF(env, utf);
+    LC_REC_BLOB(kNewStringUTF, 0, 0, Id(r), utf, utf ? std::strlen(utf) : 0);
+    return r;
+}
+
+jobject JNICALL Rec_NewGlobalRef(JNIEnv* env, jobject obj) {
+    jobject r = s_next->NewGlobalRef(env, obj);
+    LC_REC(kNewGlobalRef, Id(obj), 0, Id(r));
+    return r;
+}
+void JNICALL Rec_DeleteGlobalRef(JNIEnv* env, jobject obj) {
+    s_next->DeleteGlobalRef(env, obj);
+    LC_REC(kDeleteGlobalRef, Id(obj), 0, 0);
+}
+jweak JNICALL Rec_NewWeakGlobalRef(JNIEnv* env, jobject obj) {
+    jweak r = s_next->NewWeakGlobalRef(env, obj);
+    LC_REC(kNewWeakGlobalRef, Id(obj), 0, Id(r));
+    return r;
+}
+void JNICALL Rec_DeleteWeakGlobalRef(JNIEnv* env, jweak obj) {
+    s_next->DeleteWeakGlobalRef(env, obj);
+    LC_REC(kDeleteWeakGlobalRef, Id(obj), 0, 0);
+}
+jobject JNICALL Rec_NewLocalRef(JNIEnv* env, jobject obj) {
+    jobject r = s_next->NewLocalRef(env, obj);
+    LC_REC(kNewLocalRef, Id(obj), 0, Id(r));
+    return r;
+}
+void JNICALL Rec_DeleteLocalRef(JNIEnv* env, jobject obj) {
+    s_next->DeleteLocalRef(env, obj);
+    LC_REC(kDeleteLocalRef, Id(obj), 0, 0);
+}
+jint JNICALL Rec_PushLocalFrame(JNIEnv* env, jint capacity) {
+    jint r = s_next->PushLocalFrame(env, capacity);
+    LC_REC(kPushLocalFrame, 0, Zig(capacity), Zig(r));
+    return r;
+}
+jobject JNICALL Rec_PopLocalFrame(JNIEnv* env, jobject result) {
+    jobject r = s_next->PopLocalFrame(env, result);
+    LC_REC(kPopLocalFrame, Id(result), 0, Id(r));
+    return r;
+}
+
+jboolean JNICALL Rec_ExceptionCheck(JNIEnv* env) {
+    jboolean r = s_next->ExceptionCheck(env);
+    LC_REC(kExceptionCheck, 0, 0, r);
+    return r;
+}
+void JNICALL Rec_ExceptionClear(JNIEnv* env) {
+    s_next->ExceptionClear(env);
+    LC_REC(kExceptionClear, 0, 0, 0);
+}
+jthrowable JNICALL Rec_ExceptionOccurred(JNIEnv* env) {
+    jthrowable r = s_next->ExceptionOccurred(env);
+    LC_REC(kExceptionOccurred, 0, 0, Id(r));
+    return r;
+}
+
+void* JNICALL Rec_GetDirectBufferAddress(JNIEnv* env, jobject buf) {
+    void* r = s_next->GetDirectBufferAddress(env, buf);
+    jlong cap = r ? s_next->GetDirectBufferCapacity(env, buf) : 0;
+    LC_REC(kGetDirectBufferAddress, Id(buf), Zig(cap > 0 ? cap : 0), Id(r));
+    return r;
+}
+jlong JNICALL Rec_GetDirectBufferCapacity(JNIEnv* env, jobject buf) {
+    jlong r = s_next->GetDirectBufferCapacity(env, buf);
+    LC_REC(kGetDirectBufferCapacity, Id(buf), 0, Zig(r));
+    return r;
+}
+jobject JNICALL Rec_NewDirectByteBuffer(JNIEnv* env, void* address, jlong capacity) {
+    jobject r = s_next->NewDirectByteBuffer(env, address, capacity);
+    LC_REC(kNewDirectByteBuffer, Id(address), Zig(capacity), Id(r));
+    return r;
+}
+
+#define LC_REC_INSTALL_CALLS(Type, jtype, tag)                           \
+    t.Call##Type##Method = Rec_Call##Type##Method;                       \
+    t.Call##Type##MethodV = Rec_Call##Type##MethodV;                     \
+    t.Call##Type##MethodA = Rec_Call##Type##MethodA;                     \
+    t.CallNonvirtual##Type##Method = Rec_CallNonvirtual##Type##Method;   \
+    t.CallNonvirtual##Type##MethodV = Rec_CallNonvirtual##Type##MethodV; \
+    t.CallNonvirtual##Type##MethodA = Rec_CallNonvirtual##Type##MethodA; \
+    t.CallStatic##Type##Method = Rec_CallStatic##Type##Method;           \
+    t.CallStatic##Type##MethodV = Rec_CallStatic##Type##MethodV;         \
+    t.CallStatic##Type##MethodA = Rec_CallStatic##Type##MethodA;
+
+#define LC_REC_INSTALL_FIELDS(Type, jtype, tag)             \
+    t.Get##Type##Field = Rec_Get##Type##Field;              \
+    t.Set##Type##Field = Rec_Set##Type##Field;              \
+    t.GetStatic##Type##Field = Rec_GetStatic##Type##Field;
+
+// Same rules as JniAccounting's table: built once, from the table the first
+// recording scope finds; a thread that loses the race does not record.
+bool EnsureRecordingTable(JNIEnv* env) {
+    if (InterlockedCompareExchange(&s_tableState, 0, 0) == 2) return true;
+    if (InterlockedCompareExchange(&s_tableState, 1, 0) != 0) return false;
+    JNINativeInterface_& t = s_recording;
+    t = *env->functions;
+    LC_REPLAY_TYPES(LC_REC_INSTALL_CALLS)
+    LC_REPLAY_TYPES(LC_REC_INSTALL_FIELDS)
+    t.CallVoidMethod = Rec_CallVoidMethod;
+    t.CallVoidMethodV = Rec_CallVoidMethodV;
+    t.CallVoidMethodA = Rec_CallVoidMethodA;
+    t.CallNonvirtualVoidMethod = Rec_CallNonvirtualVoidMethod;
+    t.CallNonvirtualVoidMethodV = Rec_CallNonvirtualVoidMethodV;
+    t.CallNonvirtualVoidMethodA = Rec_CallNonvirtualVoidMethodA;
+    t.CallStaticVoidMethod = Rec_CallStaticVoidMethod;
+    t.CallStaticVoidMethodV = Rec_CallStaticVoidMethodV;
+    t.CallStaticVoidMethodA = Rec_CallStaticVoidMethodA;
+    t.NewObject = Rec_NewObject;
+    t.NewObjectV = Rec_NewObjectV;
+    t.NewObjectA = Rec_NewObjectA;
+    t.FindClass = Rec_FindClass;
+    t.GetObjectClass = Rec_GetObjectClass;
+    t.GetMethodID = Rec_GetMethodID;
+    t.GetStaticMethodID = Rec_GetStaticMethodID;
+    t.GetFieldID = Rec_GetFieldID;
+    t.GetStaticFieldID = Rec_GetStaticFieldID;
+    t.FromReflectedMethod = Rec_FromReflectedMethod;
+    t.ToReflectedMethod = Rec_ToReflectedMethod;
+    t.ToReflectedField = Rec_ToReflectedField;
+    t.IsInstanceOf = Rec_IsInstanceOf;
+    t.IsAssignableFrom = Rec_IsAssignableFrom;
+    t.IsSameObject = Rec_IsSameObject;
+    t.GetArrayLength = Rec_GetArrayLength;
+    t.GetObjectArrayElement = Rec_GetObjectArrayElement;
+    t.SetObjectArrayElement = Rec_SetObjectArrayElement;
+    t.NewObjectArray = Rec_NewObjectArray;
+    t.NewByteArray = Rec_NewByteArray;
+    t.SetByteArrayRegion = Rec_SetByteArrayRegion;
+    t.GetFloatArrayRegion = Rec_GetFloatArrayRegion;
+    t.GetStringUTFChars = Rec_GetStringUTFChars;
+    t.ReleaseStringUTFChars = Rec_ReleaseStringUTFChars;
+    t.NewStringUTF = Rec_NewStringUTF;
+    t.NewGlobalRef = Rec_NewGlobalRef;
+    t.DeleteGlobalRef = Rec_DeleteGlobalRef;
+    t.NewWeakGlobalRef = Rec_NewWeakGlobalRef;
+    t.DeleteWeakGlobalRef = Rec_DeleteWeakGlobalRef;
+    t.NewLocalRef = Rec_NewLocalRef;
+    t.DeleteLocalRef = Rec_DeleteLocalRef;
+    t.PushLocalFrame = Rec_PushLocalFrame;
+    t.PopLocalFrame = Rec_PopLocalFrame;
+    t.ExceptionCheck = Rec_ExceptionCheck;
+    t.ExceptionClear = Rec_ExceptionClear;
+    t.ExceptionOccurred = Rec_ExceptionOccurred;
+    t.GetDirectBufferAddress = Rec_GetDirectBufferAddress;
+    t.GetDirectBufferCapacity = Rec_GetDirectBufferCapacity;
+    t.NewDirectByteBuffer = Rec_NewDirectByteBuffer;
+    InterlockedExchangePointer((PVOID volatile*)&s_next, (PVOID)env->functions);
+    InterlockedExchange(&s_tableState, 2);
+    return true;
+}
+
+// ── Replay table ─────────────────────────────────────────────────────────────
+
+inline Player* P(JNIEnv* env) { return static_cast<PlayerEnv*>(env)->player; }
+inline Arg H(const void* p) { return Arg::Handle(p); }
+inline Arg N(long long v) { return Arg::Number(Zig(v)); }
+
+template <class T>
+inline T PlayValue(JNIEnv* env, int op, const Arg& a, const Arg& b) {
+    const Record* r = P(env)->Next(op, a, b);
+    return r ? FromBits<T>(r->value) : T();
+}
+
+inline void PlayVoid(JNIEnv* env, int op, const Arg& a, const Arg& b) {
+    P(env)->Next(op, a, b);
+}
+
+#define LC_PLAY_CALLS(Type, jtype, tag)                                                                \
+    jtype JNICALL Play_Call##Type##Method(JNIEnv* env, jobject obj, jmethodID mid, ...) {              \
+        return PlayValue<jtype>(env, kCall + tag, H(obj), H(mid));                                     \
+    }                                                                                                  \
+    jtype JNICALL Play_Call##Type##MethodV(JNIEnv* env, jobject obj, jmethodID mid, va_list) {         \
+        return PlayValue<jtype>(env, kCall + tag, H(obj), H(mid));                                     \
+    }                                                                                                  \
+    jtype JNICALL Play_Call##Type##MethodA(JNIEnv* env, jobject obj, jmethodID mid, const jvalue*) {   \
+        return PlayValue<jtype>(env, kCall + tag, H(obj), H(mid));                                     \
+    }                                                                                                  \
+    jtype JNICALL Play_CallNonvirtual##Type##Method(JNIEnv* env, jobject obj, jclass, jmethodID mid, ...) { \
+        return PlayValue<jtype>(env, kCall + tag, H(obj), H(mid));                                     \
+    }                                                                                                  \
+    jtype JNICALL Play_CallNonvirtual##Type##MethodV(JNIEnv* env, jobject obj, jclass, jmethodID mid, va_list) { \
+        return PlayValue<jtype>(env, kCall + tag, H(obj), H(mid));                                     \
+    }                                                                                                  \
+    jtype JNICALL Play_CallNonvirtual##Type##MethodA(JNIEnv* env, jobject obj, jclass, jmethodID mid,  \
+                                                     const jvalue*) {                                  \
+        return PlayValue<jtype>(env, kCall + tag, H(obj), H(mid));                                     \
+    }                                                                                                  \
+    jtype JNICALL Play_CallStatic##Type##Method(JNIEnv* env, jclass cls, jmethodID mid, ...) {         \
+        return PlayValue<jtype>(env, kCallStatic + tag, H(cls), H(mid));                               \
+    }                                                                                                  \
+    jtype JNICALL Play_CallStatic##Type##MethodV(JNIEnv* env, jclass cls, jmethodID mid, va_list) {    \
+        return PlayValue<jtype>(env, kCallStatic + tag, H(cls), H(mid));                               \
+    }                                                                                                  \
+    jtype JNICALL Play_CallStatic##Type##MethodA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue*) { \
+        return PlayValue<jtype>(env, kCallStatic + tag, H(cls), H(mid));                               \
+    }
+
+#define LC_PLAY_FIELDS(Type, jtype, tag)                                                               \
+    jtype JNICALL Play_Get##Type##Field(JNIEnv* env, jobject obj, jfieldID fid) {                      \
+        return PlayValue<jtype>(env, kGetField + tag, H(obj), H(fid));                                 \
+    }                                                                                                  \
+    void JNICALL Play_Set##Type##Field(JNIEnv* env, jobject obj, jfieldID fid, jtype) {                \
+        PlayVoid(env, kSetField + tag, H(obj), H(fid));                                                \
+    }                                                                                                  \
+    jtype JNICALL Play_GetStatic##Type##Field(JNIEnv* env, jclass cls, jfieldID fid) {                 \
+        return PlayValue<jtype>(env, kGetStatic + tag, H(cls), H(fid));                                \
+    }
+
+LC_REPLAY_TYPES(LC_PLAY_CALLS)
+LC_REPLAY_TYPES(LC_PLAY_FIELDS)
+
+void JNICALL Play_CallVoidMethod(JNIEnv* env, jobject obj, jmethodID mid, ...) {
+    PlayVoid(env, kCall + kVoid, H(obj), H(mid));
+}
+void JNICALL Play_CallVoidMethodV(JNIEnv* env, jobject obj, jmethodID mid, va_list) {
+    PlayVoid(env, kCall + kVoid, H(obj), H(mid));
+}
+void JNICALL Play_CallVoidMethodA(JNIEnv* env, jobject obj, jmethodID mid, const jvalue*) {
+    PlayVoid(env, kCall + kVoid, H(obj), H(mid));
+}
+void JNICALL Play_CallNonvirtualVoidMethod(JNIEnv* env, jobject obj, jclass, jmethodID mid, ...) {
+    PlayVoid(env, kCall + kVoid, H(obj), H(mid));
+}
+void JNICALL Play_CallNonvirtualVoidMethodV(JNIEnv* env, jobject obj, jclass, jmethodID mid, va_list) {
+    PlayVoid(env, kCall + kVoid, H(obj), H(mid));
+}
+void JNICALL Play_CallNonvirtualVoidMethodA(JNIEnv* env, jobject obj, jclass, jmethodID mid, const jvalue*) {
+    PlayVoid(env, kCall + kVoid, H(obj), H(mid));
+}
+void JNICALL Play_CallStaticVoidMethod(JNIEnv* env, jclass cls, jmethodID mid, ...) {
+    PlayVoid(env, kCallStatic + kVoid, H(cls), H(mid));
+}
+void JNICALL Play_CallStaticVoidMethodV(JNIEnv* env, jclass cls, jmethodID mid, va_list) {
+    PlayVoid(env, kCallStatic + kVoid, H(cls), H(mid));
+}
+void JNICALL Play_CallStaticVoidMethodA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue*) {
+    PlayVoid(env, kCallStatic + kVoid, H(cls), H(mid));
+}
+
+jobject JNICALL Play_NewObject(JNIEnv* env, jclass cls, jmethodID mid, ...) {
+    return PlayValue<jobject>(env, kNewObject, H(cls), H(mid));
+}
+jobject JNICALL Play_NewObjectV(JNIEnv* env, jclass cls, jmethodID mid, va_list) {
+    return PlayValue<jobject>(env, kNewObject, H(cls), H(mid));
+}
+jobject JNICALL Play_NewObjectA(JNIEnv* env, jclass cls, jmethodID mid, const jvalue*) {
+    return PlayValue<jobject>(env, kNewObject, H(cls), H(mid));
+}
+
+// Lookups check the name and signature too: a different member asked for in
+// the same place is a divergence.
+const Record* NextNamed(JNIEnv* env, int op, const Arg& a, const std::string& blob) {
+    Player* p = P(env);
+    size_t at = p->Position();
+    const Record* r = p->Next(op, a, Arg::Any());
+    if (r && r->blob != blob) {
+        char buf[160];
+        snprintf(buf, sizeof(buf), "record %lu: %s for a different name", (unsigned long)at, OpName(op));
+        p->Diverge(buf);
+        return nullptr;
+    }
+    return r;
+}
+
+jclass JNICALL Play_FindClass(JNIEnv* env, const char* name) {
+    const Record* r = NextNamed(env, kFindClass, Arg::Any(), name ? name : "");
+    return r ? (jclass)Player::Handle(r->value) : nullptr;
+}
+jclass JNICALL Play_GetObjectClass(JNIEnv* env, jobject obj) {
+    return (jclass)PlayValue<jobject>(env, kGetObjectClass, H(obj), Arg::Any());
+}
+jmethodID JNICALL Play_GetMethodID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    const Record* r = NextNamed(env, kGetMethodID, H(cls), NameSig(name, sig));
+    return r ? (jmethodID)Player::Handle(r->value) : nullptr;
+}
+jmethodID JNICALL Play_GetStaticMethodID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    const Record* r = NextNamed(env, kGetStaticMethodID, H(cls), NameSig(name, sig));
+    return r ? (jmethodID)Player::Handle(r->value) : nullptr;
+}
+jfieldID JNICALL Play_GetFieldID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    const Record* r = NextNamed(env, kGetFieldID, H(cls), NameSig(name, sig));
+    return r ? (jfieldID)Player::Handle(r->value) : nullptr;
+}
+jfieldID JNICALL Play_GetStaticFieldID(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+    const Record* r = NextNamed(env, kGetStaticFieldID, H(cls), NameSig(name, sig));
+    return r ? (jfieldID)Player::Handle(r->value) : nullptr;
+}
+jmethodID JNICALL Play_FromReflectedMethod(JNIEnv* env, jobject method) {
+    return (jmethodID)(void*)PlayValue<jobject>(env, kFromReflectedMethod, H(method), Arg::Any());
+}
+jobject JNICALL Play_ToReflectedMethod(JNIEnv* env, jclass cls, jmethodID mid, jboolean) {
+    return PlayValue<jobject>(env, kToReflectedMethod, H(cls), H(mid));
+}
+jobject JNICALL Play_ToReflectedField(JNIEnv* env, jclass cls, jfieldID fid, jboolean) {
+    return PlayValue<jobject>(env, kToReflectedField, H(cls), H(fid));
+}
+jboolean JNICALL Play_IsInstanceOf(JNIEnv* env, jobject obj, jclass cls) {
+    return PlayValue<jboolean>(env, kIsInstanceOf, H(obj), H(cls)) ? JNI_TRUE : JNI_FALSE;
+}
+jboolean JNICALL Play_IsAssignableFrom(JNIEnv* env, jclass sub, jclass sup) {
+    return PlayValue<jboolean>(env, kIsAssignableFrom, H(sub), H(sup)) ? JNI_TRUE : JNI_FALSE;
+}
+jboolean JNICALL Play_IsSameObject(JNIEnv* env, jobject x, jobject y) {
+    return PlayValue<jboolean>(env, kIsSameObject, H(x), H(y)) ? JNI_TRUE : JNI_FALSE;
+}
+
+jsize JNICALL Play_GetArrayLength(JNIEnv* env, jarray arr) {
+    return PlayValue<jsize>(env, kGetArrayLength, H(arr), Arg::Any());
+}
+jobject JNICALL Play_GetObjectArrayElement(JNIEnv* env, jobjectArray arr, jsize i) {
+    return PlayValue<jobject>(env, kGetObjectArrayElement, H(arr), N(i));
+}
+void JNICALL Play_SetObjectArrayElement(JNIEnv* env, jobjectArray arr, jsize i, jobject) {
+    PlayVoid(env, kSetObjectArrayElement, H(arr), N(i));
+}
+jobjectArray JNICALL Play_NewObjectArray(JNIEnv* env, jsize len, jclass cls, jobject) {
+    return (jobjectArray)PlayValue<jobject>(env, kNewObjectArray, H(cls), N(len));
+}
+jbyteArray JNICALL Play_NewByteArray(JNIEnv* env, jsize len) {
+    return (jbyteArray)PlayValue<jobject>(env, kNewByteArray, Arg::Any(), N(len));
+}
+void JNICALL Play_SetByteArrayRegion(JNIEnv* env, jbyteArray arr, jsize start, jsize, const jbyte*) {
+    PlayVoid(env, kSetByteArrayRegion, H(arr), N(start));
+}
+void JNICALL Play_GetFloatArrayRegion(JNIEnv* env, jfloatArray arr, jsize start, jsize len, jfloat* buf) {
+    const Record* r = P(env)->Next(kGetFloatArrayRegion, H(arr), N(start));
+    if (!buf || len <= 0) return;
+    size_t want = (size_t)len * sizeof(jfloat);
+    size_t have = r ? r->blob.size() : 0;
+    if (have > want) have = want;
+    if (have) std::memcpy(buf, r->blob.data(), have);
+    if (have < want) std::memset((char*)buf + have, 0, want - have);
+}
+
+const char* JNICALL Play_GetStringUTFChars(JNIEnv* env, jstring s, jboolean* isCopy) {
+    const Record* r = P(env)->Next(kGetStringUTFChars, H(s), Arg::Any());
+    if (isCopy) *isCopy = JNI_TRUE;
+    return (r && r->value) ? P(env)->KeepString(r->blob) : nullptr;
+}
+void JNICALL Play_ReleaseStringUTFChars(JNIEnv* env, jstring s, const char* chars) {
+    P(env)->DropString(chars);
+    PlayVoid(env, kReleaseStringUTFChars, H(s), Arg::Any());
+}
+jstring JNICALL Play_NewStringUTF(JNIEnv* env, const char* utf) {
+    const Record* r = NextNamed(env, kNewStringUTF, Arg::Any(), utf ? utf : "");
+    return r ? (jstring)Player::Handle(r->value) : nullptr;
+}
+
+jobject JNICALL Play_NewGlobalRef(JNIEnv* env, jobject obj) {
+    return PlayValue<jobject>(env, kNewGlobalRef, H(obj), Arg::Any());
+}
+void JNICALL Play_DeleteGlobalRef(JNIEnv* env, jobject obj) {
+    PlayVoid(env, kDeleteGlobalRef, H(obj), Arg::Any());
+}
+jweak JNICALL Play_NewWeakGlobalRef(JNIEnv* env, jobject obj) {
+    return PlayValue<jobject>(env, kNewWeakGlobalRef, H(obj), Arg::Any());
+}
+void JNICALL Play_DeleteWeakGlobalRef(JNIEnv* env, jweak obj) {
+    PlayVoid(env, kDeleteWeakGlobalRef, H(obj), Arg::Any());
+}
+jobject JNICALL Play_NewLocalRef(JNIEnv* env, jobject obj) {
+    return PlayValue<jobject>(env, kNewLocalRef, H(obj), Arg::Any());
+}
+void JNICALL Play_DeleteLocalRef(JNIEnv* env, jobject obj) {
+    PlayVoid(env, kDeleteLocalRef, H(obj), Arg::Any());
+}
+jint JNICALL Play_PushLocalFrame(JNIEnv* env, jint capacity) {
+    return PlayValue<jint>(env, kPushLocalFrame, Arg::Any(), N(capacity));
+}
+jobject JNICALL Play_PopLocalFrame(JNIEnv* env, jobject result) {
+    return PlayValue<jobject>(env, kPopLocalFrame, H(result), Arg::Any());
+}
+
+jboolean JNICALL Play_ExceptionCheck(JNIEnv* env) {
+    return PlayValue<jboolean>(env, kExceptionCheck, Arg::Any(), Arg::Any()) ? JNI_TRUE : JNI_FALSE;
+}
+void JNICALL Play_ExceptionClear(JNIEnv* env) {
+    PlayVoid(env, kExceptionClear, Arg::Any(), Arg::Any());
+}
+jthrowable JNICALL Play_ExceptionOccurred(JNIEnv* env) {
+    return (jthrowable)PlayValue<jobject>(env, kExceptionOccurred, Arg::Any(), Arg::Any());
+}
+
+void* JNICALL Play_GetDirectBufferAddress(JNIEnv* env, jobject buf) {
+    const Record* r = P(env)->Next(kGetDirectBufferAddress, H(buf), Arg::Any());
+    return (r && r->value) ? P(env)->Buffer(r->value, (u64)Unzig(r->b)) : nullptr;
+}
+jlong JNICALL Play_GetDirectBufferCapacity(JNIEnv* env, jobject buf) {
+    return PlayValue<jlong>(env, kGetDirectBufferCapacity, H(buf), Arg::Any());
+}
+jobject JNICALL Play_NewDirectByteBuffer(JNIEnv* env, void* address, jlong capacity) {
+    return PlayValue<jobject>(env, kNewDirectByteBuffer, H(address), N(capacity));
+}
+
+#define LC_PLAY_INSTALL_CALLS(Type, jtype, tag)                           \
+    t.Call##Type##Method = Play_Call##Type##Method;                       \
+    t.Call##Type##MethodV = Play_Call##Type##MethodV;                     \
+    t.Call##Type##MethodA = Play_Call##Type##MethodA;                     \
+    t.CallNonvirtual##Type##Method = Play_CallNonvirtual##Type##Method;   \
+    t.CallNonvirtual##Type##MethodV = Play_CallNonvirtual##Type##MethodV; \
+    t.CallNonvirtual##Type##MethodA = Play_CallNonvirtual##Type##MethodA; \
+    t.CallStatic##Type##Method = Play_CallStatic##Type##Method;           \
+    t.CallStatic##Type##MethodV = Play_CallStatic##Type##MethodV;         \
+    t.CallStatic##Type##MethodA = Play_CallStatic##Type##MethodA;
+
+#define LC_PLAY_INSTALL_FIELDS(Type, jtype, tag)             \
+    t.Get##Type##Field = Play_Get##Type##Field;              \
+    t.Set##Type##Field = Play_Set##Type##Field;              \
+    t.GetStatic##Type##Field = Play_GetStatic##Type##Field;
+
+const JNINativeInterface_* PlayTable() {
+    static JNINativeInterface_ s_table;
+    static bool s_built = false;
+    if (s_built) return &s_table;
+    JNINativeInterface_& t = s_table;
+    std::memset(&t, 0, sizeof(t));
+    LC_REPLAY_TYPES(LC_PLAY_INSTALL_CALLS)
+    LC_REPLAY_TYPES(LC_PLAY_INSTALL_FIELDS)
+    t.CallVoidMethod = Play_CallVoidMethod;
+    t.CallVoidMethodV = Play_CallVoidMethodV;
+    t.CallVoidMethodA = Play_CallVoidMethodA;
+    t.CallNonvirtualVoidMethod = Play_CallNonvirtualVoidMethod;
+    t.CallNonvirtualVoidMethodV = Play_CallNonvirtualVoidMethodV;
+    t.CallNonvirtualVoidMethodA = Play_CallNonvirtualVoidMethodA;
+    t.CallStaticVoidMethod = Play_CallStaticVoidMethod;
+    t.CallStaticVoidMethodV = Play_CallStaticVoidMethodV;
+    t.CallStaticVoidMethodA = Play_CallStaticVoidMethodA;
+    t.NewObject = Play_NewObject;
+    t.NewObjectV = Play_NewObjectV;
+    t.NewObjectA = Play_NewObjectA;
+    t.FindClass = Play_FindClass;
+    t.GetObjectClass = Play_GetObjectClass;
+    t.GetMethodID = Play_GetMethodID;
+    t.GetStaticMethodID = Play_GetStaticMethodID;
+    t.GetFieldID = Play_GetFieldID;
+    t.GetStaticFieldID = Play_GetStaticFieldID;
+    t.FromReflectedMethod = Play_FromReflectedMethod;
+    t.ToReflectedMethod = Play_ToReflectedMethod;
+    t.ToReflectedField = Play_ToReflectedField;
+    t.IsInstanceOf = Play_IsInstanceOf;
+    t.IsAssignableFrom = Play_IsAssignableFrom;
+    t.IsSameObject = Play_IsSameObject;
+    t.GetArrayLength = Play_GetArrayLength;
+    t.GetObjectArrayElement = Play_GetObjectArrayElement;
+    t.SetObjectArrayElement = Play_SetObjectArrayElement;
+    t.NewObjectArray = Play_NewObjectArray;
+    t.NewByteArray = Play_NewByteArray;
+    t.SetByteArrayRegion = Play_SetByteArrayRegion;
+    t.GetFloatArrayRegion = Play_GetFloatArrayRegion;
+    t.GetStringUTFChars = Play_GetStringUTFChars;
+    t.ReleaseStringUTFChars = Play_ReleaseStringUTFChars;
+    t.NewStringUTF = Play_NewStringUTF;
+    t.NewGlobalRef = Play_NewGlobalRef;
+    t.DeleteGlobalRef = Play_DeleteGlobalRef;
+    t.NewWeakGlobalRef = Play_NewWeakGlobalRef;
+    t.DeleteWeakGlobalRef = Play_DeleteWeakGlobalRef;
+    t.NewLocalRef = Play_NewLocalRef;
+    t.DeleteLocalRef = Play_DeleteLocalRef;
+    t.PushLocalFrame = Play_PushLocalFrame;
+    t.PopLocalFrame = Play_PopLocalFrame;
+    t.ExceptionCheck = Play_ExceptionCheck;
+    t.ExceptionClear = Play_ExceptionClear;
+    t.ExceptionOccurred = Play_ExceptionOccurred;
+    t.GetDirectBufferAddress = Play_GetDirectBufferAddress;
+    t.GetDirectBufferCapacity = Play_GetDirectBufferCapacity;
+    t.NewDirectByteBuffer = Play_NewDirectByteBuffer;
+    s_built = true;
+    return &s_table;
+}
+
+// Handles the player hands out: id * 16 above a non-canonical base on x64, so
+// they can never alias a caller's real pointer.
+const uintptr_t kHandleBase = (uintptr_t)1 << (sizeof(void*) * 8 - 2);
+
+} // namespace
+
+const char* OpName(int op) {
+    static const char* const kNames[] = {
+        "FindClass", "GetObjectClass", "GetMethodID", "GetStaticMethodID", "GetFieldID", "GetStaticFieldID",
+        "FromReflectedMethod", "ToReflectedMethod", "ToReflectedField",
+        "IsInstanceOf", "IsAssignableFrom", "IsSameObject",
+        "NewObject",
+        "GetArrayLength", "GetObjectArrayElement", "SetObjectArrayElement", "NewObjectArray",
+        "NewByteArray", "SetByteArrayRegion", "GetFloatArrayRegion",
+        "GetStringUTFChars", "ReleaseStringUTFChars", "NewStringUTF",
+        "NewGlobalRef", "DeleteGlobalRef", "NewWeakGlobalRef", "DeleteWeakGlobalRef",
+        "NewLocalRef", "DeleteLocalRef", "PushLocalFrame", "PopLocalFrame",
+        "ExceptionCheck", "ExceptionClear", "ExceptionOccurred",
+        "GetDirectBufferAddress", "GetDirectBufferCapacity", "NewDirectByteBuffer"
+    };
+    static const char* const kTypes[kTypeCount] = {
+        "Void", "Object", "Boolean", "Byte", "Char", "Short", "Int", "Long", "Float", "Double"
+    };
+    static const char* const kGroups[] = { "Call%sMethod", "CallStatic%sMethod", "Get%sField", "GetStatic%sField", "Set%sField" };
+    static char s_typed[kOpCount - kCall][32];
+    if (op >= 0 && op < kCall) return kNames[op];
+    if (op < kCall || op >= kOpCount) return "?";
+    char* name = s_typed[op - kCall];
+    if (!name[0]) snprintf(name, sizeof(s_typed[0]), kGroups[(op - kCall) / kTypeCount], kTypes[(op - kCall) % kTypeCount]);
+    return name;
+}
+
+// ── Recording API ────────────────────────────────────────────────────────────
+
+bool StartRecording(const std::string& path, unsigned long maxBytes) {
+    Guard g;
+    if (s_file) return false;
+    s_file = std::fopen(path.c_str(), "wb");
+    if (!s_file) return false;
+    s_buf.assign("LCJR", 4);
+    for (int i = 0; i < 4; i++) s_buf += (char)((kVersion >> (8 * i)) & 0xFF);
+    s_written = 0;
+    s_maxBytes = maxBytes;
+    s_ids.clear();
+    s_nextId = 0;
+    InterlockedExchange(&s_calls, 0);
+    InterlockedExchange(&s_active, 1);
+    return true;
+}
+
+void StopRecording() {
+    Guard g;
+    CloseLocked();
+}
+
+bool Recording() {
+    return InterlockedCompareExchange(&s_active, 0, 0) != 0;
+}
+
+unsigned long RecordedCalls() {
+    return (unsigned long)InterlockedCompareExchange(&s_calls, 0, 0);
+}
+
+RecordScope::RecordScope(JNIEnv* env) : _env(env), _savedTable(nullptr) {
+    if (!env || !Recording()) return;
+    if (!EnsureRecordingTable(env)) return;
+    if (env->functions != s_next) return;   // some other table; leave it alone
+    _savedTable = env->functions;
+    env->functions = &s_recording;
+}
+
+RecordScope::~RecordScope() {
+    if (_savedTable) _env->functions = (const JNINativeInterface_*)_savedTable;
+}
+
+// ── Player ───────────────────────────────────────────────────────────────────
+
+Player::Player() : _pos(0) {
+    _env.functions = PlayTable();
+    _env.player = this;
+}
+
+Player::~Player() {
+    Reset();
+}
+
+void Player::Reset() {
+    for (size_t i = 0; i < _strings.size(); i++) std::free(_strings[i]);
+    _strings.clear();
+    _foreign.clear();
+    _buffers.clear();
+    _divergence.clear();
+    _pos = 0;
+}
+
+bool Player::Load(const std::string& path, std::string* error) {
+    Reset();
+    _records.clear();
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    std::vector<unsigned char> data;
+    unsigned char chunk[65536];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) data.insert(data.end(), chunk, chunk + n);
+    std::fclose(f);
+
+    if (data.size() < 8 || std::memcmp(&data[0], "LCJR", 4) != 0) {
+        if (error) *error = "not a JNI recording";
+        return false;
+    }
+    unsigned version = data[4] | (data[5] << 8) | (data[6] << 16) | ((unsigned)data[7] << 24);
+    if (version != kVersion) {
+        if (error) *error = "unsupported recording version";
+        return false;
+    }
+    const unsigned char* p = &data[0] + 8;
+    const unsigned char* end = &data[0] + data.size();
+    while (p < end) {
+        Record r;
+        r.op = *p++;
+        u64 len = 0;
+        bool ok = r.op < kOpCount && GetVarint(p, end, r.a) && GetVarint(p, end, r.b) && GetVarint(p, end, r.value);
+        if (ok && OpHasBlob(r.op)) {
+            ok = GetVarint(p, end, len) && len <= (u64)(end - p);
+            if (ok) {
+                r.blob.assign((const char*)p, (size_t)len);
+                p += len;
+            }
+        }
+        if (!ok) {
+            // A recording cut short by a crash keeps every complete record.
+            if (error) *error = "truncated at record " + std::to_string(_records.size());
+            break;
+        }
+        _records.push_back(r);
+    }
+    return true;
+}
+
+JNIEnv* Player::Env() {
+    return &_env;
+}
+
+void Player::Rewind() {
+    Reset();
+}
+
+void* Player::Handle(unsigned long long id) {
+    return id ? (void*)(kHandleBase + (uintptr_t)id * 16) : nullptr;
+}
+
+void Player::Diverge(const std::string& why) {
+    if (_divergence.empty()) _divergence = why;
+}
+
+bool Player::Matches(const Arg& in, unsigned long long recorded) {
+    if (in.kind == Arg::kAny) return true;
+    if (in.kind == Arg::kNumber) return in.v == recorded;
+    if (!in.p) return recorded == 0;
+    uintptr_t h = (uintptr_t)in.p;
+    for (size_t i = 0; i < _foreign.size(); i++)
+        if (_foreign[i].first == in.p) return _foreign[i].second == recorded;
+    if (h >= kHandleBase && (h - kHandleBase) % 16 == 0) return (h - kHandleBase) / 16 == recorded;
+    // First sight of a caller's own pointer: it is whatever the recording had here.
+    _foreign.push_back(std::make_pair(in.p, recorded));
+    return true;
+}
+
+const Record* Player::Next(int op, const Arg& a, const Arg& b) {
+    if (!_divergence.empty()) return nullptr;
+    char buf[160];
+    if (_pos >= _records.size()) {
+        snprintf(buf, sizeof(buf), "past the end of the recording (%s)", OpName(op));
+        Diverge(buf);
+        return nullptr;
+    }
+    const Record& r = _records[_pos];
+    if (r.op != op) {
+        snprintf(buf, sizeof(buf), "record %lu: recorded %s, replayed %s", (unsigned long)_pos, OpName(r.op), OpName(op));
+        Diverge(buf);
+        return nullptr;
+    }
+    if (!Matches(a, r.a) || !Matches(b, r.b)) {
+        snprintf(buf, sizeof(buf), "record %lu: %s with different inputs", (unsigned long)_pos, OpName(op));
+        Diverge(buf);
+        return nullptr;
+    }
+    ++_pos;
+    return &r;
+}
+
+const char* Player::KeepString(const std::string& s) {
+    char* copy = (char*)std::malloc(s.size() + 1);
+    if (!copy) return nullptr;
+    std::memcpy(copy, s.data(), s.size());
+    copy[s.size()] = '\0';
+    _strings.push_back(copy);
+    return copy;
+}
+
+void Player::DropString(const char* p) {
+    for (size_t i = 0; i < _strings.size(); i++) {
+        if (_strings[i] != p) continue;
+        std::free(_strings[i]);
+        _strings[i] = _strings.back();
+        _strings.pop_back();
+        return;
+    }
+}
+
+void* Player::Buffer(unsigned long long id, unsigned long long capacity) {
+    for (size_t i = 0; i < _buffers.size(); i++)
+        if (_buffers[i].first == id) return _buffers[i].second.empty() ? nullptr : &_buffers[i].second[0];
+    _buffers.push_back(std::make_pair(id, std::vector<char>((size_t)capacity)));
+    std::vector<char>& storage = _buffers.back().second;
+    if (storage.empty()) return nullptr;
+    _foreign.push_back(std::make_pair((const void*)&storage[0], id));
+    return &storage[0];
+}
+
+} // namespace JniReplay
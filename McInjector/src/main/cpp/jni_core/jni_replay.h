@@ -0,0 +1,163 @@
+#pragma once
+// jni_core/jni_replay.h
+// Record-and-replay of the JNI traffic of the scan thread, so scan code can be
+// profiled and regression-tested without a running game.
+//
+// Recording works like JniAccounting: a RecordScope points the thread's JNIEnv
+// at a copy of the table it found, whose lookup, call, field, array, string,
+// ref, exception and direct-buffer entries forward to that table and append
+// (op, inputs, result) to the recording.  Objects, classes, member IDs and
+// buffer addresses are written as small ids assigned on first sight, so a
+// file does not depend on where things lived in the game's process.  Open the
+// RecordScope inside any JniAccounting::Scope so both see the calls.
+//
+// Replay: a Player loads a file and hands out a JNIEnv whose table answers
+// each call with the next recorded result.  Every call is checked against the
+// recording (op and the handle / index inputs); the first mismatch is kept as
+// the divergence and later calls return zero values.  Pointers that were not
+// handed out by the player (e.g. a caller's own direct buffer) are bound to
+// the id the recording expects the first time they appear.
+//
+// Not recorded: the extra arguments of Call* / NewObject (they are not
+// checked on replay) and the contents of direct buffers, which replay as
+// zeroed memory of the recorded capacity.  Entries outside the list in
+// jni_replay.cpp are null in the replay table.
+//
+// File: "LCJR" u32 version, then one record per call: op byte, varint a,
+// varint b, varint value, and for ops that carry one, varint length + bytes
+// (class / member names, UTF strings, array regions).
+
+#include <jni.h>
+#include <windows.h>
+#include <string>
+#include <vector>
+
+namespace JniReplay {
+
+enum Type { kVoid, kObject, kBoolean, kByte, kChar, kShort, kInt, kLong, kFloat, kDouble, kTypeCount };
+
+// Typed ops are base + Type.
+enum Op {
+    kFindClass, kGetObjectClass, kGetMethodID, kGetStaticMethodID, kGetFieldID, kGetStaticFieldID,
+    kFromReflectedMethod, kToReflectedMethod, kToReflectedField,
+    kIsInstanceOf, kIsAssignableFrom, kIsSameObject,
+    kNewObject,
+    kGetArrayLength, kGetObjectArrayElement, kSetObjectArrayElement, kNewObjectArray,
+    kNewByteArray, kSetByteArrayRegion, kGetFloatArrayRegion,
+    kGetStringUTFChars, kReleaseStringUTFChars, kNewStringUTF,
+    kNewGlobalRef, kDeleteGlobalRef, kNewWeakGlobalRef, kDeleteWeakGlobalRef,
+    kNewLocalRef, kDeleteLocalRef, kPushLocalFrame, kPopLocalFrame,
+    kExceptionCheck, kExceptionClear, kExceptionOccurred,
+    kGetDirectBufferAddress, kGetDirectBufferCapacity, kNewDirectByteBuffer,
+    kCall,                               // Call<Type>Method (also Nonvirtual)
+    kCallStatic  = kCall + kTypeCount,   // CallStatic<Type>Method
+    kGetField    = kCallStatic + kTypeCount,
+    kGetStatic   = kGetField + kTypeCount,
+    kSetField    = kGetStatic + kTypeCount,
+    kOpCount     = kSetField + kTypeCount
+};
+
+const char* OpName(int op);
+
+// One call.  a / b are handle ids or integer inputs, value the result (or the
+// stored value for setters); see jni_replay.cpp for each op's layout.
+struct Record {
+    int                op;
+    unsigned long long a;
+    unsigned long long b;
+    unsigned long long value;
+    std::string        blob;
+};
+
+// ── Recording ────────────────────────────────────────────────────────────────
+
+// Starts a recording at `path`; it stops by itself once maxBytes are written.
+// False if one is already running or the file cannot be created.
+bool StartRecording(const std::string& path, unsigned long maxBytes);
+void StopRecording();          // flushes and closes; safe to call when idle
+bool Recording();
+unsigned long RecordedCalls();
+
+// Swaps the env to the recording table while a recording runs; a no-op
+// otherwise, or when the env carries a table other than the one the recording
+// table was built from.  One recording thread at a time.
+class RecordScope {
+public:
+    explicit RecordScope(JNIEnv* env);
+    ~RecordScope();
+
+private:
+    RecordScope(const RecordScope&);
+    RecordScope& operator=(const RecordScope&);
+
+    JNIEnv*     _env;
+    const void* _savedTable;
+};
+
+// ── Replay ───────────────────────────────────────────────────────────────────
+
+// An input of a replayed call as the replay table passes it to Player::Next:
+// a handle, an integer, or not checked.
+struct Arg {
+    enum Kind { kHandle, kNumber, kAny };
+    Kind               kind;
+    const void*        p;
+    unsigned long long v;
+
+    static Arg Handle(const void* h)       { Arg r = { kHandle, h, 0 }; return r; }
+    static Arg Number(unsigned long long n) { Arg r = { kNumber, nullptr, n }; return r; }
+    static Arg Any()                       { Arg r = { kAny, nullptr, 0 }; return r; }
+};
+
+class Player;
+
+struct PlayerEnv : JNIEnv {
+    Player* player;
+};
+
+class Player {
+public:
+    Player();
+    ~Player();
+
+    bool Load(const std::string& path, std::string* error);
+
+    JNIEnv* Env();
+    void    Rewind();                 // back to the first record, divergence cleared
+
+    size_t        Size() const       { return _records.size(); }
+    size_t        Position() const   { return _pos; }
+    const Record& At(size_t i) const { return _records[i]; }
+    bool          Done() const       { return _pos >= _records.size(); }
+
+    bool               Diverged() const   { return !_divergence.empty(); }
+    const std::string& Divergence() const { return _divergence; }
+
+    // The handle the player hands out for a recorded id (null for 0).
+    static void* Handle(unsigned long long id);
+
+    // Used by the replay table: the next record if it is `op` with inputs a
+    // and b, else null (and the divergence is set).
+    const Record* Next(int op, const Arg& a, const Arg& b);
+    const char*   KeepString(const std::string& s);
+    void          DropString(const char* p);
+    void*         Buffer(unsigned long long id, unsigned long long capacity);
+    void          Diverge(const std::string& why);   // keeps the first one
+
+private:
+    Player(const Player&);
+    Player& operator=(const Player&);
+
+    bool Matches(const Arg& in, unsigned long long recorded);
+    void Reset();
+
+    std::vector<Record> _records;
+    size_t              _pos;
+    std::string         _divergence;
+    PlayerEnv           _env;
+    std::vector<std::pair<const void*, unsigned long long> >        _foreign;   // caller pointers → ids
+    std::vector<char*>                                              _strings;
+    std::vector<std::pair<unsigned long long, std::vector<char> > > _buffers;
+};
+
+} // namespace JniReplay
@@ -0,0 +1,204 @@
+// jni_core/mapping_cache.cpp
+#include "mapping_cache.h"
+#include <windows.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+namespace MappingCache {
+
+namespace {
+
+const char* const kHeader = "# LegoClicker mapping cache v1";
+
+std::map<std::string, std::string> s_entries;
+std::string s_path;
+std::string s_key;
+bool        s_dirty  = false;
+int         s_hits   = 0;
+int         s_misses = 0;
+
+void Fnv1a(unsigned long long& h, const std::string& s) {
+    for (size_t i = 0; i < s.size(); i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    h ^= 0xFF; // field separator
+    h *= 1099511628211ULL;
+}
+
+std::string GetSystemProperty(JNIEnv* env, const char* name) {
+    std::string out;
+    jclass sys = env->FindClass("java/lang/System");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); sys = nullptr; }
+    if (!sys) return out;
+    jmethodID get = env->GetStaticMethodID(sys, "getProperty", "(Ljava/lang/String;)Ljava/lang/String;");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); get = nullptr; }
+    if (get) {
+        jstring jname = env->NewStringUTF(name);
+        jstring jval = jname ? (jstring)env->CallStaticObjectMethod(sys, get, jname) : nullptr;
+        if (env->ExceptionCheck()) { env->ExceptionClear(); jval = nullptr; }
+        if (jval) {
+            const char* c = env->GetStringUTFChars(jval, nullptr);
+            if (c) { out = c; env->ReleaseStringUTFChars(jval, c); }
+            env->DeleteLocalRef(jval);
+        }
+        if (jname) env->DeleteLocalRef(jname);
+    }
+    env->DeleteLocalRef(sys);
+    return out;
+}
+
+int DeclaredCount(JNIEnv* env, jclass cls, const char* getter, const char* sig) {
+    if (!cls) return -1;
+    jclass cClass = env->FindClass("java/lang/Class");
+    if (env->ExceptionCheck()) { env->ExceptionClear(); cClass = nullptr; }
+    if (!cClass) return -1;
+    int n = -1;
+    jmethodID m = env->GetMethodID(cClass, getter, sig);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); m = nullptr; }
+    if (m) {
+        jobjectArray arr = (jobjectArray)env->CallObjectMethod(cls, m);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); arr = nullptr; }
+        if (arr) {
+            n = (int)env->GetArrayLength(arr);
+            env->DeleteLocalRef(arr);
+        }
+    }
+    env->DeleteLocalRef(cClass);
+    return n;
+}
+
+bool SplitMember(const std::string& v, std::string& name, std::string& sig) {
+    size_t sp = v.find(' ');
+    if (sp == std::string::npos || sp == 0 || sp + 1 >= v.size()) return false;
+    name = v.substr(0, sp);
+    sig = v.substr(sp + 1);
+    return true;
+}
+
+} // namespace
+
+std::string BuildKey(JNIEnv* env, const char* bridgeTag, jclass mcClass, const std::string& mcName) {
+    if (!env) return "";
+    unsigned long long h = 1469598103934665603ULL;
+    Fnv1a(h, bridgeTag ? bridgeTag : "");
+    Fnv1a(h, mcName);
+    Fnv1a(h, GetSystemProperty(env, "java.class.path"));
+    Fnv1a(h, GetSystemProperty(env, "sun.java.command"));
+    Fnv1a(h, std::to_string(DeclaredCount(env, mcClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;")));
+    Fnv1a(h, std::to_string(DeclaredCount(env, mcClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;")));
+
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", h);
+    return buf;
+}
+
+int Open(const std::string& path, const std::string& key) {
+    s_entries.clear();
+    s_path = path;
+    s_key = key;
+    s_dirty = false;
+    s_hits = 0;
+    s_misses = 0;
+    if (path.empty() || key.empty()) return 0;
+
+    std::ifstream in(path.c_str());
+    if (!in) return 0;
+
+    std::string line;
+    bool keyOk = false;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        std::string k = line.substr(0, eq);
+        std::string v = line.substr(eq + 1);
+        if (k == "key") {
+            keyOk = (v == key);
+            if (!keyOk) break;
+            continue;
+        }
+        if (keyOk) s_entries[k] = v;
+    }
+    if (!keyOk) {
+        s_entries.clear();
+        s_dirty = true; // rewrite under the new key
+    }
+    return (int)s_entries.size();
+}
+
+bool Get(const char* entry, std::string& value) {
+    std::map<std::string, std::string>::const_iterator it = s_entries.find(entry);
+    if (it == s_entries.end()) { s_misses++; return false; }
+    s_hits++;
+    value = it->second;
+    return true;
+}
+
+void Put(const char* entry, const std::string& value) {
+    if (!entry || value.empty()) return;
+    std::string& slot = s_entries[entry];
+    if (slot != value) { slot = value; s_dirty = true; }
+}
+
+jfieldID GetField(JNIEnv* env, jclass cls, const char* entry, bool isStatic) {
+    if (!env || !cls) return nullptr;
+    std::string v, name, sig;
+    if (!Get(entry, v)) return nullptr;
+    if (!SplitMember(v, name, sig)) { Invalidate(entry); return nullptr; }
+    jfieldID fid = isStatic ? env->GetStaticFieldID(cls, name.c_str(), sig.c_str())
+                            : env->GetFieldID(cls, name.c_str(), sig.c_str());
+    if (env->ExceptionCheck()) { env->ExceptionClear(); fid = nullptr; }
+    if (!fid) { s_hits--; s_misses++; Invalidate(entry); }
+    return fid;
+}
+
+jmethodID GetMethod(JNIEnv* env, jclass cls, const char* entry, bool isStatic) {
+    if (!env || !cls) return nullptr;
+    std::string v, name, sig;
+    if (!Get(entry, v)) return nullptr;
+    if (!SplitMember(v, name, sig)) { Invalidate(entry); return nullptr; }
+    jmethodID mid = isStatic ? env->GetStaticMethodID(cls, name.c_str(), sig.c_str())
+                             : env->GetMethodID(cls, name.c_str(), sig.c_str());
+    if (env->ExceptionCheck()) { env->ExceptionClear(); mid = nullptr; }
+    if (!mid) { s_hits--; s_misses++; Invalidate(entry); }
+    return mid;
+}
+
+void PutMember(const char* entry, const std::string& name, const std::string& sig) {
+    if (name.empty() || sig.empty()) return;
+    Put(entry, name + " " + sig);
+}
+
+void Invalidate(const char* entry) {
+    if (s_entries.erase(entry)) s_dirty = true;
+}
+
+bool Save() {
+    if (!s_dirty) return true;
+    if (s_path.empty() || s_key.empty()) return false;
+
+    std::string tmp = s_path + ".tmp";
+    {
+        std::ofstream out(tmp.c_str(), std::ios::out | std::ios::trunc);
+        if (!out) return false;
+        out << kHeader << "\n";
+        out << "key=" << s_key << "\n";
+        for (std::map<std::string, std::string>::const_iterator it = s_entries.begin(); it != s_entries.end(); ++it)
+            out << it->first << "=" << it->second << "\n";
+        if (!out) return false;
+    }
+    if (!MoveFileExA(tmp.c_str(), s_path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileA(tmp.c_str());
+        return false;
+    }
+    s_dirty = false;
+    return true;
+}
+
+int Hits()   { return s_hits; }
+int Misses() { return s_misses; }
+
+} // namespace MappingCache
@@ -0,0 +1,55 @@
+#pragma once
+// jni_core/mapping_cache.h
+// Persistent cache of names/signatures found by the reflection scans in discovery.
+//
+// The file lives next to the bridge debug log and is keyed by a fingerprint of the
+// running game build (bridge tag, Minecraft class name, JVM class path / command
+// line, and the Minecraft class's declared member counts).  A key mismatch
+// discards the whole file.  Every entry is re-validated with one GetFieldID /
+// GetMethodID before use, so a stale entry costs a single failed lookup and then
+// falls through to the normal scan.
+//
+// Usage (discovery):
+//   MappingCache::Open(dir + "\\bridge_mappings.cache",
+//                      MappingCache::BuildKey(env, "legacy", mcClass, mcName));
+//   jfieldID f = MappingCache::GetField(env, mcClass, "mc.player");
+//   if (!f) { f = <scan>; MappingCache::PutMember("mc.player", name, sig); }
+//   ...
+//   MappingCache::Save();              // only writes when something changed
+//
+// Thread safety: none.  Call from whichever thread runs discovery, one pass at a time.
+
+#include <jni.h>
+#include <string>
+
+namespace MappingCache {
+
+// Fingerprint of the running game build.  Cheap: a few property reads and two
+// reflection array lengths on mcClass.
+std::string BuildKey(JNIEnv* env, const char* bridgeTag, jclass mcClass, const std::string& mcName);
+
+// Load the cache file at `path`.  Entries are kept only if the stored key
+// matches `key`.  Returns the number of entries loaded.
+int Open(const std::string& path, const std::string& key);
+
+// Raw string entries (e.g. a class name).
+bool Get(const char* entry, std::string& value);
+void Put(const char* entry, const std::string& value);
+
+// Member entries are stored as "name sig".  GetField/GetMethod validate against
+// `cls` and drop the entry if it no longer resolves.
+jfieldID  GetField (JNIEnv* env, jclass cls, const char* entry, bool isStatic = false);
+jmethodID GetMethod(JNIEnv* env, jclass cls, const char* entry, bool isStatic = false);
+void      PutMember(const char* entry, const std::string& name, const std::string& sig);
+
+void Invalidate(const char* entry);
+
+// Write the file if any entry changed since Open().  Returns true on success
+// or when there was nothing to write.
+bool Save();
+
+// Lookup statistics since Open(), for the discovery report.
+int Hits();
+int Misses();
+
+} // namespace MappingCache
@@ -0,0 +1,259 @@
+// jni_core/member_index.cpp
+#include "member_index.h"
+#include <windows.h>
+#include <unordered_set>
+
+namespace MemberIndex {
+
+namespace {
+
+struct Entry {
+    jclass              cls;          // global ref
+    bool                haveMethods;
+    bool                haveFields;
+    std::vector<Method> methods;
+    std::vector<Field>  fields;
+};
+
+struct IndexLock {
+    CRITICAL_SECTION cs;
+    IndexLock()  { InitializeCriticalSection(&cs); }
+    ~IndexLock() { DeleteCriticalSection(&cs); }
+};
+
+IndexLock& Lock() {
+    static IndexLock s_lock;
+    return s_lock;
+}
+
+// Node-based: element addresses survive rehashing.
+std::unordered_set<std::string> s_strings;
+std::vector<Entry*>             s_entries;
+Stats                           s_stats = {};
+
+const std::vector<Method> kNoMethods;
+const std::vector<Field>  kNoFields;
+
+const std::string* Intern(const std::string& s) {
+    return &*s_strings.insert(s).first;
+}
+
+// Reflection IDs for one build; looked up per build since the index may
+// outlive a JVM's class unloads between discovery passes.
+struct Reflect {
+    jmethodID classGetName, getMethods, getFields;
+    jmethodID mName, mRet, mParams, mMods;
+    jmethodID fName, fType, fMods;
+
+    bool Load(JNIEnv* env) {
+        jclass cClass  = env->FindClass("java/lang/Class");
+        jclass cMethod = env->FindClass("java/lang/reflect/Method");
+        jclass cField  = env->FindClass("java/lang/reflect/Field");
+        bool ok = cClass && cMethod && cField && !env->ExceptionCheck();
+        if (ok) {
+            classGetName = env->GetMethodID(cClass, "getName", "()Ljava/lang/String;");
+            getMethods   = env->GetMethodID(cClass, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;");
+            getFields    = env->GetMethodID(cClass, "getDeclaredFields", "()[Ljava/lang/reflect/Field;");
+            mName   = env->GetMethodID(cMethod, "getName", "()Ljava/lang/String;");
+            mRet    = env->GetMethodID(cMethod, "getReturnType", "()Ljava/lang/Class;");
+            mParams = env->GetMethodID(cMethod, "getParameterTypes", "()[Ljava/lang/Class;");
+            mMods   = env->GetMethodID(cMethod, "getModifiers", "()I");
+            fName   = env->GetMethodID(cField, "getName", "()Ljava/lang/String;");
+            fType   = env->GetMethodID(cField, "getType", "()Ljava/lang/Class;");
+            fMods   = env->GetMethodID(cField, "getModifiers", "()I");
+            ok = !env->ExceptionCheck() && classGetName && getMethods && getFields &&
+                 mName && mRet && mParams && mMods && fName && fType && fMods;
+        }
+        if (env->ExceptionCheck()) env->ExceptionClear();
+        if (cClass) env->DeleteLocalRef(cClass);
+        if (cMethod) env->DeleteLocalRef(cMethod);
+        if (cField) env->DeleteLocalRef(cField);
+        return ok;
+    }
+};
+
+const std::string* StringOf(JNIEnv* env, jobject obj, jmethodID getter) {
+    s_stats.reflected++;
+    jstring js = (jstring)env->CallObjectMethod(obj, getter);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); js = nullptr; }
+    if (!js) return Intern(std::string());
+    const char* c = env->GetStringUTFChars(js, nullptr);
+    const std::string* out = Intern(c ? c : "");
+    if (c) env->ReleaseStringUTFChars(js, c);
+    env->DeleteLocalRef(js);
+    return out;
+}
+
+// Class.getName() of the class `owner.getter()` returns.
+const std::string* TypeOf(JNIEnv* env, const Reflect& r, jobject owner, jmethodID getter) {
+    s_stats.reflected++;
+    jobject t = env->CallObjectMethod(owner, getter);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); t = nullptr; }
+    if (!t) return Intern(std::string());
+    const std::string* out = StringOf(env, t, r.classGetName);
+    env->DeleteLocalRef(t);
+    return out;
+}
+
+jint ModifiersOf(JNIEnv* env, jobject member, jmethodID getter) {
+    s_stats.reflected++;
+    jint mod = env->CallIntMethod(member, getter);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); mod = 0; }
+    return mod;
+}
+
+jobjectArray Declared(JNIEnv* env, jclass cls, jmethodID getter) {
+    s_stats.reflected++;
+    jobjectArray arr = (jobjectArray)env->CallObjectMethod(cls, getter);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); arr = nullptr; }
+    return arr;
+}
+
+void BuildMethods(JNIEnv* env, Entry& e) {
+    e.haveMethods = true;
+    s_stats.builds++;
+    Reflect r;
+    if (!r.Load(env)) return;
+    jobjectArray arr = Declared(env, e.cls, r.getMethods);
+    if (!arr) return;
+    jsize n = env->GetArrayLength(arr);
+    e.methods.reserve((size_t)n);
+    for (jsize i = 0; i < n; i++) {
+        jobject m = env->GetObjectArrayElement(arr, i);
+        if (!m) continue;
+        Method out;
+        out.name = StringOf(env, m, r.mName);
+        out.ret = TypeOf(env, r, m, r.mRet);
+        out.modifiers = ModifiersOf(env, m, r.mMods);
+        s_stats.reflected++;
+        jobjectArray ps = (jobjectArray)env->CallObjectMethod(m, r.mParams);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); ps = nullptr; }
+        std::string sig = "(";
+        jsize pc = ps ? env->GetArrayLength(ps) : 0;
+        for (jsize p = 0; p < pc; p++) {
+            jobject pt = env->GetObjectArrayElement(ps, p);
+            const std::string* pn = pt ? StringOf(env, pt, r.classGetName) : Intern(std::string());
+            if (pt) env->DeleteLocalRef(pt);
+            out.params.push_back(pn);
+            sig += Descriptor(*pn);
+        }
+        if (ps) env->DeleteLocalRef(ps);
+        sig += ")" + Descriptor(*out.ret);
+        out.sig = Intern(sig);
+        out.id = env->FromReflectedMethod(m);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); out.id = nullptr; }
+        env->DeleteLocalRef(m);
+        e.methods.push_back(out);
+    }
+    env->DeleteLocalRef(arr);
+}
+
+void BuildFields(JNIEnv* env, Entry& e) {
+    e.haveFields = true;
+    s_stats.builds++;
+    Reflect r;
+    if (!r.Load(env)) return;
+    jobjectArray arr = Declared(env, e.cls, r.getFields);
+    if (!arr) return;
+    jsize n = env->GetArrayLength(arr);
+    e.fields.reserve((size_t)n);
+    for (jsize i = 0; i < n; i++) {
+        jobject f = env->GetObjectArrayElement(arr, i);
+        if (!f) continue;
+        Field out;
+        out.name = StringOf(env, f, r.fName);
+        out.type = TypeOf(env, r, f, r.fType);
+        out.modifiers = ModifiersOf(env, f, r.fMods);
+        out.sig = Intern(Descriptor(*out.type));
+        out.id = env->FromReflectedField(f);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); out.id = nullptr; }
+        env->DeleteLocalRef(f);
+        e.fields.push_back(out);
+    }
+    env->DeleteLocalRef(arr);
+}
+
+Entry* Find(JNIEnv* env, jclass cls) {
+    for (size_t i = 0; i < s_entries.size(); i++)
+        if (env->IsSameObject(s_entries[i]->cls, cls)) return s_entries[i];
+    jclass ref = (jclass)env->NewGlobalRef(cls);
+    if (!ref) return nullptr;
+    Entry* e = new Entry();
+    e->cls = ref;
+    e->haveMethods = false;
+    e->haveFields = false;
+    s_entries.push_back(e);
+    return e;
+}
+
+} // namespace
+
+Query::Query(JNIEnv* env) : m_env(env) {
+    EnterCriticalSection(&Lock().cs);
+}
+
+Query::~Query() {
+    LeaveCriticalSection(&Lock().cs);
+}
+
+const std::vector<Method>& Query::Methods(jclass cls) {
+    if (!m_env || !cls) return kNoMethods;
+    Entry* e = Find(m_env, cls);
+    if (!e) return kNoMethods;
+    if (e->haveMethods) s_stats.hits++;
+    else BuildMethods(m_env, *e);
+    return e->methods;
+}
+
+const std::vector<Field>& Query::Fields(jclass cls) {
+    if (!m_env || !cls) return kNoFields;
+    Entry* e = Find(m_env, cls);
+    if (!e) return kNoFields;
+    if (e->haveFields) s_stats.hits++;
+    else BuildFields(m_env, *e);
+    return e->fields;
+}
+
+Stats Counters() {
+    EnterCriticalSection(&Lock().cs);
+    Stats st = s_stats;
+    st.classes = (unsigned)s_entries.size();
+    LeaveCriticalSection(&Lock().cs);
+    return st;
+}
+
+Stats Clear(JNIEnv* env) {
+    EnterCriticalSection(&Lock().cs);
+    Stats st = s_stats;
+    st.classes = (unsigned)s_entries.size();
+    for (size_t i = 0; i < s_entries.size(); i++) {
+        if (env) env->DeleteGlobalRef(s_entries[i]->cls);
+        delete s_entries[i];
+    }
+    s_entries.clear();
+    std::vector<Entry*>().swap(s_entries);
+    std::unordered_set<std::string>().swap(s_strings);
+    s_stats = Stats();
+    LeaveCriticalSection(&Lock().cs);
+    return st;
+}
+
+std::string Descriptor(const std::string& typeName) {
+    if (typeName.empty()) return "V";
+    if (typeName[0] == '[') {
+        std::string d = typeName;
+        for (size_t i = 0; i < d.size(); i++) if (d[i] == '.') d[i] = '/';
+        return d;
+    }
+    static const struct { const char* name; const char* desc; } kPrimitives[] = {
+        { "void", "V" }, { "boolean", "Z" }, { "byte", "B" }, { "char", "C" }, { "short", "S" },
+        { "int", "I" }, { "long", "J" }, { "float", "F" }, { "double", "D" },
+    };
+    for (size_t i = 0; i < sizeof(kPrimitives) / sizeof(kPrimitives[0]); i++)
+        if (typeName == kPrimitives[i].name) return kPrimitives[i].desc;
+    std::string d = "L" + typeName + ";";
+    for (size_t i = 0; i < d.size(); i++) if (d[i] == '.') d[i] = '/';
+    return d;
+}
+
+} // namespace MemberIndex
@@ -0,0 +1,91 @@
+#pragma once
+// jni_core/member_index.h
+// Declared members of a class, reflected once and shared by every reflection
+// fallback in discovery.
+//
+// The first query for a class calls getDeclaredMethods (or getDeclaredFields)
+// and converts each member's name, types and modifiers to native strings.
+// Strings are interned, so the index holds one copy of "int" or
+// "net.minecraft.class_2818" no matter how many members use it.  Later
+// queries for the same class, from any resolver, cost no reflection.  Methods
+// and fields are built separately: a field-only resolver never pays for the
+// class's methods.
+//
+// Type names use the Class.getName() form ("int", "[I",
+// "net.minecraft.class_2818"); `sig` is the JVM descriptor, ready for
+// GetMethodID / GetFieldID.  `id` comes from FromReflectedMethod/Field.
+//
+// Usage (discovery / lazy resolvers):
+//   MemberIndex::Query q(env);
+//   for (const MemberIndex::Method& m : q.Methods(cls))
+//       if (m.params.empty() && *m.ret == "java.lang.String") ...
+//   ...
+//   MemberIndex::Clear(env);           // after discovery: frees everything
+//
+// Thread safety: a Query holds the index lock for its lifetime, and the
+// references it returns are valid only that long.  Clear() waits for open
+// queries.  Keep queries short; a nested Query on the same thread is fine
+// (the lock is re-entrant).
+
+#include <jni.h>
+#include <string>
+#include <vector>
+
+namespace MemberIndex {
+
+static const jint kAccStatic = 0x0008;
+static const jint kAccFinal  = 0x0010;
+
+struct Method {
+    const std::string*              name;
+    const std::string*              ret;
+    std::vector<const std::string*> params;
+    const std::string*              sig;
+    jint                            modifiers;
+    jmethodID                       id;
+    bool IsStatic() const { return (modifiers & kAccStatic) != 0; }
+};
+
+struct Field {
+    const std::string* name;
+    const std::string* type;
+    const std::string* sig;
+    jint               modifiers;
+    jfieldID           id;
+    bool IsStatic() const { return (modifiers & kAccStatic) != 0; }
+};
+
+class Query {
+public:
+    explicit Query(JNIEnv* env);
+    ~Query();
+
+    // Declared members of `cls`, built on first use.  Empty when `cls` is null
+    // or reflection failed (not retried until Clear()).
+    const std::vector<Method>& Methods(jclass cls);
+    const std::vector<Field>&  Fields(jclass cls);
+
+private:
+    Query(const Query&);
+    Query& operator=(const Query&);
+
+    JNIEnv* m_env;
+};
+
+struct Stats {
+    unsigned classes;        // currently indexed
+    unsigned builds;         // member lists reflected since the last Clear()
+    unsigned hits;           // member lists served from the index
+    unsigned long reflected; // reflection calls made building them
+};
+
+Stats Counters();
+
+// Frees every entry, its class refs and the string pool; returns the counters
+// as they were.
+Stats Clear(JNIEnv* env);
+
+// "int" -> "I", "net.minecraft.Foo" -> "Lnet/minecraft/Foo;", "[I" -> "[I".
+std::string Descriptor(const std::string& typeName);
+
+} // namespace MemberIndex
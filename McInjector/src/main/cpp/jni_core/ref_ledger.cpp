@@ -0,0 +1,280 @@
+// jni_core/ref_ledger.cpp
+#include "ref_ledger.h"
+#include "../async_log.h"
+
+#include <windows.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace RefLedger {
+
+namespace {
+
+struct Module {
+    const char*   name;
+    unsigned      cap;
+    unsigned long live;
+    unsigned long liveWeak;
+    unsigned long peak;
+    unsigned long created;
+    unsigned long deleted;
+    unsigned long rejected;
+    AsyncLog::RateGate capGate;
+};
+
+struct Entry {
+    int         module;
+    bool        weak;
+    const char* func;
+    int         line;
+};
+
+struct LedgerLock {
+    CRITICAL_SECTION cs;
+    LedgerLock()  { InitializeCriticalSection(&cs); }
+    ~LedgerLock() { DeleteCriticalSection(&cs); }
+};
+
+LedgerLock& Lock() {
+    static LedgerLock s_lock;
+    return s_lock;
+}
+
+struct Held {
+    Held()  { EnterCriticalSection(&Lock().cs); }
+    ~Held() { LeaveCriticalSection(&Lock().cs); }
+};
+
+Module        s_modules[kMaxModules];
+int           s_moduleCount = 0;
+unsigned long s_untracked = 0;
+std::unordered_map<jobject, Entry> s_refs;
+
+inline bool ValidModule(int module) { return module >= 0 && module < s_moduleCount; }
+
+void Untrack(const Entry& e) {
+    if (!ValidModule(e.module)) return;
+    Module& m = s_modules[e.module];
+    if (m.live) m.live--;
+    if (e.weak && m.liveWeak) m.liveWeak--;
+    m.deleted++;
+}
+
+// Caller holds the lock.  False when the module is at its cap.
+bool Admit(int module) {
+    if (!ValidModule(module)) return true;
+    Module& m = s_modules[module];
+    if (!m.cap || m.live < m.cap) return true;
+    m.rejected++;
+    long suppressed = 0;
+    if (AsyncLog::Allow(m.capGate, 10000, &suppressed)) {
+        char buf[176];
+        snprintf(buf, sizeof(buf), "WARNING: RefLedger: %s is at its cap of %u live refs; refusing new refs (%ld more since last warning)",
+                 m.name, m.cap, suppressed);
+        AsyncLog::Write(AsyncLog::LEVEL_WARN, buf);
+    }
+    return false;
+}
+
+void Record(jobject ref, int module, bool weak, const char* func, int line) {
+    Entry e = { ValidModule(module) ? module : -1, weak, func, line };
+    std::unordered_map<jobject, Entry>::iterator it = s_refs.find(ref);
+    if (it != s_refs.end()) {
+        Untrack(it->second);   // handle reused after a delete that bypassed the ledger
+        it->second = e;
+    } else {
+        s_refs.insert(std::make_pair(ref, e));
+    }
+    if (!ValidModule(module)) return;
+    Module& m = s_modules[module];
+    m.live++;
+    if (weak) m.liveWeak++;
+    m.created++;
+    if (m.live > m.peak) m.peak = m.live;
+}
+
+jobject Create(JNIEnv* env, jobject obj, int module, bool weak, const char* func, int line) {
+    if (!env || !obj) return nullptr;
+    {
+        Held held;
+        if (!Admit(module)) return nullptr;
+    }
+    jobject ref = weak ? env->NewWeakGlobalRef(obj) : env->NewGlobalRef(obj);
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        if (ref) weak ? env->DeleteWeakGlobalRef(ref) : env->DeleteGlobalRef(ref);
+        return nullptr;
+    }
+    if (!ref) return nullptr;
+    Held held;
+    Record(ref, module, weak, func, line);
+    return ref;
+}
+
+void Release(JNIEnv* env, jobject ref, bool weak) {
+    if (weak) env->DeleteWeakGlobalRef(ref);
+    else      env->DeleteGlobalRef(ref);
+}
+
+} // namespace
+
+int Register(const char* name, unsigned cap) {
+    if (!name) return -1;
+    Held held;
+    for (int i = 0; i < s_moduleCount; i++)
+        if (std::strcmp(s_modules[i].name, name) == 0) return i;
+    if (s_moduleCount >= kMaxModules) return -1;
+    Module& m = s_modules[s_moduleCount];
+    m.name = name;
+    m.cap = cap;
+    return s_moduleCount++;
+}
+
+void SetCap(int module, unsigned cap) {
+    Held held;
+    if (ValidModule(module)) s_modules[module].cap = cap;
+}
+
+jobject NewGlobal(JNIEnv* env, jobject obj, int module, const char* func, int line) {
+    return Create(env, obj, module, false, func, line);
+}
+
+jweak NewWeak(JNIEnv* env, jobject obj, int module, const char* func, int line) {
+    return (jweak)Create(env, obj, module, true, func, line);
+}
+
+void Delete(JNIEnv* env, jobject ref) {
+    if (!env || !ref) return;
+    bool weak = false;
+    {
+        Held held;
+        std::unordered_map<jobject, Entry>::iterator it = s_refs.find(ref);
+        if (it != s_refs.end()) {
+            weak = it->second.weak;
+            Untrack(it->second);
+            s_refs.erase(it);
+        } else {
+            s_untracked++;
+            weak = env->GetObjectRefType(ref) == JNIWeakGlobalRefType;
+        }
+    }
+    Release(env, ref, weak);
+}
+
+void Retag(jobject ref, int module) {
+    if (!ref) return;
+    Held held;
+    std::unordered_map<jobject, Entry>::iterator it = s_refs.find(ref);
+    if (it == s_refs.end() || it->second.module == module) return;
+    Entry& e = it->second;
+    if (ValidModule(e.module)) {
+        Module& from = s_modules[e.module];
+        if (from.live) from.live--;
+        if (e.weak && from.liveWeak) from.liveWeak--;
+    }
+    e.module = ValidModule(module) ? module : -1;
+    if (!ValidModule(module)) return;
+    Module& to = s_modules[module];
+    to.live++;
+    if (e.weak) to.liveWeak++;
+    if (to.live > to.peak) to.peak = to.live;
+}
+
+int ModuleCount() {
+    Held held;
+    return s_moduleCount;
+}
+
+bool Get(int module, ModuleStats& out) {
+    Held held;
+    if (!ValidModule(module)) return false;
+    const Module& m = s_modules[module];
+    out.name = m.name;
+    out.cap = m.cap;
+    out.live = m.live;
+    out.liveWeak = m.liveWeak;
+    out.peak = m.peak;
+    out.created = m.created;
+    out.deleted = m.deleted;
+    out.rejected = m.rejected;
+    return true;
+}
+
+unsigned long LiveTotal() {
+    Held held;
+    return (unsigned long)s_refs.size();
+}
+
+unsigned long UntrackedDeletes() {
+    Held held;
+    return s_untracked;
+}
+
+std::string FormatLive() {
+    std::string out;
+    char buf[160];
+    Held held;
+    for (int i = 0; i < s_moduleCount; i++) {
+        const Module& m = s_modules[i];
+        if (!m.created) continue;
+        snprintf(buf, sizeof(buf), "%s%s live=%lu weak=%lu peak=%lu rejected=%lu",
+                 out.empty() ? "" : "; ", m.name, m.live, m.liveWeak, m.peak, m.rejected);
+        out += buf;
+    }
+    return out;
+}
+
+unsigned long ReportLeaks(JNIEnv* env, const char* when, bool release, int exceptModule) {
+    struct Site {
+        int           module;
+        const char*   func;
+        int           line;
+        unsigned long strong, weak;
+    };
+    std::vector<Site> sites;
+    std::vector<std::pair<jobject, bool> > leaked;
+    {
+        Held held;
+        for (std::unordered_map<jobject, Entry>::iterator it = s_refs.begin(); it != s_refs.end(); ) {
+            const Entry& e = it->second;
+            if (exceptModule >= 0 && e.module == exceptModule) { ++it; continue; }
+            size_t i = 0;
+            while (i < sites.size() && !(sites[i].module == e.module && sites[i].line == e.line
+                                         && std::strcmp(sites[i].func, e.func) == 0)) i++;
+            if (i == sites.size()) { Site s = { e.module, e.func, e.line, 0, 0 }; sites.push_back(s); }
+            (e.weak ? sites[i].weak : sites[i].strong)++;
+            if (release && env) {
+                leaked.push_back(std::make_pair(it->first, e.weak));
+                Untrack(e);
+                it = s_refs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    unsigned long total = 0;
+    std::sort(sites.begin(), sites.end(), [](const Site& a, const Site& b) {
+        return a.strong + a.weak > b.strong + b.weak;
+    });
+    char buf[224];
+    for (size_t i = 0; i < sites.size(); i++) {
+        const Site& s = sites[i];
+        const char* module = s.module >= 0 ? s_modules[s.module].name : "untagged";
+        snprintf(buf, sizeof(buf), "WARNING: RefLedger (%s): %lu leaked strong + %lu weak ref(s) from %s, created in %s:%d",
+                 when ? when : "?", s.strong, s.weak, module, s.func, s.line);
+        AsyncLog::Write(AsyncLog::LEVEL_WARN, buf);
+        total += s.strong + s.weak;
+    }
+    for (size_t i = 0; i < leaked.size(); i++) Release(env, leaked[i].first, leaked[i].second);
+    if (total) {
+        snprintf(buf, sizeof(buf), "WARNING: RefLedger (%s): %lu leaked ref(s) in total%s", when ? when : "?", total,
+                 release && env ? ", released" : "");
+        AsyncLog::Write(AsyncLog::LEVEL_WARN, buf);
+    }
+    return total;
+}
+
+} // namespace RefLedger
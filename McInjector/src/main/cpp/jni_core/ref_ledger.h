@@ -0,0 +1,79 @@
+#pragma once
+// jni_core/ref_ledger.h
+// Ledger of the bridge's long-lived JNI global and weak global refs.
+//
+// Every ref created through NewGlobal/NewWeak is tagged with its owning
+// module and creation site (function + line) and counted per module, so live
+// counts can be shown in the debug panel and whatever is still alive once a
+// bridge has dropped everything it knows about can be reported as a leak.
+// A leaked strong ref pins its object (often a whole ClientWorld) in the
+// game's heap, which is why each module also has a cap: past it, NewGlobal
+// and NewWeak return nullptr and log a rate-limited warning, and the caller
+// takes the same path it takes when the JVM refuses a ref.
+//
+// Usage:
+//   static const int s_refs = RefLedger::Register("nametagHide", 256);
+//   g_world = LC_NEW_GLOBAL_REF(env, worldObj, s_refs);
+//   ...
+//   RefLedger::Delete(env, g_world); g_world = nullptr;
+//   RefLedger::ReportLeaks(env, "cleanup", true);
+//
+// Refs are keyed by handle value; Delete on a handle the ledger did not hand
+// out still releases it (global or weak, by GetObjectRefType) and is counted
+// as untracked.
+
+#include <jni.h>
+#include <string>
+
+namespace RefLedger {
+
+static const int kMaxModules = 32;
+
+struct ModuleStats {
+    const char*   name;
+    unsigned      cap;        // live refs allowed, 0 = none
+    unsigned long live;       // strong + weak
+    unsigned long liveWeak;
+    unsigned long peak;
+    unsigned long created;
+    unsigned long deleted;
+    unsigned long rejected;   // refused by the cap
+};
+
+// Returns the id for `name` (string literal), registering it on first use.
+// Returns -1 once kMaxModules are taken; refs for -1 are created untagged.
+int Register(const char* name, unsigned cap);
+
+// Changes a module's cap.
+void SetCap(int module, unsigned cap);
+
+// NewGlobalRef / NewWeakGlobalRef recorded against `module`.  `func` must
+// outlive the ledger (use the macros below).  Return nullptr for a null
+// object, a pending exception, or a module at its cap.
+jobject NewGlobal(JNIEnv* env, jobject obj, int module, const char* func, int line);
+jweak   NewWeak(JNIEnv* env, jobject obj, int module, const char* func, int line);
+
+// Deletes a ref of either kind and drops it from the ledger.  Null is a no-op.
+void Delete(JNIEnv* env, jobject ref);
+
+// Moves a live ref to another module (a staged remap handle being adopted).
+void Retag(jobject ref, int module);
+
+int  ModuleCount();
+bool Get(int module, ModuleStats& out);
+unsigned long LiveTotal();
+unsigned long UntrackedDeletes();
+
+// "name live=N weak=W peak=P rejected=R" for each module with a ref,
+// "; "-separated.
+std::string FormatLive();
+
+// Logs every live ref except those of `exceptModule` (-1 for none), grouped
+// by module and creation site, and deletes them when `release` is set.
+// Returns the number of refs reported.
+unsigned long ReportLeaks(JNIEnv* env, const char* when, bool release, int exceptModule = -1);
+
+} // namespace RefLedger
+
+#define LC_NEW_GLOBAL_REF(env, obj, module) RefLedger::NewGlobal((env), (obj), (module), __FUNCTION__, __LINE__)
+#define LC_NEW_WEAK_REF(env, obj, module)   RefLedger::NewWeak((env), (obj), (module), __FUNCTION__, __LINE__)
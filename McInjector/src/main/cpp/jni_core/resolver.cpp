@@ -42,61 +42,80 @@ static jclass LoadClass(JNIEnv* env, const char* dotName, jobject classLoader) {
 
 // ── ClassDesc ────────────────────────────────────────────────────────────────
 
-jclass Resolve(JNIEnv* env, ClassDesc& desc, jobject classLoader) {
-    if (desc.cached) return desc.cached;
+jclass LoadDescClass(JNIEnv* env, const ClassDesc& desc, jobject classLoader) {
     if (!env || !desc.classNames) return nullptr;
 
     for (int i = 0; desc.classNames[i]; i++) {
         jclass local = LoadClass(env, desc.classNames[i], classLoader);
-        if (local) {
-            desc.cached = (jclass)env->NewGlobalRef(local);
-            env->DeleteLocalRef(local);
-            return desc.cached;
-        }
+        if (local) return local;
     }
     return nullptr;
 }
 
-// ── FieldDesc ────────────────────────────────────────────────────────────────
-
-jfieldID Resolve(JNIEnv* env, FieldDesc& desc, jobject classLoader) {
+jclass Resolve(JNIEnv* env, ClassDesc& desc, jobject classLoader) {
     if (desc.cached) return desc.cached;
 
-    jclass cls = Resolve(env, desc.owner, classLoader);
-    if (!cls) return nullptr;
+    jclass local = LoadDescClass(env, desc, classLoader);
+    if (!local) return nullptr;
+    desc.cached = (jclass)env->NewGlobalRef(local);
+    env->DeleteLocalRef(local);
+    return desc.cached;
+}
+
+// ── FieldDesc ────────────────────────────────────────────────────────────────
+
+jfieldID LookupField(JNIEnv* env, jclass owner, const FieldDesc& desc) {
+    if (!env || !owner) return nullptr;
 
     for (int ni = 0; desc.fieldNames[ni]; ni++) {
         for (int si = 0; desc.fieldSigs[si]; si++) {
             jfieldID fid = desc.isStatic
-                ? env->GetStaticFieldID(cls, desc.fieldNames[ni], desc.fieldSigs[si])
-                : env->GetFieldID(cls, desc.fieldNames[ni], desc.fieldSigs[si]);
+                ? env->GetStaticFieldID(owner, desc.fieldNames[ni], desc.fieldSigs[si])
+                : env->GetFieldID(owner, desc.fieldNames[ni], desc.fieldSigs[si]);
             if (env->ExceptionCheck()) { env->ExceptionClear(); fid = nullptr; }
-            if (fid) { desc.cached = fid; return fid; }
+            if (fid) return fid;
         }
     }
     return nullptr;
 }
 
-// ── MethodDesc ───────────────────────────────────────────────────────────────
-
-jmethodID Resolve(JNIEnv* env, MethodDesc& desc, jobject classLoader) {
+jfieldID Resolve(JNIEnv* env, FieldDesc& desc, jobject classLoader) {
     if (desc.cached) return desc.cached;
 
     jclass cls = Resolve(env, desc.owner, classLoader);
     if (!cls) return nullptr;
 
+    desc.cached = LookupField(env, cls, desc);
+    return desc.cached;
+}
+
+// ── MethodDesc ───────────────────────────────────────────────────────────────
+
+jmethodID LookupMethod(JNIEnv* env, jclass owner, const MethodDesc& desc) {
+    if (!env || !owner) return nullptr;
+
     for (int ni = 0; desc.methodNames[ni]; ni++) {
         for (int si = 0; desc.methodSigs[si]; si++) {
             jmethodID mid = desc.isStatic
-                ? env->GetStaticMethodID(cls, desc.methodNames[ni], desc.methodSigs[si])
-                : env->GetMethodID(cls, desc.methodNames[ni], desc.methodSigs[si]);
+                ? env->GetStaticMethodID(owner, desc.methodNames[ni], desc.methodSigs[si])
+                : env->GetMethodID(owner, desc.methodNames[ni], desc.methodSigs[si]);
             if (env->ExceptionCheck()) { env->ExceptionClear(); mid = nullptr; }
-            if (mid) { desc.cached = mid; return mid; }
+            if (mid) return mid;
         }
     }
     return nullptr;
 }
 
+jmethodID Resolve(JNIEnv* env, MethodDesc& desc, jobject classLoader) {
+    if (desc.cached) return desc.cached;
+
+    jclass cls = Resolve(env, desc.owner, classLoader);
+    if (!cls) return nullptr;
+
+    desc.cached = LookupMethod(env, cls, desc);
+    return desc.cached;
+}
+
 // ── Reset ────────────────────────────────────────────────────────────────────
 
 void ResetDesc(ClassDesc& desc, JNIEnv* env) {
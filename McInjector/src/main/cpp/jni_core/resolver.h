@@ -68,6 +68,13 @@ jclass    Resolve(JNIEnv* env, ClassDesc&  desc, jobject classLoader = nullptr);
 jfieldID  Resolve(JNIEnv* env, FieldDesc&  desc, jobject classLoader = nullptr);
 jmethodID Resolve(JNIEnv* env, MethodDesc& desc, jobject classLoader = nullptr);
 
+// Uncached lookups: same candidate walk as Resolve(), but desc.cached is never
+// read or written.  Used by builders that own their results (jni_registry.h).
+// LoadDescClass returns a local ref; LookupField/LookupMethod search `owner`.
+jclass    LoadDescClass(JNIEnv* env, const ClassDesc& desc, jobject classLoader = nullptr);
+jfieldID  LookupField(JNIEnv* env, jclass owner, const FieldDesc& desc);
+jmethodID LookupMethod(JNIEnv* env, jclass owner, const MethodDesc& desc);
+
 // Invalidate all cached values (call during remap / world reload).
 void ResetDesc(ClassDesc&  desc, JNIEnv* env);
 void ResetDesc(FieldDesc&  desc);
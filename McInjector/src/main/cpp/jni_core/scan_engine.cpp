@@ -0,0 +1,128 @@
+// jni_core/scan_engine.cpp
+#include "scan_engine.h"
+#include "../text_utils.h"
+
+#include <windows.h>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+namespace ScanEngine {
+
+namespace {
+
+volatile LONG s_walks = 0;
+volatile LONG s_batched = 0;
+volatile LONG s_entities = 0;
+volatile LONG s_dropped = 0;
+
+double DistanceFrom(const WalkOptions& opts, const PlayerSample& s) {
+    double dx = s.x - opts.originX;
+    double dy = s.y - opts.originY;
+    double dz = s.z - opts.originZ;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Shared acceptance for both paths: named, not a fake line, in range.
+bool Accept(VersionAdapter& adapter, const WalkOptions& opts, PlayerSample& s) {
+    if (s.name.empty() || adapter.IsFakeName(s.name)) return false;
+    s.dist = DistanceFrom(opts, s);
+    return opts.maxDist <= 0.0 || s.dist <= opts.maxDist;
+}
+
+} // namespace
+
+bool VersionAdapter::CollectBatch(JNIEnv*, jobject, jobject, std::vector<PlayerSample>&) {
+    return false;
+}
+
+bool VersionAdapter::IsFakeName(const std::string& name) {
+    return lc::LooksLikeFakePlayerName(lc::NormalizeNameSpaces(lc::StripMinecraftFormattingCodes(name)));
+}
+
+int WalkPlayers(JNIEnv* env, VersionAdapter& adapter, jobject list, const ListAccess& access,
+                jobject self, const WalkOptions& opts, std::vector<PlayerSample>& out) {
+    out.clear();
+    if (!env || !list) return -1;
+    InterlockedIncrement(&s_walks);
+
+    if (adapter.CollectBatch(env, list, self, out)) {
+        InterlockedIncrement(&s_batched);
+        size_t kept = 0;
+        for (size_t i = 0; i < out.size(); i++) {
+            if (!Accept(adapter, opts, out[i])) { InterlockedIncrement(&s_dropped); continue; }
+            if (kept != i) std::swap(out[kept], out[i]);
+            kept++;
+        }
+        out.resize(kept);
+        return (int)kept;
+    }
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!access.size || !access.get) return -1;
+
+    jint size = env->CallIntMethod(list, access.size);
+    if (env->ExceptionCheck()) { env->ExceptionClear(); return -1; }
+
+    PlayerSample s;
+    for (jint i = 0; i < size; i++) {
+        jobject entity = env->CallObjectMethod(list, access.get, i);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); break; }
+        if (!entity) continue;
+        InterlockedIncrement(&s_entities);
+        if (self && env->IsSameObject(entity, self)) {
+            env->DeleteLocalRef(entity);
+            InterlockedIncrement(&s_dropped);
+            continue;
+        }
+
+        s.index = (int)i;
+        s.key = 0;
+        s.x = s.y = s.z = 0.0;
+        s.lastX = s.lastY = s.lastZ = 0.0;
+        s.health = 20.0f;
+        s.armor = -1;
+        s.dist = 0.0;
+        s.name.clear();
+        bool ok = adapter.ReadPlayer(env, entity, s);
+        if (env->ExceptionCheck()) { env->ExceptionClear(); ok = false; }
+        env->DeleteLocalRef(entity);
+        if (!ok || !Accept(adapter, opts, s)) { InterlockedIncrement(&s_dropped); continue; }
+        out.push_back(s);
+    }
+    return (int)out.size();
+}
+
+int Nearest(const std::vector<PlayerSample>& players, double maxDist) {
+    int best = -1;
+    for (size_t i = 0; i < players.size(); i++) {
+        if (maxDist > 0.0 && players[i].dist > maxDist) continue;
+        if (best < 0 || players[i].dist < players[best].dist) best = (int)i;
+    }
+    return best;
+}
+
+WalkStats Stats() {
+    WalkStats s;
+    s.walks = (unsigned long)InterlockedCompareExchange(&s_walks, 0, 0);
+    s.batched = (unsigned long)InterlockedCompareExchange(&s_batched, 0, 0);
+    s.entities = (unsigned long)InterlockedCompareExchange(&s_entities, 0, 0);
+    s.dropped = (unsigned long)InterlockedCompareExchange(&s_dropped, 0, 0);
+    return s;
+}
+
+void ResetStats() {
+    InterlockedExchange(&s_walks, 0);
+    InterlockedExchange(&s_batched, 0);
+    InterlockedExchange(&s_entities, 0);
+    InterlockedExchange(&s_dropped, 0);
+}
+
+std::string FormatStats() {
+    WalkStats s = Stats();
+    char buf[128];
+    snprintf(buf, sizeof(buf), "walks=%lu batched=%lu entities=%lu dropped=%lu",
+             s.walks, s.batched, s.entities, s.dropped);
+    return buf;
+}
+
+} // namespace ScanEngine
@@ -0,0 +1,98 @@
+#pragma once
+// jni_core/scan_engine.h
+// Version-neutral player-list walk shared by both bridges.
+//
+// Both bridges walk the world's player list the same way: one batched
+// AokoHelper call when the helper is loaded, else List.get + per-entity reads,
+// dropping the local player, nameless entities and scoreboard/bot lines, and
+// measuring each player from the local one.  What differs between 1.8.9 and
+// 26.1 is only how a single entity is read (fields vs getters, which helper
+// collector) and how names are cleaned, so that is all a VersionAdapter
+// supplies; the loop, filtering, local-ref hygiene and exception handling
+// live here once.
+//
+// Usage (per scan pass):
+//   struct Adapter121 : ScanEngine::VersionAdapter {
+//       bool ReadPlayer(JNIEnv* env, jobject e, ScanEngine::PlayerSample& s) { ... }
+//   } adapter;
+//   ScanEngine::ListAccess access = { sizeMethod, getMethod };
+//   ScanEngine::WalkOptions opts = { selfX, selfY, selfZ, 96.0 };
+//   std::vector<ScanEngine::PlayerSample> players;
+//   if (ScanEngine::WalkPlayers(env, adapter, list, access, self, opts, players) >= 0) {
+//       int nearest = ScanEngine::Nearest(players, 96.0);
+//       ...
+//   }
+//
+// Not thread-safe: each scan thread owns its adapter and output vector.
+
+#include <jni.h>
+#include <string>
+#include <vector>
+
+namespace ScanEngine {
+
+struct PlayerSample {
+    int    index;            // position in the player list (List.get index)
+    int    key;              // hash code or entity id; 0 when the adapter has none
+    double x, y, z;
+    double lastX, lastY, lastZ;   // previous tick; equal to x/y/z when unknown
+    float  health;           // 20 when unknown
+    int    armor;            // -1 when unknown
+    double dist;             // from the walk origin, tick positions
+    std::string name;        // display name, never empty or a fake line
+};
+
+// java.util.List accessors for the player list.
+struct ListAccess {
+    jmethodID size;
+    jmethodID get;
+};
+
+struct WalkOptions {
+    double originX, originY, originZ;
+    double maxDist;          // 0 = no limit
+};
+
+// Per-version reads.  Adapters live on the scan thread that walks with them.
+class VersionAdapter {
+public:
+    virtual ~VersionAdapter() {}
+
+    // Reads the whole list in one crossing, appending every player except
+    // `self` with index, key, positions, health, armor and name filled.
+    // Returns false to fall back to the per-entity walk.
+    virtual bool CollectBatch(JNIEnv* env, jobject list, jobject self, std::vector<PlayerSample>& out);
+
+    // Per-entity read: everything but index and dist.  Returns false to
+    // drop the entity.
+    virtual bool ReadPlayer(JNIEnv* env, jobject entity, PlayerSample& out) = 0;
+
+    // True when `name` is a scoreboard line, separator or bot filler rather
+    // than a player.  The default strips formatting codes (UTF-8 kept).
+    virtual bool IsFakeName(const std::string& name);
+};
+
+// Counters since the last ResetStats(), for the bridges' periodic stats line.
+struct WalkStats {
+    unsigned long walks;
+    unsigned long batched;       // walks served by CollectBatch
+    unsigned long entities;      // entities read on the per-entity path
+    unsigned long dropped;       // self, unreadable, nameless, fake or out of range
+};
+
+// Walks `list` once and appends the accepted players to `out` (cleared
+// first) in list order.  Returns the number appended, or -1 when the list
+// could not be read at all.
+int WalkPlayers(JNIEnv* env, VersionAdapter& adapter, jobject list, const ListAccess& access,
+                jobject self, const WalkOptions& opts, std::vector<PlayerSample>& out);
+
+// Index into `players` of the nearest one within maxDist (0 = no limit), or -1.
+int Nearest(const std::vector<PlayerSample>& players, double maxDist);
+
+WalkStats Stats();
+void ResetStats();
+
+// "walks=W batched=B entities=E dropped=D".
+std::string FormatStats();
+
+} // namespace ScanEngine
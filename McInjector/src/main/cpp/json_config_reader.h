@@ -1,59 +1,293 @@
 #pragma once
 
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <vector>
 
 namespace lc {
 
+// Reader for the loader's flat JSON packets.  The constructor tokenizes the
+// line once into a key -> value-span index (sorted, first occurrence wins), so
+// each Get* is a binary search plus a parse of the value bytes; only
+// GetString() allocates.  Nested objects/arrays are kept as raw spans and
+// their keys are not indexed.  Malformed input ends the scan; keys read
+// before that point stay available.
 class SimpleJsonConfigReader {
 public:
-    explicit SimpleJsonConfigReader(std::string line) : _line(std::move(line)) {}
+    explicit SimpleJsonConfigReader(std::string line) : _line(std::move(line)) { Index(); }
+
+    bool Has(const char* key) const { return Find(key) != nullptr; }
 
     std::string GetString(const char* key) const
     {
-        std::string marker = std::string("\"") + key + "\":";
-        size_t pos = _line.find(marker);
-        if (pos == std::string::npos) return "";
-
-        pos += marker.length();
-        if (pos >= _line.size()) return "";
-
-        if (_line[pos] == '"') {
-            size_t end = _line.find('"', pos + 1);
-            return (end == std::string::npos) ? "" : _line.substr(pos + 1, end - pos - 1);
-        }
-
-        size_t end = _line.find_first_of(",}", pos);
-        std::string value = (end == std::string::npos) ? _line.substr(pos) : _line.substr(pos, end - pos);
-        while (!value.empty() && value[0] == ' ') value.erase(0, 1);
-        return value;
+        const Field* f = Find(key);
+        if (!f) return "";
+        if (!f->escaped) return _line.substr(f->valPos, f->valLen);
+        return Unescape(_line.data() + f->valPos, f->valLen);
     }
 
     bool GetBool(const char* key, bool defaultValue = false) const
     {
-        std::string value = GetString(key);
-        if (value.empty()) return defaultValue;
-        return value == "true";
+        const Field* f = Find(key);
+        if (!f || f->valLen == 0) return defaultValue;
+        return f->valLen == 4 && std::memcmp(_line.data() + f->valPos, "true", 4) == 0;
     }
 
     float GetFloat(const char* key, float defaultValue = 0.0f) const
     {
-        std::string value = GetString(key);
-        if (value.empty()) return defaultValue;
-        try { return std::stof(value); } catch (...) { return defaultValue; }
+        char buf[64];
+        if (!CopyNumber(key, buf, sizeof(buf))) return defaultValue;
+        char* end = nullptr;
+        errno = 0;
+        float v = std::strtof(buf, &end);
+        if (end == buf || errno == ERANGE) return defaultValue;
+        return v;
     }
 
     int GetInt(const char* key, int defaultValue = 0) const
     {
-        std::string value = GetString(key);
-        if (value.empty()) return defaultValue;
-        try { return std::stoi(value); } catch (...) { return defaultValue; }
+        char buf[64];
+        if (!CopyNumber(key, buf, sizeof(buf))) return defaultValue;
+        char* end = nullptr;
+        errno = 0;
+        long v = std::strtol(buf, &end, 10);
+        if (end == buf || errno == ERANGE || v < INT_MIN || v > INT_MAX) return defaultValue;
+        return (int)v;
     }
 
 private:
+    struct Field {
+        unsigned keyPos, keyLen;
+        unsigned valPos, valLen;   // string values: the bytes between the quotes
+        bool     escaped;          // string value contains a backslash escape
+    };
+
+    static bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    void SkipSpace(size_t& i) const
+    {
+        while (i < _line.size() && IsSpace(_line[i])) i++;
+    }
+
+    // `i` is just past an opening quote; returns the index of the closing one
+    // (npos if unterminated) and whether a backslash was seen.
+    size_t ScanString(size_t i, bool& escaped) const
+    {
+        escaped = false;
+        for (; i < _line.size(); i++) {
+            if (_line[i] == '\\') { escaped = true; i++; continue; }
+            if (_line[i] == '"') return i;
+        }
+        return std::string::npos;
+    }
+
+    // `i` is on '{' or '['; returns the index past its matching close.
+    size_t SkipNested(size_t i) const
+    {
+        int depth = 0;
+        bool esc;
+        for (; i < _line.size(); i++) {
+            char c = _line[i];
+            if (c == '"') {
+                i = ScanString(i + 1, esc);
+                if (i == std::string::npos) return _line.size();
+            } else if (c == '{' || c == '[') {
+                depth++;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return i + 1;
+            }
+        }
+        return _line.size();
+    }
+
+    void Index()
+    {
+        size_t i = 0;
+        SkipSpace(i);
+        if (i < _line.size() && _line[i] == '{') i++;
+
+        while (true) {
+            SkipSpace(i);
+            if (i >= _line.size() || _line[i] != '"') break;
+            bool esc;
+            size_t keyEnd = ScanString(i + 1, esc);
+            if (keyEnd == std::string::npos) break;
+            Field f;
+            f.keyPos = (unsigned)(i + 1);
+            f.keyLen = (unsigned)(keyEnd - i - 1);
+            f.escaped = false;
+            i = keyEnd + 1;
+            SkipSpace(i);
+            if (i >= _line.size() || _line[i] != ':') break;
+            i++;
+            SkipSpace(i);
+            if (i >= _line.size()) break;
+
+            if (_line[i] == '"') {
+                size_t valEnd = ScanString(i + 1, f.escaped);
+                if (valEnd == std::string::npos) break;
+                f.valPos = (unsigned)(i + 1);
+                f.valLen = (unsigned)(valEnd - i - 1);
+                i = valEnd + 1;
+            } else if (_line[i] == '{' || _line[i] == '[') {
+                size_t end = SkipNested(i);
+                f.valPos = (unsigned)i;
+                f.valLen = (unsigned)(end - i);
+                i = end;
+            } else {
+                size_t end = i;
+                while (end < _line.size() && _line[end] != ',' && _line[end] != '}') end++;
+                size_t last = end;
+                while (last > i && IsSpace(_line[last - 1])) last--;
+                f.valPos = (unsigned)i;
+                f.valLen = (unsigned)(last - i);
+                i = end;
+            }
+            _fields.push_back(f);
+
+            SkipSpace(i);
+            if (i >= _line.size() || _line[i] != ',') break;
+            i++;
+        }
+
+        std::stable_sort(_fields.begin(), _fields.end(), KeyLess(_line.data()));
+    }
+
+    struct KeyLess {
+        const char* base;
+        explicit KeyLess(const char* b) : base(b) {}
+
+        static int Compare(const char* a, size_t an, const char* b, size_t bn)
+        {
+            int c = std::memcmp(a, b, (std::min)(an, bn));
+            if (c != 0) return c;
+            return an < bn ? -1 : (an > bn ? 1 : 0);
+        }
+        bool operator()(const Field& a, const Field& b) const
+        {
+            return Compare(base + a.keyPos, a.keyLen, base + b.keyPos, b.keyLen) < 0;
+        }
+    };
+
+    const Field* Find(const char* key) const
+    {
+        size_t n = std::strlen(key);
+        const char* base = _line.data();
+        size_t lo = 0, hi = _fields.size();
+        while (lo < hi) {   // lower bound, so duplicates resolve to the first
+            size_t mid = (lo + hi) / 2;
+            const Field& f = _fields[mid];
+            if (KeyLess::Compare(base + f.keyPos, f.keyLen, key, n) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo == _fields.size()) return nullptr;
+        const Field& f = _fields[lo];
+        return KeyLess::Compare(base + f.keyPos, f.keyLen, key, n) == 0 ? &f : nullptr;
+    }
+
+    // Null-terminated copy of a short scalar for strtol/strtof.
+    bool CopyNumber(const char* key, char* buf, size_t cap) const
+    {
+        const Field* f = Find(key);
+        if (!f || f->valLen == 0 || f->valLen >= cap) return false;
+        std::memcpy(buf, _line.data() + f->valPos, f->valLen);
+        buf[f->valLen] = 0;
+        return true;
+    }
+
+    static unsigned HexDigit(char c)
+    {
+        if (c >= '0' && c <= '9') return (unsigned)(c - '0');
+        if (c >= 'a' && c <= 'f') return (unsigned)(c - 'a' + 10);
+        if (c >= 'A' && c <= 'F') return (unsigned)(c - 'A' + 10);
+        return 16;
+    }
+
+    static bool ReadHex4(const char* p, const char* end, unsigned& out)
+    {
+        if (end - p < 4) return false;
+        out = 0;
+        for (int k = 0; k < 4; k++) {
+            unsigned d = HexDigit(p[k]);
+            if (d > 15) return false;
+            out = (out << 4) | d;
+        }
+        return true;
+    }
+
+    static void AppendUtf8(std::string& out, unsigned cp)
+    {
+        if (cp < 0x80) {
+            out.push_back((char)cp);
+        } else if (cp < 0x800) {
+            out.push_back((char)(0xC0 | (cp >> 6)));
+            out.push_back((char)(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back((char)(0xE0 | (cp >> 12)));
+            out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back((char)(0xF0 | (cp >> 18)));
+            out.push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    // System.Text.Json escapes quotes, '<', '>', '&', '\'' and non-ASCII as
+    // \uXXXX; decode those (and the short forms) back to UTF-8.
+    static std::string Unescape(const char* p, size_t n)
+    {
+        std::string out;
+        out.reserve(n);
+        const char* end = p + n;
+        while (p < end) {
+            if (*p != '\\' || p + 1 >= end) { out.push_back(*p++); continue; }
+            char c = p[1];
+            p += 2;
+            switch (c) {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case 'r': out.push_back('\r'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u': {
+                    unsigned cp;
+                    if (!ReadHex4(p, end, cp)) { out += "\\u"; break; }
+                    p += 4;
+                    unsigned lo;
+                    if (cp >= 0xD800 && cp <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u'
+                        && ReadHex4(p + 2, end, lo) && lo >= 0xDC00 && lo <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                        p += 6;
+                    }
+                    AppendUtf8(out, cp);
+                    break;
+                }
+                default: out.push_back(c); break;   // \" \\ \/
+            }
+        }
+        return out;
+    }
+
     std::string _line;
+    std::vector<Field> _fields;
 };
 
+// Assigns `value` to `field` only when it differs and records `module` in
+// `changed`, so a caller can tell which modules a config packet touched.
+template <typename T>
+inline void ApplyIfChanged(T& field, const T& value, unsigned module, unsigned& changed)
+{
+    if (field == value) return;
+    field = value;
+    changed |= module;
+}
+
 inline int ClampInt(int value, int minValue, int maxValue)
 {
     return (std::max)(minValue, (std::min)(maxValue, value));
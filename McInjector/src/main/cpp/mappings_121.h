@@ -2,7 +2,7 @@
 // mappings_121.h
 // Descriptor tables for MC 1.21.x / Lunar 26.1 (Fabric/Mojmap bridge).
 // Candidate order: Yarn intermediary → Mojmap official → obfuscated fallback.
-// Include this in bridge_261.cpp only.
+// Include this in bridge_261.cpp only (internal linkage keeps it C++11-safe).
 
 #include "jni_core/resolver.h"
 
@@ -10,183 +10,255 @@ namespace mc121 {
 
 // ── Classes ──────────────────────────────────────────────────────────────────
 
-inline const char* kMcClassNames[] = {
+static const char* kMcClassNames[] = {
     "net.minecraft.class_310",                  // Yarn
     "net.minecraft.client.Minecraft",           // Mojmap
     "net.minecraft.client.MinecraftClient",     // Fabric alt
     nullptr
 };
-inline ClassDesc CLS_MC{ kMcClassNames };
+static ClassDesc CLS_MC{ kMcClassNames };
 
-inline const char* kEntityNames[] = {
+static const char* kEntityNames[] = {
     "net.minecraft.class_1297",                 // Yarn
     "net.minecraft.world.entity.Entity",        // Mojmap
     nullptr
 };
-inline ClassDesc CLS_ENTITY{ kEntityNames };
+static ClassDesc CLS_ENTITY{ kEntityNames };
 
-inline const char* kLivingEntityNames[] = {
+static const char* kLivingEntityNames[] = {
     "net.minecraft.class_1309",                 // Yarn
     "net.minecraft.world.entity.LivingEntity",  // Mojmap
     nullptr
 };
-inline ClassDesc CLS_LIVING_ENTITY{ kLivingEntityNames };
+static ClassDesc CLS_LIVING_ENTITY{ kLivingEntityNames };
 
-inline const char* kLocalPlayerNames[] = {
+static const char* kLocalPlayerNames[] = {
     "net.minecraft.class_746",                  // Yarn
     "net.minecraft.client.player.LocalPlayer",  // Mojmap
     nullptr
 };
-inline ClassDesc CLS_LOCAL_PLAYER{ kLocalPlayerNames };
+static ClassDesc CLS_LOCAL_PLAYER{ kLocalPlayerNames };
 
-inline const char* kClientWorldNames[] = {
+static const char* kClientWorldNames[] = {
     "net.minecraft.class_638",                  // Yarn
     "net.minecraft.client.multiplayer.ClientLevel", // Mojmap
     nullptr
 };
-inline ClassDesc CLS_WORLD{ kClientWorldNames };
+static ClassDesc CLS_WORLD{ kClientWorldNames };
 
-inline const char* kScreenNames[] = {
+static const char* kScreenNames[] = {
     "net.minecraft.class_437",                  // Yarn
     "net.minecraft.client.gui.screens.Screen",  // Mojmap
     "net.minecraft.client.gui.screen.Screen",   // Fabric alt
     nullptr
 };
-inline ClassDesc CLS_SCREEN{ kScreenNames };
+static ClassDesc CLS_SCREEN{ kScreenNames };
 
-inline const char* kChatScreenNames[] = {
+static const char* kChatScreenNames[] = {
     "net.minecraft.class_408",                  // Yarn
     "net.minecraft.client.gui.screens.ChatScreen", // Mojmap
     nullptr
 };
-inline ClassDesc CLS_CHAT_SCREEN{ kChatScreenNames };
+static ClassDesc CLS_CHAT_SCREEN{ kChatScreenNames };
 
-inline const char* kBlockPosNames[] = {
+static const char* kBlockPosNames[] = {
     "net.minecraft.class_2338",                 // Yarn
     "net.minecraft.core.BlockPos",              // Mojmap
     nullptr
 };
-inline ClassDesc CLS_BLOCKPOS{ kBlockPosNames };
+static ClassDesc CLS_BLOCKPOS{ kBlockPosNames };
 
-inline const char* kBlockEntityNames[] = {
+static const char* kBlockEntityNames[] = {
     "net.minecraft.class_2586",                 // Yarn
     "net.minecraft.world.level.block.entity.BlockEntity", // Mojmap
     nullptr
 };
-inline ClassDesc CLS_BLOCK_ENTITY{ kBlockEntityNames };
+static ClassDesc CLS_BLOCK_ENTITY{ kBlockEntityNames };
 
-inline const char* kVec3dNames[] = {
+static const char* kVec3dNames[] = {
     "net.minecraft.class_243",                  // Yarn
     "net.minecraft.world.phys.Vec3",            // Mojmap
     nullptr
 };
-inline ClassDesc CLS_VEC3D{ kVec3dNames };
+static ClassDesc CLS_VEC3D{ kVec3dNames };
 
-inline const char* kItemStackNames[] = {
+static const char* kItemStackNames[] = {
     "net.minecraft.class_1799",                 // Yarn
     "net.minecraft.world.item.ItemStack",       // Mojmap
     nullptr
 };
-inline ClassDesc CLS_ITEM_STACK{ kItemStackNames };
+static ClassDesc CLS_ITEM_STACK{ kItemStackNames };
 
-inline const char* kBlockItemNames[] = {
+static const char* kBlockItemNames[] = {
     "net.minecraft.class_1747",                 // Yarn
     "net.minecraft.world.item.BlockItem",       // Mojmap
     nullptr
 };
-inline ClassDesc CLS_BLOCK_ITEM{ kBlockItemNames };
+static ClassDesc CLS_BLOCK_ITEM{ kBlockItemNames };
 
-inline const char* kGameProfileNames[] = {
+static const char* kGameProfileNames[] = {
     "com.mojang.authlib.GameProfile", nullptr
 };
-inline ClassDesc CLS_GAME_PROFILE{ kGameProfileNames };
+static ClassDesc CLS_GAME_PROFILE{ kGameProfileNames };
+
+static const char* kGameModeNames[] = {
+    "net.minecraft.class_636",                  // Yarn
+    "net.minecraft.client.multiplayer.MultiPlayerGameMode", // Mojmap
+    nullptr
+};
+static ClassDesc CLS_GAME_MODE{ kGameModeNames };
+
+// Declaring class of the main-hand / attack-cooldown accessors.
+static const char* kPlayerNames[] = {
+    "net.minecraft.class_1657",                 // Yarn
+    "net.minecraft.world.entity.player.Player", // Mojmap
+    nullptr
+};
+static ClassDesc CLS_PLAYER{ kPlayerNames };
+
+static const char* kJavaClassNames[] = { "java.lang.Class", nullptr };
+static ClassDesc CLS_JAVA_CLASS{ kJavaClassNames };
 
 // ── Fields on Minecraft ───────────────────────────────────────────────────────
 
-inline const char* kPlayerFieldNames[] = { "field_1724", "player",  "f_91074_", nullptr };
-inline const char* kPlayerFieldSigs[]  = {
+static const char* kPlayerFieldNames[] = { "field_1724", "player",  "f_91074_", nullptr };
+static const char* kPlayerFieldSigs[]  = {
     "Lnet/minecraft/class_746;",
     "Lnet/minecraft/client/player/LocalPlayer;",
     nullptr
 };
-inline FieldDesc FIELD_PLAYER{ CLS_MC, kPlayerFieldNames, kPlayerFieldSigs };
+static FieldDesc FIELD_PLAYER{ CLS_MC, kPlayerFieldNames, kPlayerFieldSigs };
 
-inline const char* kScreenFieldNames[] = { "field_1755", "screen", "currentScreen", nullptr };
-inline const char* kScreenFieldSigs[]  = {
+static const char* kScreenFieldNames[] = { "field_1755", "screen", "currentScreen", nullptr };
+static const char* kScreenFieldSigs[]  = {
     "Lnet/minecraft/class_437;",
     "Lnet/minecraft/client/gui/screens/Screen;",
     "Lnet/minecraft/client/gui/screen/Screen;",
     nullptr
 };
-inline FieldDesc FIELD_SCREEN{ CLS_MC, kScreenFieldNames, kScreenFieldSigs };
+static FieldDesc FIELD_SCREEN{ CLS_MC, kScreenFieldNames, kScreenFieldSigs };
 
-inline const char* kWorldFieldNames[]  = { "field_1687", "level", "world", nullptr };
-inline const char* kWorldFieldSigs[]   = {
+static const char* kWorldFieldNames[]  = { "field_1687", "level", "world", nullptr };
+static const char* kWorldFieldSigs[]   = {
     "Lnet/minecraft/class_638;",
     "Lnet/minecraft/client/multiplayer/ClientLevel;",
     nullptr
 };
-inline FieldDesc FIELD_WORLD{ CLS_MC, kWorldFieldNames, kWorldFieldSigs };
+static FieldDesc FIELD_WORLD{ CLS_MC, kWorldFieldNames, kWorldFieldSigs };
+
+static const char* kGameModeFieldNames[] = { "field_1761", "gameMode", nullptr };
+static const char* kGameModeFieldSigs[]  = {
+    "Lnet/minecraft/class_636;",
+    "Lnet/minecraft/client/multiplayer/MultiPlayerGameMode;",
+    nullptr
+};
+static FieldDesc FIELD_GAME_MODE{ CLS_MC, kGameModeFieldNames, kGameModeFieldSigs };
+
+// ── Fields on MultiPlayerGameMode ─────────────────────────────────────────────
+
+static const char* kIsDestroyingNames[] = { "field_3716", "isDestroying", nullptr };
+static const char* kIsDestroyingSigs[]  = { "Z", nullptr };
+static FieldDesc FIELD_IS_DESTROYING{ CLS_GAME_MODE, kIsDestroyingNames, kIsDestroyingSigs };
 
 // ── Fields on Entity ─────────────────────────────────────────────────────────
 
-inline const char* kEntityPosNames[] = { "field_5961", "position", "pos", nullptr };
-inline const char* kEntityPosSigs[]  = {
+static const char* kEntityPosNames[] = { "field_5961", "position", "pos", nullptr };
+static const char* kEntityPosSigs[]  = {
     "Lnet/minecraft/class_243;",
     "Lnet/minecraft/world/phys/Vec3;",
     nullptr
 };
-inline FieldDesc FIELD_ENTITY_POS{ CLS_ENTITY, kEntityPosNames, kEntityPosSigs };
+static FieldDesc FIELD_ENTITY_POS{ CLS_ENTITY, kEntityPosNames, kEntityPosSigs };
+
+// Ticks the entity has existed; the local player's copy is the tick clock.
+static const char* kEntityTickCountNames[] = { "field_6012", "tickCount", "age", nullptr };
+static const char* kEntityTickCountSigs[]  = { "I", nullptr };
+static FieldDesc FIELD_ENTITY_TICK_COUNT{ CLS_ENTITY, kEntityTickCountNames, kEntityTickCountSigs };
 
 // ── Fields on Vec3d ───────────────────────────────────────────────────────────
 
-inline const char* kVec3XNames[] = { "field_1352", "x", nullptr };
-inline const char* kVec3XSigs[]  = { "D", nullptr };
-inline FieldDesc FIELD_VEC3_X{ CLS_VEC3D, kVec3XNames, kVec3XSigs };
+static const char* kVec3XNames[] = { "field_1352", "x", nullptr };
+static const char* kVec3XSigs[]  = { "D", nullptr };
+static FieldDesc FIELD_VEC3_X{ CLS_VEC3D, kVec3XNames, kVec3XSigs };
 
-inline const char* kVec3YNames[] = { "field_1351", "y", nullptr };
-inline const char* kVec3YSigs[]  = { "D", nullptr };
-inline FieldDesc FIELD_VEC3_Y{ CLS_VEC3D, kVec3YNames, kVec3YSigs };
+static const char* kVec3YNames[] = { "field_1351", "y", nullptr };
+static const char* kVec3YSigs[]  = { "D", nullptr };
+static FieldDesc FIELD_VEC3_Y{ CLS_VEC3D, kVec3YNames, kVec3YSigs };
 
-inline const char* kVec3ZNames[] = { "field_1350", "z", nullptr };
-inline const char* kVec3ZSigs[]  = { "D", nullptr };
-inline FieldDesc FIELD_VEC3_Z{ CLS_VEC3D, kVec3ZNames, kVec3ZSigs };
+static const char* kVec3ZNames[] = { "field_1350", "z", nullptr };
+static const char* kVec3ZSigs[]  = { "D", nullptr };
+static FieldDesc FIELD_VEC3_Z{ CLS_VEC3D, kVec3ZNames, kVec3ZSigs };
 
 // ── Methods on Entity ─────────────────────────────────────────────────────────
 
-inline const char* kGetXNames[] = { "method_23317", "getX", nullptr };
-inline const char* kGetXSigs[]  = { "()D", nullptr };
-inline MethodDesc METHOD_GET_X{ CLS_ENTITY, kGetXNames, kGetXSigs };
+static const char* kGetXNames[] = { "method_23317", "getX", nullptr };
+static const char* kGetXSigs[]  = { "()D", nullptr };
+static MethodDesc METHOD_GET_X{ CLS_ENTITY, kGetXNames, kGetXSigs };
 
-inline const char* kGetYNames[] = { "method_23318", "getY", nullptr };
-inline const char* kGetYSigs[]  = { "()D", nullptr };
-inline MethodDesc METHOD_GET_Y{ CLS_ENTITY, kGetYNames, kGetYSigs };
+static const char* kGetYNames[] = { "method_23318", "getY", nullptr };
+static const char* kGetYSigs[]  = { "()D", nullptr };
+static MethodDesc METHOD_GET_Y{ CLS_ENTITY, kGetYNames, kGetYSigs };
 
-inline const char* kGetZNames[] = { "method_23321", "getZ", nullptr };
-inline const char* kGetZSigs[]  = { "()D", nullptr };
-inline MethodDesc METHOD_GET_Z{ CLS_ENTITY, kGetZNames, kGetZSigs };
+static const char* kGetZNames[] = { "method_23321", "getZ", nullptr };
+static const char* kGetZSigs[]  = { "()D", nullptr };
+static MethodDesc METHOD_GET_Z{ CLS_ENTITY, kGetZNames, kGetZSigs };
 
 // ── Methods on LivingEntity ───────────────────────────────────────────────────
 
-inline const char* kGetHealthNames[] = { "method_6032", "getHealth", nullptr };
-inline const char* kGetHealthSigs[]  = { "()F", nullptr };
-inline MethodDesc METHOD_GET_HEALTH{ CLS_LIVING_ENTITY, kGetHealthNames, kGetHealthSigs };
+static const char* kGetHealthNames[] = { "method_6032", "getHealth", nullptr };
+static const char* kGetHealthSigs[]  = { "()F", nullptr };
+static MethodDesc METHOD_GET_HEALTH{ CLS_LIVING_ENTITY, kGetHealthNames, kGetHealthSigs };
 
 // ── Methods on Minecraft ──────────────────────────────────────────────────────
 
-inline const char* kSetScreenNames[] = { "method_1507", "setScreen", nullptr };
-inline const char* kSetScreenSigs[]  = {
+static const char* kSetScreenNames[] = { "method_1507", "setScreen", nullptr };
+static const char* kSetScreenSigs[]  = {
     "(Lnet/minecraft/class_437;)V",
     "(Lnet/minecraft/client/gui/screens/Screen;)V",
     nullptr
 };
-inline MethodDesc METHOD_SET_SCREEN{ CLS_MC, kSetScreenNames, kSetScreenSigs };
+static MethodDesc METHOD_SET_SCREEN{ CLS_MC, kSetScreenNames, kSetScreenSigs };
 
 // ── Methods on GameProfile ────────────────────────────────────────────────────
 
-inline const char* kGetNameNames[] = { "getName", nullptr };
-inline const char* kGetNameSigs[]  = { "()Ljava/lang/String;", nullptr };
-inline MethodDesc METHOD_GAME_PROFILE_GET_NAME{ CLS_GAME_PROFILE, kGetNameNames, kGetNameSigs };
+static const char* kGetNameNames[] = { "getName", nullptr };
+static const char* kGetNameSigs[]  = { "()Ljava/lang/String;", nullptr };
+static MethodDesc METHOD_GAME_PROFILE_GET_NAME{ CLS_GAME_PROFILE, kGetNameNames, kGetNameSigs };
+
+// ── Methods on Player ─────────────────────────────────────────────────────────
+
+static const char* kGetMainHandNames[] = { "getMainHandItem", "getMainHandStack", "method_6047", nullptr };
+static const char* kGetMainHandSigs[]  = {
+    "()Lnet/minecraft/world/item/ItemStack;",
+    "()Lnet/minecraft/class_1799;",
+    nullptr
+};
+static MethodDesc METHOD_GET_MAIN_HAND{ CLS_PLAYER, kGetMainHandNames, kGetMainHandSigs };
+
+static const char* kCooldownProgressNames[] = { "getAttackStrengthScale", "getAttackCooldownProgress", "method_7261", nullptr };
+static const char* kCooldownProgressSigs[]  = { "(F)F", nullptr };
+static MethodDesc METHOD_COOLDOWN_PROGRESS{ CLS_PLAYER, kCooldownProgressNames, kCooldownProgressSigs };
+
+static const char* kCooldownPerTickNames[] = { "getCurrentItemAttackStrengthDelay", "getAttackCooldownProgressPerTick", "method_7279", nullptr };
+static const char* kCooldownPerTickSigs[]  = { "()F", nullptr };
+static MethodDesc METHOD_COOLDOWN_PER_TICK{ CLS_PLAYER, kCooldownPerTickNames, kCooldownPerTickSigs };
+
+// ── Methods on ItemStack ──────────────────────────────────────────────────────
+
+static const char* kStackGetItemNames[] = { "getItem", "method_7909", nullptr };
+static const char* kStackGetItemSigs[]  = {
+    "()Lnet/minecraft/world/item/Item;",
+    "()Lnet/minecraft/item/Item;",
+    "()Lnet/minecraft/class_1792;",
+    nullptr
+};
+static MethodDesc METHOD_STACK_GET_ITEM{ CLS_ITEM_STACK, kStackGetItemNames, kStackGetItemSigs };
+
+// ── Methods on java.lang.Class ────────────────────────────────────────────────
+
+static const char* kGetSuperclassNames[] = { "getSuperclass", nullptr };
+static const char* kGetSuperclassSigs[]  = { "()Ljava/lang/Class;", nullptr };
+static MethodDesc METHOD_GET_SUPERCLASS{ CLS_JAVA_CLASS, kGetSuperclassNames, kGetSuperclassSigs };
 
 // ── Reset all (call during remap) ─────────────────────────────────────────────
 
@@ -204,15 +276,24 @@ inline void ResetAll(JNIEnv* env) {
     ResetDesc(CLS_ITEM_STACK, env);
     ResetDesc(CLS_BLOCK_ITEM, env);
     ResetDesc(CLS_GAME_PROFILE, env);
+    ResetDesc(CLS_GAME_MODE, env);
+    ResetDesc(CLS_PLAYER, env);
+    ResetDesc(CLS_JAVA_CLASS, env);
 
     ResetDesc(FIELD_PLAYER);  ResetDesc(FIELD_SCREEN);
-    ResetDesc(FIELD_WORLD);   ResetDesc(FIELD_ENTITY_POS);
+    ResetDesc(FIELD_WORLD);   ResetDesc(FIELD_ENTITY_POS);  ResetDesc(FIELD_ENTITY_TICK_COUNT);
     ResetDesc(FIELD_VEC3_X);  ResetDesc(FIELD_VEC3_Y);  ResetDesc(FIELD_VEC3_Z);
+    ResetDesc(FIELD_GAME_MODE); ResetDesc(FIELD_IS_DESTROYING);
 
     ResetDesc(METHOD_GET_X);  ResetDesc(METHOD_GET_Y);  ResetDesc(METHOD_GET_Z);
     ResetDesc(METHOD_GET_HEALTH);
     ResetDesc(METHOD_SET_SCREEN);
     ResetDesc(METHOD_GAME_PROFILE_GET_NAME);
+    ResetDesc(METHOD_GET_MAIN_HAND);
+    ResetDesc(METHOD_COOLDOWN_PROGRESS);
+    ResetDesc(METHOD_COOLDOWN_PER_TICK);
+    ResetDesc(METHOD_STACK_GET_ITEM);
+    ResetDesc(METHOD_GET_SUPERCLASS);
 }
 
 } // namespace mc121
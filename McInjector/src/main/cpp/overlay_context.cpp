@@ -0,0 +1,148 @@
+// overlay_context.cpp
+#include "overlay_context.h"
+#include "gl_loader.h"
+
+namespace OverlayContext {
+
+namespace {
+
+#define LC_WGL_CONTEXT_MAJOR_VERSION_ARB    0x2091
+#define LC_WGL_CONTEXT_MINOR_VERSION_ARB    0x2092
+#define LC_WGL_CONTEXT_PROFILE_MASK_ARB     0x9126
+#define LC_WGL_CONTEXT_CORE_PROFILE_BIT_ARB 0x00000001
+#define LC_WGL_CONTEXT_COMPAT_PROFILE_BIT_ARB 0x00000002
+#define LC_GL_SYNC_GPU_COMMANDS_COMPLETE    0x9117
+
+typedef struct __GLsync* LcGLsync;
+typedef HGLRC (WINAPI* PFNWGLCREATECONTEXTATTRIBSARB)(HDC, HGLRC, const int*);
+typedef LcGLsync (WINAPI* PFNGLFENCESYNC)(GLenum condition, GLbitfield flags);
+typedef void (WINAPI* PFNGLWAITSYNC)(LcGLsync sync, GLbitfield flags, unsigned long long timeout);
+typedef void (WINAPI* PFNGLDELETESYNC)(LcGLsync sync);
+
+const unsigned long long kTimeoutIgnored = 0xFFFFFFFFFFFFFFFFull;
+
+HGLRC s_overlayRc = nullptr;
+HGLRC s_gameRc    = nullptr;
+PFNGLFENCESYNC  s_fenceSync  = nullptr;
+PFNGLWAITSYNC   s_waitSync   = nullptr;
+PFNGLDELETESYNC s_deleteSync = nullptr;
+
+void* GetProc(const char* name) {
+    void* p = (void*)wglGetProcAddress(name);
+    if (p == (void*)0 || p == (void*)1 || p == (void*)2 || p == (void*)3 || p == (void*)-1) return nullptr;
+    return p;
+}
+
+// Fences the current context's commands so far; the context made current
+// next queues a wait on it (WaitAndDelete) before drawing.
+LcGLsync Fence() {
+    LcGLsync sync = s_fenceSync(LC_GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();   // the other context can only wait on a fence that was flushed
+    return sync;
+}
+
+void WaitAndDelete(LcGLsync sync) {
+    if (!sync) return;
+    s_waitSync(sync, 0, kTimeoutIgnored);
+    s_deleteSync(sync);
+}
+
+} // namespace
+
+bool EnabledFromEnvironment() {
+    static int s_enabled = -1;
+    if (s_enabled < 0) {
+        char env[16] = {};
+        DWORD len = GetEnvironmentVariableA("LC_OVERLAY_SHARED_CONTEXT", env, sizeof(env));
+        s_enabled = (len > 0 && (env[0] == '1' || env[0] == 'y' || env[0] == 'Y'
+                                 || env[0] == 't' || env[0] == 'T')) ? 1 : 0;
+    }
+    return s_enabled == 1;
+}
+
+bool Create(HDC hdc, HGLRC gameRc, bool core) {
+    Destroy();
+    if (!hdc || !gameRc || wglGetCurrentContext() != gameRc) return false;
+
+    s_fenceSync  = (PFNGLFENCESYNC)GetProc("glFenceSync");
+    s_waitSync   = (PFNGLWAITSYNC)GetProc("glWaitSync");
+    s_deleteSync = (PFNGLDELETESYNC)GetProc("glDeleteSync");
+    if (!s_fenceSync || !s_waitSync || !s_deleteSync) return false;   // needs GL 3.2 / ARB_sync
+
+    HGLRC rc = nullptr;
+    PFNWGLCREATECONTEXTATTRIBSARB createAttribs =
+        (PFNWGLCREATECONTEXTATTRIBSARB)GetProc("wglCreateContextAttribsARB");
+    if (createAttribs) {
+        const int attribs[] = {
+            LC_WGL_CONTEXT_MAJOR_VERSION_ARB, 3,
+            LC_WGL_CONTEXT_MINOR_VERSION_ARB, 3,
+            LC_WGL_CONTEXT_PROFILE_MASK_ARB,
+            core ? LC_WGL_CONTEXT_CORE_PROFILE_BIT_ARB : LC_WGL_CONTEXT_COMPAT_PROFILE_BIT_ARB,
+            0
+        };
+        rc = createAttribs(hdc, gameRc, attribs);   // shares with gameRc on creation
+    }
+    if (!rc && !core) {
+        rc = wglCreateContext(hdc);
+        if (rc && !wglShareLists(gameRc, rc)) {
+            wglDeleteContext(rc);
+            rc = nullptr;
+        }
+    }
+    if (!rc) return false;
+
+    // One round trip now, so a driver that refuses to switch shows up here
+    // and not in the middle of a frame.
+    if (!wglMakeCurrent(hdc, rc)) {
+        wglMakeCurrent(hdc, gameRc);
+        wglDeleteContext(rc);
+        return false;
+    }
+    wglMakeCurrent(hdc, gameRc);
+
+    s_overlayRc = rc;
+    s_gameRc = gameRc;
+    return true;
+}
+
+bool Begin(HDC hdc) {
+    if (!s_overlayRc) return false;
+    LcGLsync gameDone = Fence();
+    if (!wglMakeCurrent(hdc, s_overlayRc)) {
+        wglMakeCurrent(hdc, s_gameRc);
+        if (gameDone) s_deleteSync(gameDone);
+        return false;
+    }
+    WaitAndDelete(gameDone);
+    return true;
+}
+
+bool End(HDC hdc) {
+    if (!s_overlayRc) return false;
+    LcGLsync overlayDone = Fence();
+    if (!wglMakeCurrent(hdc, s_gameRc)) {
+        if (overlayDone) s_deleteSync(overlayDone);
+        return false;
+    }
+    WaitAndDelete(overlayDone);
+    return true;
+}
+
+void Destroy() {
+    if (s_overlayRc) {
+        if (wglGetCurrentContext() == s_overlayRc) wglMakeCurrent(nullptr, nullptr);
+        wglDeleteContext(s_overlayRc);
+    }
+    s_overlayRc = nullptr;
+    s_gameRc = nullptr;
+}
+
+bool Active() {
+    return s_overlayRc != nullptr;
+}
+
+HGLRC GameContext() {
+    return s_gameRc;
+}
+
+} // namespace OverlayContext
@@ -0,0 +1,47 @@
+#pragma once
+// overlay_context.h
+// Optional bridge-owned GL context for the ImGui overlay, shared by both bridges.
+//
+// The context is created on the game window's DC and shares objects with the
+// game's context (textures, buffers, programs, sync objects), but its binding
+// and enable state are its own.  So the overlay can draw with the backend's
+// GL state backup/restore turned off (ImGui_ImplOpenGL3_SetSkipStateBackup),
+// with none of the per-frame glGet* round trips into the game's context.
+//
+// Ordering between the two contexts uses fences: Begin() fences the game's
+// commands and has the overlay context wait on them before drawing; End()
+// does the same the other way before the game context becomes current again
+// for the real swap.
+//
+// Opt-in with LC_OVERLAY_SHARED_CONTEXT=1.  When creation, sharing or a
+// context switch fails the bridges fall back to drawing on the game context
+// with the usual save/restore.  Render thread only.
+
+#include <windows.h>
+
+namespace OverlayContext {
+
+// Reads LC_OVERLAY_SHARED_CONTEXT (1 / y / t) once.
+bool EnabledFromEnvironment();
+
+// Creates the shared context for `gameRc` (which must be current on `hdc`).
+// core = a 3.3 core profile (26.1), otherwise a compatibility context
+// (1.8.9).  Returns false and leaves nothing behind on failure.
+bool Create(HDC hdc, HGLRC gameRc, bool core);
+
+// Fences the game context and makes the overlay context current.  On false
+// the game context is current again and the caller should Destroy() and use
+// the fallback path.
+bool Begin(HDC hdc);
+
+// Fences the overlay draws and makes the game context current again.
+// Returns false if the game context could not be restored.
+bool End(HDC hdc);
+
+// Deletes the context (any context may be current).  Safe to call twice.
+void Destroy();
+
+bool  Active();
+HGLRC GameContext();
+
+} // namespace OverlayContext
@@ -0,0 +1,162 @@
+// overlay_font.cpp
+#include "overlay_font.h"
+#include "imgui.h"
+
+#include <cstring>
+#include <vector>
+
+namespace OverlayFont {
+
+namespace {
+
+const DWORD kDpiPollMs          = 1000;
+const int   kCompactAfterFrames = 120;   // stale bakes are unused by then
+
+struct LoadLock {
+    CRITICAL_SECTION cs;
+    LoadLock()  { InitializeCriticalSection(&cs); }
+    ~LoadLock() { DeleteCriticalSection(&cs); }
+};
+
+LoadLock& Lock() {
+    static LoadLock s_lock;
+    return s_lock;
+}
+
+// Guarded by Lock().
+bool              s_loaded = false;
+std::vector<char> s_data;
+std::string       s_path;
+std::string       s_prefetchDir;
+volatile LONG     s_prefetchStarted = 0;
+
+// Render thread.
+float s_baseScale = 1.0f;      // scale the font and style were built for
+float s_currentScale = 1.0f;
+DWORD s_lastPollMs = 0;
+int   s_compactIn = 0;
+
+bool LikelyFontBinary(const std::vector<char>& d) {
+    if (d.size() < 4) return false;
+    const unsigned char* h = (const unsigned char*)&d[0];
+    // TrueType/OpenType headers: 00 01 00 00, "OTTO", "true", "ttcf"
+    if (h[0] == 0x00 && h[1] == 0x01 && h[2] == 0x00 && h[3] == 0x00) return true;
+    return memcmp(h, "OTTO", 4) == 0 || memcmp(h, "true", 4) == 0 || memcmp(h, "ttcf", 4) == 0;
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<char>& out) {
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    bool ok = GetFileSizeEx(f, &size) && size.QuadPart > 0 && size.QuadPart < (64 << 20);
+    if (ok) {
+        out.resize((size_t)size.QuadPart);
+        DWORD got = 0;
+        ok = ReadFile(f, &out[0], (DWORD)out.size(), &got, nullptr) && got == out.size();
+    }
+    CloseHandle(f);
+    if (!ok) out.clear();
+    return ok;
+}
+
+// Caller holds Lock().
+void LoadLocked(const std::string& bridgeDir) {
+    if (s_loaded) return;
+    s_loaded = true;
+    const std::string candidates[] = {
+        bridgeDir + "\\minecraftia.ttf",
+        bridgeDir + "\\Minecraftia.ttf",
+        bridgeDir + "\\Data\\minecraftia.ttf",
+        bridgeDir + "\\Data\\Minecraftia.ttf",
+        "C:\\Windows\\Fonts\\minecraftia.ttf",
+        "C:\\Windows\\Fonts\\Minecraftia.ttf"
+    };
+    for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+        std::vector<char> data;
+        if (!ReadWholeFile(candidates[i], data) || !LikelyFontBinary(data)) continue;
+        s_data.swap(data);
+        s_path = candidates[i];
+        return;
+    }
+}
+
+DWORD WINAPI PrefetchThreadProc(LPVOID) {
+    EnterCriticalSection(&Lock().cs);
+    LoadLocked(s_prefetchDir);
+    LeaveCriticalSection(&Lock().cs);
+    return 0;
+}
+
+} // namespace
+
+void Prefetch(const std::string& bridgeDir) {
+    if (InterlockedCompareExchange(&s_prefetchStarted, 1, 0) != 0) return;
+    EnterCriticalSection(&Lock().cs);
+    s_prefetchDir = bridgeDir;
+    LeaveCriticalSection(&Lock().cs);
+    HANDLE t = CreateThread(nullptr, 0, PrefetchThreadProc, nullptr, 0, nullptr);
+    if (t) CloseHandle(t);
+}
+
+ImFont* AddPrefetched(ImFontAtlas* atlas, ImFontConfig& cfg, const std::string& bridgeDir,
+                      std::string* pathOut) {
+    EnterCriticalSection(&Lock().cs);
+    LoadLocked(bridgeDir);   // no-op once the prefetch has run
+    ImFont* font = nullptr;
+    if (!s_data.empty()) {
+        // The atlas frees what it owns on Clear(); hand it a copy so a later
+        // context (backend reset, window change) can load from memory again.
+        void* copy = IM_ALLOC(s_data.size());
+        memcpy(copy, &s_data[0], s_data.size());
+        cfg.FontDataOwnedByAtlas = true;
+        font = atlas->AddFontFromMemoryTTF(copy, (int)s_data.size(), cfg.SizePixels, &cfg);
+        if (font && pathOut) *pathOut = s_path;
+    }
+    LeaveCriticalSection(&Lock().cs);
+    return font;
+}
+
+float DpiScale(HWND hwnd) {
+    UINT dpi = 96;
+    typedef UINT (WINAPI* FnGetDpiForWindow)(HWND);
+    static FnGetDpiForWindow s_fn = nullptr;
+    static bool s_resolved = false;
+    if (!s_resolved) {
+        HMODULE hUser32 = GetModuleHandleA("user32.dll");
+        if (hUser32) s_fn = (FnGetDpiForWindow)GetProcAddress(hUser32, "GetDpiForWindow");
+        s_resolved = true;
+    }
+    if (s_fn && hwnd) dpi = s_fn(hwnd);
+    float scale = (dpi > 0) ? ((float)dpi / 96.0f) : 1.0f;
+    if (scale < 0.75f) scale = 0.75f;
+    if (scale > 2.5f) scale = 2.5f;
+    return scale;
+}
+
+void BeginContext(float scale) {
+    s_baseScale = s_currentScale = scale;
+    s_lastPollMs = GetTickCount();
+    s_compactIn = 0;
+}
+
+bool UpdateDpi(HWND hwnd, float* scaleOut) {
+    if (s_compactIn > 0 && --s_compactIn == 0)
+        ImGui::GetIO().Fonts->CompactCache();
+
+    DWORD now = GetTickCount();
+    if (now - s_lastPollMs < kDpiPollMs) return false;
+    s_lastPollMs = now;
+
+    float scale = DpiScale(hwnd);
+    if (scale == s_currentScale) return false;
+    ImGuiStyle& st = ImGui::GetStyle();
+    st.ScaleAllSizes(scale / s_currentScale);
+    st.FontScaleDpi = scale / s_baseScale;
+    s_currentScale = scale;
+    s_compactIn = kCompactAfterFrames;
+    if (scaleOut) *scaleOut = scale;
+    return true;
+}
+
+} // namespace OverlayFont
@@ -0,0 +1,51 @@
+#pragma once
+// overlay_font.h
+// Minecraftia loading and DPI tracking for the overlay font, shared by both
+// bridges.
+//
+// The TTF is read into memory on a worker thread started right after
+// injection, so phase-1 init on the first SwapBuffers only hands the bytes
+// to the atlas instead of probing and reading candidate files on the game's
+// render thread.  ImGui 1.92's atlas is dynamic: glyphs are rasterised on
+// first use at the size they are drawn with, so only what the overlay
+// actually prints ever reaches the texture.
+//
+// A monitor DPI change does not rebuild anything: UpdateDpi() rescales the
+// style and sets FontScaleDpi, and the glyphs re-bake lazily at the new size
+// on the next frames.  Stale bakes are compacted away once they fall out of
+// use.
+//
+// Prefetch() from any thread; everything else on the render thread.
+
+#include <windows.h>
+#include <string>
+
+struct ImFontAtlas;
+struct ImFontConfig;
+struct ImFont;
+
+namespace OverlayFont {
+
+// Starts reading the first valid Minecraftia candidate under bridgeDir (and
+// the Windows font folder).  A no-op after the first call.
+void Prefetch(const std::string& bridgeDir);
+
+// Adds the prefetched font to the atlas at cfg.SizePixels; reads it now if
+// the prefetch has not run.  Null when no candidate exists.  pathOut (may be
+// null) receives the file the bytes came from.
+ImFont* AddPrefetched(ImFontAtlas* atlas, ImFontConfig& cfg, const std::string& bridgeDir,
+                      std::string* pathOut);
+
+// Window DPI / 96, clamped to [0.75, 2.5].
+float DpiScale(HWND hwnd);
+
+// Call after creating an ImGui context whose font and style were set up
+// for `scale`.
+void BeginContext(float scale);
+
+// Once per frame before NewFrame.  Polls the window DPI at most once a
+// second; on a change it rescales the style and FontScaleDpi and returns
+// true (the new scale in *scaleOut, may be null).
+bool UpdateDpi(HWND hwnd, float* scaleOut);
+
+} // namespace OverlayFont
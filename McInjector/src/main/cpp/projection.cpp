@@ -0,0 +1,187 @@
+// projection.cpp
+#include "projection.h"
+
+#include <cmath>
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LC_PROJECTION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Projection {
+
+namespace {
+
+struct Viewport {
+    float xScale;   // extra x factor (1 / aspect for the angles model)
+    float halfW, halfH;
+    float w, h;
+};
+
+Viewport MakeViewport(const Camera& cam, int winW, int winH) {
+    Viewport vp;
+    vp.w = (float)winW;
+    vp.h = (float)winH;
+    vp.halfW = 0.5f * vp.w;
+    vp.halfH = 0.5f * vp.h;
+    vp.xScale = (cam.aspectFromViewport && winW > 0) ? vp.h / vp.w : 1.0f;
+    return vp;
+}
+
+unsigned char ProjectOne(const Camera& cam, const Viewport& vp, double x, double y, double z,
+                         float& sx, float& sy) {
+    const float* m = cam.m;
+    float dx = (float)(x - cam.ox);
+    float dy = (float)(y - cam.oy);
+    float dz = (float)(z - cam.oz);
+    float cx = dx * m[0] + dy * m[4] + dz * m[8]  + m[12];
+    float cy = dx * m[1] + dy * m[5] + dz * m[9]  + m[13];
+    float cw = dx * m[3] + dy * m[7] + dz * m[11] + m[15];
+    sx = 0.0f;
+    sy = 0.0f;
+    if (!(cw >= kNearW) || cw > FLT_MAX) return 0;
+    float inv = 1.0f / cw;
+    sx = (cx * inv * vp.xScale + 1.0f) * vp.halfW;
+    sy = (1.0f - cy * inv) * vp.halfH;
+    if (!std::isfinite(sx) || !std::isfinite(sy)) return 0;
+    unsigned char f = kInFront;
+    if (sx >= 0.0f && sx <= vp.w && sy >= 0.0f && sy <= vp.h) f |= kOnScreen;
+    return f;
+}
+
+} // namespace
+
+void FromMatrices(Camera& out, double camX, double camY, double camZ,
+                  const float view[16], const float proj[16]) {
+    out.ox = camX; out.oy = camY; out.oz = camZ;
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            float s = 0.0f;
+            for (int k = 0; k < 4; k++) s += proj[k * 4 + r] * view[c * 4 + k];
+            out.m[c * 4 + r] = s;
+        }
+    }
+    out.aspectFromViewport = false;
+    out.valid = true;
+}
+
+void FromAngles(Camera& out, double camX, double camY, double camZ,
+                float yawDeg, float pitchDeg, float fovDeg) {
+    const float PI = 3.14159265f;
+    float yaw   = yawDeg   * (PI / 180.0f);
+    float pitch = pitchDeg * (PI / 180.0f);
+    float sinY = sinf(yaw),   cosY = cosf(yaw);
+    float sinP = sinf(pitch), cosP = cosf(pitch);
+
+    // Forward, right = normalize(worldUp x forward), up = forward x right.
+    float fX = -sinY * cosP, fY = -sinP, fZ = cosY * cosP;
+    float rX = fZ, rY = 0.0f, rZ = -fX;
+    float rLen = sqrtf(rX * rX + rZ * rZ);
+    if (rLen < 1e-6f) { rX = 1.0f; rZ = 0.0f; rLen = 1.0f; }
+    rX /= rLen; rZ /= rLen;
+    float uX = fY * rZ - fZ * rY;
+    float uY = fZ * rX - fX * rZ;
+    float uZ = fX * rY - fY * rX;
+
+    float invTan = 1.0f / tanf(fovDeg * 0.5f * (PI / 180.0f));
+    out.ox = camX; out.oy = camY; out.oz = camZ;
+    // Rows: x = right/tan (aspect applied per viewport), y = up/tan, w = forward.
+    out.m[0] = rX * invTan; out.m[4] = rY * invTan; out.m[8]  = rZ * invTan; out.m[12] = 0.0f;
+    out.m[1] = uX * invTan; out.m[5] = uY * invTan; out.m[9]  = uZ * invTan; out.m[13] = 0.0f;
+    out.m[2] = 0.0f;        out.m[6] = 0.0f;        out.m[10] = 0.0f;        out.m[14] = 0.0f;
+    out.m[3] = fX;          out.m[7] = fY;          out.m[11] = fZ;          out.m[15] = 0.0f;
+    out.aspectFromViewport = true;
+    out.valid = true;
+}
+
+int Project(const Camera& cam, int winW, int winH, const Points& pts, Screen& out) {
+    const int n = pts.Size();
+    out.sx.resize(n);
+    out.sy.resize(n);
+    out.flags.resize(n);
+    if (!n) return 0;
+    const Viewport vp = MakeViewport(cam, winW, winH);
+    const double* px = &pts.x[0];
+    const double* py = &pts.y[0];
+    const double* pz = &pts.z[0];
+    float* sx = &out.sx[0];
+    float* sy = &out.sy[0];
+    unsigned char* flags = &out.flags[0];
+    int inFront = 0;
+    int i = 0;
+
+#ifdef LC_PROJECTION_SSE2
+    const float* m = cam.m;
+    const __m128d ox = _mm_set1_pd(cam.ox), oy = _mm_set1_pd(cam.oy), oz = _mm_set1_pd(cam.oz);
+    const __m128 m0 = _mm_set1_ps(m[0]), m4 = _mm_set1_ps(m[4]), m8  = _mm_set1_ps(m[8]),  m12 = _mm_set1_ps(m[12]);
+    const __m128 m1 = _mm_set1_ps(m[1]), m5 = _mm_set1_ps(m[5]), m9  = _mm_set1_ps(m[9]),  m13 = _mm_set1_ps(m[13]);
+    const __m128 m3 = _mm_set1_ps(m[3]), m7 = _mm_set1_ps(m[7]), m11 = _mm_set1_ps(m[11]), m15 = _mm_set1_ps(m[15]);
+    const __m128 nearW = _mm_set1_ps(kNearW), maxW = _mm_set1_ps(FLT_MAX);
+    const __m128 one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+    const __m128 xScale = _mm_set1_ps(vp.xScale);
+    const __m128 halfW = _mm_set1_ps(vp.halfW), halfH = _mm_set1_ps(vp.halfH);
+    const __m128 vpW = _mm_set1_ps(vp.w), vpH = _mm_set1_ps(vp.h);
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 dx = _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(px + i), ox)),
+                                  _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(px + i + 2), ox)));
+        __m128 dy = _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(py + i), oy)),
+                                  _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(py + i + 2), oy)));
+        __m128 dz = _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(pz + i), oz)),
+                                  _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(pz + i + 2), oz)));
+
+        __m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, m0), _mm_mul_ps(dy, m4)), _mm_add_ps(_mm_mul_ps(dz, m8), m12));
+        __m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, m1), _mm_mul_ps(dy, m5)), _mm_add_ps(_mm_mul_ps(dz, m9), m13));
+        __m128 cw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, m3), _mm_mul_ps(dy, m7)), _mm_add_ps(_mm_mul_ps(dz, m11), m15));
+
+        // Ordered compares are false for NaN, so NaN w is culled too.
+        __m128 front = _mm_and_ps(_mm_cmpge_ps(cw, nearW), _mm_cmple_ps(cw, maxW));
+        __m128 safeW = _mm_or_ps(_mm_and_ps(front, cw), _mm_andnot_ps(front, one));
+        __m128 ndcX = _mm_div_ps(cx, safeW);
+        __m128 ndcY = _mm_div_ps(cy, safeW);
+        __m128 x = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ndcX, xScale), one), halfW);
+        __m128 y = _mm_mul_ps(_mm_sub_ps(one, ndcY), halfH);
+
+        // v - v is 0 only for finite v.
+        __m128 finite = _mm_and_ps(_mm_cmpeq_ps(_mm_sub_ps(x, x), zero), _mm_cmpeq_ps(_mm_sub_ps(y, y), zero));
+        front = _mm_and_ps(front, finite);
+        __m128 onScreen = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x, zero), _mm_cmple_ps(x, vpW)),
+                                     _mm_and_ps(_mm_cmpge_ps(y, zero), _mm_cmple_ps(y, vpH)));
+        onScreen = _mm_and_ps(onScreen, front);
+
+        x = _mm_and_ps(x, front);
+        y = _mm_and_ps(y, front);
+        _mm_storeu_ps(sx + i, x);
+        _mm_storeu_ps(sy + i, y);
+
+        int frontMask = _mm_movemask_ps(front);
+        int screenMask = _mm_movemask_ps(onScreen);
+        for (int k = 0; k < 4; k++) {
+            unsigned char f = 0;
+            if (frontMask & (1 << k))  { f |= kInFront; inFront++; }
+            if (screenMask & (1 << k)) f |= kOnScreen;
+            flags[i + k] = f;
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        flags[i] = ProjectOne(cam, vp, px[i], py[i], pz[i], sx[i], sy[i]);
+        if (flags[i] & kInFront) inFront++;
+    }
+    return inFront;
+}
+
+bool ProjectPoint(const Camera& cam, int winW, int winH, double x, double y, double z,
+                  float* sx, float* sy) {
+    const Viewport vp = MakeViewport(cam, winW, winH);
+    float ox = 0.0f, oy = 0.0f;
+    unsigned char f = ProjectOne(cam, vp, x, y, z, ox, oy);
+    if (!(f & kInFront)) return false;
+    *sx = ox;
+    *sy = oy;
+    return true;
+}
+
+} // namespace Projection
@@ -0,0 +1,92 @@
+#pragma once
+// projection.h
+// Batch world-to-screen projection for the overlays.
+//
+// A Camera folds view and projection (or the yaw/pitch/FOV model used when
+// the matrices are unavailable) into one 4x4 once per camera snapshot.
+// Project() then maps structure-of-arrays world points to screen space and
+// classifies each one in the same pass, four points per SSE2 iteration with a
+// scalar loop for the tail (and for builds without SSE2).  Positions stay
+// doubles up to the camera-relative subtraction, as in the single-point
+// WorldToScreen paths, so far-from-origin worlds keep their precision.
+//
+//   Projection::Camera cam;
+//   Projection::FromMatrices(cam, camX, camY, camZ, view.m, proj.m);
+//   Projection::Points pts;  pts.Push(x, y, z); ...
+//   Projection::Project(cam, winW, winH, pts, out);
+//   if (out.flags[i] & Projection::kInFront) ... out.sx[i], out.sy[i]
+//
+// Header types are plain data; no allocation happens once the output
+// vectors have grown to the largest batch.
+
+#include <cstddef>
+#include <vector>
+
+namespace Projection {
+
+// Points closer than this along the view axis (clip w) are behind the camera.
+static const float kNearW = 0.1f;
+
+enum PointFlags {
+    kInFront  = 1,   // in front of the near plane with finite screen coords
+    kOnScreen = 2    // kInFront and inside [0,w]x[0,h]
+};
+
+struct Camera {
+    double ox, oy, oz;     // camera position; projected points are relative to it
+    float  m[16];          // clip = m * (p - o, 1), column-major
+    bool   aspectFromViewport;  // x is divided by the viewport aspect (angles model)
+    bool   valid;
+};
+
+// view/proj are column-major (JOML / OpenGL layout).
+void FromMatrices(Camera& out, double camX, double camY, double camZ,
+                  const float view[16], const float proj[16]);
+// Minecraft yaw/pitch in degrees (yaw 0 = south, +pitch looks down) and
+// vertical FOV in degrees; same model as WorldToScreen_Angles.
+void FromAngles(Camera& out, double camX, double camY, double camZ,
+                float yawDeg, float pitchDeg, float fovDeg);
+
+struct Points {
+    std::vector<double> x, y, z;
+
+    void Clear() { x.clear(); y.clear(); z.clear(); }
+    void Reserve(size_t n) { x.reserve(n); y.reserve(n); z.reserve(n); }
+    void Push(double px, double py, double pz) { x.push_back(px); y.push_back(py); z.push_back(pz); }
+    int  Size() const { return (int)x.size(); }
+};
+
+struct Screen {
+    std::vector<float>         sx, sy;
+    std::vector<unsigned char> flags;   // PointFlags
+};
+
+// Describes the inputs of the last Project() into a Screen so an overlay can
+// keep that output when nothing it depends on moved: the camera snapshot
+// sequence, the point source's version and count, and the viewport.
+struct BatchKey {
+    unsigned long cameraSeq;
+    long          sourceVersion;
+    int           count, winW, winH;
+    bool          valid;
+
+    // True when the key matches; otherwise records it and returns false, so
+    // the caller re-projects.
+    bool Reuse(unsigned long seq, long version, int n, int w, int h) {
+        if (valid && cameraSeq == seq && sourceVersion == version && count == n && winW == w && winH == h)
+            return true;
+        cameraSeq = seq; sourceVersion = version; count = n; winW = w; winH = h; valid = true;
+        return false;
+    }
+    void Invalidate() { valid = false; }
+};
+
+// Projects every point; out is resized to pts.Size().  Returns how many
+// points are kInFront.
+int Project(const Camera& cam, int winW, int winH, const Points& pts, Screen& out);
+
+// Single point; true when kInFront.
+bool ProjectPoint(const Camera& cam, int winW, int winH, double x, double y, double z,
+                  float* sx, float* sy);
+
+} // namespace Projection
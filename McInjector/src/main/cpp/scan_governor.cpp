@@ -0,0 +1,162 @@
+// scan_governor.cpp
+#include "scan_governor.h"
+#include "frame_profiler.h"
+
+#include <cstdio>
+
+namespace lc {
+
+namespace {
+
+SnapshotCell<GovernorStatus>& Cell() {
+    static SnapshotCell<GovernorStatus> s_cell;   // GovernorStatus() zeroes: running = false
+    return s_cell;
+}
+
+bool DisabledFromEnvironment() {
+    char env[16] = {};
+    DWORD len = GetEnvironmentVariableA("LC_SCAN_GOVERNOR", env, sizeof(env));
+    return len > 0 && (env[0] == '0' || env[0] == 'n' || env[0] == 'N' || env[0] == 'f' || env[0] == 'F');
+}
+
+} // namespace
+
+ScanGovernor::ScanGovernor(TaskScheduler& sched)
+    : _sched(sched), _taskCount(0), _enabled(!DisabledFromEnvironment()), _level(0),
+      _pressuredRun(0), _calmRun(0), _pressured(false), _frameUs(0), _baselineUs(0.0),
+      _busyPct(0.0f), _evalAtMs(GetTickCount()), _busyAtEval(sched.BusyUs()),
+      _levelSinceMs(GetTickCount()), _raises(0), _drops(0) {}
+
+ScanGovernor::~ScanGovernor() {
+    Cell().BeginWrite() = GovernorStatus();
+    Cell().Commit();
+}
+
+void ScanGovernor::Manage(int taskId, DWORD basePeriodMs, DWORD maxPeriodMs) {
+    for (int i = 0; i < _taskCount; i++) {
+        if (_tasks[i].taskId == taskId) { SetBase(taskId, basePeriodMs, maxPeriodMs); return; }
+    }
+    if (_taskCount >= GovernorStatus::kMaxTasks) return;
+    Managed& m = _tasks[_taskCount++];
+    m.taskId = taskId;
+    m.baseMs = basePeriodMs ? basePeriodMs : 1;
+    m.maxMs = maxPeriodMs;
+    m.busyAtEval = _sched.BusyUs(taskId);
+    m.busyPct = 0.0f;
+    _sched.SetPeriod(taskId, PeriodFor(m));
+}
+
+void ScanGovernor::SetBase(int taskId, DWORD basePeriodMs, DWORD maxPeriodMs) {
+    for (int i = 0; i < _taskCount; i++) {
+        Managed& m = _tasks[i];
+        if (m.taskId != taskId) continue;
+        m.baseMs = basePeriodMs ? basePeriodMs : 1;
+        m.maxMs = maxPeriodMs;
+        _sched.SetPeriod(taskId, PeriodFor(m));
+        return;
+    }
+    _sched.SetPeriod(taskId, basePeriodMs);
+}
+
+DWORD ScanGovernor::PeriodFor(const Managed& m) const {
+    if (!_enabled || m.maxMs <= m.baseMs) return m.baseMs;
+    DWORD p = m.baseMs << _level;
+    return p < m.maxMs ? p : m.maxMs;
+}
+
+void ScanGovernor::Apply() {
+    for (int i = 0; i < _taskCount; i++) _sched.SetPeriod(_tasks[i].taskId, PeriodFor(_tasks[i]));
+}
+
+bool ScanGovernor::Update() {
+    DWORD nowMs = GetTickCount();
+    DWORD elapsedMs = nowMs - _evalAtMs;
+    if (elapsedMs < kEvalMs) return false;
+    _evalAtMs = nowMs;
+
+    unsigned long long busy = _sched.BusyUs();
+    double wallUs = (double)elapsedMs * 1000.0;
+    _busyPct = (float)((busy - _busyAtEval) * 100.0 / wallUs);
+    _busyAtEval = busy;
+    for (int i = 0; i < _taskCount; i++) {
+        Managed& m = _tasks[i];
+        unsigned long long b = _sched.BusyUs(m.taskId);
+        m.busyPct = (float)((b - m.busyAtEval) * 100.0 / wallUs);
+        m.busyAtEval = b;
+    }
+
+    // No frame time (minimised, loading): hold the level, learn nothing.
+    _frameUs = FrameProfiler::GameFrameUs();
+    const int oldLevel = _level;
+    if (_frameUs) {
+        if (_baselineUs <= 0.0) _baselineUs = _frameUs;
+        const bool slow = _frameUs > _baselineUs * (100 + kPressurePct) / 100.0
+                       || _frameUs > 1000000u / kFloorFps;
+        _pressured = slow && _busyPct * 10.0f >= (float)kMinBusyPermille;
+        if (_pressured) {
+            _calmRun = 0;
+            if (++_pressuredRun >= kRaiseEvals && _enabled && _level < kMaxLevel) { _level++; _pressuredRun = 0; }
+        } else {
+            _pressuredRun = 0;
+            if (_level > 0 && ++_calmRun >= kCalmEvals) { _level--; _calmRun = 0; }
+        }
+        // The baseline follows calm frames only while nothing is stretched:
+        // down quickly (a lighter scene), up slowly (so a fight does not
+        // become the new normal before it is noticed).
+        if (_level == 0 && !slow)
+            _baselineUs += (_frameUs - _baselineUs) / (_frameUs < _baselineUs ? 4.0 : 32.0);
+    }
+
+    const bool changed = _level != oldLevel;
+    if (changed) {
+        if (_level > oldLevel) _raises++; else _drops++;
+        _levelSinceMs = nowMs;
+        Apply();
+    }
+    Publish();
+    return changed;
+}
+
+std::string ScanGovernor::Describe() const {
+    char buf[160];
+    snprintf(buf, sizeof(buf), "level=%d frame=%.1fms baseline=%.1fms scanBusy=%.1f%%%s",
+             _level, _frameUs / 1000.0, _baselineUs / 1000.0, _busyPct, _pressured ? " pressured" : "");
+    std::string out = buf;
+    for (int i = 0; i < _taskCount; i++) {
+        const Managed& m = _tasks[i];
+        snprintf(buf, sizeof(buf), " %s=%lums", _sched.Name(m.taskId).c_str(), (unsigned long)_sched.Period(m.taskId));
+        out += buf;
+    }
+    return out;
+}
+
+void ScanGovernor::Publish() {
+    GovernorStatus& st = Cell().BeginWrite();
+    st.running = true;
+    st.enabled = _enabled;
+    st.level = _level;
+    st.pressured = _pressured;
+    st.frameMs = _frameUs / 1000.0f;
+    st.baselineMs = (float)(_baselineUs / 1000.0);
+    st.busyPct = _busyPct;
+    st.levelSinceMs = _levelSinceMs;
+    st.raises = _raises;
+    st.drops = _drops;
+    st.taskCount = _taskCount;
+    for (int i = 0; i < _taskCount; i++) {
+        const Managed& m = _tasks[i];
+        GovernorStatus::Task& t = st.tasks[i];
+        snprintf(t.name, sizeof(t.name), "%s", _sched.Name(m.taskId).c_str());
+        t.baseMs = m.baseMs;
+        t.maxMs = m.maxMs > m.baseMs ? m.maxMs : m.baseMs;
+        t.periodMs = _sched.Period(m.taskId);
+        t.busyPct = m.busyPct;
+    }
+    Cell().Commit();
+}
+
+SnapshotCell<GovernorStatus>::Ref ScanGovernor::Published() {
+    return Cell().Acquire();
+}
+
+} // namespace lc
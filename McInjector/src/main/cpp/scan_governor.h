@@ -0,0 +1,115 @@
+#pragma once
+// scan_governor.h
+// Stretches the periods of non-critical scan tasks while the game is short
+// of frame time (the 26.1 scan thread).
+//
+// Every kEvalMs the governor compares the game's frame time
+// (FrameProfiler::GameFrameUs, taken in the swap hook) with a calm baseline,
+// a slow average of the frame time while nothing is stretched, and measures
+// what the scan thread costs over the interval (TaskScheduler::BusyUs).  An
+// interval is pressured when the frame time is kPressurePct over the baseline
+// or below kFloorFps, and the scan thread was busy at least kMinBusyPermille
+// of it: only then can backing off give the game anything.  kRaiseEvals
+// pressured intervals in a row raise the back-off level; kCalmEvals calm ones
+// lower it.  Each level doubles a managed task's period, up to the limit it
+// was registered with.  Latency-critical tasks are simply not registered.
+//
+// LC_SCAN_GOVERNOR=0 (or n / f) keeps every period at its base.
+//
+// Scan thread only, except Published(), which any thread may call.
+
+#include "task_scheduler.h"
+#include "snapshot_cell.h"
+
+#include <windows.h>
+#include <string>
+
+namespace lc {
+
+struct GovernorStatus {
+    static const int kMaxTasks = 8;
+
+    struct Task {
+        char        name[24];
+        DWORD       baseMs;
+        DWORD       maxMs;
+        DWORD       periodMs;      // current
+        float       busyPct;       // of one core over the last interval
+    };
+
+    bool     running;              // false until a governor publishes
+    bool     enabled;
+    int      level;
+    bool     pressured;            // last interval
+    float    frameMs;              // 0: no frame time (minimised, loading)
+    float    baselineMs;
+    float    busyPct;              // whole scan thread, of one core
+    DWORD    levelSinceMs;         // GetTickCount() of the last level change
+    unsigned raises, drops;        // level changes since start
+    int      taskCount;
+    Task     tasks[kMaxTasks];
+};
+
+class ScanGovernor {
+public:
+    static const DWORD    kEvalMs          = 500;
+    static const int      kMaxLevel        = 3;    // periods up to 8x base
+    static const unsigned kPressurePct     = 25;
+    static const unsigned kFloorFps        = 40;
+    static const unsigned kMinBusyPermille = 10;   // 1% of a core
+    static const int      kRaiseEvals      = 2;
+    static const int      kCalmEvals       = 8;
+
+    explicit ScanGovernor(TaskScheduler& sched);
+    ~ScanGovernor();   // publishes running = false
+
+    // Puts a scheduler task under the governor: its period becomes
+    // base << level, capped at maxPeriodMs.  maxPeriodMs <= basePeriodMs pins
+    // it at the base.  Call SetBase() instead of TaskScheduler::SetPeriod()
+    // for managed tasks when their base changes (config).
+    void Manage(int taskId, DWORD basePeriodMs, DWORD maxPeriodMs);
+    void SetBase(int taskId, DWORD basePeriodMs, DWORD maxPeriodMs);
+
+    // Once per scan-loop pass; evaluates every kEvalMs.  True when the
+    // back-off level changed (Describe() says how).
+    bool Update();
+
+    int Level() const { return _level; }
+    std::string Describe() const;
+
+    // Latest status published by the running governor.
+    static SnapshotCell<GovernorStatus>::Ref Published();
+
+private:
+    ScanGovernor(const ScanGovernor&);
+    ScanGovernor& operator=(const ScanGovernor&);
+
+    struct Managed {
+        int   taskId;
+        DWORD baseMs;
+        DWORD maxMs;
+        unsigned long long busyAtEval;
+        float busyPct;
+    };
+
+    DWORD PeriodFor(const Managed& m) const;
+    void  Apply();
+    void  Publish();
+
+    TaskScheduler& _sched;
+    Managed  _tasks[GovernorStatus::kMaxTasks];
+    int      _taskCount;
+    bool     _enabled;
+    int      _level;
+    int      _pressuredRun, _calmRun;
+    bool     _pressured;
+    unsigned _frameUs;
+    double   _baselineUs;
+    float    _busyPct;
+    DWORD    _evalAtMs;
+    unsigned long long _busyAtEval;
+    DWORD    _levelSinceMs;
+    unsigned _raises, _drops;
+};
+
+} // namespace lc
@@ -0,0 +1,58 @@
+// send_queue.cpp
+#include "send_queue.h"
+
+namespace lc {
+
+bool SendQueue::Send(SOCKET s, const std::string* const* bufs, size_t count) {
+    const size_t kMaxBufs = 16;
+    WSABUF wsa[kMaxBufs];
+    const char* bases[kMaxBufs];
+    size_t lens[kMaxBufs];
+    DWORD n = 0;
+
+    if (HasBacklog()) {
+        bases[n] = _pending.data();
+        lens[n] = _pending.size();
+        n++;
+    }
+    size_t next = 0;   // first buffer not gathered into this WSASend
+    for (; next < count && n < kMaxBufs; next++) {
+        if (!bufs[next] || bufs[next]->empty()) continue;
+        bases[n] = bufs[next]->data();
+        lens[n] = bufs[next]->size();
+        n++;
+    }
+    if (n == 0) return true;
+
+    for (DWORD i = 0; i < n; i++) {
+        wsa[i].buf = (CHAR*)bases[i];
+        wsa[i].len = (ULONG)lens[i];
+    }
+
+    DWORD sent = 0;
+    if (WSASend(s, wsa, n, &sent, 0, nullptr, nullptr) == SOCKET_ERROR) {
+        int err = WSAGetLastError();
+        if (err != WSAEWOULDBLOCK) { _lastError = err; return false; }
+        sent = 0;
+    }
+    _sentBytes += sent;
+
+    // Keep every byte the socket did not take, in order, followed by the
+    // buffers that did not fit into this call; they go out on the next flush.
+    std::string rest;
+    size_t skip = sent;
+    for (DWORD i = 0; i < n; i++) {
+        if (skip >= lens[i]) { skip -= lens[i]; continue; }
+        rest.append(bases[i] + skip, lens[i] - skip);
+        skip = 0;
+    }
+    for (; next < count; next++) {
+        if (bufs[next]) rest.append(*bufs[next]);
+    }
+    _pending.swap(rest);
+
+    if (_pending.size() > kMaxPendingBytes) { _lastError = WSAENOBUFS; return false; }
+    return true;
+}
+
+} // namespace lc
@@ -0,0 +1,46 @@
+#pragma once
+// send_queue.h
+// Ordered, loss-free sends on a non-blocking socket.
+//
+// Send() gathers whatever is still pending from earlier calls plus the new
+// buffers into one WSASend.  Bytes the socket does not take (partial send or
+// WSAEWOULDBLOCK) are kept and go out first next time, so frames are never
+// truncated or reordered.  Callers should skip producing latest-wins data
+// (state) while HasBacklog() and just keep flushing.
+
+#include <winsock2.h>
+#include <string>
+
+namespace lc {
+
+class SendQueue {
+public:
+    // A loader that stops reading for this long worth of data is dropped.
+    static const size_t kMaxPendingBytes = 1024 * 1024;
+
+    SendQueue() : _lastError(0), _sentBytes(0) {}
+
+    // Append without sending (acks and handshake lines; they keep their place
+    // ahead of anything passed to a later Send()).
+    void Push(const std::string& data) { _pending.append(data); }
+
+    bool HasBacklog() const { return !_pending.empty(); }
+    size_t Pending() const { return _pending.size(); }
+
+    // Send pending bytes then each non-empty buffer in `bufs`.  Returns false
+    // on a socket error other than WSAEWOULDBLOCK, or when the backlog would
+    // exceed kMaxPendingBytes; the connection should then be closed.
+    bool Send(SOCKET s, const std::string* const* bufs, size_t count);
+
+    int LastError() const { return _lastError; }
+
+    // Bytes the socket has taken since construction.
+    unsigned long long SentBytes() const { return _sentBytes; }
+
+private:
+    std::string _pending;
+    int _lastError;
+    unsigned long long _sentBytes;
+};
+
+} // namespace lc
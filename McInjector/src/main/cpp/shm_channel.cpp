@@ -0,0 +1,123 @@
+// shm_channel.cpp
+#include "shm_channel.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace lc {
+
+namespace {
+
+struct Header {
+    DWORD          magic;
+    DWORD          version;
+    DWORD          slotCount;
+    DWORD          slotBytes;
+    volatile LONG64 published;
+    volatile LONG  configSeq;
+    DWORD          configLen;
+    DWORD          bridgePid;
+};
+
+struct SlotHeader {
+    volatile LONG64 seq;
+    DWORD           len;
+    DWORD           parts;     // slots the frame takes; 0 on all but its first
+};
+
+const unsigned kSlotPayload = ShmChannel::kSlotBytes - sizeof(SlotHeader);
+
+} // namespace
+
+ShmChannel::ShmChannel()
+    : _mapping(nullptr), _stateEvent(nullptr), _configEvent(nullptr),
+      _view(nullptr), _published(0), _lastConfigSeq(0) {}
+
+ShmChannel::~ShmChannel() { Close(); }
+
+bool ShmChannel::Open() {
+    if (_view) return true;
+
+    char base[64];
+    snprintf(base, sizeof(base), "LegoClickerBridge_%lu", (unsigned long)GetCurrentProcessId());
+    _name = base;
+    std::string local = std::string("Local\\") + base;
+
+    _mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, kMappingBytes, local.c_str());
+    if (!_mapping) return false;
+    _view = (unsigned char*)MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, kMappingBytes);
+    _stateEvent = CreateEventA(nullptr, FALSE, FALSE, (local + "_state").c_str());
+    _configEvent = CreateEventA(nullptr, FALSE, FALSE, (local + "_config").c_str());
+    if (!_view || !_stateEvent || !_configEvent) { Close(); return false; }
+
+    // A reopened mapping (bridge reinjected into the same game) keeps its
+    // frame counter so a loader that is still attached never sees it go back.
+    Header* h = (Header*)_view;
+    if (h->magic != kMagic || h->version != kVersion) {
+        std::memset(_view, 0, kRingOffset);
+        h->version = kVersion;
+        h->slotCount = kSlotCount;
+        h->slotBytes = kSlotBytes;
+        h->bridgePid = GetCurrentProcessId();
+        MemoryBarrier();
+        h->magic = kMagic;
+    }
+    _published = h->published;
+    _lastConfigSeq = h->configSeq & ~1L;
+    return true;
+}
+
+void ShmChannel::Close() {
+    if (_view) { UnmapViewOfFile(_view); _view = nullptr; }
+    if (_mapping) { CloseHandle(_mapping); _mapping = nullptr; }
+    if (_stateEvent) { CloseHandle(_stateEvent); _stateEvent = nullptr; }
+    if (_configEvent) { CloseHandle(_configEvent); _configEvent = nullptr; }
+}
+
+bool ShmChannel::Publish(const std::string& frame) {
+    size_t parts = (frame.size() + kSlotPayload - 1) / kSlotPayload;
+    if (!_view || parts == 0 || parts > kMaxFrameSlots) return false;
+
+    Header* h = (Header*)_view;
+    for (size_t i = 0; i < parts; i++) {
+        LONG64 n = _published + 1 + (LONG64)i;
+        SlotHeader* slot = (SlotHeader*)(_view + kRingOffset + (size_t)((n - 1) % kSlotCount) * kSlotBytes);
+        size_t offset = i * kSlotPayload;
+        size_t len = frame.size() - offset < kSlotPayload ? frame.size() - offset : kSlotPayload;
+
+        InterlockedExchange64(&slot->seq, 0);
+        slot->len = (DWORD)len;
+        slot->parts = i == 0 ? (DWORD)parts : 0;
+        std::memcpy((unsigned char*)(slot + 1), frame.data() + offset, len);
+        InterlockedExchange64(&slot->seq, n);
+    }
+    // Only now can the reader reach any of the frame's slots.
+    _published += (LONG64)parts;
+    InterlockedExchange64(&h->published, _published);
+
+    SetEvent(_stateEvent);
+    return true;
+}
+
+bool ShmChannel::TakeConfig(std::string& out) {
+    if (!_view) return false;
+    Header* h = (Header*)_view;
+
+    LONG s1 = InterlockedCompareExchange(&h->configSeq, 0, 0);
+    if ((s1 & 1) || s1 == _lastConfigSeq) return false;
+    DWORD len = h->configLen;
+    if (len > kConfigBytes) return false;
+    out.assign((const char*)_view + kConfigOffset, len);
+    MemoryBarrier();
+    if (InterlockedCompareExchange(&h->configSeq, 0, 0) != s1) return false;   // torn; retry next call
+
+    _lastConfigSeq = s1;
+    return true;
+}
+
+void ShmChannel::WaitForConfig(DWORD ms) {
+    if (_configEvent) WaitForSingleObject(_configEvent, ms);
+    else Sleep(ms);
+}
+
+} // namespace lc
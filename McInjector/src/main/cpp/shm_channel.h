@@ -0,0 +1,92 @@
+#pragma once
+// shm_channel.h
+// Same-machine transport next to the TCP socket: one named file mapping with a
+// ring of lcb1 frames (bridge -> loader) and a config mailbox (loader ->
+// bridge), plus two auto-reset events for wakeups.
+//
+// The TCP connection stays the session: capabilities list "transports":
+// ["tcp","shm"], the loader sends {"type":"transport","state":"shm"}, and the
+// bridge answers {"type":"transport","state":"shm","name":"<base>"} once the
+// mapping exists.  From then on state and cmd frames go to the ring instead of
+// the socket, and config arrives through the mailbox.  The loader drops back
+// with {"type":"transport","state":"tcp"}; a closed socket ends both.
+//
+// Objects (all "Local\" + base):
+//   <base>          mapping, kMappingBytes
+//   <base>_state    signalled after each published frame
+//   <base>_config   signalled after the loader writes the mailbox
+//
+// Mapping layout (little-endian, offsets in bytes):
+//   0   u32 magic (kMagic)      4  u32 version
+//   8   u32 slotCount           12 u32 slotBytes
+//   16  i64 published           frames published so far; frame n is in slot (n-1) % slotCount
+//   24  i32 configSeq           seqlock: odd while the loader is writing
+//   28  u32 configLen           32 u32 bridgePid
+//   64  config bytes (kConfigBytes, one JSON object, no newline)
+//   kRingOffset + i*slotBytes: i64 seq (slot number, 0 while rewriting) |
+//                              u32 len | u32 parts | len bytes of lcb1 frame
+//
+// A frame normally fits one slot (parts = 1), and the reader decodes it in
+// place, accepting the result only if the slot's seq still equals the number
+// it wanted.  A larger frame (a crowded keyframe) is split over `parts`
+// consecutive slots, up to kMaxFrameSlots; its later slots carry parts = 0,
+// and `published` moves past all of them at once.  The reader copies those
+// chunks out, checking each slot's seq, before it decodes.
+
+#include <windows.h>
+#include <string>
+
+namespace lc {
+
+class ShmChannel {
+public:
+    static const unsigned kMagic        = 0x4D53434C;   // "LCSM"
+    static const unsigned kVersion      = 2;
+    static const unsigned kSlotCount    = 64;
+    static const unsigned kSlotBytes    = 8192;
+    static const unsigned kConfigOffset = 64;
+    static const unsigned kConfigBytes  = 16384;
+    static const unsigned kRingOffset   = kConfigOffset + kConfigBytes;
+    static const unsigned kMappingBytes = kRingOffset + kSlotCount * kSlotBytes;
+    static const unsigned kMaxFrameSlots = 16;
+
+    ShmChannel();
+    ~ShmChannel();
+
+    // Create (or reopen) the mapping and events for this process.  Idempotent.
+    bool Open();
+    void Close();
+    bool IsOpen() const { return _view != nullptr; }
+
+    // Base object name without the "Local\" prefix.
+    const std::string& Name() const { return _name; }
+
+    // Copy one complete lcb1 frame into the next slot(s) and signal
+    // <base>_state.  Returns false for a frame over kMaxFrameSlots slots; the
+    // caller sends that one over TCP.  Single writer.
+    bool Publish(const std::string& frame);
+
+    // If the loader wrote a new config since the last call, copy it to `out`.
+    bool TakeConfig(std::string& out);
+
+    // Wait up to `ms` for <base>_config; Sleep(ms) when not open.
+    void WaitForConfig(DWORD ms);
+
+    // <base>_config, for callers that wait on it with other handles; null when
+    // not open.
+    HANDLE ConfigEvent() const { return _configEvent; }
+
+private:
+    ShmChannel(const ShmChannel&);
+    ShmChannel& operator=(const ShmChannel&);
+
+    std::string _name;
+    HANDLE _mapping;
+    HANDLE _stateEvent;
+    HANDLE _configEvent;
+    unsigned char* _view;
+    LONG64 _published;
+    LONG _lastConfigSeq;
+};
+
+} // namespace lc
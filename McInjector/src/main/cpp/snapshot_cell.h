@@ -0,0 +1,162 @@
+#pragma once
+// snapshot_cell.h
+// Single-writer publication of immutable, reference-counted snapshots.
+//
+// The writer builds a new T and Publish()es it; readers Acquire() a Ref to the
+// current snapshot without taking a lock (two interlocked ops) and can keep it
+// for as long as they like.  Readers that poll can compare Version() with the
+// Ref they hold and skip re-acquiring when nothing was published.
+//
+// Reclamation: a reader bumps _acquiring around the load of _current and the
+// increment of the node's refcount.  After swapping _current the writer frees
+// a retired node only once it sees _acquiring == 0 (every reader that could
+// have loaded the old pointer has already counted itself) and the node's
+// refcount is 0.  Nodes still held stay on the writer's retired list and are
+// retried on the next Publish() or Reclaim().
+//
+// Freed nodes are kept for reuse, so a writer that fills BeginWrite() in place
+// (clear() + refill a vector, assign a string) stops allocating once the pool
+// covers the snapshots readers hold at once: with one writer and a reader or
+// two that is three or four buffers, a triple buffer that tolerates several
+// readers.  Version() doubles as the generation counter.
+
+#include <windows.h>
+#include <vector>
+
+namespace lc {
+
+template <typename T>
+class SnapshotCell {
+    struct Node {
+        volatile LONG refs;
+        LONG version;
+        T value;
+
+        Node(const T& v, LONG ver) : refs(0), version(ver), value(v) {}
+    };
+
+public:
+    class Ref {
+    public:
+        Ref() : _node(nullptr) {}
+        Ref(const Ref& o) : _node(o._node) { if (_node) InterlockedIncrement(&_node->refs); }
+        ~Ref() { Reset(); }
+
+        Ref& operator=(const Ref& o)
+        {
+            if (o._node) InterlockedIncrement(&o._node->refs);
+            Reset();
+            _node = o._node;
+            return *this;
+        }
+
+        void Reset()
+        {
+            if (_node) InterlockedDecrement(&_node->refs);
+            _node = nullptr;
+        }
+
+        const T& operator*() const { return _node->value; }
+        const T* operator->() const { return &_node->value; }
+        LONG Version() const { return _node ? _node->version : 0; }
+
+    private:
+        friend class SnapshotCell;
+        explicit Ref(Node* n) : _node(n) {}   // takes an already-counted reference
+        Node* _node;
+    };
+
+    explicit SnapshotCell(const T& initial = T())
+        : _current(new Node(initial, 1)), _version(1), _acquiring(0), _writing(nullptr) {}
+
+    ~SnapshotCell()
+    {
+        // Process teardown only; outstanding Refs must be gone.
+        delete _current;
+        delete _writing;
+        for (size_t i = 0; i < _retired.size(); i++) delete _retired[i];
+        for (size_t i = 0; i < _free.size(); i++) delete _free[i];
+    }
+
+    // Version of the newest snapshot; one plain read for pollers.
+    LONG Version() const { return *(const volatile LONG*)&_version; }
+
+    Ref Acquire() const
+    {
+        InterlockedIncrement(&_acquiring);
+        Node* n = (Node*)InterlockedCompareExchangePointer((PVOID volatile*)&_current, nullptr, nullptr);
+        InterlockedIncrement(&n->refs);
+        InterlockedDecrement(&_acquiring);
+        return Ref(n);
+    }
+
+    // Refreshes `ref` only when a newer snapshot exists.  Returns true if it did.
+    bool Refresh(Ref& ref) const
+    {
+        if (ref._node && ref._node->version == Version()) return false;
+        ref = Acquire();
+        return true;
+    }
+
+    // Single writer: the buffer the next Commit() publishes.  It holds stale
+    // data from an older snapshot; overwrite all of it.  Calling it again
+    // before Commit() returns the same buffer.
+    T& BeginWrite()
+    {
+        if (!_writing) {
+            Reclaim();
+            if (!_free.empty()) { _writing = _free.back(); _free.pop_back(); }
+            else _writing = new Node(T(), 0);
+        }
+        return _writing->value;
+    }
+
+    // Publishes the BeginWrite() buffer.  Returns the new version.
+    LONG Commit()
+    {
+        BeginWrite();
+        Node* n = _writing;
+        _writing = nullptr;
+        LONG ver = _version + 1;
+        n->version = ver;
+        n->refs = 0;
+        Node* old = (Node*)InterlockedExchangePointer((PVOID volatile*)&_current, n);
+        InterlockedExchange(&_version, ver);
+        _retired.push_back(old);
+        Reclaim();
+        return ver;
+    }
+
+    // Copy-assigns into a recycled buffer and publishes it.
+    LONG Publish(const T& value)
+    {
+        BeginWrite() = value;
+        return Commit();
+    }
+
+    // Moves retired snapshots no reader holds to the reuse pool.  Writer only.
+    void Reclaim()
+    {
+        if (_retired.empty()) return;
+        if (InterlockedCompareExchange(&_acquiring, 0, 0) != 0) return;
+        size_t kept = 0;
+        for (size_t i = 0; i < _retired.size(); i++) {
+            if (InterlockedCompareExchange(&_retired[i]->refs, 0, 0) == 0) _free.push_back(_retired[i]);
+            else _retired[kept++] = _retired[i];
+        }
+        _retired.resize(kept);
+    }
+
+private:
+    SnapshotCell(const SnapshotCell&);
+    SnapshotCell& operator=(const SnapshotCell&);
+
+    Node* volatile _current;
+    volatile LONG _version;
+    mutable volatile LONG _acquiring;
+    Node* _writing;
+    std::vector<Node*> _retired;
+    std::vector<Node*> _free;
+};
+
+} // namespace lc
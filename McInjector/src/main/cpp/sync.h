@@ -0,0 +1,36 @@
+#pragma once
+// sync.h
+// CRITICAL_SECTION mutex and scoped guards shared by both bridges.  MinGW's
+// win32 thread model has no std::mutex, so the bridges used to carry their
+// own copies of these.
+
+#include <windows.h>
+
+class Mutex {
+    CRITICAL_SECTION cs;
+public:
+    Mutex()  { InitializeCriticalSection(&cs); }
+    ~Mutex() { DeleteCriticalSection(&cs); }
+    void lock()     { EnterCriticalSection(&cs); }
+    bool try_lock() { return TryEnterCriticalSection(&cs) != 0; }
+    void unlock()   { LeaveCriticalSection(&cs); }
+private:
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+};
+
+class LockGuard {
+    Mutex& m;
+public:
+    explicit LockGuard(Mutex& m) : m(m) { m.lock(); }
+    ~LockGuard() { m.unlock(); }
+};
+
+class TryLockGuard {
+    Mutex& m;
+    bool owns;
+public:
+    explicit TryLockGuard(Mutex& m) : m(m), owns(m.try_lock()) {}
+    ~TryLockGuard() { if (owns) m.unlock(); }
+    bool owns_lock() const { return owns; }
+};
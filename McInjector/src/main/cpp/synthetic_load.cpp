@@ -0,0 +1,253 @@
+// synthetic_load.cpp
+#include "synthetic_load.h"
+
+#if LC_SYNTHETIC_LOAD
+
+#include "entity_interp.h"
+#include "frame_profiler.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace SyntheticLoad {
+
+namespace {
+
+const char* const kStageNames[kStageCount] = {
+    "playerScan", "chestScan", "projection", "nametags", "chestEsp", "serialize"
+};
+
+const char* const kHeldItems[] = { "Diamond Sword", "Bow", "Golden Apple", "Oak Planks", "" };
+const int kHeldItemCount = (int)(sizeof(kHeldItems) / sizeof(kHeldItems[0]));
+
+enum Counter { kRuns, kItems, kTicks, kBytes, kCounterCount };
+
+volatile LONGLONG s_counters[kStageCount][kCounterCount];
+DWORD s_lastFormatMs = 0;
+
+int      s_active = -1;   // -1 until Active() read the environment
+Settings s_settings = {};
+
+// Scan thread only: the players' paths and the spot everything is laid out
+// around, fixed on the first Fill call.
+struct Walker {
+    double cx, cz;    // circle centre
+    double radius;
+    double omega;     // rad/s, signed
+    double phase;
+    float  hpPhase;
+    int    armor;
+    HelperBridge::PoolString name, held;
+};
+bool                s_anchored = false;
+double              s_anchorX = 0.0, s_anchorY = 0.0, s_anchorZ = 0.0;
+std::vector<Walker> s_walkers;
+std::string         s_pool;
+
+unsigned Mix(unsigned a, unsigned b) {
+    unsigned h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u + (a << 6) + (a >> 2));
+    h ^= h >> 16; h *= 0x85EBCA6Bu;
+    h ^= h >> 13; h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+double Unit(unsigned h) { return (double)(h & 0xFFFFFF) / 16777216.0; }
+
+HelperBridge::PoolString PoolAppend(const std::string& s) {
+    HelperBridge::PoolString p = { (int)s_pool.size(), (int)s.size() };
+    s_pool += s;
+    return p;
+}
+
+void Anchor(double x, double y, double z) {
+    if (s_anchored) return;
+    s_anchored = true;
+    s_anchorX = x; s_anchorY = y; s_anchorZ = z;
+
+    const double kTwoPi = 6.283185307179586;
+    s_walkers.resize((size_t)s_settings.players);
+    s_pool.clear();
+    HelperBridge::PoolString held[kHeldItemCount];
+    for (int k = 0; k < kHeldItemCount; k++) held[k] = PoolAppend(kHeldItems[k]);
+    for (int i = 0; i < s_settings.players; i++) {
+        const unsigned h = Mix(s_settings.seed, (unsigned)i);
+        Walker& w = s_walkers[(size_t)i];
+        const double angle = kTwoPi * Unit(h);
+        const double dist = s_settings.radius * std::sqrt(Unit(Mix(h, 1)));
+        w.cx = x + dist * std::cos(angle);
+        w.cz = z + dist * std::sin(angle);
+        w.radius = 2.0 + 6.0 * Unit(Mix(h, 2));
+        w.omega = (0.2 + 0.8 * Unit(Mix(h, 3))) * ((h & 1) ? 1.0 : -1.0);
+        w.phase = kTwoPi * Unit(Mix(h, 4));
+        w.hpPhase = (float)(kTwoPi * Unit(Mix(h, 5)));
+        w.armor = (int)(Mix(h, 6) % 21);
+        char name[24];
+        snprintf(name, sizeof(name), "Synth_%03d", i);
+        w.name = PoolAppend(name);
+        w.held = held[Mix(h, 7) % (unsigned)kHeldItemCount];
+    }
+}
+
+} // namespace
+
+bool ParseSpec(const char* spec, Settings& out) {
+    if (!spec || !*spec) return false;
+    Settings s = { 0, 0, 48.0, 1u };
+    char* end = nullptr;
+    long players = std::strtol(spec, &end, 10);
+    if (end == spec || *end != ',') return false;
+    const char* p = end + 1;
+    long chests = std::strtol(p, &end, 10);
+    if (end == p) return false;
+    if (*end == ',') {
+        p = end + 1;
+        s.radius = std::strtod(p, &end);
+        if (end == p || !(s.radius > 0.0)) return false;
+        if (*end == ',') {
+            p = end + 1;
+            s.seed = (unsigned)std::strtoul(p, &end, 10);
+            if (end == p) return false;
+        }
+    }
+    if (*end || players < 0 || chests < 0 || players > 10000 || chests > 100000) return false;
+    s.players = (int)players;
+    s.chests = (int)chests;
+    out = s;
+    return true;
+}
+
+bool Active() {
+    if (s_active < 0) {
+        char env[64] = {};
+        DWORD len = GetEnvironmentVariableA("LC_SYNTHETIC_LOAD", env, sizeof(env));
+        s_active = (len > 0 && len < sizeof(env) && ParseSpec(env, s_settings)) ? 1 : 0;
+        s_lastFormatMs = GetTickCount();
+    }
+    return s_active == 1;
+}
+
+const Settings& Current() {
+    return s_settings;
+}
+
+int FillEntities(double camX, double camY, double camZ, double tSec, HelperBridge::WideEntityFrame& frame) {
+    Anchor(camX, camY, camZ);
+    frame.pool = s_pool;   // the helper path copies its pool out of the buffer too
+    frame.records.resize(s_walkers.size());
+    for (size_t i = 0; i < s_walkers.size(); i++) {
+        const Walker& w = s_walkers[i];
+        const double a = w.phase + w.omega * tSec;
+        HelperBridge::WideEntityRecord& r = frame.records[i];
+        r.index = (int)i;
+        r.entityId = 100000 + (int)i;
+        r.x = w.cx + w.radius * std::cos(a);
+        r.y = s_anchorY + 0.4 * std::sin(2.0 * a);
+        r.z = w.cz + w.radius * std::sin(a);
+        // Whole half hearts, so health changes a few times a minute per player.
+        r.health = std::floor((float)(10.5 + 9.5 * std::sin(0.1 * tSec + w.hpPhase)) * 2.0f) * 0.5f;
+        r.armor = w.armor;
+        r.heldDamage = 0;
+        r.heldMaxDamage = 0;
+        r.name = w.name;
+        r.profile = w.name;
+        r.held = w.held;
+        r.team.off = 0;
+        r.team.len = 0;
+    }
+    return (int)frame.records.size();
+}
+
+int FillBlockEntities(double camX, double camY, double camZ, int pcx, int pcz, int range,
+                      HelperBridge::BlockEntityFrame& frame) {
+    Anchor(camX, camY, camZ);
+    frame.chunks.clear();
+    frame.records.clear();
+    const unsigned window = (unsigned)((2 * range + 1) * (2 * range + 1));
+    const unsigned perChunk = (unsigned)s_settings.chests / window;
+    const unsigned extra = (unsigned)s_settings.chests % window;
+    const int baseY = (int)std::floor(s_anchorY);
+    for (int dx = -range; dx <= range; dx++) {
+        for (int dz = -range; dz <= range; dz++) {
+            const int cx = pcx + dx, cz = pcz + dz;
+            const unsigned h = Mix(Mix(s_settings.seed, (unsigned)cx), (unsigned)cz);
+            const unsigned count = perChunk + (h % window < extra ? 1u : 0u);
+            HelperBridge::BlockEntityChunk c;
+            c.first = (int)frame.records.size();
+            c.count = (int)count;
+            c.scanned = (int)(count + count / 4);   // signs, furnaces and the like are walked too
+            for (unsigned k = 0; k < count; k++) {
+                const unsigned r = Mix(h, k);
+                HelperBridge::BlockEntityRecord rec;
+                rec.x = cx * 16 + (int)(r & 15);
+                rec.z = cz * 16 + (int)((r >> 4) & 15);
+                rec.y = baseY - 8 + (int)((r >> 8) & 15);
+                rec.kind = 0;
+                frame.records.push_back(rec);
+            }
+            frame.chunks.push_back(c);
+        }
+    }
+    return (int)frame.chunks.size();
+}
+
+const char* StageName(int stage) {
+    return stage >= 0 && stage < kStageCount ? kStageNames[stage] : "?";
+}
+
+void Record(Stage stage, unsigned long long items, LONGLONG qpcTicks, unsigned long long bytes) {
+    volatile LONGLONG* c = s_counters[stage];
+    InterlockedIncrement64(&c[kRuns]);
+    InterlockedExchangeAdd64(&c[kItems], (LONGLONG)items);
+    InterlockedExchangeAdd64(&c[kTicks], qpcTicks);
+    if (bytes) InterlockedExchangeAdd64(&c[kBytes], (LONGLONG)bytes);
+}
+
+std::string FormatAndReset(DWORD nowMs) {
+    DWORD elapsed = nowMs - s_lastFormatMs;
+    if (elapsed == 0) elapsed = 1;
+    s_lastFormatMs = nowMs;
+    const double perSec = 1000.0 / (double)elapsed;
+    const double usPerTick = 1e6 / (double)lc::QpcFrequency();
+
+    char buf[192];
+    snprintf(buf, sizeof(buf), "players=%d chests=%d over %lu ms",
+             s_settings.players, s_settings.chests, (unsigned long)elapsed);
+    std::string out = buf;
+    for (int s = 0; s < kStageCount; s++) {
+        LONGLONG v[kCounterCount];
+        for (int k = 0; k < kCounterCount; k++) v[k] = InterlockedExchange64(&s_counters[s][k], 0);
+        if (!v[kRuns]) {
+            snprintf(buf, sizeof(buf), "; %s idle", kStageNames[s]);
+        } else if (v[kBytes]) {
+            snprintf(buf, sizeof(buf), "; %s %.1f runs/s %.0f items/s %.0f us/run %.0f B/s", kStageNames[s],
+                     v[kRuns] * perSec, v[kItems] * perSec, v[kTicks] * usPerTick / v[kRuns], v[kBytes] * perSec);
+        } else {
+            snprintf(buf, sizeof(buf), "; %s %.1f runs/s %.0f items/s %.0f us/run", kStageNames[s],
+                     v[kRuns] * perSec, v[kItems] * perSec, v[kTicks] * usPerTick / v[kRuns]);
+        }
+        out += buf;
+    }
+
+    FrameProfiler::PhaseStats st;
+    if (FrameProfiler::Percentiles(FrameProfiler::kTotal, st)) {
+        snprintf(buf, sizeof(buf), "; hook p50=%.0fus p99=%.0fus", st.p50Us, st.p99Us);
+        out += buf;
+    }
+    snprintf(buf, sizeof(buf), "; game frame %.2f ms", FrameProfiler::GameFrameUs() / 1000.0);
+    out += buf;
+    return out;
+}
+
+StageTimer::StageTimer(Stage stage)
+    : items(0), bytes(0), _stage(stage), _start(Active() ? lc::QpcNow() : 0) {}
+
+StageTimer::~StageTimer() {
+    if (_start) Record(_stage, items, lc::QpcNow() - _start, bytes);
+}
+
+} // namespace SyntheticLoad
+
+#endif // LC_SYNTHETIC_LOAD
@@ -0,0 +1,115 @@
+#pragma once
+// synthetic_load.h
+// Debug-only synthetic world for scaling runs of the 26.1 scan and overlay
+// paths.
+//
+// Release builds (the default) leave LC_SYNTHETIC_LOAD at 0: the header
+// declares nothing and the LC_SYNTH_* macros below expand to nothing.
+//
+// Synthetic builds (`build_261.bat synthetic`, i.e. -DLC_SYNTHETIC_LOAD=1)
+// read LC_SYNTHETIC_LOAD=players,chests[,radius[,seed]] once.  While it is
+// set, the player-list scan takes its frame from FillEntities() instead of
+// the AokoHelper crossing and the chest scan takes its frame from
+// FillBlockEntities(); everything downstream of the frame (player table,
+// g_playerList / g_chestList, frustum culling, projection, nametags, chest
+// ESP, state serialization) runs unchanged on that data.  Players walk
+// circles around the spot where the camera stood on the first pass; chests
+// are spread over the chunk window deterministically per chunk, so moving
+// the camera moves the window as it would in a real world.
+//
+// Each stage is timed with a StageTimer (any thread); FormatAndReset()
+// turns the counters into runs/s, items/s, us per run and bytes/s for the
+// periodic "SyntheticLoad:" log line.
+//
+// Usage (synthetic builds only):
+//   if (SyntheticLoad::Active()) n = SyntheticLoad::FillEntities(x, y, z, tSec, frame);
+//   LC_SYNTH_STAGE(timer, SyntheticLoad::kPlayerScan);
+//   LC_SYNTH_ITEMS(timer, list.size());
+
+#ifndef LC_SYNTHETIC_LOAD
+#define LC_SYNTHETIC_LOAD 0
+#endif
+
+#if LC_SYNTHETIC_LOAD
+
+#include "jni_core/helper_bridge.h"
+
+#include <windows.h>
+#include <string>
+
+namespace SyntheticLoad {
+
+struct Settings {
+    int players;
+    int chests;      // about this many over the whole chunk window
+    double radius;   // players' anchors lie within this distance of the first camera position
+    unsigned seed;
+};
+
+// "players,chests[,radius[,seed]]".  False for anything else or negative counts.
+bool ParseSpec(const char* spec, Settings& out);
+
+// LC_SYNTHETIC_LOAD, read on the first call (DllMain, before any thread
+// starts).  False while unset or malformed.
+bool Active();
+const Settings& Current();
+
+// Scan thread only.  Fills `frame` the way collectEntityFrameWide() would
+// for the players at tSec and returns the record count.
+int FillEntities(double camX, double camY, double camZ, double tSec, HelperBridge::WideEntityFrame& frame);
+
+// Scan thread only.  Fills `frame` the way collectBlockEntities() would for
+// the (2 * range + 1)^2 chunks around (pcx, pcz) and returns the chunk count.
+// The camera position only matters on the first Fill call of either kind.
+int FillBlockEntities(double camX, double camY, double camZ, int pcx, int pcz, int range,
+                      HelperBridge::BlockEntityFrame& frame);
+
+enum Stage {
+    kPlayerScan,   // frame -> player table -> g_playerList
+    kChestScan,    // frame -> chunk cache -> g_chestList
+    kProjection,   // batched Projection::Project calls of both overlays
+    kNametags,     // nametag cull, pick and draw (projection included)
+    kChestEsp,     // chest ESP cull, pick and draw (projection included)
+    kSerialize,    // state line / lcb1 frame for the loader
+    kStageCount
+};
+
+const char* StageName(int stage);
+
+// Counts one run of `stage`.  Safe from any thread.
+void Record(Stage stage, unsigned long long items, LONGLONG qpcTicks, unsigned long long bytes);
+
+// Per-stage rates since the previous call, then resets the counters.
+std::string FormatAndReset(DWORD nowMs);
+
+// Times its scope as one run of `stage`; nothing is recorded while the
+// synthetic load is off.
+class StageTimer {
+public:
+    explicit StageTimer(Stage stage);
+    ~StageTimer();
+
+    unsigned long long items;
+    unsigned long long bytes;
+
+private:
+    StageTimer(const StageTimer&);
+    StageTimer& operator=(const StageTimer&);
+
+    Stage _stage;
+    LONGLONG _start;   // 0 while inactive
+};
+
+} // namespace SyntheticLoad
+
+#define LC_SYNTH_STAGE(var, stage) SyntheticLoad::StageTimer var(stage)
+#define LC_SYNTH_ITEMS(var, n)     ((var).items += (unsigned long long)(n))
+#define LC_SYNTH_BYTES(var, n)     ((var).bytes += (unsigned long long)(n))
+
+#else
+
+#define LC_SYNTH_STAGE(var, stage) ((void)0)
+#define LC_SYNTH_ITEMS(var, n)     ((void)0)
+#define LC_SYNTH_BYTES(var, n)     ((void)0)
+
+#endif // LC_SYNTHETIC_LOAD
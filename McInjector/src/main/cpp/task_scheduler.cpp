@@ -0,0 +1,164 @@
+// task_scheduler.cpp
+#include "task_scheduler.h"
+
+#include <cstdio>
+
+namespace lc {
+
+TaskScheduler::TaskScheduler() : _cursorMs(NowUs() / 1000), _busyUs(0), _deferCurrent(false) {}
+
+unsigned long long TaskScheduler::NowUs() {
+    static LARGE_INTEGER s_freq = { { 0, 0 } };
+    if (s_freq.QuadPart == 0) QueryPerformanceFrequency(&s_freq);
+    LARGE_INTEGER c;
+    QueryPerformanceCounter(&c);
+    return (unsigned long long)(c.QuadPart / s_freq.QuadPart) * 1000000ULL
+        + (unsigned long long)(c.QuadPart % s_freq.QuadPart) * 1000000ULL / (unsigned long long)s_freq.QuadPart;
+}
+
+int TaskScheduler::Add(const char* name, DWORD periodMs, int priority, unsigned budgetUs, const std::function<void()>& run) {
+    Task t;
+    t.name = name;
+    t.periodMs = periodMs ? periodMs : 1;
+    t.priority = priority;
+    t.budgetUs = budgetUs;
+    t.run = run;
+    t.enabled = true;
+    t.dueMs = 0;
+    t.gen = 0;
+    t.ready = false;
+    t.busyUs = 0;
+    _tasks.push_back(t);
+    int id = (int)_tasks.size() - 1;
+    Schedule(id, NowUs() / 1000 + t.periodMs);
+    return id;
+}
+
+void TaskScheduler::SetPeriod(int id, DWORD periodMs) {
+    Task& t = _tasks[id];
+    if (!periodMs) periodMs = 1;
+    if (t.periodMs == periodMs) return;
+    t.periodMs = periodMs;
+    unsigned long long sooner = NowUs() / 1000 + periodMs;
+    if (!t.ready && sooner < t.dueMs) Schedule(id, sooner);
+}
+
+void TaskScheduler::SetEnabled(int id, bool enabled) {
+    _tasks[id].enabled = enabled;
+}
+
+void TaskScheduler::RunSoon(int id) {
+    if (!_tasks[id].ready) Schedule(id, NowUs() / 1000);
+}
+
+void TaskScheduler::Schedule(int id, unsigned long long dueMs) {
+    Task& t = _tasks[id];
+    t.dueMs = dueMs;
+    t.gen++;
+    if (dueMs <= _cursorMs) {
+        t.ready = true;
+        _ready.push_back(id);
+        return;
+    }
+    Entry e = { id, t.gen };
+    _wheel[dueMs % kWheelSlots].push_back(e);
+}
+
+void TaskScheduler::Advance(unsigned long long nowMs) {
+    if (nowMs <= _cursorMs) return;
+    unsigned long long steps = nowMs - _cursorMs;
+    if (steps > kWheelSlots) steps = kWheelSlots;   // a full turn visits every slot
+    for (unsigned long long s = 0; s < steps; s++) {
+        std::vector<Entry>& slot = _wheel[(nowMs - s) % kWheelSlots];
+        size_t kept = 0;
+        for (size_t i = 0; i < slot.size(); i++) {
+            Task& t = _tasks[slot[i].id];
+            if (slot[i].gen != t.gen) continue;   // rescheduled since
+            if (t.dueMs <= nowMs) {
+                t.ready = true;
+                _ready.push_back(slot[i].id);
+            } else {
+                slot[kept++] = slot[i];            // a later lap
+            }
+        }
+        slot.resize(kept);
+    }
+    _cursorMs = nowMs;
+}
+
+int TaskScheduler::PopReady() {
+    if (_ready.empty()) return -1;
+    size_t best = 0;
+    for (size_t i = 1; i < _ready.size(); i++) {
+        const Task& a = _tasks[_ready[i]];
+        const Task& b = _tasks[_ready[best]];
+        if (a.priority < b.priority || (a.priority == b.priority && a.dueMs < b.dueMs)) best = i;
+    }
+    int id = _ready[best];
+    _ready[best] = _ready.back();
+    _ready.pop_back();
+    _tasks[id].ready = false;
+    return id;
+}
+
+DWORD TaskScheduler::RunDue() {
+    unsigned long long nowMs = NowUs() / 1000;
+    Advance(nowMs);
+
+    for (int id = PopReady(); id >= 0; id = PopReady()) {
+        Task& t = _tasks[id];
+        unsigned long long startUs = NowUs();
+        _deferCurrent = false;
+        if (t.enabled) t.run();
+        unsigned long long endUs = NowUs();
+        nowMs = endUs / 1000;
+
+        unsigned long long next = t.dueMs + t.periodMs;
+        if (next <= nowMs) next = nowMs + t.periodMs;   // no catch-up bursts
+        if (t.enabled) {
+            unsigned us = (unsigned)(endUs - startUs);
+            t.stats.runs++;
+            t.stats.totalUs += us;
+            t.stats.lastUs = us;
+            t.busyUs += us;
+            _busyUs += us;
+            if (us > t.stats.maxUs) t.stats.maxUs = us;
+            unsigned long long deferMs = 0;
+            if (t.budgetUs && us > t.budgetUs) {
+                t.stats.overBudget++;
+                deferMs = (us - t.budgetUs) / 1000;
+            }
+            if (_deferCurrent) deferMs += t.periodMs;
+            unsigned long long capMs = 4ULL * t.periodMs;
+            next += deferMs < capMs ? deferMs : capMs;
+        }
+        Schedule(id, next);
+        Advance(nowMs);
+    }
+
+    unsigned long long soonest = nowMs + kMaxIdleMs;
+    for (size_t i = 0; i < _tasks.size(); i++)
+        if (_tasks[i].dueMs < soonest) soonest = _tasks[i].dueMs;
+    nowMs = NowUs() / 1000;
+    return soonest > nowMs ? (DWORD)(soonest - nowMs) : 0;
+}
+
+std::string TaskScheduler::FormatStats() const {
+    std::string out;
+    char buf[160];
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        const TaskStats& s = _tasks[i].stats;
+        if (!s.runs) continue;
+        snprintf(buf, sizeof(buf), "%s%s runs=%lu avg=%lluus max=%uus over=%lu",
+                 out.empty() ? "" : "; ", _tasks[i].name.c_str(), s.runs,
+                 s.totalUs / s.runs, s.maxUs, s.overBudget);
+        out += buf;
+    }
+    return out;
+}
+
+void TaskScheduler::ResetStats() {
+    for (size_t i = 0; i < _tasks.size(); i++) _tasks[i].stats = TaskStats();
+}
+
+} // namespace lc
@@ -0,0 +1,103 @@
+#pragma once
+// task_scheduler.h
+// Cooperative periodic tasks for one worker thread (the 26.1 scan thread).
+//
+// Each task has a period, a priority (lower runs first when several are due)
+// and a CPU budget per run.  Due times live on a hashed timer wheel with 1 ms
+// slots, so finding what is due costs the slots elapsed, not the task count.
+// After every run the wheel is checked again, so a cheap high-priority task
+// that came due while a slow one ran goes next instead of waiting for the
+// rest of the pass.  A run over budget pushes that task's next run back by
+// the overrun (at most 4 periods), which keeps a slow module's duty cycle
+// near budget / period.
+//
+// Tasks run on the thread that calls RunDue(); nothing here is thread-safe.
+
+#include <windows.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace lc {
+
+struct TaskStats {
+    unsigned long      runs;
+    unsigned long      overBudget;
+    unsigned long long totalUs;
+    unsigned           maxUs;
+    unsigned           lastUs;
+
+    TaskStats() : runs(0), overBudget(0), totalUs(0), maxUs(0), lastUs(0) {}
+};
+
+class TaskScheduler {
+public:
+    static const unsigned kWheelSlots = 128;   // 1 ms each
+    static const DWORD    kMaxIdleMs  = 50;    // RunDue() never asks to sleep longer
+
+    TaskScheduler();
+
+    // Registers a task, first due one period from now.  budgetUs 0 = unlimited.
+    int Add(const char* name, DWORD periodMs, int priority, unsigned budgetUs, const std::function<void()>& run);
+
+    // Changes the period; a shorter one takes effect immediately.
+    void SetPeriod(int id, DWORD periodMs);
+
+    // Disabled tasks keep their slot but are skipped when due.
+    void SetEnabled(int id, bool enabled);
+
+    // Makes the task due now (e.g. after a cache reset).
+    void RunSoon(int id);
+
+    // Called from inside a task's run: pushes its next run back one more
+    // period (within the same 4-period cap), e.g. when the run went over a
+    // budget the scheduler can't see such as JNI transitions.
+    void DeferCurrent() { _deferCurrent = true; }
+
+    // Runs every due task and returns the ms until the next one is due.
+    DWORD RunDue();
+
+    size_t Count() const { return _tasks.size(); }
+    const std::string& Name(int id) const { return _tasks[id].name; }
+    DWORD Period(int id) const { return _tasks[id].periodMs; }
+    const TaskStats& Stats(int id) const { return _tasks[id].stats; }
+
+    // Run time since construction, all tasks or one; unlike Stats() never
+    // reset, so callers can take deltas over their own intervals.
+    unsigned long long BusyUs() const { return _busyUs; }
+    unsigned long long BusyUs(int id) const { return _tasks[id].busyUs; }
+
+    // "name runs=N avg=Xus max=Yus over=Z" for each task that ran, "; "-separated.
+    std::string FormatStats() const;
+    void ResetStats();
+
+private:
+    struct Task {
+        std::string name;
+        DWORD       periodMs;
+        int         priority;
+        unsigned    budgetUs;
+        std::function<void()> run;
+        bool        enabled;
+        unsigned long long dueMs;
+        unsigned    gen;       // bumps on reschedule; older wheel entries are stale
+        bool        ready;
+        TaskStats   stats;
+        unsigned long long busyUs;
+    };
+    struct Entry { int id; unsigned gen; };
+
+    static unsigned long long NowUs();
+    void Schedule(int id, unsigned long long dueMs);
+    void Advance(unsigned long long nowMs);
+    int  PopReady();
+
+    std::vector<Task> _tasks;
+    std::vector<Entry> _wheel[kWheelSlots];
+    std::vector<int> _ready;
+    unsigned long long _cursorMs;   // every slot up to here has been collected
+    unsigned long long _busyUs;
+    bool _deferCurrent;
+};
+
+} // namespace lc
@@ -0,0 +1,110 @@
+// telemetry.cpp
+#include "telemetry.h"
+#include "frame_profiler.h"
+#include "json_config_reader.h"
+#include "scan_governor.h"
+#include "jni_core/ref_ledger.h"
+
+#include <cstdio>
+
+namespace lc {
+
+namespace {
+
+// Delta of a counter that ResetStats() may have zeroed since `prev`.
+template <typename T>
+T Since(T now, T prev) { return now >= prev ? now - prev : now; }
+
+double PerSecond(unsigned long long n, DWORD elapsedMs) {
+    return elapsedMs ? (double)n * 1000.0 / (double)elapsedMs : 0.0;
+}
+
+} // namespace
+
+TelemetrySampler::TelemetrySampler() {
+    Reset(GetTickCount());
+}
+
+bool TelemetrySampler::ParseRequest(const std::string& line, bool& on) {
+    if (line.find("\"telemetry\"") == std::string::npos) return false;
+    SimpleJsonConfigReader reader(line);
+    if (reader.GetString("type") != "telemetry") return false;
+    on = reader.GetString("state") != "off";
+    return true;
+}
+
+void TelemetrySampler::Reset(DWORD nowMs, unsigned long long bytesOut) {
+    _lastMs = nowMs;
+    _lastBytes = bytesOut;
+    for (int i = 0; i < JniAccounting::kMaxModules; i++) {
+        JniAccounting::ModuleStats s;
+        if (JniAccounting::Get(i, s)) {
+            _prev[i].calls = s.Transitions();
+            _prev[i].runs = s.runs;
+            _prev[i].us = s.totalUs;
+        } else {
+            _prev[i].calls = 0;
+            _prev[i].runs = 0;
+            _prev[i].us = 0;
+        }
+    }
+}
+
+std::string TelemetrySampler::Sample(DWORD nowMs, unsigned long long bytesOut, long snapshotLag, DWORD snapshotAgeMs) {
+    DWORD elapsed = nowMs - _lastMs;
+    if (elapsed == 0) elapsed = 1;
+
+    std::string out;
+    out.reserve(1024);
+    char buf[192];
+    snprintf(buf, sizeof(buf), "{\"type\":\"telemetry\",\"intervalMs\":%lu,\"modules\":[", (unsigned long)elapsed);
+    out += buf;
+
+    unsigned long long totalCalls = 0;
+    bool first = true;
+    for (int i = 0; i < JniAccounting::ModuleCount(); i++) {
+        JniAccounting::ModuleStats s;
+        if (!JniAccounting::Get(i, s)) continue;
+        unsigned long calls = Since(s.Transitions(), _prev[i].calls);
+        unsigned long runs = Since(s.runs, _prev[i].runs);
+        unsigned long long us = Since(s.totalUs, _prev[i].us);
+        _prev[i].calls = s.Transitions();
+        _prev[i].runs = s.runs;
+        _prev[i].us = s.totalUs;
+        totalCalls += calls;
+        if (!runs) continue;
+        // Module names are identifiers registered from string literals.
+        snprintf(buf, sizeof(buf), "%s{\"name\":\"%s\",\"runUs\":%.0f,\"jniCalls\":%.0f,\"runs\":%.1f}",
+                 first ? "" : ",", s.name, PerSecond(us, elapsed), PerSecond(calls, elapsed), PerSecond(runs, elapsed));
+        out += buf;
+        first = false;
+    }
+
+    unsigned long long bytes = Since(bytesOut, _lastBytes);
+    _lastBytes = bytesOut;
+    _lastMs = nowMs;
+
+    unsigned long weak = 0;
+    for (int i = 0; i < RefLedger::ModuleCount(); i++) {
+        RefLedger::ModuleStats r;
+        if (RefLedger::Get(i, r)) weak += r.liveWeak;
+    }
+
+    snprintf(buf, sizeof(buf),
+             "],\"jniCalls\":%.0f,\"bytesOut\":%.0f,\"snapshotLag\":%ld,\"snapshotAgeMs\":%lu,"
+             "\"globalRefs\":%lu,\"weakRefs\":%lu,\"frameMs\":%.2f",
+             PerSecond(totalCalls, elapsed), PerSecond(bytes, elapsed), snapshotLag < 0 ? 0L : snapshotLag,
+             (unsigned long)snapshotAgeMs, RefLedger::LiveTotal(), weak, FrameProfiler::GameFrameUs() / 1000.0);
+    out += buf;
+
+    SnapshotCell<GovernorStatus>::Ref gov = ScanGovernor::Published();
+    if (gov->running) {
+        snprintf(buf, sizeof(buf), ",\"governor\":{\"level\":%d,\"busyPct\":%.1f,\"pressured\":%s}",
+                 gov->level, gov->busyPct, gov->pressured ? "true" : "false");
+        out += buf;
+    }
+    out += "}\n";
+    return out;
+}
+
+} // namespace lc
@@ -0,0 +1,72 @@
+#pragma once
+// telemetry.h
+// The 1 Hz "telemetry" line both bridges send to the loader (announced as
+// "streams":["telemetry"] in the capabilities packet).
+//
+// The counters it reports already exist for the periodic log lines; this
+// turns them into per-second rates over the interval since the previous line
+// so the loader's Diagnostics tab can chart them:
+//   modules       per JniAccounting module: run time (us/s), JNI calls/s, runs/s
+//   jniCalls      all modules, calls/s
+//   bytesOut      bridge -> loader bytes/s, both transports
+//   snapshotLag   generations the consumer is behind the producer
+//   snapshotAgeMs age of the newest snapshot
+//   globalRefs    live RefLedger refs (strong + weak), weakRefs of those weak
+//   frameMs       game frame time (FrameProfiler::GameFrameUs)
+//   governor      26.1 scan governor level and scan-thread busy %, when running
+//
+// JniAccounting::ResetStats() (the 30 s log) may zero the counters between two
+// samples; a counter that went backwards counts from zero.
+//
+// The loader opts in with {"type":"telemetry","state":"on"} once it has seen
+// the stream in the capabilities; older loaders would take the line for state.
+//
+// Usage (socket thread):
+//   lc::TelemetrySampler telemetry;           // per connection
+//   if (lc::TelemetrySampler::ParseRequest(line, telemetryOn)) continue;
+//   if (telemetryOn && telemetry.Due(GetTickCount()))
+//       queue(telemetry.Sample(GetTickCount(), bytesOut, lag, ageMs));
+//
+// One sampler per thread; not thread-safe.
+
+#include "jni_core/jni_accounting.h"
+
+#include <windows.h>
+#include <string>
+
+namespace lc {
+
+class TelemetrySampler {
+public:
+    static const DWORD kIntervalMs = 1000;
+
+    TelemetrySampler();
+
+    // {"type":"telemetry","state":"on"|"off"} from the loader.  Returns false
+    // for any other packet.
+    static bool ParseRequest(const std::string& line, bool& on);
+
+    // True once kIntervalMs passed since the previous Sample().
+    bool Due(DWORD nowMs) const { return nowMs - _lastMs >= kIntervalMs; }
+
+    // Builds the telemetry line ("{...}\n") covering the time since the
+    // previous call.  bytesOut is the total sent so far on this connection.
+    std::string Sample(DWORD nowMs, unsigned long long bytesOut, long snapshotLag, DWORD snapshotAgeMs);
+
+    // Forgets the previous sample (new connection); the next line covers one
+    // interval from now.
+    void Reset(DWORD nowMs, unsigned long long bytesOut = 0);
+
+private:
+    struct ModulePrev {
+        unsigned long      calls;
+        unsigned long      runs;
+        unsigned long long us;
+    };
+
+    DWORD _lastMs;
+    unsigned long long _lastBytes;
+    ModulePrev _prev[JniAccounting::kMaxModules];
+};
+
+} // namespace lc
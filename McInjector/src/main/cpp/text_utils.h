@@ -0,0 +1,113 @@
+#pragma once
+// text_utils.h
+// Name and chat-text cleanup shared by both bridges (and the native bench).
+
+#include <cctype>
+#include <string>
+
+namespace lc {
+
+// Drops control characters, collapses whitespace runs to one space and trims.
+inline std::string NormalizeNameSpaces(const std::string& in)
+{
+    std::string out;
+    out.reserve(in.size());
+    bool wasSpace = false;
+    for (size_t i = 0; i < in.size(); i++) {
+        unsigned char c = (unsigned char)in[i];
+        if (c < 32) continue;
+        bool isSpace = std::isspace(c) != 0;
+        if (isSpace) {
+            if (!wasSpace && !out.empty()) out.push_back(' ');
+        } else {
+            out.push_back((char)c);
+        }
+        wasSpace = isSpace;
+    }
+    while (!out.empty() && out.back() == ' ') out.pop_back();
+    return out;
+}
+
+// Removes section-sign colour/format codes, in UTF-8 (C2 A7 x) or Latin-1 (A7 x).
+inline std::string StripMinecraftFormattingCodes(const std::string& in)
+{
+    std::string out;
+    out.reserve(in.size());
+    for (size_t i = 0; i < in.size(); i++) {
+        unsigned char c = (unsigned char)in[i];
+        if (c == 0xC2 && i + 2 < in.size() && (unsigned char)in[i + 1] == 0xA7) {
+            i += 2;
+            continue;
+        }
+        if (c == 0xA7) {
+            if (i + 1 < in.size()) i++;
+            continue;
+        }
+        out.push_back((char)c);
+    }
+    return out;
+}
+
+// 3-16 characters of [A-Za-z0-9_], the shape of an account name.
+inline bool IsLikelyProfileName(const std::string& name)
+{
+    if (name.size() < 3 || name.size() > 16) return false;
+    for (size_t i = 0; i < name.size(); i++) {
+        unsigned char c = (unsigned char)name[i];
+        if (std::isalnum(c) || c == '_') continue;
+        return false;
+    }
+    return true;
+}
+
+// True for a scoreboard line, separator or bot filler rather than a player.
+// `name` is already stripped of formatting codes and space-normalised; each
+// bridge strips with its own rules first.
+inline bool LooksLikeFakePlayerName(const std::string& name)
+{
+    if (name.empty()) return true;
+
+    bool anyAlnum = false;
+    bool anyNonDecor = false;
+    int alnumCount = 0;
+    for (size_t i = 0; i < name.size(); i++) {
+        char ch = name[i];
+        unsigned char c = (unsigned char)ch;
+        if (std::isalnum(c)) {
+            anyAlnum = true;
+            anyNonDecor = true;
+            alnumCount++;
+            continue;
+        }
+        if (ch == '_' || ch == ' ') {
+            anyNonDecor = true;
+            continue;
+        }
+        if (ch == '-' || ch == '=' || ch == '[' || ch == ']' || ch == '(' || ch == ')' || ch == '<' || ch == '>' || ch == '|' || ch == '*' || ch == '~' || ch == ':') {
+            continue;
+        }
+        anyNonDecor = true;
+    }
+
+    if (!anyNonDecor) return true;
+    if (!anyAlnum && name != "_") return true;
+    if (alnumCount < 2 && !IsLikelyProfileName(name)) return true;
+    return false;
+}
+
+inline void TrimNameWhitespace(std::string& s)
+{
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r' || s.back() == '\n')) s.pop_back();
+    size_t i = 0;
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n')) i++;
+    if (i > 0) s.erase(0, i);
+}
+
+// GameProfile name if it looks like a real account name, else "".
+inline std::string StableProfileName(std::string profileName)
+{
+    TrimNameWhitespace(profileName);
+    return IsLikelyProfileName(profileName) ? profileName : std::string();
+}
+
+} // namespace lc
@@ -0,0 +1,217 @@
+// thread_policy.cpp
+#include "thread_policy.h"
+#include "async_log.h"
+
+#include <windows.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace ThreadPolicy {
+
+namespace {
+
+enum Policy { POLICY_OFF, POLICY_BALANCED, POLICY_ECO };
+
+// Declared here rather than taken from <windows.h>: the MinGW headers only
+// carry these for recent _WIN32_WINNT values.
+struct CpuSetRecord {                       // SYSTEM_CPU_SET_INFORMATION, CpuSetInformation
+    DWORD   size;
+    DWORD   type;
+    DWORD   id;
+    WORD    group;
+    BYTE    logicalProcessorIndex;
+    BYTE    coreIndex;
+    BYTE    lastLevelCacheIndex;
+    BYTE    numaNodeIndex;
+    BYTE    efficiencyClass;
+    BYTE    allFlags;
+    DWORD   reserved;
+    ULONG64 allocationTag;
+};
+
+struct PowerThrottlingState {               // THREAD_POWER_THROTTLING_STATE
+    ULONG version;
+    ULONG controlMask;
+    ULONG stateMask;
+};
+
+const int   kThreadPowerThrottling = 3;     // THREAD_INFORMATION_CLASS
+const ULONG kThrottlingVersion = 1;
+const ULONG kThrottleExecutionSpeed = 0x1;
+
+typedef BOOL (WINAPI* GetSystemCpuSetInformationFn)(void*, ULONG, PULONG, HANDLE, ULONG);
+typedef BOOL (WINAPI* SetThreadSelectedCpuSetsFn)(HANDLE, const ULONG*, ULONG);
+typedef BOOL (WINAPI* SetThreadInformationFn)(HANDLE, int, LPVOID, DWORD);
+
+struct Placement {
+    int  priority;
+    bool ecoQos;
+};
+
+const Placement kBalanced[ROLE_COUNT] = {
+    { THREAD_PRIORITY_NORMAL,       false },    // ROLE_STATE
+    { THREAD_PRIORITY_NORMAL,       false },    // ROLE_NETWORK
+    { THREAD_PRIORITY_BELOW_NORMAL, true  },    // ROLE_SCAN
+    { THREAD_PRIORITY_LOWEST,       true  },    // ROLE_BACKGROUND
+};
+
+struct Setup {
+    Policy policy;
+    SetThreadSelectedCpuSetsFn setCpuSets;
+    SetThreadInformationFn     setInfo;
+    std::vector<ULONG> efficientIds;        // empty unless the CPU is hybrid
+    int  logicalCount;
+    int  minClass, maxClass;
+
+    Setup() : policy(POLICY_BALANCED), setCpuSets(nullptr), setInfo(nullptr),
+              logicalCount(0), minClass(0), maxClass(0) {
+        char env[16] = {};
+        if (GetEnvironmentVariableA("LC_THREAD_POLICY", env, sizeof(env)) > 0) {
+            if (env[0] == '0' || env[0] == 'n' || env[0] == 'N' || env[0] == 'f' || env[0] == 'F'
+                || _stricmp(env, "off") == 0)
+                policy = POLICY_OFF;
+            else if (_stricmp(env, "eco") == 0)
+                policy = POLICY_ECO;
+        }
+
+        HMODULE k32 = GetModuleHandleA("kernel32.dll");
+        GetSystemCpuSetInformationFn getCpuSets = nullptr;
+        if (k32) {
+            getCpuSets = (GetSystemCpuSetInformationFn)GetProcAddress(k32, "GetSystemCpuSetInformation");
+            setCpuSets = (SetThreadSelectedCpuSetsFn)GetProcAddress(k32, "SetThreadSelectedCpuSets");
+            setInfo    = (SetThreadInformationFn)GetProcAddress(k32, "SetThreadInformation");
+        }
+        if (!getCpuSets) return;
+
+        ULONG len = 0;
+        getCpuSets(nullptr, 0, &len, GetCurrentProcess(), 0);
+        if (!len) return;
+        std::vector<unsigned char> buf(len);
+        if (!getCpuSets(&buf[0], len, &len, GetCurrentProcess(), 0)) return;
+
+        std::vector<const CpuSetRecord*> sets;
+        for (ULONG off = 0; off + sizeof(DWORD) * 2 <= len; ) {
+            const CpuSetRecord* r = reinterpret_cast<const CpuSetRecord*>(&buf[off]);
+            if (r->size == 0) break;
+            if (r->type == 0 && off + sizeof(CpuSetRecord) <= len) sets.push_back(r);   // CpuSetInformation
+            off += r->size;
+        }
+        if (sets.empty()) return;
+        logicalCount = (int)sets.size();
+        minClass = maxClass = sets[0]->efficiencyClass;
+        for (size_t i = 1; i < sets.size(); i++) {
+            if (sets[i]->efficiencyClass < minClass) minClass = sets[i]->efficiencyClass;
+            if (sets[i]->efficiencyClass > maxClass) maxClass = sets[i]->efficiencyClass;
+        }
+        if (minClass == maxClass) return;
+        for (size_t i = 0; i < sets.size(); i++)
+            if (sets[i]->efficiencyClass == minClass) efficientIds.push_back(sets[i]->id);
+    }
+};
+
+Setup& Get() {
+    static Setup s_setup;
+    return s_setup;
+}
+
+const char* PriorityName(int priority) {
+    switch (priority) {
+        case THREAD_PRIORITY_LOWEST:       return "lowest";
+        case THREAD_PRIORITY_BELOW_NORMAL: return "below normal";
+        case THREAD_PRIORITY_NORMAL:       return "normal";
+        case THREAD_PRIORITY_ABOVE_NORMAL: return "above normal";
+        default:                           return "other";
+    }
+}
+
+struct SeenNames {
+    CRITICAL_SECTION cs;
+    std::vector<const char*> names;
+    SeenNames()  { InitializeCriticalSection(&cs); }
+    ~SeenNames() { DeleteCriticalSection(&cs); }
+};
+
+// Logs the topology once, then each thread name the first time it is placed.
+bool FirstTimeFor(const char* name) {
+    static SeenNames s_seen;
+    EnterCriticalSection(&s_seen.cs);
+    bool first = true;
+    for (size_t i = 0; i < s_seen.names.size() && first; i++)
+        if (std::strcmp(s_seen.names[i], name) == 0) first = false;
+    bool logTopology = s_seen.names.empty();
+    if (first) s_seen.names.push_back(name);
+    LeaveCriticalSection(&s_seen.cs);
+
+    if (logTopology) {
+        const Setup& s = Get();
+        char buf[224];
+        if (s.efficientIds.empty())
+            snprintf(buf, sizeof(buf), "ThreadPolicy: %s; %d logical processors, no efficiency cores to prefer%s",
+                     PolicyName(), s.logicalCount, s.setCpuSets ? "" : " (no CPU set API)");
+        else
+            snprintf(buf, sizeof(buf), "ThreadPolicy: %s; hybrid CPU, %u of %d logical processors in efficiency class %d (max %d)",
+                     PolicyName(), (unsigned)s.efficientIds.size(), s.logicalCount, s.minClass, s.maxClass);
+        AsyncLog::Write(AsyncLog::LEVEL_INFO, buf);
+    }
+    return first;
+}
+
+} // namespace
+
+const char* PolicyName() {
+    switch (Get().policy) {
+        case POLICY_OFF: return "off";
+        case POLICY_ECO: return "eco";
+        default:         return "balanced";
+    }
+}
+
+void Apply(Role role, const char* name) {
+    if (role < 0 || role >= ROLE_COUNT || !name) return;
+    const Setup& s = Get();
+    if (s.policy == POLICY_OFF) {
+        if (FirstTimeFor(name)) {
+            char buf[96];
+            snprintf(buf, sizeof(buf), "ThreadPolicy: %s left as created", name);
+            AsyncLog::Write(AsyncLog::LEVEL_INFO, buf);
+        }
+        return;
+    }
+
+    Placement p = kBalanced[role];
+    if (s.policy == POLICY_ECO) p.ecoQos = true;
+    HANDLE self = GetCurrentThread();
+
+    bool prioOk = SetThreadPriority(self, p.priority) != 0;
+
+    const char* qos = "unavailable";
+    if (s.setInfo) {
+        PowerThrottlingState st;
+        st.version = kThrottlingVersion;
+        st.controlMask = kThrottleExecutionSpeed;
+        st.stateMask = p.ecoQos ? kThrottleExecutionSpeed : 0;   // 0 with the bit controlled = opt out
+        if (s.setInfo(self, kThreadPowerThrottling, &st, sizeof(st)))
+            qos = p.ecoQos ? "on" : "off";
+        else
+            qos = "refused";
+    }
+
+    char cores[48];
+    if (s.efficientIds.empty()) {
+        snprintf(cores, sizeof(cores), "any core");
+    } else if (s.setCpuSets && s.setCpuSets(self, &s.efficientIds[0], (ULONG)s.efficientIds.size())) {
+        snprintf(cores, sizeof(cores), "%u efficiency cores", (unsigned)s.efficientIds.size());
+    } else {
+        snprintf(cores, sizeof(cores), "any core (CPU sets refused, err=%lu)", GetLastError());
+    }
+
+    if (FirstTimeFor(name)) {
+        char buf[192];
+        snprintf(buf, sizeof(buf), "ThreadPolicy: %s -> priority %s%s, EcoQoS %s, %s",
+                 name, PriorityName(p.priority), prioOk ? "" : " (refused)", qos, cores);
+        AsyncLog::Write(AsyncLog::LEVEL_INFO, buf);
+    }
+}
+
+} // namespace ThreadPolicy
@@ -0,0 +1,46 @@
+#pragma once
+// thread_policy.h
+// Priority, EcoQoS and efficiency-core placement for the threads the bridges
+// create.
+//
+// None of these threads is on the game's frame path, yet at default priority
+// Windows happily runs them on the performance cores the render and server
+// threads need.  Each thread places itself once, from inside the thread, by
+// role:
+//
+//   ROLE_STATE       per-frame state sampling   normal priority, no EcoQoS
+//   ROLE_NETWORK     loader TCP loop            normal priority, no EcoQoS
+//   ROLE_SCAN        module scan thread         below normal, EcoQoS
+//   ROLE_BACKGROUND  remap, class-scan helpers  lowest, EcoQoS
+//
+// On a hybrid CPU (more than one efficiency class) every role is also
+// restricted to the most efficient cores with SetThreadSelectedCpuSets; on
+// any other CPU that step is skipped.  The state and network roles stay out
+// of EcoQoS because the clicker reads their output against a freshness limit.
+//
+// LC_THREAD_POLICY picks the policy, read once:
+//   balanced (default)  the table above
+//   eco                 EcoQoS for every role as well
+//   off (or 0 / n / f)  leave every thread as Windows created it
+//
+// The APIs are resolved at run time, so on Windows builds without CPU sets or
+// thread power throttling the missing step is skipped and logged.  The first
+// Apply() per thread name logs what was chosen.
+
+namespace ThreadPolicy {
+
+enum Role {
+    ROLE_STATE = 0,
+    ROLE_NETWORK,
+    ROLE_SCAN,
+    ROLE_BACKGROUND,
+    ROLE_COUNT
+};
+
+// Places the calling thread.  `name` is a string literal used in the log.
+void Apply(Role role, const char* name);
+
+// "balanced", "eco" or "off".
+const char* PolicyName();
+
+} // namespace ThreadPolicy
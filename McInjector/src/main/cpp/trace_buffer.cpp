@@ -0,0 +1,138 @@
+// trace_buffer.cpp
+#include "trace_buffer.h"
+
+#if LC_TRACE_BUILD
+
+#include <windows.h>
+#include <cstdio>
+#include <cstring>
+
+namespace TraceBuffer {
+
+volatile long g_enabled = 0;
+
+namespace {
+
+const LONG kMaxSites   = 1024;
+const LONG kMaxRings   = 32;
+const LONG kRingEvents = 4096;   // power of two
+
+#pragma pack(push, 1)
+struct Event {
+    unsigned short     site;
+    unsigned short     ring;
+    unsigned int       value;
+    unsigned long long qpc;
+};
+#pragma pack(pop)
+
+struct Site {
+    char        kind;
+    const char* function;
+    const char* name;
+    int         line;
+};
+
+struct Ring {
+    volatile LONG head;              // events written (owner thread only)
+    DWORD         threadId;
+    Event         events[kRingEvents];
+};
+
+Site          s_sites[kMaxSites];
+volatile LONG s_siteCount = 0;
+Ring*         s_rings[kMaxRings];
+volatile LONG s_ringCount = 0;
+
+DWORD TlsSlot() {
+    static DWORD s_slot = TlsAlloc();
+    return s_slot;
+}
+
+// Ring for the calling thread, created on first use.  nullptr once all
+// kMaxRings are taken (extra threads are simply not traced).
+Ring* ThreadRing(unsigned short& index) {
+    DWORD slot = TlsSlot();
+    if (slot == TLS_OUT_OF_INDEXES) return nullptr;
+    LONG_PTR v = (LONG_PTR)TlsGetValue(slot);
+    if (v == -1) return nullptr;
+    if (v == 0) {
+        LONG i = InterlockedIncrement(&s_ringCount) - 1;
+        if (i >= kMaxRings) { TlsSetValue(slot, (LPVOID)(LONG_PTR)-1); return nullptr; }
+        Ring* r = new Ring;
+        r->head = 0;
+        r->threadId = GetCurrentThreadId();
+        InterlockedExchangePointer((PVOID volatile*)&s_rings[i], r);
+        v = i + 1;
+        TlsSetValue(slot, (LPVOID)v);
+    }
+    index = (unsigned short)(v - 1);
+    return s_rings[v - 1];
+}
+
+} // namespace
+
+void SetEnabled(bool on) {
+    InterlockedExchange(&g_enabled, on ? 1 : 0);
+}
+
+unsigned short RegisterSite(char kind, const char* function, const char* name, int line) {
+    LONG id = InterlockedIncrement(&s_siteCount) - 1;
+    if (id >= kMaxSites) return (unsigned short)0xFFFF;
+    s_sites[id].kind = kind;
+    s_sites[id].function = function;
+    s_sites[id].name = name;
+    s_sites[id].line = line;
+    return (unsigned short)id;
+}
+
+void Record(unsigned short site, unsigned int value) {
+    if (site == 0xFFFF) return;
+    unsigned short ringIndex = 0;
+    Ring* r = ThreadRing(ringIndex);
+    if (!r) return;
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    Event& e = r->events[(unsigned long)r->head & (kRingEvents - 1)];
+    e.site = site;
+    e.ring = ringIndex;
+    e.value = value;
+    e.qpc = (unsigned long long)now.QuadPart;
+    r->head = r->head + 1;
+}
+
+bool Dump(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    LONG sites = InterlockedCompareExchange(&s_siteCount, 0, 0);
+    if (sites > kMaxSites) sites = kMaxSites;
+    LONG rings = InterlockedCompareExchange(&s_ringCount, 0, 0);
+    if (rings > kMaxRings) rings = kMaxRings;
+
+    std::fprintf(f, "LCTRACE1\nqpc_freq=%lld\nsites=%ld\n", (long long)freq.QuadPart, (long)sites);
+    for (LONG i = 0; i < sites; i++) {
+        const Site& s = s_sites[i];
+        std::fprintf(f, "%ld\t%c\t%s\t%s\t%d\n", (long)i, s.kind ? s.kind : '?',
+                     s.function ? s.function : "?", s.name ? s.name : "?", s.line);
+    }
+    std::fprintf(f, "rings=%ld\n", (long)rings);
+    for (LONG i = 0; i < rings; i++) {
+        Ring* r = (Ring*)InterlockedCompareExchangePointer((PVOID volatile*)&s_rings[i], nullptr, nullptr);
+        if (!r) { std::fprintf(f, "ring\t%ld\t0\t0\n", (long)i); continue; }
+        LONG head = r->head;
+        LONG count = head < kRingEvents ? head : kRingEvents;
+        std::fprintf(f, "ring\t%ld\t%lu\t%ld\n", (long)i, (unsigned long)r->threadId, (long)count);
+        for (LONG k = head - count; k < head; k++) {
+            std::fwrite(&r->events[(unsigned long)k & (kRingEvents - 1)], sizeof(Event), 1, f);
+        }
+    }
+    std::fclose(f);
+    return true;
+}
+
+} // namespace TraceBuffer
+
+#endif // LC_TRACE_BUILD
@@ -0,0 +1,66 @@
+#pragma once
+// trace_buffer.h
+// Binary trace buffer behind the bridges' TRACE macros.
+//
+// Release builds (the default) leave LC_TRACE_BUILD at 0 and the bridges'
+// TRACE macros expand to nothing (TRACE_IF to its expression), so hot paths
+// build no strings and test no flags.
+//
+// Trace builds (`build.bat trace`, i.e. -DLC_TRACE_BUILD=1) record a fixed
+// 16-byte event {site id, ring, value, QPC timestamp} into a per-thread ring
+// while the runtime switch (LC_BRIDGE_TRACE) is on.  Each call site registers
+// once, on first hit.  Dump() writes the site table and every ring to a file;
+// McInjector/tools/trace_decode.py turns that into text.
+//
+// Usage (trace builds only):
+//   TraceBuffer::SetEnabled(true);
+//   LC_TRACE_EVENT('B', "clientAccepted", ok ? 1 : 0);
+//   TraceBuffer::Dump(dir + "\\bridge_trace.bin");
+
+#ifndef LC_TRACE_BUILD
+#define LC_TRACE_BUILD 0
+#endif
+
+#if LC_TRACE_BUILD
+
+#include <string>
+
+namespace TraceBuffer {
+
+extern volatile long g_enabled;
+
+inline bool Enabled() { return g_enabled != 0; }
+void SetEnabled(bool on);
+
+// kind: 'P' path, 'B' branch/decision.  `function` and `name` must outlive the
+// process (string literals / __FUNCTION__).  Returns the site id.
+unsigned short RegisterSite(char kind, const char* function, const char* name, int line);
+
+void Record(unsigned short site, unsigned int value);
+
+// Write sites + rings to `path`.  Safe to call while other threads record;
+// events being written during the copy may be torn.
+bool Dump(const std::string& path);
+
+} // namespace TraceBuffer
+
+#define LC_TRACE_EVENT_FN(fn, kind, name, value)                                       \
+    do {                                                                               \
+        if (TraceBuffer::Enabled()) {                                                  \
+            static const unsigned short lcTraceSite_ =                                 \
+                TraceBuffer::RegisterSite((kind), (fn), (name), __LINE__);             \
+            TraceBuffer::Record(lcTraceSite_, (unsigned int)(value));                  \
+        }                                                                              \
+    } while (0)
+
+#define LC_TRACE_EVENT(kind, name, value) LC_TRACE_EVENT_FN(__FUNCTION__, kind, name, value)
+
+// Evaluates `expr` once, records it as a branch event, yields it.
+#define LC_TRACE_DECISION(name, expr)                                                  \
+    ([&](const char* lcTraceFn_) -> bool {                                             \
+        bool lcTraceV_ = (expr);                                                       \
+        LC_TRACE_EVENT_FN(lcTraceFn_, 'B', (name), lcTraceV_ ? 1u : 0u);               \
+        return lcTraceV_;                                                              \
+    }(__FUNCTION__))
+
+#endif // LC_TRACE_BUILD
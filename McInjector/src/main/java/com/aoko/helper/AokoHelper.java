@@ -5,6 +5,7 @@ import java.lang.reflect.Method;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.util.List;
+import java.util.Map;
 
 /**
  * AokoHelper - injected into the game JVM at runtime.
@@ -23,6 +24,56 @@ import java.util.List;
  *
  * Total fixed part: 32 bytes + variable name.
  * The native side pre-allocates a large enough direct ByteBuffer.
+ *
+ * Wide entity frame layout (little-endian): a header, maxEntities fixed-stride
+ * records, then a string pool.
+ *   int count      records written
+ *   int poolStart  byte offset of the string pool (8 + entities.length * 80)
+ *   count x record (WIDE_STRIDE = 80 bytes):
+ *     int    index       position in the entities array
+ *     int    entityId    Entity.getId(), -1 if unavailable
+ *     double x, y, z
+ *     float  health
+ *     int    armor
+ *     int    heldDamage, heldMaxDamage
+ *     int    nameOff, nameLen         display name (getName().getString())
+ *     int    profileOff, profileLen   GameProfile name
+ *     int    heldOff, heldLen         held item display name
+ *     int    teamOff, teamLen         scoreboard team name
+ *   String offsets are relative to poolStart; UTF-8, no terminator.  A string
+ *   that does not fit in the buffer is written with length 0.
+ *
+ * Legacy (1.8.9) entity frame: same header and pool as the wide frame,
+ * records of LEGACY_STRIDE = 80 bytes:
+ *     int    index       position in the entity list
+ *     int    hash        Object.hashCode() (stable per entity; nametag smoothing key)
+ *     double posX, posY, posZ
+ *     double lastTickPosX, lastTickPosY, lastTickPosZ
+ *     float  health
+ *     int    armor       getTotalArmorValue(), -1 if unavailable
+ *     int    nameOff, nameLen         getName()
+ *     int    profileOff, profileLen   GameProfile name
+ *
+ * Legacy tile-entity frame: the block-entity layout with a single chunk
+ * header covering the whole loadedTileEntityList.
+ *
+ * Block-entity frame layout (little-endian), one header per chunk of the scan
+ * window in dx-major order, each followed by its records:
+ *   int count    (records that follow; -1 chunk not loaded, -2 walk failed)
+ *   int scanned  (block entities looked at)
+ *   count x { int x; int y; int z; int kind }   (16 bytes, kind = index into kinds[])
+ *
+ * Inventory frame layout (little-endian), written by collectInventory:
+ *   int slots    Inventory.getContainerSize()
+ *   (slots + 1) x record (INV_STRIDE = 12 bytes), the last one for the offhand:
+ *     int kind    index into kinds[] of the stack's item, INV_OTHER, or INV_EMPTY
+ *     int itemId  System.identityHashCode of the Item, 0 when empty
+ *     int count   ItemStack.getCount(), 0 when empty
+ *
+ * Nametag-hide result layout (little-endian), written by applyNametagHide:
+ *   int count      joins processed
+ *   int poolStart  byte offset of the string pool (8 + joins.length * 12)
+ *   count x { int status; int teamOff; int teamLen }   (NT_STATUS_*, server team name)
  */
 public final class AokoHelper {
 
@@ -134,4 +185,601 @@ public final class AokoHelper {
         out.flip(); // limit = written bytes, position = 0
         return count;
     }
+
+    /** Indices into the handles[] array of collectEntityFrameWide. */
+    public static final int H_GET_X = 0, H_GET_Y = 1, H_GET_Z = 2, H_GET_HEALTH = 3, H_GET_ARMOR = 4,
+            H_MAIN_HAND = 5, H_STACK_NAME = 6, H_STACK_DAMAGE = 7, H_STACK_MAX_DAMAGE = 8,
+            H_GET_NAME = 9, H_TEXT_STRING = 10, H_GAME_PROFILE = 11, H_PROFILE_NAME = 12,
+            H_GET_ID = 13, H_HOLDER_TEAM = 14, H_TEAM_NAME = 15, H_COUNT = 16;
+
+    public static final int WIDE_STRIDE = 80;
+
+    /**
+     * Pack position, health, armor, held item, id, names and team for every
+     * entity into fixed-stride records plus a string pool (layout above).
+     *
+     * @param entities    entity array (e.g. world players list toArray())
+     * @param selfEntity  local player to skip (may be null)
+     * @param handles     Method[H_COUNT]; only the getX/Y/Z entries are required
+     * @param scoreboard  world scoreboard for H_HOLDER_TEAM (may be null)
+     * @param out         Direct ByteBuffer owned by native; position=0 on entry
+     * @return number of records written, or -1 if the record area did not fit
+     */
+    public static int collectEntityFrameWide(
+            Object[]   entities,
+            Object     selfEntity,
+            Method[]   handles,
+            Object     scoreboard,
+            ByteBuffer out) {
+
+        out.order(ByteOrder.LITTLE_ENDIAN);
+        out.clear();
+        if (entities == null || handles == null || handles.length < H_COUNT) return -1;
+        Method mX = handles[H_GET_X], mY = handles[H_GET_Y], mZ = handles[H_GET_Z];
+        if (mX == null || mY == null || mZ == null) return -1;
+
+        int poolStart = 8 + entities.length * WIDE_STRIDE;
+        if (poolStart > out.capacity()) return -1;
+        out.position(poolStart);
+
+        int count = 0;
+        for (int i = 0; i < entities.length; i++) {
+            Object e = entities[i];
+            if (e == null || e == selfEntity) continue;
+
+            double x, y, z;
+            try {
+                x = (Double) mX.invoke(e);
+                y = (Double) mY.invoke(e);
+                z = (Double) mZ.invoke(e);
+            } catch (Exception ex) {
+                continue;
+            }
+
+            float health = 20.0f;
+            Object v = call(handles[H_GET_HEALTH], e);
+            if (v instanceof Float) health = (Float) v;
+            int armor = 0;
+            v = call(handles[H_GET_ARMOR], e);
+            if (v instanceof Integer) armor = (Integer) v;
+            int entityId = -1;
+            v = call(handles[H_GET_ID], e);
+            if (v instanceof Integer) entityId = (Integer) v;
+
+            int heldDamage = 0, heldMaxDamage = 0;
+            String held = null;
+            Object stack = call(handles[H_MAIN_HAND], e);
+            if (stack != null) {
+                held = text(call(handles[H_STACK_NAME], stack), handles[H_TEXT_STRING]);
+                v = call(handles[H_STACK_DAMAGE], stack);
+                if (v instanceof Integer) heldDamage = (Integer) v;
+                v = call(handles[H_STACK_MAX_DAMAGE], stack);
+                if (v instanceof Integer) heldMaxDamage = (Integer) v;
+            }
+
+            String name = text(call(handles[H_GET_NAME], e), handles[H_TEXT_STRING]);
+            String profile = null;
+            Object gp = call(handles[H_GAME_PROFILE], e);
+            if (gp != null) {
+                v = call(handles[H_PROFILE_NAME], gp);
+                if (v instanceof String) profile = (String) v;
+            }
+            String team = null;
+            if (scoreboard != null && profile != null && handles[H_HOLDER_TEAM] != null) {
+                try {
+                    Object t = handles[H_HOLDER_TEAM].invoke(scoreboard, profile);
+                    v = call(handles[H_TEAM_NAME], t);
+                    if (v instanceof String) team = (String) v;
+                } catch (Exception ex) { /* no team */ }
+            }
+
+            int rec = 8 + count * WIDE_STRIDE;
+            out.putInt(rec, i);
+            out.putInt(rec + 4, entityId);
+            out.putDouble(rec + 8, x);
+            out.putDouble(rec + 16, y);
+            out.putDouble(rec + 24, z);
+            out.putFloat(rec + 32, health);
+            out.putInt(rec + 36, armor);
+            out.putInt(rec + 40, heldDamage);
+            out.putInt(rec + 44, heldMaxDamage);
+            putPooled(out, rec + 48, poolStart, name);
+            putPooled(out, rec + 56, poolStart, profile);
+            putPooled(out, rec + 64, poolStart, held);
+            putPooled(out, rec + 72, poolStart, team);
+            count++;
+        }
+
+        out.putInt(0, count);
+        out.putInt(4, poolStart);
+        out.flip(); // limit = end of pool, position = 0
+        return count;
+    }
+
+    private static Object call(Method m, Object target) {
+        if (m == null || target == null) return null;
+        try {
+            return m.invoke(target);
+        } catch (Exception ex) {
+            return null;
+        }
+    }
+
+    private static String text(Object textObj, Method mGetString) {
+        if (textObj == null) return null;
+        if (textObj instanceof String) return (String) textObj;
+        try {
+            if (mGetString != null) return (String) mGetString.invoke(textObj);
+            return (String) textObj.getClass().getMethod("getString").invoke(textObj);
+        } catch (Exception ex) {
+            return textObj.toString();
+        }
+    }
+
+    /** Append s to the pool at the current position and store {off, len} at slot. */
+    private static void putPooled(ByteBuffer out, int slot, int poolStart, String s) {
+        int off = out.position() - poolStart, len = 0;
+        if (s != null && !s.isEmpty()) {
+            byte[] b = s.getBytes(java.nio.charset.StandardCharsets.UTF_8);
+            if (out.remaining() >= b.length) {
+                out.put(b);
+                len = b.length;
+            }
+        }
+        out.putInt(slot, off);
+        out.putInt(slot + 4, len);
+    }
+
+    /** Indices into the fields[] / methods[] arrays of collectLegacyEntityFrame. */
+    public static final int LF_POS_X = 0, LF_POS_Y = 1, LF_POS_Z = 2,
+            LF_LAST_X = 3, LF_LAST_Y = 4, LF_LAST_Z = 5, LF_COUNT = 6;
+    public static final int LM_GET_HEALTH = 0, LM_GET_ARMOR = 1, LM_GET_NAME = 2,
+            LM_GAME_PROFILE = 3, LM_PROFILE_NAME = 4, LM_COUNT = 5;
+
+    public static final int LEGACY_STRIDE = 80;
+
+    /**
+     * 1.8.9 entity frame: positions come from the posX/lastTickPosX fields the
+     * legacy bridge resolves from its descriptor tables (mappings_18.h).
+     *
+     * @param entities    World.playerEntities
+     * @param selfEntity  local player to skip (may be null)
+     * @param fields      Field[LF_COUNT]; the posX/Y/Z entries are required,
+     *                    lastTickPos entries fall back to pos
+     * @param methods     Method[LM_COUNT]; entries may be null
+     * @param out         Direct ByteBuffer owned by native; position=0 on entry
+     * @return number of records written, or -1 if the record area did not fit
+     */
+    public static int collectLegacyEntityFrame(
+            List<?>    entities,
+            Object     selfEntity,
+            Field[]    fields,
+            Method[]   methods,
+            ByteBuffer out) {
+
+        out.order(ByteOrder.LITTLE_ENDIAN);
+        out.clear();
+        if (entities == null || fields == null || fields.length < LF_COUNT
+                || methods == null || methods.length < LM_COUNT) return -1;
+        Field fX = fields[LF_POS_X], fY = fields[LF_POS_Y], fZ = fields[LF_POS_Z];
+        if (fX == null || fY == null || fZ == null) return -1;
+        try {
+            for (Field f : fields) if (f != null) f.setAccessible(true);
+        } catch (RuntimeException ex) {
+            return -1;
+        }
+
+        Object[] arr;
+        try {
+            arr = entities.toArray();
+        } catch (RuntimeException ex) {
+            return -1;   // list mutated while copying
+        }
+        int poolStart = 8 + arr.length * LEGACY_STRIDE;
+        if (poolStart > out.capacity()) return -1;
+        out.position(poolStart);
+
+        int count = 0;
+        for (int i = 0; i < arr.length; i++) {
+            Object e = arr[i];
+            if (e == null || e == selfEntity) continue;
+
+            double x, y, z, lx, ly, lz;
+            try {
+                x = fX.getDouble(e);
+                y = fY.getDouble(e);
+                z = fZ.getDouble(e);
+                lx = fields[LF_LAST_X] != null ? fields[LF_LAST_X].getDouble(e) : x;
+                ly = fields[LF_LAST_Y] != null ? fields[LF_LAST_Y].getDouble(e) : y;
+                lz = fields[LF_LAST_Z] != null ? fields[LF_LAST_Z].getDouble(e) : z;
+            } catch (Exception ex) {
+                continue;
+            }
+
+            float health = 20.0f;
+            Object v = call(methods[LM_GET_HEALTH], e);
+            if (v instanceof Float) health = (Float) v;
+            int armor = -1;
+            v = call(methods[LM_GET_ARMOR], e);
+            if (v instanceof Integer) armor = (Integer) v;
+            v = call(methods[LM_GET_NAME], e);
+            String name = v instanceof String ? (String) v : null;
+            String profile = null;
+            Object gp = call(methods[LM_GAME_PROFILE], e);
+            if (gp != null) {
+                v = call(methods[LM_PROFILE_NAME], gp);
+                if (v instanceof String) profile = (String) v;
+            }
+
+            int rec = 8 + count * LEGACY_STRIDE;
+            out.putInt(rec, i);
+            out.putInt(rec + 4, e.hashCode());
+            out.putDouble(rec + 8, x);
+            out.putDouble(rec + 16, y);
+            out.putDouble(rec + 24, z);
+            out.putDouble(rec + 32, lx);
+            out.putDouble(rec + 40, ly);
+            out.putDouble(rec + 48, lz);
+            out.putFloat(rec + 56, health);
+            out.putInt(rec + 60, armor);
+            putPooled(out, rec + 64, poolStart, name);
+            putPooled(out, rec + 72, poolStart, profile);
+            count++;
+        }
+
+        out.putInt(0, count);
+        out.putInt(4, poolStart);
+        out.flip();
+        return count;
+    }
+
+    /**
+     * 1.8.9 chest scan over World.loadedTileEntityList.  A tile entity matches
+     * kinds[k] by instanceof, or kinds.length when its class name contains
+     * "Chest" (the legacy bridge's name fallback).
+     *
+     * @param tiles   World.loadedTileEntityList
+     * @param kinds   tile-entity classes to report; entries may be null
+     * @param fPos    Field: TileEntity.pos (BlockPos)
+     * @param mPosX   Method: BlockPos.getX()
+     * @param mPosY   Method: BlockPos.getY()
+     * @param mPosZ   Method: BlockPos.getZ()
+     * @param out     Direct ByteBuffer owned by native; position=0 on entry
+     * @return 1 (one chunk header), or -1 if the frame did not fit
+     */
+    public static int collectLegacyTileEntities(
+            List<?>    tiles,
+            Class<?>[] kinds,
+            Field      fPos,
+            Method     mPosX,
+            Method     mPosY,
+            Method     mPosZ,
+            ByteBuffer out) {
+
+        out.order(ByteOrder.LITTLE_ENDIAN);
+        out.clear();
+        if (tiles == null || kinds == null || fPos == null
+                || mPosX == null || mPosY == null || mPosZ == null) return -1;
+        try {
+            fPos.setAccessible(true);
+        } catch (RuntimeException ex) {
+            return -1;
+        }
+        Object[] arr;
+        try {
+            arr = tiles.toArray();
+        } catch (RuntimeException ex) {
+            return -1;
+        }
+
+        out.putInt(0);
+        out.putInt(arr.length);
+        int count = 0;
+        for (Object te : arr) {
+            if (te == null) continue;
+            int kind = -1;
+            for (int k = 0; k < kinds.length; k++) {
+                if (kinds[k] != null && kinds[k].isInstance(te)) { kind = k; break; }
+            }
+            if (kind < 0 && te.getClass().getName().contains("Chest")) kind = kinds.length;
+            if (kind < 0) continue;
+            int x, y, z;
+            try {
+                Object pos = fPos.get(te);
+                if (pos == null) continue;
+                x = (Integer) mPosX.invoke(pos);
+                y = (Integer) mPosY.invoke(pos);
+                z = (Integer) mPosZ.invoke(pos);
+            } catch (Exception ex) {
+                continue;
+            }
+            if (out.remaining() < 16) return -1;
+            out.putInt(x);
+            out.putInt(y);
+            out.putInt(z);
+            out.putInt(kind);
+            count++;
+        }
+        out.putInt(0, count);
+        out.flip();
+        return 1;
+    }
+
+    /**
+     * Walk the block-entity maps of a (2*range+1)^2 chunk window and pack the
+     * positions of block entities matching one of kinds[] into a direct ByteBuffer.
+     *
+     * @param world           the client world
+     * @param mGetChunk       Method: World.getChunk(int, int)
+     * @param centerX         chunk x of the window centre
+     * @param centerZ         chunk z of the window centre
+     * @param range           window half-size in chunks
+     * @param fBlockEntities  Field: Chunk.blockEntities (Map&lt;BlockPos, BlockEntity&gt;)
+     * @param kinds           block-entity classes to report; entries may be null
+     * @param fPosX           Field: BlockPos/Vec3i x (int)
+     * @param fPosY           Field: BlockPos/Vec3i y (int)
+     * @param fPosZ           Field: BlockPos/Vec3i z (int)
+     * @param out             Direct ByteBuffer owned by native; position=0 on entry
+     * @return number of chunk headers written, or -1 if the frame did not fit
+     */
+    public static int collectBlockEntities(
+            Object   world,
+            Method   mGetChunk,
+            int      centerX,
+            int      centerZ,
+            int      range,
+            Field    fBlockEntities,
+            Class<?>[] kinds,
+            Field    fPosX,
+            Field    fPosY,
+            Field    fPosZ,
+            ByteBuffer out) {
+
+        out.order(ByteOrder.LITTLE_ENDIAN);
+        out.clear();
+        try {
+            mGetChunk.setAccessible(true);
+            fBlockEntities.setAccessible(true);
+            fPosX.setAccessible(true);
+            fPosY.setAccessible(true);
+            fPosZ.setAccessible(true);
+        } catch (RuntimeException ex) {
+            return -1;
+        }
+
+        int chunks = 0;
+        for (int dx = -range; dx <= range; dx++) {
+            for (int dz = -range; dz <= range; dz++) {
+                if (out.remaining() < 8) return -1;
+                int header = out.position();
+                out.putInt(-1);
+                out.putInt(0);
+                chunks++;
+
+                Map<?, ?> map;
+                try {
+                    Object chunk = mGetChunk.invoke(world, centerX + dx, centerZ + dz);
+                    if (chunk == null) continue;
+                    map = (Map<?, ?>) fBlockEntities.get(chunk);
+                } catch (Exception ex) {
+                    continue;
+                }
+                if (map == null) continue;
+
+                int count = 0, scanned = 0;
+                try {
+                    // The game thread may mutate the map while we walk it; a
+                    // failed walk is reported per chunk and rewound.
+                    for (Map.Entry<?, ?> e : map.entrySet()) {
+                        Object be = e.getValue();
+                        if (be == null) continue;
+                        scanned++;
+                        int kind = -1;
+                        for (int k = 0; k < kinds.length; k++) {
+                            if (kinds[k] != null && kinds[k].isInstance(be)) { kind = k; break; }
+                        }
+                        if (kind < 0) continue;
+                        Object pos = e.getKey();
+                        int x, y, z;
+                        try {
+                            x = fPosX.getInt(pos);
+                            y = fPosY.getInt(pos);
+                            z = fPosZ.getInt(pos);
+                        } catch (Exception ex) {
+                            continue;
+                        }
+                        if (out.remaining() < 16) return -1;
+                        out.putInt(x);
+                        out.putInt(y);
+                        out.putInt(z);
+                        out.putInt(kind);
+                        count++;
+                    }
+                } catch (RuntimeException ex) {
+                    out.position(header + 8);
+                    count = -2;
+                }
+                out.putInt(header, count);
+                out.putInt(header + 4, scanned);
+            }
+        }
+
+        out.flip();
+        return chunks;
+    }
+
+    /** Indices into the Method[] passed to collectInventory. */
+    public static final int INV_GET_SIZE = 0, INV_GET_ITEM = 1, INV_GET_OFFHAND = 2,
+                            INV_STACK_ITEM = 3, INV_STACK_COUNT = 4, INV_STACK_EMPTY = 5;
+    public static final int INV_STRIDE = 12;
+    public static final int INV_OTHER = -1, INV_EMPTY = -2;
+
+    /**
+     * Pack every inventory slot plus the offhand into a direct ByteBuffer, so the
+     * native side can keep a snapshot and only come back when the inventory
+     * changed.
+     *
+     * @param inventory  Player.getInventory()
+     * @param player     the local player (offhand); may be null
+     * @param handles    Method[]: getContainerSize, getItem(int), getOffhandItem,
+     *                   ItemStack.getItem, ItemStack.getCount, ItemStack.isEmpty;
+     *                   the offhand and isEmpty entries may be null
+     * @param kinds      Item objects to classify by identity; entries may be null
+     * @param out        Direct ByteBuffer owned by native; position=0 on entry
+     * @return number of slots written (excluding the offhand record), or -1
+     */
+    public static int collectInventory(
+            Object     inventory,
+            Object     player,
+            Method[]   handles,
+            Object[]   kinds,
+            ByteBuffer out) {
+
+        out.order(ByteOrder.LITTLE_ENDIAN);
+        out.clear();
+        if (inventory == null || handles == null || handles.length <= INV_STACK_EMPTY || kinds == null
+                || handles[INV_GET_SIZE] == null || handles[INV_GET_ITEM] == null
+                || handles[INV_STACK_ITEM] == null || handles[INV_STACK_COUNT] == null) return -1;
+
+        int slots;
+        try {
+            slots = (Integer) handles[INV_GET_SIZE].invoke(inventory);
+        } catch (Exception ex) {
+            return -1;
+        }
+        if (slots < 0 || out.remaining() < 4 + (slots + 1) * INV_STRIDE) return -1;
+
+        out.putInt(slots);
+        for (int i = 0; i < slots; i++) {
+            Object stack;
+            try {
+                stack = handles[INV_GET_ITEM].invoke(inventory, i);
+            } catch (Exception ex) {
+                stack = null;
+            }
+            putStack(stack, handles, kinds, out);
+        }
+        Object offhand = null;
+        if (player != null && handles[INV_GET_OFFHAND] != null) {
+            try {
+                offhand = handles[INV_GET_OFFHAND].invoke(player);
+            } catch (Exception ex) {
+                offhand = null;
+            }
+        }
+        putStack(offhand, handles, kinds, out);
+
+        out.flip();
+        return slots;
+    }
+
+    /** Indices into the Method[] passed to applyNametagHide. */
+    public static final int NT_HOLDER_TEAM = 0, NT_ADD_HOLDER = 1, NT_REMOVE_HOLDER = 2,
+                            NT_TEAM_NAME = 3, NT_GET_VISIBILITY = 4, NT_SET_VISIBILITY = 5, NT_COUNT = 6;
+    public static final int NT_STATUS_FAILED = 0, NT_STATUS_HIDE_TEAM = 1, NT_STATUS_SERVER_TEAM = 2;
+
+    /**
+     * Apply one pass of client-side nametag hiding: joins are hidden, leaves
+     * are taken back off the hide team.  A join already on a server team keeps
+     * that team and has the team's nametag visibility set to never instead;
+     * the visibility it had before is stored in originals[i] so the native
+     * side can restore it.
+     *
+     * @param scoreboard  the world scoreboard
+     * @param hideTeam    the client-only hide team
+     * @param never       the visibility value to apply to server teams
+     * @param joins       player names to hide
+     * @param leaves      player names to unhide; only removed while on hideTeam
+     * @param handles     Method[NT_COUNT]: getPlayersTeam(String), addPlayerToTeam(String, team),
+     *                    removePlayerFromTeam(String), team getName, get/set nametag visibility;
+     *                    the name and visibility getters may be null
+     * @param originals   Object[joins.length], filled for NT_STATUS_SERVER_TEAM joins
+     * @param out         Direct ByteBuffer owned by native; position=0 on entry
+     * @return number of joins written, or -1
+     */
+    public static int applyNametagHide(
+            Object     scoreboard,
+            Object     hideTeam,
+            Object     never,
+            String[]   joins,
+            String[]   leaves,
+            Method[]   handles,
+            Object[]   originals,
+            ByteBuffer out) {
+
+        out.order(ByteOrder.LITTLE_ENDIAN);
+        out.clear();
+        if (scoreboard == null || joins == null || leaves == null || handles == null || handles.length < NT_COUNT
+                || originals == null || originals.length < joins.length
+                || handles[NT_HOLDER_TEAM] == null) return -1;
+        Method mTeamOf = handles[NT_HOLDER_TEAM];
+
+        for (String name : leaves) {
+            if (name == null || hideTeam == null || handles[NT_REMOVE_HOLDER] == null) continue;
+            try {
+                if (mTeamOf.invoke(scoreboard, name) == hideTeam) handles[NT_REMOVE_HOLDER].invoke(scoreboard, name);
+            } catch (Exception ex) { /* already gone */ }
+        }
+
+        int poolStart = 8 + joins.length * 12;
+        if (poolStart > out.capacity()) return -1;
+        out.position(poolStart);
+
+        for (int i = 0; i < joins.length; i++) {
+            int rec = 8 + i * 12;
+            int status = NT_STATUS_FAILED;
+            String teamName = null;
+            originals[i] = null;
+            if (joins[i] != null) try {
+                Object team = mTeamOf.invoke(scoreboard, joins[i]);
+                if (team != null && team == hideTeam) {
+                    status = NT_STATUS_HIDE_TEAM;
+                } else if (team != null) {
+                    if (never != null && handles[NT_SET_VISIBILITY] != null) {
+                        originals[i] = call(handles[NT_GET_VISIBILITY], team);
+                        Object v = call(handles[NT_TEAM_NAME], team);
+                        if (v instanceof String) teamName = (String) v;
+                        handles[NT_SET_VISIBILITY].invoke(team, never);
+                        status = NT_STATUS_SERVER_TEAM;
+                    }
+                } else if (hideTeam != null && handles[NT_ADD_HOLDER] != null) {
+                    handles[NT_ADD_HOLDER].invoke(scoreboard, joins[i], hideTeam);
+                    status = NT_STATUS_HIDE_TEAM;
+                }
+            } catch (Exception ex) {
+                status = NT_STATUS_FAILED;
+            }
+            out.putInt(rec, status);
+            putPooled(out, rec + 4, poolStart, teamName);
+        }
+
+        out.putInt(0, joins.length);
+        out.putInt(4, poolStart);
+        out.flip();
+        return joins.length;
+    }
+
+    private static void putStack(Object stack, Method[] handles, Object[] kinds, ByteBuffer out) {
+        int kind = INV_EMPTY, itemId = 0, count = 0;
+        try {
+            boolean empty = stack == null
+                    || (handles[INV_STACK_EMPTY] != null && (Boolean) handles[INV_STACK_EMPTY].invoke(stack));
+            Object item = empty ? null : handles[INV_STACK_ITEM].invoke(stack);
+            if (item != null) {
+                kind = INV_OTHER;
+                for (int k = 0; k < kinds.length; k++) {
+                    if (kinds[k] == item) { kind = k; break; }
+                }
+                itemId = System.identityHashCode(item);
+                count = (Integer) handles[INV_STACK_COUNT].invoke(stack);
+            }
+        } catch (Exception ex) {
+            kind = INV_EMPTY;
+            itemId = 0;
+            count = 0;
+        }
+        out.putInt(kind);
+        out.putInt(itemId);
+        out.putInt(count);
+    }
 }
@@ -0,0 +1,432 @@
+// Native microbenchmarks for the bridge hot paths that live in shared sources.
+//
+// Build and run from McInjector (needs the JDK headers for jni_core):
+//   g++ -std=c++11 -O2 -o bridge_bench tests/bridge_bench.cpp src/main/cpp/projection.cpp
+//       src/main/cpp/bridge_protocol.cpp src/main/cpp/jni_core/helper_bridge.cpp
+//       src/main/cpp/jni_core/ref_ledger.cpp src/main/cpp/async_log.cpp
+//       -Isrc/main/cpp -I"%JAVA_HOME%/include" -I"%JAVA_HOME%/include/win32"
+//   bridge_bench [baseline-file] [--write-baseline]
+//
+// Each case reports ns/op and heap allocations/op.  A case fails when it is
+// more than kNsTolerance times slower than its baseline entry or allocates
+// more; write a new baseline (on the reference machine, -O2) when a change is
+// meant to move the numbers.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/main/cpp/bridge_protocol.h"
+#include "../src/main/cpp/frustum.h"
+#include "../src/main/cpp/jni_core/helper_bridge.h"
+#include "../src/main/cpp/json_config_reader.h"
+#include "../src/main/cpp/projection.h"
+#include "../src/main/cpp/text_utils.h"
+
+// ── Allocation counting ──────────────────────────────────────────────────────
+
+static unsigned long long g_allocs = 0;
+
+void* operator new(size_t n)
+{
+    ++g_allocs;
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+static volatile double g_sink = 0.0;   // keeps results observable
+
+// ── Runner ───────────────────────────────────────────────────────────────────
+
+struct Result {
+    std::string name;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+static const double kNsTolerance = 1.5;
+static const double kMinRunSeconds = 0.05;   // per sample
+static const int    kSamples = 5;            // fastest sample is reported
+
+template <typename Fn>
+static Result Run(const char* name, Fn fn)
+{
+    typedef std::chrono::steady_clock Clock;
+    for (int i = 0; i < 16; i++) fn();   // warm caches and recycled buffers
+
+    // Grow the batch until one sample takes kMinRunSeconds.
+    unsigned long long iters = 64;
+    for (;;) {
+        Clock::time_point t0 = Clock::now();
+        for (unsigned long long i = 0; i < iters; i++) fn();
+        double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (secs >= kMinRunSeconds || iters >= (1ULL << 40)) break;
+        iters *= secs > 0.0 ? (unsigned long long)(std::min)(16.0, std::ceil(kMinRunSeconds * 1.2 / secs)) : 16;
+    }
+
+    Result r;
+    r.name = name;
+    r.nsPerOp = 0.0;
+    unsigned long long allocs0 = g_allocs;
+    for (int s = 0; s < kSamples; s++) {
+        Clock::time_point t0 = Clock::now();
+        for (unsigned long long i = 0; i < iters; i++) fn();
+        double ns = std::chrono::duration<double>(Clock::now() - t0).count() * 1e9 / (double)iters;
+        if (s == 0 || ns < r.nsPerOp) r.nsPerOp = ns;
+    }
+    r.allocsPerOp = (double)(g_allocs - allocs0) / (double)(iters * kSamples);
+    return r;
+}
+
+// ── Inputs ───────────────────────────────────────────────────────────────────
+
+static std::string PlayerName(int i)
+{
+    static const char* const kStems[] = { "Notch", "xX_Slayer_Xx", "jeb_", "Dinnerbone", "steve", "Alex" };
+    std::ostringstream ss;
+    ss << kStems[i % 6] << i;
+    return ss.str().substr(0, 16);
+}
+
+static std::string ConfigLine()
+{
+    std::string preview;
+    for (int i = 0; i < 20; i++) preview += (i ? ", " : "") + std::string("candidate_word_") + std::to_string(i);
+    std::ostringstream ss;
+    ss << "{\"type\":\"config\",\"armed\":true,\"clicking\":false,\"minCPS\":9,\"maxCPS\":13,"
+       << "\"left\":true,\"right\":false,\"rightMinCPS\":10,\"rightMaxCPS\":14,\"rightBlock\":true,"
+       << "\"breakBlocks\":false,\"jitter\":false,\"clickInChests\":false,\"aimAssist\":true,"
+       << "\"aimAssistFov\":60.0,\"aimAssistRange\":4.5,\"aimAssistStrength\":40,\"triggerbot\":false,"
+       << "\"speedBridge\":false,\"speedBridgeBlockOnly\":true,\"speedBridgeDelayMs\":60,"
+       << "\"speedBridgeHoldingShiftOnly\":false,\"speedBridgeLookingDownOnly\":true,\"gtbHelper\":true,"
+       << "\"gtbHint\":\"_ _ _ _ _ _ _ (7)\",\"gtbCount\":20,\"gtbPreview\":\"" << preview << "\","
+       << "\"nametags\":true,\"showModuleList\":true,\"moduleListStyle\":2,\"showLogo\":true,"
+       << "\"overlayUpdateHz\":0,\"guiTheme\":\"Dark\",\"closestPlayerInfo\":true,"
+       << "\"nametagShowHealth\":true,\"nametagShowArmor\":true,\"nametagShowHeldItem\":false,"
+       << "\"nametagHideVanilla\":false,\"reloadMappingsNonce\":0,\"nametagMaxCount\":8,"
+       << "\"chestEsp\":false,\"chestEspMaxCount\":10,\"reachEnabled\":false,\"reachMin\":3.0,"
+       << "\"reachMax\":3.2,\"reachChance\":50,\"velocityEnabled\":false,\"velocityHorizontal\":90,"
+       << "\"velocityVertical\":100,\"velocityChance\":80,\"autoTotemEnabled\":false,\"autoTotemMode\":0,"
+       << "\"autoTotemHealth\":8,\"autoTotemElytra\":false,\"autoTotemDelay\":50,\"autoTotemBehaviorMode\":0,"
+       << "\"keybindAutoclicker\":82,\"keybindRightClick\":0,\"keybindJitter\":0,\"keybindClickInChests\":0,"
+       << "\"keybindBreakBlocks\":0,\"keybindAimAssist\":0,\"keybindTriggerbot\":0,\"keybindSpeedBridge\":0,"
+       << "\"keybindGtbHelper\":0,\"keybindNametags\":0,\"keybindClosestPlayer\":0,\"keybindChestEsp\":0}";
+    return ss.str();
+}
+
+// Reads every key the way ParseConfig does (one Get* per setting).
+static double ReadConfig(const lc::SimpleJsonConfigReader& r)
+{
+    static const char* const kBools[] = {
+        "armed", "clicking", "left", "right", "rightBlock", "breakBlocks", "jitter", "clickInChests",
+        "aimAssist", "triggerbot", "speedBridge", "speedBridgeBlockOnly", "speedBridgeHoldingShiftOnly",
+        "speedBridgeLookingDownOnly", "gtbHelper", "nametags", "showModuleList", "showLogo",
+        "closestPlayerInfo", "nametagShowHealth", "nametagShowArmor", "nametagShowHeldItem",
+        "nametagHideVanilla", "chestEsp", "reachEnabled", "velocityEnabled", "autoTotemEnabled",
+        "autoTotemElytra"
+    };
+    static const char* const kInts[] = {
+        "minCPS", "maxCPS", "rightMinCPS", "rightMaxCPS", "aimAssistStrength", "speedBridgeDelayMs",
+        "gtbCount", "moduleListStyle", "overlayUpdateHz", "reloadMappingsNonce", "nametagMaxCount",
+        "chestEspMaxCount", "reachChance", "velocityHorizontal", "velocityVertical", "velocityChance",
+        "autoTotemMode", "autoTotemHealth", "autoTotemDelay", "autoTotemBehaviorMode",
+        "keybindAutoclicker", "keybindRightClick", "keybindJitter", "keybindClickInChests",
+        "keybindBreakBlocks", "keybindAimAssist", "keybindTriggerbot", "keybindSpeedBridge",
+        "keybindGtbHelper", "keybindNametags", "keybindClosestPlayer", "keybindChestEsp"
+    };
+    static const char* const kFloats[] = { "aimAssistFov", "aimAssistRange", "reachMin", "reachMax" };
+    double acc = 0.0;
+    for (size_t i = 0; i < sizeof(kBools) / sizeof(kBools[0]); i++) acc += r.GetBool(kBools[i]) ? 1 : 0;
+    for (size_t i = 0; i < sizeof(kInts) / sizeof(kInts[0]); i++) acc += r.GetInt(kInts[i], -1);
+    for (size_t i = 0; i < sizeof(kFloats) / sizeof(kFloats[0]); i++) acc += r.GetFloat(kFloats[i], -1.0f);
+    acc += (double)r.GetString("gtbHint").size() + (double)r.GetString("gtbPreview").size() +
+           (double)r.GetString("guiTheme").size();
+    return acc;
+}
+
+static std::string LongActionBar()
+{
+    std::string s;
+    for (int i = 0; i < 12; i++) {
+        s += "\xC2\xA7" "c\xE2\x9D\xA4 ";
+        s += std::to_string(18 + i) + "/20 ";
+        s += "\xC2\xA7" "b\xC2\xA7" "lMana " + std::to_string(100 + i * 7) + "   ";
+    }
+    return s;
+}
+
+static lc::proto::StateSnapshot Snapshot(int players)
+{
+    lc::proto::StateSnapshot s;
+    s.flags = lc::proto::STATE_MAPPED | lc::proto::STATE_HOLDING_BLOCK;
+    s.posX = 1024.5; s.posY = 64.0; s.posZ = -2048.25;
+    s.stateMs = 123456789;
+    s.screenName = "";
+    s.actionBar = LongActionBar();
+    for (int i = 0; i < players; i++) {
+        lc::proto::EntitySnapshot e;
+        e.name = PlayerName(i);
+        e.sx = 100.0f + i; e.sy = 200.0f + i;
+        e.dist = 3.0 + i * 0.5;
+        e.hp = 20.0f - (float)(i % 20);
+        s.entities.push_back(e);
+    }
+    return s;
+}
+
+static void FillPoints(Projection::Points& pts, int n)
+{
+    pts.Clear();
+    for (int i = 0; i < n; i++) {
+        double a = i * 0.7;
+        pts.Push(1024.5 + std::cos(a) * (4 + i % 40), 64.0 + (i % 5), -2048.25 + std::sin(a) * (4 + i % 40));
+    }
+}
+
+static void PutI32(std::string& b, int v) { b.append((const char*)&v, 4); }
+static void PutF64(std::string& b, double v) { b.append((const char*)&v, 8); }
+static void PutF32(std::string& b, float v) { b.append((const char*)&v, 4); }
+
+// collectEntityFrame layout: per entity f64 x,y,z | f32 hp | i32 len | bytes.
+static std::string EntityFrameBytes(int n)
+{
+    std::string b;
+    for (int i = 0; i < n; i++) {
+        PutF64(b, i * 1.5); PutF64(b, 64.0); PutF64(b, -i * 2.0);
+        PutF32(b, 20.0f);
+        std::string name = PlayerName(i);
+        PutI32(b, (int)name.size());
+        b += name;
+    }
+    return b;
+}
+
+// collectEntityFrameWide layout: { count, poolStart }, 80-byte records, pool.
+static std::string WideFrameBytes(int n)
+{
+    std::string pool;
+    std::vector<HelperBridge::WideEntityRecord> recs(n);
+    for (int i = 0; i < n; i++) {
+        HelperBridge::WideEntityRecord& r = recs[i];
+        std::memset(&r, 0, sizeof(r));
+        r.index = i; r.entityId = 1000 + i;
+        r.x = i * 1.5; r.y = 64.0; r.z = -i * 2.0;
+        r.health = 20.0f; r.armor = 10;
+        std::string name = PlayerName(i);
+        r.name.off = (int)pool.size(); r.name.len = (int)name.size(); pool += name;
+        r.profile = r.name;
+        std::string held = "Diamond Sword";
+        r.held.off = (int)pool.size(); r.held.len = (int)held.size(); pool += held;
+        r.team.off = r.team.len = 0;
+    }
+    std::string b;
+    PutI32(b, n);
+    PutI32(b, 8 + n * 80);
+    if (n) b.append((const char*)&recs[0], (size_t)n * 80);
+    b += pool;
+    return b;
+}
+
+// ── Baseline ─────────────────────────────────────────────────────────────────
+
+static bool LoadBaseline(const std::string& path, std::map<std::string, Result>& out)
+{
+    std::ifstream in(path.c_str());
+    if (!in.good()) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        Result r;
+        if (ss >> r.name >> r.nsPerOp >> r.allocsPerOp) out[r.name] = r;
+    }
+    return true;
+}
+
+static bool WriteBaseline(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream out(path.c_str());
+    if (!out.good()) return false;
+    out << "# bridge_bench baseline: name ns/op allocs/op (regenerate with --write-baseline)\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        char row[160];
+        snprintf(row, sizeof(row), "%s %.1f %.2f\n", results[i].name.c_str(), results[i].nsPerOp,
+                 results[i].allocsPerOp);
+        out << row;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::string baselinePath = "tests/bridge_bench_baseline.txt";
+    bool writeBaseline = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--write-baseline") == 0) writeBaseline = true;
+        else baselinePath = argv[i];
+    }
+
+    std::vector<Result> results;
+
+    const std::string configLine = ConfigLine();
+    results.push_back(Run("config_parse", [&]() {
+        lc::SimpleJsonConfigReader reader(configLine);
+        g_sink = g_sink + ReadConfig(reader);
+    }));
+
+    const int kPlayerCounts[] = { 32, 200 };
+    for (int pc = 0; pc < 2; pc++) {
+        const int n = kPlayerCounts[pc];
+        const std::string suffix = "_" + std::to_string(n);
+
+        const lc::proto::StateSnapshot snap = Snapshot(n);
+        std::string frame;
+        frame.reserve(64 * 1024);
+        results.push_back(Run(("state_frame" + suffix).c_str(), [&]() {
+            frame.clear();
+            lc::proto::AppendStateFrame(frame, snap);
+            g_sink = g_sink + (double)frame.size();
+        }));
+
+        lc::proto::StateSnapshot moving = snap;
+        lc::proto::DeltaEncoder enc(1000000);
+        unsigned long nowMs = 0;
+        int tick = 0;
+        results.push_back(Run(("state_delta" + suffix).c_str(), [&]() {
+            tick++;
+            moving.stateMs++;
+            for (int i = 0; i < 4; i++) moving.entities[(tick + i) % n].dist += 0.05;
+            frame.clear();
+            enc.Encode(frame, moving, ++nowMs);
+            g_sink = g_sink + (double)frame.size();
+        }));
+
+        Projection::Camera cam;
+        const float view[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+        // Perspective, 70 degree vertical FOV, 16:9, near 0.05, far 1000.
+        const float f = 1.0f / std::tan(35.0f * 3.14159265f / 180.0f);
+        const float proj[16] = { f / (16.0f / 9.0f),0,0,0, 0,f,0,0, 0,0,-1.0001f,-1, 0,0,-0.1f,0 };
+        Projection::FromMatrices(cam, 1024.5, 64.0, -2048.25, view, proj);
+        Projection::Points pts;
+        FillPoints(pts, n);
+        Projection::Screen screen;
+        results.push_back(Run(("project_point" + suffix).c_str(), [&]() {
+            int inFront = 0;
+            for (int i = 0; i < pts.Size(); i++) {
+                float sx, sy;
+                if (Projection::ProjectPoint(cam, 1920, 1080, pts.x[i], pts.y[i], pts.z[i], &sx, &sy)) inFront++;
+            }
+            g_sink = g_sink + inFront;
+        }));
+        results.push_back(Run(("project_batch" + suffix).c_str(), [&]() {
+            g_sink = g_sink + Projection::Project(cam, 1920, 1080, pts, screen);
+        }));
+
+        // Overlay pick: frustum-cull every box, keep the nearest 8, project those.
+        struct Pick { double dist; int index; };
+        std::vector<Pick> picks;
+        picks.reserve(n);
+        Projection::Points pickPts;
+        pickPts.Reserve(8);
+        results.push_back(Run(("cull_select" + suffix).c_str(), [&]() {
+            Frustum::Planes fr;
+            Frustum::FromCamera(fr, cam, 1920, 1080);
+            picks.clear();
+            for (int i = 0; i < pts.Size(); i++) {
+                if (!Frustum::BoxVisible(fr, pts.x[i] - 0.5, pts.y[i], pts.z[i] - 0.5,
+                                         pts.x[i] + 0.5, pts.y[i] + 1.0, pts.z[i] + 0.5)) continue;
+                double dx = pts.x[i] - cam.ox, dz = pts.z[i] - cam.oz;
+                Pick p = { dx * dx + dz * dz, i };
+                picks.push_back(p);
+            }
+            picks.resize(Frustum::SelectNearest(picks, 8, [](const Pick& a, const Pick& b) { return a.dist < b.dist; }));
+            pickPts.Clear();
+            for (size_t k = 0; k < picks.size(); k++)
+                pickPts.Push(pts.x[picks[k].index], pts.y[picks[k].index], pts.z[picks[k].index]);
+            g_sink = g_sink + Projection::Project(cam, 1920, 1080, pickPts, screen);
+        }));
+
+        std::vector<std::string> rawNames;
+        for (int i = 0; i < n; i++) rawNames.push_back("\xC2\xA7" "7[VIP]  " + PlayerName(i) + " \xC2\xA7" "c\t");
+        results.push_back(Run(("normalize_names" + suffix).c_str(), [&]() {
+            size_t total = 0;
+            for (size_t i = 0; i < rawNames.size(); i++)
+                total += lc::NormalizeNameSpaces(lc::StripMinecraftFormattingCodes(rawNames[i])).size();
+            g_sink = g_sink + (double)total;
+        }));
+
+        const std::string entBytes = EntityFrameBytes(n);
+        HelperBridge::EntityFrame entFrame;
+        results.push_back(Run(("decode_entity_frame" + suffix).c_str(), [&]() {
+            g_sink = g_sink + HelperBridge::DecodeEntityFrame((const unsigned char*)entBytes.data(),
+                                                              (int)entBytes.size(), n, entFrame);
+        }));
+
+        const std::string wideBytes = WideFrameBytes(n);
+        HelperBridge::WideEntityFrame wideFrame;
+        results.push_back(Run(("decode_wide_frame" + suffix).c_str(), [&]() {
+            g_sink = g_sink + HelperBridge::DecodeWideFrame((const unsigned char*)wideBytes.data(),
+                                                            (int)wideBytes.size(), n, wideFrame);
+        }));
+    }
+
+    const std::string actionBar = LongActionBar();
+    results.push_back(Run("strip_action_bar", [&]() {
+        g_sink = g_sink + (double)lc::StripMinecraftFormattingCodes(actionBar).size();
+    }));
+
+    if (writeBaseline) {
+        if (!WriteBaseline(baselinePath, results)) {
+            std::cerr << "Cannot write baseline " << baselinePath << std::endl;
+            return 2;
+        }
+        std::cout << "Wrote baseline " << baselinePath << " (" << results.size() << " cases)." << std::endl;
+        return 0;
+    }
+
+    std::map<std::string, Result> baseline;
+    if (!LoadBaseline(baselinePath, baseline)) {
+        std::cerr << "No baseline at " << baselinePath << "; run with --write-baseline first." << std::endl;
+        return 2;
+    }
+
+    int regressions = 0;
+    printf("%-26s %12s %10s %12s %10s\n", "case", "ns/op", "allocs/op", "base ns/op", "base alc");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        std::map<std::string, Result>::const_iterator it = baseline.find(r.name);
+        const char* verdict = "";
+        if (it == baseline.end()) {
+            verdict = "  (new)";
+            printf("%-26s %12.1f %10.2f %12s %10s%s\n", r.name.c_str(), r.nsPerOp, r.allocsPerOp, "-", "-", verdict);
+            continue;
+        }
+        const Result& b = it->second;
+        if (r.nsPerOp > b.nsPerOp * kNsTolerance) { verdict = "  SLOWER"; regressions++; }
+        else if (r.allocsPerOp > b.allocsPerOp + 0.01) { verdict = "  MORE ALLOCS"; regressions++; }
+        printf("%-26s %12.1f %10.2f %12.1f %10.2f%s\n", r.name.c_str(), r.nsPerOp, r.allocsPerOp,
+               b.nsPerOp, b.allocsPerOp, verdict);
+    }
+
+    if (regressions != 0) {
+        std::cerr << "Bridge benchmarks regressed: " << regressions << std::endl;
+        return 1;
+    }
+    std::cout << "Bridge benchmarks within baseline." << std::endl;
+    return 0;
+}
@@ -0,0 +1,570 @@
+// Offline replay of a recorded scan-thread JNI session.
+//
+// Build from McInjector (needs the JDK headers):
+//   g++ -std=c++11 -O2 -o jni_replay tests/jni_replay.cpp src/main/cpp/jni_core/jni_replay.cpp
+//       src/main/cpp/jni_core/scan_engine.cpp
+//       -Isrc/main/cpp -I"%JAVA_HOME%/include" -I"%JAVA_HOME%/include/win32"
+//   jni_replay                      self-test: record a scan-shaped walk and a
+//                                   ScanEngine::WalkPlayers pass over a fake JVM,
+//                                   replay them, compare results
+//   jni_replay <file.lcjr> [passes] replay a recording made with LC_JNI_RECORD=1
+//
+// A recording is replayed by re-issuing each recorded call through the
+// player's JNIEnv, so every pass checks that the replay table returns the
+// recorded value for every call and reports ns per call.  Scan code that
+// takes a JNIEnv* runs against Player::Env() the same way.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../src/main/cpp/jni_core/jni_replay.h"
+#include "../src/main/cpp/jni_core/scan_engine.h"
+
+using JniReplay::Player;
+using JniReplay::Record;
+
+static int g_failures = 0;
+
+static void Check(bool ok, const char* what)
+{
+    if (ok) return;
+    ++g_failures;
+    std::printf("FAIL: %s\n", what);
+}
+
+// ── Re-issuing a recorded call ───────────────────────────────────────────────
+
+static unsigned long long Zig(long long v) { return ((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63); }
+static long long Unzig(unsigned long long v) { return (long long)(v >> 1) ^ -(long long)(v & 1); }
+
+static void* H(unsigned long long id) { return Player::Handle(id); }
+
+static unsigned long long IdOf(const void* h)
+{
+    if (!h) return 0;
+    return ((unsigned long long)(size_t)h - (unsigned long long)(size_t)Player::Handle(1)) / 16 + 1;
+}
+
+template <class T> static unsigned long long Bits(T v) { return Zig((long long)v); }
+template <class T> static unsigned long long Bits(T* v) { return IdOf(v); }
+static unsigned long long Bits(jfloat v) { unsigned u; std::memcpy(&u, &v, 4); return u; }
+static unsigned long long Bits(jdouble v) { unsigned long long u; std::memcpy(&u, &v, 8); return u; }
+
+// Strings re-issued with GetStringUTFChars, released when the recording does.
+static std::map<unsigned long long, std::vector<const char*> > g_openStrings;
+
+// Issues the call `r` describes and returns the value the env gave back in
+// the recording's encoding (handles as ids).
+static unsigned long long Issue(JNIEnv* env, const Record& r)
+{
+    using namespace JniReplay;
+    jobject a = (jobject)H(r.a);
+    jsize bi = (jsize)Unzig(r.b);
+    std::string name, sig;
+    if (!r.blob.empty()) {
+        size_t z = r.blob.find('\0');
+        name = r.blob.substr(0, z);
+        if (z != std::string::npos) sig = r.blob.substr(z + 1);
+    }
+
+    if (r.op >= kCall && r.op < kOpCount) {
+        int group = (r.op - kCall) / kTypeCount;
+        int type = (r.op - kCall) % kTypeCount;
+        jmethodID mid = (jmethodID)H(r.b);
+        jfieldID fid = (jfieldID)H(r.b);
+        jclass cls = (jclass)a;
+        switch (group * kTypeCount + type) {
+#define LC_ISSUE(Type, tag)                                                                   \
+        case 0 * kTypeCount + tag: return Bits(env->Call##Type##Method(a, mid));              \
+        case 1 * kTypeCount + tag: return Bits(env->CallStatic##Type##Method(cls, mid));      \
+        case 2 * kTypeCount + tag: return Bits(env->Get##Type##Field(a, fid));                \
+        case 3 * kTypeCount + tag: return Bits(env->GetStatic##Type##Field(cls, fid));
+        LC_ISSUE(Object, kObject) LC_ISSUE(Boolean, kBoolean) LC_ISSUE(Byte, kByte) LC_ISSUE(Char, kChar)
+        LC_ISSUE(Short, kShort) LC_ISSUE(Int, kInt) LC_ISSUE(Long, kLong) LC_ISSUE(Float, kFloat)
+        LC_ISSUE(Double, kDouble)
+#undef LC_ISSUE
+        case 0 * kTypeCount + kVoid: env->CallVoidMethod(a, mid); return 0;
+        case 1 * kTypeCount + kVoid: env->CallStaticVoidMethod(cls, mid); return 0;
+        case 4 * kTypeCount + kObject: env->SetObjectField(a, fid, (jobject)H(r.value)); return r.value;
+        case 4 * kTypeCount + kBoolean: env->SetBooleanField(a, fid, (jboolean)Unzig(r.value)); return r.value;
+        case 4 * kTypeCount + kInt: env->SetIntField(a, fid, (jint)Unzig(r.value)); return r.value;
+        case 4 * kTypeCount + kFloat: {
+            unsigned u = (unsigned)r.value; jfloat f; std::memcpy(&f, &u, 4);
+            env->SetFloatField(a, fid, f); return r.value;
+        }
+        case 4 * kTypeCount + kDouble: {
+            jdouble d; std::memcpy(&d, &r.value, 8);
+            env->SetDoubleField(a, fid, d); return r.value;
+        }
+        default:
+            return ~0ULL;   // not re-issuable; counts as a mismatch
+        }
+    }
+
+    switch (r.op) {
+    case kFindClass:            return Bits(env->FindClass(name.c_str()));
+    case kGetObjectClass:       return Bits(env->GetObjectClass(a));
+    case kGetMethodID:          return IdOf(env->GetMethodID((jclass)a, name.c_str(), sig.c_str()));
+    case kGetStaticMethodID:    return IdOf(env->GetStaticMethodID((jclass)a, name.c_str(), sig.c_str()));
+    case kGetFieldID:           return IdOf(env->GetFieldID((jclass)a, name.c_str(), sig.c_str()));
+    case kGetStaticFieldID:     return IdOf(env->GetStaticFieldID((jclass)a, name.c_str(), sig.c_str()));
+    case kFromReflectedMethod:  return IdOf(env->FromReflectedMethod(a));
+    case kToReflectedMethod:    return Bits(env->ToReflectedMethod((jclass)a, (jmethodID)H(r.b), JNI_FALSE));
+    case kToReflectedField:     return Bits(env->ToReflectedField((jclass)a, (jfieldID)H(r.b), JNI_FALSE));
+    case kIsInstanceOf:         return env->IsInstanceOf(a, (jclass)H(r.b));
+    case kIsAssignableFrom:     return env->IsAssignableFrom((jclass)a, (jclass)H(r.b));
+    case kIsSameObject:         return env->IsSameObject(a, (jobject)H(r.b));
+    case kNewObject:            return Bits(env->NewObject((jclass)a, (jmethodID)H(r.b)));
+    case kGetArrayLength:       return Bits(env->GetArrayLength((jarray)a));
+    case kGetObjectArrayElement: return Bits(env->GetObjectArrayElement((jobjectArray)a, bi));
+    case kSetObjectArrayElement: env->SetObjectArrayElement((jobjectArray)a, bi, (jobject)H(r.value)); return r.value;
+    case kNewObjectArray:       return Bits(env->NewObjectArray(bi, (jclass)a, nullptr));
+    case kNewByteArray:         return Bits(env->NewByteArray(bi));
+    case kSetByteArrayRegion:
+        env->SetByteArrayRegion((jbyteArray)a, bi, (jsize)r.blob.size(), (const jbyte*)r.blob.data());
+        return r.value;
+    case kGetFloatArrayRegion: {
+        jsize len = (jsize)Unzig(r.value);
+        std::vector<jfloat> buf(len > 0 ? (size_t)len : 1);
+        env->GetFloatArrayRegion((jfloatArray)a, bi, len, &buf[0]);
+        size_t n = r.blob.size() < buf.size() * sizeof(jfloat) ? r.blob.size() : buf.size() * sizeof(jfloat);
+        return std::memcmp(&buf[0], r.blob.data(), n) == 0 ? r.value : ~0ULL;
+    }
+    case kGetStringUTFChars: {
+        const char* s = env->GetStringUTFChars((jstring)a, nullptr);
+        if (!s) return r.value == 0 ? 0 : ~0ULL;
+        g_openStrings[r.a].push_back(s);
+        return r.blob == s ? 1 : ~0ULL;
+    }
+    case kReleaseStringUTFChars: {
+        std::vector<const char*>& open = g_openStrings[r.a];
+        const char* s = open.empty() ? nullptr : open.back();
+        if (!open.empty()) open.pop_back();
+        env->ReleaseStringUTFChars((jstring)a, s);
+        return 0;
+    }
+    case kNewStringUTF:         return Bits(env->NewStringUTF(r.blob.c_str()));
+    case kNewGlobalRef:         return Bits(env->NewGlobalRef(a));
+    case kDeleteGlobalRef:      env->DeleteGlobalRef(a); return 0;
+    case kNewWeakGlobalRef:     return Bits(env->NewWeakGlobalRef(a));
+    case kDeleteWeakGlobalRef:  env->DeleteWeakGlobalRef(a); return 0;
+    case kNewLocalRef:          return Bits(env->NewLocalRef(a));
+    case kDeleteLocalRef:       env->DeleteLocalRef(a); return 0;
+    case kPushLocalFrame:       return Bits(env->PushLocalFrame(bi));
+    case kPopLocalFrame:        return Bits(env->PopLocalFrame(a));
+    case kExceptionCheck:       return env->ExceptionCheck();
+    case kExceptionClear:       env->ExceptionClear(); return 0;
+    case kExceptionOccurred:    return Bits(env->ExceptionOccurred());
+    case kGetDirectBufferAddress:  return env->GetDirectBufferAddress(a) ? r.value : 0;
+    case kGetDirectBufferCapacity: return Bits(env->GetDirectBufferCapacity(a));
+    case kNewDirectByteBuffer: {
+        // The address is whatever the player handed out for that id earlier.
+        return Bits(env->NewDirectByteBuffer(H(r.a), (jlong)Unzig(r.b)));
+    }
+    default:
+        return ~0ULL;
+    }
+}
+
+// Re-issues the whole recording `passes` times.  Returns false on a
+// divergence or a value that differs from the recording.
+static bool ReplayPasses(Player& player, int passes, double* nsPerCall)
+{
+    JNIEnv* env = player.Env();
+    unsigned long long calls = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        player.Rewind();
+        g_openStrings.clear();
+        for (size_t i = 0; i < player.Size(); i++) {
+            const Record& r = player.At(i);
+            unsigned long long got = Issue(env, r);
+            ++calls;
+            if (player.Diverged()) {
+                std::printf("  divergence: %s\n", player.Divergence().c_str());
+                return false;
+            }
+            if (got != r.value && r.op != JniReplay::kGetDirectBufferAddress) {
+                std::printf("  record %lu (%s): replayed value differs\n", (unsigned long)i, JniReplay::OpName(r.op));
+                return false;
+            }
+        }
+    }
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    if (nsPerCall) *nsPerCall = calls ? ns / (double)calls : 0.0;
+    return true;
+}
+
+// ── Self-test: a fake JVM and a scan-shaped walk over it ─────────────────────
+
+namespace fake {
+
+enum Kind { kLevel, kList, kArray, kPlayer, kOther, kString, kClass, kMember };
+
+struct Obj {
+    int         kind;
+    int         index;
+    const char* name;
+};
+
+const int kSlots = 9;   // slot 3 is not a player
+const char* const kNames[kSlots] = { "Alex", "Steve", "Notch", "-", "jeb_", "Dinnerbone", "Grumm", "Marc", "Jens" };
+
+Obj g_level = { kLevel, 0, nullptr };
+Obj g_list = { kList, 0, nullptr };
+Obj g_array = { kArray, 0, nullptr };
+Obj g_levelClass = { kClass, 0, "Level" };
+Obj g_listClass = { kClass, 1, "java/util/List" };
+Obj g_playerClass = { kClass, 2, "net/minecraft/world/entity/player/Player" };
+Obj g_slots[kSlots];
+Obj g_strings[kSlots];
+Obj g_members[] = {
+    { kMember, 0, "players" }, { kMember, 1, "toArray" }, { kMember, 2, "getScoreboardName" },
+    { kMember, 3, "getHealth" }, { kMember, 4, "x" }, { kMember, 5, "y" }, { kMember, 6, "z" },
+    { kMember, 7, "size" }, { kMember, 8, "get" }
+};
+
+Obj* O(jobject h) { return (Obj*)h; }
+
+jobject Member(const char* name)
+{
+    for (size_t i = 0; i < sizeof(g_members) / sizeof(g_members[0]); i++)
+        if (std::strcmp(g_members[i].name, name) == 0) return (jobject)&g_members[i];
+    return nullptr;
+}
+
+jclass JNICALL FindClass(JNIEnv*, const char* name)
+{
+    if (std::strcmp(name, g_listClass.name) == 0) return (jclass)&g_listClass;
+    if (std::strcmp(name, g_playerClass.name) == 0) return (jclass)&g_playerClass;
+    return nullptr;
+}
+jclass JNICALL GetObjectClass(JNIEnv*, jobject) { return (jclass)&g_levelClass; }
+jmethodID JNICALL GetMethodID(JNIEnv*, jclass, const char* name, const char*) { return (jmethodID)(void*)Member(name); }
+jfieldID JNICALL GetFieldID(JNIEnv*, jclass, const char* name, const char*) { return (jfieldID)(void*)Member(name); }
+jobject JNICALL CallObjectMethodV(JNIEnv*, jobject obj, jmethodID mid, va_list args)
+{
+    switch (((Obj*)(void*)mid)->index) {
+    case 0: return (jobject)&g_list;
+    case 1: return (jobject)&g_array;
+    case 2: return (jobject)&g_strings[O(obj)->index];
+    case 8: {
+        jint i = va_arg(args, jint);
+        return i >= 0 && i < kSlots ? (jobject)&g_slots[i] : nullptr;
+    }
+    default: return nullptr;
+    }
+}
+jint JNICALL CallIntMethodV(JNIEnv*, jobject, jmethodID, va_list) { return kSlots; }
+jfloat JNICALL CallFloatMethodV(JNIEnv*, jobject obj, jmethodID, va_list) { return 20.0f - (float)O(obj)->index; }
+jsize JNICALL GetArrayLength(JNIEnv*, jarray) { return kSlots; }
+jobject JNICALL GetObjectArrayElement(JNIEnv*, jobjectArray, jsize i) { return (jobject)&g_slots[i]; }
+jboolean JNICALL IsInstanceOf(JNIEnv*, jobject obj, jclass) { return O(obj)->kind == kPlayer ? JNI_TRUE : JNI_FALSE; }
+jdouble JNICALL GetDoubleField(JNIEnv*, jobject obj, jfieldID fid)
+{
+    return O(obj)->index * 1.5 + (((Obj*)(void*)fid)->index - 4) * 100.0;
+}
+const char* JNICALL GetStringUTFChars(JNIEnv*, jstring s, jboolean* isCopy)
+{
+    if (isCopy) *isCopy = JNI_FALSE;
+    return O(s)->name;
+}
+void JNICALL ReleaseStringUTFChars(JNIEnv*, jstring, const char*) {}
+jboolean JNICALL IsSameObject(JNIEnv*, jobject x, jobject y) { return x == y ? JNI_TRUE : JNI_FALSE; }
+void JNICALL DeleteLocalRef(JNIEnv*, jobject) {}
+jboolean JNICALL ExceptionCheck(JNIEnv*) { return JNI_FALSE; }
+void JNICALL ExceptionClear(JNIEnv*) {}
+
+JNIEnv* Env()
+{
+    static JNINativeInterface_ s_table;
+    static JNIEnv s_env;
+    std::memset(&s_table, 0, sizeof(s_table));
+    s_table.FindClass = FindClass;
+    s_table.GetObjectClass = GetObjectClass;
+    s_table.GetMethodID = GetMethodID;
+    s_table.GetFieldID = GetFieldID;
+    s_table.CallObjectMethodV = CallObjectMethodV;
+    s_table.CallIntMethodV = CallIntMethodV;
+    s_table.CallFloatMethodV = CallFloatMethodV;
+    s_table.GetArrayLength = GetArrayLength;
+    s_table.GetObjectArrayElement = GetObjectArrayElement;
+    s_table.IsInstanceOf = IsInstanceOf;
+    s_table.GetDoubleField = GetDoubleField;
+    s_table.GetStringUTFChars = GetStringUTFChars;
+    s_table.ReleaseStringUTFChars = ReleaseStringUTFChars;
+    s_table.IsSameObject = IsSameObject;
+    s_table.DeleteLocalRef = DeleteLocalRef;
+    s_table.ExceptionCheck = ExceptionCheck;
+    s_table.ExceptionClear = ExceptionClear;
+    for (int i = 0; i < kSlots; i++) {
+        g_slots[i].kind = (i == 3) ? kOther : kPlayer;
+        g_slots[i].index = i;
+        g_strings[i].kind = kString;
+        g_strings[i].index = i;
+        g_strings[i].name = kNames[i];
+    }
+    s_env.functions = &s_table;
+    return &s_env;
+}
+
+} // namespace fake
+
+struct WalkResult {
+    std::string names;
+    double      sum;
+    int         players;
+
+    bool operator==(const WalkResult& o) const { return names == o.names && sum == o.sum && players == o.players; }
+};
+
+// Shaped like the player-list scan: resolve members, list → array, then per
+// element an instanceof, three fields, a call and a string.
+static WalkResult WalkPlayers(JNIEnv* env, jobject level)
+{
+    WalkResult out = { std::string(), 0.0, 0 };
+    jclass levelCls = env->GetObjectClass(level);
+    jmethodID players = env->GetMethodID(levelCls, "players", "()Ljava/util/List;");
+    jobject list = env->CallObjectMethod(level, players);
+    jclass listCls = env->FindClass("java/util/List");
+    jmethodID toArray = env->GetMethodID(listCls, "toArray", "()[Ljava/lang/Object;");
+    jobjectArray arr = (jobjectArray)env->CallObjectMethod(list, toArray);
+    jclass playerCls = env->FindClass("net/minecraft/world/entity/player/Player");
+    jfieldID fx = env->GetFieldID(playerCls, "x", "D");
+    jfieldID fy = env->GetFieldID(playerCls, "y", "D");
+    jfieldID fz = env->GetFieldID(playerCls, "z", "D");
+    jmethodID getName = env->GetMethodID(playerCls, "getScoreboardName", "()Ljava/lang/String;");
+    jmethodID getHealth = env->GetMethodID(playerCls, "getHealth", "()F");
+    jsize n = arr ? env->GetArrayLength(arr) : 0;
+    for (jsize i = 0; i < n; i++) {
+        jobject p = env->GetObjectArrayElement(arr, i);
+        if (!p || !env->IsInstanceOf(p, playerCls)) {
+            if (p) env->DeleteLocalRef(p);
+            continue;
+        }
+        out.sum += env->GetDoubleField(p, fx) + env->GetDoubleField(p, fy) + env->GetDoubleField(p, fz);
+        out.sum += env->CallFloatMethod(p, getHealth);
+        jstring s = (jstring)env->CallObjectMethod(p, getName);
+        if (env->ExceptionCheck()) s = nullptr;
+        if (s) {
+            const char* chars = env->GetStringUTFChars(s, nullptr);
+            if (chars) {
+                out.names += chars;
+                out.names += ',';
+                env->ReleaseStringUTFChars(s, chars);
+            }
+            env->DeleteLocalRef(s);
+        }
+        env->DeleteLocalRef(p);
+        ++out.players;
+    }
+    if (arr) env->DeleteLocalRef(arr);
+    if (list) env->DeleteLocalRef(list);
+    env->DeleteLocalRef(listCls);
+    env->DeleteLocalRef(playerCls);
+    env->DeleteLocalRef(levelCls);
+    return out;
+}
+
+// ── The real walk: ScanEngine::WalkPlayers over the same fake JVM ────────────
+
+// Per-entity reads the way the 26.1 adapter does them: position fields,
+// getHealth() and the scoreboard name.  No instanceof, so slot 3 ("-") has to
+// be dropped by the engine's fake-name filter.
+struct GetterAdapter : ScanEngine::VersionAdapter {
+    jfieldID  fx, fy, fz;
+    jmethodID getName, getHealth;
+
+    bool ReadPlayer(JNIEnv* env, jobject e, ScanEngine::PlayerSample& s)
+    {
+        s.x = s.lastX = env->GetDoubleField(e, fx);
+        s.y = s.lastY = env->GetDoubleField(e, fy);
+        s.z = s.lastZ = env->GetDoubleField(e, fz);
+        s.health = env->CallFloatMethod(e, getHealth);
+        jstring js = (jstring)env->CallObjectMethod(e, getName);
+        if (!js) return false;
+        const char* chars = env->GetStringUTFChars(js, nullptr);
+        if (chars) {
+            s.name = chars;
+            env->ReleaseStringUTFChars(js, chars);
+        }
+        env->DeleteLocalRef(js);
+        return true;
+    }
+};
+
+struct ScanResult {
+    int         players;
+    std::string names;
+    std::string nearest;
+    double      sum;
+    ScanEngine::WalkStats stats;
+
+    bool operator==(const ScanResult& o) const
+    {
+        return players == o.players && names == o.names && nearest == o.nearest && sum == o.sum &&
+               stats.walks == o.stats.walks && stats.batched == o.stats.batched &&
+               stats.entities == o.stats.entities && stats.dropped == o.stats.dropped;
+    }
+};
+
+// Resolves the list accessors and adapter members, then one walk from slot
+// 0's position with a 16-block range, `self` excluded.
+static ScanResult ScanWalk(JNIEnv* env, jobject level, jobject self)
+{
+    ScanResult out = { -1, std::string(), std::string(), 0.0, ScanEngine::WalkStats() };
+    jclass levelCls = env->GetObjectClass(level);
+    jobject list = env->CallObjectMethod(level, env->GetMethodID(levelCls, "players", "()Ljava/util/List;"));
+    jclass listCls = env->FindClass("java/util/List");
+    ScanEngine::ListAccess access = { env->GetMethodID(listCls, "size", "()I"),
+                                      env->GetMethodID(listCls, "get", "(I)Ljava/lang/Object;") };
+    jclass playerCls = env->FindClass("net/minecraft/world/entity/player/Player");
+    GetterAdapter adapter;
+    adapter.fx = env->GetFieldID(playerCls, "x", "D");
+    adapter.fy = env->GetFieldID(playerCls, "y", "D");
+    adapter.fz = env->GetFieldID(playerCls, "z", "D");
+    adapter.getName = env->GetMethodID(playerCls, "getScoreboardName", "()Ljava/lang/String;");
+    adapter.getHealth = env->GetMethodID(playerCls, "getHealth", "()F");
+
+    ScanEngine::WalkOptions opts = { 0.0, 100.0, 200.0, 16.0 };
+    std::vector<ScanEngine::PlayerSample> players;
+    ScanEngine::ResetStats();
+    out.players = ScanEngine::WalkPlayers(env, adapter, list, access, self, opts, players);
+    out.stats = ScanEngine::Stats();
+    for (size_t i = 0; i < players.size(); i++) {
+        out.names += players[i].name;
+        out.names += ',';
+        out.sum += players[i].dist + players[i].health + players[i].index;
+    }
+    int nearest = ScanEngine::Nearest(players, opts.maxDist);
+    if (nearest >= 0) out.nearest = players[nearest].name;
+
+    if (list) env->DeleteLocalRef(list);
+    env->DeleteLocalRef(listCls);
+    env->DeleteLocalRef(playerCls);
+    env->DeleteLocalRef(levelCls);
+    return out;
+}
+
+static void ScanEngineReplayTest(JNIEnv* jvm)
+{
+    const char* path = "jni_replay_scan.lcjr";
+    jobject level = (jobject)&fake::g_level;
+    jobject self = (jobject)&fake::g_slots[5];
+    ScanResult direct = ScanWalk(jvm, level, self);
+    // Slot 5 is self, 3 is a separator line, 7 and 8 are out of range.
+    Check(direct.players == 5 && direct.names == "Alex,Steve,Notch,jeb_,Grumm,", "ScanEngine walk filters the fake list");
+    Check(direct.nearest == "Alex", "ScanEngine::Nearest picks the closest player");
+    Check(direct.stats.walks == 1 && direct.stats.batched == 0 && direct.stats.entities == fake::kSlots &&
+          direct.stats.dropped == 4, "ScanEngine counts the per-entity walk");
+
+    Check(JniReplay::StartRecording(path, 1 << 20), "scan recording starts");
+    ScanResult recorded;
+    {
+        JniReplay::RecordScope rec(jvm);
+        recorded = ScanWalk(jvm, level, self);
+    }
+    unsigned long calls = JniReplay::RecordedCalls();
+    JniReplay::StopRecording();
+    Check(recorded == direct, "recording does not change the ScanEngine walk");
+
+    Player player;
+    std::string error;
+    Check(player.Load(path, &error) && player.Size() == calls, "scan recording loads");
+
+    // level and self are the caller's pointers: the player binds them to the
+    // recorded ids on first use, as it would a bridge's globals.
+    for (int pass = 0; pass < 2; pass++) {
+        player.Rewind();
+        ScanResult replayed = ScanWalk(player.Env(), level, self);
+        Check(replayed == direct, "ScanEngine walk over the replay gives the recorded results");
+        Check(!player.Diverged() && player.Done(), "ScanEngine walk consumes the recording exactly");
+        if (player.Diverged()) std::printf("  divergence: %s\n", player.Divergence().c_str());
+    }
+    Check(ReplayPasses(player, 100, nullptr), "re-issuing the scan recording matches it");
+
+    std::remove(path);
+    std::printf("ScanEngine replay: %lu calls recorded\n", calls);
+}
+
+static int SelfTest()
+{
+    const char* path = "jni_replay_selftest.lcjr";
+    JNIEnv* jvm = fake::Env();
+    WalkResult direct = WalkPlayers(jvm, (jobject)&fake::g_level);
+    Check(direct.players == fake::kSlots - 1, "fake walk sees every player");
+
+    Check(JniReplay::StartRecording(path, 1 << 20), "recording starts");
+    WalkResult recorded;
+    {
+        JniReplay::RecordScope rec(jvm);
+        recorded = WalkPlayers(jvm, (jobject)&fake::g_level);
+    }
+    unsigned long calls = JniReplay::RecordedCalls();
+    JniReplay::StopRecording();
+    Check(jvm->functions != nullptr && recorded == direct, "recording does not change results");
+    Check(calls > 0, "calls were recorded");
+
+    Player player;
+    std::string error;
+    Check(player.Load(path, &error) && error.empty(), "recording loads");
+    Check(player.Size() == calls, "every call is in the file");
+    if (player.Size() == 0) return 1;
+
+    jobject level = (jobject)Player::Handle(player.At(0).a);
+    for (int pass = 0; pass < 2; pass++) {
+        player.Rewind();
+        WalkResult replayed = WalkPlayers(player.Env(), level);
+        Check(replayed == direct, "replay gives the recorded results");
+        Check(!player.Diverged() && player.Done(), "replay consumes the recording exactly");
+    }
+
+    player.Rewind();
+    player.Env()->FindClass("java/util/List");   // not what the recording starts with
+    Check(player.Diverged(), "a different call sequence is reported");
+
+    double ns = 0.0;
+    Check(ReplayPasses(player, 1000, &ns), "re-issuing the recording matches it");
+
+    std::remove(path);
+    std::printf("self-test: %lu calls recorded, replay %.1f ns/call\n", calls, ns);
+
+    ScanEngineReplayTest(jvm);
+    if (g_failures) {
+        std::printf("%d check(s) failed.\n", g_failures);
+        return 1;
+    }
+    std::printf("JNI replay self-test passed.\n");
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) return SelfTest();
+
+    Player player;
+    std::string error;
+    if (!player.Load(argv[1], &error)) {
+        std::printf("%s\n", error.c_str());
+        return 1;
+    }
+    if (!error.empty()) std::printf("warning: %s\n", error.c_str());
+
+    std::map<std::string, unsigned long> perOp;
+    for (size_t i = 0; i < player.Size(); i++) ++perOp[JniReplay::OpName(player.At(i).op)];
+    std::printf("%lu calls\n", (unsigned long)player.Size());
+    for (std::map<std::string, unsigned long>::const_iterator it = perOp.begin(); it != perOp.end(); ++it)
+        std::printf("  %-28s %lu\n", it->first.c_str(), it->second);
+
+    int passes = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (passes < 1) passes = 1;
+    double ns = 0.0;
+    if (!ReplayPasses(player, passes, &ns)) return 1;
+    std::printf("replayed %d pass(es) deterministically, %.1f ns/call\n", passes, ns);
+    return 0;
+}
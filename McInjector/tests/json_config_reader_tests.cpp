@@ -65,6 +65,31 @@ static void TestFallbacksOnMissingOrInvalidValues()
     ExpectTrue(!reader.GetBool("missingBool", true), "bool explicit false");
 }
 
+static void TestEscapesNestingAndDuplicates()
+{
+    const std::string line =
+        "{\"type\":\"config\",\"gtbHint\":\"it\\u0027s \\\"a\\\" \\u00e9\",\"nested\":{\"armed\":true,\"s\":\"}\"},"
+        "\"list\":[1,2],\"armed\":false,\"gtbCount\":3,\"gtbCount\":9}";
+    lc::SimpleJsonConfigReader reader(line);
+
+    ExpectEq("it's \"a\" \xc3\xa9", reader.GetString("gtbHint"), "escaped string decoded");
+    ExpectTrue(!reader.GetBool("armed", true), "nested keys are not indexed");
+    ExpectEq("[1,2]", reader.GetString("list"), "array kept as raw span");
+    ExpectEq(3, reader.GetInt("gtbCount"), "first duplicate wins");
+    ExpectTrue(reader.Has("nested") && !reader.Has("s"), "Has on top-level keys only");
+}
+
+static void TestApplyIfChanged()
+{
+    unsigned changed = 0;
+    int value = 5;
+    lc::ApplyIfChanged(value, 5, 1u << 0, changed);
+    ExpectEq(0, (int)changed, "unchanged value leaves mask empty");
+    lc::ApplyIfChanged(value, 7, 1u << 2, changed);
+    ExpectEq(7, value, "changed value applied");
+    ExpectEq(4, (int)changed, "changed value marks its module");
+}
+
 static void TestClampUtilities()
 {
     ExpectEq(1, lc::ClampInt(-5, 1, 20), "ClampInt lower bound");
@@ -76,6 +101,18 @@ static void TestClampUtilities()
     ExpectNear(3.5f, lc::ClampFloat(3.5f, 1.0f, 6.0f), 0.0001f, "ClampFloat passthrough");
 }
 
+// True when `name` is one of the entries of the payload's "streams" array.
+static bool HasStream(const std::string& payload, const char* name)
+{
+    const std::string key = "\"streams\":[";
+    size_t begin = payload.find(key);
+    if (begin == std::string::npos) return false;
+    begin += key.size();
+    size_t end = payload.find(']', begin);
+    if (end == std::string::npos) return false;
+    return payload.substr(begin, end - begin).find("\"" + std::string(name) + "\"") != std::string::npos;
+}
+
 static void TestCapabilitiesPayloads()
 {
     const std::string legacy = lc::LegacyCapabilitiesJson();
@@ -87,12 +124,17 @@ static void TestCapabilitiesPayloads()
     ExpectTrue(legacy.find("\"keybindautoclicker\"") != std::string::npos, "legacy should advertise keybind setting");
     ExpectTrue(legacy.find("\"state\":[") != std::string::npos, "legacy should include state array");
     ExpectTrue(modern.find("\"state\":[") != std::string::npos, "modern should include state array");
+    ExpectTrue(HasStream(legacy, "telemetry"), "legacy should announce the telemetry stream");
+    ExpectTrue(HasStream(modern, "telemetry"), "modern should announce the telemetry stream");
+    ExpectTrue(HasStream(modern, "moduleState"), "modern should announce the moduleState stream");
 }
 
 int main()
 {
     TestReadsQuotedAndUnquotedValues();
     TestFallbacksOnMissingOrInvalidValues();
+    TestEscapesNestingAndDuplicates();
+    TestApplyIfChanged();
     TestClampUtilities();
     TestCapabilitiesPayloads();
 
@@ -0,0 +1,233 @@
+// Unit tests for lc::SnapshotCell (snapshot_cell.h).
+//
+// Build and run from McInjector:
+//   g++ -std=c++11 -O2 -o snapshot_cell_tests tests/snapshot_cell_tests.cpp -Isrc/main/cpp
+//   snapshot_cell_tests
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../src/main/cpp/snapshot_cell.h"
+
+static int g_failures = 0;
+
+static void Check(bool ok, const char* what)
+{
+    if (ok) return;
+    ++g_failures;
+    std::printf("FAIL: %s\n", what);
+}
+
+struct Frame {
+    LONG seq;
+    std::vector<LONG> items;   // seq, seq + 1, ... so a torn read shows up
+
+    Frame() : seq(0) {}
+};
+
+static void Fill(Frame& f, LONG seq)
+{
+    f.seq = seq;
+    f.items.clear();
+    for (LONG i = 0; i < 8 + seq % 24; i++) f.items.push_back(seq + i);
+}
+
+static bool Consistent(const Frame& f)
+{
+    for (size_t i = 0; i < f.items.size(); i++) {
+        if (f.items[i] != f.seq + (LONG)i) return false;
+    }
+    return true;
+}
+
+// ── Single thread ────────────────────────────────────────────────────────────
+
+static void TestAcquireSeesEachPublishInOrder()
+{
+    lc::SnapshotCell<int> cell(7);
+    lc::SnapshotCell<int>::Ref first = cell.Acquire();
+    Check(*first == 7 && first.Version() == 1 && cell.Version() == 1, "initial snapshot is version 1");
+    Check(!cell.Refresh(first), "Refresh without a publish keeps the ref");
+
+    LONG v2 = cell.Publish(8);
+    LONG v3 = cell.Publish(9);
+    Check(v2 == 2 && v3 == 3 && cell.Version() == 3, "Publish bumps the version by one");
+    Check(*first == 7, "a held ref keeps its value across publishes");
+
+    lc::SnapshotCell<int>::Ref latest = cell.Acquire();
+    Check(*latest == 9 && latest.Version() == 3, "Acquire returns the newest snapshot");
+    Check(cell.Refresh(first) && *first == 9 && first.Version() == 3, "Refresh moves a stale ref to the newest snapshot");
+
+    lc::SnapshotCell<int>::Ref empty;
+    Check(empty.Version() == 0 && cell.Refresh(empty) && *empty == 9, "Refresh fills an empty ref");
+}
+
+static void TestBeginWriteReturnsOneBufferUntilCommit()
+{
+    lc::SnapshotCell<std::string> cell;
+    std::string& a = cell.BeginWrite();
+    a = "one";
+    Check(&cell.BeginWrite() == &a, "BeginWrite before Commit returns the same buffer");
+    cell.Commit();
+    Check(*cell.Acquire() == "one", "Commit publishes the BeginWrite buffer");
+}
+
+static size_t DistinctNodes(const std::vector<const Frame*>& seen)
+{
+    std::vector<const Frame*> distinct;
+    for (size_t i = 0; i < seen.size(); i++) {
+        bool known = false;
+        for (size_t k = 0; k < distinct.size(); k++) known = known || distinct[k] == seen[i];
+        if (!known) distinct.push_back(seen[i]);
+    }
+    return distinct.size();
+}
+
+static void TestReleasedNodesAreRecycled()
+{
+    // Readers that release before the next write: the published node and the
+    // one being written are all the writer ever needs.
+    lc::SnapshotCell<Frame> cell;
+    std::vector<const Frame*> seen;
+    for (LONG seq = 1; seq <= 50; seq++) {
+        Frame& f = cell.BeginWrite();
+        seen.push_back(&f);
+        Fill(f, seq);
+        cell.Commit();
+        lc::SnapshotCell<Frame>::Ref r = cell.Acquire();
+        Check(r->seq == seq && Consistent(*r), "reader sees the last commit");
+    }
+    Check(DistinctNodes(seen) == 2, "without held readers the writer reuses two nodes");
+
+    // A reader that always lags one publish behind costs one more node.
+    seen.clear();
+    lc::SnapshotCell<Frame>::Ref lagging = cell.Acquire();
+    for (LONG seq = 51; seq <= 100; seq++) {
+        Frame& f = cell.BeginWrite();
+        seen.push_back(&f);
+        Fill(f, seq);
+        cell.Commit();
+        lc::SnapshotCell<Frame>::Ref next = cell.Acquire();
+        Check(lagging->seq == seq - 1 && Consistent(*lagging), "lagging reader keeps the previous snapshot");
+        lagging = next;
+    }
+    Check(DistinctNodes(seen) <= 3, "released nodes return to the pool for later writes");
+}
+
+static void TestHeldSnapshotIsNotRecycledUntilReleased()
+{
+    lc::SnapshotCell<Frame> cell;
+    Fill(cell.BeginWrite(), 1);
+    cell.Commit();
+
+    lc::SnapshotCell<Frame>::Ref held = cell.Acquire();
+    const Frame* heldNode = &*held;
+
+    bool neverHanded = true;
+    for (LONG seq = 2; seq <= 12; seq++) {
+        Frame& f = cell.BeginWrite();
+        neverHanded = neverHanded && &f != heldNode;
+        Fill(f, seq);
+        cell.Commit();
+        cell.Reclaim();
+    }
+    Check(neverHanded, "a held snapshot is never handed out as a write buffer");
+    Check(held->seq == 1 && Consistent(*held), "a held snapshot keeps its contents across publishes");
+
+    // A copy keeps the node alive after the original ref is gone.
+    lc::SnapshotCell<Frame>::Ref copy = held;
+    held.Reset();
+    bool stillHeld = true;
+    for (LONG seq = 13; seq <= 16; seq++) {
+        Frame& f = cell.BeginWrite();
+        stillHeld = stillHeld && &f != heldNode;
+        Fill(f, seq);
+        cell.Commit();
+    }
+    Check(stillHeld && copy->seq == 1, "a copied ref keeps the node out of the pool");
+
+    copy.Reset();
+    bool recycled = false;
+    for (LONG seq = 17; seq <= 20 && !recycled; seq++) {
+        Frame& f = cell.BeginWrite();
+        recycled = &f == heldNode;
+        Fill(f, seq);
+        cell.Commit();
+    }
+    Check(recycled, "the node is reused once the last ref is released");
+}
+
+// ── Threads ──────────────────────────────────────────────────────────────────
+
+struct StressShared {
+    lc::SnapshotCell<Frame>* cell;
+    volatile LONG stop;
+    volatile LONG torn;
+    volatile LONG backwards;
+    volatile LONG reads;
+};
+
+static DWORD WINAPI StressReader(LPVOID p)
+{
+    StressShared* s = (StressShared*)p;
+    lc::SnapshotCell<Frame>::Ref ref;
+    LONG lastVersion = 0;
+    LONG lastSeq = 0;
+    while (!InterlockedCompareExchange(&s->stop, 0, 0)) {
+        // Alternate between polling and holding a fresh ref for a while.
+        if (s->cell->Refresh(ref)) {
+            if (ref.Version() < lastVersion || ref->seq < lastSeq) InterlockedIncrement(&s->backwards);
+            lastVersion = ref.Version();
+            lastSeq = ref->seq;
+        }
+        lc::SnapshotCell<Frame>::Ref extra = s->cell->Acquire();
+        for (int spin = 0; spin < 50; spin++) {
+            if (!Consistent(*ref) || !Consistent(*extra)) { InterlockedIncrement(&s->torn); break; }
+        }
+        InterlockedIncrement(&s->reads);
+    }
+    return 0;
+}
+
+static void TestConcurrentReadersNeverSeeTornOrOlderSnapshots()
+{
+    const int kReaders = 4;
+    const LONG kPublishes = 200000;
+
+    lc::SnapshotCell<Frame> cell;
+    StressShared shared = { &cell, 0, 0, 0, 0 };
+    HANDLE threads[kReaders];
+    for (int i = 0; i < kReaders; i++) threads[i] = CreateThread(nullptr, 0, StressReader, &shared, 0, nullptr);
+
+    for (LONG seq = 1; seq <= kPublishes; seq++) {
+        Fill(cell.BeginWrite(), seq);
+        cell.Commit();
+    }
+    InterlockedExchange(&shared.stop, 1);
+    for (int i = 0; i < kReaders; i++) {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+    }
+
+    Check(shared.torn == 0, "readers never see a snapshot being rewritten");
+    Check(shared.backwards == 0, "a reader's snapshots never go back in version");
+    Check(shared.reads > 0, "readers ran during the stress run");
+    Check(cell.Acquire()->seq == kPublishes, "the last publish wins");
+}
+
+int main()
+{
+    TestAcquireSeesEachPublishInOrder();
+    TestBeginWriteReturnsOneBufferUntilCommit();
+    TestReleasedNodesAreRecycled();
+    TestHeldSnapshotIsNotRecycledUntilReleased();
+    TestConcurrentReadersNeverSeeTornOrOlderSnapshots();
+
+    if (g_failures != 0) {
+        std::printf("SnapshotCell tests failed: %d\n", g_failures);
+        return 1;
+    }
+    std::printf("SnapshotCell tests passed.\n");
+    return 0;
+}
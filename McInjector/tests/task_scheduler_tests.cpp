@@ -0,0 +1,198 @@
+// Unit tests for lc::TaskScheduler (task_scheduler.h): the 128-slot, 1 ms
+// timer wheel across wrap-around, delays longer than a revolution, and
+// rescheduling from inside a running task.
+//
+// Build and run from McInjector:
+//   g++ -std=c++11 -O2 -o task_scheduler_tests tests/task_scheduler_tests.cpp src/main/cpp/task_scheduler.cpp
+//       -Isrc/main/cpp
+//   task_scheduler_tests
+//
+// The scheduler reads the real QPC clock, so cases poll RunDue() for a few
+// hundred milliseconds; bounds leave room for a loaded machine.
+
+#include <cstdio>
+#include <vector>
+
+#include "../src/main/cpp/task_scheduler.h"
+
+static int g_failures = 0;
+
+static void Check(bool ok, const char* what)
+{
+    if (ok) return;
+    ++g_failures;
+    std::printf("FAIL: %s\n", what);
+}
+
+static double NowMs()
+{
+    static LARGE_INTEGER s_freq = { { 0, 0 } };
+    if (s_freq.QuadPart == 0) QueryPerformanceFrequency(&s_freq);
+    LARGE_INTEGER c;
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart * 1000.0 / (double)s_freq.QuadPart;
+}
+
+// Calls RunDue() until `ms` have passed, sleeping 1 ms between passes.
+static void Pump(lc::TaskScheduler& sched, double ms)
+{
+    double end = NowMs() + ms;
+    while (NowMs() < end) {
+        sched.RunDue();
+        Sleep(1);
+    }
+}
+
+static const double kSlackMs = 40.0;   // scheduling jitter tolerated on a busy machine
+
+static void TestDelayLongerThanOneRevolution()
+{
+    // 300 ms is more than two turns of the wheel: the task's slot comes round
+    // at +44 ms and +172 ms without it being due.
+    const DWORD kPeriod = 300;
+    lc::TaskScheduler sched;
+    std::vector<double> runs;
+    double added = NowMs();
+    sched.Add("slow", kPeriod, 0, 0, [&]() { runs.push_back(NowMs() - added); });
+
+    Pump(sched, kPeriod - 20);
+    Check(runs.empty(), "a task is not run on an earlier lap of its slot");
+
+    Pump(sched, 20 + 150);
+    Check(runs.size() == 1, "a long-period task runs once per period");
+    Check(!runs.empty() && runs[0] >= kPeriod - 1 && runs[0] <= kPeriod + kSlackMs,
+          "a long-period task runs when its period is up");
+}
+
+static void TestShortPeriodAcrossWrapAround()
+{
+    // 400 ms of a 5 ms task walks the slot index round the wheel three times.
+    const DWORD kPeriod = 5;
+    const double kWindow = 400.0;
+    lc::TaskScheduler sched;
+    std::vector<double> runs;
+    sched.Add("fast", kPeriod, 0, 0, [&]() { runs.push_back(NowMs()); });
+
+    Pump(sched, kWindow);
+    bool spaced = true;
+    for (size_t i = 1; i < runs.size(); i++) spaced = spaced && runs[i] - runs[i - 1] >= kPeriod - 1;
+    Check(spaced, "runs stay a period apart across wheel wrap-around");
+    Check(runs.size() <= (size_t)(kWindow / kPeriod) + 1, "no extra runs after the wheel wraps");
+    Check(runs.size() >= (size_t)(kWindow / kPeriod) / 4, "the task keeps running after the wheel wraps");
+}
+
+static void TestLongStallRunsEachTaskOnce()
+{
+    // RunDue() called after a stall longer than a revolution: every slot is
+    // visited, each overdue task runs once and no catch-up burst follows.
+    lc::TaskScheduler sched;
+    int fast = 0, slow = 0, later = 0;
+    sched.Add("fast", 10, 0, 0, [&]() { fast++; });
+    sched.Add("slow", 250, 0, 0, [&]() { slow++; });
+    sched.Add("later", 1000, 0, 0, [&]() { later++; });
+
+    Sleep(300);
+    sched.RunDue();
+    Check(fast == 1 && slow == 1, "overdue tasks run once after a stall");
+    Check(later == 0, "a task not yet due stays put after a stall");
+
+    DWORD idle = sched.RunDue();
+    Check(fast == 1 && slow == 1, "no catch-up runs right after a stall");
+    Check(idle <= lc::TaskScheduler::kMaxIdleMs, "RunDue never asks to sleep past kMaxIdleMs");
+}
+
+static void TestRunSoonFromInsideATask()
+{
+    lc::TaskScheduler sched;
+    int pass = 0, aPass = -1, bPass = -1, bRuns = 0;
+    int b = -1;
+    sched.Add("a", 10, 0, 0, [&]() {
+        aPass = pass;
+        sched.RunSoon(b);
+    });
+    b = sched.Add("b", 10000, 1, 0, [&]() { bRuns++; bPass = pass; });
+
+    double end = NowMs() + 200;
+    while (NowMs() < end && bRuns == 0) {
+        pass++;
+        sched.RunDue();
+        Sleep(1);
+    }
+    Check(bRuns == 1 && bPass == aPass, "RunSoon from inside a task runs the target in the same pass");
+
+    // a keeps calling RunSoon(b) every 10 ms, so b runs about as often as a.
+    Pump(sched, 100);
+    Check(bRuns >= 3, "a task re-armed from inside another keeps running");
+}
+
+static void TestRunSoonOfItselfRunsOnceMore()
+{
+    lc::TaskScheduler sched;
+    int runs = 0;
+    int self = -1;
+    self = sched.Add("self", 10000, 0, 0, [&]() {
+        if (++runs == 1) sched.RunSoon(self);
+    });
+    sched.RunSoon(self);
+    sched.RunDue();
+    Check(runs == 2, "a task that re-arms itself runs once more in the same pass");
+    Pump(sched, 50);
+    Check(runs == 2, "a self re-arm leaves no stale wheel entry behind");
+}
+
+static void TestSetPeriodFromInsideATask()
+{
+    lc::TaskScheduler sched;
+    int b = -1;
+    double changed = 0.0;
+    std::vector<double> bRuns;
+    const int a = sched.Add("a", 10000, 0, 0, [&]() {
+        changed = NowMs();
+        sched.SetPeriod(b, 20);
+    });
+    b = sched.Add("b", 5000, 1, 0, [&]() { bRuns.push_back(NowMs()); });
+    sched.RunSoon(a);
+
+    Pump(sched, 120);
+    Check(!bRuns.empty() && bRuns[0] - changed >= 19 && bRuns[0] - changed <= 20 + kSlackMs,
+          "a shorter period set from inside a task takes effect at once");
+    Check(bRuns.size() >= 3, "the new period keeps applying");
+    Check(sched.Period(b) == 20, "SetPeriod is reported by Period()");
+
+    // A longer period waits for the run already scheduled.
+    sched.SetPeriod(b, 300);
+    size_t before = bRuns.size();
+    Pump(sched, 100);
+    Check(bRuns.size() <= before + 1, "a longer period applies from the next run");
+}
+
+static void TestDisabledTasksKeepTheirSlot()
+{
+    lc::TaskScheduler sched;
+    int runs = 0;
+    const int id = sched.Add("t", 5, 0, 0, [&]() { runs++; });
+    sched.SetEnabled(id, false);
+    Pump(sched, 60);
+    Check(runs == 0, "a disabled task does not run");
+    sched.SetEnabled(id, true);
+    Pump(sched, 60);
+    Check(runs > 0, "a re-enabled task runs again without being re-added");
+}
+
+int main()
+{
+    TestDelayLongerThanOneRevolution();
+    TestShortPeriodAcrossWrapAround();
+    TestLongStallRunsEachTaskOnce();
+    TestRunSoonFromInsideATask();
+    TestRunSoonOfItselfRunsOnceMore();
+    TestSetPeriodFromInsideATask();
+    TestDisabledTasksKeepTheirSlot();
+
+    if (g_failures != 0) {
+        std::printf("TaskScheduler tests failed: %d\n", g_failures);
+        return 1;
+    }
+    std::printf("TaskScheduler tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,93 @@
+# Compiles AokoHelper.java and embeds the class in src/main/cpp/jni_core/aoko_helper.inc
+# (kAokoHelperClassBytes), which helper_bridge.cpp defines in the game JVM.  Run by
+# build.bat / build_261.bat before the bridge compile; not meant to be run on its own.
+#
+#   powershell -NoProfile -ExecutionPolicy Bypass -File tools\embed_helper.ps1
+#
+# javac is the JDK 17 one (set LC_JAVAC to use another).  --release 8 keeps the class
+# loadable by the 1.8.9 JVM.  The build stops when a method helper_bridge.cpp resolves
+# is missing from the class: the bridge treats most of them as optional and would
+# quietly fall back instead.  When the .inc changes, AokoHelper.class beside the source
+# is refreshed; build_libs.bat then sees the newer .inc and rebuilds the cached jni_core
+# libraries.  Both files are tracked and must be committed with the AokoHelper.java
+# change that produced them.
+#
+# The .inc records the SHA-256 of the AokoHelper.java it was built from.  Without a JDK
+# the build goes on with the checked-in .inc when that hash still matches, and stops
+# when the .inc is stale instead of shipping a class the bridge would fall back from.
+$ErrorActionPreference = 'Stop'
+
+$root = Split-Path -Parent $PSScriptRoot
+$javac = if ($env:LC_JAVAC) { $env:LC_JAVAC } else { 'C:\Program Files\Java\jdk-17\bin\javac.exe' }
+$helperDir = Join-Path $root 'src\main\java\com\aoko\helper'
+$inc = Join-Path $root 'src\main\cpp\jni_core\aoko_helper.inc'
+$outDir = Join-Path $root 'obj\helper'
+$source = Join-Path $helperDir 'AokoHelper.java'
+# Hashed with LF line ends so a core.autocrlf checkout still matches.
+$sourceText = [IO.File]::ReadAllText($source).Replace("`r`n", "`n")
+$sha = [Security.Cryptography.SHA256]::Create()
+$sourceHash = -join ($sha.ComputeHash([Text.Encoding]::UTF8.GetBytes($sourceText)) | ForEach-Object { $_.ToString('x2') })
+$stamp = "// Source: AokoHelper.java sha256 $sourceHash"
+$current = if (Test-Path $inc) { [IO.File]::ReadAllText($inc) } else { '' }
+
+# Static methods helper_bridge.cpp looks up with GetStaticMethodID.
+$required = @(
+    'collectEntityFrame',
+    'collectBlockEntities',
+    'collectEntityFrameWide',
+    'collectLegacyEntityFrame',
+    'collectLegacyTileEntities',
+    'collectInventory',
+    'applyNametagHide'
+)
+
+if (-not (Test-Path $javac)) {
+    if ($current.Contains($stamp)) {
+        Write-Host "javac not found at $javac; aoko_helper.inc matches AokoHelper.java, using it as is."
+        exit 0
+    }
+    Write-Host "javac not found at $javac and aoko_helper.inc is older than AokoHelper.java (install JDK 17 or set LC_JAVAC)."
+    exit 1
+}
+New-Item -ItemType Directory -Force -Path $outDir | Out-Null
+& $javac --release 8 -nowarn -d $outDir $source
+if ($LASTEXITCODE -ne 0) { exit 1 }
+
+$class = Join-Path $outDir 'com\aoko\helper\AokoHelper.class'
+$bytes = [IO.File]::ReadAllBytes($class)
+
+# A method name shows up in the constant pool as a CONSTANT_Utf8 entry: a big-endian
+# u2 length followed by the name.  Matching the length too keeps collectEntityFrame
+# from being satisfied by collectEntityFrameWide.
+$pool = [Text.Encoding]::GetEncoding(28591).GetString($bytes)
+$missing = @($required | Where-Object {
+    $entry = [string][char]($_.Length -shr 8) + [char]($_.Length -band 0xFF) + $_
+    $pool.IndexOf($entry, [StringComparison]::Ordinal) -lt 0
+})
+if ($missing.Count -gt 0) {
+    Write-Host ("AokoHelper.class is missing: " + ($missing -join ', '))
+    exit 1
+}
+
+$sb = New-Object Text.StringBuilder
+[void]$sb.Append("// Auto-generated from AokoHelper.class by tools/embed_helper.ps1 - do not edit manually.`r`n")
+[void]$sb.Append("// Regenerate: run build.bat or build_261.bat (javac --release 8 AokoHelper.java).`r`n")
+[void]$sb.Append("$stamp`r`n")
+[void]$sb.Append("static const unsigned char kAokoHelperClassBytes[] = {`r`n")
+for ($i = 0; $i -lt $bytes.Length; $i += 12) {
+    $end = [Math]::Min($i + 12, $bytes.Length)
+    $row = for ($k = $i; $k -lt $end; $k++) { '0x{0:X2}' -f $bytes[$k] }
+    $line = '    ' + ($row -join ', ')
+    if ($end -lt $bytes.Length) { $line += ',' }
+    [void]$sb.Append($line + "`r`n")
+}
+[void]$sb.Append("};`r`n")
+[void]$sb.Append("static const int kAokoHelperClassLen = $($bytes.Length);`r`n")
+$text = $sb.ToString()
+
+if ($current -ceq $text) { exit 0 }
+
+[IO.File]::WriteAllText($inc, $text, [Text.Encoding]::ASCII)
+Copy-Item -Force $class (Join-Path $helperDir 'AokoHelper.class')
+Write-Host "Updated aoko_helper.inc ($($bytes.Length) bytes); commit it and AokoHelper.class with AokoHelper.java."
+exit 0
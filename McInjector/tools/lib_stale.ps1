@@ -0,0 +1,28 @@
+# Used by build_libs.bat to decide whether a cached release library needs a rebuild.
+#
+#   powershell -NoProfile -ExecutionPolicy Bypass -File tools\lib_stale.ps1 <lib> <source>...
+#
+# Exits 0 when <lib> is missing or older than any source, 1 when it is up to date.  A
+# source is a file, a wildcard, or a directory (walked recursively).
+param(
+    [Parameter(Mandatory = $true)][string]$Lib,
+    [Parameter(ValueFromRemainingArguments = $true)][string[]]$Sources
+)
+$ErrorActionPreference = 'Stop'
+
+if (-not (Test-Path -LiteralPath $Lib)) { exit 0 }
+$built = (Get-Item -LiteralPath $Lib).LastWriteTimeUtc
+
+foreach ($source in $Sources) {
+    $files = if (Test-Path -LiteralPath $source -PathType Container) {
+        Get-ChildItem -LiteralPath $source -File -Recurse
+    } else {
+        Get-ChildItem -Path $source -File -ErrorAction SilentlyContinue
+    }
+    $newer = $files | Where-Object { $_.LastWriteTimeUtc -gt $built } | Select-Object -First 1
+    if ($newer) {
+        Write-Host "$Lib is older than $($newer.FullName)."
+        exit 0
+    }
+}
+exit 1
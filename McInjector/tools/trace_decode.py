@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Decode a bridge trace dump (bridge_trace.bin / bridge_261_trace.bin).
+
+Dumps are written on Detach by trace builds (build.bat trace). Output is one
+line per event, merged across threads in timestamp order:
+
+    <ms since first event>  tid=<thread>  <function>:<line>  <P|B> <name> [=value]
+
+Usage: trace_decode.py <dump> [--site SUBSTR] [--summary]
+"""
+import argparse
+import struct
+import sys
+from collections import Counter
+
+EVENT = struct.Struct("<HHIQ")
+
+
+def read_line(f):
+    line = f.readline()
+    if not line:
+        raise ValueError("unexpected end of dump")
+    return line.decode("utf-8", "replace").rstrip("\n")
+
+
+def load(path):
+    with open(path, "rb") as f:
+        if read_line(f) != "LCTRACE1":
+            raise ValueError("not a LegoClicker trace dump")
+        freq = int(read_line(f).split("=", 1)[1])
+        site_count = int(read_line(f).split("=", 1)[1])
+        sites = {}
+        for _ in range(site_count):
+            sid, kind, fn, name, line = read_line(f).split("\t")
+            sites[int(sid)] = (kind, fn, name, int(line))
+        ring_count = int(read_line(f).split("=", 1)[1])
+        events = []
+        for _ in range(ring_count):
+            _, _, tid, count = read_line(f).split("\t")
+            tid, count = int(tid), int(count)
+            raw = f.read(EVENT.size * count)
+            for site, _ring, value, qpc in EVENT.iter_unpack(raw):
+                events.append((qpc, tid, site, value))
+    events.sort()
+    return freq, sites, events
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("dump")
+    ap.add_argument("--site", help="only events whose function or name contains SUBSTR")
+    ap.add_argument("--summary", action="store_true", help="print per-site hit counts instead")
+    args = ap.parse_args()
+
+    freq, sites, events = load(args.dump)
+    if not events:
+        print("no events recorded")
+        return 0
+
+    def describe(sid):
+        return sites.get(sid, ("?", "?", "site%d" % sid, 0))
+
+    if args.site:
+        events = [e for e in events
+                  if args.site in describe(e[2])[1] or args.site in describe(e[2])[2]]
+
+    if args.summary:
+        hits = Counter((e[2], e[3]) for e in events)
+        for (sid, value), n in hits.most_common():
+            kind, fn, name, line = describe(sid)
+            suffix = "" if kind == "P" else " =%d" % value
+            print("%8d  %s:%d  %s %s%s" % (n, fn, line, kind, name, suffix))
+        return 0
+
+    t0 = events[0][0]
+    for qpc, tid, sid, value in events:
+        kind, fn, name, line = describe(sid)
+        ms = (qpc - t0) * 1000.0 / freq
+        suffix = "" if kind == "P" else " =%d" % value
+        print("%12.3f  tid=%-6d %s:%d  %s %s%s" % (ms, tid, fn, line, kind, name, suffix))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
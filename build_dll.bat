@@ -3,7 +3,7 @@ echo [bridge.dll] Building C++ bridge...
 echo.
 
 cd McInjector
-call build.bat
+call build.bat %*
 if %errorlevel% neq 0 (
     echo.
     echo [bridge.dll] BUILD FAILED.
@@ -16,7 +16,7 @@ echo [bridge_261.dll] Building C++ 26.1 bridge...
 echo.
 
 cd McInjector
-call build_261.bat
+call build_261.bat %*
 if %errorlevel% neq 0 (
     echo.
     echo [bridge_261.dll] BUILD FAILED.